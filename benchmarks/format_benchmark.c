@@ -0,0 +1,106 @@
+// Microbenchmark for number_format.h: int32, int64, float64 and float32 to decimal text, against the
+// snprintf calls it replaced (%d, %lld, %.15g and %.7g; the float formats print fewer digits than
+// the shortest round trip, so snprintf gets the easier job). Also appends each kind to a
+// ds_builder the way StringBuilder.append() does.
+//
+//   cmake --build build --target slate_format_benchmark && ./build/slate_format_benchmark
+
+#include "number_format.h"
+#include "dynamic_string.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define COUNT 1000000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Keeps the compiler from dropping formatting whose results are unused
+static volatile size_t sink;
+
+static uint64_t state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t next_random(void) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static int32_t int32s[COUNT];
+static int64_t int64s[COUNT];
+static double float64s[COUNT];
+static float float32s[COUNT];
+
+static void report(const char* kind, double snprintf_ns, double nf_ns, double builder_ns) {
+    printf("%-8s %12.1f %12.1f %12.1f %9.1fx\n", kind, snprintf_ns, nf_ns, builder_ns, snprintf_ns / nf_ns);
+}
+
+int main(void) {
+    for (int i = 0; i < COUNT; i++) {
+        uint64_t bits = next_random();
+        // Mixed magnitudes, as in real output: small counters as well as full-width values
+        int32s[i] = (int32_t)bits >> (bits % 24);
+        int64s[i] = (int64_t)bits >> (bits % 48);
+        // Half two-decimal amounts like 12345.67, half full-precision fractions scaled up to 10^6
+        float64s[i] = i % 2 ? (double)(bits % 100000000) / 100.0 : (double)(bits >> 11) * 0x1p-53 * (double)(bits % 1000000);
+        float32s[i] = (float)float64s[i];
+    }
+
+    char buffer[NF_MAX_LENGTH];
+    ds_builder sb = ds_builder_create();
+    printf("%-8s %12s %12s %12s %10s   (ns/op)\n", "", "snprintf", "nf_format", "ds_builder", "speedup");
+
+    double start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += (size_t)snprintf(buffer, sizeof(buffer), "%d", int32s[i]);
+    double snprintf_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += nf_format_int32(buffer, int32s[i]);
+    double nf_ns = (now_ns() - start) / COUNT;
+    ds_builder_clear(sb);
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) ds_builder_commit(sb, nf_format_int32(ds_builder_reserve(sb, NF_MAX_LENGTH), int32s[i]));
+    report("int32", snprintf_ns, nf_ns, (now_ns() - start) / COUNT);
+
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += (size_t)snprintf(buffer, sizeof(buffer), "%lld", (long long)int64s[i]);
+    snprintf_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += nf_format_int64(buffer, int64s[i]);
+    nf_ns = (now_ns() - start) / COUNT;
+    ds_builder_clear(sb);
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) ds_builder_commit(sb, nf_format_int64(ds_builder_reserve(sb, NF_MAX_LENGTH), int64s[i]));
+    report("int64", snprintf_ns, nf_ns, (now_ns() - start) / COUNT);
+
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += (size_t)snprintf(buffer, sizeof(buffer), "%.15g", float64s[i]);
+    snprintf_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += nf_format_float64(buffer, float64s[i]);
+    nf_ns = (now_ns() - start) / COUNT;
+    ds_builder_clear(sb);
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) ds_builder_commit(sb, nf_format_float64(ds_builder_reserve(sb, NF_MAX_LENGTH), float64s[i]));
+    report("float64", snprintf_ns, nf_ns, (now_ns() - start) / COUNT);
+
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += (size_t)snprintf(buffer, sizeof(buffer), "%.7g", float32s[i]);
+    snprintf_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += nf_format_float32(buffer, float32s[i]);
+    nf_ns = (now_ns() - start) / COUNT;
+    ds_builder_clear(sb);
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) ds_builder_commit(sb, nf_format_float32(ds_builder_reserve(sb, NF_MAX_LENGTH), float32s[i]));
+    report("float32", snprintf_ns, nf_ns, (now_ns() - start) / COUNT);
+
+    sink += ds_builder_length(sb);
+    ds_builder_release(&sb);
+    return 0;
+}
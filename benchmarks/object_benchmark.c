@@ -0,0 +1,91 @@
+// Microbenchmark for dynamic_object.h property storage: get, set and delete+reinsert on objects
+// with 1, 8, 64 and 10k properties, looked up by plain C strings, by ds_strings interned with
+// their cached hash (as the VM does) and by pre-interned keys.
+//
+//   cmake --build build --target slate_object_benchmark && ./build/slate_object_benchmark
+
+#include "dynamic_object.h"
+#include "dynamic_string.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define TOTAL_OPS 4000000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Keeps the compiler from dropping lookups whose results are unused
+static volatile uintptr_t sink;
+
+static void run(int property_count) {
+    char (*names)[24] = malloc((size_t)property_count * sizeof(*names));
+    const char** interned = malloc((size_t)property_count * sizeof(*interned));
+    ds_string* strings = malloc((size_t)property_count * sizeof(*strings));
+    do_object obj = do_create(NULL);
+    for (int i = 0; i < property_count; i++) {
+        snprintf(names[i], sizeof(names[i]), "bench_%d", i);
+        interned[i] = do_string_intern(names[i]);
+        strings[i] = ds_new(names[i]);
+        int64_t value = i;
+        do_set(obj, names[i], &value, sizeof(value));
+    }
+
+    double start = now_ns();
+    for (int op = 0; op < TOTAL_OPS; op++) {
+        sink += (uintptr_t)do_get(obj, names[op % property_count]);
+    }
+    double get_ns = (now_ns() - start) / TOTAL_OPS;
+
+    start = now_ns();
+    for (int op = 0; op < TOTAL_OPS; op++) {
+        ds_string name = strings[op % property_count];
+        sink += (uintptr_t)do_get_interned(obj, do_string_intern_hashed(name, ds_hash32(name)));
+    }
+    double get_hashed_ns = (now_ns() - start) / TOTAL_OPS;
+
+    start = now_ns();
+    for (int op = 0; op < TOTAL_OPS; op++) {
+        sink += (uintptr_t)do_get_interned(obj, interned[op % property_count]);
+    }
+    double get_interned_ns = (now_ns() - start) / TOTAL_OPS;
+
+    start = now_ns();
+    for (int op = 0; op < TOTAL_OPS; op++) {
+        int64_t value = op;
+        do_set(obj, names[op % property_count], &value, sizeof(value));
+    }
+    double set_ns = (now_ns() - start) / TOTAL_OPS;
+
+    start = now_ns();
+    for (int op = 0; op < TOTAL_OPS / 4; op++) {
+        int64_t value = op;
+        do_delete(obj, names[op % property_count]);
+        do_set(obj, names[op % property_count], &value, sizeof(value));
+    }
+    double delete_ns = (now_ns() - start) / (TOTAL_OPS / 4);
+
+    printf("%8d %12.1f %12.1f %12.1f %12.1f %16.1f\n", property_count, get_ns, get_hashed_ns, get_interned_ns, set_ns,
+           delete_ns);
+    sink += (uintptr_t)do_property_count(obj);
+    do_release(&obj);
+    for (int i = 0; i < property_count; i++) {
+        ds_release(&strings[i]);
+    }
+    free(strings);
+    free(interned);
+    free(names);
+}
+
+int main(void) {
+    printf("%8s %12s %12s %12s %12s %16s   (ns/op)\n", "props", "get", "get_hashed", "get_interned", "set",
+           "delete+reinsert");
+    int sizes[] = {1, 8, 64, 10000};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        run(sizes[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Microbenchmark for number_parse.h: decimal integers and floats to numbers, against the strtoll,
+// strtod and strtof calls it replaced, plus one whitespace-separated line of integers split into
+// an int32 buffer the way String.parseInts() reads it.
+//
+//   cmake --build build --target slate_parse_benchmark && ./build/slate_parse_benchmark
+
+#include "number_parse.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define COUNT 1000000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Keeps the compiler from dropping parses whose results are unused
+static volatile double sink;
+
+static uint64_t state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t next_random(void) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+// COUNT NUL-terminated texts back to back, with their offsets and lengths
+typedef struct {
+    char* text;
+    size_t* offsets;
+    size_t* lengths;
+} corpus;
+
+static corpus build(int floats) {
+    corpus c = {malloc((size_t)COUNT * 32), malloc(COUNT * sizeof(size_t)), malloc(COUNT * sizeof(size_t))};
+    size_t at = 0;
+    for (int i = 0; i < COUNT; i++) {
+        uint64_t bits = next_random();
+        int length;
+        if (floats) {
+            // Half two-decimal amounts like 12345.67, half 17-digit values with an exponent
+            length = i % 2 ? snprintf(c.text + at, 32, "%.2f", (double)(bits % 100000000) / 100.0)
+                           : snprintf(c.text + at, 32, "%.17g", (double)(bits >> 11) * 0x1p-53 * 1e6);
+        } else {
+            length = snprintf(c.text + at, 32, "%d", (int32_t)bits >> (bits % 24));
+        }
+        c.offsets[i] = at;
+        c.lengths[i] = (size_t)length;
+        at += (size_t)length + 1;
+    }
+    return c;
+}
+
+static void release(corpus c) {
+    free(c.text);
+    free(c.offsets);
+    free(c.lengths);
+}
+
+static void report(const char* kind, double libc_ns, double np_ns) {
+    printf("%-8s %12.1f %12.1f %9.1fx\n", kind, libc_ns, np_ns, libc_ns / np_ns);
+}
+
+int main(void) {
+    printf("%-8s %12s %12s %10s   (ns/op)\n", "", "libc", "np_parse", "speedup");
+    np_number number;
+
+    corpus ints = build(0);
+    double start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += (double)strtoll(ints.text + ints.offsets[i], NULL, 10);
+    double libc_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) {
+        np_parse(ints.text + ints.offsets[i], ints.lengths[i], NP_INTEGER_ONLY, &number);
+        sink += number.as.int32;
+    }
+    report("int32", libc_ns, (now_ns() - start) / COUNT);
+
+    corpus floats = build(1);
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += strtod(floats.text + floats.offsets[i], NULL);
+    libc_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += np_parse_float64(floats.text + floats.offsets[i], floats.lengths[i]);
+    report("float64", libc_ns, (now_ns() - start) / COUNT);
+
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += strtof(floats.text + floats.offsets[i], NULL);
+    libc_ns = (now_ns() - start) / COUNT;
+    start = now_ns();
+    for (int i = 0; i < COUNT; i++) sink += np_parse_float32(floats.text + floats.offsets[i], floats.lengths[i]);
+    report("float32", libc_ns, (now_ns() - start) / COUNT);
+
+    // One line of space-separated integers, as a data file would hold them
+    for (int i = 0; i < COUNT; i++) ints.text[ints.offsets[i] + ints.lengths[i]] = ' ';
+    size_t line_length = ints.offsets[COUNT - 1] + ints.lengths[COUNT - 1];
+    int32_t* values = malloc(COUNT * sizeof(int32_t));
+    start = now_ns();
+    char* end = ints.text;
+    for (int i = 0; i < COUNT; i++) values[i] = (int32_t)strtol(end, &end, 10);
+    libc_ns = (now_ns() - start) / COUNT;
+    sink += values[COUNT - 1];
+    start = now_ns();
+    size_t pos = 0;
+    for (int i = 0; pos < line_length; i++) {
+        pos += np_scan(ints.text + pos, line_length - pos, NP_INTEGER_ONLY, &number);
+        values[i] = number.as.int32;
+        pos++;
+    }
+    report("line", libc_ns, (now_ns() - start) / COUNT);
+    sink += values[COUNT - 1];
+
+    free(values);
+    release(ints);
+    release(floats);
+    return 0;
+}
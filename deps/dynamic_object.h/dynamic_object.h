@@ -12,7 +12,8 @@
  * - Reference counting with optional atomic operations
  * - Release function for property values (like DA's retain/release)
  * - String interning for efficient property keys
- * - Automatic upgrade from linear to hash storage
+ * - Insertion-ordered properties, indexed by a SIMD-probed hash table once an
+ *   object outgrows a short linear scan
  * - Single header library
  * - Microcontroller friendly
  * 
@@ -34,6 +35,13 @@
 #include <string.h>
 #include <assert.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DO_SSE2 1
+#else
+#define DO_SSE2 0
+#endif
+
 // stb_ds.h for dynamic arrays and hash maps
 #ifdef DO_IMPLEMENTATION
     #define STB_DS_IMPLEMENTATION
@@ -70,6 +78,12 @@ extern "C" {
 #define DO_STRING_INTERNING 1
 #endif
 
+// Intern table locking (define both to share objects' keys across threads)
+#ifndef DO_INTERN_LOCK
+#define DO_INTERN_LOCK() ((void)0)
+#define DO_INTERN_UNLOCK() ((void)0)
+#endif
+
 // Atomic reference counting configuration
 #ifndef DO_ATOMIC_REFCOUNT
 #define DO_ATOMIC_REFCOUNT 0  // Default to non-atomic
@@ -77,7 +91,16 @@ extern "C" {
 
 // Property storage optimization threshold
 #ifndef DO_HASH_THRESHOLD
-#define DO_HASH_THRESHOLD 8  // Switch to hash table after N properties
+#define DO_HASH_THRESHOLD 8  // Index properties in a hash table after N properties
+#endif
+
+// Per-thread cache of recent interning results, checked before taking the intern lock
+#ifndef DO_INTERN_CACHE_SIZE
+#define DO_INTERN_CACHE_SIZE 256  // Power of two; 0 disables the cache
+#endif
+
+#ifndef DO_THREAD_LOCAL
+#define DO_THREAD_LOCAL _Thread_local
 #endif
 
 // Atomic operations (inherit from dynamic_array.h)
@@ -124,24 +147,20 @@ typedef struct do_object_t* do_object;
  * release_fn handles cleanup of property values.
  */
 typedef struct {
-    const char* key;     // Interned string key (pointer equality)
+    const char* key;     // Interned string key (pointer equality), NULL once deleted
     void* data;          // Generic data pointer
     size_t size;         // Size of data in bytes
 } do_property_t;
 
-/**
- * @brief Hash map entry for stb_ds hash table
- */
-typedef struct {
-    const char* key;     // Hash map key (interned string)
-    do_property_t value; // Property value
-} do_hash_entry_t;
-
 /**
  * @brief Dynamic object structure with prototype-based inheritance
  * 
- * Uses hybrid storage: linear array for small objects (cache-friendly),
- * hash table for large objects (O(1) access). Automatic upgrade at threshold.
+ * Properties live in an stb_ds array in insertion order. Small objects are
+ * searched linearly (cache-friendly); past DO_HASH_THRESHOLD an open-addressing
+ * index is added in the style of Swiss tables: one control byte per slot holding
+ * 7 bits of the key's hash (or empty/deleted), probed 16 at a time with SSE2,
+ * and a parallel array of indexes into the property array. Keys are interned,
+ * so the hash is computed from the key pointer and matches are pointer compares.
  * 
  * The release_fn is called on property values when they are removed or
  * the object is destroyed, enabling proper cleanup of reference-counted values.
@@ -150,11 +169,12 @@ typedef struct do_object_t {
     DO_ATOMIC_INT ref_count;        // Reference counting (object-level)
     struct do_object_t* prototype;  // Inheritance chain
     void (*release_fn)(void*);      // Called on property values when removed
-    union {
-        do_property_t* linear_props; // stb_ds array for small objects
-        do_hash_entry_t* hash_props; // stb_ds hash map for large objects
-    } properties;
-    int is_hashed;                  // 0 = linear array, 1 = hash table
+    do_property_t* properties;      // stb_ds array in insertion order
+    uint8_t* ctrl;                  // Index control bytes (NULL while searched linearly)
+    uint32_t* slots;                // Index into properties for each full control byte
+    int capacity;                   // Index slots, a multiple of the group size
+    int growth_left;                // Inserts into empty slots before the index is rebuilt
+    int deleted_count;              // Deleted entries still in properties (indexed objects only)
     int property_count;             // Number of own properties
 } do_object_t;
 
@@ -162,6 +182,13 @@ typedef struct do_object_t {
  * STRING INTERNING SYSTEM
  * ============================================================================= */
 
+/**
+ * @brief Hash used for interning: 32-bit FNV-1a over the bytes before the terminator
+ * @param str String to hash (must not be NULL)
+ * @return Hash value (the same as dynamic_string.h's ds_hash32 for the same text)
+ */
+DO_DEF size_t do_string_hash(const char* str);
+
 #if DO_STRING_INTERNING
 
 /**
@@ -172,6 +199,21 @@ typedef struct do_object_t {
  */
 DO_DEF const char* do_string_intern(const char* str);
 
+/**
+ * @brief Intern a string whose hash the caller already has
+ * @param str String to intern (must not be NULL)
+ * @param hash do_string_hash(str), e.g. cached alongside the caller's copy of the string
+ * @return Interned string pointer, as from do_string_intern()
+ */
+DO_DEF const char* do_string_intern_hashed(const char* str, size_t hash);
+
+/**
+ * @brief Hash of an interned string, stored with it when it was interned
+ * @param interned_key Interned string (must be interned)
+ * @return do_string_hash(interned_key), without rehashing
+ */
+DO_DEF size_t do_interned_hash(const char* interned_key);
+
 /**
  * @brief Check if string is already interned
  * @param str String to check
@@ -188,6 +230,8 @@ DO_DEF void do_string_intern_cleanup(void);
 #else
 // No interning - just return the original string
 #define do_string_intern(str) (str)
+#define do_string_intern_hashed(str, hash) (str)
+#define do_interned_hash(str) do_string_hash(str)
 #define do_string_find_interned(str) (str)
 #define do_string_intern_cleanup() ((void)0)
 #endif
@@ -624,6 +668,15 @@ DO_DEF void do_foreach_property(do_object obj,
  * STRING INTERNING IMPLEMENTATION
  * ============================================================================= */
 
+DO_DEF size_t do_string_hash(const char* str) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (; *str; str++) {
+        hash ^= (uint8_t)*str;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 #if DO_STRING_INTERNING
 
 typedef struct {
@@ -631,170 +684,304 @@ typedef struct {
     size_t hash;
 } intern_entry_t;
 
-// Simple string interning using stb_ds array
+// Interned strings are allocated behind a copy of their hash: [hash|chars|\0]
+#define DO_INTERN_HEADER sizeof(size_t)
+
+// Open-addressing table of interned strings (linear probing, at most half full)
 static intern_entry_t* g_intern_table = NULL;
+static size_t g_intern_capacity = 0;
+static size_t g_intern_count = 0;
+
+#if DO_INTERN_CACHE_SIZE
+// Most lookups are for names seen moments ago; a per-thread cache answers them without the lock.
+// Interned strings are never freed before do_string_intern_cleanup(), which bumps the generation.
+static unsigned g_intern_generation = 0;
+static DO_THREAD_LOCAL struct {
+    const char* entries[DO_INTERN_CACHE_SIZE];
+    unsigned generation;
+} g_intern_cache;
+
+static const char* intern_cache_find(const char* str, size_t hash) {
+    if (g_intern_cache.generation != g_intern_generation) {
+        memset(g_intern_cache.entries, 0, sizeof(g_intern_cache.entries));
+        g_intern_cache.generation = g_intern_generation;
+        return NULL;
+    }
+    const char* cached = g_intern_cache.entries[hash & (DO_INTERN_CACHE_SIZE - 1)];
+    return cached && (cached == str || strcmp(cached, str) == 0) ? cached : NULL;
+}
 
-// Simple hash function (djb2)
-static size_t do_hash_string(const char* str) {
-    size_t hash = 5381;
-    int c;
-    while ((c = *str++)) {
-        hash = ((hash << 5) + hash) + c;
+static void intern_cache_store(const char* interned, size_t hash) {
+    g_intern_cache.entries[hash & (DO_INTERN_CACHE_SIZE - 1)] = interned;
+}
+#else
+#define intern_cache_find(str, hash) NULL
+#define intern_cache_store(interned, hash) ((void)0)
+#endif
+
+// Table slot holding str, or the empty slot where it belongs. Caller holds the intern lock.
+static intern_entry_t* intern_find_slot(const char* str, size_t hash) {
+    size_t mask = g_intern_capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        intern_entry_t* entry = &g_intern_table[i];
+        if (!entry->str || (entry->hash == hash && strcmp(entry->str, str) == 0)) {
+            return entry;
+        }
     }
-    return hash;
+}
+
+static int intern_grow(void) {
+    size_t old_capacity = g_intern_capacity;
+    intern_entry_t* old_table = g_intern_table;
+    size_t capacity = old_capacity ? old_capacity * 2 : 1024;
+    intern_entry_t* table = (intern_entry_t*)calloc(capacity, sizeof(intern_entry_t));
+    if (!table) return 0;
+
+    g_intern_table = table;
+    g_intern_capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_table[i].str) {
+            *intern_find_slot(old_table[i].str, old_table[i].hash) = old_table[i];
+        }
+    }
+    free(old_table);
+    return 1;
 }
 
 DO_DEF const char* do_string_intern(const char* str) {
     DO_ASSERT(str != NULL);
-    
-    size_t hash = do_hash_string(str);
-    int len = arrlen(g_intern_table);
-    
-    // Linear search (could optimize with hash table later)
-    for (int i = 0; i < len; i++) {
-        if (g_intern_table[i].hash == hash && strcmp(g_intern_table[i].str, str) == 0) {
-            return g_intern_table[i].str;
+    return do_string_intern_hashed(str, do_string_hash(str));
+}
+
+DO_DEF const char* do_string_intern_hashed(const char* str, size_t hash) {
+    DO_ASSERT(str != NULL);
+
+    const char* found = intern_cache_find(str, hash);
+    if (found) return found;
+
+    DO_INTERN_LOCK();
+    if ((g_intern_count + 1) * 2 > g_intern_capacity && !intern_grow()) {
+        DO_INTERN_UNLOCK();
+        return NULL;
+    }
+    intern_entry_t* entry = intern_find_slot(str, hash);
+    if (!entry->str) {
+        // Not found - add new entry
+        size_t str_len = strlen(str);
+        char* block = (char*)DO_MALLOC(DO_INTERN_HEADER + str_len + 1);
+        if (!block) {
+            DO_INTERN_UNLOCK();
+            return NULL;
         }
+        memcpy(block, &hash, sizeof(hash));
+        char* new_str = block + DO_INTERN_HEADER;
+        memcpy(new_str, str, str_len + 1);
+        entry->str = new_str;
+        entry->hash = hash;
+        g_intern_count++;
     }
-    
-    // Not found - add new entry
-    size_t str_len = strlen(str);
-    char* new_str = (char*)DO_MALLOC(str_len + 1);
-    if (!new_str) return NULL;
-    
-    strcpy(new_str, str);
-    
-    intern_entry_t new_entry = {new_str, hash};
-    arrput(g_intern_table, new_entry);
-    
-    return new_str;
+    found = entry->str;
+    DO_INTERN_UNLOCK();
+
+    intern_cache_store(found, hash);
+    return found;
+}
+
+DO_DEF size_t do_interned_hash(const char* interned_key) {
+    DO_ASSERT(interned_key != NULL);
+    size_t hash;
+    memcpy(&hash, interned_key - DO_INTERN_HEADER, sizeof(hash));
+    return hash;
 }
 
 DO_DEF const char* do_string_find_interned(const char* str) {
-    if (!str || !g_intern_table) return NULL;
-    
-    size_t hash = do_hash_string(str);
-    int len = arrlen(g_intern_table);
+    if (!str) return NULL;
     
-    for (int i = 0; i < len; i++) {
-        if (g_intern_table[i].hash == hash && strcmp(g_intern_table[i].str, str) == 0) {
-            return g_intern_table[i].str;
-        }
+    size_t hash = do_string_hash(str);
+    const char* found = intern_cache_find(str, hash);
+    if (found) return found;
+
+    DO_INTERN_LOCK();
+    if (g_intern_capacity) {
+        found = intern_find_slot(str, hash)->str;
     }
+    DO_INTERN_UNLOCK();
     
-    return NULL;
+    return found;
 }
 
 DO_DEF void do_string_intern_cleanup(void) {
+    DO_INTERN_LOCK();
     if (g_intern_table) {
-        int len = arrlen(g_intern_table);
-        for (int i = 0; i < len; i++) {
-            DO_FREE(g_intern_table[i].str);
+        for (size_t i = 0; i < g_intern_capacity; i++) {
+            if (g_intern_table[i].str) {
+                DO_FREE(g_intern_table[i].str - DO_INTERN_HEADER);
+            }
         }
-        arrfree(g_intern_table);
+        free(g_intern_table);
         g_intern_table = NULL;
+        g_intern_capacity = 0;
+        g_intern_count = 0;
     }
+#if DO_INTERN_CACHE_SIZE
+    g_intern_generation++;
+#endif
+    DO_INTERN_UNLOCK();
 }
 
 #endif // DO_STRING_INTERNING
 
 /* =============================================================================
- * PROPERTY STORAGE IMPLEMENTATION (using dynamic arrays)
+ * PROPERTY INDEX IMPLEMENTATION (Swiss-table style open addressing)
  * ============================================================================= */
 
-// Find property in linear array  
-static do_property_t* find_linear_property(do_property_t* props, const char* key) {
-    if (!props) return NULL;
-    
-    int len = arrlen(props);
-    for (int i = 0; i < len; i++) {
-        if (props[i].key == key) {  // Pointer equality for interned strings
-            return &props[i];
-        }
+#define DO_GROUP_SIZE 16
+#define DO_CTRL_EMPTY 0x80      // Ends a probe
+#define DO_CTRL_DELETED 0xFE    // Probes continue past it; reusable by inserts
+// Full slots hold the low 7 bits of the key's hash (high bit clear)
+
+// Keys are interned, so the pointer identifies the string (Fibonacci hashing)
+static inline uint32_t do_key_hash(const char* key) {
+    return (uint32_t)(((uint64_t)(uintptr_t)key * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+static inline int do_ctz(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int n = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        n++;
     }
-    return NULL;
+    return n;
+#endif
 }
 
-// Hash table optimization using interned string keys for maximum performance
-#define PROPERTY_HASH(p) ((uintptr_t)(p.key) >> 3)  // Fast pointer-based hash
-#define PROPERTY_EQUAL(a,b) ((a.key) == (b.key))   // Pointer equality for interned strings
+// Bit i set where group[i] == byte
+static inline uint32_t do_group_match(const uint8_t* group, uint8_t byte) {
+#if DO_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < DO_GROUP_SIZE; i++) {
+        mask |= (uint32_t)(group[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
 
-// Hash map property access using stb_ds
-static do_property_t* find_hash_property(do_hash_entry_t* props, const char* key) {
-    if (!props) return NULL;
-    
-    // Use stb_ds hash map get - returns pointer to the hash entry
-    do_hash_entry_t* entry = hmgetp_null(props, key);
-    return entry ? &entry->value : NULL;
+// Bit i set where group[i] is empty or deleted
+static inline uint32_t do_group_match_free(const uint8_t* group) {
+#if DO_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < DO_GROUP_SIZE; i++) {
+        mask |= (uint32_t)(group[i] >> 7) << i;
+    }
+    return mask;
+#endif
 }
 
-static int set_hash_property(do_object obj, const char* key, const void* data, size_t size) {
-    // Check if property already exists
-    do_property_t* existing = find_hash_property(obj->properties.hash_props, key);
-    
-    if (existing) {
-        // Update existing property - release old value
-        if (obj->release_fn && existing->data) {
-            obj->release_fn(existing->data);
+// Groups are probed triangularly (1, 2, 3... groups on), which visits every group of a
+// power-of-two table. The index never fills, so every probe reaches an empty slot.
+static int find_index_slot(do_object obj, const char* key, uint32_t hash) {
+    uint32_t group_mask = (uint32_t)(obj->capacity / DO_GROUP_SIZE) - 1;
+    uint32_t group = (hash >> 7) & group_mask;
+    uint8_t tag = (uint8_t)(hash & 0x7F);
+    for (uint32_t step = 1;; step++) {
+        const uint8_t* ctrl = obj->ctrl + group * DO_GROUP_SIZE;
+        for (uint32_t match = do_group_match(ctrl, tag); match; match &= match - 1) {
+            int slot = (int)(group * DO_GROUP_SIZE) + do_ctz(match);
+            if (obj->properties[obj->slots[slot]].key == key) {
+                return slot;
+            }
         }
-        if (existing->data) {
-            DO_FREE(existing->data);
+        if (do_group_match(ctrl, DO_CTRL_EMPTY)) {
+            return -1;
         }
-        
-        existing->data = DO_MALLOC(size);
-        if (!existing->data) return DO_ERROR_MEMORY;
-        
-        memcpy(existing->data, data, size);
-        existing->size = size;
-        return DO_SUCCESS;
-    } else {
-        // New property
-        do_property_t new_prop;
-        new_prop.key = key;
-        new_prop.data = DO_MALLOC(size);
-        if (!new_prop.data) return DO_ERROR_MEMORY;
-        
-        memcpy(new_prop.data, data, size);
-        new_prop.size = size;
-        
-        do_hash_entry_t new_entry = { key, new_prop };
-        hmput(obj->properties.hash_props, key, new_entry.value);
-        obj->property_count++;
-        return DO_SUCCESS;
+        group = (group + step) & group_mask;
     }
 }
 
-static void upgrade_to_hash(do_object obj) {
-    if (obj->is_hashed) return;
-    
-    do_property_t* linear_props = obj->properties.linear_props;
-    if (!linear_props) return;
-    
-    int len = arrlen(linear_props);
-    if (len <= DO_HASH_THRESHOLD) return;
-    
-    // Initialize empty stb_ds hash map
-    obj->properties.hash_props = NULL;
-    obj->is_hashed = 1;
-    obj->property_count = 0;  // Reset count, will be rebuilt during migration
-    
-    // Move properties to hash table
-    for (int i = 0; i < len; i++) {
-        do_property_t* prop = &linear_props[i];
-        if (set_hash_property(obj, prop->key, prop->data, prop->size) != DO_SUCCESS) {
-            // Failed to migrate - restore linear
-            hmfree(obj->properties.hash_props);
-            obj->is_hashed = 0;
-            obj->properties.linear_props = linear_props;
-            obj->property_count = len;  // Restore original count
+static void index_insert(do_object obj, uint32_t property_index, uint32_t hash) {
+    uint32_t group_mask = (uint32_t)(obj->capacity / DO_GROUP_SIZE) - 1;
+    uint32_t group = (hash >> 7) & group_mask;
+    for (uint32_t step = 1;; step++) {
+        uint32_t free_slots = do_group_match_free(obj->ctrl + group * DO_GROUP_SIZE);
+        if (free_slots) {
+            int slot = (int)(group * DO_GROUP_SIZE) + do_ctz(free_slots);
+            if (obj->ctrl[slot] == DO_CTRL_EMPTY) {
+                obj->growth_left--;
+            }
+            obj->ctrl[slot] = (uint8_t)(hash & 0x7F);
+            obj->slots[slot] = property_index;
             return;
         }
-        // Don't free the data here as it was moved to hash table
+        group = (group + step) & group_mask;
+    }
+}
+
+// Rebuild the index with room for count properties and half as many again, dropping deleted
+// entries from the property array. On failure the object is left as it was.
+static int rebuild_index(do_object obj, int count) {
+    int capacity = DO_GROUP_SIZE * 2;
+    while (capacity / 8 * 7 < count + count / 2 + 1) {
+        capacity *= 2;
+    }
+    // Control bytes and slots share one allocation (capacity is a multiple of 4)
+    uint8_t* ctrl = (uint8_t*)DO_MALLOC((size_t)capacity * (1 + sizeof(uint32_t)));
+    if (!ctrl) return DO_ERROR_MEMORY;
+
+    int len = (int)arrlen(obj->properties);
+    int live = 0;
+    for (int i = 0; i < len; i++) {
+        if (obj->properties[i].key) {
+            obj->properties[live++] = obj->properties[i];
+        }
+    }
+    if (obj->properties) {
+        arrsetlen(obj->properties, live);
+    }
+
+    DO_FREE(obj->ctrl);
+    obj->ctrl = ctrl;
+    obj->slots = (uint32_t*)(ctrl + capacity);
+    obj->capacity = capacity;
+    obj->growth_left = capacity / 8 * 7;
+    obj->deleted_count = 0;
+    memset(ctrl, DO_CTRL_EMPTY, (size_t)capacity);
+    for (int i = 0; i < live; i++) {
+        index_insert(obj, (uint32_t)i, do_key_hash(obj->properties[i].key));
+    }
+    return DO_SUCCESS;
+}
+
+static do_property_t* find_own_property(do_object obj, const char* key) {
+    if (obj->ctrl) {
+        int slot = find_index_slot(obj, key, do_key_hash(key));
+        return slot < 0 ? NULL : &obj->properties[obj->slots[slot]];
+    }
+    do_property_t* props = obj->properties;
+    int len = (int)arrlen(props);
+    for (int i = 0; i < len; i++) {
+        if (props[i].key == key) {  // Pointer equality for interned strings
+            return &props[i];
+        }
+    }
+    return NULL;
+}
+
+static void release_property_data(do_object obj, do_property_t* prop) {
+    if (prop->data) {
+        if (obj->release_fn) {
+            obj->release_fn(prop->data);
+        }
+        DO_FREE(prop->data);
         prop->data = NULL;
     }
-    
-    // Successfully migrated - free the linear array
-    arrfree(linear_props);
 }
 
 /* =============================================================================
@@ -808,8 +995,12 @@ DO_DEF do_object do_create(void (*release_fn)(void*)) {
     DO_ATOMIC_STORE(&obj->ref_count, 1);
     obj->prototype = NULL;
     obj->release_fn = release_fn;
-    obj->properties.linear_props = NULL;
-    obj->is_hashed = 0;
+    obj->properties = NULL;
+    obj->ctrl = NULL;
+    obj->slots = NULL;
+    obj->capacity = 0;
+    obj->growth_left = 0;
+    obj->deleted_count = 0;
     obj->property_count = 0;
     
     return obj;
@@ -837,35 +1028,12 @@ DO_DEF do_object do_retain(do_object obj) {
 }
 
 static void free_properties(do_object obj) {
-    if (obj->is_hashed) {
-        if (obj->properties.hash_props) {
-            // Free each property's data using stb_ds hash map
-            for (int i = 0; i < hmlen(obj->properties.hash_props); i++) {
-                do_property_t* prop = &obj->properties.hash_props[i].value;
-                if (prop->data) {
-                    if (obj->release_fn) {
-                        obj->release_fn(prop->data);
-                    }
-                    DO_FREE(prop->data);
-                }
-            }
-            hmfree(obj->properties.hash_props);
-        }
-    } else {
-        if (obj->properties.linear_props) {
-            int len = arrlen(obj->properties.linear_props);
-            for (int i = 0; i < len; i++) {
-                do_property_t* prop = &obj->properties.linear_props[i];
-                if (prop->data) {
-                    if (obj->release_fn) {
-                        obj->release_fn(prop->data);
-                    }
-                    DO_FREE(prop->data);
-                }
-            }
-            arrfree(obj->properties.linear_props);
-        }
+    int len = (int)arrlen(obj->properties);
+    for (int i = 0; i < len; i++) {
+        release_property_data(obj, &obj->properties[i]);
     }
+    arrfree(obj->properties);
+    DO_FREE(obj->ctrl);
 }
 
 DO_DEF void do_release(do_object* obj) {
@@ -932,16 +1100,6 @@ DO_DEF do_object do_get_prototype(do_object obj) {
  * PROPERTY ACCESS IMPLEMENTATION
  * ============================================================================= */
 
-static void* find_own_property(do_object obj, const char* key) {
-    if (obj->is_hashed) {
-        do_property_t* prop = find_hash_property(obj->properties.hash_props, key);
-        return prop ? prop->data : NULL;
-    } else {
-        do_property_t* prop = find_linear_property(obj->properties.linear_props, key);
-        return prop ? prop->data : NULL;
-    }
-}
-
 DO_DEF void* do_get(do_object obj, const char* key) {
     DO_ASSERT(obj != NULL);
     if (key == NULL) return NULL;  // Handle NULL key gracefully
@@ -956,16 +1114,10 @@ DO_DEF void* do_get_interned(do_object obj, const char* interned_key) {
     DO_ASSERT(obj != NULL);
     DO_ASSERT(interned_key != NULL);
     
-    // Search own properties first
-    void* data = find_own_property(obj, interned_key);
-    if (data) return data;
-    
-    // Search prototype chain
-    do_object current = obj->prototype;
-    while (current) {
-        data = find_own_property(current, interned_key);
-        if (data) return data;
-        current = current->prototype;
+    // Search own properties first, then the prototype chain
+    for (do_object current = obj; current; current = current->prototype) {
+        do_property_t* prop = find_own_property(current, interned_key);
+        if (prop) return prop->data;
     }
     
     return NULL;  // Not found
@@ -987,57 +1139,44 @@ DO_DEF int do_set_interned(do_object obj, const char* interned_key, const void*
     DO_ASSERT(interned_key != NULL);
     DO_ASSERT(data != NULL);
     
-    if (obj->is_hashed) {
-        return set_hash_property(obj, interned_key, data, size);
-    } else {
-        // Check if we need to upgrade to hash table first
-        if (obj->property_count >= DO_HASH_THRESHOLD) {
-            upgrade_to_hash(obj);
-            if (obj->is_hashed) {
-                return set_hash_property(obj, interned_key, data, size);
-            }
-        }
-        
-        // Use linear storage
-        // properties.linear_props is a stb_ds array, no need to initialize
-        
-        // Check if property already exists
-        int len = arrlen(obj->properties.linear_props);
-        
-        for (int i = 0; i < len; i++) {
-            do_property_t* prop = &obj->properties.linear_props[i];
-            if (prop->key == interned_key) {
-                // Update existing property - release old value
-                if (obj->release_fn && prop->data) {
-                    obj->release_fn(prop->data);
-                }
-                if (prop->data) {
-                    DO_FREE(prop->data);
-                }
-                
-                prop->data = DO_MALLOC(size);
-                if (!prop->data) return DO_ERROR_MEMORY;
-                
-                memcpy(prop->data, data, size);
-                prop->size = size;
-                return DO_SUCCESS;
-            }
+    do_property_t* existing = find_own_property(obj, interned_key);
+    if (existing) {
+        // Update existing property - release old value, reusing its storage when the size matches
+        if (existing->size != size || !existing->data) {
+            void* resized = DO_MALLOC(size);
+            if (!resized) return DO_ERROR_MEMORY;
+            release_property_data(obj, existing);
+            existing->data = resized;
+            existing->size = size;
+        } else if (obj->release_fn) {
+            obj->release_fn(existing->data);
         }
-        
-        // Add new property
-        do_property_t new_prop;
-        new_prop.key = interned_key;
-        new_prop.data = DO_MALLOC(size);
-        if (!new_prop.data) return DO_ERROR_MEMORY;
-        
-        memcpy(new_prop.data, data, size);
-        new_prop.size = size;
-        
-        arrput(obj->properties.linear_props, new_prop);
-        obj->property_count++;
-        
+        memmove(existing->data, data, size);
         return DO_SUCCESS;
     }
+    
+    // New property - index the object once it outgrows a linear scan
+    if (obj->ctrl ? obj->growth_left == 0 : obj->property_count >= DO_HASH_THRESHOLD) {
+        if (rebuild_index(obj, obj->property_count + 1) != DO_SUCCESS && obj->ctrl) {
+            return DO_ERROR_MEMORY;
+        }
+    }
+    
+    do_property_t new_prop;
+    new_prop.key = interned_key;
+    new_prop.data = DO_MALLOC(size);
+    if (!new_prop.data) return DO_ERROR_MEMORY;
+    
+    memcpy(new_prop.data, data, size);
+    new_prop.size = size;
+    
+    arrput(obj->properties, new_prop);
+    if (obj->ctrl) {
+        index_insert(obj, (uint32_t)(arrlen(obj->properties) - 1), do_key_hash(interned_key));
+    }
+    obj->property_count++;
+    
+    return DO_SUCCESS;
 }
 
 DO_DEF int do_has(do_object obj, const char* key) {
@@ -1081,52 +1220,47 @@ DO_DEF int do_delete_interned(do_object obj, const char* interned_key) {
     DO_ASSERT(obj != NULL);
     DO_ASSERT(interned_key != NULL);
     
-    if (obj->is_hashed) {
-        if (!obj->properties.hash_props) return 0;
+    if (obj->ctrl) {
+        int slot = find_index_slot(obj, interned_key, do_key_hash(interned_key));
+        if (slot < 0) return 0;
         
-        // Find and delete from stb_ds hash map
-        do_hash_entry_t* entry = hmgetp_null(obj->properties.hash_props, interned_key);
-        if (entry) {
-            // Found - delete it
-            do_property_t* prop = &entry->value;
-            if (obj->release_fn && prop->data) {
-                obj->release_fn(prop->data);
-            }
-            if (prop->data) {
-                DO_FREE(prop->data);
-            }
-            
-            hmdel(obj->properties.hash_props, interned_key);
-            obj->property_count--;
-            return 1;
-        }
+        // Leave a hole in the property array so later indexes stay valid
+        do_property_t* prop = &obj->properties[obj->slots[slot]];
+        release_property_data(obj, prop);
+        prop->key = NULL;
+        obj->deleted_count++;
+        obj->property_count--;
         
-        return 0;
-    } else {
-        if (!obj->properties.linear_props) return 0;
-        
-        int len = arrlen(obj->properties.linear_props);
-        
-        for (int i = 0; i < len; i++) {
-            do_property_t* prop = &obj->properties.linear_props[i];
-            if (prop->key == interned_key) {
-                // Found - delete it
-                if (obj->release_fn && prop->data) {
-                    obj->release_fn(prop->data);
-                }
-                if (prop->data) {
-                    DO_FREE(prop->data);
-                }
-                
-                // Remove from array
-                arrdel(obj->properties.linear_props, i);
-                obj->property_count--;
-                return 1;
-            }
+        // A group that still has an empty slot never sent a probe past it, so the slot can go
+        // back to empty; otherwise it must stay a tombstone until the next rebuild
+        uint8_t* group = obj->ctrl + (slot / DO_GROUP_SIZE) * DO_GROUP_SIZE;
+        if (do_group_match(group, DO_CTRL_EMPTY)) {
+            obj->ctrl[slot] = DO_CTRL_EMPTY;
+            obj->growth_left++;
+        } else {
+            obj->ctrl[slot] = DO_CTRL_DELETED;
         }
         
-        return 0;
+        // Compact once holes outnumber properties (if that fails the holes just stay)
+        if (obj->deleted_count > obj->property_count && obj->deleted_count >= DO_GROUP_SIZE) {
+            rebuild_index(obj, obj->property_count);
+        }
+        return 1;
+    }
+    
+    int len = (int)arrlen(obj->properties);
+    for (int i = 0; i < len; i++) {
+        do_property_t* prop = &obj->properties[i];
+        if (prop->key == interned_key) {
+            // Found - delete it, keeping the rest in order
+            release_property_data(obj, prop);
+            arrdel(obj->properties, i);
+            obj->property_count--;
+            return 1;
+        }
     }
+    
+    return 0;
 }
 
 /* =============================================================================
@@ -1138,28 +1272,15 @@ DO_DEF const char** do_get_own_keys(do_object obj) {
     
     const char** keys = NULL;
     
-    if (obj->is_hashed) {
-        // Hash map iteration using stb_ds
-        if (obj->properties.hash_props) {
-            for (int i = 0; i < hmlen(obj->properties.hash_props); i++) {
-                arrput(keys, obj->properties.hash_props[i].key);
-            }
-        }
-    } else {
-        // Linear array iteration  
-        if (obj->properties.linear_props) {
-            int len = arrlen(obj->properties.linear_props);
-            for (int i = 0; i < len; i++) {
-                const char* key = obj->properties.linear_props[i].key;
-                arrput(keys, key);
-            }
+    // Insertion order, skipping deleted entries
+    int len = (int)arrlen(obj->properties);
+    for (int i = 0; i < len; i++) {
+        if (obj->properties[i].key) {
+            arrput(keys, obj->properties[i].key);
         }
     }
     
-    // Ensure we always return a valid array, even if empty
-    // Note: stb_ds returns NULL for empty arrays, but the test expects a valid pointer
-    // We'll return NULL and fix the test instead
-    
+    // Note: stb_ds returns NULL for empty arrays
     return keys;
 }
 
@@ -1212,22 +1333,12 @@ DO_DEF void do_foreach_property(do_object obj,
     DO_ASSERT(obj != NULL);
     DO_ASSERT(callback != NULL);
     
-    if (obj->is_hashed) {
-        if (obj->properties.hash_props) {
-            // Iterate through stb_ds hash map
-            for (int i = 0; i < hmlen(obj->properties.hash_props); i++) {
-                do_property_t* prop = &obj->properties.hash_props[i].value;
-                callback(obj->properties.hash_props[i].key, prop->data, prop->size, context);
-            }
-        }
-    } else {
-        if (obj->properties.linear_props) {
-            int len = arrlen(obj->properties.linear_props);
-            
-            for (int i = 0; i < len; i++) {
-                do_property_t* prop = &obj->properties.linear_props[i];
-                callback(prop->key, prop->data, prop->size, context);
-            }
+    // Insertion order, skipping deleted entries
+    int len = (int)arrlen(obj->properties);
+    for (int i = 0; i < len; i++) {
+        do_property_t* prop = &obj->properties[i];
+        if (prop->key) {
+            callback(prop->key, prop->data, prop->size, context);
         }
     }
 }
@@ -93,12 +93,23 @@
     #define DS_ATOMIC_FETCH_SUB(ptr, val) atomic_fetch_sub(ptr, val)
     #define DS_ATOMIC_LOAD(ptr) atomic_load(ptr)
     #define DS_ATOMIC_STORE(ptr, val) atomic_store(ptr, val)
+    #define DS_ATOMIC_UINT32 _Atomic uint32_t
+    #define DS_ATOMIC_LOAD_ACQUIRE(ptr) atomic_load_explicit(ptr, memory_order_acquire)
+    #define DS_ATOMIC_STORE_RELEASE(ptr, val) atomic_store_explicit(ptr, val, memory_order_release)
+    #define DS_ATOMIC_PTR(type) _Atomic(type)
+    #define DS_ATOMIC_CAS(ptr, expected, desired) atomic_compare_exchange_strong(ptr, expected, desired)
 #else
     #define DS_ATOMIC_SIZE_T size_t
     #define DS_ATOMIC_FETCH_ADD(ptr, val) (*(ptr) += (val), *(ptr) - (val))
     #define DS_ATOMIC_FETCH_SUB(ptr, val) (*(ptr) -= (val), *(ptr) + (val))
     #define DS_ATOMIC_LOAD(ptr) (*(ptr))
     #define DS_ATOMIC_STORE(ptr, val) (*(ptr) = (val))
+    #define DS_ATOMIC_UINT32 uint32_t
+    #define DS_ATOMIC_LOAD_ACQUIRE(ptr) (*(ptr))
+    #define DS_ATOMIC_STORE_RELEASE(ptr, val) (*(ptr) = (val))
+    #define DS_ATOMIC_PTR(type) type
+    #define DS_ATOMIC_CAS(ptr, expected, desired) \
+        (*(ptr) == *(expected) ? (*(ptr) = (desired), 1) : (*(expected) = *(ptr), 0))
 #endif
 
 #ifdef __cplusplus
@@ -113,11 +124,11 @@ extern "C" {
  * @brief String handle - points directly to null-terminated string data
  *
  * This is a char* that points directly to UTF-8 string data. Metadata
- * (refcount, length) is stored at negative offsets before the string data.
+ * (refcount, length, capacity, cached hash) is stored at negative offsets before the string data.
  * This allows ds_string to be used directly with all C string functions.
  *
- * Memory layout: [refcount|length|string_data|\0]
- *                                ^
+ * Memory layout: [refcount|length|capacity|hash|flags|string_data|\0|spare]
+ *                                                 ^
  *                  ds_string points here
  *
  * @note Use directly with printf, strcmp, fopen, etc. - no conversion needed!
@@ -156,6 +167,13 @@ DS_DEF ds_string ds_new(const char* text);
  */
 DS_DEF ds_string ds_create_length(const char* text, size_t length);
 
+/**
+ * @brief Allocate a string of exactly length bytes for the caller to fill in
+ * @param length Length of the string in bytes (the terminator is written here)
+ * @return New ds_string whose bytes are uninitialized; write all of them before sharing it
+ */
+DS_DEF ds_string ds_new_uninit(size_t length);
+
 /**
  * @brief Increment reference count and return shared handle
  * @param str String to retain (must not be NULL)
@@ -225,6 +243,20 @@ DS_DEF ds_string ds_substring(ds_string str, size_t start, size_t len);
  */
 DS_DEF ds_string ds_concat(ds_string a, ds_string b);
 
+/**
+ * @brief Append bytes to a string by growing its own allocation
+ *
+ * Unlike every other operation this mutates str, so the caller must account for every
+ * reference to it (a refcount of 1, or holders it will point at the result). Capacity grows
+ * geometrically, making a run of appends to the same string linear overall.
+ *
+ * @param str String to extend (must not be NULL)
+ * @param text Bytes to append (may contain NUL)
+ * @param length Number of bytes to append
+ * @return The extended string - str itself unless the allocation moved, when str is invalid
+ */
+DS_DEF ds_string ds_append_in_place(ds_string str, const char* text, size_t length);
+
 /**
  * @brief Join multiple strings with a separator
  * @param strings Array of ds_string to join (may contain NULL entries)
@@ -234,6 +266,34 @@ DS_DEF ds_string ds_concat(ds_string a, ds_string b);
  */
 DS_DEF ds_string ds_join(ds_string* strings, size_t count, const char* separator);
 
+#ifndef DS_POOL_CHUNK
+#define DS_POOL_CHUNK 65536 // Bytes per shared allocation made by ds_slices()
+#endif
+
+/**
+ * @brief A byte range within a string, for ds_slices()
+ */
+typedef struct ds_span {
+    size_t start;
+    size_t length;
+} ds_span;
+
+/**
+ * @brief Copy many byte ranges of text into strings that share pooled allocations
+ *
+ * Pieces are packed into chunks of up to DS_POOL_CHUNK bytes, each a single allocation freed when
+ * its last string is released. Splitting text into many small strings therefore costs one copy
+ * of the text and a few allocations instead of one per piece, and a string that outlives the rest
+ * keeps at most one chunk alive. Pieces too large to share a chunk get their own allocation.
+ * Pooled strings behave like any other; ds_append_in_place() moves one out of its chunk first.
+ *
+ * @param text Source bytes
+ * @param spans Ranges within text
+ * @param count Number of ranges
+ * @param out Receives count new strings, each to be released as usual
+ */
+DS_DEF void ds_slices(const char* text, const ds_span* spans, size_t count, ds_string* out);
+
 // Utility functions (read-only)
 /**
  * @brief Get the length of a string in bytes
@@ -250,6 +310,16 @@ DS_DEF size_t ds_length(ds_string str);
  */
 DS_DEF int ds_compare(ds_string a, ds_string b);
 
+/**
+ * @brief Check two strings for equal contents
+ * @param a First string (must not be NULL)
+ * @param b Second string (must not be NULL)
+ * @return 1 if equal, 0 otherwise
+ * @note Decides on identity, then length, then cached hashes (when both strings have one)
+ *       before comparing bytes, so unequal strings rarely get as far as memcmp
+ */
+DS_DEF int ds_equals(ds_string a, ds_string b);
+
 /**
  * @brief Compare two strings lexicographically (case-insensitive)
  * @param a First string (may be NULL)
@@ -266,6 +336,22 @@ DS_DEF int ds_compare_ignore_case(ds_string a, ds_string b);
  */
 DS_DEF size_t ds_hash(ds_string str);
 
+/**
+ * @brief 32-bit FNV-1a hash of a string, cached in its header
+ * @param str String to hash (must not be NULL)
+ * @return Same value as ds_hash_bytes(str, ds_length(str))
+ * @note The first call computes the hash; later calls on the same string just read it
+ */
+DS_DEF uint32_t ds_hash32(ds_string str);
+
+/**
+ * @brief 32-bit FNV-1a hash of a byte range
+ * @param data Bytes to hash (may be NULL when length is 0)
+ * @param length Number of bytes
+ * @return Hash value, matching ds_hash32 for a string with these contents
+ */
+DS_DEF uint32_t ds_hash_bytes(const char* data, size_t length);
+
 /**
  * @brief Find the first occurrence of a substring
  * @param str String to search in (may be NULL)
@@ -542,21 +628,49 @@ DS_DEF uint32_t ds_iter_next(ds_codepoint_iter* iter);
 DS_DEF int ds_iter_has_next(const ds_codepoint_iter* iter);
 
 // Unicode utility functions
+/**
+ * @brief Check whether a string is pure 7-bit ASCII, so byte and codepoint positions coincide
+ * @param str String to check (must not be NULL)
+ * @return 1 if every byte is below 0x80, 0 otherwise
+ * @note The answer is cached in the string after the first scan
+ */
+DS_DEF int ds_is_ascii(ds_string str);
+
 /**
  * @brief Count the number of Unicode codepoints in a string
- * @param str String to count (may be NULL)
- * @return Number of codepoints, or 0 if str is NULL
+ * @param str String to count (must not be NULL)
+ * @return Number of codepoints
+ * @note A lead byte claims as many bytes as it announces (clamped at the end of the string) and any
+ *       other byte counts as one codepoint. O(1) for ASCII strings, O(n) once and then O(1) otherwise
  */
 DS_DEF size_t ds_codepoint_length(ds_string str);
 
 /**
  * @brief Get Unicode codepoint at specific index
- * @param str String to access (may be NULL)
+ * @param str String to access (must not be NULL)
  * @param index Codepoint index (0-based)
  * @return Codepoint at index, or 0 if index is out of bounds
  */
 DS_DEF uint32_t ds_codepoint_at(ds_string str, size_t index);
 
+/**
+ * @brief Byte offset where a codepoint starts
+ * @param str String to access (must not be NULL)
+ * @param index Codepoint index (0-based)
+ * @return Byte offset of the codepoint, or the byte length if index is at or past the end
+ * @note Near-constant time: the first non-ASCII lookup builds a sparse index with one entry every
+ *       DS_CHAR_INDEX_STRIDE codepoints, kept with the string until it is freed
+ */
+DS_DEF size_t ds_codepoint_offset(ds_string str, size_t index);
+
+/**
+ * @brief Codepoint index of a byte offset, the inverse of ds_codepoint_offset
+ * @param str String to access (must not be NULL)
+ * @param offset Byte offset
+ * @return Number of codepoints that start before offset
+ */
+DS_DEF size_t ds_codepoint_index(ds_string str, size_t offset);
+
 // Convenience macros for common operations
 #define ds_empty() ds_new("")
 #define ds_from_literal(lit) ds_new(lit)
@@ -912,6 +1026,29 @@ DS_DEF int ds_builder_append_double(ds_builder sb, double value, int precision);
  */
 DS_DEF int ds_builder_append_length(ds_builder sb, const char* text, size_t length);
 
+/**
+ * @brief Make room to write up to max_length bytes at the end of StringBuilder
+ * @param sb StringBuilder to append to (must not be NULL)
+ * @param max_length Most bytes the caller will write
+ * @return Where to write them, or NULL on failure; valid until the next call on sb
+ *
+ * Lets formatters write straight into the builder. Follow with ds_builder_commit() giving the
+ * number of bytes actually written.
+ *
+ * @code
+ * char* at = ds_builder_reserve(sb, 16);
+ * ds_builder_commit(sb, format_into(at, value));
+ * @endcode
+ */
+DS_DEF char* ds_builder_reserve(ds_builder sb, size_t max_length);
+
+/**
+ * @brief Add bytes written after ds_builder_reserve() to StringBuilder's content
+ * @param sb StringBuilder (must not be NULL)
+ * @param length Bytes written, at most the reserved max_length
+ */
+DS_DEF void ds_builder_commit(ds_builder sb, size_t length);
+
 /**
  * @brief Prepend text to the beginning of StringBuilder
  * @param sb StringBuilder to prepend to (must not be NULL)
@@ -1106,8 +1243,36 @@ DS_DEF const char* ds_builder_cstr(ds_builder sb);
 typedef struct ds_internal {
     DS_ATOMIC_SIZE_T refcount;
     size_t length;
+    size_t capacity; // Bytes of string data the block can hold, excluding the null terminator
+    uint32_t hash;   // ds_hash32, valid while DS_FLAG_HASHED is set
+    DS_ATOMIC_UINT32 flags;
+    DS_ATOMIC_PTR(struct ds_char_index*) chars; // Built by ds_codepoint_offset for non-ASCII strings
 } ds_internal;
 
+#define DS_FLAG_HASHED 1u
+#define DS_FLAG_POOLED 2u // Lives in a ds_pool_chunk (see ds_slices), whose address precedes the header
+#define DS_FLAG_ASCII_KNOWN 4u
+#define DS_FLAG_ASCII 8u // Valid while DS_FLAG_ASCII_KNOWN is set
+
+#ifndef DS_CHAR_INDEX_STRIDE
+#define DS_CHAR_INDEX_STRIDE 32
+#endif
+
+/**
+ * @brief Sparse codepoint index of a non-ASCII string
+ */
+typedef struct ds_char_index {
+    size_t count;     // Codepoints in the string
+    size_t offsets[]; // Byte offset of codepoint k * DS_CHAR_INDEX_STRIDE
+} ds_char_index;
+
+/**
+ * @brief Shared allocation holding pooled strings, each laid out as [chunk*|ds_internal|data|\0]
+ */
+typedef struct ds_pool_chunk {
+    DS_ATOMIC_SIZE_T refcount; // Live strings in the chunk
+} ds_pool_chunk;
+
 // ============================================================================
 // INTERNAL HELPER FUNCTIONS
 // ============================================================================
@@ -1119,6 +1284,36 @@ typedef struct ds_internal {
  */
 static ds_internal* ds_meta(ds_string str) { return (ds_internal*)(str - sizeof(ds_internal)); }
 
+/**
+ * @brief Check that no byte has its high bit set, a word at a time
+ */
+static int ds_bytes_are_ascii(const char* data, size_t length) {
+    size_t i = 0;
+    uint64_t high = 0;
+    // Four independent words per step so the loop vectorizes
+    for (; i + 32 <= length; i += 32) {
+        uint64_t w[4];
+        memcpy(w, data + i, sizeof(w));
+        high |= (w[0] | w[1] | w[2] | w[3]) & 0x8080808080808080ull;
+        if (high)
+            return 0;
+    }
+    for (; i + 8 <= length; i += 8) {
+        uint64_t w;
+        memcpy(&w, data + i, sizeof(w));
+        high |= w & 0x8080808080808080ull;
+    }
+    for (; i < length; i++) {
+        high |= (unsigned char)data[i] & 0x80u;
+    }
+    return high == 0;
+}
+
+/**
+ * @brief Byte length of the UTF-8 sequence a lead byte announces, at least 1
+ */
+static size_t ds_utf8_width(unsigned char lead) { return lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1; }
+
 /**
  * @brief Allocate memory for string with metadata
  * @param length Length of string data in bytes
@@ -1133,6 +1328,10 @@ static ds_string ds_alloc(size_t length) {
     ds_internal* meta = block;
     DS_ATOMIC_STORE(&meta->refcount, 1);
     meta->length = length;
+    meta->capacity = length;
+    meta->hash = 0;
+    DS_ATOMIC_STORE(&meta->flags, 0);
+    DS_ATOMIC_STORE(&meta->chars, NULL);
 
     // Return pointer to string data portion
     ds_string str = (char*)block + sizeof(ds_internal);
@@ -1147,9 +1346,22 @@ static ds_string ds_alloc(size_t length) {
  */
 static void ds_dealloc(ds_string str) {
     if (str) {
+        ds_internal* meta = ds_meta(str);
+        struct ds_char_index* chars = DS_ATOMIC_LOAD(&meta->chars);
+        if (chars) {
+            DS_FREE(chars);
+        }
+        if (DS_ATOMIC_LOAD(&meta->flags) & DS_FLAG_POOLED) {
+            // The chunk goes with its last string
+            ds_pool_chunk* chunk;
+            memcpy(&chunk, (char*)meta - sizeof(chunk), sizeof(chunk));
+            if (DS_ATOMIC_FETCH_SUB(&chunk->refcount, 1) == 1) {
+                DS_FREE(chunk);
+            }
+            return;
+        }
         // Get original malloc pointer and free it
-        void* block = str - sizeof(ds_internal);
-        DS_FREE(block);
+        DS_FREE(meta);
     }
 }
 
@@ -1187,9 +1399,10 @@ DS_DEF ds_string ds_new(const char* text) {
 DS_DEF ds_string ds_create_length(const char* text, size_t length) {
     DS_ASSERT(text && "ds_create_length: text cannot be NULL");
     
-    size_t text_len = strlen(text);
-    size_t actual_len = text_len < length ? text_len : length;
-    
+    // Stops at an embedded null, like strlen, but never reads past length
+    const char* nul = memchr(text, '\0', length);
+    size_t actual_len = nul ? (size_t)(nul - text) : length;
+
     ds_string str = ds_alloc(actual_len);
 
     if (actual_len > 0) {
@@ -1199,6 +1412,10 @@ DS_DEF ds_string ds_create_length(const char* text, size_t length) {
     return str;
 }
 
+DS_DEF ds_string ds_new_uninit(size_t length) {
+    return ds_alloc(length);
+}
+
 DS_DEF ds_string ds_retain(ds_string str) {
     DS_ASSERT(str && "ds_retain: str cannot be NULL");
     DS_ATOMIC_FETCH_ADD(&ds_meta(str)->refcount, 1);
@@ -1353,9 +1570,114 @@ DS_DEF ds_string ds_concat(ds_string a, ds_string b) {
     memcpy(result, a, ds_meta(a)->length);
     memcpy(result + ds_meta(a)->length, b, ds_meta(b)->length);
 
+    // Two known-ASCII halves make a known-ASCII whole
+    uint32_t ascii = DS_FLAG_ASCII_KNOWN | DS_FLAG_ASCII;
+    if ((DS_ATOMIC_LOAD_ACQUIRE(&ds_meta(a)->flags) & DS_ATOMIC_LOAD_ACQUIRE(&ds_meta(b)->flags) & ascii) == ascii) {
+        DS_ATOMIC_STORE(&ds_meta(result)->flags, ascii);
+    }
+
     return result;
 }
 
+DS_DEF ds_string ds_append_in_place(ds_string str, const char* text, size_t length) {
+    DS_ASSERT(str && "ds_append_in_place: str cannot be NULL");
+    DS_ASSERT((text || length == 0) && "ds_append_in_place: text cannot be NULL");
+
+    ds_internal* meta = ds_meta(str);
+    size_t new_length = meta->length + length;
+    int self_append = text == str; // s + s: the source moves along with the destination
+    if (length > 0 && (DS_ATOMIC_LOAD(&meta->flags) & DS_FLAG_POOLED)) {
+        // A pooled string can't grow inside its chunk: move it to an allocation of its own. Like a
+        // realloc below, the move takes every reference along, since the caller repoints them all.
+        ds_string own = ds_alloc(meta->length);
+        memcpy(own, str, meta->length);
+        DS_ATOMIC_STORE(&ds_meta(own)->refcount, DS_ATOMIC_LOAD(&meta->refcount));
+        ds_dealloc(str);
+        str = own;
+        meta = ds_meta(str);
+    }
+    if (new_length > meta->capacity) {
+        size_t new_capacity = meta->capacity < 16 ? 16 : meta->capacity;
+        while (new_capacity < new_length) {
+            new_capacity *= 2;
+        }
+        void* block = DS_REALLOC(meta, sizeof(ds_internal) + new_capacity + 1);
+        DS_ASSERT(block && "Memory re-allocation failed");
+        meta = block;
+        meta->capacity = new_capacity;
+        str = (char*)block + sizeof(ds_internal);
+    }
+
+    memcpy(str + meta->length, self_append ? str : text, length);
+    size_t old_length = meta->length;
+    meta->length = new_length;
+    str[new_length] = '\0';
+
+    // Keep a known ASCII answer by checking only the appended bytes
+    uint32_t flags = DS_ATOMIC_LOAD(&meta->flags) & ~DS_FLAG_HASHED;
+    if ((flags & DS_FLAG_ASCII) && !ds_bytes_are_ascii(str + old_length, length)) {
+        flags &= ~DS_FLAG_ASCII;
+    }
+    DS_ATOMIC_STORE(&meta->flags, flags);
+    struct ds_char_index* chars = DS_ATOMIC_LOAD(&meta->chars);
+    if (chars) {
+        DS_FREE(chars);
+        DS_ATOMIC_STORE(&meta->chars, NULL);
+    }
+    return str;
+}
+
+#define DS_POOL_ALIGN(n) (((n) + 7) & ~(size_t)7)
+
+static size_t ds_pool_block_size(size_t length) {
+    return DS_POOL_ALIGN(sizeof(ds_pool_chunk*) + sizeof(ds_internal) + length + 1);
+}
+
+DS_DEF void ds_slices(const char* text, const ds_span* spans, size_t count, ds_string* out) {
+    DS_ASSERT((text || count == 0) && "ds_slices: text cannot be NULL");
+
+    size_t i = 0;
+    while (i < count) {
+        if (ds_pool_block_size(spans[i].length) > DS_POOL_CHUNK / 8) {
+            out[i] = ds_alloc(spans[i].length);
+            memcpy(out[i], text + spans[i].start, spans[i].length);
+            i++;
+            continue;
+        }
+
+        // The run of small pieces that fits in one chunk
+        size_t end = i;
+        size_t size = DS_POOL_ALIGN(sizeof(ds_pool_chunk));
+        while (end < count) {
+            size_t block = ds_pool_block_size(spans[end].length);
+            if (block > DS_POOL_CHUNK / 8 || size + block > DS_POOL_CHUNK) break;
+            size += block;
+            end++;
+        }
+
+        ds_pool_chunk* chunk = DS_MALLOC(size);
+        DS_ASSERT(chunk && "Memory allocation failed");
+        DS_ATOMIC_STORE(&chunk->refcount, end - i);
+        char* at = (char*)chunk + DS_POOL_ALIGN(sizeof(ds_pool_chunk));
+        for (; i < end; i++) {
+            size_t length = spans[i].length;
+            memcpy(at, &chunk, sizeof(chunk));
+            ds_internal* meta = (ds_internal*)(at + sizeof(chunk));
+            DS_ATOMIC_STORE(&meta->refcount, 1);
+            meta->length = length;
+            meta->capacity = length;
+            meta->hash = 0;
+            DS_ATOMIC_STORE(&meta->flags, DS_FLAG_POOLED);
+            DS_ATOMIC_STORE(&meta->chars, NULL);
+            ds_string str = (char*)meta + sizeof(ds_internal);
+            memcpy(str, text + spans[i].start, length);
+            str[length] = '\0';
+            out[i] = str;
+            at += ds_pool_block_size(length);
+        }
+    }
+}
+
 DS_DEF ds_string ds_join(ds_string* strings, size_t count, const char* separator) {
     DS_ASSERT(strings && "ds_join: strings cannot be NULL");
     
@@ -1395,6 +1717,24 @@ DS_DEF int ds_compare(ds_string a, ds_string b) {
     return strcmp(a, b);
 }
 
+DS_DEF int ds_equals(ds_string a, ds_string b) {
+    DS_ASSERT(a && "ds_equals: a cannot be NULL");
+    DS_ASSERT(b && "ds_equals: b cannot be NULL");
+
+    if (a == b)
+        return 1;
+
+    ds_internal* a_meta = ds_meta(a);
+    ds_internal* b_meta = ds_meta(b);
+    if (a_meta->length != b_meta->length)
+        return 0;
+    if ((DS_ATOMIC_LOAD_ACQUIRE(&a_meta->flags) & DS_ATOMIC_LOAD_ACQUIRE(&b_meta->flags) & DS_FLAG_HASHED) &&
+        a_meta->hash != b_meta->hash)
+        return 0;
+
+    return memcmp(a, b, a_meta->length) == 0;
+}
+
 DS_DEF int ds_compare_ignore_case(ds_string a, ds_string b) {
     DS_ASSERT(a && "ds_compare_ignore_case: a cannot be NULL");
     DS_ASSERT(b && "ds_compare_ignore_case: b cannot be NULL");
@@ -1438,6 +1778,32 @@ DS_DEF size_t ds_hash(ds_string str) {
     return hash;
 }
 
+DS_DEF uint32_t ds_hash_bytes(const char* data, size_t length) {
+    DS_ASSERT((data || length == 0) && "ds_hash_bytes: data cannot be NULL");
+
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+DS_DEF uint32_t ds_hash32(ds_string str) {
+    DS_ASSERT(str && "ds_hash32: str cannot be NULL");
+
+    ds_internal* meta = ds_meta(str);
+    uint32_t flags = DS_ATOMIC_LOAD_ACQUIRE(&meta->flags);
+    if (flags & DS_FLAG_HASHED)
+        return meta->hash;
+
+    // Racing threads compute the same value, so either store wins
+    uint32_t hash = ds_hash_bytes(str, meta->length);
+    meta->hash = hash;
+    DS_ATOMIC_STORE_RELEASE(&meta->flags, flags | DS_FLAG_HASHED);
+    return hash;
+}
+
 DS_DEF int ds_find(ds_string str, const char* needle) {
     DS_ASSERT(str && "ds_find: str cannot be NULL");
     DS_ASSERT(needle && "ds_find: needle cannot be NULL");
@@ -2104,34 +2470,129 @@ DS_DEF uint32_t ds_iter_next(ds_codepoint_iter* iter) {
 
 DS_DEF int ds_iter_has_next(const ds_codepoint_iter* iter) { return iter && iter->pos < iter->end; }
 
-DS_DEF size_t ds_codepoint_length(ds_string str) {
-    DS_ASSERT(str && "ds_codepoint_length: str cannot be NULL");
+DS_DEF int ds_is_ascii(ds_string str) {
+    DS_ASSERT(str && "ds_is_ascii: str cannot be NULL");
 
-    ds_codepoint_iter iter = ds_codepoints(str);
+    ds_internal* meta = ds_meta(str);
+    uint32_t flags = DS_ATOMIC_LOAD_ACQUIRE(&meta->flags);
+    if (!(flags & DS_FLAG_ASCII_KNOWN)) {
+        // Racing threads compute the same answer, so either store wins
+        flags |= DS_FLAG_ASCII_KNOWN | (ds_bytes_are_ascii(str, meta->length) ? DS_FLAG_ASCII : 0);
+        DS_ATOMIC_STORE_RELEASE(&meta->flags, flags);
+    }
+    return (flags & DS_FLAG_ASCII) != 0;
+}
+
+/**
+ * @brief The codepoint index of a non-ASCII string, built on first use
+ */
+static ds_char_index* ds_chars(ds_string str) {
+    ds_internal* meta = ds_meta(str);
+    ds_char_index* chars = DS_ATOMIC_LOAD(&meta->chars);
+    if (chars)
+        return chars;
+
+    // Sized for the worst case of one byte per codepoint, then trimmed
+    size_t length = meta->length;
+    chars = DS_MALLOC(sizeof(ds_char_index) + (length / DS_CHAR_INDEX_STRIDE + 1) * sizeof(size_t));
+    DS_ASSERT(chars && "Memory allocation failed");
     size_t count = 0;
+    for (size_t pos = 0; pos < length; count++) {
+        if (count % DS_CHAR_INDEX_STRIDE == 0) {
+            chars->offsets[count / DS_CHAR_INDEX_STRIDE] = pos;
+        }
+        size_t width = ds_utf8_width((unsigned char)str[pos]);
+        pos += width < length - pos ? width : length - pos;
+    }
+    if (count % DS_CHAR_INDEX_STRIDE == 0) {
+        chars->offsets[count / DS_CHAR_INDEX_STRIDE] = length;
+    }
+    chars->count = count;
+    ds_char_index* trimmed =
+        DS_REALLOC(chars, sizeof(ds_char_index) + (count / DS_CHAR_INDEX_STRIDE + 1) * sizeof(size_t));
+    if (trimmed) {
+        chars = trimmed;
+    }
 
-    while (ds_iter_next(&iter) != 0) {
-        count++;
+    // Publish it unless another thread got there first
+    ds_char_index* expected = NULL;
+    if (!DS_ATOMIC_CAS(&meta->chars, &expected, chars)) {
+        DS_FREE(chars);
+        return expected;
     }
+    return chars;
+}
 
-    return count;
+DS_DEF size_t ds_codepoint_length(ds_string str) {
+    DS_ASSERT(str && "ds_codepoint_length: str cannot be NULL");
+
+    if (ds_is_ascii(str))
+        return ds_meta(str)->length;
+    return ds_chars(str)->count;
 }
 
-DS_DEF uint32_t ds_codepoint_at(ds_string str, size_t index) {
-    DS_ASSERT(str && "ds_codepoint_at: str cannot be NULL");
+DS_DEF size_t ds_codepoint_offset(ds_string str, size_t index) {
+    DS_ASSERT(str && "ds_codepoint_offset: str cannot be NULL");
 
-    ds_codepoint_iter iter = ds_codepoints(str);
-    size_t current_index = 0;
-    uint32_t codepoint;
+    size_t length = ds_meta(str)->length;
+    if (ds_is_ascii(str))
+        return index < length ? index : length;
+
+    ds_char_index* chars = ds_chars(str);
+    if (index >= chars->count)
+        return length;
+
+    // Start from the nearest indexed codepoint and step over at most DS_CHAR_INDEX_STRIDE - 1 more
+    size_t pos = chars->offsets[index / DS_CHAR_INDEX_STRIDE];
+    for (size_t skip = index % DS_CHAR_INDEX_STRIDE; skip > 0; skip--) {
+        size_t width = ds_utf8_width((unsigned char)str[pos]);
+        pos += width < length - pos ? width : length - pos;
+    }
+    return pos;
+}
+
+DS_DEF size_t ds_codepoint_index(ds_string str, size_t offset) {
+    DS_ASSERT(str && "ds_codepoint_index: str cannot be NULL");
 
-    while ((codepoint = ds_iter_next(&iter)) != 0) {
-        if (current_index == index) {
-            return codepoint;
+    size_t length = ds_meta(str)->length;
+    if (offset > length)
+        offset = length;
+    if (ds_is_ascii(str))
+        return offset;
+
+    // Last indexed codepoint at or before offset
+    ds_char_index* chars = ds_chars(str);
+    size_t low = 0;
+    size_t high = (chars->count + DS_CHAR_INDEX_STRIDE - 1) / DS_CHAR_INDEX_STRIDE;
+    while (low + 1 < high) {
+        size_t mid = low + (high - low) / 2;
+        if (chars->offsets[mid] <= offset) {
+            low = mid;
+        } else {
+            high = mid;
         }
-        current_index++;
     }
 
-    return 0;
+    size_t index = low * DS_CHAR_INDEX_STRIDE;
+    size_t pos = chars->offsets[low];
+    while (pos < offset) {
+        size_t width = ds_utf8_width((unsigned char)str[pos]);
+        pos += width < length - pos ? width : length - pos;
+        index++;
+    }
+    return index;
+}
+
+DS_DEF uint32_t ds_codepoint_at(ds_string str, size_t index) {
+    DS_ASSERT(str && "ds_codepoint_at: str cannot be NULL");
+
+    size_t length = ds_meta(str)->length;
+    size_t pos = ds_codepoint_offset(str, index);
+    if (pos >= length)
+        return 0;
+
+    size_t bytes_consumed;
+    return ds_decode_utf8_at(str, pos, length, &bytes_consumed);
 }
 
 // ============================================================================
@@ -2167,6 +2628,7 @@ static int ds_sb_ensure_capacity(ds_builder sb, size_t required_capacity) {
 
     sb->data = (char*)new_block + sizeof(ds_internal);
     sb->capacity = new_capacity;
+    ((ds_internal*)new_block)->capacity = new_capacity - 1;
     return 1;
 }
 
@@ -2219,6 +2681,10 @@ DS_DEF ds_builder ds_builder_create_with_capacity(size_t capacity) {
     ds_internal* meta = (ds_internal*)block;
     DS_ATOMIC_STORE(&meta->refcount, 1);
     meta->length = 0;
+    meta->capacity = capacity - 1;
+    meta->hash = 0;
+    DS_ATOMIC_STORE(&meta->flags, 0);
+    DS_ATOMIC_STORE(&meta->chars, NULL);
 
     sb->data = (char*)block + sizeof(ds_internal);
     sb->data[0] = '\0';
@@ -2369,6 +2835,7 @@ DS_DEF ds_string ds_builder_to_string(ds_builder sb) {
     if (shrunk_block) {
         result = (char*)shrunk_block + sizeof(ds_internal);
         meta = (ds_internal*)shrunk_block;
+        meta->capacity = meta->length;
     } else {
         result = sb->data; // Use original if realloc failed
     }
@@ -2438,19 +2905,32 @@ DS_DEF int ds_builder_append_format_v(ds_builder sb, const char* fmt, va_list ar
 }
 
 // Numeric append functions
+
+// Decimal digits written from the end of a stack buffer, skipping vsnprintf's two passes
+static int ds_sb_append_decimal(ds_builder sb, unsigned long magnitude, int negative) {
+    char digits[24];
+    char* p = digits + sizeof(digits);
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+    if (negative) *--p = '-';
+    return ds_builder_append_length(sb, p, (size_t)(digits + sizeof(digits) - p));
+}
+
 DS_DEF int ds_builder_append_int(ds_builder sb, int value) {
     DS_ASSERT(sb && "ds_builder_append_int: sb cannot be NULL");
-    return ds_builder_append_format(sb, "%d", value);
+    return ds_sb_append_decimal(sb, value < 0 ? 0ul - (unsigned long)value : (unsigned long)value, value < 0);
 }
 
 DS_DEF int ds_builder_append_uint(ds_builder sb, unsigned int value) {
     DS_ASSERT(sb && "ds_builder_append_uint: sb cannot be NULL");
-    return ds_builder_append_format(sb, "%u", value);
+    return ds_sb_append_decimal(sb, value, 0);
 }
 
 DS_DEF int ds_builder_append_long(ds_builder sb, long value) {
     DS_ASSERT(sb && "ds_builder_append_long: sb cannot be NULL");
-    return ds_builder_append_format(sb, "%ld", value);
+    return ds_sb_append_decimal(sb, value < 0 ? 0ul - (unsigned long)value : (unsigned long)value, value < 0);
 }
 
 DS_DEF int ds_builder_append_double(ds_builder sb, double value, int precision) {
@@ -2480,6 +2960,27 @@ DS_DEF int ds_builder_append_length(ds_builder sb, const char* text, size_t leng
     return 1;
 }
 
+DS_DEF char* ds_builder_reserve(ds_builder sb, size_t max_length) {
+    DS_ASSERT(sb && "ds_builder_reserve: sb cannot be NULL");
+    DS_ASSERT(sb->data && "ds_builder_reserve: sb->data cannot be NULL");
+
+    if (!ds_sb_ensure_unique(sb)) return NULL;
+
+    ds_internal* meta = ds_meta(sb->data);
+    if (!ds_sb_ensure_capacity(sb, meta->length + max_length + 1)) return NULL;
+
+    return sb->data + ds_meta(sb->data)->length;
+}
+
+DS_DEF void ds_builder_commit(ds_builder sb, size_t length) {
+    DS_ASSERT(sb && "ds_builder_commit: sb cannot be NULL");
+
+    ds_internal* meta = ds_meta(sb->data);
+    DS_ASSERT(meta->length + length < sb->capacity && "ds_builder_commit: more than was reserved");
+    meta->length += length;
+    sb->data[meta->length] = '\0';
+}
+
 DS_DEF int ds_builder_prepend(ds_builder sb, const char* text) {
     DS_ASSERT(sb && "ds_builder_prepend: sb cannot be NULL");
     DS_ASSERT(text && "ds_builder_prepend: text cannot be NULL");
@@ -0,0 +1,95 @@
+#ifndef SLATE_AOT_H
+#define SLATE_AOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "vm.h"
+#include "../src/opcodes/opcodes.h"
+
+// Ahead-of-time compilation (slate --emit-c).
+//
+// The emitter (codegen_emit_c) compiles a script as usual and writes the resulting function
+// tree out as a C file: the bytecode and constants of every function as static data, plus one
+// C function per Slate function that calls the op_* handlers in sequence with the jumps resolved
+// to gotos. Linked against slate_runtime, aot_main() rebuilds the function table, attaches the
+// native bodies and runs main exactly as `slate file.sl` would.
+//
+// The bytecode stays attached to every function, so anything that enters a function through the
+// interpreter (callbacks from builtins, vm_call_function) still runs it correctly.
+
+typedef enum {
+    AOT_CONST_NULL,
+    AOT_CONST_INT32,
+    AOT_CONST_FLOAT32,
+    AOT_CONST_FLOAT64,
+    AOT_CONST_BIGINT, // Decimal digits in text
+    AOT_CONST_STRING
+} aot_constant_kind;
+
+typedef struct {
+    aot_constant_kind kind;
+    int32_t int32;
+    uint64_t bits; // IEEE-754 bits of the float64 (float32 constants widen exactly)
+    const char* text;
+    size_t length;
+} aot_constant;
+
+typedef struct {
+    const char* name;
+    const uint8_t* bytecode;
+    size_t bytecode_length;
+    const aot_constant* constants;
+    size_t constant_count;
+    const char* const* parameter_names;
+    size_t parameter_count;
+    size_t local_count;
+    const upvalue_desc_t* upvalue_descriptors;
+    size_t upvalue_count;
+    int is_generator;
+    vm_result (*native)(vm_t* vm, size_t depth); // NULL for generators, which only run in the interpreter
+} aot_function;
+
+typedef struct aot_program {
+    const aot_function* functions; // Function table entries in index order
+    size_t function_count;
+    size_t first_function; // Function table index of functions[0] when the program was compiled
+    const aot_function* main;
+} aot_program;
+
+// Set up a VM like file mode does, load the program and run it. Returns the process exit code.
+int aot_main(const aot_program* program, int argc, char** argv);
+
+// Add the program's functions to a fresh VM and return its main function (NULL if the VM's
+// builtins don't line up with the ones the program was compiled against)
+function_t* aot_load(vm_t* vm, const aot_program* program);
+
+// A handler pushed a call frame: run the callee (natively if it has a body) until it returns
+vm_result aot_run_callee(vm_t* vm, size_t caller_depth);
+
+// Instruction helpers used by the generated code. `code` is the running function's bytecode
+// and `depth` the frame count while it is on top.
+#define AOT_STEP(offset, handler)                                            \
+    do {                                                                     \
+        vm->current_instruction = code + (offset);                           \
+        vm->ip = code + (offset) + 1;                                        \
+        vm_result aot_result = handler(vm);                                  \
+        if (aot_result != VM_OK) return aot_result;                          \
+    } while (0)
+
+#define AOT_CALL(offset, handler)                                            \
+    do {                                                                     \
+        AOT_STEP(offset, handler);                                           \
+        if (vm->frame_count != depth) {                                      \
+            vm_result aot_result = aot_run_callee(vm, depth);                \
+            if (aot_result != VM_OK) return aot_result;                      \
+        }                                                                    \
+    } while (0)
+
+// Conditional jumps: the handler moved ip past the fallthrough if the branch was taken
+#define AOT_BRANCH(offset, handler, target)                                  \
+    do {                                                                     \
+        AOT_STEP(offset, handler);                                           \
+        if (vm->ip != code + (offset) + 3) goto L_##target;                  \
+    } while (0)
+
+#endif // SLATE_AOT_H
@@ -60,6 +60,7 @@ typedef enum {
     AST_BREAK,
     AST_CONTINUE,
     AST_RETURN,
+    AST_YIELD,
     AST_EXPRESSION_STMT,
     AST_BLOCK,
 
@@ -230,6 +231,7 @@ typedef struct {
     size_t param_count;
     ast_node* body; // Block statement or expression
     int is_expression; // 1 if body is expression, 0 if block
+    int is_generator; // Body contains yield: calling it returns an Iterator
 } ast_function;
 
 // Function call node
@@ -355,6 +357,12 @@ typedef struct {
     ast_node* value; // May be NULL
 } ast_return;
 
+// Yield expression node (suspends the enclosing generator, evaluates to null when resumed)
+typedef struct {
+    ast_node base;
+    ast_node* value;
+} ast_yield;
+
 // Expression statement node
 typedef struct {
     ast_node base;
@@ -466,6 +474,7 @@ ast_loop* ast_create_loop(ast_node* body, int line, int column);
 ast_break* ast_create_break(int line, int column);
 ast_continue* ast_create_continue(int line, int column);
 ast_return* ast_create_return(ast_node* value, int line, int column);
+ast_yield* ast_create_yield(ast_node* value, int line, int column);
 
 ast_expression_stmt* ast_create_expression_stmt(ast_node* expression, int line, int column);
 ast_block* ast_create_block(ast_node** statements, size_t statement_count, int line, int column);
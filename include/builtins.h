@@ -145,11 +145,11 @@ value_t builtin_write_file(vm_t* vm, int arg_count, value_t* args);
 void register_builtin(vm_t* vm, const char* name, native_t func, int min_args, int max_args);
 
 // Global class references (for use in make_* functions)
-extern value_t* global_value_class;
-extern value_t* global_string_class;
-extern value_t* global_array_class;
-extern value_t* global_string_builder_class;
-extern value_t* global_buffer_class;
-extern value_t* global_int_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_value_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_string_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_array_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_string_builder_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_buffer_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_int_class;
 
 #endif // SLATE_BUILTINS_H
\ No newline at end of file
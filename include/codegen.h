@@ -3,6 +3,7 @@
 
 #include "ast.h"
 #include "vm.h"
+#include <stdio.h>
 
 // Debug info entry mapping bytecode offset to source position
 typedef struct {
@@ -28,6 +29,7 @@ typedef struct {
     size_t constant_count;
     size_t constant_capacity;
     debug_info* debug; // Optional debug information (NULL if disabled)
+    char* local_types; // Inferred local types for the disassembler, e.g. "i: Int, s: String" (NULL if none)
 } bytecode_chunk;
 
 // Loop types for different continue behaviors
@@ -51,6 +53,30 @@ typedef struct {
     size_t continue_jump_capacity;
 } loop_context_t;
 
+// Static types proven by the local type inference pass (see types.c)
+typedef enum {
+    STATIC_TYPE_NONE,    // No assignment seen yet (fixpoint starting point)
+    STATIC_TYPE_UNKNOWN, // Anything - generic opcodes
+    STATIC_TYPE_INT,     // int32, promoted to BigInt on overflow
+    STATIC_TYPE_FLOAT64,
+    STATIC_TYPE_STRING,
+    STATIC_TYPE_ARRAY,
+    STATIC_TYPE_BOOLEAN
+} static_type;
+
+// Inferred type of every name assigned in the function being compiled
+typedef struct {
+    char* name;
+    static_type type;
+    bool captured; // Mentioned from a nested function, which can read or write it at any call
+} type_binding_t;
+
+typedef struct {
+    type_binding_t* bindings;
+    int count;
+    int capacity;
+} type_env_t;
+
 // Local variable tracking for scope management
 typedef struct {
     char* name;           // Variable name
@@ -58,6 +84,7 @@ typedef struct {
     int slot;            // Stack slot index
     int is_initialized; // Has been initialized
     int is_immutable;   // 1 for val, 0 for var
+    static_type type;   // Inferred type of every value the slot can hold
 } local_var_t;
 
 // Upvalue tracking for closures
@@ -94,6 +121,8 @@ struct codegen {
     size_t loop_capacity;          // Capacity of loop_contexts array
     // Scope and local variable management
     scope_manager_t scope;         // Scope and variable tracking
+    type_env_t types;              // Inferred local types for this function
+    int is_generator;              // Compiling a generator body (may suspend at any yield)
 };
 
 // Debug info functions
@@ -136,6 +165,7 @@ void codegen_emit_unary_op(codegen_t* codegen, ast_unary_op* node);
 void codegen_emit_array(codegen_t* codegen, ast_array* node);
 void codegen_emit_object(codegen_t* codegen, ast_object_literal* node);
 void codegen_emit_function(codegen_t* codegen, ast_function* node);
+void codegen_emit_local_function(codegen_t* codegen, ast_function* node);
 function_t* codegen_compile_function(codegen_t* parent_codegen, ast_function* func_node);
 
 // Statement code generation
@@ -157,6 +187,7 @@ void codegen_emit_infinite_loop(codegen_t* codegen, ast_loop* node);
 void codegen_emit_break(codegen_t* codegen, ast_break* node);
 void codegen_emit_continue(codegen_t* codegen, ast_continue* node);
 void codegen_emit_return(codegen_t* codegen, ast_return* node);
+void codegen_emit_yield(codegen_t* codegen, ast_yield* node);
 
 // Utility functions
 void codegen_emit_op(codegen_t* codegen, opcode op);
@@ -186,6 +217,17 @@ void codegen_cleanup_scope_manager(codegen_t* codegen);
 int codegen_add_upvalue(codegen_t* codegen, const char* name, int index, int is_local);
 int codegen_resolve_upvalue(codegen_t* codegen, const char* name);
 
+// Local type inference (types.c)
+void codegen_infer_types(codegen_t* codegen, ast_node** statements, size_t statement_count,
+                         char** parameters, size_t param_count);
+static_type codegen_expression_type(codegen_t* codegen, ast_node* expr);
+bool codegen_name_is_captured(codegen_t* codegen, const char* name);
+bool codegen_specialize_binary_op(codegen_t* codegen, binary_operator op, ast_node* left, ast_node* right,
+                                  opcode* specialized);
+void codegen_assign_local_type(codegen_t* codegen, int slot, const char* name);
+void codegen_free_types(codegen_t* codegen);
+const char* static_type_name(static_type type);
+
 // Error handling
 void codegen_error(codegen_t* codegen, const char* message);
 
@@ -195,4 +237,8 @@ void chunk_disassemble_with_vm(bytecode_chunk* chunk, const char* name, vm_t* vm
 size_t disassemble_instruction(bytecode_chunk* chunk, size_t offset);
 size_t disassemble_instruction_with_vm(bytecode_chunk* chunk, size_t offset, vm_t* vm);
 
+// Ahead-of-time compilation: write `main_function` and the function table entries from
+// `first_function` on as a C program for the slate_runtime library (see aot.h). Returns 0 on success.
+int codegen_emit_c(vm_t* vm, function_t* main_function, size_t first_function, const char* source_name, FILE* out);
+
 #endif // CODEGEN_H
\ No newline at end of file
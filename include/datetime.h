@@ -4,13 +4,13 @@
 #include "vm.h"
 
 // Global date/time class references
-extern value_t* global_local_date_class;
-extern value_t* global_local_time_class;
-extern value_t* global_local_datetime_class;
-extern value_t* global_date_class;
-extern value_t* global_instant_class;
-extern value_t* global_duration_class;
-extern value_t* global_period_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_time_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_datetime_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_instant_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_duration_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_period_class;
 
 // Date/time validation functions
 bool is_valid_date(int year, int month, int day);
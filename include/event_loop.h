@@ -0,0 +1,52 @@
+#ifndef SLATE_EVENT_LOOP_H
+#define SLATE_EVENT_LOOP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "vm.h"
+
+// Per-VM event loop for asynchronous I/O (read_file_async, write_file_async, sleep, exec).
+//
+// Every asynchronous operation returns a Promise right away. Coroutines are generator functions
+// started with spawn(): the loop resumes one until it yields, and a yielded promise parks the
+// task until that promise settles, at which point the yield evaluates to its value. So the wait
+// for one file or child process overlaps with every other task's work and waits.
+//
+// The loop itself only runs inside await(), which drives it until the awaited promise settles.
+// Child-process pipes and timers are multiplexed with epoll. Regular files can't be polled, so
+// reads and writes run on a small pool of I/O threads that only touch the file and a private
+// buffer; everything that touches VM values happens on the VM's own thread.
+
+// Threads used for file operations (started on the first one)
+#define EVENT_LOOP_IO_THREADS 4
+
+typedef struct event_loop event_loop_t;
+
+// The VM's loop, created on first use. NULL if the platform has no event loop support.
+event_loop_t* event_loop_get(vm_t* vm);
+void event_loop_destroy(event_loop_t* loop);
+
+// New pending promise (ref_count 1) and settling it. Settling consumes `value` and resumes
+// everything waiting on the promise; settling an already settled promise just releases `value`.
+promise_t* promise_create(void);
+void promise_fulfill(event_loop_t* loop, promise_t* promise, value_t value);
+void promise_reject(event_loop_t* loop, promise_t* promise, value_t message);
+
+// Run a generator iterator as a task. The returned promise settles with its return value.
+promise_t* event_loop_spawn(event_loop_t* loop, value_t generator);
+
+// Promise that fulfills with an array of the results once all elements have (values that
+// aren't promises count as already fulfilled), or rejects with the first rejection
+promise_t* event_loop_all(event_loop_t* loop, value_t* values, size_t count);
+
+// Asynchronous operations
+promise_t* event_loop_sleep(event_loop_t* loop, int64_t millis);
+promise_t* event_loop_read_file(event_loop_t* loop, const char* path);
+promise_t* event_loop_write_file(event_loop_t* loop, db_buffer buffer, const char* path);
+promise_t* event_loop_exec(event_loop_t* loop, const char* command);
+
+// Run tasks and dispatch I/O until `promise` settles. Returns false if it never can: it's
+// still pending and there are no tasks, timers or operations left that could settle it.
+bool event_loop_run_until(event_loop_t* loop, promise_t* promise);
+
+#endif // SLATE_EVENT_LOOP_H
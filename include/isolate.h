@@ -0,0 +1,53 @@
+#ifndef SLATE_ISOLATE_H
+#define SLATE_ISOLATE_H
+
+#include <stddef.h>
+#include "vm.h"
+
+// Isolates: independent scripts running concurrently on a pool of worker threads.
+//
+// An isolate owns a vm_t and everything allocated through it - values never cross isolates, so
+// reference counts stay plain integers. A worker runs one isolate from start to finish, and the
+// per-VM registers that used to be process-wide (the builtin class pointers, g_current_vm) are
+// thread-local, pointing at whichever isolate the thread is running. The state that really is
+// shared - interned property keys and the timezone pool - is locked.
+//
+// Every worker keeps its own queue of isolates waiting to start; idle workers steal from the
+// others, so one thread spawning many isolates still keeps the whole pool busy.
+//
+// Compiled programs can be shared as well: an aot_program (slate --emit-c) is immutable static
+// data, and each isolate spawned from one loads its own copy of the functions.
+
+struct aot_program;
+
+typedef struct isolate_pool isolate_pool;
+typedef struct isolate isolate;
+
+// Start a pool with `threads` workers (0 = one per online CPU). NULL if no thread could start.
+isolate_pool* isolate_pool_create(size_t threads);
+
+// Wait for every spawned isolate to finish, then stop the workers
+void isolate_pool_destroy(isolate_pool* pool);
+
+size_t isolate_pool_size(const isolate_pool* pool);
+
+// Queue a script for execution. The source is copied; argv must stay valid until the isolate
+// has been joined. Every isolate must be joined exactly once.
+isolate* isolate_spawn(isolate_pool* pool, const char* source, int argc, char** argv);
+
+// Queue an ahead-of-time compiled program for execution (see aot.h)
+isolate* isolate_spawn_program(isolate_pool* pool, const struct aot_program* program, int argc, char** argv);
+
+// Queue a C function to run on a fresh isolate's VM. Its return value becomes the join result;
+// a runtime error raised inside it unwinds out and joins as VM_RUNTIME_ERROR.
+isolate* isolate_spawn_call(isolate_pool* pool, vm_result (*entry)(vm_t* vm, void* context), void* context);
+
+// Block until the isolate has finished and free it. If result_text is non-NULL it receives the
+// display form of the script's result (malloc'd; NULL if the result was undefined or the run
+// failed). Parse and compile failures return VM_COMPILE_ERROR, runtime errors VM_RUNTIME_ERROR;
+// either way the message has already been printed to stderr.
+//
+// Don't join from inside a running isolate: the worker would wait for itself.
+vm_result isolate_join(isolate* iso, char** result_text);
+
+#endif // SLATE_ISOLATE_H
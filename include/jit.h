@@ -0,0 +1,37 @@
+#ifndef SLATE_JIT_H
+#define SLATE_JIT_H
+
+#include "config.h"
+#include "vm.h"
+
+// Baseline template JIT (x86-64 Linux, enabled with -DSLATE_JIT=ON).
+//
+// A function whose hotness (calls + loop back-edges) passes the threshold is translated once
+// into native code that calls the existing op_* handlers in sequence, with the jumps resolved
+// natively and inline int32 fast paths for locals, arithmetic and comparisons. Anything the
+// fast paths can't prove (non-int32 operands, overflow, a full stack) falls back to the handler.
+//
+// The threshold defaults to JIT_DEFAULT_THRESHOLD; the SLATE_JIT_THRESHOLD environment variable
+// overrides it (0 compiles every function on its first call).
+
+#define JIT_DEFAULT_THRESHOLD 1000
+
+typedef struct jit_code jit_code_t;
+
+#ifdef SLATE_JIT
+
+// Called after an opcode that may have pushed a call frame (OP_CALL and friends).
+// If a frame was pushed and its function is compiled, runs it natively until it returns;
+// otherwise returns VM_OK and the interpreter carries on in the callee's bytecode.
+vm_result jit_enter_frame(vm_t* vm, size_t caller_depth);
+
+// Called by the interpreter after a loop back-edge. Once the function is hot, execution
+// switches to native code at the loop header and stays there until the function returns.
+vm_result jit_enter_loop(vm_t* vm);
+
+// Release the native code attached to a function
+void jit_code_free(jit_code_t* code);
+
+#endif // SLATE_JIT
+
+#endif // SLATE_JIT_H
@@ -34,6 +34,7 @@ typedef enum {
     TOKEN_BREAK,         // break
     TOKEN_CONTINUE,      // continue
     TOKEN_RETURN,        // return
+    TOKEN_YIELD,         // yield
     TOKEN_THEN,          // then
     TOKEN_END,           // end
     TOKEN_AND,           // and (synonym for &&)
@@ -6,7 +6,7 @@
 typedef struct slate_vm vm_t;
 
 // Global VM pointer for library assert access
-extern vm_t* g_current_vm;
+extern _Thread_local vm_t* g_current_vm; // Per thread, like the class registers in value.h
 
 // Wrapper function to handle library assert failures - implemented in runtime_error.c
 void slate_library_assert_failed(const char* condition, const char* file, int line);
@@ -57,6 +57,7 @@ int module_file_exists(const char* path);
 
 // Module search path management
 void module_add_search_path(struct slate_vm* vm, const char* search_path);
+void module_add_env_search_paths(struct slate_vm* vm); // Directories listed in SLATEPATH
 void module_clear_search_paths(struct slate_vm* vm);
 const char** module_get_search_paths(struct slate_vm* vm, size_t* count);
 
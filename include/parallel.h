@@ -0,0 +1,42 @@
+#ifndef SLATE_PARALLEL_H
+#define SLATE_PARALLEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "vm.h"
+
+// Data-parallel loops over arrays (Array.parMap, parFilter, parReduce).
+//
+// The array is split into one chunk per thread and every chunk runs in its own worker isolate
+// (isolate.h) on a private copy of the callback. That is only sound for callbacks that can't
+// tell the difference, so parallel_kernel_create verifies the bytecode first: no stores outside
+// its own locals, no property or method access, no calls except to pure math builtins, and
+// globals and captures that hold plain values. Inputs and results must be plain values too -
+// Int, Float, Boolean, null - since those carry no references back into either heap.
+//
+// Everything here reports failure instead of raising: the caller then runs the sequential
+// version, which is safe to repeat because the callback is pure, and raises any error there.
+
+// Arrays shorter than this aren't worth starting workers for
+#define PARALLEL_MIN_ELEMENTS 2048
+
+typedef struct parallel_kernel parallel_kernel;
+
+// Worker threads for parallel operations: SLATE_THREADS, or one per online CPU
+size_t parallel_thread_count(void);
+
+// Verify and capture a callback taking at most max_params arguments. NULL if it isn't provably pure.
+parallel_kernel* parallel_kernel_create(vm_t* vm, value_t callable, size_t max_params);
+void parallel_kernel_destroy(parallel_kernel* kernel);
+
+// out[i] = f(in[i], i). out must have room for count values.
+bool parallel_map(vm_t* vm, parallel_kernel* kernel, const value_t* in, size_t count, value_t* out);
+
+// keep[i] = f(in[i], i) is truthy
+bool parallel_test(vm_t* vm, parallel_kernel* kernel, const value_t* in, size_t count, bool* keep);
+
+// Fold each chunk from its first element with acc = f(acc, element) and store the chunk results
+// in order. Returns how many were stored (at most parallel_thread_count()), 0 on failure.
+size_t parallel_fold(vm_t* vm, parallel_kernel* kernel, const value_t* in, size_t count, value_t* partials);
+
+#endif // SLATE_PARALLEL_H
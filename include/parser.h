@@ -22,6 +22,10 @@ typedef struct {
     // Simple pushback mechanism (supports up to 2 tokens)
     token_t pushed_back[2];  // Tokens pushed back
     int pushback_count;      // Number of tokens pushed back
+    
+    // Function bodies being parsed; yield is only valid inside one and makes it a generator
+    int function_depth;
+    int saw_yield;           // The innermost function body being parsed contains yield
 } parser_t;
 
 // Parser functions
@@ -63,6 +63,9 @@ const char* timezone_get_id(const timezone_t* tz);
 // Utility functions
 bool is_valid_timezone_id(const char* id);
 
+// localtime_r() in the process's zone, safe while other threads look up zones
+struct tm* timezone_localtime(time_t seconds, struct tm* out);
+
 // Initialize timezone system (called during VM startup)
 void init_timezone_system(void);
 
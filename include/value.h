@@ -1,6 +1,7 @@
 #ifndef SLATE_VALUE_H
 #define SLATE_VALUE_H
 
+#include <stdbool.h>
 #include <stdint.h>
 // Include dynamic libraries
 #include "dynamic_array.h"
@@ -44,7 +45,12 @@ typedef enum {
     VAL_DATE, // Date and time with timezone (the primary zoned datetime type)
     VAL_INSTANT, // Point in time (Unix timestamp with nanoseconds)
     VAL_DURATION, // Time-based amount (2 hours, 30 minutes)
-    VAL_PERIOD // Date-based amount (2 years, 3 months, 5 days)
+    VAL_PERIOD, // Date-based amount (2 years, 3 months, 5 days)
+    VAL_ADT, // Algebraic data type instance (Some(42), Node(1, Leaf, Leaf))
+    VAL_PROMISE, // Eventual result of an asynchronous operation (see event_loop.h)
+    VAL_TYPED_ARRAY, // Packed Int32Array / Float64Array storage (see typed_array.h)
+    VAL_MAP, // Hash map from any value to any value, in insertion order
+    VAL_SET // Hash set of values, in insertion order (a map without values)
 } value_type;
 
 // Forward declarations for value-related structures
@@ -61,6 +67,11 @@ typedef struct date date_t;
 typedef struct instant instant_t;
 typedef struct duration duration_t;
 typedef struct period period_t;
+typedef struct adt_constructor adt_constructor_t;
+typedef struct adt_instance adt_instance_t;
+typedef struct promise promise_t;
+typedef struct typed_array typed_array_t;
+typedef struct hash_map hash_map_t;
 
 // Native function pointer type
 typedef value_t (*native_t)(vm_t* vm, int arg_count, value_t* args);
@@ -97,6 +108,10 @@ struct value {
         int64_t instant_millis; // Point in time (epoch milliseconds, direct storage)
         duration_t* duration; // Time-based amount
         period_t* period; // Date-based amount
+        adt_instance_t* adt; // ADT instance (constructor tag + fields)
+        promise_t* promise; // Pending or settled asynchronous result
+        typed_array_t* typed_array; // Unboxed numeric elements (ref-counted)
+        hash_map_t* map; // Map and Set storage (ref-counted)
     } as;
     value_t* class; // For object instances: pointer to their class value (NULL for non-instances)
     debug_location* debug; // Debug info for error reporting (NULL when disabled)
@@ -114,7 +129,9 @@ struct range {
 // Iterator types
 typedef enum {
     ITER_ARRAY, // Array iterator
-    ITER_RANGE // Range iterator
+    ITER_RANGE, // Range iterator
+    ITER_GENERATOR, // Suspended generator function (see generators.c)
+    ITER_PIPELINE // Lazy adapters over another iterator (see pipelines.c)
 } iterator_type;
 
 // Iterator structure for unified iteration over arrays, ranges, etc.
@@ -134,9 +151,66 @@ struct iterator {
             int finished; // Whether iteration is complete
             int reverse; // 1 if iterating backwards (start > end), 0 if forwards
         } range_iter;
+        struct generator* generator; // Owned by the iterator
+        struct iterator_pipeline* pipeline; // Owned by the iterator
     } data;
 };
 
+// Promise states
+typedef enum {
+    PROMISE_PENDING,
+    PROMISE_FULFILLED,
+    PROMISE_REJECTED
+} promise_state;
+
+// Promise structure: settled once by the event loop, which then resumes everything waiting on it
+struct promise {
+    size_t ref_count; // Reference counting for memory management
+    promise_state state;
+    value_t value; // Fulfilled value, or the error message (String) when rejected
+    struct promise_waiter* waiters; // Tasks and combinators to notify when it settles
+};
+
+// Typed array element kinds
+typedef enum {
+    TYPED_INT32, // Int32Array
+    TYPED_FLOAT64 // Float64Array
+} typed_array_kind;
+
+// Typed array structure: a fixed number of unboxed numbers in one contiguous block
+struct typed_array {
+    size_t ref_count; // Reference counting for memory management
+    typed_array_kind kind;
+    size_t length; // Number of elements
+    union {
+        int32_t* i32;
+        double* f64;
+        void* bytes;
+    } data; // 32-byte aligned, so vector kernels never split a cache line per load
+};
+
+// Hash map entry, kept in insertion order; removed entries stay until the next rehash
+typedef struct hash_map_entry {
+    value_t key;
+    value_t value; // null in sets
+    uint32_t hash;
+    bool live;
+} hash_map_entry;
+
+#define HASH_MAP_SLOT_REMOVED UINT32_MAX
+
+// Hash map structure behind Map and Set (see hash_maps.c). Open addressing: slots index into
+// the entry array, so iteration follows insertion order and probing touches 4 bytes per slot.
+struct hash_map {
+    size_t ref_count; // Reference counting for memory management
+    hash_map_entry* entries;
+    size_t entry_count; // Entries used, including removed ones
+    size_t entry_capacity;
+    size_t count; // Live entries
+    uint32_t* slots; // 0 = empty, HASH_MAP_SLOT_REMOVED, otherwise entry index + 1
+    size_t slot_mask; // Slot count - 1 (slot count is a power of two)
+};
+
 // Bound method structure
 struct bound_method {
     size_t ref_count; // Reference counting for memory management
@@ -152,6 +226,22 @@ struct class {
     do_object static_properties; // Hash table of static methods/class properties
     value_t (*factory)(vm_t* vm, class_t* self, int arg_count,
                        value_t* args); // Factory function for creating instances (NULL if not callable)
+    adt_constructor_t* adt; // Field layout for ADT constructor classes (NULL for other classes)
+};
+
+// Layout shared by every instance of one ADT constructor (Some, Node, ...)
+struct adt_constructor {
+    value_t class_value; // Constructor class as referenced by instance.class (not retained - owned by the class)
+    uint16_t tag; // Constructor index within its data declaration
+    uint16_t field_count; // Number of declared parameters
+    char** field_names; // Parameter names in declaration order (owned)
+};
+
+// ADT instance: fixed-size field array read by index, allocated in one block
+struct adt_instance {
+    size_t ref_count;
+    adt_constructor_t* constructor; // Shared layout; the instance retains its class
+    value_t fields[]; // constructor->field_count values in declaration order
 };
 
 // Date/Time structures (forward declared, implemented in datetime.c)
@@ -205,27 +295,35 @@ struct period {
 };
 
 // Global class instances (extern declarations)
-extern value_t* global_value_class;
-extern value_t* global_object_class;
-extern value_t* global_int_class;
-extern value_t* global_float_class;
-extern value_t* global_string_class;
-extern value_t* global_boolean_class;
-extern value_t* global_null_class;
-extern value_t* global_array_class;
-extern value_t* global_range_class;
-extern value_t* global_iterator_class;
-extern value_t* global_string_builder_class;
-extern value_t* global_buffer_class;
-extern value_t* global_buffer_builder_class;
-extern value_t* global_local_date_class;
-extern value_t* global_local_time_class;
-extern value_t* global_local_datetime_class;
-extern value_t* global_zone_class;
-extern value_t* global_date_class;
-extern value_t* global_instant_class;
-extern value_t* global_duration_class;
-extern value_t* global_period_class;
+// These are per thread: builtins_init points them at the classes of the VM being set up, and a
+// thread runs one VM at a time (see isolate.h)
+#define SLATE_ISOLATE_LOCAL _Thread_local
+extern SLATE_ISOLATE_LOCAL value_t* global_value_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_object_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_int_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_float_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_string_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_boolean_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_null_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_array_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_range_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_iterator_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_string_builder_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_buffer_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_buffer_builder_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_time_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_datetime_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_zone_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_instant_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_duration_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_period_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_promise_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_int32_array_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_float64_array_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_map_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_set_class;
 
 // Memory management functions
 value_t vm_retain(value_t value);
@@ -263,6 +361,11 @@ value_t make_date(date_t* date);
 value_t make_instant_direct(int64_t epoch_millis);
 value_t make_duration(duration_t* duration);
 value_t make_period(period_t* period);
+value_t make_adt(adt_instance_t* adt);
+value_t make_promise(promise_t* promise);
+value_t make_typed_array(typed_array_t* array);
+value_t make_map(hash_map_t* map);
+value_t make_set(hash_map_t* set);
 
 // Value creation functions with debug info
 value_t make_null_with_debug(debug_location* debug);
@@ -296,6 +399,7 @@ value_t make_date_with_debug(date_t* date, debug_location* debug);
 value_t make_instant_direct_with_debug(int64_t epoch_millis, debug_location* debug);
 value_t make_duration_with_debug(duration_t* duration, debug_location* debug);
 value_t make_period_with_debug(period_t* period, debug_location* debug);
+value_t make_adt_with_debug(adt_instance_t* adt, debug_location* debug);
 
 // Utility functions for classes
 class_t* class_retain(class_t* class);
@@ -310,5 +414,11 @@ void local_datetime_release(local_datetime_t* dt);
 void instant_release(instant_t* instant);
 void duration_release(duration_t* duration);
 void period_release(period_t* period);
+void adt_instance_release(adt_instance_t* adt);
+void promise_release(promise_t* promise);
+typed_array_t* typed_array_create(typed_array_kind kind, size_t length); // Zero-filled, NULL if out of memory
+void typed_array_release(typed_array_t* array);
+hash_map_t* hash_map_create(size_t capacity); // Room for capacity entries, NULL if out of memory
+void hash_map_release(hash_map_t* map);
 
 #endif // SLATE_VALUE_H
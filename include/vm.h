@@ -19,6 +19,7 @@ typedef enum {
     CTX_INTERACTIVE,
     CTX_SCRIPT,
     CTX_TEST,
+    CTX_ISOLATE, // Script semantics, but runtime errors end only the isolate (isolate.h)
 } RunContext;
 
 // Include value system
@@ -92,12 +93,29 @@ typedef enum {
     OP_INCREMENT, // Pop a, push a + 1
     OP_DECREMENT, // Pop a, push a - 1
 
+    // Type-specialized operations (operand types proven by codegen's local type inference)
+    OP_ADD_INT, // Pop b, pop a, push a + b for Int operands
+    OP_SUBTRACT_INT, // Pop b, pop a, push a - b for Int operands
+    OP_MULTIPLY_INT, // Pop b, pop a, push a * b for Int operands
+    OP_LESS_INT, // Pop b, pop a, push a < b for Int operands
+    OP_LESS_EQUAL_INT, // Pop b, pop a, push a <= b for Int operands
+    OP_GREATER_INT, // Pop b, pop a, push a > b for Int operands
+    OP_GREATER_EQUAL_INT, // Pop b, pop a, push a >= b for Int operands
+    OP_ADD_FLOAT, // Pop b, pop a, push a + b for float64 operands
+    OP_SUBTRACT_FLOAT, // Pop b, pop a, push a - b for float64 operands
+    OP_MULTIPLY_FLOAT, // Pop b, pop a, push a * b for float64 operands
+    OP_DIVIDE_FLOAT, // Pop b, pop a, push a / b for float64 operands
+    OP_CONCAT_STRING, // Pop b, pop a, push a + b for string operands
+    OP_CONCAT_N, // Pop n values, push their string forms joined, for template literals (operand = n)
+
     // Variable operations
     OP_GET_LOCAL, // Push local variable value
     OP_SET_LOCAL, // Set local variable value (pops value)
     OP_GET_GLOBAL, // Push global variable value
     OP_SET_GLOBAL, // Set global variable value (pops value)
     OP_DEFINE_GLOBAL, // Define global variable (pops value)
+    OP_APPEND_LOCAL, // Pop b, a + b for `x = x + b` in a loop, growing x's string in place (operand = x's slot)
+    OP_APPEND_GLOBAL, // Pop b, a + b for `x = x + b` in a loop, growing x's string in place (operand = x's name)
 
     // Object/property operations
     OP_GET_PROPERTY, // Pop object, push property value
@@ -105,6 +123,7 @@ typedef enum {
 
     // Array operations
     OP_BUILD_ARRAY, // Pop n elements, build array (operand = n)
+    OP_GET_INDEX, // Pop index, pop receiver, push receiver[index] (falls back to a one-argument call)
     OP_SET_INDEX, // Pop value, pop index, pop array, set array[index] = value
 
     // Object operations
@@ -115,15 +134,19 @@ typedef enum {
 
     // Function operations
     OP_CLOSURE, // Create closure (operand = function index)
+    OP_CLOSURE_LOCAL, // Create non-escaping closure in the VM's closure pool (operand = function index)
+    OP_RELEASE_LOCAL_CLOSURES, // Return pooled closures after the consuming call (operand = count)
     OP_CALL, // Call function (operand = arg count)
     OP_CALL_METHOD, // Call method with implicit receiver (operand = arg count)
     OP_RETURN, // Return from function
+    OP_YIELD, // Pop value, suspend the generator frame and hand the value to the resuming next()
     
     // Upvalue operations (for closures)
     OP_GET_UPVALUE, // Get upvalue (operand = upvalue index)
     OP_SET_UPVALUE, // Set upvalue (operand = upvalue index)
 
     // Control flow
+    OP_MATCH_SWITCH, // Jump table dispatch on top of stack for literal match cases (variable-length, see match_switch_kind)
     OP_JUMP, // Unconditional jump (operand = offset)
     OP_JUMP_IF_FALSE, // Jump if top of stack is false (operand = offset)
     OP_JUMP_IF_TRUE, // Jump if top of stack is true (operand = offset)
@@ -149,6 +172,14 @@ typedef enum {
     OP_HALT // Stop execution
 } opcode;
 
+// OP_MATCH_SWITCH table layouts. Every switch starts with: u8 kind, u16 miss offset.
+// Jump offsets are relative to the end of the instruction; a subject of the wrong type
+// falls through to the sequential .equals() chain that follows the instruction.
+typedef enum {
+    MATCH_SWITCH_INT32,  // i32 min, u16 count, count x u16 offset (0xFFFF = no case)
+    MATCH_SWITCH_STRING  // u32 seed, u16 slot count (power of 2), slots x (u32 hash, u16 constant, u16 offset)
+} match_switch_kind;
+
 
 
 
@@ -159,6 +190,9 @@ typedef struct {
     int is_local;   // 1 if capturing from parent locals, 0 if from parent upvalues
 } upvalue_desc_t;
 
+// Bytecode execution result
+typedef enum { VM_OK, VM_COMPILE_ERROR, VM_RUNTIME_ERROR, VM_STACK_OVERFLOW, VM_STACK_UNDERFLOW } vm_result;
+
 // Function structure
 typedef struct function {
     uint8_t* bytecode; // Function bytecode
@@ -170,8 +204,14 @@ typedef struct function {
     size_t local_count; // Total local variables (params + locals)
     char* name; // Function name (for debugging)
     void* debug; // Optional debug information (debug_info*)
+    char* local_types; // Statically inferred local types, for the disassembler (NULL if none)
     upvalue_desc_t* upvalue_descriptors; // Upvalue capture information
     size_t upvalue_count; // Number of upvalues this function captures
+    size_t hotness; // Calls + loop back-edges, drives baseline JIT compilation (SLATE_JIT builds)
+    struct jit_code* jit; // Native code once compiled, NULL otherwise
+    int jit_disabled; // Bytecode the JIT can't translate - don't try again
+    vm_result (*native)(vm_t* vm, size_t depth); // Ahead-of-time compiled body (see aot.h), NULL otherwise
+    int is_generator; // Body contains yield: a call returns an Iterator instead of running it
 } function_t;
 
 // Closure structure (function + captured variables)
@@ -180,8 +220,16 @@ typedef struct closure {
     value_t* upvalues; // Captured variables from outer scopes
     size_t upvalue_count;
     struct module_t* module; // Module context where closure was created (for namespace resolution)
+    int is_local; // Lives in the VM's local closure pool (OP_CLOSURE_LOCAL) - must not outlive its call
 } closure_t;
 
+// Pool slot for closures of lambdas that never escape their call (see OP_CLOSURE_LOCAL).
+// Slots are reused LIFO, so the upvalue buffer is only reallocated when a slot needs more room.
+typedef struct local_closure {
+    closure_t closure;
+    size_t upvalue_capacity;
+} local_closure_t;
+
 // Call frame for function calls
 typedef struct call_frame {
     closure_t* closure; // Function being executed
@@ -205,6 +253,7 @@ typedef struct slate_vm {
     call_frame* frames; // Call frames
     size_t frame_count;
     size_t frame_capacity;
+    size_t call_floor; // vm_run returns when frame_count drops back to this (vm_call_function sets it)
 
     // Constants
     value_t* constants; // Global constant pool
@@ -225,6 +274,17 @@ typedef struct slate_vm {
     // Function table - stores all defined functions with proper reference counting
     da_array functions; // Global function table
 
+    // Pooled closures for non-escaping lambdas (stack discipline, slots kept for reuse)
+    local_closure_t** local_closures;
+    size_t local_closure_count; // Slots currently in use
+    size_t local_closure_capacity; // Slots allocated
+
+    // Innermost generator being resumed (see generators.c), NULL when none is running
+    struct generator* generator;
+
+    // Event loop for asynchronous I/O (event_loop.h), created on first use
+    struct event_loop* event_loop;
+
     // Result register - holds the value of the last executed statement
     value_t result;
 
@@ -235,6 +295,9 @@ typedef struct slate_vm {
     char** argv;
     int argc;
 
+    // random() state (xorshift64*), seeded per VM by builtins_init
+    uint64_t random_state;
+
     // Memory management
     size_t bytes_allocated; // For GC later
     
@@ -257,23 +320,21 @@ void vm_destroy(vm_t* vm);
 void vm_reset(vm_t* vm);
 
 // Store global String class (accessed by vm.c for string creation)
-extern value_t* global_string_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_string_class;
 
 // Store global Array class (accessed by vm.c for array creation)
-extern value_t* global_array_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_array_class;
 
 // Store global Range class (accessed by vm.c for range creation)
-extern value_t* global_range_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_range_class;
 
 // Store global Iterator class (accessed by vm.c for iterator creation)
-extern value_t* global_iterator_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_iterator_class;
 
 // Store global StringBuilder class (accessed by vm.c for string builder creation)
-extern value_t* global_string_builder_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_string_builder_class;
 
 // Bytecode execution
-typedef enum { VM_OK, VM_COMPILE_ERROR, VM_RUNTIME_ERROR, VM_STACK_OVERFLOW, VM_STACK_UNDERFLOW } vm_result;
-
 vm_result vm_run(vm_t* vm);
 vm_result vm_execute(vm_t* vm, function_t* function);
 vm_result vm_interpret(vm_t* vm, const char* source);
@@ -286,6 +347,7 @@ value_t vm_peek(vm_t* vm, int distance);
 
 // Function calling helper for builtin methods
 value_t vm_call_function(vm_t* vm, value_t callable, int arg_count, value_t* args);
+value_t vm_call_generator(vm_t* vm, value_t callable, int arg_count, value_t* args);
 
 // VM call state for safe function calling
 typedef struct {
@@ -333,6 +395,102 @@ iterator_t* create_range_iterator(value_t start, value_t end, int exclusive, val
 int iterator_has_next(iterator_t* iter);
 value_t iterator_next(iterator_t* iter);
 
+// Generators: a call to a function containing yield returns an Iterator over its yields.
+// The frame runs only inside iterator_has_next; at each yield its stack window and ip are
+// moved into the heap generator and control returns to the caller.
+typedef enum {
+    GEN_SUSPENDED, // Not started yet, or stopped at a yield
+    GEN_RUNNING,   // Between resume and the next yield or return
+    GEN_DONE       // Returned or raised - has_next is false from now on
+} generator_state;
+
+typedef struct generator {
+    vm_t* vm;
+    closure_t* closure;
+    int owns_closure;         // Wrapper or promoted copy made for this call - freed with the generator
+    value_t* stack;           // Saved stack window (arguments, locals, temporaries)
+    size_t stack_count;
+    size_t stack_capacity;
+    uint8_t* ip;              // Where to resume
+    int started;              // Resumes after the first push the value of the yield expression
+    generator_state state;
+    value_t pending;          // Yielded value not yet taken by next()
+    int has_pending;
+    value_t result;           // Value the body returned (null until it does)
+    struct generator* resumer; // Generator that resumed this one (vm->generator chain)
+} generator_t;
+
+iterator_t* create_generator_iterator(vm_t* vm, closure_t* closure, int owns_closure, value_t* args, size_t arg_count);
+int generator_has_next(generator_t* gen);
+// Resume with `sent` (consumed) as the value of the suspended yield. 1 if the body yielded again.
+int generator_send(generator_t* gen, value_t sent);
+value_t generator_next(generator_t* gen);
+void generator_destroy(generator_t* gen);
+
+// Lazy iterator adapters (it.map(f).filter(g).take(n)). A chain of adapters is a single
+// pipeline of stages over one source iterator: pulling an element runs it through every stage
+// in turn, so nothing is stored between stages and toArray() allocates once, at the end.
+typedef enum {
+    STAGE_MAP,       // f(x)
+    STAGE_FILTER,    // x where f(x) is truthy
+    STAGE_FLAT_MAP,  // Elements of f(x) (array, range or iterator), or f(x) itself
+    STAGE_TAKE,      // First `count` elements
+    STAGE_SKIP,      // All but the first `count` elements
+    STAGE_ENUMERATE, // [index, x]
+    STAGE_ZIP        // [x, y] with y from `other`, until either runs out
+} pipeline_stage_kind;
+
+typedef struct pipeline_stage {
+    pipeline_stage_kind kind;
+    value_t fn;          // map, filter, flatMap
+    int owns_fn;         // fn is a promoted copy of a pooled closure, freed with the stage
+    iterator_t* other;   // zip: second source; flatMap: elements of the current f(x)
+    size_t count;        // take/skip: elements left; enumerate: next index
+} pipeline_stage;
+
+typedef struct iterator_pipeline {
+    vm_t* vm;
+    iterator_t* source;
+    pipeline_stage* stages;
+    size_t stage_count;
+    value_t pending;     // Next element, pulled ahead by has_next
+    int has_pending;
+    int pulled;          // Anything pulled yet (only fresh pipelines are extended in place of wrapping)
+    int done;
+} iterator_pipeline;
+
+// New iterator applying `stage` to the elements of `upstream`. Takes over the stage's fn and
+// other; upstream is retained, or when it's a fresh pipeline, its stages are copied instead.
+// NULL if the callback can't be kept or on allocation failure.
+iterator_t* iterator_pipeline_create(vm_t* vm, iterator_t* upstream, pipeline_stage stage);
+int pipeline_has_next(iterator_pipeline* pipeline);
+value_t pipeline_next(iterator_pipeline* pipeline);
+void pipeline_destroy(iterator_pipeline* pipeline);
+
+// Elements the iterator will still produce: 1 with *count exact, 0 if that can't be known
+// without running it (*count is then an upper bound, or SIZE_MAX)
+int iterator_size_hint(iterator_t* iter, size_t* count);
+
+// New iterator over an array, range, set (its elements) or map ([key, value] pairs), or the
+// iterator itself retained. NULL for anything else. Sets and maps are iterated as a snapshot.
+iterator_t* iterator_for_value(value_t value);
+
+// Hash tables behind Map and Set (see hash_maps.c). Keys are hashed with .hash() and compared
+// with .equals(), with fast paths for numbers and strings; numbers that are equal across types
+// (1, 1.0, a BigInt 1) hash alike so they find the same entry.
+uint32_t hash_map_key_hash(vm_t* vm, value_t key);
+hash_map_entry* hash_map_find(vm_t* vm, hash_map_t* map, value_t key); // NULL if absent
+// Set key's value (adding the key if new), retaining both. 0 if out of memory.
+int hash_map_put(vm_t* vm, hash_map_t* map, value_t key, value_t value);
+int hash_map_remove(vm_t* vm, hash_map_t* map, value_t key); // 1 if the key was there
+// Room for `count` live entries in total without rehashing. 0 if out of memory.
+int hash_map_reserve(hash_map_t* map, size_t count);
+void hash_map_clear(hash_map_t* map);
+hash_map_t* hash_map_copy(hash_map_t* map); // NULL if out of memory
+typedef enum { HASH_MAP_KEYS, HASH_MAP_VALUES, HASH_MAP_ENTRIES } hash_map_view;
+// New array of the keys, values or [key, value] pairs in insertion order
+da_array hash_map_to_array(hash_map_t* map, hash_map_view view);
+
 // Iterator reference counting
 iterator_t* iterator_retain(iterator_t* iter);
 void iterator_release(iterator_t* iter);
@@ -376,11 +534,16 @@ int is_truthy(value_t value);
 int is_number(value_t value); // Check if value is numeric (int32, bigint, or number)
 int compare_numbers(value_t a, value_t b); // Compare two numbers: -1 if a < b, 0 if a == b, 1 if a > b
 int call_equals_method(vm_t* vm, value_t a, value_t b); // Call .equals() method using proper method dispatch
+int primitive_equals(value_t a, value_t b); // Builtin .equals() for primitive pairs: 1/0, or -1 if dispatch is needed
+uint32_t call_hash_method(vm_t* vm, value_t value); // Call .hash() method using proper method dispatch
+uint32_t match_string_hash(const char* str, size_t length, uint32_t seed); // Seeded hash used by OP_MATCH_SWITCH
+uint32_t match_hash_seed(uint32_t hash, uint32_t seed); // match_string_hash from an already computed ds_hash32
 void print_value(vm_t* vm, value_t value);
 
 // Property lookup functions
 value_t* lookup_static_property(class_t* cls, const char* prop_name);
 value_t* lookup_instance_property(class_t* cls, const char* prop_name);
+const char* property_key(ds_string name); // Interned key for a property name, using the string's cached hash
 void print_for_builtin(vm_t* vm, value_t value);
 float value_to_float32(value_t value); // Convert numeric values to float32
 double value_to_float64(value_t value); // Convert numeric values to float64
@@ -404,9 +567,14 @@ void function_destroy(function_t* function);
 closure_t* closure_create(function_t* function);
 closure_t* closure_create_with_module(function_t* function, vm_t* vm);
 void closure_destroy(closure_t* closure);
+closure_t* local_closure_acquire(vm_t* vm, function_t* function); // Next pooled closure (NULL on allocation failure)
+void local_closures_release(vm_t* vm, size_t count); // Return the most recent count pooled closures
+closure_t* closure_promote(closure_t* closure); // Heap copy of a pooled closure that is about to escape
+void closure_free_promoted(closure_t* closure); // Free a closure_promote copy (not its function)
 
 // Bytecode utilities
 const char* opcode_name(opcode op);
+size_t instruction_length(const uint8_t* bytecode, size_t offset, size_t length); // 0 if truncated
 
 // Debug utilities
 void* vm_get_debug_info_at(function_t* function, size_t bytecode_offset);
@@ -414,5 +582,6 @@ void vm_runtime_error_with_debug(vm_t* vm, const char* message);
 void vm_runtime_error_with_values(vm_t* vm, const char* format, const value_t* a, const value_t* b,
                                   debug_location* location);
 const char* value_type_name(value_type type);
+const char* value_class_name(value_t value);
 
 #endif // SLATE_VM_H
@@ -237,6 +237,7 @@ ast_function* ast_create_function(char** parameters, size_t param_count, ast_nod
     node->param_count = param_count;
     node->body = body;
     node->is_expression = is_expression;
+    node->is_generator = 0;
     
     return node;
 }
@@ -451,6 +452,18 @@ ast_return* ast_create_return(ast_node* value, int line, int column) {
     return node;
 }
 
+ast_yield* ast_create_yield(ast_node* value, int line, int column) {
+    ast_yield* node = malloc(sizeof(ast_yield));
+    if (!node) return NULL;
+    
+    node->base.type = AST_YIELD;
+    node->base.line = line;
+    node->base.column = column;
+    node->value = value;
+    
+    return node;
+}
+
 ast_expression_stmt* ast_create_expression_stmt(ast_node* expression, int line, int column) {
     ast_expression_stmt* node = malloc(sizeof(ast_expression_stmt));
     if (!node) return NULL;
@@ -762,6 +775,12 @@ void ast_free(ast_node* node) {
             break;
         }
         
+        case AST_YIELD: {
+            ast_yield* yield_node = (ast_yield*)node;
+            ast_free(yield_node->value);
+            break;
+        }
+        
         case AST_EXPRESSION_STMT: {
             ast_expression_stmt* expr_node = (ast_expression_stmt*)node;
             ast_free(expr_node->expression);
@@ -875,6 +894,7 @@ const char* ast_node_type_name(ast_node_type type) {
         case AST_BREAK: return "BREAK";
         case AST_CONTINUE: return "CONTINUE";
         case AST_RETURN: return "RETURN";
+        case AST_YIELD: return "YIELD";
         case AST_EXPRESSION_STMT: return "EXPRESSION_STMT";
         case AST_BLOCK: return "BLOCK";
         case AST_PROGRAM: return "PROGRAM";
@@ -2,6 +2,7 @@
 #include <assert.h>
 #include <math.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -16,7 +17,12 @@
 #include "datetime.h"
 #include "int.h"
 #include "iterator.h"
+#include "promise.h"
+#include "typed_array.h"
+#include "map.h"
 #include "classes/Number/number.h"
+#include "classes/Number/number_parse.h"
+#include "classes/String/string_kernels.h"
 #include "classes/Float/float.h"
 #include "library_assert.h"
 #include "local_date.h"
@@ -36,8 +42,16 @@
 // Include datetime for date/time functions
 #include "datetime.h"
 
-// Static random initialization flag
-static int random_initialized = 0;
+// Seed for a VM's random() state, distinct for VMs created in the same second or on other threads
+static uint64_t random_seed(vm_t* vm) {
+    static _Atomic uint64_t sequence = 0;
+    uint64_t z = (uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)vm;
+    z += (atomic_fetch_add(&sequence, 1) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL; // splitmix64 finalizer
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z ? z : 1; // xorshift never leaves zero
+}
 
 
 // Register a built-in function in the VM's global namespace
@@ -50,21 +64,17 @@ void register_builtin(vm_t* vm, const char* name, native_t func, int min_args, i
 }
 
 // Global String class storage
-value_t* global_string_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_string_class = NULL;
 
 // Global Boolean class storage
-value_t* global_boolean_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_boolean_class = NULL;
 
 // Global Value class storage
-value_t* global_value_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_value_class = NULL;
 
 // Initialize all built-in functions
 void builtins_init(vm_t* vm) {
-    // Initialize random seed once
-    if (!random_initialized) {
-        srand((unsigned int)time(NULL));
-        random_initialized = 1;
-    }
+    vm->random_state = random_seed(vm);
 
     // Create the String class with its prototype
     do_object string_proto = do_create(NULL);
@@ -103,9 +113,30 @@ void builtins_init(vm_t* vm) {
     value_t replace_method = make_native(builtin_string_replace);
     do_set(string_proto, "replace", &replace_method, sizeof(value_t));
 
+    value_t replace_all_method = make_native(builtin_string_replace_all);
+    do_set(string_proto, "replaceAll", &replace_all_method, sizeof(value_t));
+
     value_t index_of_method = make_native(builtin_string_index_of);
     do_set(string_proto, "indexOf", &index_of_method, sizeof(value_t));
 
+    value_t last_index_of_method = make_native(builtin_string_last_index_of);
+    do_set(string_proto, "lastIndexOf", &last_index_of_method, sizeof(value_t));
+
+    value_t count_method = make_native(builtin_string_count);
+    do_set(string_proto, "count", &count_method, sizeof(value_t));
+
+    value_t split_method = make_native(builtin_string_split);
+    do_set(string_proto, "split", &split_method, sizeof(value_t));
+
+    value_t lines_method = make_native(builtin_string_lines);
+    do_set(string_proto, "lines", &lines_method, sizeof(value_t));
+
+    value_t split_whitespace_method = make_native(builtin_string_split_whitespace);
+    do_set(string_proto, "splitWhitespace", &split_whitespace_method, sizeof(value_t));
+
+    value_t parse_ints_method = make_native(builtin_string_parse_ints);
+    do_set(string_proto, "parseInts", &parse_ints_method, sizeof(value_t));
+
     value_t string_is_empty_method = make_native(builtin_string_is_empty);
     do_set(string_proto, "isEmpty", &string_is_empty_method, sizeof(value_t));
 
@@ -122,7 +153,7 @@ void builtins_init(vm_t* vm) {
     do_set(vm->globals, "String", &string_class, sizeof(value_t));
 
     // Store a global reference for use in make_string
-    static value_t string_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t string_class_storage;
     string_class_storage = vm_retain(string_class);
     global_string_class = &string_class_storage;
 
@@ -161,7 +192,7 @@ void builtins_init(vm_t* vm) {
     do_set(vm->globals, "Boolean", &boolean_class, sizeof(value_t));
 
     // Store a global reference for use in make_boolean
-    static value_t boolean_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t boolean_class_storage;
     boolean_class_storage = vm_retain(boolean_class);
     global_boolean_class = &boolean_class_storage;
 
@@ -174,6 +205,9 @@ void builtins_init(vm_t* vm) {
     // Initialize Iterator class
     iterator_class_init(vm);
 
+    // Initialize Promise class
+    promise_class_init(vm);
+
     // Initialize StringBuilder class
     string_builder_class_init(vm);
 
@@ -200,6 +234,10 @@ void builtins_init(vm_t* vm) {
     // Initialize BufferBuilder class
     buffer_builder_class_init(vm);
 
+    // Initialize Int32Array and Float64Array classes
+    typed_array_class_init(vm);
+    map_class_init(vm);
+
     // Initialize Null class
     initialize_null_class(vm);
     
@@ -244,6 +282,14 @@ void builtins_init(vm_t* vm) {
     register_builtin(vm, "read_file", builtin_read_file, 1, 1);
     register_builtin(vm, "write_file", builtin_write_file, 2, 2);
 
+    // Asynchronous I/O (event_loop.h)
+    register_builtin(vm, "spawn", builtin_spawn, 1, 1);
+    register_builtin(vm, "await", builtin_await, 1, 1);
+    register_builtin(vm, "sleep", builtin_sleep, 1, 1);
+    register_builtin(vm, "read_file_async", builtin_read_file_async, 1, 1);
+    register_builtin(vm, "write_file_async", builtin_write_file_async, 2, 2);
+    register_builtin(vm, "exec", builtin_exec, 1, 1);
+
     // Create the Value class - the ultimate superclass of all values
     do_object value_proto = do_create(NULL);
 
@@ -269,7 +315,7 @@ void builtins_init(vm_t* vm) {
     do_set(vm->globals, "Value", &value_class, sizeof(value_t));
 
     // Store a global reference for use in make_value functions
-    static value_t value_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t value_class_storage;
     value_class_storage = vm_retain(value_class);
     global_value_class = &value_class_storage;
 
@@ -491,7 +537,12 @@ value_t builtin_random(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "random() takes no arguments (%d given)", arg_count);
     }
 
-    return make_float64((double)rand() / RAND_MAX);
+    uint64_t x = vm->random_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    vm->random_state = x;
+    return make_float64((double)((x * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0); // 53 bits in [0, 1)
 }
 
 // sin(number) - Sine function (radians)
@@ -773,7 +824,28 @@ value_t builtin_input(vm_t* vm, int arg_count, value_t* args) {
     return make_string_ds(result);
 }
 
-// parse_int(string) - Convert string to integer
+// The number a parse_int/parse_number argument holds, ignoring surrounding whitespace
+static np_kind parse_argument(ds_string str, int flags, np_number* number) {
+    size_t length = ds_length(str);
+    size_t start = sk_skip_space(str, length);
+    size_t end = start + sk_skip_space_back(str + start, length - start);
+    return np_parse(str + start, end - start, flags, number);
+}
+
+static value_t parsed_value(np_number number) {
+    switch (number.kind) {
+    case NP_INT32:
+        return make_int32(number.as.int32);
+    case NP_BIGINT:
+        return make_bigint(number.as.bigint);
+    case NP_FLOAT32:
+        return make_float32(number.as.float32);
+    default:
+        return make_float64(number.as.float64);
+    }
+}
+
+// parse_int(string) - Convert string to integer: Int when it fits in 32 bits, BigInt otherwise
 value_t builtin_parse_int(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count != 1) {
         runtime_error(vm, "parse_int() takes exactly 1 argument (%d given)", arg_count);
@@ -784,28 +856,16 @@ value_t builtin_parse_int(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "parse_int() requires a string argument");
     }
 
-    char* endptr;
-    const char* str = arg.as.string;
-
-    // Try parsing as long long first
-    long long val = strtoll(str, &endptr, 10);
-
-    // Check if entire string was consumed
-    if (*endptr != '\0') {
-        runtime_error(vm, "'%s' is not a valid integer", str);
-    }
-
-    // Check if it fits in int32
-    if (val >= INT32_MIN && val <= INT32_MAX) {
-        return make_int32((int32_t)val);
-    } else {
-        // Use BigInt for large numbers
-        di_int big = di_from_int64(val);
-        return make_bigint(big);
+    np_number number;
+    if (parse_argument(arg.as.string, NP_INTEGER_ONLY, &number) == NP_INVALID) {
+        runtime_error(vm, "'%s' is not a valid integer", arg.as.string);
     }
+    return parsed_value(number);
 }
 
-// parse_number(string) - Convert string to number (int or float)
+// parse_number(string) - Convert string to number with the literal rules: Int or BigInt for
+// integers, Float when there is a fraction or exponent (float32 with an f suffix). Unlike in a
+// literal, the point may have digits on one side only, as in .5 and 1.
 value_t builtin_parse_number(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count != 1) {
         runtime_error(vm, "parse_number() takes exactly 1 argument (%d given)", arg_count);
@@ -816,36 +876,11 @@ value_t builtin_parse_number(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "parse_number() requires a string argument");
     }
 
-    const char* str = arg.as.string;
-    char* endptr;
-
-    // Check if it contains a decimal point
-    if (strchr(str, '.') != NULL) {
-        // Parse as float
-        double val = strtod(str, &endptr);
-
-        if (*endptr != '\0') {
-            runtime_error(vm, "'%s' is not a valid number", str);
-        }
-
-        return make_float64(val);
-    } else {
-        // Parse as integer first, then convert to appropriate type
-        long long val = strtoll(str, &endptr, 10);
-
-        if (*endptr != '\0') {
-            runtime_error(vm, "'%s' is not a valid number", str);
-        }
-
-        // Check if it fits in int32
-        if (val >= INT32_MIN && val <= INT32_MAX) {
-            return make_int32((int32_t)val);
-        } else {
-            // Use BigInt for large numbers
-            di_int big = di_from_int64(val);
-            return make_bigint(big);
-        }
+    np_number number;
+    if (parse_argument(arg.as.string, NP_BARE_POINT, &number) == NP_INVALID) {
+        runtime_error(vm, "'%s' is not a valid number", arg.as.string);
     }
+    return parsed_value(number);
 }
 
 // args() - Get command line arguments as array
@@ -881,7 +916,7 @@ value_t builtin_read_file(vm_t* vm, int arg_count, value_t* args) {
 
     value_t filename_val = args[0];
     if (filename_val.type != VAL_STRING) {
-        runtime_error(vm, "read_file() requires a string filename, not %s", value_type_name(filename_val.type));
+        runtime_error(vm, "read_file() requires a string filename, not %s", value_class_name(filename_val));
     }
 
     const char* filename = filename_val.as.string;
@@ -907,10 +942,10 @@ value_t builtin_write_file(vm_t* vm, int arg_count, value_t* args) {
     value_t filename_val = args[1];
 
     if (buffer_val.type != VAL_BUFFER) {
-        runtime_error(vm, "write_file() requires a buffer as first argument, not %s", value_type_name(buffer_val.type));
+        runtime_error(vm, "write_file() requires a buffer as first argument, not %s", value_class_name(buffer_val));
     }
     if (filename_val.type != VAL_STRING) {
-        runtime_error(vm, "write_file() requires a string filename, not %s", value_type_name(filename_val.type));
+        runtime_error(vm, "write_file() requires a string filename, not %s", value_class_name(filename_val));
     }
 
     const char* filename = filename_val.as.string;
@@ -1,4 +1,5 @@
 #include "adt_methods.h"
+#include "../Value/value.h"
 #include "vm.h"
 #include "runtime_error.h"
 #include "dynamic_string.h"
@@ -12,6 +13,17 @@
 // ADT INSTANCE METHODS (for ADT instances like Some(42))
 // ========================================
 
+// Field lookup by declared parameter name; returns NULL for unknown names
+value_t* adt_instance_field(adt_instance_t* adt, const char* name) {
+    adt_constructor_t* layout = adt->constructor;
+    for (uint16_t i = 0; i < layout->field_count; i++) {
+        if (strcmp(layout->field_names[i], name) == 0) {
+            return &adt->fields[i];
+        }
+    }
+    return NULL;
+}
+
 // ADT instance toString: "Some(42)"
 value_t adt_instance_toString(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count < 1) {
@@ -20,76 +32,48 @@ value_t adt_instance_toString(vm_t* vm, int arg_count, value_t* args) {
     }
     
     value_t receiver = args[0];
-    if (receiver.type != VAL_OBJECT) {
-        runtime_error(vm, "toString() can only be called on objects");
+    if (receiver.type != VAL_ADT) {
+        runtime_error(vm, "toString() can only be called on ADT instances");
         return make_null();
     }
     
-    // Get constructor information from the receiver's class
-    if (!receiver.class || receiver.class->type != VAL_CLASS || !receiver.class->as.class) {
-        return make_string("ADTInstance");
-    }
+    adt_instance_t* adt = receiver.as.adt;
+    const char* constructor_name = adt->constructor->class_value.as.class->name;
     
-    const char* constructor_name = receiver.class->as.class->name;
-    if (!constructor_name) {
-        return make_string("ADTInstance");
-    }
-    
-    // Get parameter count from the constructor class
-    int32_t* param_count_ptr = NULL;
-    if (receiver.class->as.class->static_properties) {
-        param_count_ptr = (int32_t*)do_get(receiver.class->as.class->static_properties, "__constructor_param_count");
+    if (adt->constructor->field_count == 0) {
+        // No parameters - singleton case
+        return make_string(constructor_name);
     }
-    int param_count = param_count_ptr ? *param_count_ptr : 0;
     
-    // Format the constructor display
-    char buffer[512];
+    // Format with field values in declaration order
+    ds_builder sb = ds_builder_create();
+    ds_builder_append(sb, constructor_name);
+    ds_builder_append(sb, "(");
     
-    if (param_count == 0) {
-        // No parameters - singleton case
-        return make_string(constructor_name);
-    } else {
-        // Format with actual parameter names and values
-        snprintf(buffer, sizeof(buffer), "%s(", constructor_name);
+    for (uint16_t i = 0; i < adt->constructor->field_count; i++) {
+        value_t* param_value = &adt->fields[i];
+        if (i > 0) ds_builder_append(sb, ", ");
         
-        for (int i = 0; i < param_count; i++) {
-            // Get parameter name from class metadata
-            char param_key[32];
-            snprintf(param_key, sizeof(param_key), "__param_%d", i);
-            ds_string* param_name_ptr = (ds_string*)do_get(receiver.class->as.class->static_properties, param_key);
-            
-            if (param_name_ptr) {
-                // Get parameter value from instance
-                value_t* param_value = (value_t*)do_get(receiver.as.object, *param_name_ptr);
-                if (param_value) {
-                    if (i > 0) strcat(buffer, ", ");
-                    
-                    // Format the parameter value
-                    if (param_value->type == VAL_INT32) {
-                        char temp[32];
-                        snprintf(temp, sizeof(temp), "%d", param_value->as.int32);
-                        strcat(buffer, temp);
-                    } else if (param_value->type == VAL_STRING) {
-                        char temp[128];
-                        snprintf(temp, sizeof(temp), "\"%s\"", param_value->as.string);
-                        strcat(buffer, temp);
-                    } else if (param_value->type == VAL_BOOLEAN) {
-                        strcat(buffer, param_value->as.boolean ? "true" : "false");
-                    } else if (param_value->type == VAL_NULL) {
-                        strcat(buffer, "null");
-                    } else {
-                        strcat(buffer, "...");
-                    }
-                } else {
-                    if (i > 0) strcat(buffer, ", ");
-                    strcat(buffer, "?");
-                }
-            }
+        // Format the parameter value
+        if (param_value->type == VAL_INT32) {
+            ds_builder_append_int(sb, param_value->as.int32);
+        } else if (param_value->type == VAL_STRING) {
+            ds_builder_append(sb, "\"");
+            ds_builder_append_string(sb, param_value->as.string);
+            ds_builder_append(sb, "\"");
+        } else if (param_value->type == VAL_BOOLEAN) {
+            ds_builder_append(sb, param_value->as.boolean ? "true" : "false");
+        } else if (param_value->type == VAL_NULL) {
+            ds_builder_append(sb, "null");
+        } else {
+            ds_builder_append(sb, "...");
         }
-        strcat(buffer, ")");
-        
-        return make_string(buffer);
     }
+    ds_builder_append(sb, ")");
+    
+    ds_string result = ds_builder_to_string(sb);
+    ds_builder_release(&sb);
+    return make_string_ds(result);
 }
 
 // ADT instance equals: structural equality
@@ -102,71 +86,29 @@ value_t adt_instance_equals(vm_t* vm, int arg_count, value_t* args) {
     value_t receiver = args[0];
     value_t other = args[1];
     
-    if (receiver.type != VAL_OBJECT) {
-        runtime_error(vm, "equals() can only be called on objects");
+    if (receiver.type != VAL_ADT) {
+        runtime_error(vm, "equals() can only be called on ADT instances");
         return make_boolean(0);
     }
     
-    // Only ADT objects can be equal to ADT objects
-    if (other.type != VAL_OBJECT) {
+    // Only ADT instances can be equal to ADT instances
+    if (other.type != VAL_ADT) {
         return make_boolean(0);
     }
     
     // Identity equality check
-    if (receiver.as.object == other.as.object) {
+    if (receiver.as.adt == other.as.adt) {
         return make_boolean(1);
     }
     
-    // Check if both values have classes (all ADT instances should have classes)
-    if (!receiver.class || !other.class || 
-        receiver.class->type != VAL_CLASS || other.class->type != VAL_CLASS) {
+    // ADT instances must be from the same constructor to be equal
+    if (receiver.as.adt->constructor != other.as.adt->constructor) {
         return make_boolean(0);
     }
     
-    // ADT instances must be from the same constructor class to be equal
-    if (receiver.class->as.class != other.class->as.class) {
-        return make_boolean(0);
-    }
-    
-    // If they're from the same constructor class, check if it's a singleton
-    ds_string* case_type = NULL;
-    if (receiver.class->as.class->static_properties) {
-        case_type = (ds_string*)do_get(receiver.class->as.class->static_properties, "__constructor_case_type");
-    }
-    
-    // For singletons, class equality is sufficient (None == None)
-    if (case_type && strcmp(*case_type, "singleton") == 0) {
-        return make_boolean(1);
-    }
-    
-    // For constructors, compare all parameters structurally
-    // Get parameter count from the constructor class
-    int32_t* param_count_ptr = NULL;
-    if (receiver.class->as.class->static_properties) {
-        param_count_ptr = (int32_t*)do_get(receiver.class->as.class->static_properties, "__constructor_param_count");
-    }
-    int param_count = param_count_ptr ? *param_count_ptr : 0;
-    
-    // Compare each parameter by name
-    for (int i = 0; i < param_count; i++) {
-        char param_key[32];
-        snprintf(param_key, sizeof(param_key), "__param_%d", i);
-        ds_string* param_name_ptr = (ds_string*)do_get(receiver.class->as.class->static_properties, param_key);
-        
-        if (!param_name_ptr) {
-            continue; // Skip if parameter name not found
-        }
-        
-        ds_string param_name = *param_name_ptr;
-        value_t* val1 = (value_t*)do_get(receiver.as.object, param_name);
-        value_t* val2 = (value_t*)do_get(other.as.object, param_name);
-        
-        if (!val1 || !val2) {
-            return make_boolean(0); // Parameter missing
-        }
-        
-        // Use proper equals comparison for parameter values
-        if (!call_equals_method(vm, *val1, *val2)) {
+    // Same constructor: compare fields positionally (singletons have none, so None == None)
+    for (uint16_t i = 0; i < receiver.as.adt->constructor->field_count; i++) {
+        if (!call_equals_method(vm, receiver.as.adt->fields[i], other.as.adt->fields[i])) {
             return make_boolean(0);
         }
     }
@@ -175,7 +117,7 @@ value_t adt_instance_equals(vm_t* vm, int arg_count, value_t* args) {
     return make_boolean(1);
 }
 
-// ADT instance hash: hash based on case name + parameters
+// ADT instance hash: hash based on constructor tag + field values
 value_t adt_instance_hash(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count < 1) {
         runtime_error(vm, "hash() method requires receiver");
@@ -183,28 +125,27 @@ value_t adt_instance_hash(vm_t* vm, int arg_count, value_t* args) {
     }
     
     value_t receiver = args[0];
-    if (receiver.type != VAL_OBJECT) {
-        runtime_error(vm, "hash() can only be called on objects");
+    if (receiver.type != VAL_ADT) {
+        runtime_error(vm, "hash() can only be called on ADT instances");
         return make_null();
     }
     
-    // Get ADT type information for hashing
-    ds_string* type_name = (ds_string*)do_get(receiver.as.object, "__type");
-    ds_string* case_type = (ds_string*)do_get(receiver.as.object, "__case_type");
-    
-    if (!type_name || !case_type) {
-        return make_int32(0);
-    }
-    
-    // Simple hash based on case name
-    // TODO: Include parameter values in hash
+    adt_instance_t* adt = receiver.as.adt;
     uint32_t hash = 2166136261u; // FNV offset basis
-    const char* name = *type_name;
+    const char* name = adt->constructor->class_value.as.class->name;
     while (*name) {
         hash ^= (uint32_t)*name++;
         hash *= 16777619u; // FNV prime
     }
     
+    for (uint16_t i = 0; i < adt->constructor->field_count; i++) {
+        value_t field_hash = builtin_value_hash(vm, 1, &adt->fields[i]);
+        if (field_hash.type == VAL_INT32) {
+            hash ^= (uint32_t)field_hash.as.int32;
+            hash *= 16777619u; // FNV prime
+        }
+    }
+    
     return make_int32((int32_t)hash);
 }
 
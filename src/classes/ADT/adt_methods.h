@@ -4,6 +4,9 @@
 #include "vm.h"
 #include "value.h"
 
+// Field lookup by parameter name (NULL if the constructor has no such field)
+value_t* adt_instance_field(adt_instance_t* adt, const char* name);
+
 // ADT Instance Methods (for ADT instances like Some(42))
 value_t adt_instance_toString(vm_t* vm, int arg_count, value_t* args);
 value_t adt_instance_equals(vm_t* vm, int arg_count, value_t* args);
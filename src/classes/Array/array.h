@@ -32,6 +32,16 @@ value_t builtin_array_map(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_array_filter(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_array_flatmap(vm_t* vm, int arg_count, value_t* args);
 
+// Array Sorting Methods
+value_t builtin_array_sort(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_array_sorted(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_array_sort_by(vm_t* vm, int arg_count, value_t* args);
+
+// Array Parallel Methods
+value_t builtin_array_par_map(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_array_par_filter(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_array_par_reduce(vm_t* vm, int arg_count, value_t* args);
+
 // External dependencies from other modules
 value_t builtin_iterator(vm_t* vm, int arg_count, value_t* args);
 
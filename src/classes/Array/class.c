@@ -3,7 +3,7 @@
 #include "dynamic_object.h"
 
 // Global Array class storage
-value_t* global_array_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_array_class = NULL;
 
 // Array factory function
 value_t array_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
@@ -89,6 +89,26 @@ void array_class_init(vm_t* vm) {
     value_t array_flatmap_method = make_native(builtin_array_flatmap);
     do_set(array_proto, "flatMap", &array_flatmap_method, sizeof(value_t));
 
+    // Native sorting
+    value_t array_sort_method = make_native(builtin_array_sort);
+    do_set(array_proto, "sort", &array_sort_method, sizeof(value_t));
+
+    value_t array_sorted_method = make_native(builtin_array_sorted);
+    do_set(array_proto, "sorted", &array_sorted_method, sizeof(value_t));
+
+    value_t array_sort_by_method = make_native(builtin_array_sort_by);
+    do_set(array_proto, "sortBy", &array_sort_by_method, sizeof(value_t));
+
+    // Parallel variants for pure callbacks over large arrays
+    value_t array_par_map_method = make_native(builtin_array_par_map);
+    do_set(array_proto, "parMap", &array_par_map_method, sizeof(value_t));
+
+    value_t array_par_filter_method = make_native(builtin_array_par_filter);
+    do_set(array_proto, "parFilter", &array_par_filter_method, sizeof(value_t));
+
+    value_t array_par_reduce_method = make_native(builtin_array_par_reduce);
+    do_set(array_proto, "parReduce", &array_par_reduce_method, sizeof(value_t));
+
     // Utility methods
     value_t array_hash_method = make_native(builtin_array_hash);
     do_set(array_proto, "hash", &array_hash_method, sizeof(value_t));
@@ -114,7 +134,7 @@ void array_class_init(vm_t* vm) {
     do_set(vm->globals, "Array", &array_class, sizeof(value_t));
 
     // Store a global reference for use in make_array
-    static value_t array_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t array_class_storage;
     array_class_storage = vm_retain(array_class);
     global_array_class = &array_class_storage;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "builtins.h"
 #include "dynamic_array.h"
 #include <stdint.h>
+#include <string.h>
 
 // Using centralized call_equals_method from vm/utilities.c
 
@@ -235,6 +236,48 @@ value_t builtin_array_non_empty(vm_t* vm, int arg_count, value_t* args) {
     return make_boolean(!is_empty);
 }
 
+// Index of the first element equal to needle, or -1. Primitive needles with builtin
+// .equals() are matched by a direct scan; elements that need .equals() dispatch
+// (bigints, objects, user classes) still go through call_equals_method.
+static int32_t array_find(vm_t* vm, da_array array, value_t needle) {
+    size_t length = da_length(array);
+    value_t* elems = (value_t*)da_data(array);
+
+    if (needle.type == VAL_INT32 && needle.class == global_int_class) {
+        int32_t target = needle.as.int32;
+        for (size_t i = 0; i < length; i++) {
+            if (elems[i].type == VAL_INT32) {
+                if (elems[i].as.int32 == target) return (int32_t)i;
+            } else if (call_equals_method(vm, elems[i], needle)) {
+                return (int32_t)i;
+            }
+        }
+        return -1;
+    }
+
+    if (needle.type == VAL_STRING && needle.class == global_string_class && needle.as.string) {
+        size_t needle_length = ds_length(needle.as.string);
+        for (size_t i = 0; i < length; i++) {
+            if (elems[i].type == VAL_STRING) {
+                ds_string s = elems[i].as.string;
+                if (s && ds_length(s) == needle_length && memcmp(s, needle.as.string, needle_length) == 0) {
+                    return (int32_t)i;
+                }
+            } else if (call_equals_method(vm, elems[i], needle)) {
+                return (int32_t)i;
+            }
+        }
+        return -1;
+    }
+
+    for (size_t i = 0; i < length; i++) {
+        if (call_equals_method(vm, elems[i], needle)) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
 // Array method: indexOf(element)
 // Returns first index of element, or -1 if not found
 value_t builtin_array_index_of(vm_t* vm, int arg_count, value_t* args) {
@@ -249,18 +292,7 @@ value_t builtin_array_index_of(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "indexOf() can only be called on arrays");
     }
     
-    da_array array = receiver.as.array;
-    size_t length = da_length(array);
-    
-    // Search for element
-    for (size_t i = 0; i < length; i++) {
-        value_t* elem = (value_t*)da_get(array, i);
-        if (call_equals_method(vm, *elem, element)) {
-            return make_int32((int32_t)i);
-        }
-    }
-    
-    return make_int32(-1); // Not found
+    return make_int32(array_find(vm, receiver.as.array, element));
 }
 
 // Array method: contains(element)
@@ -277,18 +309,7 @@ value_t builtin_array_contains(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "contains() can only be called on arrays");
     }
     
-    da_array array = receiver.as.array;
-    size_t length = da_length(array);
-    
-    // Search for element
-    for (size_t i = 0; i < length; i++) {
-        value_t* elem = (value_t*)da_get(array, i);
-        if (call_equals_method(vm, *elem, element)) {
-            return make_boolean(true);
-        }
-    }
-    
-    return make_boolean(false); // Not found
+    return make_boolean(array_find(vm, receiver.as.array, element) >= 0);
 }
 
 // Array method: copy()
@@ -0,0 +1,121 @@
+#include "array.h"
+#include "builtins.h"
+#include "dynamic_array.h"
+#include "parallel.h"
+#include "vm.h"
+#include <stdlib.h>
+
+// Parallel variants of map, filter and reduce. They split the array across worker threads when
+// the callback is provably pure and every element is a plain value (see parallel.h); otherwise
+// they run exactly like their sequential counterparts, so they are always safe to call.
+
+static int is_callable(value_t v) {
+    return v.type == VAL_NATIVE || v.type == VAL_CLOSURE ||
+           v.type == VAL_FUNCTION || v.type == VAL_BOUND_METHOD;
+}
+
+value_t builtin_array_par_map(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) {
+        runtime_error(vm, "parMap() takes exactly 1 argument (%d given)", arg_count - 1);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "parMap() can only be called on arrays");
+    }
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "parMap() expects a function");
+    }
+
+    da_array in = args[0].as.array;
+    size_t len = da_length(in);
+    if (len >= PARALLEL_MIN_ELEMENTS) {
+        parallel_kernel* kernel = parallel_kernel_create(vm, args[1], 2);
+        if (kernel) {
+            da_array out = da_new(sizeof(value_t));
+            da_resize(out, (int)len); // Workers write their chunks in place
+            bool done = parallel_map(vm, kernel, da_data(in), len, da_data(out));
+            parallel_kernel_destroy(kernel);
+            if (done) {
+                return make_array(out);
+            }
+            da_release(&out); // Only plain values were written: nothing to release
+        }
+    }
+    return builtin_array_map(vm, arg_count, args);
+}
+
+value_t builtin_array_par_filter(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) {
+        runtime_error(vm, "parFilter() takes exactly 1 argument (%d given)", arg_count - 1);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "parFilter() can only be called on arrays");
+    }
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "parFilter() expects a function");
+    }
+
+    da_array in = args[0].as.array;
+    size_t len = da_length(in);
+    if (len >= PARALLEL_MIN_ELEMENTS) {
+        parallel_kernel* kernel = parallel_kernel_create(vm, args[1], 2);
+        bool* keep = kernel ? malloc(len) : NULL;
+        if (keep && parallel_test(vm, kernel, da_data(in), len, keep)) {
+            parallel_kernel_destroy(kernel);
+            const value_t* elements = da_data(in);
+            da_array out = da_new(sizeof(value_t));
+            for (size_t i = 0; i < len; i++) {
+                if (keep[i]) {
+                    da_push(out, &elements[i]); // Plain values: no retain needed
+                }
+            }
+            free(keep);
+            return make_array(out);
+        }
+        free(keep);
+        parallel_kernel_destroy(kernel);
+    }
+    return builtin_array_filter(vm, arg_count, args);
+}
+
+// reduce(fn, initial): acc = fn(acc, element) from the left
+static value_t fold(vm_t* vm, value_t reducer, value_t acc, const value_t* elements, size_t count) {
+    acc = vm_retain(acc);
+    for (size_t i = 0; i < count; i++) {
+        value_t call_args[2] = {acc, vm_retain(elements[i])};
+        value_t next = vm_call_slate_function_safe(vm, reducer, 2, call_args);
+        vm_release(call_args[0]);
+        vm_release(call_args[1]);
+        acc = next;
+    }
+    return acc;
+}
+
+value_t builtin_array_par_reduce(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 3) {
+        runtime_error(vm, "parReduce() takes exactly 2 arguments (%d given)", arg_count - 1);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "parReduce() can only be called on arrays");
+    }
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "parReduce() expects a function");
+    }
+
+    da_array in = args[0].as.array;
+    size_t len = da_length(in);
+    value_t initial = args[2];
+    if (len >= PARALLEL_MIN_ELEMENTS) {
+        parallel_kernel* kernel = parallel_kernel_create(vm, args[1], 2);
+        value_t* partials = kernel ? malloc(sizeof(value_t) * parallel_thread_count()) : NULL;
+        size_t partial_count = partials ? parallel_fold(vm, kernel, da_data(in), len, partials) : 0;
+        parallel_kernel_destroy(kernel);
+        if (partial_count > 0) {
+            // The chunks were folded independently, so fn must be associative - the contract of parReduce
+            value_t result = fold(vm, args[1], initial, partials, partial_count);
+            free(partials);
+            return result;
+        }
+        free(partials);
+    }
+    return fold(vm, args[1], initial, da_data(in), len);
+}
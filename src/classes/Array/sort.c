@@ -0,0 +1,553 @@
+#include "array.h"
+#include "builtins.h"
+#include "dynamic_array.h"
+#include "vm.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Native sorting for arrays. Every path first computes a permutation of element indices and
+// then gathers the elements through it, so the array is only rewritten once sorting has
+// finished and a comparator that fails part way leaves it untouched.
+//
+// Without a comparator the keys are classified once and sorted with a type-specialized
+// introsort (Int32, Float, String) that never calls back into Slate; large Int32 arrays use a
+// radix sort instead. Ties are broken by the original index, which makes those sorts stable
+// as well. With a comparator, a natural merge sort (timsort-style runs plus binary insertion)
+// keeps the number of Slate calls low.
+
+#define SORT_INSERTION_THRESHOLD 24
+#define SORT_MIN_RUN 32
+
+// ===========================
+// INTROSORT OVER C KEYS
+// ===========================
+
+// Quicksort with a median-of-three pivot, insertion sort for short ranges and a heapsort
+// fallback once the recursion gets too deep. Keys are unique (they carry their index), so
+// there is no equal-key degeneration to guard against.
+#define DEFINE_INTROSORT(name, type, less)                                          \
+    static void name##_insertion(type* a, size_t n) {                               \
+        for (size_t i = 1; i < n; i++) {                                             \
+            type x = a[i];                                                           \
+            size_t j = i;                                                            \
+            while (j > 0 && less(x, a[j - 1])) {                                     \
+                a[j] = a[j - 1];                                                     \
+                j--;                                                                 \
+            }                                                                        \
+            a[j] = x;                                                                \
+        }                                                                            \
+    }                                                                                \
+    static void name##_sift_down(type* a, size_t root, size_t n) {                   \
+        type x = a[root];                                                            \
+        for (;;) {                                                                   \
+            size_t child = 2 * root + 1;                                             \
+            if (child >= n) break;                                                   \
+            if (child + 1 < n && less(a[child], a[child + 1])) child++;              \
+            if (!less(x, a[child])) break;                                           \
+            a[root] = a[child];                                                      \
+            root = child;                                                            \
+        }                                                                            \
+        a[root] = x;                                                                 \
+    }                                                                                \
+    static void name##_heapsort(type* a, size_t n) {                                 \
+        for (size_t i = n / 2; i-- > 0;) name##_sift_down(a, i, n);                  \
+        for (size_t end = n; end-- > 1;) {                                           \
+            type top = a[0];                                                         \
+            a[0] = a[end];                                                           \
+            a[end] = top;                                                            \
+            name##_sift_down(a, 0, end);                                             \
+        }                                                                            \
+    }                                                                                \
+    static void name##_loop(type* a, size_t n, int depth) {                          \
+        while (n > SORT_INSERTION_THRESHOLD) {                                       \
+            if (depth-- == 0) {                                                      \
+                name##_heapsort(a, n);                                               \
+                return;                                                              \
+            }                                                                        \
+            type t;                                                                  \
+            size_t mid = n / 2;                                                      \
+            if (less(a[mid], a[0])) { t = a[mid]; a[mid] = a[0]; a[0] = t; }         \
+            if (less(a[n - 1], a[mid])) {                                            \
+                t = a[n - 1]; a[n - 1] = a[mid]; a[mid] = t;                         \
+                if (less(a[mid], a[0])) { t = a[mid]; a[mid] = a[0]; a[0] = t; }     \
+            }                                                                        \
+            type pivot = a[mid];                                                     \
+            size_t i = 0, j = n - 1;                                                 \
+            for (;;) {                                                               \
+                while (less(a[i], pivot)) i++;                                       \
+                while (less(pivot, a[j])) j--;                                       \
+                if (i >= j) break;                                                   \
+                t = a[i]; a[i] = a[j]; a[j] = t;                                     \
+                i++;                                                                 \
+                j--;                                                                 \
+            }                                                                        \
+            /* Recurse into the smaller side, loop on the larger */                  \
+            size_t left = j + 1;                                                     \
+            if (left < n - left) {                                                   \
+                name##_loop(a, left, depth);                                         \
+                a += left;                                                           \
+                n -= left;                                                           \
+            } else {                                                                 \
+                name##_loop(a + left, n - left, depth);                              \
+                n = left;                                                            \
+            }                                                                        \
+        }                                                                            \
+        name##_insertion(a, n);                                                      \
+    }                                                                                \
+    static void name(type* a, size_t n) {                                            \
+        int depth = 0;                                                               \
+        for (size_t m = n; m > 1; m >>= 1) depth += 2;                               \
+        name##_loop(a, n, depth);                                                    \
+    }
+
+// Int32 keys: the biased value in the high half, the index in the low half
+#define PACKED_LESS(x, y) ((x) < (y))
+DEFINE_INTROSORT(sort_packed, uint64_t, PACKED_LESS)
+
+// Large Int32 arrays: a stable LSD radix sort on the biased value, one byte per pass. The
+// packed keys start in index order, so only the high half needs sorting.
+#define SORT_RADIX_THRESHOLD 1024
+
+static bool radix_sort_packed(uint64_t* keys, size_t n) {
+    uint64_t* buffer = malloc(n * sizeof(uint64_t));
+    if (!buffer) return false;
+    size_t counts[4][256] = {{0}};
+    for (size_t i = 0; i < n; i++) {
+        uint32_t high = (uint32_t)(keys[i] >> 32);
+        counts[0][high & 0xff]++;
+        counts[1][(high >> 8) & 0xff]++;
+        counts[2][(high >> 16) & 0xff]++;
+        counts[3][high >> 24]++;
+    }
+    uint64_t* from = keys;
+    uint64_t* to = buffer;
+    for (int pass = 0; pass < 4; pass++) {
+        // A byte that is the same everywhere leaves the order unchanged
+        if (counts[pass][(uint32_t)(from[0] >> (32 + 8 * pass)) & 0xff] == n) continue;
+        size_t offset = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t count = counts[pass][b];
+            counts[pass][b] = offset;
+            offset += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            to[counts[pass][(uint32_t)(from[i] >> (32 + 8 * pass)) & 0xff]++] = from[i];
+        }
+        uint64_t* t = from;
+        from = to;
+        to = t;
+    }
+    if (from != keys) {
+        memcpy(keys, from, n * sizeof(uint64_t));
+    }
+    free(buffer);
+    return true;
+}
+
+// Float keys: the double's bits remapped so unsigned order is numeric order (NaN last)
+typedef struct {
+    uint64_t bits;
+    size_t index;
+} float_key;
+
+#define FLOAT_KEY_LESS(x, y) ((x).bits < (y).bits || ((x).bits == (y).bits && (x).index < (y).index))
+DEFINE_INTROSORT(sort_float_keys, float_key, FLOAT_KEY_LESS)
+
+// String keys: byte order, which for UTF-8 is code point order
+typedef struct {
+    const char* chars;
+    size_t length;
+    size_t index;
+} string_key;
+
+static inline int string_key_compare(const string_key* x, const string_key* y) {
+    size_t common = x->length < y->length ? x->length : y->length;
+    int order = memcmp(x->chars, y->chars, common);
+    if (order != 0) return order;
+    if (x->length != y->length) return x->length < y->length ? -1 : 1;
+    return x->index < y->index ? -1 : (x->index > y->index);
+}
+
+#define STRING_KEY_LESS(x, y) (string_key_compare(&(x), &(y)) < 0)
+DEFINE_INTROSORT(sort_string_keys, string_key, STRING_KEY_LESS)
+
+static uint64_t float_sort_bits(double x) {
+    if (x != x) return UINT64_MAX; // NaN sorts after everything
+    if (x == 0) x = 0.0;           // -0.0 and 0.0 tie, keeping their original order
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return (bits & UINT64_C(0x8000000000000000)) ? ~bits : bits | UINT64_C(0x8000000000000000);
+}
+
+static double number_as_double(value_t value) {
+    switch (value.type) {
+        case VAL_INT32: return (double)value.as.int32;
+        case VAL_FLOAT32: return (double)value.as.float32;
+        default: return value.as.float64;
+    }
+}
+
+// ===========================
+// NATURAL MERGE SORT OVER INDICES
+// ===========================
+
+typedef struct sort_context sort_context;
+struct sort_context {
+    vm_t* vm;
+    const char* name;
+    const value_t* keys;
+    value_t comparator;  // Undefined when ordering keys by value
+    size_t* permutation; // Owned allocations, freed before raising an error
+    size_t* scratch;
+};
+
+static void sort_context_free(sort_context* ctx) {
+    free(ctx->permutation);
+    free(ctx->scratch);
+    ctx->permutation = NULL;
+    ctx->scratch = NULL;
+}
+
+// < 0 when key a orders before key b
+static int sort_compare(sort_context* ctx, size_t a, size_t b) {
+    if (ctx->comparator.type == VAL_UNDEFINED) {
+        return compare_numbers(ctx->keys[a], ctx->keys[b]);
+    }
+
+    value_t call_args[2];
+    call_args[0] = vm_retain(ctx->keys[a]);
+    call_args[1] = vm_retain(ctx->keys[b]);
+    value_t result = vm_call_slate_function_safe(ctx->vm, ctx->comparator, 2, call_args);
+    vm_release(call_args[0]);
+    vm_release(call_args[1]);
+
+    if (!is_number(result)) {
+        const char* type = value_class_name(result);
+        vm_release(result);
+        sort_context_free(ctx);
+        runtime_error(ctx->vm, "%s() comparator must return a number, not %s", ctx->name, type);
+    }
+    int order = compare_numbers(result, make_int32(0));
+    vm_release(result);
+    return order;
+}
+
+// Sorts perm[0, n) where perm[0, sorted) is already in order
+static void binary_insertion_sort(sort_context* ctx, size_t* perm, size_t sorted, size_t n) {
+    for (size_t i = sorted; i < n; i++) {
+        size_t x = perm[i];
+        size_t lo = 0, hi = i;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            // Insert after equal keys to stay stable
+            if (sort_compare(ctx, x, perm[mid]) < 0) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        memmove(perm + lo + 1, perm + lo, (i - lo) * sizeof(size_t));
+        perm[lo] = x;
+    }
+}
+
+// Extends an ascending or strictly descending run starting at perm[0]; returns its length
+static size_t natural_run(sort_context* ctx, size_t* perm, size_t n) {
+    if (n < 2) return n;
+    size_t end = 2;
+    if (sort_compare(ctx, perm[1], perm[0]) < 0) {
+        // Strictly descending, so reversing it can't reorder equal keys
+        while (end < n && sort_compare(ctx, perm[end], perm[end - 1]) < 0) end++;
+        for (size_t i = 0, j = end - 1; i < j; i++, j--) {
+            size_t t = perm[i];
+            perm[i] = perm[j];
+            perm[j] = t;
+        }
+    } else {
+        while (end < n && sort_compare(ctx, perm[end], perm[end - 1]) >= 0) end++;
+    }
+    return end;
+}
+
+// Merges perm[0, mid) and perm[mid, n), copying only the left run out
+static void merge_runs(sort_context* ctx, size_t* perm, size_t mid, size_t n) {
+    // Already in order: one comparison instead of a merge
+    if (sort_compare(ctx, perm[mid], perm[mid - 1]) >= 0) return;
+
+    memcpy(ctx->scratch, perm, mid * sizeof(size_t));
+    size_t* left = ctx->scratch;
+    size_t i = 0, j = mid, k = 0;
+    while (i < mid && j < n) {
+        // Take from the right only when strictly smaller to stay stable
+        if (sort_compare(ctx, perm[j], left[i]) < 0) {
+            perm[k++] = perm[j++];
+        } else {
+            perm[k++] = left[i++];
+        }
+    }
+    memcpy(perm + k, left + i, (mid - i) * sizeof(size_t));
+}
+
+static void merge_sort(sort_context* ctx, size_t* perm, size_t n) {
+    // Split into runs of at least SORT_MIN_RUN, recording where each one starts
+    size_t run_capacity = n / SORT_MIN_RUN + 2;
+    size_t* run_starts = malloc(run_capacity * sizeof(size_t));
+    ctx->scratch = malloc((n / 2 + 1) * sizeof(size_t));
+    if (!run_starts || !ctx->scratch) {
+        free(run_starts);
+        sort_context_free(ctx);
+        runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+    }
+
+    size_t run_count = 0;
+    for (size_t start = 0; start < n;) {
+        size_t length = natural_run(ctx, perm + start, n - start);
+        if (length < SORT_MIN_RUN) {
+            size_t forced = n - start < SORT_MIN_RUN ? n - start : SORT_MIN_RUN;
+            binary_insertion_sort(ctx, perm + start, length, forced);
+            length = forced;
+        }
+        run_starts[run_count++] = start;
+        start += length;
+    }
+    run_starts[run_count] = n;
+
+    // Merge neighbouring runs pairwise until one is left
+    while (run_count > 1) {
+        size_t merged = 0;
+        for (size_t r = 0; r < run_count; r += 2) {
+            size_t start = run_starts[r];
+            if (r + 1 < run_count) {
+                size_t* block = perm + start;
+                size_t mid = run_starts[r + 1] - start;
+                size_t end = run_starts[r + 2] - start;
+                // The left run is at most half the block when runs are balanced; otherwise grow scratch
+                if (mid > n / 2 + 1) {
+                    size_t* grown = realloc(ctx->scratch, mid * sizeof(size_t));
+                    if (!grown) {
+                        free(run_starts);
+                        sort_context_free(ctx);
+                        runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+                    }
+                    ctx->scratch = grown;
+                }
+                merge_runs(ctx, block, mid, end);
+            }
+            run_starts[merged++] = start;
+        }
+        run_starts[merged] = n;
+        run_count = merged;
+    }
+    free(run_starts);
+}
+
+// ===========================
+// PERMUTATIONS
+// ===========================
+
+// Fills ctx->permutation with the order of ctx->keys (by value, or by the comparator)
+static void sort_permutation(sort_context* ctx, size_t n) {
+    ctx->permutation = malloc((n ? n : 1) * sizeof(size_t));
+    if (!ctx->permutation) {
+        runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+    }
+    size_t* perm = ctx->permutation;
+    const value_t* keys = ctx->keys;
+
+    if (ctx->comparator.type != VAL_UNDEFINED) {
+        for (size_t i = 0; i < n; i++) perm[i] = i;
+        merge_sort(ctx, perm, n);
+        return;
+    }
+
+    // Classify the keys once so the common homogeneous cases get a specialized sort
+    bool all_int32 = true, all_float = true, all_numbers = true, all_strings = true;
+    for (size_t i = 0; i < n; i++) {
+        value_type type = keys[i].type;
+        all_int32 = all_int32 && type == VAL_INT32;
+        all_float = all_float && (type == VAL_INT32 || type == VAL_FLOAT32 || type == VAL_FLOAT64);
+        all_numbers = all_numbers && is_number(keys[i]);
+        all_strings = all_strings && type == VAL_STRING;
+        if (!all_numbers && !all_strings) {
+            sort_context_free(ctx);
+            runtime_error(ctx->vm, "%s() can only order numbers or strings without a comparator (found %s)",
+                          ctx->name, value_class_name(keys[i]));
+        }
+    }
+
+    if (all_int32 && n <= UINT32_MAX) {
+        uint64_t* packed = malloc((n ? n : 1) * sizeof(uint64_t));
+        if (!packed) {
+            sort_context_free(ctx);
+            runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint32_t biased = (uint32_t)keys[i].as.int32 ^ UINT32_C(0x80000000);
+            packed[i] = ((uint64_t)biased << 32) | (uint64_t)i;
+        }
+        if (n < SORT_RADIX_THRESHOLD || !radix_sort_packed(packed, n)) {
+            sort_packed(packed, n);
+        }
+        for (size_t i = 0; i < n; i++) perm[i] = (size_t)(packed[i] & UINT32_MAX);
+        free(packed);
+    } else if (all_float) {
+        float_key* sorted = malloc((n ? n : 1) * sizeof(float_key));
+        if (!sorted) {
+            sort_context_free(ctx);
+            runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+        }
+        for (size_t i = 0; i < n; i++) {
+            sorted[i].bits = float_sort_bits(number_as_double(keys[i]));
+            sorted[i].index = i;
+        }
+        sort_float_keys(sorted, n);
+        for (size_t i = 0; i < n; i++) perm[i] = sorted[i].index;
+        free(sorted);
+    } else if (all_strings) {
+        string_key* sorted = malloc((n ? n : 1) * sizeof(string_key));
+        if (!sorted) {
+            sort_context_free(ctx);
+            runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+        }
+        for (size_t i = 0; i < n; i++) {
+            sorted[i].chars = keys[i].as.string;
+            sorted[i].length = ds_length(keys[i].as.string);
+            sorted[i].index = i;
+        }
+        sort_string_keys(sorted, n);
+        for (size_t i = 0; i < n; i++) perm[i] = sorted[i].index;
+        free(sorted);
+    } else {
+        // Mixed with BigInts: compare_numbers handles every pairing
+        for (size_t i = 0; i < n; i++) perm[i] = i;
+        merge_sort(ctx, perm, n);
+    }
+}
+
+// Rewrites elements[0, n) in permutation order (ownership just moves, so no retains)
+static void apply_permutation(sort_context* ctx, value_t* elements, size_t n) {
+    value_t* ordered = malloc((n ? n : 1) * sizeof(value_t));
+    if (!ordered) {
+        sort_context_free(ctx);
+        runtime_error(ctx->vm, "%s() failed: out of memory", ctx->name);
+    }
+    for (size_t i = 0; i < n; i++) {
+        ordered[i] = elements[ctx->permutation[i]];
+    }
+    memcpy(elements, ordered, n * sizeof(value_t));
+    free(ordered);
+    sort_context_free(ctx);
+}
+
+// ===========================
+// ARRAY METHODS
+// ===========================
+
+static int is_callable(value_t v) {
+    return v.type == VAL_NATIVE || v.type == VAL_CLOSURE ||
+           v.type == VAL_FUNCTION || v.type == VAL_BOUND_METHOD;
+}
+
+// True when every key is a number, or every key is a string
+static bool keys_orderable(const value_t* keys, size_t n) {
+    bool numbers = true, strings = true;
+    for (size_t i = 0; i < n && (numbers || strings); i++) {
+        numbers = numbers && is_number(keys[i]);
+        strings = strings && keys[i].type == VAL_STRING;
+    }
+    return numbers || strings;
+}
+
+// Validates receiver and optional comparator, and sets up the context for them
+static sort_context sort_setup(vm_t* vm, const char* name, int arg_count, value_t* args) {
+    if (arg_count < 1 || arg_count > 2) {
+        runtime_error(vm, "%s() takes 0 or 1 arguments (%d given)", name, arg_count - 1);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "%s() can only be called on arrays", name);
+    }
+    sort_context ctx = {vm, name, (const value_t*)da_data(args[0].as.array), make_undefined(), NULL, NULL};
+    if (arg_count == 2) {
+        if (!is_callable(args[1])) {
+            runtime_error(vm, "%s() comparator must be a function", name);
+        }
+        ctx.comparator = args[1];
+    }
+    return ctx;
+}
+
+// Array method: sort(comparator?)
+// Sorts the array in place (numbers or strings ascending, or by comparator(a, b) < 0) and returns it
+value_t builtin_array_sort(vm_t* vm, int arg_count, value_t* args) {
+    sort_context ctx = sort_setup(vm, "sort", arg_count, args);
+    size_t length = da_length(args[0].as.array);
+    sort_permutation(&ctx, length);
+    apply_permutation(&ctx, (value_t*)da_data(args[0].as.array), length);
+    return vm_retain(args[0]);
+}
+
+// Array method: sorted(comparator?)
+// Like sort(), but returns a new array and leaves the receiver unchanged
+value_t builtin_array_sorted(vm_t* vm, int arg_count, value_t* args) {
+    sort_context ctx = sort_setup(vm, "sorted", arg_count, args);
+    size_t length = da_length(args[0].as.array);
+    sort_permutation(&ctx, length);
+
+    da_array out = da_new(sizeof(value_t));
+    da_reserve(out, length);
+    const value_t* elements = (const value_t*)da_data(args[0].as.array);
+    for (size_t i = 0; i < length; i++) {
+        value_t element = vm_retain(elements[ctx.permutation[i]]);
+        da_push(out, &element);
+    }
+    sort_context_free(&ctx);
+    return make_array(out);
+}
+
+// Array method: sortBy(key)
+// Stable in-place sort by key(element); each key is computed once, then ordered like sort()
+value_t builtin_array_sort_by(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) {
+        runtime_error(vm, "sortBy() takes exactly 1 argument (%d given)", arg_count - 1);
+    }
+    value_t receiver = args[0];
+    value_t key_fn = args[1];
+    if (receiver.type != VAL_ARRAY) {
+        runtime_error(vm, "sortBy() can only be called on arrays");
+    }
+    if (!is_callable(key_fn)) {
+        runtime_error(vm, "sortBy() expects a function");
+    }
+
+    size_t length = da_length(receiver.as.array);
+    value_t* keys = malloc((length ? length : 1) * sizeof(value_t));
+    if (!keys) {
+        runtime_error(vm, "sortBy() failed: out of memory");
+    }
+    for (size_t i = 0; i < length; i++) {
+        value_t element = vm_retain(((value_t*)da_data(receiver.as.array))[i]);
+        keys[i] = vm_call_slate_function_safe(vm, key_fn, 1, &element);
+        vm_release(element);
+    }
+    if (da_length(receiver.as.array) != length) {
+        for (size_t i = 0; i < length; i++) vm_release(keys[i]);
+        free(keys);
+        runtime_error(vm, "sortBy() key function must not change the array's length");
+    }
+
+    // Check the keys here so a bad one is reported after they have been released
+    if (!keys_orderable(keys, length)) {
+        const char* first = value_class_name(keys[0]);
+        for (size_t i = 0; i < length; i++) vm_release(keys[i]);
+        free(keys);
+        runtime_error(vm, "sortBy() keys must be all numbers or all strings (first key is %s)", first);
+    }
+
+    sort_context ctx = {vm, "sortBy", keys, make_undefined(), NULL, NULL};
+    sort_permutation(&ctx, length);
+    apply_permutation(&ctx, (value_t*)da_data(receiver.as.array), length);
+    for (size_t i = 0; i < length; i++) vm_release(keys[i]);
+    free(keys);
+    return vm_retain(receiver);
+}
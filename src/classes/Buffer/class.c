@@ -3,7 +3,7 @@
 #include "dynamic_object.h"
 
 // Global Buffer class storage
-value_t* global_buffer_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_buffer_class = NULL;
 
 // Initialize Buffer class with prototype and methods
 void buffer_class_init(vm_t* vm) {
@@ -50,7 +50,7 @@ void buffer_class_init(vm_t* vm) {
     do_set(vm->globals, "Buffer", &buffer_class, sizeof(value_t));
 
     // Store a global reference for use in make_buffer
-    static value_t buffer_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t buffer_class_storage;
     buffer_class_storage = vm_retain(buffer_class);
     global_buffer_class = &buffer_class_storage;
 }
\ No newline at end of file
@@ -50,7 +50,7 @@ value_t buffer_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
                 bytes[i] = (uint8_t)elem->as.int32;
             } else {
                 free(bytes);
-                runtime_error(vm, "Array element at index %zu must be an integer, not %s", i, value_type_name(elem->type));
+                runtime_error(vm, "Array element at index %zu must be an integer, not %s", i, value_class_name(*elem));
                 return make_null();
             }
         }
@@ -59,7 +59,7 @@ value_t buffer_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
         free(bytes);
         return make_buffer(buf);
     } else {
-        runtime_error(vm, "Buffer() argument must be a string or array, not %s", value_type_name(arg.type));
+        runtime_error(vm, "Buffer() argument must be a string or array, not %s", value_class_name(arg));
         return make_null();
     }
 }
@@ -72,7 +72,7 @@ value_t builtin_buffer_from_hex(vm_t* vm, int arg_count, value_t* args) {
 
     value_t hex_val = args[0];
     if (hex_val.type != VAL_STRING) {
-        runtime_error(vm, "buffer_from_hex() requires a string argument, not %s", value_type_name(hex_val.type));
+        runtime_error(vm, "buffer_from_hex() requires a string argument, not %s", value_class_name(hex_val));
     }
 
     const char* hex_str = hex_val.as.string;
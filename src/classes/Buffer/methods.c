@@ -21,10 +21,10 @@ value_t builtin_buffer_method_slice(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "slice() can only be called on buffers");
     }
     if (offset_val.type != VAL_INT32) {
-        runtime_error(vm, "slice() offset must be an integer, not %s", value_type_name(offset_val.type));
+        runtime_error(vm, "slice() offset must be an integer, not %s", value_class_name(offset_val));
     }
     if (length_val.type != VAL_INT32) {
-        runtime_error(vm, "slice() length must be an integer, not %s", value_type_name(length_val.type));
+        runtime_error(vm, "slice() length must be an integer, not %s", value_class_name(length_val));
     }
     
     db_buffer buf = receiver.as.buffer;
@@ -57,7 +57,7 @@ value_t builtin_buffer_method_concat(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "concat() can only be called on buffers");
     }
     if (other_val.type != VAL_BUFFER) {
-        runtime_error(vm, "concat() argument must be a buffer, not %s", value_type_name(other_val.type));
+        runtime_error(vm, "concat() argument must be a buffer, not %s", value_class_name(other_val));
     }
     
     db_buffer result = db_concat(receiver.as.buffer, other_val.as.buffer);
@@ -127,7 +127,7 @@ value_t builtin_buffer_method_equals(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "equals() can only be called on buffers");
     }
     if (other_val.type != VAL_BUFFER) {
-        runtime_error(vm, "equals() argument must be a buffer, not %s", value_type_name(other_val.type));
+        runtime_error(vm, "equals() argument must be a buffer, not %s", value_class_name(other_val));
     }
     
     bool equal = db_equals(receiver.as.buffer, other_val.as.buffer);
@@ -178,7 +178,7 @@ value_t builtin_buffer_method_reader(vm_t* vm, int arg_count, value_t* args) {
     }
     
     // Use BufferReader factory to create a proper BufferReader class instance
-    extern value_t* global_buffer_reader_class;
+    extern SLATE_ISOLATE_LOCAL value_t* global_buffer_reader_class;
     return buffer_reader_factory(vm, global_buffer_reader_class->as.class, 1, &receiver);
 }
 
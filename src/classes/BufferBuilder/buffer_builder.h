@@ -6,7 +6,7 @@
 #include "runtime_error.h"
 
 // Global BufferBuilder class reference
-extern value_t* global_buffer_builder_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_buffer_builder_class;
 
 // Class initialization
 void buffer_builder_class_init(vm_t* vm);
@@ -3,7 +3,7 @@
 #include "dynamic_object.h"
 
 // Global BufferBuilder class storage
-value_t* global_buffer_builder_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_buffer_builder_class = NULL;
 
 // Initialize BufferBuilder class with prototype and methods
 void buffer_builder_class_init(vm_t* vm) {
@@ -46,7 +46,7 @@ void buffer_builder_class_init(vm_t* vm) {
     do_set(vm->globals, "BufferBuilder", &buffer_builder_class, sizeof(value_t));
 
     // Store a global reference for use in make_buffer_builder
-    static value_t buffer_builder_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t buffer_builder_class_storage;
     buffer_builder_class_storage = vm_retain(buffer_builder_class);
     global_buffer_builder_class = &buffer_builder_class_storage;
 }
\ No newline at end of file
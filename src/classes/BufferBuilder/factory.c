@@ -11,7 +11,7 @@ value_t buffer_builder_factory(vm_t* vm, class_t* self, int arg_count, value_t*
 
     value_t capacity_val = args[0];
     if (capacity_val.type != VAL_INT32) {
-        runtime_error(vm, "BufferBuilder() requires an integer capacity, not %s", value_type_name(capacity_val.type));
+        runtime_error(vm, "BufferBuilder() requires an integer capacity, not %s", value_class_name(capacity_val));
     }
 
     int32_t capacity = capacity_val.as.int32;
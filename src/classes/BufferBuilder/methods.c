@@ -14,10 +14,10 @@ value_t builtin_buffer_builder_append_uint8(vm_t* vm, int arg_count, value_t* ar
     value_t value_val = args[1];
 
     if (receiver.type != VAL_BUFFER_BUILDER) {
-        runtime_error(vm, "appendUint8() can only be called on BufferBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "appendUint8() can only be called on BufferBuilder, not %s", value_class_name(receiver));
     }
     if (value_val.type != VAL_INT32) {
-        runtime_error(vm, "appendUint8() requires an integer value, not %s", value_type_name(value_val.type));
+        runtime_error(vm, "appendUint8() requires an integer value, not %s", value_class_name(value_val));
     }
 
     int32_t value = value_val.as.int32;
@@ -44,10 +44,10 @@ value_t builtin_buffer_builder_append_uint16_le(vm_t* vm, int arg_count, value_t
     value_t value_val = args[1];
 
     if (receiver.type != VAL_BUFFER_BUILDER) {
-        runtime_error(vm, "appendUint16LE() can only be called on BufferBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "appendUint16LE() can only be called on BufferBuilder, not %s", value_class_name(receiver));
     }
     if (value_val.type != VAL_INT32) {
-        runtime_error(vm, "appendUint16LE() requires an integer value, not %s", value_type_name(value_val.type));
+        runtime_error(vm, "appendUint16LE() requires an integer value, not %s", value_class_name(value_val));
     }
 
     int32_t value = value_val.as.int32;
@@ -74,7 +74,7 @@ value_t builtin_buffer_builder_append_uint32_le(vm_t* vm, int arg_count, value_t
     value_t value_val = args[1];
 
     if (receiver.type != VAL_BUFFER_BUILDER) {
-        runtime_error(vm, "appendUint32LE() can only be called on BufferBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "appendUint32LE() can only be called on BufferBuilder, not %s", value_class_name(receiver));
     }
     uint32_t value;
     if (value_val.type == VAL_INT32) {
@@ -88,7 +88,7 @@ value_t builtin_buffer_builder_append_uint32_le(vm_t* vm, int arg_count, value_t
             runtime_error(vm, "appendUint32LE() value must be a non-negative integer that fits in uint32 range");
         }
     } else {
-        runtime_error(vm, "appendUint32LE() requires an integer value, not %s", value_type_name(value_val.type));
+        runtime_error(vm, "appendUint32LE() requires an integer value, not %s", value_class_name(value_val));
     }
 
     db_builder builder = receiver.as.builder;
@@ -110,10 +110,10 @@ value_t builtin_buffer_builder_append_string(vm_t* vm, int arg_count, value_t* a
     value_t string_val = args[1];
 
     if (receiver.type != VAL_BUFFER_BUILDER) {
-        runtime_error(vm, "appendString() can only be called on BufferBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "appendString() can only be called on BufferBuilder, not %s", value_class_name(receiver));
     }
     if (string_val.type != VAL_STRING) {
-        runtime_error(vm, "appendString() requires a string value, not %s", value_type_name(string_val.type));
+        runtime_error(vm, "appendString() requires a string value, not %s", value_class_name(string_val));
     }
 
     const char* str = string_val.as.string;
@@ -138,7 +138,7 @@ value_t builtin_buffer_builder_build(vm_t* vm, int arg_count, value_t* args) {
 
     value_t receiver = args[0];
     if (receiver.type != VAL_BUFFER_BUILDER) {
-        runtime_error(vm, "build() can only be called on BufferBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "build() can only be called on BufferBuilder, not %s", value_class_name(receiver));
     }
 
     db_builder builder = receiver.as.builder;
@@ -5,7 +5,7 @@
 #include <limits.h>
 
 // Global BufferReader class storage
-value_t* global_buffer_reader_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_buffer_reader_class = NULL;
 
 // buffer_reader(buffer) - Create buffer reader
 value_t builtin_buffer_reader(vm_t* vm, int arg_count, value_t* args) {
@@ -15,7 +15,7 @@ value_t builtin_buffer_reader(vm_t* vm, int arg_count, value_t* args) {
 
     value_t buffer_val = args[0];
     if (buffer_val.type != VAL_BUFFER) {
-        runtime_error(vm, "buffer_reader() requires a buffer argument, not %s", value_type_name(buffer_val.type));
+        runtime_error(vm, "buffer_reader() requires a buffer argument, not %s", value_class_name(buffer_val));
     }
 
     db_reader reader = db_reader_new(buffer_val.as.buffer);
@@ -30,7 +30,7 @@ value_t builtin_reader_read_uint8(vm_t* vm, int arg_count, value_t* args) {
 
     value_t reader_val = args[0];
     if (reader_val.type != VAL_BUFFER_READER) {
-        runtime_error(vm, "reader_read_uint8() requires a buffer reader, not %s", value_type_name(reader_val.type));
+        runtime_error(vm, "reader_read_uint8() requires a buffer reader, not %s", value_class_name(reader_val));
     }
 
     db_reader reader = reader_val.as.reader;
@@ -50,7 +50,7 @@ value_t builtin_reader_read_uint16_le(vm_t* vm, int arg_count, value_t* args) {
 
     value_t reader_val = args[0];
     if (reader_val.type != VAL_BUFFER_READER) {
-        runtime_error(vm, "reader_read_uint16_le() requires a buffer reader, not %s", value_type_name(reader_val.type));
+        runtime_error(vm, "reader_read_uint16_le() requires a buffer reader, not %s", value_class_name(reader_val));
     }
 
     db_reader reader = reader_val.as.reader;
@@ -70,7 +70,7 @@ value_t builtin_reader_read_uint32_le(vm_t* vm, int arg_count, value_t* args) {
 
     value_t reader_val = args[0];
     if (reader_val.type != VAL_BUFFER_READER) {
-        runtime_error(vm, "reader_read_uint32_le() requires a buffer reader, not %s", value_type_name(reader_val.type));
+        runtime_error(vm, "reader_read_uint32_le() requires a buffer reader, not %s", value_class_name(reader_val));
     }
 
     db_reader reader = reader_val.as.reader;
@@ -98,7 +98,7 @@ value_t builtin_reader_position(vm_t* vm, int arg_count, value_t* args) {
 
     value_t reader_val = args[0];
     if (reader_val.type != VAL_BUFFER_READER) {
-        runtime_error(vm, "reader_position() requires a buffer reader, not %s", value_type_name(reader_val.type));
+        runtime_error(vm, "reader_position() requires a buffer reader, not %s", value_class_name(reader_val));
     }
 
     size_t pos = db_reader_position(reader_val.as.reader);
@@ -113,7 +113,7 @@ value_t builtin_reader_remaining(vm_t* vm, int arg_count, value_t* args) {
 
     value_t reader_val = args[0];
     if (reader_val.type != VAL_BUFFER_READER) {
-        runtime_error(vm, "reader_remaining() requires a buffer reader, not %s", value_type_name(reader_val.type));
+        runtime_error(vm, "reader_remaining() requires a buffer reader, not %s", value_class_name(reader_val));
     }
 
     size_t remaining = db_reader_remaining(reader_val.as.reader);
@@ -132,7 +132,7 @@ value_t buffer_reader_factory(vm_t* vm, class_t* self, int arg_count, value_t* a
     
     value_t buffer_val = args[0];
     if (buffer_val.type != VAL_BUFFER) {
-        runtime_error(vm, "BufferReader() requires a buffer argument, not %s", value_type_name(buffer_val.type));
+        runtime_error(vm, "BufferReader() requires a buffer argument, not %s", value_class_name(buffer_val));
     }
 
     db_reader reader = db_reader_new(buffer_val.as.buffer);
@@ -283,7 +283,7 @@ void buffer_reader_class_init(vm_t* vm) {
     do_set(vm->globals, "BufferReader", &buffer_reader_class, sizeof(value_t));
 
     // Store a global reference for use in make_buffer_reader
-    static value_t buffer_reader_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t buffer_reader_class_storage;
     buffer_reader_class_storage = vm_retain(buffer_reader_class);
     global_buffer_reader_class = &buffer_reader_class_storage;
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "dynamic_object.h"
 
 // Global reference to Date class (declared in datetime.c)
-extern value_t* global_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_date_class;
 
 // Initialize Date class with prototype and methods
 void init_date_class(vm_t* vm) {
@@ -89,7 +89,7 @@ void init_date_class(vm_t* vm) {
     do_set(vm->globals, "Date", &date_class, sizeof(value_t));
     
     // Store a global reference for use in make_date_direct
-    static value_t date_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t date_class_storage;
     date_class_storage = vm_retain(date_class);
     global_date_class = &date_class_storage;
 }
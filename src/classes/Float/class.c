@@ -4,7 +4,7 @@
 #include "number.h"
 
 // Global Float class storage
-value_t* global_float_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_float_class = NULL;
 
 // Initialize the Float class
 void float_class_init(vm_t* vm) {
@@ -95,7 +95,7 @@ void float_class_init(vm_t* vm) {
     do_set(vm->globals, "Float", &float_class, sizeof(value_t));
     
     // Store a global reference for use in make_float functions
-    static value_t float_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t float_class_storage;
     float_class_storage = vm_retain(float_class);
     global_float_class = &float_class_storage;
 }
\ No newline at end of file
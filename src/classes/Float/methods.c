@@ -2,6 +2,7 @@
 #include "builtins.h"
 #include "dynamic_object.h"
 #include "number.h"
+#include "number_format.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
@@ -74,30 +75,11 @@ value_t builtin_float_to_string(vm_t* vm, int arg_count, value_t* args) {
     
     value_t receiver = args[0];
     
+    char buffer[NF_MAX_LENGTH];
     if (receiver.type == VAL_FLOAT32) {
-        float val = receiver.as.float32;
-        if (isnan(val)) {
-            return make_string("NaN");
-        } else if (isinf(val)) {
-            return make_string(val > 0 ? "Infinity" : "-Infinity");
-        } else {
-            char buffer[32];
-            // Use %.7g for clean formatting without unnecessary zeros (float32 precision)
-            snprintf(buffer, sizeof(buffer), "%.7g", val);
-            return make_string(buffer);
-        }
+        return make_string_ds(ds_create_length(buffer, nf_format_float32(buffer, receiver.as.float32)));
     } else if (receiver.type == VAL_FLOAT64) {
-        double val = receiver.as.float64;
-        if (isnan(val)) {
-            return make_string("NaN");
-        } else if (isinf(val)) {
-            return make_string(val > 0 ? "Infinity" : "-Infinity");
-        } else {
-            char buffer[64];
-            // Use %.15g for clean formatting without unnecessary zeros
-            snprintf(buffer, sizeof(buffer), "%.15g", val);
-            return make_string(buffer);
-        }
+        return make_string_ds(ds_create_length(buffer, nf_format_float64(buffer, receiver.as.float64)));
     } else {
         runtime_error(vm, "toString() can only be called on floating point numbers");
         return make_null();
@@ -60,7 +60,7 @@ void init_instant_class(vm_t* vm) {
     do_set(vm->globals, "Instant", &instant_class, sizeof(value_t));
     
     // Store a global reference for use in make_instant_direct
-    static value_t instant_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t instant_class_storage;
     instant_class_storage = vm_retain(instant_class);
     global_instant_class = &instant_class_storage;
 }
\ No newline at end of file
@@ -258,7 +258,8 @@ value_t instant_to_string(vm_t* vm, int arg_count, value_t* args) {
     }
     
     // Convert to UTC time
-    struct tm* utc_tm = gmtime(&epoch_seconds);
+    struct tm utc_storage;
+    struct tm* utc_tm = gmtime_r(&epoch_seconds, &utc_storage);
     if (!utc_tm) {
         runtime_error(vm, "Failed to convert instant to UTC time");
         return make_null();
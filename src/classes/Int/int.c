@@ -3,6 +3,7 @@
 #include "dynamic_object.h"
 #include "dynamic_int.h"
 #include "number.h"
+#include "number_format.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
@@ -377,7 +378,7 @@ int is_integer(value_t value) {
 }
 
 // Global Int class storage
-value_t* global_int_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_int_class = NULL;
 
 // Int factory function for converting strings to integers with optional base
 value_t int_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
@@ -501,7 +502,7 @@ value_t builtin_int_to_string(vm_t* vm, int arg_count, value_t* args) {
     if (receiver.type == VAL_INT32) {
         char buffer[64];
         if (base == 10) {
-            snprintf(buffer, sizeof(buffer), "%d", receiver.as.int32);
+            return make_string_ds(ds_create_length(buffer, nf_format_int32(buffer, receiver.as.int32)));
         } else if (base == 16) {
             snprintf(buffer, sizeof(buffer), "%x", receiver.as.int32);
         } else if (base == 2) {
@@ -1268,7 +1269,7 @@ void int_class_init(vm_t* vm) {
     do_set(vm->globals, "Int", &int_class, sizeof(value_t));
     
     // Store a global reference for use in make_int32 and make_bigint
-    static value_t int_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t int_class_storage;
     int_class_storage = vm_retain(int_class);
     global_int_class = &int_class_storage;
 }
\ No newline at end of file
@@ -6,7 +6,7 @@
 // Using centralized call_equals_method from vm/utilities.c
 
 // Global Iterator class storage
-value_t* global_iterator_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_iterator_class = NULL;
 
 // Initialize Iterator class with prototype and methods
 void iterator_class_init(vm_t* vm) {
@@ -32,6 +32,38 @@ void iterator_class_init(vm_t* vm) {
     value_t iterator_equals_method = make_native(builtin_iterator_equals);
     do_set(iterator_proto, "equals", &iterator_equals_method, sizeof(value_t));
 
+    // Lazy adapters (see pipelines.c)
+    value_t iterator_map_method = make_native(builtin_iterator_map);
+    do_set(iterator_proto, "map", &iterator_map_method, sizeof(value_t));
+
+    value_t iterator_filter_method = make_native(builtin_iterator_filter);
+    do_set(iterator_proto, "filter", &iterator_filter_method, sizeof(value_t));
+
+    value_t iterator_flat_map_method = make_native(builtin_iterator_flat_map);
+    do_set(iterator_proto, "flatMap", &iterator_flat_map_method, sizeof(value_t));
+
+    value_t iterator_take_method = make_native(builtin_iterator_take);
+    do_set(iterator_proto, "take", &iterator_take_method, sizeof(value_t));
+
+    value_t iterator_skip_method = make_native(builtin_iterator_skip);
+    do_set(iterator_proto, "skip", &iterator_skip_method, sizeof(value_t));
+
+    value_t iterator_zip_method = make_native(builtin_iterator_zip);
+    do_set(iterator_proto, "zip", &iterator_zip_method, sizeof(value_t));
+
+    value_t iterator_enumerate_method = make_native(builtin_iterator_enumerate);
+    do_set(iterator_proto, "enumerate", &iterator_enumerate_method, sizeof(value_t));
+
+    // Terminal operations
+    value_t iterator_reduce_method = make_native(builtin_iterator_reduce);
+    do_set(iterator_proto, "reduce", &iterator_reduce_method, sizeof(value_t));
+
+    value_t iterator_sum_method = make_native(builtin_iterator_sum);
+    do_set(iterator_proto, "sum", &iterator_sum_method, sizeof(value_t));
+
+    value_t iterator_count_method = make_native(builtin_iterator_count);
+    do_set(iterator_proto, "count", &iterator_count_method, sizeof(value_t));
+
     // Create the Iterator class
     value_t iterator_class = make_class("Iterator", iterator_proto, NULL);
 
@@ -39,7 +71,7 @@ void iterator_class_init(vm_t* vm) {
     do_set(vm->globals, "Iterator", &iterator_class, sizeof(value_t));
 
     // Store a global reference for use in make_iterator
-    static value_t iterator_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t iterator_class_storage;
     iterator_class_storage = vm_retain(iterator_class);
     global_iterator_class = &iterator_class_storage;
 }
@@ -63,8 +95,13 @@ value_t builtin_iterator(vm_t* vm, int arg_count, value_t* args) {
                                          collection.as.range->exclusive, collection.as.range->step);
         }
         break;
+    case VAL_SET:
+    case VAL_MAP:
+        iter = iterator_for_value(collection);
+        break;
     default:
-        runtime_error(vm, "iterator() can only be called on arrays and ranges, not %s", value_type_name(collection.type));
+        runtime_error(vm, "iterator() can only be called on arrays, ranges, sets and maps, not %s",
+                      value_class_name(collection));
     }
 
     if (!iter) {
@@ -82,7 +119,7 @@ value_t builtin_has_next(vm_t* vm, int arg_count, value_t* args) {
 
     value_t iter_val = args[0];
     if (iter_val.type != VAL_ITERATOR) {
-        runtime_error(vm, "hasNext() requires an iterator argument, not %s", value_type_name(iter_val.type));
+        runtime_error(vm, "hasNext() requires an iterator argument, not %s", value_class_name(iter_val));
     }
 
     int has_next = iterator_has_next(iter_val.as.iterator);
@@ -97,7 +134,7 @@ value_t builtin_next(vm_t* vm, int arg_count, value_t* args) {
 
     value_t iter_val = args[0];
     if (iter_val.type != VAL_ITERATOR) {
-        runtime_error(vm, "next() requires an iterator argument, not %s", value_type_name(iter_val.type));
+        runtime_error(vm, "next() requires an iterator argument, not %s", value_class_name(iter_val));
     }
 
     if (!iterator_has_next(iter_val.as.iterator)) {
@@ -143,8 +180,12 @@ value_t builtin_iterator_to_array(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "Invalid iterator");
     }
     
-    // Create new array to collect elements
+    // Create new array to collect elements, sized up front when the count is known
     da_array array = da_new(sizeof(value_t));
+    size_t expected;
+    if (iterator_size_hint(iter, &expected) && expected > 0) {
+        da_reserve(array, expected);
+    }
     
     // Consume all remaining elements from iterator
     while (iterator_has_next(iter)) {
@@ -198,6 +239,10 @@ value_t builtin_iterator_hash(vm_t* vm, int arg_count, value_t* args) {
         }
         combined ^= iter->data.range_iter.exclusive ? (1 << 12) : 0;
         combined ^= iter->data.range_iter.finished ? (1 << 13) : 0;
+    } else if (iter->type == ITER_GENERATOR || iter->type == ITER_PIPELINE) {
+        // Generator and pipeline state can't be compared, so hash the identity
+        uintptr_t address = (uintptr_t)iter;
+        combined ^= (uint32_t)(address ^ (address >> 32));
     }
     
     return make_int32((int32_t)combined);
@@ -264,7 +309,193 @@ value_t builtin_iterator_equals(vm_t* vm, int arg_count, value_t* args) {
         int step_equal = call_equals_method(vm, iter1->data.range_iter.step, iter2->data.range_iter.step);
         
         return make_boolean(current_equal && end_equal && step_equal);
+    } else if (iter1->type == ITER_GENERATOR || iter1->type == ITER_PIPELINE) {
+        return make_boolean(iter1 == iter2);
     }
     
     return make_boolean(0);
-}
\ No newline at end of file
+}
+static int is_callable(value_t v) {
+    return v.type == VAL_NATIVE || v.type == VAL_CLOSURE ||
+           v.type == VAL_FUNCTION || v.type == VAL_BOUND_METHOD;
+}
+
+static iterator_t* receiver_iterator(vm_t* vm, value_t receiver, const char* name) {
+    if (receiver.type != VAL_ITERATOR || !receiver.as.iterator) {
+        runtime_error(vm, "%s() can only be called on iterators", name);
+    }
+    return receiver.as.iterator;
+}
+
+static value_t make_pipeline(vm_t* vm, iterator_t* upstream, pipeline_stage stage, const char* name) {
+    iterator_t* iter = iterator_pipeline_create(vm, upstream, stage);
+    if (!iter) {
+        runtime_error(vm, "%s() failed: out of memory", name);
+    }
+    return make_iterator(iter);
+}
+
+static value_t callback_stage(vm_t* vm, int arg_count, value_t* args, pipeline_stage_kind kind, const char* name) {
+    if (arg_count != 2) {
+        runtime_error(vm, "%s() takes exactly 1 argument (%d given)", name, arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], name);
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "%s() expects a function", name);
+    }
+    pipeline_stage stage = {kind, args[1], 0, NULL, 0};
+    return make_pipeline(vm, iter, stage, name);
+}
+
+static value_t count_stage(vm_t* vm, int arg_count, value_t* args, pipeline_stage_kind kind, const char* name) {
+    if (arg_count != 2) {
+        runtime_error(vm, "%s() takes exactly 1 argument (%d given)", name, arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], name);
+    if (args[1].type != VAL_INT32 || args[1].as.int32 < 0) {
+        runtime_error(vm, "%s() requires a non-negative Int", name);
+    }
+    pipeline_stage stage = {kind, make_null(), 0, NULL, (size_t)args[1].as.int32};
+    return make_pipeline(vm, iter, stage, name);
+}
+
+// iterator.map(fn) - Lazily apply fn to each element
+value_t builtin_iterator_map(vm_t* vm, int arg_count, value_t* args) {
+    return callback_stage(vm, arg_count, args, STAGE_MAP, "map");
+}
+
+// iterator.filter(fn) - Lazily keep the elements fn accepts
+value_t builtin_iterator_filter(vm_t* vm, int arg_count, value_t* args) {
+    return callback_stage(vm, arg_count, args, STAGE_FILTER, "filter");
+}
+
+// iterator.flatMap(fn) - Lazily produce the elements of each fn(element) array, range or iterator
+value_t builtin_iterator_flat_map(vm_t* vm, int arg_count, value_t* args) {
+    return callback_stage(vm, arg_count, args, STAGE_FLAT_MAP, "flatMap");
+}
+
+// iterator.take(n) - At most the next n elements
+value_t builtin_iterator_take(vm_t* vm, int arg_count, value_t* args) {
+    return count_stage(vm, arg_count, args, STAGE_TAKE, "take");
+}
+
+// iterator.skip(n) - Everything after the next n elements
+value_t builtin_iterator_skip(vm_t* vm, int arg_count, value_t* args) {
+    return count_stage(vm, arg_count, args, STAGE_SKIP, "skip");
+}
+
+// iterator.zip(other) - [element, otherElement] pairs until either side runs out
+value_t builtin_iterator_zip(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) {
+        runtime_error(vm, "zip() takes exactly 1 argument (%d given)", arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], "zip");
+    iterator_t* other = iterator_for_value(args[1]);
+    if (!other) {
+        runtime_error(vm, "zip() requires an array, range or iterator, not %s", value_class_name(args[1]));
+    }
+    pipeline_stage stage = {STAGE_ZIP, make_null(), 0, other, 0};
+    return make_pipeline(vm, iter, stage, "zip");
+}
+
+// iterator.enumerate() - [index, element] pairs
+value_t builtin_iterator_enumerate(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "enumerate() takes no arguments (%d given)", arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], "enumerate");
+    pipeline_stage stage = {STAGE_ENUMERATE, make_null(), 0, NULL, 0};
+    return make_pipeline(vm, iter, stage, "enumerate");
+}
+
+// iterator.reduce(fn, initial) - Fold the remaining elements with acc = fn(acc, element).
+// Without initial the first element starts the fold.
+value_t builtin_iterator_reduce(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2 && arg_count != 3) {
+        runtime_error(vm, "reduce() takes 1 or 2 arguments (%d given)", arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], "reduce");
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "reduce() expects a function");
+    }
+
+    value_t acc;
+    if (arg_count == 3) {
+        acc = vm_retain(args[2]);
+    } else if (iterator_has_next(iter)) {
+        acc = iterator_next(iter);
+    } else {
+        runtime_error(vm, "reduce() of an empty iterator with no initial value");
+        return make_null();
+    }
+
+    while (iterator_has_next(iter)) {
+        value_t call_args[2] = {acc, iterator_next(iter)};
+        acc = vm_call_slate_function_safe(vm, args[1], 2, call_args);
+        vm_release(call_args[0]);
+        vm_release(call_args[1]);
+    }
+    return acc;
+}
+
+// iterator.sum() - Sum of the remaining elements (Int, or Float once any element is)
+value_t builtin_iterator_sum(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "sum() takes no arguments (%d given)", arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], "sum");
+
+    int64_t int_total = 0;
+    double float_total = 0.0;
+    int is_float = 0;
+    while (iterator_has_next(iter)) {
+        value_t element = iterator_next(iter);
+        if (element.type == VAL_INT32) {
+            if (__builtin_add_overflow(int_total, (int64_t)element.as.int32, &int_total)) {
+                runtime_error(vm, "sum() overflowed");
+            }
+        } else if (element.type == VAL_FLOAT64 || element.type == VAL_FLOAT32) {
+            float_total += element.type == VAL_FLOAT64 ? element.as.float64 : (double)element.as.float32;
+            is_float = 1;
+        } else if (element.type == VAL_BIGINT) {
+            float_total += di_to_double(element.as.bigint);
+            is_float = 1;
+            vm_release(element);
+        } else {
+            const char* type = value_class_name(element);
+            vm_release(element);
+            runtime_error(vm, "sum() requires numbers, not %s", type);
+        }
+    }
+
+    if (is_float) {
+        return make_float64(float_total + (double)int_total);
+    }
+    if (int_total >= INT32_MIN && int_total <= INT32_MAX) {
+        return make_int32((int32_t)int_total);
+    }
+    return make_bigint(di_from_int64(int_total));
+}
+
+// iterator.count() - Number of remaining elements (consumes them)
+value_t builtin_iterator_count(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "count() takes no arguments (%d given)", arg_count - 1);
+    }
+    iterator_t* iter = receiver_iterator(vm, args[0], "count");
+
+    // Arrays and ranges know their length: skip to the end without producing the elements
+    size_t count;
+    if ((iter->type == ITER_ARRAY || iter->type == ITER_RANGE) && iterator_size_hint(iter, &count)) {
+        if (iter->type == ITER_ARRAY) {
+            iter->data.array_iter.index = da_length(iter->data.array_iter.array);
+        } else {
+            iter->data.range_iter.finished = 1;
+        }
+    } else {
+        for (count = 0; iterator_has_next(iter); count++) {
+            vm_release(iterator_next(iter));
+        }
+    }
+    return count <= INT32_MAX ? make_int32((int32_t)count) : make_float64((double)count);
+}
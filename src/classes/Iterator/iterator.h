@@ -20,4 +20,18 @@ value_t builtin_iterator_to_array(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_iterator_hash(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_iterator_equals(vm_t* vm, int arg_count, value_t* args);
 
+// Lazy Adapters (see pipelines.c)
+value_t builtin_iterator_map(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_filter(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_flat_map(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_take(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_skip(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_zip(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_enumerate(vm_t* vm, int arg_count, value_t* args);
+
+// Terminal Operations
+value_t builtin_iterator_reduce(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_sum(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_iterator_count(vm_t* vm, int arg_count, value_t* args);
+
 #endif // CLASS_ITERATOR_H
\ No newline at end of file
@@ -5,7 +5,7 @@
 #include "dynamic_object.h"
 
 // External reference to global LocalDate class storage (declared in datetime.c)
-extern value_t* global_local_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_date_class;
 
 // Initialize LocalDate class with prototype and methods
 void local_date_class_init(vm_t* vm) {
@@ -76,7 +76,7 @@ void local_date_class_init(vm_t* vm) {
     do_set(vm->globals, "LocalDate", &local_date_class, sizeof(value_t));
 
     // Store a global reference for use in make_local_date
-    static value_t local_date_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t local_date_class_storage;
     local_date_class_storage = vm_retain(local_date_class);
     global_local_date_class = &local_date_class_storage;
 }
\ No newline at end of file
@@ -6,7 +6,7 @@
 #include "library_assert.h"
 
 // External reference to global LocalDate class storage (declared in datetime.c)
-extern value_t* global_local_date_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_date_class;
 
 // LocalDate factory function
 value_t local_date_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
@@ -99,7 +99,7 @@ void local_datetime_class_init(vm_t* vm) {
     do_set(vm->globals, "LocalDateTime", &local_datetime_class, sizeof(value_t));
     
     // Store a global reference for use in make_local_datetime
-    static value_t local_datetime_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t local_datetime_class_storage;
     local_datetime_class_storage = vm_retain(local_datetime_class);
     global_local_datetime_class = &local_datetime_class_storage;
 }
\ No newline at end of file
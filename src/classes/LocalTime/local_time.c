@@ -8,7 +8,7 @@
 #include <string.h>
 
 // External reference to global LocalTime class storage (declared in datetime.c)
-extern value_t* global_local_time_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_local_time_class;
 
 // LocalTime factory function
 value_t local_time_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
@@ -437,7 +437,7 @@ void local_time_class_init(vm_t* vm) {
     do_set(vm->globals, "LocalTime", &local_time_class, sizeof(value_t));
 
     // Store a global reference for use in make_local_time
-    static value_t local_time_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t local_time_class_storage;
     local_time_class_storage = vm_retain(local_time_class);
     global_local_time_class = &local_time_class_storage;
 }
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "map.h"
+#include "builtins.h"
+#include "dynamic_object.h"
+
+// Global Map and Set class storage
+SLATE_ISOLATE_LOCAL value_t* global_map_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_set_class = NULL;
+
+static void init_map(vm_t* vm) {
+    do_object map_proto = do_create(NULL);
+
+    value_t size_method = make_native(builtin_map_size);
+    do_set(map_proto, "size", &size_method, sizeof(value_t));
+
+    value_t is_empty_method = make_native(builtin_map_is_empty);
+    do_set(map_proto, "isEmpty", &is_empty_method, sizeof(value_t));
+
+    // Lookup and update
+    value_t get_method = make_native(builtin_map_get);
+    do_set(map_proto, "get", &get_method, sizeof(value_t));
+
+    value_t set_method = make_native(builtin_map_set);
+    do_set(map_proto, "set", &set_method, sizeof(value_t));
+
+    value_t has_method = make_native(builtin_map_has);
+    do_set(map_proto, "has", &has_method, sizeof(value_t));
+
+    value_t delete_method = make_native(builtin_map_delete);
+    do_set(map_proto, "delete", &delete_method, sizeof(value_t));
+
+    value_t clear_method = make_native(builtin_map_clear);
+    do_set(map_proto, "clear", &clear_method, sizeof(value_t));
+
+    value_t reserve_method = make_native(builtin_map_reserve);
+    do_set(map_proto, "reserve", &reserve_method, sizeof(value_t));
+
+    // Views, in insertion order
+    value_t keys_method = make_native(builtin_map_keys);
+    do_set(map_proto, "keys", &keys_method, sizeof(value_t));
+
+    value_t values_method = make_native(builtin_map_values);
+    do_set(map_proto, "values", &values_method, sizeof(value_t));
+
+    value_t entries_method = make_native(builtin_map_entries);
+    do_set(map_proto, "entries", &entries_method, sizeof(value_t));
+
+    value_t iterator_method = make_native(builtin_iterator);
+    do_set(map_proto, "iterator", &iterator_method, sizeof(value_t));
+
+    value_t copy_method = make_native(builtin_map_copy);
+    do_set(map_proto, "copy", &copy_method, sizeof(value_t));
+
+    value_t hash_method = make_native(builtin_map_hash);
+    do_set(map_proto, "hash", &hash_method, sizeof(value_t));
+
+    value_t equals_method = make_native(builtin_map_equals);
+    do_set(map_proto, "equals", &equals_method, sizeof(value_t));
+
+    value_t to_string_method = make_native(builtin_map_to_string);
+    do_set(map_proto, "toString", &to_string_method, sizeof(value_t));
+
+    // Bulk constructors
+    do_object map_static = do_create(NULL);
+    value_t from_array_method = make_native(builtin_map_from_array);
+    do_set(map_static, "fromArray", &from_array_method, sizeof(value_t));
+
+    value_t group_by_method = make_native(builtin_map_group_by);
+    do_set(map_static, "groupBy", &group_by_method, sizeof(value_t));
+
+    value_t map_class = make_class("Map", map_proto, map_static);
+    map_class.as.class->factory = map_factory;
+    do_set(vm->globals, "Map", &map_class, sizeof(value_t));
+
+    static SLATE_ISOLATE_LOCAL value_t map_class_storage;
+    map_class_storage = vm_retain(map_class);
+    global_map_class = &map_class_storage;
+}
+
+static void init_set(vm_t* vm) {
+    do_object set_proto = do_create(NULL);
+
+    value_t size_method = make_native(builtin_set_size);
+    do_set(set_proto, "size", &size_method, sizeof(value_t));
+
+    value_t is_empty_method = make_native(builtin_set_is_empty);
+    do_set(set_proto, "isEmpty", &is_empty_method, sizeof(value_t));
+
+    // Membership
+    value_t add_method = make_native(builtin_set_add);
+    do_set(set_proto, "add", &add_method, sizeof(value_t));
+
+    value_t has_method = make_native(builtin_set_has);
+    do_set(set_proto, "has", &has_method, sizeof(value_t));
+
+    value_t delete_method = make_native(builtin_set_delete);
+    do_set(set_proto, "delete", &delete_method, sizeof(value_t));
+
+    value_t clear_method = make_native(builtin_set_clear);
+    do_set(set_proto, "clear", &clear_method, sizeof(value_t));
+
+    value_t reserve_method = make_native(builtin_set_reserve);
+    do_set(set_proto, "reserve", &reserve_method, sizeof(value_t));
+
+    // Set algebra (new sets, in the receiver's order then the argument's)
+    value_t union_method = make_native(builtin_set_union);
+    do_set(set_proto, "union", &union_method, sizeof(value_t));
+
+    value_t intersection_method = make_native(builtin_set_intersection);
+    do_set(set_proto, "intersection", &intersection_method, sizeof(value_t));
+
+    value_t difference_method = make_native(builtin_set_difference);
+    do_set(set_proto, "difference", &difference_method, sizeof(value_t));
+
+    value_t to_array_method = make_native(builtin_set_to_array);
+    do_set(set_proto, "toArray", &to_array_method, sizeof(value_t));
+
+    value_t iterator_method = make_native(builtin_iterator);
+    do_set(set_proto, "iterator", &iterator_method, sizeof(value_t));
+
+    value_t copy_method = make_native(builtin_set_copy);
+    do_set(set_proto, "copy", &copy_method, sizeof(value_t));
+
+    value_t hash_method = make_native(builtin_set_hash);
+    do_set(set_proto, "hash", &hash_method, sizeof(value_t));
+
+    value_t equals_method = make_native(builtin_set_equals);
+    do_set(set_proto, "equals", &equals_method, sizeof(value_t));
+
+    value_t to_string_method = make_native(builtin_set_to_string);
+    do_set(set_proto, "toString", &to_string_method, sizeof(value_t));
+
+    do_object set_static = do_create(NULL);
+    value_t from_array_method = make_native(builtin_set_from_array);
+    do_set(set_static, "fromArray", &from_array_method, sizeof(value_t));
+
+    value_t set_class = make_class("Set", set_proto, set_static);
+    set_class.as.class->factory = set_factory;
+    do_set(vm->globals, "Set", &set_class, sizeof(value_t));
+
+    static SLATE_ISOLATE_LOCAL value_t set_class_storage;
+    set_class_storage = vm_retain(set_class);
+    global_set_class = &set_class_storage;
+}
+
+// Initialize the Map and Set classes with their prototypes and methods
+void map_class_init(vm_t* vm) {
+    init_map(vm);
+    init_set(vm);
+}
@@ -0,0 +1,194 @@
+#include "map.h"
+#include "builtins.h"
+#include "dynamic_array.h"
+
+static int is_callable(value_t v) {
+    return v.type == VAL_NATIVE || v.type == VAL_CLOSURE ||
+           v.type == VAL_FUNCTION || v.type == VAL_BOUND_METHOD;
+}
+
+// Adds a [key, value] pair, or releases the map and raises if element isn't one
+static void put_pair(vm_t* vm, hash_map_t* map, value_t element, size_t index, const char* name) {
+    if (element.type != VAL_ARRAY || da_length(element.as.array) != 2) {
+        hash_map_release(map);
+        runtime_error(vm, "%s() entries must be [key, value] pairs (index %zu is %s)", name, index,
+                      value_class_name(element));
+    }
+    value_t* pair = (value_t*)da_data(element.as.array);
+    map_put(vm, map, pair[0], pair[1], name);
+}
+
+static hash_map_t* map_from_pairs(vm_t* vm, value_t source, const char* name) {
+    if (source.type == VAL_ARRAY) {
+        size_t length = da_length(source.as.array);
+        value_t* elements = (value_t*)da_data(source.as.array);
+        hash_map_t* map = map_allocate(vm, length, name);
+        for (size_t i = 0; i < length; i++) {
+            put_pair(vm, map, elements[i], i, name);
+        }
+        return map;
+    }
+
+    iterator_t* iter = iterator_for_value(source);
+    if (!iter) {
+        runtime_error(vm, "%s() argument must be a map, or an array or iterator of [key, value] pairs, not %s", name,
+                      value_class_name(source));
+    }
+    size_t hint;
+    if (!iterator_size_hint(iter, &hint) || hint == SIZE_MAX) {
+        hint = 0;
+    }
+    hash_map_t* map = map_allocate(vm, hint, name);
+    for (size_t i = 0; iterator_has_next(iter); i++) {
+        value_t element = iterator_next(iter);
+        if (element.type != VAL_ARRAY || da_length(element.as.array) != 2) {
+            iterator_release(iter);
+            vm_release(element); // put_pair only needs its type for the message
+        }
+        put_pair(vm, map, element, i, name);
+        vm_release(element);
+    }
+    iterator_release(iter);
+    return map;
+}
+
+// Map() or Map(source) factory function for class instantiation
+value_t map_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
+    (void)self;
+    if (arg_count == 0) {
+        return make_map(map_allocate(vm, 0, "Map"));
+    }
+    if (arg_count != 1) {
+        runtime_error(vm, "Map() takes 0 or 1 arguments (%d given)", arg_count);
+    }
+    if (args[0].type == VAL_MAP) {
+        hash_map_t* copy = hash_map_copy(args[0].as.map);
+        if (!copy) {
+            runtime_error(vm, "Map() failed: out of memory");
+        }
+        return make_map(copy);
+    }
+    return make_map(map_from_pairs(vm, args[0], "Map"));
+}
+
+// Set() or Set(source) factory function for class instantiation
+value_t set_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
+    (void)self;
+    if (arg_count == 0) {
+        return make_set(map_allocate(vm, 0, "Set"));
+    }
+    if (arg_count != 1) {
+        runtime_error(vm, "Set() takes 0 or 1 arguments (%d given)", arg_count);
+    }
+    value_t source = args[0];
+    if (source.type == VAL_SET) {
+        hash_map_t* copy = hash_map_copy(source.as.map);
+        if (!copy) {
+            runtime_error(vm, "Set() failed: out of memory");
+        }
+        return make_set(copy);
+    }
+    if (source.type == VAL_ARRAY) {
+        return builtin_set_from_array(vm, 1, args);
+    }
+
+    iterator_t* iter = iterator_for_value(source);
+    if (!iter) {
+        runtime_error(vm, "Set() argument must be an array, range, iterator or set, not %s",
+                      value_class_name(source));
+    }
+    size_t hint;
+    if (!iterator_size_hint(iter, &hint) || hint == SIZE_MAX) {
+        hint = 0;
+    }
+    hash_map_t* set = map_allocate(vm, hint, "Set");
+    while (iterator_has_next(iter)) {
+        value_t element = iterator_next(iter);
+        map_put(vm, set, element, make_null(), "Set");
+        vm_release(element);
+    }
+    iterator_release(iter);
+    return make_set(set);
+}
+
+// Set.fromArray(array) - The distinct elements, in first-seen order
+value_t builtin_set_from_array(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "Set.fromArray() takes exactly 1 argument (%d given)", arg_count);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "Set.fromArray() requires an array, not %s", value_class_name(args[0]));
+    }
+    size_t length = da_length(args[0].as.array);
+    value_t* elements = (value_t*)da_data(args[0].as.array);
+    hash_map_t* set = map_allocate(vm, length, "Set.fromArray");
+    for (size_t i = 0; i < length; i++) {
+        map_put(vm, set, elements[i], make_null(), "Set.fromArray");
+    }
+    return make_set(set);
+}
+
+// Map.fromArray(pairs) - From [key, value] pairs
+// Map.fromArray(array, keyFn) - Each element under keyFn(element); later elements win
+value_t builtin_map_from_array(vm_t* vm, int arg_count, value_t* args) {
+    const char* name = "Map.fromArray";
+    if (arg_count < 1 || arg_count > 2) {
+        runtime_error(vm, "%s() takes 1 or 2 arguments (%d given)", name, arg_count);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "%s() requires an array, not %s", name, value_class_name(args[0]));
+    }
+    if (arg_count == 1) {
+        return make_map(map_from_pairs(vm, args[0], name));
+    }
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "%s() key function must be a function", name);
+    }
+
+    da_array array = args[0].as.array;
+    size_t length = da_length(array);
+    hash_map_t* map = map_allocate(vm, length, name);
+    for (size_t i = 0; i < length; i++) {
+        value_t element = vm_retain(((value_t*)da_data(array))[i]);
+        value_t key = vm_call_slate_function_safe(vm, args[1], 1, &element);
+        map_put(vm, map, key, element, name);
+        vm_release(key);
+        vm_release(element);
+    }
+    return make_map(map);
+}
+
+// Map.groupBy(source, keyFn) - keyFn(element) -> array of the elements with that key, in order
+value_t builtin_map_group_by(vm_t* vm, int arg_count, value_t* args) {
+    const char* name = "Map.groupBy";
+    if (arg_count != 2) {
+        runtime_error(vm, "%s() takes exactly 2 arguments (%d given)", name, arg_count);
+    }
+    if (!is_callable(args[1])) {
+        runtime_error(vm, "%s() key function must be a function", name);
+    }
+    iterator_t* iter = iterator_for_value(args[0]);
+    if (!iter) {
+        runtime_error(vm, "%s() source must be an array, range, iterator, set or map, not %s", name,
+                      value_class_name(args[0]));
+    }
+
+    hash_map_t* groups = map_allocate(vm, 0, name);
+    while (iterator_has_next(iter)) {
+        value_t element = iterator_next(iter);
+        value_t key = vm_call_slate_function_safe(vm, args[1], 1, &element);
+        hash_map_entry* entry = hash_map_find(vm, groups, key);
+        if (entry) {
+            da_push(entry->value.as.array, &element); // The group takes our reference
+        } else {
+            da_array group = da_new(sizeof(value_t));
+            da_push(group, &element);
+            value_t group_value = make_array(group);
+            map_put(vm, groups, key, group_value, name);
+            vm_release(group_value);
+        }
+        vm_release(key);
+    }
+    iterator_release(iter);
+    return make_map(groups);
+}
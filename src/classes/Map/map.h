@@ -0,0 +1,68 @@
+#ifndef CLASS_MAP_H
+#define CLASS_MAP_H
+
+#include "vm.h"
+#include "value.h"
+#include "runtime_error.h"
+
+// Map and Set: hash tables keyed by any value (see hash_maps.c), iterated in insertion order.
+// Keys use their class's hash() and equals(), with fast paths for numbers and strings.
+
+// Map and Set Class Initialization (both classes)
+void map_class_init(vm_t* vm);
+
+// Factory Functions
+value_t map_factory(vm_t* vm, class_t* self, int arg_count, value_t* args);
+value_t set_factory(vm_t* vm, class_t* self, int arg_count, value_t* args);
+
+// Map Static Methods
+value_t builtin_map_from_array(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_group_by(vm_t* vm, int arg_count, value_t* args);
+
+// Map Instance Methods
+value_t builtin_map_size(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_is_empty(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_get(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_set(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_has(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_delete(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_clear(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_reserve(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_keys(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_values(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_entries(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_copy(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_hash(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_equals(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_map_to_string(vm_t* vm, int arg_count, value_t* args);
+
+// Set Static Methods
+value_t builtin_set_from_array(vm_t* vm, int arg_count, value_t* args);
+
+// Set Instance Methods
+value_t builtin_set_size(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_is_empty(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_add(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_has(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_delete(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_clear(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_reserve(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_to_array(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_copy(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_union(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_intersection(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_difference(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_hash(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_equals(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_set_to_string(vm_t* vm, int arg_count, value_t* args);
+
+// Shared helpers
+hash_map_t* map_allocate(vm_t* vm, size_t capacity, const char* name); // Raises if out of memory
+void map_put(vm_t* vm, hash_map_t* map, value_t key, value_t value, const char* name); // Raises if out of memory
+void map_reserve(vm_t* vm, hash_map_t* map, value_t count); // reserve(n) argument checking
+ds_string map_to_display_string(vm_t* vm, value_t map); // "Map{k: v}" or "Set{x, y}"
+
+// External dependencies from other modules
+value_t builtin_iterator(vm_t* vm, int arg_count, value_t* args);
+
+#endif // CLASS_MAP_H
@@ -0,0 +1,199 @@
+#include "map.h"
+#include "builtins.h"
+#include "dynamic_array.h"
+#include "dynamic_string.h"
+
+hash_map_t* map_allocate(vm_t* vm, size_t capacity, const char* name) {
+    hash_map_t* map = hash_map_create(capacity);
+    if (!map) {
+        runtime_error(vm, "%s() failed: out of memory", name);
+    }
+    return map;
+}
+
+void map_put(vm_t* vm, hash_map_t* map, value_t key, value_t value, const char* name) {
+    if (!hash_map_put(vm, map, key, value)) {
+        runtime_error(vm, "%s() failed: out of memory", name);
+    }
+}
+
+ds_string map_to_display_string(vm_t* vm, value_t value) {
+    int is_map = value.type == VAL_MAP;
+    hash_map_t* map = value.as.map;
+    ds_builder sb = ds_builder_create();
+    ds_builder_append(sb, is_map ? "Map{" : "Set{");
+    int first = 1;
+    for (size_t i = 0; i < map->entry_count; i++) {
+        hash_map_entry* entry = &map->entries[i];
+        if (!entry->live) continue;
+        if (!first) {
+            ds_builder_append(sb, ", ");
+        }
+        first = 0;
+        ds_string key = display_value_to_string(vm, entry->key);
+        ds_builder_append_string(sb, key);
+        ds_release(&key);
+        if (is_map) {
+            ds_builder_append(sb, ": ");
+            ds_string element = display_value_to_string(vm, entry->value);
+            ds_builder_append_string(sb, element);
+            ds_release(&element);
+        }
+    }
+    ds_builder_append(sb, "}");
+    ds_string result = ds_builder_to_string(sb);
+    ds_builder_release(&sb);
+    return result;
+}
+
+static hash_map_t* receiver_map(vm_t* vm, int arg_count, value_t* args, int expected, const char* name) {
+    if (arg_count != expected + 1) {
+        if (expected == 0) {
+            runtime_error(vm, "%s() takes no arguments (%d given)", name, arg_count - 1);
+        }
+        runtime_error(vm, "%s() takes exactly %d argument%s (%d given)", name, expected, expected == 1 ? "" : "s",
+                      arg_count - 1);
+    }
+    if (args[0].type != VAL_MAP) {
+        runtime_error(vm, "%s() can only be called on maps", name);
+    }
+    return args[0].as.map;
+}
+
+// map.size() - Number of entries
+value_t builtin_map_size(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "size");
+    return make_int32((int32_t)map->count);
+}
+
+// map.isEmpty() - True if there are no entries
+value_t builtin_map_is_empty(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "isEmpty");
+    return make_boolean(map->count == 0);
+}
+
+// map.get(key, default?) - The value stored under key, else default (or null)
+value_t builtin_map_get(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2 && arg_count != 3) {
+        runtime_error(vm, "get() takes 1 or 2 arguments (%d given)", arg_count - 1);
+    }
+    hash_map_t* map = receiver_map(vm, arg_count, args, arg_count - 1, "get");
+    hash_map_entry* entry = hash_map_find(vm, map, args[1]);
+    if (entry) {
+        return vm_retain(entry->value);
+    }
+    return arg_count == 3 ? vm_retain(args[2]) : make_null();
+}
+
+// map.set(key, value) - Store value under key; returns the map for chaining
+value_t builtin_map_set(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 2, "set");
+    map_put(vm, map, args[1], args[2], "set");
+    return vm_retain(args[0]);
+}
+
+// map.has(key) - True if key has an entry
+value_t builtin_map_has(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 1, "has");
+    return make_boolean(hash_map_find(vm, map, args[1]) != NULL);
+}
+
+// map.delete(key) - Remove key's entry; true if there was one
+value_t builtin_map_delete(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 1, "delete");
+    return make_boolean(hash_map_remove(vm, map, args[1]));
+}
+
+// map.clear() - Remove every entry; returns the map
+value_t builtin_map_clear(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "clear");
+    hash_map_clear(map);
+    return vm_retain(args[0]);
+}
+
+// Shared by Map and Set reserve(): room for n entries in total without rehashing
+void map_reserve(vm_t* vm, hash_map_t* map, value_t count) {
+    if (count.type != VAL_INT32 || count.as.int32 < 0) {
+        runtime_error(vm, "reserve() requires a non-negative Int");
+    }
+    if (!hash_map_reserve(map, (size_t)count.as.int32)) {
+        runtime_error(vm, "reserve() failed: out of memory");
+    }
+}
+
+// map.reserve(n) - Preallocate for n entries; returns the map
+value_t builtin_map_reserve(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 1, "reserve");
+    map_reserve(vm, map, args[1]);
+    return vm_retain(args[0]);
+}
+
+// map.keys() - Array of the keys in insertion order
+value_t builtin_map_keys(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "keys");
+    return make_array(hash_map_to_array(map, HASH_MAP_KEYS));
+}
+
+// map.values() - Array of the values in insertion order
+value_t builtin_map_values(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "values");
+    return make_array(hash_map_to_array(map, HASH_MAP_VALUES));
+}
+
+// map.entries() - Array of [key, value] pairs in insertion order
+value_t builtin_map_entries(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "entries");
+    return make_array(hash_map_to_array(map, HASH_MAP_ENTRIES));
+}
+
+// map.copy() - Shallow copy (keys and values are shared)
+value_t builtin_map_copy(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "copy");
+    hash_map_t* copy = hash_map_copy(map);
+    if (!copy) {
+        runtime_error(vm, "copy() failed: out of memory");
+    }
+    return make_map(copy);
+}
+
+// map.hash() - Independent of insertion order, like equals()
+value_t builtin_map_hash(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 0, "hash");
+    uint32_t hash = 0x811c9dc5 ^ (uint32_t)map->count;
+    for (size_t i = 0; i < map->entry_count; i++) {
+        hash_map_entry* entry = &map->entries[i];
+        if (!entry->live) continue;
+        hash += entry->hash * 31 + call_hash_method(vm, entry->value);
+    }
+    return make_int32((int32_t)hash);
+}
+
+// map.equals(other) - Same keys, each with an equal value, in any order
+value_t builtin_map_equals(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* map = receiver_map(vm, arg_count, args, 1, "equals");
+    if (args[1].type != VAL_MAP) {
+        return make_boolean(0);
+    }
+    hash_map_t* other = args[1].as.map;
+    if (other == map) {
+        return make_boolean(1);
+    }
+    if (other->count != map->count) {
+        return make_boolean(0);
+    }
+    for (size_t i = 0; i < map->entry_count; i++) {
+        hash_map_entry* entry = &map->entries[i];
+        if (!entry->live) continue;
+        hash_map_entry* match = hash_map_find(vm, other, entry->key);
+        if (!match || !call_equals_method(vm, entry->value, match->value)) {
+            return make_boolean(0);
+        }
+    }
+    return make_boolean(1);
+}
+
+// map.toString() - Map{key: value, ...}
+value_t builtin_map_to_string(vm_t* vm, int arg_count, value_t* args) {
+    receiver_map(vm, arg_count, args, 0, "toString");
+    return make_string_ds(map_to_display_string(vm, args[0]));
+}
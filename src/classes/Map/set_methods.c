@@ -0,0 +1,166 @@
+#include "map.h"
+#include "builtins.h"
+#include "dynamic_array.h"
+
+static hash_map_t* receiver_set(vm_t* vm, int arg_count, value_t* args, int expected, const char* name) {
+    if (arg_count != expected + 1) {
+        if (expected == 0) {
+            runtime_error(vm, "%s() takes no arguments (%d given)", name, arg_count - 1);
+        }
+        runtime_error(vm, "%s() takes exactly %d argument%s (%d given)", name, expected, expected == 1 ? "" : "s",
+                      arg_count - 1);
+    }
+    if (args[0].type != VAL_SET) {
+        runtime_error(vm, "%s() can only be called on sets", name);
+    }
+    return args[0].as.map;
+}
+
+static hash_map_t* set_argument(vm_t* vm, value_t value, const char* name) {
+    if (value.type != VAL_SET) {
+        runtime_error(vm, "%s() requires a set, not %s", name, value_class_name(value));
+    }
+    return value.as.map;
+}
+
+// set.size() - Number of elements
+value_t builtin_set_size(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 0, "size");
+    return make_int32((int32_t)set->count);
+}
+
+// set.isEmpty() - True if there are no elements
+value_t builtin_set_is_empty(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 0, "isEmpty");
+    return make_boolean(set->count == 0);
+}
+
+// set.add(element) - Add element if absent; returns the set for chaining
+value_t builtin_set_add(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "add");
+    if (!hash_map_find(vm, set, args[1])) {
+        map_put(vm, set, args[1], make_null(), "add");
+    }
+    return vm_retain(args[0]);
+}
+
+// set.has(element) - True if element is in the set
+value_t builtin_set_has(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "has");
+    return make_boolean(hash_map_find(vm, set, args[1]) != NULL);
+}
+
+// set.delete(element) - Remove element; true if it was there
+value_t builtin_set_delete(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "delete");
+    return make_boolean(hash_map_remove(vm, set, args[1]));
+}
+
+// set.clear() - Remove every element; returns the set
+value_t builtin_set_clear(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 0, "clear");
+    hash_map_clear(set);
+    return vm_retain(args[0]);
+}
+
+// set.reserve(n) - Preallocate for n elements; returns the set
+value_t builtin_set_reserve(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "reserve");
+    map_reserve(vm, set, args[1]);
+    return vm_retain(args[0]);
+}
+
+// set.toArray() - Array of the elements in insertion order
+value_t builtin_set_to_array(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 0, "toArray");
+    return make_array(hash_map_to_array(set, HASH_MAP_KEYS));
+}
+
+// set.copy() - Shallow copy
+value_t builtin_set_copy(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 0, "copy");
+    hash_map_t* copy = hash_map_copy(set);
+    if (!copy) {
+        runtime_error(vm, "copy() failed: out of memory");
+    }
+    return make_set(copy);
+}
+
+// set.union(other) - Elements in either set
+value_t builtin_set_union(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "union");
+    hash_map_t* other = set_argument(vm, args[1], "union");
+    hash_map_t* result = hash_map_copy(set);
+    if (!result || !hash_map_reserve(result, set->count + other->count)) {
+        if (result) hash_map_release(result);
+        runtime_error(vm, "union() failed: out of memory");
+    }
+    for (size_t i = 0; i < other->entry_count; i++) {
+        hash_map_entry* entry = &other->entries[i];
+        if (entry->live && !hash_map_find(vm, result, entry->key)) {
+            map_put(vm, result, entry->key, make_null(), "union");
+        }
+    }
+    return make_set(result);
+}
+
+// Elements of set that are (keep_common) or are not in other, in set's order
+static value_t filter_set(vm_t* vm, hash_map_t* set, hash_map_t* other, int keep_common, const char* name) {
+    hash_map_t* result = map_allocate(vm, keep_common && other->count < set->count ? other->count : set->count, name);
+    for (size_t i = 0; i < set->entry_count; i++) {
+        hash_map_entry* entry = &set->entries[i];
+        if (!entry->live) continue;
+        if ((hash_map_find(vm, other, entry->key) != NULL) == keep_common) {
+            map_put(vm, result, entry->key, make_null(), name);
+        }
+    }
+    return make_set(result);
+}
+
+// set.intersection(other) - Elements in both sets
+value_t builtin_set_intersection(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "intersection");
+    return filter_set(vm, set, set_argument(vm, args[1], "intersection"), 1, "intersection");
+}
+
+// set.difference(other) - Elements of this set that are not in other
+value_t builtin_set_difference(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "difference");
+    return filter_set(vm, set, set_argument(vm, args[1], "difference"), 0, "difference");
+}
+
+// set.hash() - Independent of insertion order, like equals()
+value_t builtin_set_hash(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 0, "hash");
+    uint32_t hash = 0x01000193 ^ (uint32_t)set->count;
+    for (size_t i = 0; i < set->entry_count; i++) {
+        if (set->entries[i].live) {
+            hash += set->entries[i].hash;
+        }
+    }
+    return make_int32((int32_t)hash);
+}
+
+// set.equals(other) - Same elements, in any order
+value_t builtin_set_equals(vm_t* vm, int arg_count, value_t* args) {
+    hash_map_t* set = receiver_set(vm, arg_count, args, 1, "equals");
+    if (args[1].type != VAL_SET) {
+        return make_boolean(0);
+    }
+    hash_map_t* other = args[1].as.map;
+    if (other->count != set->count) {
+        return make_boolean(0);
+    }
+    for (size_t i = 0; i < set->entry_count; i++) {
+        if (set->entries[i].live && !hash_map_find(vm, other, set->entries[i].key)) {
+            return make_boolean(0);
+        }
+    }
+    return make_boolean(1);
+}
+
+// set.toString() - Set{element, ...}
+value_t builtin_set_to_string(vm_t* vm, int arg_count, value_t* args) {
+    receiver_set(vm, arg_count, args, 0, "toString");
+    return make_string_ds(map_to_display_string(vm, args[0]));
+}
@@ -3,7 +3,7 @@
 #include "dynamic_object.h"
 
 // Global Null class storage
-value_t* global_null_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_null_class = NULL;
 
 // Initialize Null class with prototype and methods
 void initialize_null_class(vm_t* vm) {
@@ -27,7 +27,7 @@ void initialize_null_class(vm_t* vm) {
     do_set(vm->globals, "Null", &null_class, sizeof(value_t));
 
     // Store a global reference for use in make_null
-    static value_t null_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t null_class_storage;
     null_class_storage = vm_retain(null_class);
     global_null_class = &null_class_storage;
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "dynamic_object.h"
 
 // Global Number class storage
-value_t* global_number_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_number_class = NULL;
 
 // Create abstract Number superclass (no instance methods - purely for instanceof)
 void number_class_init(vm_t* vm) {
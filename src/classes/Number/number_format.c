@@ -0,0 +1,432 @@
+#include "number_format.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ---------------------------------------------------------------------------------------------
+// Integers
+// ---------------------------------------------------------------------------------------------
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static size_t count_digits(uint64_t value) {
+    size_t count = 1;
+    for (;;) {
+        if (value < 10) return count;
+        if (value < 100) return count + 1;
+        if (value < 1000) return count + 2;
+        if (value < 10000) return count + 3;
+        value /= 10000;
+        count += 4;
+    }
+}
+
+// Writes the digits of value backwards from end, two at a time
+static void write_digits(char* end, uint64_t value) {
+    while (value >= 100) {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--end = digit_pairs[pair + 1];
+        *--end = digit_pairs[pair];
+    }
+    if (value >= 10) {
+        *--end = digit_pairs[value * 2 + 1];
+        *--end = digit_pairs[value * 2];
+    } else {
+        *--end = (char)('0' + value);
+    }
+}
+
+size_t nf_format_uint64(char* out, uint64_t value) {
+    size_t length = count_digits(value);
+    write_digits(out + length, value);
+    return length;
+}
+
+size_t nf_format_int64(char* out, int64_t value) {
+    if (value < 0) {
+        *out = '-';
+        return 1 + nf_format_uint64(out + 1, 0 - (uint64_t)value);
+    }
+    return nf_format_uint64(out, (uint64_t)value);
+}
+
+size_t nf_format_uint32(char* out, uint32_t value) { return nf_format_uint64(out, value); }
+
+size_t nf_format_int32(char* out, int32_t value) { return nf_format_int64(out, value); }
+
+// ---------------------------------------------------------------------------------------------
+// Shortest float digits (Grisu3)
+// ---------------------------------------------------------------------------------------------
+
+// f * 2^e with a 64-bit significand
+typedef struct {
+    uint64_t f;
+    int e;
+} diy_fp;
+
+// Cached powers of ten 10^k for k = -348, -340, ... 340, normalized to 64-bit significands
+typedef struct {
+    uint64_t significand;
+    int16_t binary_exponent;
+    int16_t decimal_exponent;
+} cached_power;
+
+static const cached_power cached_powers[] = {
+    {0xfa8fd5a0081c0288ull, -1220, -348},
+    {0xbaaee17fa23ebf76ull, -1193, -340},
+    {0x8b16fb203055ac76ull, -1166, -332},
+    {0xcf42894a5dce35eaull, -1140, -324},
+    {0x9a6bb0aa55653b2dull, -1113, -316},
+    {0xe61acf033d1a45dfull, -1087, -308},
+    {0xab70fe17c79ac6caull, -1060, -300},
+    {0xff77b1fcbebcdc4full, -1034, -292},
+    {0xbe5691ef416bd60cull, -1007, -284},
+    {0x8dd01fad907ffc3cull, -980, -276},
+    {0xd3515c2831559a83ull, -954, -268},
+    {0x9d71ac8fada6c9b5ull, -927, -260},
+    {0xea9c227723ee8bcbull, -901, -252},
+    {0xaecc49914078536dull, -874, -244},
+    {0x823c12795db6ce57ull, -847, -236},
+    {0xc21094364dfb5637ull, -821, -228},
+    {0x9096ea6f3848984full, -794, -220},
+    {0xd77485cb25823ac7ull, -768, -212},
+    {0xa086cfcd97bf97f4ull, -741, -204},
+    {0xef340a98172aace5ull, -715, -196},
+    {0xb23867fb2a35b28eull, -688, -188},
+    {0x84c8d4dfd2c63f3bull, -661, -180},
+    {0xc5dd44271ad3cdbaull, -635, -172},
+    {0x936b9fcebb25c996ull, -608, -164},
+    {0xdbac6c247d62a584ull, -582, -156},
+    {0xa3ab66580d5fdaf6ull, -555, -148},
+    {0xf3e2f893dec3f126ull, -529, -140},
+    {0xb5b5ada8aaff80b8ull, -502, -132},
+    {0x87625f056c7c4a8bull, -475, -124},
+    {0xc9bcff6034c13053ull, -449, -116},
+    {0x964e858c91ba2655ull, -422, -108},
+    {0xdff9772470297ebdull, -396, -100},
+    {0xa6dfbd9fb8e5b88full, -369, -92},
+    {0xf8a95fcf88747d94ull, -343, -84},
+    {0xb94470938fa89bcfull, -316, -76},
+    {0x8a08f0f8bf0f156bull, -289, -68},
+    {0xcdb02555653131b6ull, -263, -60},
+    {0x993fe2c6d07b7facull, -236, -52},
+    {0xe45c10c42a2b3b06ull, -210, -44},
+    {0xaa242499697392d3ull, -183, -36},
+    {0xfd87b5f28300ca0eull, -157, -28},
+    {0xbce5086492111aebull, -130, -20},
+    {0x8cbccc096f5088ccull, -103, -12},
+    {0xd1b71758e219652cull, -77, -4},
+    {0x9c40000000000000ull, -50, 4},
+    {0xe8d4a51000000000ull, -24, 12},
+    {0xad78ebc5ac620000ull, 3, 20},
+    {0x813f3978f8940984ull, 30, 28},
+    {0xc097ce7bc90715b3ull, 56, 36},
+    {0x8f7e32ce7bea5c70ull, 83, 44},
+    {0xd5d238a4abe98068ull, 109, 52},
+    {0x9f4f2726179a2245ull, 136, 60},
+    {0xed63a231d4c4fb27ull, 162, 68},
+    {0xb0de65388cc8ada8ull, 189, 76},
+    {0x83c7088e1aab65dbull, 216, 84},
+    {0xc45d1df942711d9aull, 242, 92},
+    {0x924d692ca61be758ull, 269, 100},
+    {0xda01ee641a708deaull, 295, 108},
+    {0xa26da3999aef774aull, 322, 116},
+    {0xf209787bb47d6b85ull, 348, 124},
+    {0xb454e4a179dd1877ull, 375, 132},
+    {0x865b86925b9bc5c2ull, 402, 140},
+    {0xc83553c5c8965d3dull, 428, 148},
+    {0x952ab45cfa97a0b3ull, 455, 156},
+    {0xde469fbd99a05fe3ull, 481, 164},
+    {0xa59bc234db398c25ull, 508, 172},
+    {0xf6c69a72a3989f5cull, 534, 180},
+    {0xb7dcbf5354e9beceull, 561, 188},
+    {0x88fcf317f22241e2ull, 588, 196},
+    {0xcc20ce9bd35c78a5ull, 614, 204},
+    {0x98165af37b2153dfull, 641, 212},
+    {0xe2a0b5dc971f303aull, 667, 220},
+    {0xa8d9d1535ce3b396ull, 694, 228},
+    {0xfb9b7cd9a4a7443cull, 720, 236},
+    {0xbb764c4ca7a44410ull, 747, 244},
+    {0x8bab8eefb6409c1aull, 774, 252},
+    {0xd01fef10a657842cull, 800, 260},
+    {0x9b10a4e5e9913129ull, 827, 268},
+    {0xe7109bfba19c0c9dull, 853, 276},
+    {0xac2820d9623bf429ull, 880, 284},
+    {0x80444b5e7aa7cf85ull, 907, 292},
+    {0xbf21e44003acdd2dull, 933, 300},
+    {0x8e679c2f5e44ff8full, 960, 308},
+    {0xd433179d9c8cb841ull, 986, 316},
+    {0x9e19db92b4e31ba9ull, 1013, 324},
+    {0xeb96bf6ebadf77d9ull, 1039, 332},
+    {0xaf87023b9bf0ee6bull, 1066, 340},
+};
+
+#define CACHED_POWERS_OFFSET 348 // -cached_powers[0].decimal_exponent
+#define CACHED_POWERS_STEP 8
+
+// The digit loop wants w * 10^-k scaled so its binary exponent is between -60 and -32
+#define MIN_TARGET_EXPONENT -60
+
+static diy_fp diy_normalize(diy_fp x) {
+#if defined(__GNUC__) || defined(__clang__)
+    int shift = __builtin_clzll(x.f);
+    x.f <<= shift;
+    x.e -= shift;
+#else
+    while (!(x.f & 0x8000000000000000ull)) {
+        x.f <<= 1;
+        x.e--;
+    }
+#endif
+    return x;
+}
+
+// Upper 64 bits of the 128-bit product, rounded
+static diy_fp diy_multiply(diy_fp x, diy_fp y) {
+    const uint64_t mask = 0xFFFFFFFFull;
+    uint64_t a = x.f >> 32, b = x.f & mask, c = y.f >> 32, d = y.f & mask;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t middle = (bd >> 32) + (ad & mask) + (bc & mask) + (1ull << 31);
+    diy_fp product = {ac + (ad >> 32) + (bc >> 32) + (middle >> 32), x.e + y.e + 64};
+    return product;
+}
+
+// Normalized w and the midpoints to its neighbours, all with w's exponent. lower_closer is set for
+// powers of two, whose lower neighbour is half as far away.
+static void float_boundaries(uint64_t f, int e, int lower_closer, diy_fp* w, diy_fp* minus, diy_fp* plus) {
+    diy_fp value = {f, e};
+    diy_fp upper = {(f << 1) + 1, e - 1};
+    *w = diy_normalize(value);
+    *plus = diy_normalize(upper);
+    if (lower_closer) {
+        minus->f = (f << 2) - 1;
+        minus->e = e - 2;
+    } else {
+        minus->f = (f << 1) - 1;
+        minus->e = e - 1;
+    }
+    minus->f <<= minus->e - plus->e;
+    minus->e = plus->e;
+}
+
+// Steps the last digit down towards w while that stays inside the safe interval, and reports
+// whether the result is provably the closest shortest representation
+static int round_weed(char* digits, int length, uint64_t distance_too_high_w, uint64_t unsafe_interval,
+                      uint64_t rest, uint64_t ten_kappa, uint64_t unit) {
+    uint64_t small_distance = distance_too_high_w - unit;
+    uint64_t big_distance = distance_too_high_w + unit;
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+           (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)) {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+        (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance)) {
+        return 0;
+    }
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Generates digits of high until they fall inside (low, high), so they are as short as possible
+static int digit_gen(diy_fp low, diy_fp w, diy_fp high, char* digits, int* length, int* kappa) {
+    static const uint32_t powers_of_ten[] = {1,      10,      100,      1000,      10000,
+                                             100000, 1000000, 10000000, 100000000, 1000000000};
+    uint64_t unit = 1;
+    diy_fp too_low = {low.f - unit, low.e};
+    diy_fp too_high = {high.f + unit, high.e};
+    uint64_t unsafe_interval = too_high.f - too_low.f;
+    int shift = -w.e;
+    uint64_t one = 1ull << shift;
+    uint32_t integrals = (uint32_t)(too_high.f >> shift);
+    uint64_t fractionals = too_high.f & (one - 1);
+
+    int divisor_exponent = 9;
+    while (divisor_exponent > 0 && integrals < powers_of_ten[divisor_exponent]) {
+        divisor_exponent--;
+    }
+    uint32_t divisor = powers_of_ten[divisor_exponent];
+    *kappa = divisor_exponent + 1;
+    *length = 0;
+
+    while (*kappa > 0) {
+        digits[(*length)++] = (char)('0' + integrals / divisor);
+        integrals %= divisor;
+        (*kappa)--;
+        uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            return round_weed(digits, *length, too_high.f - w.f, unsafe_interval, rest, (uint64_t)divisor << shift,
+                              unit);
+        }
+        divisor /= 10;
+    }
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits[(*length)++] = (char)('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        (*kappa)--;
+        if (fractionals < unsafe_interval) {
+            return round_weed(digits, *length, (too_high.f - w.f) * unit, unsafe_interval, fractionals, one, unit);
+        }
+    }
+}
+
+// Shortest digits for w with value = digits * 10^exponent in *length; 0 if Grisu3 can't be sure
+// of them, when *length is still a lower bound on how many are needed
+static int grisu3(diy_fp w, diy_fp minus, diy_fp plus, char* digits, int* length, int* exponent) {
+    // Pick the cached power that brings w's exponent into the target range
+    int min_exponent = MIN_TARGET_EXPONENT - (w.e + 64);
+    int k = (int)ceil((min_exponent + 63) * 0.30102999566398114);
+    int index = (CACHED_POWERS_OFFSET + k - 1) / CACHED_POWERS_STEP + 1;
+    cached_power power = cached_powers[index];
+    diy_fp ten_mk = {power.significand, power.binary_exponent};
+
+    int kappa;
+    int ok = digit_gen(diy_multiply(minus, ten_mk), diy_multiply(w, ten_mk), diy_multiply(plus, ten_mk), digits,
+                       length, &kappa);
+    *exponent = kappa - power.decimal_exponent;
+    return ok;
+}
+
+// Shortest digits by trying precisions from min_length up, for the values Grisu3 gives up on (mostly
+// exact ties between two shortest candidates, which snprintf rounds to even)
+static int shortest_by_search(double value, int single, int min_length, char* digits, int* exponent) {
+    char text[40];
+    int max_length = single ? 9 : 17;
+    for (int precision = min_length > 1 ? min_length : 1;; precision++) {
+        snprintf(text, sizeof(text), "%.*e", precision - 1, value);
+        if (precision >= max_length) break;
+        if (single ? strtof(text, NULL) == (float)value : strtod(text, NULL) == value) break;
+    }
+
+    int length = 0;
+    const char* p = text;
+    for (; *p != 'e'; p++) {
+        if (*p >= '0' && *p <= '9') digits[length++] = *p;
+    }
+    *exponent = atoi(p + 1) - (length - 1);
+    while (length > 1 && digits[length - 1] == '0') {
+        length--;
+        (*exponent)++;
+    }
+    return length;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Layout
+// ---------------------------------------------------------------------------------------------
+
+// Lays out value = digits * 10^exponent the way %g would, given the shortest digits
+static size_t layout(char* out, const char* digits, int length, int exponent, int max_plain_exponent) {
+    char* p = out;
+    int point = length + exponent; // Digits before the decimal point
+    int scientific = point - 1;
+    if (scientific < -4 || scientific >= max_plain_exponent) {
+        *p++ = digits[0];
+        if (length > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, (size_t)(length - 1));
+            p += length - 1;
+        }
+        *p++ = 'e';
+        *p++ = scientific < 0 ? '-' : '+';
+        int magnitude = scientific < 0 ? -scientific : scientific;
+        if (magnitude < 10) *p++ = '0';
+        p += nf_format_uint32(p, (uint32_t)magnitude);
+    } else if (point <= 0) {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', (size_t)-point);
+        p += -point;
+        memcpy(p, digits, (size_t)length);
+        p += length;
+    } else if (point >= length) {
+        memcpy(p, digits, (size_t)length);
+        p += length;
+        memset(p, '0', (size_t)(point - length));
+        p += point - length;
+    } else {
+        memcpy(p, digits, (size_t)point);
+        p += point;
+        *p++ = '.';
+        memcpy(p, digits + point, (size_t)(length - point));
+        p += length - point;
+    }
+    return (size_t)(p - out);
+}
+
+static size_t format_special(char* out, double value) {
+    const char* text = isnan(value) ? "NaN" : value > 0 ? "Infinity" : "-Infinity";
+    size_t length = strlen(text);
+    memcpy(out, text, length);
+    return length;
+}
+
+size_t nf_format_float64(char* out, double value) {
+    if (!isfinite(value)) return format_special(out, value);
+
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    char* p = out;
+    if (bits >> 63) *p++ = '-';
+    int biased = (int)((bits >> 52) & 0x7FF);
+    uint64_t fraction = bits & 0xFFFFFFFFFFFFFull;
+    if (biased == 0 && fraction == 0) {
+        *p++ = '0';
+        return (size_t)(p - out);
+    }
+
+    uint64_t f = biased == 0 ? fraction : fraction | 0x10000000000000ull;
+    int e = biased == 0 ? -1074 : biased - 1075;
+    diy_fp w, minus, plus;
+    float_boundaries(f, e, fraction == 0 && biased > 1, &w, &minus, &plus);
+
+    char digits[20];
+    int exponent;
+    int length;
+    if (!grisu3(w, minus, plus, digits, &length, &exponent)) {
+        length = shortest_by_search(fabs(value), 0, length, digits, &exponent);
+    }
+    return (size_t)(p - out) + layout(p, digits, length, exponent, 15);
+}
+
+size_t nf_format_float32(char* out, float value) {
+    if (!isfinite(value)) return format_special(out, value);
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    char* p = out;
+    if (bits >> 31) *p++ = '-';
+    int biased = (int)((bits >> 23) & 0xFF);
+    uint32_t fraction = bits & 0x7FFFFFu;
+    if (biased == 0 && fraction == 0) {
+        *p++ = '0';
+        return (size_t)(p - out);
+    }
+
+    uint64_t f = biased == 0 ? fraction : fraction | 0x800000u;
+    int e = biased == 0 ? -149 : biased - 150;
+    diy_fp w, minus, plus;
+    float_boundaries(f, e, fraction == 0 && biased > 1, &w, &minus, &plus);
+
+    char digits[20];
+    int exponent;
+    int length;
+    if (!grisu3(w, minus, plus, digits, &length, &exponent)) {
+        length = shortest_by_search(fabsf(value), 1, length, digits, &exponent);
+    }
+    return (size_t)(p - out) + layout(p, digits, length, exponent, 7);
+}
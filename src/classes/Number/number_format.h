@@ -0,0 +1,28 @@
+#ifndef NUMBER_FORMAT_H
+#define NUMBER_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Decimal text for numbers, written directly instead of through snprintf.
+//
+// Each function writes into out, which needs room for NF_MAX_LENGTH bytes, and returns the number
+// of bytes written. Nothing is NUL-terminated, so callers can format straight into a string or
+// builder buffer.
+//
+// Floats print the fewest digits that read back as the same value. Grisu3 finds them for almost
+// every input; the few it can't decide (mostly exact ties between two candidates) go through
+// snprintf with a round-trip check. The layout follows %g: plain notation unless the exponent is
+// below -4 or at least 15 (7 for float32), when it is "1.5e+20". NaN and the infinities print as
+// "NaN", "Infinity" and "-Infinity".
+
+#define NF_MAX_LENGTH 32
+
+size_t nf_format_uint32(char* out, uint32_t value);
+size_t nf_format_int32(char* out, int32_t value);
+size_t nf_format_uint64(char* out, uint64_t value);
+size_t nf_format_int64(char* out, int64_t value);
+size_t nf_format_float64(char* out, double value);
+size_t nf_format_float32(char* out, float value);
+
+#endif // NUMBER_FORMAT_H
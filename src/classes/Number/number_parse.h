@@ -0,0 +1,51 @@
+#ifndef NUMBER_PARSE_H
+#define NUMBER_PARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "dynamic_int.h"
+
+// Decimal text to numbers, by the same rules as number literals: an integer is an Int when it fits
+// in 32 bits and a BigInt otherwise; a fraction or exponent makes a Float, float32 with an f
+// suffix (d forces float64). Unlike a literal, the text may start with + or -.
+//
+// Digits are read eight at a time with SWAR arithmetic. Floats are rounded correctly by the
+// Eisel-Lemire algorithm, after the exact fast path for short mantissas and small exponents. Only
+// the rare inputs it can't settle (more than 19 significant digits that land near a tie) go
+// through strtod.
+
+#define NP_INTEGER_ONLY 1 // Stop before a fraction or exponent instead of reading a Float
+#define NP_SINGLE 2       // Floats without a suffix are float32
+#define NP_BARE_POINT 4   // Also read a point with digits on one side only, as in .5 and 1.
+
+typedef enum {
+    NP_INVALID,
+    NP_INT32,
+    NP_BIGINT,
+    NP_FLOAT64,
+    NP_FLOAT32,
+} np_kind;
+
+typedef struct {
+    np_kind kind;
+    union {
+        int32_t int32;
+        di_int bigint; // Owned by the caller
+        double float64;
+        float float32;
+    } as;
+} np_number;
+
+// Reads the number at the start of text and returns how many bytes it took (0 and NP_INVALID when
+// there isn't one there)
+size_t np_scan(const char* text, size_t length, int flags, np_number* out);
+
+// Reads text as exactly one number; NP_INVALID when anything else is left over
+np_kind np_parse(const char* text, size_t length, int flags, np_number* out);
+
+// Value of the number at the start of text as a float64 or (rounded once) a float32; 0 if there
+// isn't one. For literals the lexer has already checked.
+double np_parse_float64(const char* text, size_t length);
+float np_parse_float32(const char* text, size_t length);
+
+#endif // NUMBER_PARSE_H
@@ -3,7 +3,7 @@
 #include "dynamic_object.h"
 
 // Global Object class storage
-value_t* global_object_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_object_class = NULL;
 
 // Initialize Object class with prototype and methods
 void initialize_object_class(vm_t* vm) {
@@ -36,7 +36,7 @@ void initialize_object_class(vm_t* vm) {
     do_set(vm->globals, "Object", &object_class, sizeof(value_t));
 
     // Store a global reference for use in make_object
-    static value_t object_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t object_class_storage;
     object_class_storage = vm_retain(object_class);
     global_object_class = &object_class_storage;
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
 #include "value.h"
 
 // Global Object class for inheritance
-extern value_t* global_object_class;
+extern SLATE_ISOLATE_LOCAL value_t* global_object_class;
 
 void initialize_object_class(vm_t* vm);
 
@@ -13,9 +13,6 @@
 // Forward declaration for the global value hash function
 extern value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args);
 
-// Forward declaration for string hash function
-extern value_t builtin_string_hash(vm_t* vm, int arg_count, value_t* args);
-
 // Helper function to get hash code for object property values (avoids recursion)
 static uint32_t hash_object_property_value(vm_t* vm, value_t value) {
     // For objects, use pointer identity to avoid infinite recursion
@@ -28,13 +25,9 @@ static uint32_t hash_object_property_value(vm_t* vm, value_t value) {
     return (uint32_t)hash_result.as.int32;
 }
 
-// Helper function to hash a string key using existing string hash
-static uint32_t hash_string_key(vm_t* vm, const char* key) {
-    value_t key_string = make_string(key);
-    value_t hash_result = builtin_string_hash(vm, 1, &key_string);
-    uint32_t result = (uint32_t)hash_result.as.int32;
-    vm_release(key_string);
-    return result;
+// Keys are interned with their String.hash() value, so hashing one is a load
+static uint32_t hash_string_key(const char* key) {
+    return (uint32_t)do_interned_hash(key);
 }
 
 // Object method: hash() - Content-based hash using key-value pairs
@@ -72,7 +65,7 @@ value_t builtin_object_hash(vm_t* vm, int arg_count, value_t* args) {
             const char* key = keys[i];
             
             // Hash the key using string hash function
-            uint32_t key_hash = hash_string_key(vm, key);
+            uint32_t key_hash = hash_string_key(key);
             hash ^= key_hash;
             hash *= FNV_32_PRIME;
             
@@ -0,0 +1,238 @@
+#include "promise.h"
+#include "builtins.h"
+#include "dynamic_array.h"
+#include "dynamic_object.h"
+#include "event_loop.h"
+#include <stdio.h>
+
+// Global Promise class storage
+SLATE_ISOLATE_LOCAL value_t* global_promise_class = NULL;
+
+// Initialize Promise class with prototype and methods
+void promise_class_init(vm_t* vm) {
+    // Create the Promise class with its prototype
+    do_object promise_proto = do_create(NULL);
+
+    // Add methods to Promise prototype
+    value_t is_pending_method = make_native(builtin_promise_is_pending);
+    do_set(promise_proto, "isPending", &is_pending_method, sizeof(value_t));
+
+    value_t is_fulfilled_method = make_native(builtin_promise_is_fulfilled);
+    do_set(promise_proto, "isFulfilled", &is_fulfilled_method, sizeof(value_t));
+
+    value_t is_rejected_method = make_native(builtin_promise_is_rejected);
+    do_set(promise_proto, "isRejected", &is_rejected_method, sizeof(value_t));
+
+    value_t value_method = make_native(builtin_promise_value);
+    do_set(promise_proto, "value", &value_method, sizeof(value_t));
+
+    value_t error_method = make_native(builtin_promise_error);
+    do_set(promise_proto, "error", &error_method, sizeof(value_t));
+
+    // Create static methods object
+    do_object promise_static = do_create(NULL);
+    value_t all_method = make_native(builtin_promise_all);
+    do_set(promise_static, "all", &all_method, sizeof(value_t));
+
+    // Create the Promise class (promises only come from asynchronous operations, so no factory)
+    value_t promise_class = make_class("Promise", promise_proto, promise_static);
+
+    // Store in globals
+    do_set(vm->globals, "Promise", &promise_class, sizeof(value_t));
+
+    // Store a global reference for use in make_promise
+    static SLATE_ISOLATE_LOCAL value_t promise_class_storage;
+    promise_class_storage = vm_retain(promise_class);
+    global_promise_class = &promise_class_storage;
+}
+
+static event_loop_t* require_event_loop(vm_t* vm, const char* name) {
+    event_loop_t* loop = event_loop_get(vm);
+    if (!loop) {
+        runtime_error(vm, "%s() is not available: asynchronous I/O isn't supported on this platform", name);
+    }
+    return loop;
+}
+
+static value_t promise_result(vm_t* vm, promise_t* promise, const char* name) {
+    if (!promise) {
+        runtime_error(vm, "%s() failed: out of memory", name);
+    }
+    return make_promise(promise);
+}
+
+static promise_t* receiver_promise(vm_t* vm, int arg_count, value_t* args, const char* name) {
+    if (arg_count != 1) {
+        runtime_error(vm, "%s() takes no arguments (%d given)", name, arg_count - 1);
+    }
+    if (args[0].type != VAL_PROMISE) {
+        runtime_error(vm, "%s() can only be called on promises", name);
+    }
+    return args[0].as.promise;
+}
+
+// promise.isPending() - Not settled yet
+value_t builtin_promise_is_pending(vm_t* vm, int arg_count, value_t* args) {
+    promise_t* promise = receiver_promise(vm, arg_count, args, "isPending");
+    return make_boolean(promise->state == PROMISE_PENDING);
+}
+
+// promise.isFulfilled() - Settled with a value
+value_t builtin_promise_is_fulfilled(vm_t* vm, int arg_count, value_t* args) {
+    promise_t* promise = receiver_promise(vm, arg_count, args, "isFulfilled");
+    return make_boolean(promise->state == PROMISE_FULFILLED);
+}
+
+// promise.isRejected() - Settled with an error
+value_t builtin_promise_is_rejected(vm_t* vm, int arg_count, value_t* args) {
+    promise_t* promise = receiver_promise(vm, arg_count, args, "isRejected");
+    return make_boolean(promise->state == PROMISE_REJECTED);
+}
+
+// promise.value() - Fulfilled value, null until then (doesn't wait: see await)
+value_t builtin_promise_value(vm_t* vm, int arg_count, value_t* args) {
+    promise_t* promise = receiver_promise(vm, arg_count, args, "value");
+    return promise->state == PROMISE_FULFILLED ? vm_retain(promise->value) : make_null();
+}
+
+// promise.error() - Error message of a rejected promise, null otherwise
+value_t builtin_promise_error(vm_t* vm, int arg_count, value_t* args) {
+    promise_t* promise = receiver_promise(vm, arg_count, args, "error");
+    return promise->state == PROMISE_REJECTED ? vm_retain(promise->value) : make_null();
+}
+
+// Promise.all(array) - Promise of all the results, in order
+value_t builtin_promise_all(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "Promise.all() takes exactly 1 argument (%d given)", arg_count);
+    }
+    if (args[0].type != VAL_ARRAY) {
+        runtime_error(vm, "Promise.all() requires an array, not %s", value_class_name(args[0]));
+    }
+    event_loop_t* loop = require_event_loop(vm, "Promise.all");
+    da_array array = args[0].as.array;
+    value_t* values = (value_t*)da_data(array);
+    return promise_result(vm, event_loop_all(loop, values, da_length(array)), "Promise.all");
+}
+
+static bool is_generator(value_t value) {
+    return value.type == VAL_ITERATOR && value.as.iterator->type == ITER_GENERATOR;
+}
+
+// spawn(generator) - Run a generator as a task, yielding promises to wait for them
+value_t builtin_spawn(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "spawn() takes exactly 1 argument (%d given)", arg_count);
+    }
+    if (!is_generator(args[0])) {
+        runtime_error(vm, "spawn() requires a generator, not %s", value_class_name(args[0]));
+    }
+    event_loop_t* loop = require_event_loop(vm, "spawn");
+    return promise_result(vm, event_loop_spawn(loop, args[0]), "spawn");
+}
+
+// await(value) - Run the event loop until a promise (or task, or array of them) settles
+value_t builtin_await(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "await() takes exactly 1 argument (%d given)", arg_count);
+    }
+    value_t target = args[0];
+    if (target.type != VAL_PROMISE && !is_generator(target) && target.type != VAL_ARRAY) {
+        return vm_retain(target);
+    }
+
+    event_loop_t* loop = require_event_loop(vm, "await");
+    promise_t* promise;
+    if (target.type == VAL_PROMISE) {
+        promise = target.as.promise;
+        promise->ref_count++;
+    } else if (target.type == VAL_ARRAY) {
+        promise = event_loop_all(loop, (value_t*)da_data(target.as.array), da_length(target.as.array));
+    } else {
+        promise = event_loop_spawn(loop, target);
+    }
+    if (!promise) {
+        runtime_error(vm, "await() failed: out of memory");
+    }
+
+    bool settled = event_loop_run_until(loop, promise);
+    value_t result = vm_retain(promise->value);
+    promise_state state = promise->state;
+    promise_release(promise);
+    if (!settled) {
+        runtime_error(vm, "await() would wait forever: nothing left can settle the promise");
+    }
+    if (state == PROMISE_REJECTED) {
+        // runtime_error doesn't return, so nothing can stay allocated
+        char message[512];
+        if (result.type == VAL_STRING) {
+            snprintf(message, sizeof(message), "%s", result.as.string);
+        } else {
+            ds_string text = display_value_to_string(vm, result);
+            snprintf(message, sizeof(message), "%s", text);
+            ds_release(&text);
+        }
+        vm_release(result);
+        runtime_error(vm, "%s", message);
+    }
+    return result;
+}
+
+// sleep(millis) - Promise fulfilled with null after the delay
+value_t builtin_sleep(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "sleep() takes exactly 1 argument (%d given)", arg_count);
+    }
+    int64_t millis;
+    if (args[0].type == VAL_INT32) {
+        millis = args[0].as.int32;
+    } else if (args[0].type == VAL_FLOAT64) {
+        millis = (int64_t)args[0].as.float64;
+    } else if (args[0].type == VAL_FLOAT32) {
+        millis = (int64_t)args[0].as.float32;
+    } else {
+        runtime_error(vm, "sleep() requires a number of milliseconds, not %s", value_class_name(args[0]));
+        return make_null();
+    }
+    event_loop_t* loop = require_event_loop(vm, "sleep");
+    return promise_result(vm, event_loop_sleep(loop, millis), "sleep");
+}
+
+// read_file_async(filename) - Promise of the file's contents as a buffer
+value_t builtin_read_file_async(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "read_file_async() takes exactly 1 argument (%d given)", arg_count);
+    }
+    if (args[0].type != VAL_STRING || !args[0].as.string) {
+        runtime_error(vm, "read_file_async() requires a string filename, not %s", value_class_name(args[0]));
+    }
+    event_loop_t* loop = require_event_loop(vm, "read_file_async");
+    return promise_result(vm, event_loop_read_file(loop, args[0].as.string), "read_file_async");
+}
+
+// write_file_async(buffer, filename) - Promise of whether the write succeeded
+value_t builtin_write_file_async(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) {
+        runtime_error(vm, "write_file_async() takes exactly 2 arguments (%d given)", arg_count);
+    }
+    if (args[0].type != VAL_BUFFER) {
+        runtime_error(vm, "write_file_async() requires a buffer as first argument, not %s", value_class_name(args[0]));
+    }
+    if (args[1].type != VAL_STRING || !args[1].as.string) {
+        runtime_error(vm, "write_file_async() requires a string filename, not %s", value_class_name(args[1]));
+    }
+    event_loop_t* loop = require_event_loop(vm, "write_file_async");
+    return promise_result(vm, event_loop_write_file(loop, args[0].as.buffer, args[1].as.string), "write_file_async");
+}
+
+// exec(command) - Run a shell command; promise of {status, output} (its standard output)
+value_t builtin_exec(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "exec() takes exactly 1 argument (%d given)", arg_count);
+    }
+    if (args[0].type != VAL_STRING || !args[0].as.string) {
+        runtime_error(vm, "exec() requires a string command, not %s", value_class_name(args[0]));
+    }
+    event_loop_t* loop = require_event_loop(vm, "exec");
+    return promise_result(vm, event_loop_exec(loop, args[0].as.string), "exec");
+}
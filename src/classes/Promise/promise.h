@@ -0,0 +1,28 @@
+#ifndef CLASS_PROMISE_H
+#define CLASS_PROMISE_H
+
+#include "vm.h"
+#include "value.h"
+
+// Promise Class Initialization
+void promise_class_init(vm_t* vm);
+
+// Promise Instance Methods
+value_t builtin_promise_is_pending(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_promise_is_fulfilled(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_promise_is_rejected(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_promise_value(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_promise_error(vm_t* vm, int arg_count, value_t* args);
+
+// Promise Static Methods
+value_t builtin_promise_all(vm_t* vm, int arg_count, value_t* args);
+
+// Asynchronous Functions (for global usage)
+value_t builtin_spawn(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_await(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_sleep(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_read_file_async(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_write_file_async(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_exec(vm_t* vm, int arg_count, value_t* args);
+
+#endif // CLASS_PROMISE_H
@@ -10,7 +10,7 @@ extern value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args);
 // Using centralized call_equals_method from vm/utilities.c
 
 // Global Range class storage
-value_t* global_range_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_range_class = NULL;
 
 // Initialize Range class with prototype and methods
 void range_class_init(vm_t* vm) {
@@ -58,7 +58,7 @@ void range_class_init(vm_t* vm) {
     do_set(vm->globals, "Range", &range_class, sizeof(value_t));
 
     // Store a global reference for use in make_range
-    static value_t range_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t range_class_storage;
     range_class_storage = vm_retain(range_class);
     global_range_class = &range_class_storage;
 }
@@ -156,6 +156,57 @@ value_t builtin_range_is_empty(vm_t* vm, int arg_count, value_t* args) {
     return make_boolean(0); // Not empty
 }
 
+// Number of elements in an all-int32 range (start, end and step must be VAL_INT32)
+int32_t range_int32_length(range_t* range) {
+    int32_t start_val = range->start.as.int32;
+    int32_t end_val = range->end.as.int32;
+    int32_t step_val = range->step.as.int32;
+    
+    // Handle edge cases
+    if (step_val == 0) {
+        return 0; // Should not happen due to validation, but safe fallback
+    }
+    
+    // Check if range direction matches step direction
+    if ((start_val < end_val && step_val < 0) || (start_val > end_val && step_val > 0)) {
+        return 0; // Empty range
+    }
+    
+    if (start_val == end_val) {
+        return range->exclusive ? 0 : 1;
+    }
+    
+    // Calculate number of steps
+    int32_t range_size;
+    if (range->exclusive) {
+        range_size = end_val - start_val;
+    } else {
+        range_size = end_val - start_val + (step_val > 0 ? 1 : -1);
+    }
+    
+    // Handle negative steps (for reverse ranges)
+    if (step_val < 0) {
+        range_size = -range_size;
+        step_val = -step_val;
+    }
+    
+    if (range_size <= 0) {
+        return 0;
+    }
+    
+    // Number of steps = ceil(range_size / step_val)
+    return (range_size + step_val - 1) / step_val;
+}
+
+// Element at position index of an all-int32 range; returns 0 if index is out of bounds
+int range_int32_at(range_t* range, int32_t index, int32_t* out) {
+    if (index < 0 || index >= range_int32_length(range)) {
+        return 0;
+    }
+    *out = (int32_t)((int64_t)range->start.as.int32 + (int64_t)index * range->step.as.int32);
+    return 1;
+}
+
 // range.length() - Number of elements in range
 value_t builtin_range_length(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count != 1) {
@@ -179,45 +230,7 @@ value_t builtin_range_length(vm_t* vm, int arg_count, value_t* args) {
     
     // For integer ranges with integer steps, calculate precisely
     if (range->start.type == VAL_INT32 && range->end.type == VAL_INT32 && range->step.type == VAL_INT32) {
-        int32_t start_val = range->start.as.int32;
-        int32_t end_val = range->end.as.int32;
-        int32_t step_val = range->step.as.int32;
-        
-        // Handle edge cases
-        if (step_val == 0) {
-            return make_int32(0); // Should not happen due to validation, but safe fallback
-        }
-        
-        // Check if range direction matches step direction
-        if ((start_val < end_val && step_val < 0) || (start_val > end_val && step_val > 0)) {
-            return make_int32(0); // Empty range
-        }
-        
-        if (start_val == end_val) {
-            return make_int32(range->exclusive ? 0 : 1);
-        }
-        
-        // Calculate number of steps
-        int32_t range_size;
-        if (range->exclusive) {
-            range_size = end_val - start_val;
-        } else {
-            range_size = end_val - start_val + (step_val > 0 ? 1 : -1);
-        }
-        
-        // Handle negative steps (for reverse ranges)
-        if (step_val < 0) {
-            range_size = -range_size;
-            step_val = -step_val;
-        }
-        
-        if (range_size <= 0) {
-            return make_int32(0);
-        }
-        
-        // Number of steps = ceil(range_size / step_val)
-        int32_t num_steps = (range_size + step_val - 1) / step_val;
-        return make_int32(num_steps);
+        return make_int32(range_int32_length(range));
     }
     
     // Fallback for non-integer types - use original logic with step 1
@@ -19,4 +19,8 @@ value_t builtin_range_reverse(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_range_hash(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_range_equals(vm_t* vm, int arg_count, value_t* args);
 
+// Int32 range helpers (start, end and step must all be VAL_INT32)
+int32_t range_int32_length(range_t* range);
+int range_int32_at(range_t* range, int32_t index, int32_t* out);
+
 #endif // CLASS_RANGE_H
\ No newline at end of file
@@ -22,9 +22,20 @@ value_t builtin_string_starts_with(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_string_ends_with(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_string_contains(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_string_replace(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_replace_all(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_string_index_of(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_last_index_of(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_count(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_split(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_lines(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_split_whitespace(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_string_parse_ints(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_string_is_empty(vm_t* vm, int arg_count, value_t* args);
 value_t builtin_string_non_empty(vm_t* vm, int arg_count, value_t* args);
 
+// Character (codepoint) at index as a one-character string, or null when out of range - shared by
+// str(i) in op_get_index and op_call
+value_t string_char_at(ds_string str, int32_t index);
+
 
 #endif // CLASS_STRING_H
\ No newline at end of file
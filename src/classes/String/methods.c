@@ -1,10 +1,13 @@
 #include "class_string.h"
 #include "builtins.h"
 #include "dynamic_string.h"
+#include "string_kernels.h"
+#include "../Number/number_parse.h"
+#include <stb_ds.h>
 #include <stdint.h>
+#include <string.h>
 
-// FNV-1a hash constants for 32-bit
-#define FNV_32_PRIME 0x01000193
+// FNV-1a offset basis: the hash of the empty string
 #define FNV_32_OFFSET_BASIS 0x811c9dc5
 
 // String method: hash
@@ -18,16 +21,8 @@ value_t builtin_string_hash(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "hash() can only be called on strings");
     }
 
-    // FNV-1a hash for strings
-    uint32_t hash = FNV_32_OFFSET_BASIS;
-    if (receiver.as.string) {
-        for (const char* p = receiver.as.string; *p; p++) {
-            hash ^= (uint8_t)*p;
-            hash *= FNV_32_PRIME;
-        }
-    }
-    
-    return make_int32((int32_t)hash);
+    // FNV-1a, computed once and then cached in the string's header
+    return make_int32(receiver.as.string ? (int32_t)ds_hash32(receiver.as.string) : (int32_t)FNV_32_OFFSET_BASIS);
 }
 
 // String method: equals(other) - Equality comparison for strings
@@ -56,8 +51,7 @@ value_t builtin_string_equals(vm_t* vm, int arg_count, value_t* args) {
         return make_boolean(0);
     }
     
-    // Content-based string comparison (ds_string works with strcmp)
-    return make_boolean(strcmp(receiver.as.string, other.as.string) == 0);
+    return make_boolean(ds_equals(receiver.as.string, other.as.string));
 }
 
 // String method: length
@@ -73,8 +67,8 @@ value_t builtin_string_length(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "length() can only be called on strings");
     }
 
-    // Get the length of the string
-    size_t length = ds_length(receiver.as.string);
+    // Characters, not bytes: O(1) for ASCII and after the first call otherwise
+    size_t length = ds_codepoint_length(receiver.as.string);
 
     // Return as int32 if it fits, otherwise as number
     if (length <= INT32_MAX) {
@@ -108,12 +102,41 @@ value_t builtin_string_substring(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "substring() arguments must be non-negative");
     }
 
-    size_t start = (size_t)start_int;
-    size_t length = (size_t)length_int;
+    // Character positions to byte offsets
+    ds_string str = receiver.as.string;
+    size_t start = ds_codepoint_offset(str, (size_t)start_int);
+    size_t end = ds_codepoint_offset(str, (size_t)start_int + (size_t)length_int);
 
-    // Create substring using dynamic_string
-    ds_string result = ds_substring(receiver.as.string, start, length);
-    
+    // The whole string is the string itself
+    if (start == 0 && end == ds_length(str)) {
+        return make_string_ds(ds_retain(str));
+    }
+
+    return make_string_ds(ds_substring(str, start, end - start));
+}
+
+value_t string_char_at(ds_string str, int32_t index) {
+    if (index < 0) {
+        return make_null();
+    }
+    size_t length = ds_length(str);
+    size_t start = ds_codepoint_offset(str, (size_t)index);
+    if (start == length) {
+        return make_null();
+    }
+    size_t width = ds_is_ascii(str) ? 1 : ds_codepoint_offset(str, (size_t)index + 1) - start;
+    return make_string_ds(ds_create_length(str + start, width));
+}
+
+// Same-length case mapping: the receiver itself when nothing changes
+static value_t map_case(ds_string str, int upper) {
+    size_t length = ds_length(str);
+    ds_string result = ds_new_uninit(length);
+    int changed = upper ? sk_to_upper(result, str, length) : sk_to_lower(result, str, length);
+    if (!changed) {
+        ds_release(&result);
+        return make_string_ds(ds_retain(str));
+    }
     return make_string_ds(result);
 }
 
@@ -128,8 +151,7 @@ value_t builtin_string_to_upper(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "toUpper() can only be called on strings");
     }
 
-    ds_string result = ds_to_upper(receiver.as.string);
-    return make_string_ds(result);
+    return map_case(receiver.as.string, 1);
 }
 
 // String method: toLower()
@@ -143,8 +165,7 @@ value_t builtin_string_to_lower(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "toLower() can only be called on strings");
     }
 
-    ds_string result = ds_to_lower(receiver.as.string);
-    return make_string_ds(result);
+    return map_case(receiver.as.string, 0);
 }
 
 // String method: trim()
@@ -158,8 +179,14 @@ value_t builtin_string_trim(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "trim() can only be called on strings");
     }
 
-    ds_string result = ds_trim(receiver.as.string);
-    return make_string_ds(result);
+    ds_string str = receiver.as.string;
+    size_t length = ds_length(str);
+    size_t start = sk_skip_space(str, length);
+    size_t end = start == length ? length : sk_skip_space_back(str, length);
+    if (start == 0 && end == length) {
+        return make_string_ds(ds_retain(str));
+    }
+    return make_string_ds(ds_substring(str, start, end - start));
 }
 
 // String method: startsWith(prefix)
@@ -178,7 +205,9 @@ value_t builtin_string_starts_with(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "startsWith() argument must be a string");
     }
 
-    bool result = ds_starts_with(receiver.as.string, prefix_val.as.string);
+    size_t prefix_length = ds_length(prefix_val.as.string);
+    bool result = prefix_length <= ds_length(receiver.as.string) &&
+                  memcmp(receiver.as.string, prefix_val.as.string, prefix_length) == 0;
     return make_boolean(result);
 }
 
@@ -198,10 +227,18 @@ value_t builtin_string_ends_with(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "endsWith() argument must be a string");
     }
 
-    bool result = ds_ends_with(receiver.as.string, suffix_val.as.string);
+    size_t length = ds_length(receiver.as.string);
+    size_t suffix_length = ds_length(suffix_val.as.string);
+    bool result = suffix_length <= length &&
+                  memcmp(receiver.as.string + length - suffix_length, suffix_val.as.string, suffix_length) == 0;
     return make_boolean(result);
 }
 
+// Byte offset of needle's first occurrence in str at or after from, or -1
+static ssize_t find_in(ds_string str, ds_string needle, size_t from) {
+    return sk_find(str, ds_length(str), needle, ds_length(needle), from);
+}
+
 // String method: contains(substring)
 value_t builtin_string_contains(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count != 2) { // receiver + 1 arg
@@ -218,11 +255,30 @@ value_t builtin_string_contains(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "contains() argument must be a string");
     }
 
-    bool result = ds_contains(receiver.as.string, substring_val.as.string);
-    return make_boolean(result);
+    return make_boolean(find_in(receiver.as.string, substring_val.as.string, 0) >= 0);
+}
+
+// Copies str with the old_length bytes at each of the match offsets replaced by replacement, in
+// a single allocation of the final size
+static ds_string splice_matches(ds_string str, const size_t* matches, size_t match_count, size_t old_length,
+                                ds_string replacement) {
+    size_t length = ds_length(str);
+    size_t new_length = ds_length(replacement);
+    ds_string result = ds_new_uninit(length - match_count * old_length + match_count * new_length);
+    char* out = result;
+    size_t copied = 0;
+    for (size_t i = 0; i < match_count; i++) {
+        memcpy(out, str + copied, matches[i] - copied);
+        out += matches[i] - copied;
+        memcpy(out, replacement, new_length);
+        out += new_length;
+        copied = matches[i] + old_length;
+    }
+    memcpy(out, str + copied, length - copied);
+    return result;
 }
 
-// String method: replace(old, new)
+// String method: replace(old, new) - replaces the first occurrence
 value_t builtin_string_replace(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count != 3) { // receiver + 2 args
         runtime_error(vm, "replace() takes exactly 2 arguments (%d given)", arg_count - 1);
@@ -239,7 +295,50 @@ value_t builtin_string_replace(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "replace() arguments must be strings");
     }
 
-    ds_string result = ds_replace(receiver.as.string, old_val.as.string, new_val.as.string);
+    ssize_t pos = find_in(receiver.as.string, old_val.as.string, 0);
+    if (pos < 0) {
+        return make_string_ds(ds_retain(receiver.as.string));
+    }
+    size_t match = (size_t)pos;
+    return make_string_ds(splice_matches(receiver.as.string, &match, 1, ds_length(old_val.as.string), new_val.as.string));
+}
+
+// String method: replaceAll(old, new) - replaces every non-overlapping occurrence, left to right.
+// An empty old string matches nothing.
+value_t builtin_string_replace_all(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 3) { // receiver + 2 args
+        runtime_error(vm, "replaceAll() takes exactly 2 arguments (%d given)", arg_count - 1);
+    }
+
+    value_t receiver = args[0];
+    value_t old_val = args[1];
+    value_t new_val = args[2];
+
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "replaceAll() can only be called on strings");
+    }
+    if (old_val.type != VAL_STRING || new_val.type != VAL_STRING) {
+        runtime_error(vm, "replaceAll() arguments must be strings");
+    }
+
+    ds_string str = receiver.as.string;
+    size_t old_length = ds_length(old_val.as.string);
+    if (old_length == 0) {
+        return make_string_ds(ds_retain(str));
+    }
+
+    // Find every match first so the result is allocated once at its final size
+    size_t* matches = NULL;
+    ssize_t pos = 0;
+    while ((pos = find_in(str, old_val.as.string, (size_t)pos)) >= 0) {
+        arrput(matches, (size_t)pos);
+        pos += (ssize_t)old_length;
+    }
+    if (!matches) {
+        return make_string_ds(ds_retain(str));
+    }
+    ds_string result = splice_matches(str, matches, (size_t)arrlen(matches), old_length, new_val.as.string);
+    arrfree(matches);
     return make_string_ds(result);
 }
 
@@ -259,13 +358,54 @@ value_t builtin_string_index_of(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "indexOf() argument must be a string");
     }
 
-    int result = ds_find(receiver.as.string, substring_val.as.string);
-    
-    if (result == -1) {
-        return make_int32(-1);
-    } else {
-        return make_int32(result);
+    ds_string str = receiver.as.string;
+    ssize_t found = find_in(str, substring_val.as.string, 0);
+    return make_int32(found < 0 ? -1 : (int32_t)ds_codepoint_index(str, (size_t)found));
+}
+
+// String method: lastIndexOf(substring) - an empty substring is found at the end
+value_t builtin_string_last_index_of(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) { // receiver + 1 arg
+        runtime_error(vm, "lastIndexOf() takes exactly 1 argument (%d given)", arg_count - 1);
     }
+
+    value_t receiver = args[0];
+    value_t substring_val = args[1];
+
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "lastIndexOf() can only be called on strings");
+    }
+    if (substring_val.type != VAL_STRING) {
+        runtime_error(vm, "lastIndexOf() argument must be a string");
+    }
+
+    ds_string str = receiver.as.string;
+    ds_string needle = substring_val.as.string;
+    ssize_t found = sk_find_last(str, ds_length(str), needle, ds_length(needle));
+    return make_int32(found < 0 ? -1 : (int32_t)ds_codepoint_index(str, (size_t)found));
+}
+
+// String method: count(substring) - non-overlapping occurrences; an empty substring counts 0,
+// matching replaceAll()
+value_t builtin_string_count(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) { // receiver + 1 arg
+        runtime_error(vm, "count() takes exactly 1 argument (%d given)", arg_count - 1);
+    }
+
+    value_t receiver = args[0];
+    value_t substring_val = args[1];
+
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "count() can only be called on strings");
+    }
+    if (substring_val.type != VAL_STRING) {
+        runtime_error(vm, "count() argument must be a string");
+    }
+
+    ds_string str = receiver.as.string;
+    size_t needle_length = ds_length(substring_val.as.string);
+    size_t count = needle_length ? sk_count(str, ds_length(str), substring_val.as.string, needle_length) : 0;
+    return make_int32((int32_t)count);
 }
 
 // String method: isEmpty()
@@ -296,4 +436,189 @@ value_t builtin_string_non_empty(vm_t* vm, int arg_count, value_t* args) {
 
     bool result = !ds_is_empty(receiver.as.string);
     return make_boolean(result);
-}
\ No newline at end of file
+}
+
+// Array of the given pieces of str, copied into pooled strings (see ds_slices); frees spans
+static value_t spans_to_array(ds_string str, ds_span* spans) {
+    size_t count = (size_t)arrlen(spans);
+    da_array array = da_new(sizeof(value_t));
+    if (count > 0) {
+        ds_string* pieces = malloc(count * sizeof(ds_string));
+        ds_slices(str, spans, count, pieces);
+        da_reserve(array, (int)count);
+        for (size_t i = 0; i < count; i++) {
+            value_t piece = make_string_ds(pieces[i]);
+            da_push(array, &piece);
+        }
+        free(pieces);
+    }
+    arrfree(spans);
+    return make_array(array);
+}
+
+// String method: split(separator) - the pieces between non-overlapping separators, empty ones
+// included; an empty separator splits into characters
+value_t builtin_string_split(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 2) { // receiver + 1 arg
+        runtime_error(vm, "split() takes exactly 1 argument (%d given)", arg_count - 1);
+    }
+
+    value_t receiver = args[0];
+    value_t separator_val = args[1];
+
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "split() can only be called on strings");
+    }
+    if (separator_val.type != VAL_STRING) {
+        runtime_error(vm, "split() argument must be a string");
+    }
+
+    ds_string str = receiver.as.string;
+    ds_string separator = separator_val.as.string;
+    size_t length = ds_length(str);
+    size_t separator_length = ds_length(separator);
+    ds_span* spans = NULL;
+
+    if (separator_length == 0) {
+        for (size_t pos = 0; pos < length;) {
+            unsigned char lead = (unsigned char)str[pos];
+            size_t width = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+            if (width > length - pos) width = length - pos;
+            arrput(spans, ((ds_span){pos, width}));
+            pos += width;
+        }
+        return spans_to_array(str, spans);
+    }
+
+    size_t pos = 0;
+    ssize_t found;
+    while ((found = sk_find(str, length, separator, separator_length, pos)) >= 0) {
+        arrput(spans, ((ds_span){pos, (size_t)found - pos}));
+        pos = (size_t)found + separator_length;
+    }
+    arrput(spans, ((ds_span){pos, length - pos}));
+    return spans_to_array(str, spans);
+}
+
+// String method: lines() - split on \n, dropping a \r before it and the empty piece after a final
+// newline
+value_t builtin_string_lines(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "lines() takes no arguments (%d given)", arg_count - 1);
+    }
+
+    value_t receiver = args[0];
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "lines() can only be called on strings");
+    }
+
+    ds_string str = receiver.as.string;
+    size_t length = ds_length(str);
+    ds_span* spans = NULL;
+    size_t pos = 0;
+    while (pos < length) {
+        ssize_t newline = sk_find(str, length, "\n", 1, pos);
+        size_t end = newline < 0 ? length : (size_t)newline;
+        size_t line_end = end > pos && str[end - 1] == '\r' ? end - 1 : end;
+        arrput(spans, ((ds_span){pos, line_end - pos}));
+        pos = end + 1;
+    }
+    return spans_to_array(str, spans);
+}
+
+// String method: splitWhitespace() - the runs of non-whitespace (ASCII or Unicode) characters
+value_t builtin_string_split_whitespace(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1) {
+        runtime_error(vm, "splitWhitespace() takes no arguments (%d given)", arg_count - 1);
+    }
+
+    value_t receiver = args[0];
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "splitWhitespace() can only be called on strings");
+    }
+
+    ds_string str = receiver.as.string;
+    size_t length = ds_length(str);
+    ds_span* spans = NULL;
+    size_t pos = sk_skip_space(str, length);
+    while (pos < length) {
+        size_t end = pos + sk_find_space(str + pos, length - pos);
+        arrput(spans, ((ds_span){pos, end - pos}));
+        pos = end + sk_skip_space(str + end, length - end);
+    }
+    return spans_to_array(str, spans);
+}
+
+// One parseInts() field, trimmed; runtime_error doesn't return, so the buffer is freed first
+static int32_t parse_int_field(vm_t* vm, const char* text, size_t length, int32_t* values) {
+    size_t start = sk_skip_space(text, length);
+    size_t end = start + sk_skip_space_back(text + start, length - start);
+    np_number number;
+    np_kind kind = np_parse(text + start, end - start, NP_INTEGER_ONLY, &number);
+    if (kind == NP_INT32) {
+        return number.as.int32;
+    }
+    arrfree(values);
+    if (kind == NP_BIGINT) {
+        di_release(&number.as.bigint);
+        runtime_error(vm, "parseInts() value '%.*s' is out of Int32 range", (int)(end - start), text + start);
+    }
+    runtime_error(vm, "parseInts() field '%.*s' is not a valid integer", (int)(end - start), text + start);
+    return 0;
+}
+
+// String method: parseInts(separator?) - the integers in the string as an Int32Array, read straight
+// from its bytes without a string per field. Fields are separated by whitespace, or by separator
+// when given, and trimmed; a trailing empty field (after a final separator) is ignored.
+value_t builtin_string_parse_ints(vm_t* vm, int arg_count, value_t* args) {
+    if (arg_count != 1 && arg_count != 2) {
+        runtime_error(vm, "parseInts() takes 0 or 1 arguments (%d given)", arg_count - 1);
+    }
+
+    value_t receiver = args[0];
+    if (receiver.type != VAL_STRING) {
+        runtime_error(vm, "parseInts() can only be called on strings");
+    }
+    if (arg_count == 2 && (args[1].type != VAL_STRING || ds_length(args[1].as.string) == 0)) {
+        runtime_error(vm, "parseInts() separator must be a non-empty string");
+    }
+
+    ds_string str = receiver.as.string;
+    size_t length = ds_length(str);
+    int32_t* values = NULL;
+    if (arg_count == 1) {
+        size_t pos = sk_skip_space(str, length);
+        while (pos < length) {
+            size_t end = pos + sk_find_space(str + pos, length - pos);
+            int32_t value = parse_int_field(vm, str + pos, end - pos, values);
+            arrput(values, value);
+            pos = end + sk_skip_space(str + end, length - end);
+        }
+    } else {
+        ds_string separator = args[1].as.string;
+        size_t separator_length = ds_length(separator);
+        size_t pos = 0;
+        ssize_t found;
+        while ((found = sk_find(str, length, separator, separator_length, pos)) >= 0) {
+            int32_t value = parse_int_field(vm, str + pos, (size_t)found - pos, values);
+            arrput(values, value);
+            pos = (size_t)found + separator_length;
+        }
+        if (sk_skip_space(str + pos, length - pos) < length - pos) {
+            int32_t value = parse_int_field(vm, str + pos, length - pos, values);
+            arrput(values, value);
+        }
+    }
+
+    size_t count = (size_t)arrlen(values);
+    typed_array_t* array = typed_array_create(TYPED_INT32, count);
+    if (!array) {
+        arrfree(values);
+        runtime_error(vm, "parseInts() failed: out of memory");
+    }
+    if (count > 0) {
+        memcpy(array->data.i32, values, count * sizeof(int32_t));
+    }
+    arrfree(values);
+    return make_typed_array(array);
+}
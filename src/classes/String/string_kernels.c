@@ -0,0 +1,684 @@
+#include "string_kernels.h"
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SK_X86 1
+#include <immintrin.h>
+// AVX2 versions are compiled for AVX2 regardless of the build flags and only run when the CPU has it
+#define SK_AVX2_FN __attribute__((target("avx2")))
+#endif
+
+// ---------------------------------------------------------------------------------------------
+// UTF-8 and the case and whitespace tables
+// ---------------------------------------------------------------------------------------------
+
+// Length of the well-formed UTF-8 sequence at text (0 if there isn't one), storing its code point
+static size_t decode_utf8(const unsigned char* text, size_t length, uint32_t* codepoint) {
+    unsigned c = text[0];
+    if (c < 0x80) {
+        *codepoint = c;
+        return 1;
+    }
+    if (c >= 0xC2 && c <= 0xDF) {
+        if (length < 2 || (text[1] & 0xC0) != 0x80) return 0;
+        *codepoint = ((c & 0x1Fu) << 6) | (text[1] & 0x3Fu);
+        return 2;
+    }
+    if (c >= 0xE0 && c <= 0xEF) {
+        if (length < 3 || (text[1] & 0xC0) != 0x80 || (text[2] & 0xC0) != 0x80) return 0;
+        uint32_t value = ((c & 0x0Fu) << 12) | ((text[1] & 0x3Fu) << 6) | (text[2] & 0x3Fu);
+        if (value < 0x800 || (value >= 0xD800 && value <= 0xDFFF)) return 0;
+        *codepoint = value;
+        return 3;
+    }
+    if (c >= 0xF0 && c <= 0xF4) {
+        if (length < 4 || (text[1] & 0xC0) != 0x80 || (text[2] & 0xC0) != 0x80 || (text[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        uint32_t value = ((c & 0x07u) << 18) | ((text[1] & 0x3Fu) << 12) | ((text[2] & 0x3Fu) << 6) | (text[3] & 0x3Fu);
+        if (value < 0x10000 || value > 0x10FFFF) return 0;
+        *codepoint = value;
+        return 4;
+    }
+    return 0;
+}
+
+// Writes a 2 or 3 byte sequence; case mapping never changes a character's encoded length
+static void encode_utf8(char* dst, uint32_t codepoint, size_t width) {
+    if (width == 2) {
+        dst[0] = (char)(0xC0 | (codepoint >> 6));
+        dst[1] = (char)(0x80 | (codepoint & 0x3F));
+    } else {
+        dst[0] = (char)(0xE0 | (codepoint >> 12));
+        dst[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));
+        dst[2] = (char)(0x80 | (codepoint & 0x3F));
+    }
+}
+
+// Blocks where upper and lower case alternate: upper_even says the upper case letter of each pair
+// sits at the even code point
+static int in_pair_block(uint32_t c, int* upper_even) {
+    if ((c >= 0x100 && c <= 0x12F) || (c >= 0x132 && c <= 0x137) || (c >= 0x14A && c <= 0x177) ||
+        (c >= 0x460 && c <= 0x481) || (c >= 0x48A && c <= 0x4BF) || (c >= 0x4D0 && c <= 0x52F) ||
+        (c >= 0x1E00 && c <= 0x1E95) || (c >= 0x1EA0 && c <= 0x1EFF)) {
+        *upper_even = 1;
+        return 1;
+    }
+    if ((c >= 0x139 && c <= 0x148) || (c >= 0x179 && c <= 0x17E) || (c >= 0x4C1 && c <= 0x4CE)) {
+        *upper_even = 0;
+        return 1;
+    }
+    return 0;
+}
+
+static uint32_t upper_of(uint32_t c) {
+    int upper_even;
+    if (in_pair_block(c, &upper_even)) {
+        return (c & 1) == (uint32_t)upper_even ? c - 1 : c;
+    }
+    if (c >= 0xE0 && c <= 0xFE && c != 0xF7) return c - 32;
+    if (c >= 0x3B1 && c <= 0x3CB) return c == 0x3C2 ? 0x3A3 : c - 32;
+    if (c >= 0x430 && c <= 0x44F) return c - 32;
+    if (c >= 0x450 && c <= 0x45F) return c - 80;
+    if (c >= 0x561 && c <= 0x586) return c - 48;
+    if (c >= 0xFF41 && c <= 0xFF5A) return c - 32;
+    switch (c) {
+    case 0xB5: return 0x39C;
+    case 0xFF: return 0x178;
+    case 0x3AC: return 0x386;
+    case 0x3AD: case 0x3AE: case 0x3AF: return c - 37;
+    case 0x3CC: return 0x38C;
+    case 0x3CD: case 0x3CE: return c - 63;
+    default: return c;
+    }
+}
+
+static uint32_t lower_of(uint32_t c) {
+    int upper_even;
+    if (in_pair_block(c, &upper_even)) {
+        return (c & 1) != (uint32_t)upper_even ? c + 1 : c;
+    }
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return c + 32;
+    if (c >= 0x391 && c <= 0x3AB && c != 0x3A2) return c + 32;
+    if (c >= 0x400 && c <= 0x40F) return c + 80;
+    if (c >= 0x410 && c <= 0x42F) return c + 32;
+    if (c >= 0x531 && c <= 0x556) return c + 48;
+    if (c >= 0xFF21 && c <= 0xFF3A) return c + 32;
+    switch (c) {
+    case 0x178: return 0xFF;
+    case 0x386: return 0x3AC;
+    case 0x388: case 0x389: case 0x38A: return c + 37;
+    case 0x38C: return 0x3CC;
+    case 0x38E: case 0x38F: return c + 63;
+    default: return c;
+    }
+}
+
+static int is_ascii_space(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Byte length of the non-ASCII White_Space character at text, or 0
+static size_t unicode_space_length(const char* text, size_t length) {
+    uint32_t c;
+    size_t width = decode_utf8((const unsigned char*)text, length, &c);
+    if (width < 2) return 0;
+    int space = c == 0x85 || c == 0xA0 || c == 0x1680 || (c >= 0x2000 && c <= 0x200A) || c == 0x2028 ||
+                c == 0x2029 || c == 0x202F || c == 0x205F || c == 0x3000;
+    return space ? width : 0;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Scalar versions: the whole job on other targets, and what's left (from `i`) after the vector
+// loops everywhere else
+// ---------------------------------------------------------------------------------------------
+
+static int matches_at(const char* at, const char* needle, size_t needle_length) {
+    return at[0] == needle[0] && at[needle_length - 1] == needle[needle_length - 1] &&
+           memcmp(at, needle, needle_length) == 0;
+}
+
+static ssize_t find_tail(const char* haystack, size_t length, const char* needle, size_t needle_length, size_t i) {
+    for (; i + needle_length <= length; i++) {
+        if (matches_at(haystack + i, needle, needle_length)) return (ssize_t)i;
+    }
+    return -1;
+}
+
+// Candidates below end, from the top
+static ssize_t find_last_tail(const char* haystack, const char* needle, size_t needle_length, size_t end) {
+    while (end-- > 0) {
+        if (matches_at(haystack + end, needle, needle_length)) return (ssize_t)end;
+    }
+    return -1;
+}
+
+static size_t count_byte_tail(const char* text, size_t length, char c, size_t i) {
+    size_t count = 0;
+    for (; i < length; i++) {
+        count += text[i] == c;
+    }
+    return count;
+}
+
+static size_t skip_space_tail(const char* text, size_t length, size_t i) {
+    while (i < length && is_ascii_space((unsigned char)text[i])) i++;
+    return i;
+}
+
+// Stops at whitespace or any non-ASCII byte, which may start a Unicode space
+static size_t find_space_tail(const char* text, size_t length, size_t i) {
+    while (i < length && !is_ascii_space((unsigned char)text[i]) && (unsigned char)text[i] < 0x80) i++;
+    return i;
+}
+
+static size_t skip_space_back_tail(const char* text, size_t end) {
+    while (end > 0 && is_ascii_space((unsigned char)text[end - 1])) end--;
+    return end;
+}
+
+// Maps ASCII bytes from i up to the first non-ASCII one, returning its offset
+static size_t map_ascii_tail(char* dst, const char* text, size_t length, size_t i, int upper, int* changed) {
+    char low = upper ? 'a' : 'A';
+    for (; i < length && (unsigned char)text[i] < 0x80; i++) {
+        char c = text[i];
+        if (c >= low && c <= low + 25) {
+            c ^= 0x20;
+            *changed = 1;
+        }
+        dst[i] = c;
+    }
+    return i;
+}
+
+// Two-way string matching (Crochemore and Perrin) with a last-byte shift table, for long needles
+static ssize_t find_two_way(const char* haystack, size_t length, const char* needle_chars, size_t needle_length,
+                            size_t from) {
+    const unsigned char* needle = (const unsigned char*)needle_chars;
+    const unsigned char* h = (const unsigned char*)haystack + from;
+    const unsigned char* end = (const unsigned char*)haystack + length;
+    size_t l = needle_length;
+    size_t byteset[256 / (8 * sizeof(size_t))] = {0};
+    size_t shift[256];
+#define SK_BIT(set, b) ((set)[(size_t)(b) / (8 * sizeof(size_t))] & ((size_t)1 << ((size_t)(b) % (8 * sizeof(size_t)))))
+    for (size_t i = 0; i < l; i++) {
+        byteset[needle[i] / (8 * sizeof(size_t))] |= (size_t)1 << (needle[i] % (8 * sizeof(size_t)));
+        shift[needle[i]] = i + 1;
+    }
+
+    // Critical factorization: the larger of the maximal suffixes under both byte orders
+    size_t ip = (size_t)-1, jp = 0, k = 1, p = 1;
+    while (jp + k < l) {
+        if (needle[ip + k] == needle[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (needle[ip + k] > needle[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    size_t ms = ip, p0 = p;
+
+    ip = (size_t)-1, jp = 0, k = p = 1;
+    while (jp + k < l) {
+        if (needle[ip + k] == needle[jp + k]) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (needle[ip + k] < needle[jp + k]) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    if (ip + 1 > ms + 1) {
+        ms = ip;
+    } else {
+        p = p0;
+    }
+
+    // A periodic needle remembers how much of the last match attempt is known to agree
+    size_t mem0;
+    if (memcmp(needle, needle + p, ms + 1)) {
+        mem0 = 0;
+        p = (ms > l - ms - 1 ? ms : l - ms - 1) + 1;
+    } else {
+        mem0 = l - p;
+    }
+    size_t mem = 0;
+
+    for (;;) {
+        if ((size_t)(end - h) < l) return -1;
+
+        unsigned char tail = h[l - 1];
+        if (SK_BIT(byteset, tail)) {
+            k = l - shift[tail];
+            if (k) {
+                if (k < mem) k = mem;
+                h += k;
+                mem = 0;
+                continue;
+            }
+        } else {
+            h += l;
+            mem = 0;
+            continue;
+        }
+
+        for (k = (ms + 1 > mem ? ms + 1 : mem); k < l && needle[k] == h[k]; k++);
+        if (k < l) {
+            h += k - ms;
+            mem = 0;
+            continue;
+        }
+        for (k = ms + 1; k > mem && needle[k - 1] == h[k - 1]; k--);
+        if (k <= mem) return (ssize_t)(h - (const unsigned char*)haystack);
+        h += p;
+        mem = mem0;
+    }
+#undef SK_BIT
+}
+
+#ifdef SK_X86
+
+// ---------------------------------------------------------------------------------------------
+// SSE2 (always available on x86-64)
+// ---------------------------------------------------------------------------------------------
+
+// Each block tests 16 candidate positions on the needle's first and last bytes at once
+static ssize_t find_sse2(const char* haystack, size_t length, const char* needle, size_t needle_length, size_t i) {
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[needle_length - 1]);
+    for (; i + needle_length - 1 + 16 <= length; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(haystack + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(haystack + i + needle_length - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+        while (mask) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            if (needle_length <= 2 || memcmp(haystack + at + 1, needle + 1, needle_length - 2) == 0) {
+                return (ssize_t)at;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_tail(haystack, length, needle, needle_length, i);
+}
+
+static ssize_t find_last_sse2(const char* haystack, size_t length, const char* needle, size_t needle_length) {
+    __m128i first = _mm_set1_epi8(needle[0]);
+    __m128i last = _mm_set1_epi8(needle[needle_length - 1]);
+    size_t end = length - needle_length + 1;
+    for (; end >= 16; end -= 16) {
+        size_t j = end - 16;
+        __m128i a = _mm_loadu_si128((const __m128i*)(haystack + j));
+        __m128i b = _mm_loadu_si128((const __m128i*)(haystack + j + needle_length - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+        while (mask) {
+            unsigned bit = 31u - (unsigned)__builtin_clz(mask);
+            if (needle_length <= 2 || memcmp(haystack + j + bit + 1, needle + 1, needle_length - 2) == 0) {
+                return (ssize_t)(j + bit);
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+    return find_last_tail(haystack, needle, needle_length, end);
+}
+
+static size_t count_byte_sse2(const char* text, size_t length, char c) {
+    __m128i target = _mm_set1_epi8(c);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(text + i));
+        count += (size_t)__builtin_popcount((unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, target)));
+    }
+    return count + count_byte_tail(text, length, c, i);
+}
+
+// Lanes holding ' ' or \t..\r: (c - 9) saturating-minus 4 is zero only for those control bytes
+static unsigned space_mask_sse2(__m128i v) {
+    __m128i space = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+    __m128i control = _mm_subs_epu8(_mm_sub_epi8(v, _mm_set1_epi8('\t')), _mm_set1_epi8(4));
+    control = _mm_cmpeq_epi8(control, _mm_setzero_si128());
+    return (unsigned)_mm_movemask_epi8(_mm_or_si128(space, control));
+}
+
+static size_t skip_space_sse2(const char* text, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        unsigned mask = space_mask_sse2(_mm_loadu_si128((const __m128i*)(text + i)));
+        if (mask != 0xFFFF) return i + (size_t)__builtin_ctz(~mask);
+    }
+    return skip_space_tail(text, length, i);
+}
+
+static size_t find_space_sse2(const char* text, size_t length, size_t i) {
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(text + i));
+        unsigned mask = space_mask_sse2(v) | (unsigned)_mm_movemask_epi8(v);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    return find_space_tail(text, length, i);
+}
+
+static size_t skip_space_back_sse2(const char* text, size_t end) {
+    for (; end >= 16; end -= 16) {
+        unsigned mask = space_mask_sse2(_mm_loadu_si128((const __m128i*)(text + end - 16)));
+        if (mask != 0xFFFF) return end - 16 + (32u - (unsigned)__builtin_clz(~mask & 0xFFFFu));
+    }
+    return skip_space_back_tail(text, end);
+}
+
+static size_t map_ascii_sse2(char* dst, const char* text, size_t length, size_t i, int upper, int* changed) {
+    __m128i below = _mm_set1_epi8(upper ? 'a' - 1 : 'A' - 1);
+    __m128i above = _mm_set1_epi8(upper ? 'z' + 1 : 'Z' + 1);
+    __m128i flip = _mm_set1_epi8(0x20);
+    unsigned any = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(text + i));
+        if (_mm_movemask_epi8(v)) break; // Non-ASCII somewhere in the block
+        __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+        any |= (unsigned)_mm_movemask_epi8(letter);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(v, _mm_and_si128(letter, flip)));
+    }
+    if (any) *changed = 1;
+    return map_ascii_tail(dst, text, length, i, upper, changed);
+}
+
+// ---------------------------------------------------------------------------------------------
+// AVX2
+// ---------------------------------------------------------------------------------------------
+
+SK_AVX2_FN static ssize_t find_avx2(const char* haystack, size_t length, const char* needle, size_t needle_length,
+                                    size_t i) {
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[needle_length - 1]);
+    // 64 candidates per iteration; the 32-wide loop below only finishes the end
+    for (; i + needle_length - 1 + 64 <= length; i += 64) {
+        const char* at = haystack + i;
+        __m256i a0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)at), first);
+        __m256i a1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(at + 32)), first);
+        __m256i b0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(at + needle_length - 1)), last);
+        __m256i b1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(at + needle_length + 31)), last);
+        uint64_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(a0, b0)) |
+                        (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_and_si256(a1, b1)) << 32;
+        while (mask) {
+            size_t candidate = i + (size_t)__builtin_ctzll(mask);
+            if (needle_length <= 2 || memcmp(haystack + candidate + 1, needle + 1, needle_length - 2) == 0) {
+                return (ssize_t)candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    for (; i + needle_length - 1 + 32 <= length; i += 32) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(haystack + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(haystack + i + needle_length - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                                                        _mm256_cmpeq_epi8(b, last)));
+        while (mask) {
+            size_t at = i + (size_t)__builtin_ctz(mask);
+            if (needle_length <= 2 || memcmp(haystack + at + 1, needle + 1, needle_length - 2) == 0) {
+                return (ssize_t)at;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return find_sse2(haystack, length, needle, needle_length, i);
+}
+
+SK_AVX2_FN static ssize_t find_last_avx2(const char* haystack, size_t length, const char* needle,
+                                         size_t needle_length) {
+    __m256i first = _mm256_set1_epi8(needle[0]);
+    __m256i last = _mm256_set1_epi8(needle[needle_length - 1]);
+    size_t end = length - needle_length + 1;
+    for (; end >= 32; end -= 32) {
+        size_t j = end - 32;
+        __m256i a = _mm256_loadu_si256((const __m256i*)(haystack + j));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(haystack + j + needle_length - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first),
+                                                                        _mm256_cmpeq_epi8(b, last)));
+        while (mask) {
+            unsigned bit = 31u - (unsigned)__builtin_clz(mask);
+            if (needle_length <= 2 || memcmp(haystack + j + bit + 1, needle + 1, needle_length - 2) == 0) {
+                return (ssize_t)(j + bit);
+            }
+            mask &= ~(1u << bit);
+        }
+    }
+    return find_last_tail(haystack, needle, needle_length, end);
+}
+
+SK_AVX2_FN static size_t count_byte_avx2(const char* text, size_t length, char c) {
+    __m256i target = _mm256_set1_epi8(c);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(text + i));
+        count += (size_t)__builtin_popcount((unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, target)));
+    }
+    return count + count_byte_tail(text, length, c, i);
+}
+
+SK_AVX2_FN static unsigned space_mask_avx2(__m256i v) {
+    __m256i space = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+    __m256i control = _mm256_subs_epu8(_mm256_sub_epi8(v, _mm256_set1_epi8('\t')), _mm256_set1_epi8(4));
+    control = _mm256_cmpeq_epi8(control, _mm256_setzero_si256());
+    return (unsigned)_mm256_movemask_epi8(_mm256_or_si256(space, control));
+}
+
+SK_AVX2_FN static size_t skip_space_avx2(const char* text, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        unsigned mask = space_mask_avx2(_mm256_loadu_si256((const __m256i*)(text + i)));
+        if (mask != 0xFFFFFFFFu) return i + (size_t)__builtin_ctz(~mask);
+    }
+    return skip_space_tail(text, length, i);
+}
+
+SK_AVX2_FN static size_t find_space_avx2(const char* text, size_t length, size_t i) {
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(text + i));
+        unsigned mask = space_mask_avx2(v) | (unsigned)_mm256_movemask_epi8(v);
+        if (mask) return i + (size_t)__builtin_ctz(mask);
+    }
+    return find_space_tail(text, length, i);
+}
+
+SK_AVX2_FN static size_t skip_space_back_avx2(const char* text, size_t end) {
+    for (; end >= 32; end -= 32) {
+        unsigned mask = space_mask_avx2(_mm256_loadu_si256((const __m256i*)(text + end - 32)));
+        if (mask != 0xFFFFFFFFu) return end - 32 + (32u - (unsigned)__builtin_clz(~mask));
+    }
+    return skip_space_back_tail(text, end);
+}
+
+SK_AVX2_FN static size_t map_ascii_avx2(char* dst, const char* text, size_t length, size_t i, int upper,
+                                        int* changed) {
+    __m256i below = _mm256_set1_epi8(upper ? 'a' - 1 : 'A' - 1);
+    __m256i above = _mm256_set1_epi8(upper ? 'z' + 1 : 'Z' + 1);
+    __m256i flip = _mm256_set1_epi8(0x20);
+    unsigned any = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(text + i));
+        if (_mm256_movemask_epi8(v)) break;
+        __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(v, below), _mm256_cmpgt_epi8(above, v));
+        any |= (unsigned)_mm256_movemask_epi8(letter);
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(v, _mm256_and_si256(letter, flip)));
+    }
+    if (any) *changed = 1;
+    return map_ascii_sse2(dst, text, length, i, upper, changed);
+}
+
+#endif // SK_X86
+
+// ---------------------------------------------------------------------------------------------
+// Dispatch
+// ---------------------------------------------------------------------------------------------
+
+ssize_t sk_find(const char* haystack, size_t length, const char* needle, size_t needle_length, size_t from) {
+    if (from > length) return -1;
+    if (needle_length == 0) return (ssize_t)from;
+    if (needle_length > length - from) return -1;
+    if (needle_length >= SK_TWO_WAY_MIN) {
+        return find_two_way(haystack, length, needle, needle_length, from);
+    }
+#ifdef SK_X86
+    switch (tk_get_level()) {
+    case TK_AVX2: return find_avx2(haystack, length, needle, needle_length, from);
+    case TK_SSE2: return find_sse2(haystack, length, needle, needle_length, from);
+    default: break;
+    }
+#endif
+    return find_tail(haystack, length, needle, needle_length, from);
+}
+
+ssize_t sk_find_last(const char* haystack, size_t length, const char* needle, size_t needle_length) {
+    if (needle_length == 0) return (ssize_t)length;
+    if (needle_length > length) return -1;
+#ifdef SK_X86
+    switch (tk_get_level()) {
+    case TK_AVX2: return find_last_avx2(haystack, length, needle, needle_length);
+    case TK_SSE2: return find_last_sse2(haystack, length, needle, needle_length);
+    default: break;
+    }
+#endif
+    return find_last_tail(haystack, needle, needle_length, length - needle_length + 1);
+}
+
+size_t sk_count(const char* haystack, size_t length, const char* needle, size_t needle_length) {
+    if (needle_length == 1) {
+#ifdef SK_X86
+        switch (tk_get_level()) {
+        case TK_AVX2: return count_byte_avx2(haystack, length, needle[0]);
+        case TK_SSE2: return count_byte_sse2(haystack, length, needle[0]);
+        default: break;
+        }
+#endif
+        return count_byte_tail(haystack, length, needle[0], 0);
+    }
+    size_t count = 0;
+    ssize_t at = 0;
+    while ((at = sk_find(haystack, length, needle, needle_length, (size_t)at)) >= 0) {
+        count++;
+        at += (ssize_t)needle_length;
+    }
+    return count;
+}
+
+static size_t skip_ascii_space(const char* text, size_t length) {
+#ifdef SK_X86
+    switch (tk_get_level()) {
+    case TK_AVX2: return skip_space_avx2(text, length);
+    case TK_SSE2: return skip_space_sse2(text, length);
+    default: break;
+    }
+#endif
+    return skip_space_tail(text, length, 0);
+}
+
+static size_t skip_ascii_space_back(const char* text, size_t end) {
+#ifdef SK_X86
+    switch (tk_get_level()) {
+    case TK_AVX2: return skip_space_back_avx2(text, end);
+    case TK_SSE2: return skip_space_back_sse2(text, end);
+    default: break;
+    }
+#endif
+    return skip_space_back_tail(text, end);
+}
+
+size_t sk_skip_space(const char* text, size_t length) {
+    size_t i = 0;
+    for (;;) {
+        i += skip_ascii_space(text + i, length - i);
+        size_t width = i < length && (unsigned char)text[i] >= 0x80 ? unicode_space_length(text + i, length - i) : 0;
+        if (!width) return i;
+        i += width;
+    }
+}
+
+size_t sk_skip_space_back(const char* text, size_t length) {
+    size_t end = length;
+    for (;;) {
+        end = skip_ascii_space_back(text, end);
+        if (end == 0 || (unsigned char)text[end - 1] < 0x80) return end;
+        // Back up to the lead byte of the last character
+        size_t start = end - 1;
+        while (start > 0 && end - start < 4 && ((unsigned char)text[start] & 0xC0) == 0x80) start--;
+        if (unicode_space_length(text + start, end - start) != end - start) return end;
+        end = start;
+    }
+}
+
+size_t sk_find_space(const char* text, size_t length) {
+    size_t i = 0;
+    for (;;) {
+#ifdef SK_X86
+        switch (tk_get_level()) {
+        case TK_AVX2: i = find_space_avx2(text, length, i); break;
+        case TK_SSE2: i = find_space_sse2(text, length, i); break;
+        default: i = find_space_tail(text, length, i); break;
+        }
+#else
+        i = find_space_tail(text, length, i);
+#endif
+        if (i >= length || (unsigned char)text[i] < 0x80 || unicode_space_length(text + i, length - i)) return i;
+        i++; // Some other non-ASCII byte
+    }
+}
+
+static int map_case(char* dst, const char* text, size_t length, int upper) {
+    int changed = 0;
+    size_t i = 0;
+    while (i < length) {
+#ifdef SK_X86
+        switch (tk_get_level()) {
+        case TK_AVX2: i = map_ascii_avx2(dst, text, length, i, upper, &changed); break;
+        case TK_SSE2: i = map_ascii_sse2(dst, text, length, i, upper, &changed); break;
+        default: i = map_ascii_tail(dst, text, length, i, upper, &changed); break;
+        }
+#else
+        i = map_ascii_tail(dst, text, length, i, upper, &changed);
+#endif
+        if (i >= length) break;
+
+        uint32_t c;
+        size_t width = decode_utf8((const unsigned char*)text + i, length - i, &c);
+        if (!width) {
+            dst[i] = text[i]; // Not UTF-8: copied as is
+            i++;
+            continue;
+        }
+        uint32_t mapped = upper ? upper_of(c) : lower_of(c);
+        if (mapped != c) {
+            encode_utf8(dst + i, mapped, width);
+            changed = 1;
+        } else {
+            memcpy(dst + i, text + i, width);
+        }
+        i += width;
+    }
+    return changed;
+}
+
+int sk_to_upper(char* dst, const char* text, size_t length) {
+    return map_case(dst, text, length, 1);
+}
+
+int sk_to_lower(char* dst, const char* text, size_t length) {
+    return map_case(dst, text, length, 0);
+}
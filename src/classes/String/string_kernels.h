@@ -0,0 +1,43 @@
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "../TypedArray/kernels.h"
+
+// Byte-level kernels behind String's search, replace, trim and case methods.
+//
+// Like the TypedArray kernels each has AVX2, SSE2 and scalar paths, picked per call from
+// tk_get_level(), so SLATE_SIMD caps these too. Everything works on byte lengths, never on NUL
+// terminators, and positions are byte offsets.
+//
+// Substring search filters candidates 16 or 32 positions at a time by the needle's first and last
+// bytes and only then compares the rest. Needles of SK_TWO_WAY_MIN bytes or more use the two-way
+// algorithm instead, which never looks at a haystack byte more than a few times, however
+// repetitive the text.
+
+#define SK_TWO_WAY_MIN 32
+
+// First occurrence of needle at or after from; -1 if none. An empty needle matches at from.
+ssize_t sk_find(const char* haystack, size_t length, const char* needle, size_t needle_length, size_t from);
+
+// Last occurrence of needle; -1 if none. An empty needle matches at length.
+ssize_t sk_find_last(const char* haystack, size_t length, const char* needle, size_t needle_length);
+
+// Non-overlapping occurrences of needle, scanning left to right (needle_length > 0)
+size_t sk_count(const char* haystack, size_t length, const char* needle, size_t needle_length);
+
+// Whitespace is ASCII space, \t, \n, \v, \f, \r and the Unicode White_Space code points
+size_t sk_skip_space(const char* text, size_t length);     // Offset of the first non-whitespace character
+size_t sk_skip_space_back(const char* text, size_t length); // Length without trailing whitespace
+size_t sk_find_space(const char* text, size_t length);       // Offset of the first whitespace character, or length
+
+// Simple (one-to-one) case mapping of UTF-8 text into dst, which must have room for length bytes:
+// ASCII, Latin-1, Latin Extended-A and Additional, Greek, Cyrillic, Armenian and fullwidth Latin.
+// Every mapping keeps its UTF-8 length, and bytes that aren't valid UTF-8 are copied unchanged.
+// Returns whether any character changed.
+int sk_to_upper(char* dst, const char* text, size_t length);
+int sk_to_lower(char* dst, const char* text, size_t length);
+
+#endif // STRING_KERNELS_H
@@ -3,9 +3,10 @@
 #include "dynamic_string.h"
 #include "dynamic_object.h"
 #include "class_string.h"
+#include "number_format.h"
 
 // Global StringBuilder class storage
-value_t* global_string_builder_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_string_builder_class = NULL;
 
 // Initialize StringBuilder class with prototype and methods
 void string_builder_class_init(vm_t* vm) {
@@ -44,7 +45,7 @@ void string_builder_class_init(vm_t* vm) {
     do_set(vm->globals, "StringBuilder", &string_builder_class, sizeof(value_t));
 
     // Store a global reference for use in make_string_builder
-    static value_t string_builder_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t string_builder_class_storage;
     string_builder_class_storage = vm_retain(string_builder_class);
     global_string_builder_class = &string_builder_class_storage;
 }
@@ -78,7 +79,7 @@ value_t string_builder_factory(vm_t* vm, class_t* self, int arg_count, value_t*
     for (int i = string_arg_start; i < arg_count; i++) {
         if (args[i].type != VAL_STRING) {
             ds_builder_release(&builder);
-            runtime_error(vm, "StringBuilder() string arguments must be strings, not %s", value_type_name(args[i].type));
+            runtime_error(vm, "StringBuilder() string arguments must be strings, not %s", value_class_name(args[i]));
             return make_null();
         }
         
@@ -101,10 +102,23 @@ value_t builtin_string_builder_append(vm_t* vm, int arg_count, value_t* args) {
     value_t str_val = args[1];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "append() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "append() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
+    // Numbers are formatted straight into the builder's buffer
+    ds_builder builder = receiver.as.string_builder;
+    if (str_val.type == VAL_INT32) {
+        ds_builder_commit(builder, nf_format_int32(ds_builder_reserve(builder, NF_MAX_LENGTH), str_val.as.int32));
+        return receiver;
+    } else if (str_val.type == VAL_FLOAT64) {
+        ds_builder_commit(builder, nf_format_float64(ds_builder_reserve(builder, NF_MAX_LENGTH), str_val.as.float64));
+        return receiver;
+    } else if (str_val.type == VAL_FLOAT32) {
+        ds_builder_commit(builder, nf_format_float32(ds_builder_reserve(builder, NF_MAX_LENGTH), str_val.as.float32));
+        return receiver;
+    }
+
     // Convert value to string if it's not already a string
     value_t string_val;
     if (str_val.type == VAL_STRING) {
@@ -115,7 +129,7 @@ value_t builtin_string_builder_append(vm_t* vm, int arg_count, value_t* args) {
     }
     
     // Append the string to the builder
-    ds_builder_append_string(receiver.as.string_builder, string_val.as.string);
+    ds_builder_append_string(builder, string_val.as.string);
     
     // Release the string if we created it
     if (str_val.type != VAL_STRING) {
@@ -137,12 +151,12 @@ value_t builtin_string_builder_append_char(vm_t* vm, int arg_count, value_t* arg
     value_t codepoint_val = args[1];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "appendChar() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "appendChar() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
     if (codepoint_val.type != VAL_INT32) {
-        runtime_error(vm, "appendChar() requires an integer codepoint, not %s", value_type_name(codepoint_val.type));
+        runtime_error(vm, "appendChar() requires an integer codepoint, not %s", value_class_name(codepoint_val));
         return make_null();
     }
     
@@ -169,7 +183,7 @@ value_t builtin_string_builder_to_string(vm_t* vm, int arg_count, value_t* args)
     value_t receiver = args[0];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "toString() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "toString() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
@@ -188,7 +202,7 @@ value_t builtin_string_builder_length(vm_t* vm, int arg_count, value_t* args) {
     value_t receiver = args[0];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "length() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "length() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
@@ -207,7 +221,7 @@ value_t builtin_string_builder_clear(vm_t* vm, int arg_count, value_t* args) {
     value_t receiver = args[0];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "clear() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "clear() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
@@ -228,7 +242,7 @@ value_t builtin_string_builder_hash(vm_t* vm, int arg_count, value_t* args) {
     value_t receiver = args[0];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "hash() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "hash() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
@@ -252,7 +266,7 @@ value_t builtin_string_builder_equals(vm_t* vm, int arg_count, value_t* args) {
     value_t other = args[1];
     
     if (receiver.type != VAL_STRING_BUILDER) {
-        runtime_error(vm, "equals() can only be called on StringBuilder, not %s", value_type_name(receiver.type));
+        runtime_error(vm, "equals() can only be called on StringBuilder, not %s", value_class_name(receiver));
         return make_null();
     }
     
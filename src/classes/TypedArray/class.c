@@ -0,0 +1,96 @@
+#include "typed_array.h"
+#include "builtins.h"
+#include "dynamic_object.h"
+
+// Global Int32Array and Float64Array class storage
+SLATE_ISOLATE_LOCAL value_t* global_int32_array_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_float64_array_class = NULL;
+
+static do_object create_typed_array_proto(void) {
+    do_object proto = do_create(NULL);
+
+    value_t length_method = make_native(builtin_typed_array_length);
+    do_set(proto, "length", &length_method, sizeof(value_t));
+
+    // Reductions
+    value_t sum_method = make_native(builtin_typed_array_sum);
+    do_set(proto, "sum", &sum_method, sizeof(value_t));
+
+    value_t min_method = make_native(builtin_typed_array_min);
+    do_set(proto, "min", &min_method, sizeof(value_t));
+
+    value_t max_method = make_native(builtin_typed_array_max);
+    do_set(proto, "max", &max_method, sizeof(value_t));
+
+    value_t dot_method = make_native(builtin_typed_array_dot);
+    do_set(proto, "dot", &dot_method, sizeof(value_t));
+
+    // Element-wise operations
+    value_t add_method = make_native(builtin_typed_array_add);
+    do_set(proto, "add", &add_method, sizeof(value_t));
+
+    value_t sub_method = make_native(builtin_typed_array_sub);
+    do_set(proto, "sub", &sub_method, sizeof(value_t));
+
+    value_t mul_method = make_native(builtin_typed_array_mul);
+    do_set(proto, "mul", &mul_method, sizeof(value_t));
+
+    value_t div_method = make_native(builtin_typed_array_div);
+    do_set(proto, "div", &div_method, sizeof(value_t));
+
+    value_t fill_method = make_native(builtin_typed_array_fill);
+    do_set(proto, "fill", &fill_method, sizeof(value_t));
+
+    value_t map_method = make_native(builtin_typed_array_map);
+    do_set(proto, "map", &map_method, sizeof(value_t));
+
+    // Conversions
+    value_t copy_method = make_native(builtin_typed_array_copy);
+    do_set(proto, "copy", &copy_method, sizeof(value_t));
+
+    value_t to_array_method = make_native(builtin_typed_array_to_array);
+    do_set(proto, "toArray", &to_array_method, sizeof(value_t));
+
+    value_t to_buffer_method = make_native(builtin_typed_array_to_buffer);
+    do_set(proto, "toBuffer", &to_buffer_method, sizeof(value_t));
+
+    value_t hash_method = make_native(builtin_typed_array_hash);
+    do_set(proto, "hash", &hash_method, sizeof(value_t));
+
+    value_t equals_method = make_native(builtin_typed_array_equals);
+    do_set(proto, "equals", &equals_method, sizeof(value_t));
+
+    value_t to_string_method = make_native(builtin_typed_array_to_string);
+    do_set(proto, "toString", &to_string_method, sizeof(value_t));
+
+    return proto;
+}
+
+// Initialize the Int32Array and Float64Array classes with their prototypes and methods
+void typed_array_class_init(vm_t* vm) {
+    // Int32Array
+    do_object int32_static = do_create(NULL);
+    value_t int32_from_buffer_method = make_native(builtin_int32_array_from_buffer);
+    do_set(int32_static, "fromBuffer", &int32_from_buffer_method, sizeof(value_t));
+
+    value_t int32_class = make_class("Int32Array", create_typed_array_proto(), int32_static);
+    int32_class.as.class->factory = int32_array_factory;
+    do_set(vm->globals, "Int32Array", &int32_class, sizeof(value_t));
+
+    static SLATE_ISOLATE_LOCAL value_t int32_class_storage;
+    int32_class_storage = vm_retain(int32_class);
+    global_int32_array_class = &int32_class_storage;
+
+    // Float64Array
+    do_object float64_static = do_create(NULL);
+    value_t float64_from_buffer_method = make_native(builtin_float64_array_from_buffer);
+    do_set(float64_static, "fromBuffer", &float64_from_buffer_method, sizeof(value_t));
+
+    value_t float64_class = make_class("Float64Array", create_typed_array_proto(), float64_static);
+    float64_class.as.class->factory = float64_array_factory;
+    do_set(vm->globals, "Float64Array", &float64_class, sizeof(value_t));
+
+    static SLATE_ISOLATE_LOCAL value_t float64_class_storage;
+    float64_class_storage = vm_retain(float64_class);
+    global_float64_array_class = &float64_class_storage;
+}
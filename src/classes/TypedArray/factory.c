@@ -0,0 +1,160 @@
+#include "typed_array.h"
+#include "builtins.h"
+#include "kernels.h"
+#include "dynamic_array.h"
+#include "dynamic_buffer.h"
+#include <math.h>
+#include <string.h>
+
+static typed_array_t* allocate(vm_t* vm, typed_array_kind kind, size_t length, const char* name) {
+    typed_array_t* array = typed_array_create(kind, length);
+    if (!array) {
+        runtime_error(vm, "%s() failed: out of memory", name);
+    }
+    return array;
+}
+
+// Store or raise: runtime_error doesn't return, so the partly built array is released first
+static void store(vm_t* vm, typed_array_t* array, size_t index, value_t element, const char* name) {
+    if (!typed_array_set(array, index, element)) {
+        typed_array_kind kind = array->kind;
+        typed_array_release(array);
+        if (kind == TYPED_INT32 && is_number(element)) {
+            runtime_error(vm, "%s() elements must be Int32 values (index %zu)", name, index);
+        }
+        runtime_error(vm, "%s() elements must be numbers, not %s (index %zu)", name,
+                      value_class_name(element), index);
+    }
+}
+
+static typed_array_t* from_typed_array(vm_t* vm, typed_array_kind kind, typed_array_t* source, const char* name) {
+    typed_array_t* array = allocate(vm, kind, source->length, name);
+    if (source->kind == kind) {
+        memcpy(array->data.bytes, source->data.bytes,
+               source->length * (kind == TYPED_INT32 ? sizeof(int32_t) : sizeof(double)));
+    } else if (kind == TYPED_FLOAT64) {
+        tk_i32_to_f64(array->data.f64, source->data.i32, source->length);
+    } else {
+        // Float64 -> Int32 truncates toward zero, like Int32 conversion elsewhere
+        for (size_t i = 0; i < source->length; i++) {
+            double x = source->data.f64[i];
+            if (!(x > (double)INT32_MIN - 1.0 && x < (double)INT32_MAX + 1.0)) {
+                typed_array_release(array);
+                runtime_error(vm, "%s() element %g doesn't fit in an Int32 (index %zu)", name, x, i);
+            }
+            array->data.i32[i] = (int32_t)x;
+        }
+    }
+    return array;
+}
+
+static typed_array_t* from_iterator(vm_t* vm, typed_array_kind kind, iterator_t* iter, const char* name) {
+    size_t capacity;
+    if (!iterator_size_hint(iter, &capacity) || capacity == SIZE_MAX) {
+        capacity = 16;
+    }
+    typed_array_t* array = allocate(vm, kind, capacity, name);
+    size_t count = 0;
+    size_t element_size = kind == TYPED_INT32 ? sizeof(int32_t) : sizeof(double);
+    while (iterator_has_next(iter)) {
+        value_t element = iterator_next(iter);
+        if (count == array->length) {
+            typed_array_t* grown = typed_array_create(kind, count ? count * 2 : 16);
+            if (!grown) {
+                typed_array_release(array);
+                vm_release(element);
+                iterator_release(iter);
+                runtime_error(vm, "%s() failed: out of memory", name);
+            }
+            memcpy(grown->data.bytes, array->data.bytes, count * element_size);
+            typed_array_release(array);
+            array = grown;
+        }
+        if (!typed_array_set(array, count, element)) {
+            iterator_release(iter);
+            vm_release(element); // store() only needs its type for the message
+            store(vm, array, count, element, name);
+        }
+        count++;
+        vm_release(element);
+    }
+    array->length = count; // The spare capacity stays allocated until the array is freed
+    return array;
+}
+
+static value_t construct(vm_t* vm, typed_array_kind kind, int arg_count, value_t* args) {
+    const char* name = typed_array_class_name(kind);
+    if (arg_count != 1) {
+        runtime_error(vm, "%s() takes exactly 1 argument (%d given)", name, arg_count);
+    }
+
+    value_t source = args[0];
+    if (source.type == VAL_INT32) {
+        // Int32Array(n) - n zeros
+        if (source.as.int32 < 0) {
+            runtime_error(vm, "%s() length must be non-negative", name);
+        }
+        return make_typed_array(allocate(vm, kind, (size_t)source.as.int32, name));
+    }
+    if (source.type == VAL_ARRAY) {
+        size_t length = da_length(source.as.array);
+        value_t* elements = (value_t*)da_data(source.as.array);
+        typed_array_t* array = allocate(vm, kind, length, name);
+        for (size_t i = 0; i < length; i++) {
+            store(vm, array, i, elements[i], name);
+        }
+        return make_typed_array(array);
+    }
+    if (source.type == VAL_TYPED_ARRAY) {
+        return make_typed_array(from_typed_array(vm, kind, source.as.typed_array, name));
+    }
+    iterator_t* iter = iterator_for_value(source);
+    if (!iter) {
+        runtime_error(vm, "%s() argument must be a length, array, range, iterator or typed array, not %s",
+                      name, value_class_name(source));
+    }
+    typed_array_t* array = from_iterator(vm, kind, iter, name);
+    iterator_release(iter);
+    return make_typed_array(array);
+}
+
+// Int32Array(source) factory function for class instantiation
+value_t int32_array_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
+    (void)self;
+    return construct(vm, TYPED_INT32, arg_count, args);
+}
+
+// Float64Array(source) factory function for class instantiation
+value_t float64_array_factory(vm_t* vm, class_t* self, int arg_count, value_t* args) {
+    (void)self;
+    return construct(vm, TYPED_FLOAT64, arg_count, args);
+}
+
+// The buffer's bytes reinterpreted as elements in native byte order (the inverse of toBuffer())
+static value_t from_buffer(vm_t* vm, typed_array_kind kind, int arg_count, value_t* args) {
+    const char* name = kind == TYPED_INT32 ? "Int32Array.fromBuffer" : "Float64Array.fromBuffer";
+    if (arg_count != 1) {
+        runtime_error(vm, "%s() takes exactly 1 argument (%d given)", name, arg_count);
+    }
+    if (args[0].type != VAL_BUFFER) {
+        runtime_error(vm, "%s() requires a buffer, not %s", name, value_class_name(args[0]));
+    }
+    size_t element_size = kind == TYPED_INT32 ? sizeof(int32_t) : sizeof(double);
+    size_t bytes = db_size(args[0].as.buffer);
+    if (bytes % element_size != 0) {
+        runtime_error(vm, "%s() buffer size %zu is not a multiple of %zu", name, bytes, element_size);
+    }
+    typed_array_t* array = allocate(vm, kind, bytes / element_size, name);
+    memcpy(array->data.bytes, args[0].as.buffer, bytes);
+    return make_typed_array(array);
+}
+
+// Int32Array.fromBuffer(buffer)
+value_t builtin_int32_array_from_buffer(vm_t* vm, int arg_count, value_t* args) {
+    return from_buffer(vm, TYPED_INT32, arg_count, args);
+}
+
+// Float64Array.fromBuffer(buffer)
+value_t builtin_float64_array_from_buffer(vm_t* vm, int arg_count, value_t* args) {
+    return from_buffer(vm, TYPED_FLOAT64, arg_count, args);
+}
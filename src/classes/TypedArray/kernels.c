@@ -0,0 +1,679 @@
+#include "kernels.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TK_X86 1
+#include <immintrin.h>
+// AVX2 versions are compiled for AVX2 regardless of the build flags and only run when the CPU has it
+#define TK_AVX2_FN __attribute__((target("avx2")))
+#endif
+
+static int level_cache = -1;
+
+static tk_level best_level(void) {
+#ifdef TK_X86
+    return __builtin_cpu_supports("avx2") ? TK_AVX2 : TK_SSE2;
+#else
+    return TK_SCALAR;
+#endif
+}
+
+tk_level tk_get_level(void) {
+    int level = __atomic_load_n(&level_cache, __ATOMIC_RELAXED);
+    if (level < 0) {
+        level = best_level();
+        const char* cap = getenv("SLATE_SIMD");
+        if (cap) {
+            int limit = strcmp(cap, "scalar") == 0 ? TK_SCALAR : strcmp(cap, "sse2") == 0 ? TK_SSE2 : TK_AVX2;
+            level = level < limit ? level : limit;
+        }
+        __atomic_store_n(&level_cache, level, __ATOMIC_RELAXED);
+    }
+    return (tk_level)level;
+}
+
+void tk_set_level(tk_level level) {
+    tk_level best = best_level();
+    __atomic_store_n(&level_cache, (int)(level < best ? level : best), __ATOMIC_RELAXED);
+}
+
+// ---------------------------------------------------------------------------------------------
+// Scalar versions: the whole job on other targets, and the leftover elements (from `i`) after
+// the vector loops everywhere else
+// ---------------------------------------------------------------------------------------------
+
+static int64_t sum_i32_tail(const int32_t* a, size_t i, size_t n) {
+    int64_t sum = 0;
+    for (; i < n; i++) {
+        sum += a[i];
+    }
+    return sum;
+}
+
+static double sum_f64_tail(const double* a, size_t i, size_t n) {
+    double sum = 0.0;
+    for (; i < n; i++) {
+        sum += a[i];
+    }
+    return sum;
+}
+
+static void min_max_i32_tail(const int32_t* a, size_t i, size_t n, int32_t* min, int32_t* max) {
+    for (; i < n; i++) {
+        if (a[i] < *min) *min = a[i];
+        if (a[i] > *max) *max = a[i];
+    }
+}
+
+// Returns whether a NaN was seen
+static int min_max_f64_tail(const double* a, size_t i, size_t n, double* min, double* max) {
+    int nan = 0;
+    for (; i < n; i++) {
+        if (a[i] != a[i]) nan = 1;
+        if (a[i] < *min) *min = a[i];
+        if (a[i] > *max) *max = a[i];
+    }
+    return nan;
+}
+
+static double dot_f64_tail(const double* a, const double* b, size_t i, size_t n) {
+    double sum = 0.0;
+    for (; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+static int32_t wrap_i32(tk_op op, int32_t x, int32_t y) {
+    uint32_t ux = (uint32_t)x;
+    uint32_t uy = (uint32_t)y;
+    switch (op) {
+    case TK_ADD: return (int32_t)(ux + uy);
+    case TK_SUB: return (int32_t)(ux - uy);
+    case TK_MUL: return (int32_t)(ux * uy);
+    default: return 0;
+    }
+}
+
+static double apply_f64(tk_op op, double x, double y) {
+    switch (op) {
+    case TK_ADD: return x + y;
+    case TK_SUB: return x - y;
+    case TK_MUL: return x * y;
+    default: return x / y;
+    }
+}
+
+static void binary_i32_tail(tk_op op, int32_t* dst, const int32_t* a, const int32_t* b, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = wrap_i32(op, a[i], b[i]);
+    }
+}
+
+static void binary_scalar_i32_tail(tk_op op, int32_t* dst, const int32_t* a, int32_t b, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = wrap_i32(op, a[i], b);
+    }
+}
+
+static void binary_f64_tail(tk_op op, double* dst, const double* a, const double* b, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = apply_f64(op, a[i], b[i]);
+    }
+}
+
+static void binary_scalar_f64_tail(tk_op op, double* dst, const double* a, double b, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = apply_f64(op, a[i], b);
+    }
+}
+
+static void unary_f64_tail(tk_unary op, double* dst, const double* a, size_t i, size_t n) {
+    for (; i < n; i++) {
+        switch (op) {
+        case TK_ABS: dst[i] = fabs(a[i]); break;
+        case TK_SQRT: dst[i] = sqrt(a[i]); break;
+        case TK_FLOOR: dst[i] = floor(a[i]); break;
+        case TK_CEIL: dst[i] = ceil(a[i]); break;
+        }
+    }
+}
+
+static void abs_i32_tail(int32_t* dst, const int32_t* a, size_t i, size_t n) {
+    for (; i < n; i++) {
+        uint32_t sign = (uint32_t)(a[i] >> 31);
+        dst[i] = (int32_t)(((uint32_t)a[i] ^ sign) - sign);
+    }
+}
+
+static void fill_i32_tail(int32_t* dst, int32_t value, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = value;
+    }
+}
+
+static void fill_f64_tail(double* dst, double value, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = value;
+    }
+}
+
+static void i32_to_f64_tail(double* dst, const int32_t* a, size_t i, size_t n) {
+    for (; i < n; i++) {
+        dst[i] = (double)a[i];
+    }
+}
+
+#ifdef TK_X86
+
+// ---------------------------------------------------------------------------------------------
+// SSE2 (always available on x86-64)
+// ---------------------------------------------------------------------------------------------
+
+static int64_t sum_i32_sse2(const int32_t* a, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    return lanes[0] + lanes[1] + sum_i32_tail(a, i, n);
+}
+
+static double sum_f64_sse2(const double* a, size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(a + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(a + i + 2));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + sum_f64_tail(a, i, n);
+}
+
+// SSE2 has no pminsd/pmaxsd (SSE4.1), so select with a comparison mask
+static __m128i select_i32(__m128i mask, __m128i if_set, __m128i if_clear) {
+    return _mm_or_si128(_mm_and_si128(mask, if_set), _mm_andnot_si128(mask, if_clear));
+}
+
+static void min_max_i32_sse2(const int32_t* a, size_t n, int32_t* min, int32_t* max) {
+    __m128i vmin = _mm_set1_epi32(a[0]);
+    __m128i vmax = vmin;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(a + i));
+        vmin = select_i32(_mm_cmplt_epi32(v, vmin), v, vmin);
+        vmax = select_i32(_mm_cmpgt_epi32(v, vmax), v, vmax);
+    }
+    int32_t lows[4], highs[4];
+    _mm_storeu_si128((__m128i*)lows, vmin);
+    _mm_storeu_si128((__m128i*)highs, vmax);
+    *min = a[0];
+    *max = a[0];
+    min_max_i32_tail(lows, 0, 4, min, max);
+    min_max_i32_tail(highs, 0, 4, min, max);
+    min_max_i32_tail(a, i, n, min, max);
+}
+
+static int min_max_f64_sse2(const double* a, size_t n, double* min, double* max) {
+    __m128d vmin = _mm_set1_pd(a[0]);
+    __m128d vmax = vmin;
+    __m128d nan = _mm_cmpunord_pd(vmin, vmin);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(a + i);
+        nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+        vmin = _mm_min_pd(vmin, v);
+        vmax = _mm_max_pd(vmax, v);
+    }
+    double lows[2], highs[2];
+    _mm_storeu_pd(lows, vmin);
+    _mm_storeu_pd(highs, vmax);
+    *min = lows[0] < lows[1] ? lows[0] : lows[1];
+    *max = highs[0] > highs[1] ? highs[0] : highs[1];
+    return _mm_movemask_pd(nan) | min_max_f64_tail(a, i, n, min, max);
+}
+
+static double dot_f64_sse2(const double* a, const double* b, size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + dot_f64_tail(a, b, i, n);
+}
+
+static __m128i apply_epi32_sse2(tk_op op, __m128i x, __m128i y) {
+    return op == TK_ADD ? _mm_add_epi32(x, y) : _mm_sub_epi32(x, y);
+}
+
+static void binary_i32_sse2(tk_op op, int32_t* dst, const int32_t* a, const int32_t* b, size_t n) {
+    size_t i = 0;
+    if (op != TK_MUL) { // pmulld is SSE4.1
+        for (; i + 4 <= n; i += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+            __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+            _mm_storeu_si128((__m128i*)(dst + i), apply_epi32_sse2(op, x, y));
+        }
+    }
+    binary_i32_tail(op, dst, a, b, i, n);
+}
+
+static void binary_scalar_i32_sse2(tk_op op, int32_t* dst, const int32_t* a, int32_t b, size_t n) {
+    size_t i = 0;
+    if (op != TK_MUL) {
+        __m128i y = _mm_set1_epi32(b);
+        for (; i + 4 <= n; i += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+            _mm_storeu_si128((__m128i*)(dst + i), apply_epi32_sse2(op, x, y));
+        }
+    }
+    binary_scalar_i32_tail(op, dst, a, b, i, n);
+}
+
+static __m128d apply_pd_sse2(tk_op op, __m128d x, __m128d y) {
+    switch (op) {
+    case TK_ADD: return _mm_add_pd(x, y);
+    case TK_SUB: return _mm_sub_pd(x, y);
+    case TK_MUL: return _mm_mul_pd(x, y);
+    default: return _mm_div_pd(x, y);
+    }
+}
+
+static void binary_f64_sse2(tk_op op, double* dst, const double* a, const double* b, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(dst + i, apply_pd_sse2(op, _mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    binary_f64_tail(op, dst, a, b, i, n);
+}
+
+static void binary_scalar_f64_sse2(tk_op op, double* dst, const double* a, double b, size_t n) {
+    __m128d y = _mm_set1_pd(b);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(dst + i, apply_pd_sse2(op, _mm_loadu_pd(a + i), y));
+    }
+    binary_scalar_f64_tail(op, dst, a, b, i, n);
+}
+
+static void unary_f64_sse2(tk_unary op, double* dst, const double* a, size_t n) {
+    size_t i = 0;
+    if (op == TK_ABS) {
+        __m128d sign = _mm_set1_pd(-0.0);
+        for (; i + 2 <= n; i += 2) {
+            _mm_storeu_pd(dst + i, _mm_andnot_pd(sign, _mm_loadu_pd(a + i)));
+        }
+    } else if (op == TK_SQRT) {
+        for (; i + 2 <= n; i += 2) {
+            _mm_storeu_pd(dst + i, _mm_sqrt_pd(_mm_loadu_pd(a + i)));
+        }
+    }
+    // roundpd (floor/ceil) is SSE4.1
+    unary_f64_tail(op, dst, a, i, n);
+}
+
+static void abs_i32_sse2(int32_t* dst, const int32_t* a, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i sign = _mm_srai_epi32(v, 31);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_sub_epi32(_mm_xor_si128(v, sign), sign));
+    }
+    abs_i32_tail(dst, a, i, n);
+}
+
+static void fill_i32_sse2(int32_t* dst, int32_t value, size_t n) {
+    __m128i v = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_si128((__m128i*)(dst + i), v);
+    }
+    fill_i32_tail(dst, value, i, n);
+}
+
+static void fill_f64_sse2(double* dst, double value, size_t n) {
+    __m128d v = _mm_set1_pd(value);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(dst + i, v);
+    }
+    fill_f64_tail(dst, value, i, n);
+}
+
+static void i32_to_f64_sse2(double* dst, const int32_t* a, size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(dst + i, _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i*)(a + i))));
+    }
+    i32_to_f64_tail(dst, a, i, n);
+}
+
+// ---------------------------------------------------------------------------------------------
+// AVX2
+// ---------------------------------------------------------------------------------------------
+
+TK_AVX2_FN static int64_t sum_i32_avx2(const int32_t* a, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(a + i))));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)(a + i + 4))));
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi64(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_i32_tail(a, i, n);
+}
+
+TK_AVX2_FN static double sum_f64_avx2(const double* a, size_t n) {
+    // Four independent chains hide the add latency
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(a + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(a + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(a + i + 12));
+    }
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(a + i));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + sum_f64_tail(a, i, n);
+}
+
+TK_AVX2_FN static void min_max_i32_avx2(const int32_t* a, size_t n, int32_t* min, int32_t* max) {
+    __m256i vmin = _mm256_set1_epi32(a[0]);
+    __m256i vmax = vmin;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(a + i));
+        vmin = _mm256_min_epi32(vmin, v);
+        vmax = _mm256_max_epi32(vmax, v);
+    }
+    int32_t lows[8], highs[8];
+    _mm256_storeu_si256((__m256i*)lows, vmin);
+    _mm256_storeu_si256((__m256i*)highs, vmax);
+    *min = a[0];
+    *max = a[0];
+    min_max_i32_tail(lows, 0, 8, min, max);
+    min_max_i32_tail(highs, 0, 8, min, max);
+    min_max_i32_tail(a, i, n, min, max);
+}
+
+TK_AVX2_FN static int min_max_f64_avx2(const double* a, size_t n, double* min, double* max) {
+    __m256d vmin = _mm256_set1_pd(a[0]);
+    __m256d vmax = vmin;
+    __m256d nan = _mm256_cmp_pd(vmin, vmin, _CMP_UNORD_Q);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(a + i);
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        vmin = _mm256_min_pd(vmin, v);
+        vmax = _mm256_max_pd(vmax, v);
+    }
+    double lows[4], highs[4];
+    _mm256_storeu_pd(lows, vmin);
+    _mm256_storeu_pd(highs, vmax);
+    *min = lows[0];
+    *max = highs[0];
+    min_max_f64_tail(lows, 1, 4, min, max);
+    min_max_f64_tail(highs, 1, 4, min, max);
+    return _mm256_movemask_pd(nan) | min_max_f64_tail(a, i, n, min, max);
+}
+
+TK_AVX2_FN static double dot_f64_avx2(const double* a, const double* b, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + dot_f64_tail(a, b, i, n);
+}
+
+TK_AVX2_FN static __m256i apply_epi32_avx2(tk_op op, __m256i x, __m256i y) {
+    switch (op) {
+    case TK_ADD: return _mm256_add_epi32(x, y);
+    case TK_SUB: return _mm256_sub_epi32(x, y);
+    default: return _mm256_mullo_epi32(x, y);
+    }
+}
+
+TK_AVX2_FN static void binary_i32_avx2(tk_op op, int32_t* dst, const int32_t* a, const int32_t* b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), apply_epi32_avx2(op, x, y));
+    }
+    binary_i32_tail(op, dst, a, b, i, n);
+}
+
+TK_AVX2_FN static void binary_scalar_i32_avx2(tk_op op, int32_t* dst, const int32_t* a, int32_t b, size_t n) {
+    __m256i y = _mm256_set1_epi32(b);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), apply_epi32_avx2(op, x, y));
+    }
+    binary_scalar_i32_tail(op, dst, a, b, i, n);
+}
+
+TK_AVX2_FN static __m256d apply_pd_avx2(tk_op op, __m256d x, __m256d y) {
+    switch (op) {
+    case TK_ADD: return _mm256_add_pd(x, y);
+    case TK_SUB: return _mm256_sub_pd(x, y);
+    case TK_MUL: return _mm256_mul_pd(x, y);
+    default: return _mm256_div_pd(x, y);
+    }
+}
+
+TK_AVX2_FN static void binary_f64_avx2(tk_op op, double* dst, const double* a, const double* b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(dst + i, apply_pd_avx2(op, _mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    binary_f64_tail(op, dst, a, b, i, n);
+}
+
+TK_AVX2_FN static void binary_scalar_f64_avx2(tk_op op, double* dst, const double* a, double b, size_t n) {
+    __m256d y = _mm256_set1_pd(b);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(dst + i, apply_pd_avx2(op, _mm256_loadu_pd(a + i), y));
+    }
+    binary_scalar_f64_tail(op, dst, a, b, i, n);
+}
+
+TK_AVX2_FN static __m256d apply_unary_avx2(tk_unary op, __m256d x) {
+    switch (op) {
+    case TK_ABS: return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+    case TK_SQRT: return _mm256_sqrt_pd(x);
+    case TK_FLOOR: return _mm256_floor_pd(x);
+    default: return _mm256_ceil_pd(x);
+    }
+}
+
+TK_AVX2_FN static void unary_f64_avx2(tk_unary op, double* dst, const double* a, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(dst + i, apply_unary_avx2(op, _mm256_loadu_pd(a + i)));
+    }
+    unary_f64_tail(op, dst, a, i, n);
+}
+
+TK_AVX2_FN static void abs_i32_avx2(int32_t* dst, const int32_t* a, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_abs_epi32(_mm256_loadu_si256((const __m256i*)(a + i))));
+    }
+    abs_i32_tail(dst, a, i, n);
+}
+
+TK_AVX2_FN static void fill_i32_avx2(int32_t* dst, int32_t value, size_t n) {
+    __m256i v = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_si256((__m256i*)(dst + i), v);
+    }
+    fill_i32_tail(dst, value, i, n);
+}
+
+TK_AVX2_FN static void fill_f64_avx2(double* dst, double value, size_t n) {
+    __m256d v = _mm256_set1_pd(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(dst + i, v);
+    }
+    fill_f64_tail(dst, value, i, n);
+}
+
+TK_AVX2_FN static void i32_to_f64_avx2(double* dst, const int32_t* a, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i*)(a + i))));
+    }
+    i32_to_f64_tail(dst, a, i, n);
+}
+
+// Pick the AVX2 or SSE2 version, or fall through to the scalar one
+#define TK_DISPATCH(avx2_call, sse2_call)        \
+    switch (tk_get_level()) {                    \
+    case TK_AVX2: avx2_call; return;             \
+    case TK_SSE2: sse2_call; return;             \
+    case TK_SCALAR: break;                       \
+    }
+#define TK_DISPATCH_RETURN(avx2_call, sse2_call) \
+    switch (tk_get_level()) {                    \
+    case TK_AVX2: return avx2_call;              \
+    case TK_SSE2: return sse2_call;              \
+    case TK_SCALAR: break;                       \
+    }
+
+#else
+#define TK_DISPATCH(avx2_call, sse2_call)
+#define TK_DISPATCH_RETURN(avx2_call, sse2_call)
+#endif // TK_X86
+
+// ---------------------------------------------------------------------------------------------
+// Entry points
+// ---------------------------------------------------------------------------------------------
+
+int64_t tk_sum_i32(const int32_t* a, size_t n) {
+    TK_DISPATCH_RETURN(sum_i32_avx2(a, n), sum_i32_sse2(a, n))
+    return sum_i32_tail(a, 0, n);
+}
+
+double tk_sum_f64(const double* a, size_t n) {
+    TK_DISPATCH_RETURN(sum_f64_avx2(a, n), sum_f64_sse2(a, n))
+    return sum_f64_tail(a, 0, n);
+}
+
+void tk_min_max_i32(const int32_t* a, size_t n, int32_t* min, int32_t* max) {
+    TK_DISPATCH(min_max_i32_avx2(a, n, min, max), min_max_i32_sse2(a, n, min, max))
+    *min = a[0];
+    *max = a[0];
+    min_max_i32_tail(a, 1, n, min, max);
+}
+
+void tk_min_max_f64(const double* a, size_t n, double* min, double* max) {
+    int nan;
+    switch (tk_get_level()) {
+#ifdef TK_X86
+    case TK_AVX2: nan = min_max_f64_avx2(a, n, min, max); break;
+    case TK_SSE2: nan = min_max_f64_sse2(a, n, min, max); break;
+#endif
+    default:
+        *min = a[0];
+        *max = a[0];
+        nan = min_max_f64_tail(a, 0, n, min, max);
+        break;
+    }
+    if (nan) {
+        *min = NAN;
+        *max = NAN;
+    }
+}
+
+double tk_dot_f64(const double* a, const double* b, size_t n) {
+    TK_DISPATCH_RETURN(dot_f64_avx2(a, b, n), dot_f64_sse2(a, b, n))
+    return dot_f64_tail(a, b, 0, n);
+}
+
+int tk_dot_i32(const int32_t* a, const int32_t* b, size_t n, int64_t* result) {
+    // Every product fits in int64 but their sum might not, so this one stays scalar and checked
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (__builtin_add_overflow(sum, (int64_t)a[i] * b[i], &sum)) {
+            return 0;
+        }
+    }
+    *result = sum;
+    return 1;
+}
+
+void tk_binary_i32(tk_op op, int32_t* dst, const int32_t* a, const int32_t* b, size_t n) {
+    TK_DISPATCH(binary_i32_avx2(op, dst, a, b, n), binary_i32_sse2(op, dst, a, b, n))
+    binary_i32_tail(op, dst, a, b, 0, n);
+}
+
+void tk_binary_scalar_i32(tk_op op, int32_t* dst, const int32_t* a, int32_t b, size_t n) {
+    TK_DISPATCH(binary_scalar_i32_avx2(op, dst, a, b, n), binary_scalar_i32_sse2(op, dst, a, b, n))
+    binary_scalar_i32_tail(op, dst, a, b, 0, n);
+}
+
+void tk_binary_f64(tk_op op, double* dst, const double* a, const double* b, size_t n) {
+    TK_DISPATCH(binary_f64_avx2(op, dst, a, b, n), binary_f64_sse2(op, dst, a, b, n))
+    binary_f64_tail(op, dst, a, b, 0, n);
+}
+
+void tk_binary_scalar_f64(tk_op op, double* dst, const double* a, double b, size_t n) {
+    TK_DISPATCH(binary_scalar_f64_avx2(op, dst, a, b, n), binary_scalar_f64_sse2(op, dst, a, b, n))
+    binary_scalar_f64_tail(op, dst, a, b, 0, n);
+}
+
+void tk_unary_f64(tk_unary op, double* dst, const double* a, size_t n) {
+    TK_DISPATCH(unary_f64_avx2(op, dst, a, n), unary_f64_sse2(op, dst, a, n))
+    unary_f64_tail(op, dst, a, 0, n);
+}
+
+void tk_abs_i32(int32_t* dst, const int32_t* a, size_t n) {
+    TK_DISPATCH(abs_i32_avx2(dst, a, n), abs_i32_sse2(dst, a, n))
+    abs_i32_tail(dst, a, 0, n);
+}
+
+void tk_fill_i32(int32_t* dst, int32_t value, size_t n) {
+    TK_DISPATCH(fill_i32_avx2(dst, value, n), fill_i32_sse2(dst, value, n))
+    fill_i32_tail(dst, value, 0, n);
+}
+
+void tk_fill_f64(double* dst, double value, size_t n) {
+    TK_DISPATCH(fill_f64_avx2(dst, value, n), fill_f64_sse2(dst, value, n))
+    fill_f64_tail(dst, value, 0, n);
+}
+
+void tk_i32_to_f64(double* dst, const int32_t* a, size_t n) {
+    TK_DISPATCH(i32_to_f64_avx2(dst, a, n), i32_to_f64_sse2(dst, a, n))
+    i32_to_f64_tail(dst, a, 0, n);
+}
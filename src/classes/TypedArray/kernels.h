@@ -0,0 +1,59 @@
+#ifndef CLASS_TYPED_ARRAY_KERNELS_H
+#define CLASS_TYPED_ARRAY_KERNELS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Bulk numeric kernels behind Int32Array and Float64Array.
+//
+// Each kernel has an AVX2 version, an SSE2 version and a portable scalar one, picked per call from
+// the best level the CPU supports (SSE2 is the x86-64 baseline; other targets always use scalar).
+// SLATE_SIMD=scalar|sse2|avx2 caps the level, which is how the tests cover every path.
+//
+// Float reductions keep several partial sums, so their rounding can differ in the last bits from
+// a left-to-right loop. Int32 arithmetic wraps around like the C unsigned operations it's built on.
+// Destinations may alias sources.
+
+typedef enum {
+    TK_SCALAR,
+    TK_SSE2,
+    TK_AVX2
+} tk_level;
+
+tk_level tk_get_level(void);
+void tk_set_level(tk_level level); // Clamped to what the CPU supports
+
+typedef enum {
+    TK_ADD,
+    TK_SUB,
+    TK_MUL,
+    TK_DIV // Float64 only
+} tk_op;
+
+typedef enum {
+    TK_ABS,
+    TK_SQRT,
+    TK_FLOOR,
+    TK_CEIL
+} tk_unary;
+
+// Reductions
+int64_t tk_sum_i32(const int32_t* a, size_t n);
+double tk_sum_f64(const double* a, size_t n);
+void tk_min_max_i32(const int32_t* a, size_t n, int32_t* min, int32_t* max); // n > 0
+void tk_min_max_f64(const double* a, size_t n, double* min, double* max); // n > 0; NaN if any element is
+double tk_dot_f64(const double* a, const double* b, size_t n);
+int tk_dot_i32(const int32_t* a, const int32_t* b, size_t n, int64_t* result); // 0 if it overflows int64
+
+// Element-wise
+void tk_binary_i32(tk_op op, int32_t* dst, const int32_t* a, const int32_t* b, size_t n);
+void tk_binary_scalar_i32(tk_op op, int32_t* dst, const int32_t* a, int32_t b, size_t n);
+void tk_binary_f64(tk_op op, double* dst, const double* a, const double* b, size_t n);
+void tk_binary_scalar_f64(tk_op op, double* dst, const double* a, double b, size_t n);
+void tk_unary_f64(tk_unary op, double* dst, const double* a, size_t n);
+void tk_abs_i32(int32_t* dst, const int32_t* a, size_t n);
+void tk_fill_i32(int32_t* dst, int32_t value, size_t n);
+void tk_fill_f64(double* dst, double value, size_t n);
+void tk_i32_to_f64(double* dst, const int32_t* a, size_t n);
+
+#endif // CLASS_TYPED_ARRAY_KERNELS_H
@@ -0,0 +1,430 @@
+#include "typed_array.h"
+#include "builtins.h"
+#include "kernels.h"
+#include "dynamic_array.h"
+#include "dynamic_buffer.h"
+#include "dynamic_string.h"
+#include "../Number/number_format.h"
+#include <math.h>
+#include <string.h>
+
+const char* typed_array_class_name(typed_array_kind kind) {
+    return kind == TYPED_INT32 ? "Int32Array" : "Float64Array";
+}
+
+static size_t element_size(typed_array_kind kind) {
+    return kind == TYPED_INT32 ? sizeof(int32_t) : sizeof(double);
+}
+
+value_t typed_array_get(typed_array_t* array, size_t index) {
+    return array->kind == TYPED_INT32 ? make_int32(array->data.i32[index]) : make_float64(array->data.f64[index]);
+}
+
+int typed_array_set(typed_array_t* array, size_t index, value_t value) {
+    if (array->kind == TYPED_INT32) {
+        if (value.type != VAL_INT32) {
+            return 0;
+        }
+        array->data.i32[index] = value.as.int32;
+        return 1;
+    }
+    if (!is_number(value)) {
+        return 0;
+    }
+    array->data.f64[index] = value_to_float64(value);
+    return 1;
+}
+
+ds_string typed_array_to_display_string(vm_t* vm, typed_array_t* array) {
+    ds_builder sb = ds_builder_create();
+    ds_builder_append(sb, typed_array_class_name(array->kind));
+    ds_builder_append(sb, "[");
+    for (size_t i = 0; i < array->length; i++) {
+        if (i > 0) {
+            ds_builder_append(sb, ", ");
+        }
+        if (array->kind == TYPED_INT32) {
+            ds_builder_append_int(sb, array->data.i32[i]);
+        } else {
+            // Same formatting as a Float value
+            ds_builder_commit(sb, nf_format_float64(ds_builder_reserve(sb, NF_MAX_LENGTH), array->data.f64[i]));
+        }
+    }
+    ds_builder_append(sb, "]");
+    ds_string result = ds_builder_to_string(sb);
+    ds_builder_release(&sb);
+    return result;
+}
+
+static typed_array_t* receiver_array(vm_t* vm, int arg_count, value_t* args, int expected, const char* name) {
+    if (arg_count != expected + 1) {
+        if (expected == 0) {
+            runtime_error(vm, "%s() takes no arguments (%d given)", name, arg_count - 1);
+        }
+        runtime_error(vm, "%s() takes exactly %d argument%s (%d given)", name, expected, expected == 1 ? "" : "s",
+                      arg_count - 1);
+    }
+    if (args[0].type != VAL_TYPED_ARRAY) {
+        runtime_error(vm, "%s() can only be called on typed arrays", name);
+    }
+    return args[0].as.typed_array;
+}
+
+static typed_array_t* allocate(vm_t* vm, typed_array_kind kind, size_t length, const char* name) {
+    typed_array_t* array = typed_array_create(kind, length);
+    if (!array) {
+        runtime_error(vm, "%s() failed: out of memory", name);
+    }
+    return array;
+}
+
+// The array as Float64 elements: itself (retained) or a converted copy
+static typed_array_t* widen(vm_t* vm, typed_array_t* array, const char* name) {
+    if (array->kind == TYPED_FLOAT64) {
+        array->ref_count++;
+        return array;
+    }
+    typed_array_t* wide = allocate(vm, TYPED_FLOAT64, array->length, name);
+    tk_i32_to_f64(wide->data.f64, array->data.i32, array->length);
+    return wide;
+}
+
+static value_t make_int64_value(int64_t value) {
+    if (value >= INT32_MIN && value <= INT32_MAX) {
+        return make_int32((int32_t)value);
+    }
+    return make_bigint(di_from_int64(value));
+}
+
+// typedArray.length() - Number of elements
+value_t builtin_typed_array_length(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "length");
+    return make_int64_value((int64_t)array->length);
+}
+
+// typedArray.sum() - Sum of the elements (an Int for Int32Array, never wrapping)
+value_t builtin_typed_array_sum(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "sum");
+    if (array->kind == TYPED_INT32) {
+        return make_int64_value(tk_sum_i32(array->data.i32, array->length));
+    }
+    return make_float64(tk_sum_f64(array->data.f64, array->length));
+}
+
+static value_t min_or_max(vm_t* vm, int arg_count, value_t* args, int want_max, const char* name) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, name);
+    if (array->length == 0) {
+        return make_null();
+    }
+    if (array->kind == TYPED_INT32) {
+        int32_t min, max;
+        tk_min_max_i32(array->data.i32, array->length, &min, &max);
+        return make_int32(want_max ? max : min);
+    }
+    double min, max;
+    tk_min_max_f64(array->data.f64, array->length, &min, &max);
+    return make_float64(want_max ? max : min);
+}
+
+// typedArray.min() - Smallest element, null when empty (NaN if any element is NaN)
+value_t builtin_typed_array_min(vm_t* vm, int arg_count, value_t* args) {
+    return min_or_max(vm, arg_count, args, 0, "min");
+}
+
+// typedArray.max() - Largest element, null when empty (NaN if any element is NaN)
+value_t builtin_typed_array_max(vm_t* vm, int arg_count, value_t* args) {
+    return min_or_max(vm, arg_count, args, 1, "max");
+}
+
+static typed_array_t* same_length_operand(vm_t* vm, typed_array_t* array, value_t other, const char* name) {
+    if (other.type != VAL_TYPED_ARRAY) {
+        return NULL;
+    }
+    if (other.as.typed_array->length != array->length) {
+        runtime_error(vm, "%s() requires arrays of the same length (%zu and %zu)", name, array->length,
+                      other.as.typed_array->length);
+    }
+    return other.as.typed_array;
+}
+
+// typedArray.dot(other) - Sum of the element-wise products (an Int when both are Int32Arrays)
+value_t builtin_typed_array_dot(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 1, "dot");
+    typed_array_t* other = same_length_operand(vm, array, args[1], "dot");
+    if (!other) {
+        runtime_error(vm, "dot() requires a typed array, not %s", value_class_name(args[1]));
+    }
+
+    if (array->kind == TYPED_INT32 && other->kind == TYPED_INT32) {
+        int64_t result;
+        if (!tk_dot_i32(array->data.i32, other->data.i32, array->length, &result)) {
+            runtime_error(vm, "dot() overflowed");
+        }
+        return make_int64_value(result);
+    }
+    typed_array_t* a = widen(vm, array, "dot");
+    typed_array_t* b = widen(vm, other, "dot");
+    double result = tk_dot_f64(a->data.f64, b->data.f64, array->length);
+    typed_array_release(a);
+    typed_array_release(b);
+    return make_float64(result);
+}
+
+// New array of `array op other`, where other is a same-length typed array or a number. Int32 with
+// Int32 stays Int32 (wrapping on overflow) except for division; anything else is Float64.
+static value_t elementwise(vm_t* vm, int arg_count, value_t* args, tk_op op, const char* name) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 1, name);
+    value_t other = args[1];
+    size_t n = array->length;
+
+    typed_array_t* other_array = same_length_operand(vm, array, other, name);
+    if (!other_array && !is_number(other)) {
+        runtime_error(vm, "%s() requires a typed array or a number, not %s", name, value_class_name(other));
+    }
+
+    int other_is_int = other_array ? other_array->kind == TYPED_INT32 : other.type == VAL_INT32;
+    if (op != TK_DIV && array->kind == TYPED_INT32 && other_is_int) {
+        typed_array_t* result = allocate(vm, TYPED_INT32, n, name);
+        if (other_array) {
+            tk_binary_i32(op, result->data.i32, array->data.i32, other_array->data.i32, n);
+        } else {
+            tk_binary_scalar_i32(op, result->data.i32, array->data.i32, other.as.int32, n);
+        }
+        return make_typed_array(result);
+    }
+
+    typed_array_t* result = allocate(vm, TYPED_FLOAT64, n, name);
+    typed_array_t* a = widen(vm, array, name);
+    if (other_array) {
+        typed_array_t* b = widen(vm, other_array, name);
+        tk_binary_f64(op, result->data.f64, a->data.f64, b->data.f64, n);
+        typed_array_release(b);
+    } else {
+        tk_binary_scalar_f64(op, result->data.f64, a->data.f64, value_to_float64(other), n);
+    }
+    typed_array_release(a);
+    return make_typed_array(result);
+}
+
+// typedArray.add(other) - Element-wise sum with a typed array or a number
+value_t builtin_typed_array_add(vm_t* vm, int arg_count, value_t* args) {
+    return elementwise(vm, arg_count, args, TK_ADD, "add");
+}
+
+// typedArray.sub(other) - Element-wise difference with a typed array or a number
+value_t builtin_typed_array_sub(vm_t* vm, int arg_count, value_t* args) {
+    return elementwise(vm, arg_count, args, TK_SUB, "sub");
+}
+
+// typedArray.mul(other) - Element-wise product with a typed array or a number
+value_t builtin_typed_array_mul(vm_t* vm, int arg_count, value_t* args) {
+    return elementwise(vm, arg_count, args, TK_MUL, "mul");
+}
+
+// typedArray.div(other) - Element-wise quotient as a Float64Array (IEEE: x / 0 is infinite)
+value_t builtin_typed_array_div(vm_t* vm, int arg_count, value_t* args) {
+    return elementwise(vm, arg_count, args, TK_DIV, "div");
+}
+
+// typedArray.fill(value) - Set every element in place; returns the array
+value_t builtin_typed_array_fill(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 1, "fill");
+    value_t value = args[1];
+    if (array->kind == TYPED_INT32) {
+        if (value.type != VAL_INT32) {
+            runtime_error(vm, "fill() on an Int32Array requires an Int32, not %s", value_class_name(value));
+        }
+        tk_fill_i32(array->data.i32, value.as.int32, array->length);
+    } else {
+        if (!is_number(value)) {
+            runtime_error(vm, "fill() requires a number, not %s", value_class_name(value));
+        }
+        tk_fill_f64(array->data.f64, value_to_float64(value), array->length);
+    }
+    return vm_retain(args[0]);
+}
+
+static void require_min_above(vm_t* vm, typed_array_t* array, double bound, int inclusive, const char* message) {
+    if (array->length == 0) {
+        return;
+    }
+    double min;
+    if (array->kind == TYPED_INT32) {
+        int32_t min_int, max_int;
+        tk_min_max_i32(array->data.i32, array->length, &min_int, &max_int);
+        min = min_int;
+    } else {
+        double max;
+        tk_min_max_f64(array->data.f64, array->length, &min, &max);
+    }
+    if (inclusive ? min < bound : min <= bound) {
+        runtime_error(vm, "%s", message);
+    }
+}
+
+// map() with one of the math builtins runs a kernel instead of calling it per element.
+// Returns 0 for any other function.
+static int map_builtin(vm_t* vm, typed_array_t* array, native_t fn, value_t* out) {
+    size_t n = array->length;
+    int is_int = array->kind == TYPED_INT32;
+
+    // Integers are their own floor/ceil/round, just as the builtins leave Ints unchanged
+    if (fn == builtin_floor || fn == builtin_ceil || fn == builtin_round) {
+        typed_array_t* result = allocate(vm, array->kind, n, "map");
+        if (is_int) {
+            memcpy(result->data.i32, array->data.i32, n * sizeof(int32_t));
+        } else if (fn == builtin_round) {
+            for (size_t i = 0; i < n; i++) {
+                result->data.f64[i] = round(array->data.f64[i]);
+            }
+        } else {
+            tk_unary_f64(fn == builtin_floor ? TK_FLOOR : TK_CEIL, result->data.f64, array->data.f64, n);
+        }
+        *out = make_typed_array(result);
+        return 1;
+    }
+    if (fn == builtin_abs) {
+        typed_array_t* result = allocate(vm, array->kind, n, "map");
+        if (is_int) {
+            tk_abs_i32(result->data.i32, array->data.i32, n);
+        } else {
+            tk_unary_f64(TK_ABS, result->data.f64, array->data.f64, n);
+        }
+        *out = make_typed_array(result);
+        return 1;
+    }
+
+    double (*math)(double) = NULL;
+    if (fn == builtin_sqrt) {
+        require_min_above(vm, array, 0.0, 1, "sqrt() of negative number");
+    } else if (fn == builtin_ln) {
+        require_min_above(vm, array, 0.0, 0, "ln() domain error: argument must be positive");
+        math = log;
+    } else if (fn == builtin_exp) {
+        math = exp;
+    } else if (fn == builtin_sin) {
+        math = sin;
+    } else if (fn == builtin_cos) {
+        math = cos;
+    } else if (fn == builtin_tan) {
+        math = tan;
+    } else {
+        return 0;
+    }
+
+    // The rest always produce Float64
+    typed_array_t* result = allocate(vm, TYPED_FLOAT64, n, "map");
+    const double* source = array->data.f64;
+    if (is_int) {
+        tk_i32_to_f64(result->data.f64, array->data.i32, n);
+        source = result->data.f64;
+    }
+    if (math) {
+        for (size_t i = 0; i < n; i++) {
+            result->data.f64[i] = math(source[i]);
+        }
+    } else {
+        tk_unary_f64(TK_SQRT, result->data.f64, source, n);
+    }
+    *out = make_typed_array(result);
+    return 1;
+}
+
+// typedArray.map(fn) - New array of the same type with fn applied to each element.
+// abs, sqrt, floor, ceil, round, exp, ln, sin, cos and tan run without calling back per element.
+value_t builtin_typed_array_map(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 1, "map");
+    value_t fn = args[1];
+    if (fn.type != VAL_NATIVE && fn.type != VAL_CLOSURE && fn.type != VAL_FUNCTION) {
+        runtime_error(vm, "map() expects a function");
+    }
+
+    value_t result_value;
+    if (fn.type == VAL_NATIVE && map_builtin(vm, array, fn.as.native, &result_value)) {
+        return result_value;
+    }
+
+    typed_array_t* result = allocate(vm, array->kind, array->length, "map");
+    for (size_t i = 0; i < array->length; i++) {
+        value_t element = typed_array_get(array, i);
+        value_t mapped = vm_call_slate_function_safe(vm, fn, 1, &element);
+        if (!typed_array_set(result, i, mapped)) {
+            const char* type = value_class_name(mapped);
+            typed_array_release(result);
+            vm_release(mapped);
+            runtime_error(vm, "map() on %s must return %s, not %s", typed_array_class_name(array->kind),
+                          array->kind == TYPED_INT32 ? "Int32 values" : "numbers", type);
+        }
+        vm_release(mapped);
+    }
+    return make_typed_array(result);
+}
+
+// typedArray.copy() - Independent copy
+value_t builtin_typed_array_copy(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "copy");
+    typed_array_t* result = allocate(vm, array->kind, array->length, "copy");
+    memcpy(result->data.bytes, array->data.bytes, array->length * element_size(array->kind));
+    return make_typed_array(result);
+}
+
+// typedArray.toArray() - Regular array of the elements
+value_t builtin_typed_array_to_array(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "toArray");
+    da_array result = da_new(sizeof(value_t));
+    da_reserve(result, array->length);
+    for (size_t i = 0; i < array->length; i++) {
+        value_t element = typed_array_get(array, i);
+        da_push(result, &element);
+    }
+    return make_array(result);
+}
+
+// typedArray.toBuffer() - The raw elements in native byte order (see fromBuffer)
+value_t builtin_typed_array_to_buffer(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "toBuffer");
+    return make_buffer(db_new_with_data(array->data.bytes, array->length * element_size(array->kind)));
+}
+
+// typedArray.hash() - FNV-1a over the element bytes
+value_t builtin_typed_array_hash(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "hash");
+    const uint32_t FNV_32_PRIME = 0x01000193;
+    const uint32_t FNV_32_OFFSET_BASIS = 0x811c9dc5;
+
+    uint32_t hash = FNV_32_OFFSET_BASIS ^ (uint32_t)array->kind;
+    const uint8_t* bytes = array->data.bytes;
+    size_t size = array->length * element_size(array->kind);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_32_PRIME;
+    }
+    return make_int32((int32_t)hash);
+}
+
+// typedArray.equals(other) - Same type, length and elements
+value_t builtin_typed_array_equals(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 1, "equals");
+    if (args[1].type != VAL_TYPED_ARRAY) {
+        return make_boolean(0);
+    }
+    typed_array_t* other = args[1].as.typed_array;
+    if (other->kind != array->kind || other->length != array->length) {
+        return make_boolean(0);
+    }
+    if (array->kind == TYPED_INT32) {
+        return make_boolean(memcmp(array->data.i32, other->data.i32, array->length * sizeof(int32_t)) == 0);
+    }
+    for (size_t i = 0; i < array->length; i++) {
+        if (array->data.f64[i] != other->data.f64[i]) {
+            return make_boolean(0);
+        }
+    }
+    return make_boolean(1);
+}
+
+// typedArray.toString() - "Int32Array[1, 2, 3]"
+value_t builtin_typed_array_to_string(vm_t* vm, int arg_count, value_t* args) {
+    typed_array_t* array = receiver_array(vm, arg_count, args, 0, "toString");
+    return make_string_ds(typed_array_to_display_string(vm, array));
+}
@@ -0,0 +1,48 @@
+#ifndef CLASS_TYPED_ARRAY_H
+#define CLASS_TYPED_ARRAY_H
+
+#include "vm.h"
+#include "value.h"
+#include "runtime_error.h"
+
+// Int32Array and Float64Array: fixed-length arrays of unboxed numbers (4 or 8 bytes per element
+// instead of a value_t each). Bulk operations run the SIMD kernels in kernels.h.
+
+// TypedArray Class Initialization (both classes)
+void typed_array_class_init(vm_t* vm);
+
+// Factory Functions
+value_t int32_array_factory(vm_t* vm, class_t* self, int arg_count, value_t* args);
+value_t float64_array_factory(vm_t* vm, class_t* self, int arg_count, value_t* args);
+
+// Static Methods
+value_t builtin_int32_array_from_buffer(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_float64_array_from_buffer(vm_t* vm, int arg_count, value_t* args);
+
+// Instance Methods (shared by both classes)
+value_t builtin_typed_array_length(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_sum(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_min(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_max(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_dot(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_add(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_sub(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_mul(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_div(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_fill(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_map(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_copy(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_to_array(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_to_buffer(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_hash(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_equals(vm_t* vm, int arg_count, value_t* args);
+value_t builtin_typed_array_to_string(vm_t* vm, int arg_count, value_t* args);
+
+// Shared helpers
+const char* typed_array_class_name(typed_array_kind kind);
+value_t typed_array_get(typed_array_t* array, size_t index); // index < length
+// Store a number at index (index < length). Returns 0 if it doesn't fit the element type.
+int typed_array_set(typed_array_t* array, size_t index, value_t value);
+ds_string typed_array_to_display_string(vm_t* vm, typed_array_t* array);
+
+#endif // CLASS_TYPED_ARRAY_H
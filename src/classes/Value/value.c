@@ -1,5 +1,11 @@
 #include "value.h"
 #include "builtins.h"
+#include "../ADT/adt_methods.h"
+#include "../TypedArray/typed_array.h"
+#include "../Map/map.h"
+#include "../Number/number_format.h"
+#include "date.h"
+#include "timezone.h"
 #include "dynamic_string.h"
 #include "dynamic_array.h"
 #include "dynamic_buffer.h"
@@ -112,6 +118,21 @@ value_t builtin_type(vm_t* vm, int arg_count, value_t* args) {
     case VAL_PERIOD:
         type_name = "Period";
         break;
+    case VAL_ADT:
+        type_name = "object"; // Data instances are objects to scripts; VAL_ADT is only their layout
+        break;
+    case VAL_PROMISE:
+        type_name = "Promise";
+        break;
+    case VAL_TYPED_ARRAY:
+        type_name = typed_array_class_name(arg.as.typed_array->kind);
+        break;
+    case VAL_MAP:
+        type_name = "Map";
+        break;
+    case VAL_SET:
+        type_name = "Set";
+        break;
     default:
         type_name = "unknown";
         break;
@@ -140,9 +161,8 @@ value_t builtin_value_to_string(vm_t* vm, int arg_count, value_t* args) {
             
         case VAL_INT32:
             {
-                char buffer[32];
-                snprintf(buffer, sizeof(buffer), "%d", receiver.as.int32);
-                return make_string(buffer);
+                char buffer[NF_MAX_LENGTH];
+                return make_string_ds(ds_create_length(buffer, nf_format_int32(buffer, receiver.as.int32)));
             }
             
         case VAL_BIGINT:
@@ -155,32 +175,14 @@ value_t builtin_value_to_string(vm_t* vm, int arg_count, value_t* args) {
             
         case VAL_FLOAT32:
             {
-                float val = receiver.as.float32;
-                if (isnan(val)) {
-                    return make_string("NaN");
-                } else if (isinf(val)) {
-                    return make_string(val > 0 ? "Infinity" : "-Infinity");
-                } else {
-                    char buffer[32];
-                    // Use %.7g for clean formatting without unnecessary zeros (float32 precision)
-                    snprintf(buffer, sizeof(buffer), "%.7g", val);
-                    return make_string(buffer);
-                }
+                char buffer[NF_MAX_LENGTH];
+                return make_string_ds(ds_create_length(buffer, nf_format_float32(buffer, receiver.as.float32)));
             }
             
         case VAL_FLOAT64:
             {
-                double val = receiver.as.float64;
-                if (isnan(val)) {
-                    return make_string("NaN");
-                } else if (isinf(val)) {
-                    return make_string(val > 0 ? "Infinity" : "-Infinity");
-                } else {
-                    char buffer[64];
-                    // Use %.15g for clean formatting without unnecessary zeros
-                    snprintf(buffer, sizeof(buffer), "%.15g", val);
-                    return make_string(buffer);
-                }
+                char buffer[NF_MAX_LENGTH];
+                return make_string_ds(ds_create_length(buffer, nf_format_float64(buffer, receiver.as.float64)));
             }
             
         case VAL_STRING:
@@ -328,6 +330,21 @@ value_t builtin_value_to_string(vm_t* vm, int arg_count, value_t* args) {
         case VAL_BOUND_METHOD:
             return make_string("Bound Method");
             
+        case VAL_ADT:
+            return adt_instance_toString(vm, 1, &receiver);
+            
+        case VAL_PROMISE: {
+            ds_string str = display_value_to_string(vm, receiver);
+            return make_string_ds(str);
+        }
+
+        case VAL_TYPED_ARRAY:
+            return builtin_typed_array_to_string(vm, arg_count, args);
+
+        case VAL_MAP:
+        case VAL_SET:
+            return make_string_ds(map_to_display_string(vm, receiver));
+            
         default:
             return make_string("unknown");
     }
@@ -337,6 +354,18 @@ value_t builtin_value_to_string(vm_t* vm, int arg_count, value_t* args) {
 #define FNV_32_PRIME 0x01000193
 #define FNV_32_OFFSET_BASIS 0x811c9dc5
 
+// Folds 64 bits into a 32-bit hash
+static uint32_t hash_int64(int64_t value) {
+    uint64_t bits = (uint64_t)value;
+    return (uint32_t)(bits ^ (bits >> 32)) * FNV_32_PRIME;
+}
+
+// Nanoseconds since midnight, the quantity local_time_compare() orders by
+static int64_t local_time_total_nanos(const local_time_t* time) {
+    return (int64_t)time->hour * 3600000000000LL + (int64_t)time->minute * 60000000000LL +
+           (int64_t)time->second * 1000000000LL + time->nanos;
+}
+
 // builtin_value_hash() - Universal hash function for all value types
 value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args) {
     if (arg_count != 1) {
@@ -409,17 +438,10 @@ value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args) {
         break;
     }
         
-    case VAL_STRING: {
-        // FNV-1a hash for strings
-        hash = FNV_32_OFFSET_BASIS;
-        if (value.as.string) {
-            for (const char* p = value.as.string; *p; p++) {
-                hash ^= (uint8_t)*p;
-                hash *= FNV_32_PRIME;
-            }
-        }
+    case VAL_STRING:
+        // Same as String.hash(): FNV-1a, cached in the string's header
+        hash = value.as.string ? ds_hash32(value.as.string) : FNV_32_OFFSET_BASIS;
         break;
-    }
         
     case VAL_ARRAY: {
         // Combine hash codes of all elements
@@ -450,6 +472,28 @@ value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args) {
         break;
     }
         
+    case VAL_ADT: {
+        // Constructor tag and fields, same as ADT.hash()
+        value_t adt_hash = adt_instance_hash(vm, 1, &value);
+        hash = (uint32_t)adt_hash.as.int32;
+        break;
+    }
+
+    case VAL_TYPED_ARRAY: {
+        // Element bytes, same as typedArray.hash()
+        value_t array_hash = builtin_typed_array_hash(vm, 1, &value);
+        hash = (uint32_t)array_hash.as.int32;
+        break;
+    }
+
+    case VAL_MAP:
+    case VAL_SET: {
+        // Entries in any order, same as map.hash() / set.hash()
+        value_t map_hash = value.type == VAL_MAP ? builtin_map_hash(vm, 1, &value) : builtin_set_hash(vm, 1, &value);
+        hash = (uint32_t)map_hash.as.int32;
+        break;
+    }
+        
     case VAL_RANGE: {
         // Hash based on start, end, and exclusive flag
         range_t* range = value.as.range;
@@ -492,6 +536,37 @@ value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args) {
         break;
     }
         
+    // Dates and times hash what their equals() compares
+    case VAL_LOCAL_DATE:
+        hash = value.as.local_date->epoch_day * FNV_32_PRIME;
+        break;
+
+    case VAL_LOCAL_TIME:
+        hash = hash_int64(local_time_total_nanos(value.as.local_time));
+        break;
+
+    case VAL_LOCAL_DATETIME:
+        hash = value.as.local_datetime->date->epoch_day * FNV_32_PRIME;
+        hash ^= hash_int64(local_time_total_nanos(value.as.local_datetime->time));
+        break;
+
+    case VAL_DATE:
+        hash = hash_int64(date_to_epoch_millis(value.as.date));
+        break;
+
+    case VAL_INSTANT:
+        hash = hash_int64(value.as.instant_millis);
+        break;
+
+    case VAL_ZONE: {
+        hash = FNV_32_OFFSET_BASIS;
+        for (const char* p = timezone_get_id(value.as.zone); *p; p++) {
+            hash ^= (uint8_t)*p;
+            hash *= FNV_32_PRIME;
+        }
+        break;
+    }
+
     case VAL_CLASS:
     case VAL_FUNCTION:
     case VAL_CLOSURE:
@@ -501,16 +576,11 @@ value_t builtin_value_hash(vm_t* vm, int arg_count, value_t* args) {
     case VAL_STRING_BUILDER:
     case VAL_BUFFER_BUILDER:
     case VAL_BUFFER_READER:
-    case VAL_LOCAL_DATE:
-    case VAL_LOCAL_TIME:
-    case VAL_LOCAL_DATETIME:
-    case VAL_ZONE:
-    case VAL_DATE:
-    case VAL_INSTANT:
     case VAL_DURATION:
     case VAL_PERIOD:
+    case VAL_PROMISE:
         // For these types, use pointer identity
-        hash = (uint32_t)(uintptr_t)&value;
+        hash = hash_int64((int64_t)(uintptr_t)value.as.native);
         break;
         
     default:
@@ -4,7 +4,7 @@
 #include "dynamic_object.h"
 
 // Global reference to Zone class (declared in value.h)
-value_t* global_zone_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_zone_class = NULL;
 
 // Initialize Zone class with prototype and methods
 void init_zone_class(vm_t* vm) {
@@ -51,7 +51,7 @@ void init_zone_class(vm_t* vm) {
     do_set(vm->globals, "Zone", &zone_class, sizeof(value_t));
     
     // Store a global reference for use in make_zone_direct
-    static value_t zone_class_storage;
+    static SLATE_ISOLATE_LOCAL value_t zone_class_storage;
     zone_class_storage = vm_retain(zone_class);
     global_zone_class = &zone_class_storage;
 }
@@ -16,6 +16,7 @@ bytecode_chunk* chunk_create(void) {
     chunk->constant_count = 0;
     chunk->constant_capacity = 0;
     chunk->debug = NULL; // No debug info by default
+    chunk->local_types = NULL;
     
     return chunk;
 }
@@ -44,6 +45,7 @@ void chunk_destroy(bytecode_chunk* chunk) {
     free(chunk->constants);
     
     debug_info_destroy(chunk->debug);
+    free(chunk->local_types);
     
     free(chunk);
 }
@@ -8,6 +8,8 @@
 function_t* codegen_compile(codegen_t* codegen, ast_program* program) {
     if (!codegen || !program) return NULL;
     
+    codegen_infer_types(codegen, program->statements, program->statement_count, NULL, 0);
+    
     // Generate code for all statements
     for (size_t i = 0; i < program->statement_count; i++) {
         codegen_emit_statement(codegen, program->statements[i]);
@@ -51,6 +53,8 @@ function_t* codegen_compile(codegen_t* codegen, ast_program* program) {
     // Transfer debug info
     function->debug = codegen->chunk->debug;
     codegen->chunk->debug = NULL; // Transfer ownership
+    function->local_types = codegen->chunk->local_types;
+    codegen->chunk->local_types = NULL;
     
     return function;
 }
\ No newline at end of file
@@ -323,4 +323,10 @@ void codegen_emit_return(codegen_t* codegen, ast_return* node) {
     }
     
     codegen_emit_op(codegen, OP_RETURN);
+}
+
+void codegen_emit_yield(codegen_t* codegen, ast_yield* node) {
+    codegen_emit_expression(codegen, node->value);
+    // Suspends the generator; on resume the yield expression evaluates to null
+    codegen_emit_op(codegen, OP_YIELD);
 }
\ No newline at end of file
@@ -11,6 +11,9 @@ void chunk_disassemble(bytecode_chunk* chunk, const char* name) {
 
 void chunk_disassemble_with_vm(bytecode_chunk* chunk, const char* name, vm_t* vm) {
     printf("== %s ==\n", name);
+    if (chunk->local_types) {
+        printf("; inferred types: %s\n", chunk->local_types);
+    }
     
     for (size_t offset = 0; offset < chunk->count;) {
         offset = disassemble_instruction_with_vm(chunk, offset, vm);
@@ -46,7 +49,8 @@ size_t disassemble_instruction_with_vm(bytecode_chunk* chunk, size_t offset, vm_
                         .code = func->bytecode,
                         .count = func->bytecode_length,
                         .constants = func->constants,
-                        .constant_count = func->constant_count
+                        .constant_count = func->constant_count,
+                        .local_types = func->local_types
                     };
                     chunk_disassemble_with_vm(&func_chunk, func->name ? func->name : "<anonymous>", vm);
                     printf("\n");
@@ -55,7 +59,8 @@ size_t disassemble_instruction_with_vm(bytecode_chunk* chunk, size_t offset, vm_
             return offset + 3;
         }
         
-        case OP_CLOSURE: {
+        case OP_CLOSURE:
+        case OP_CLOSURE_LOCAL: {
             uint16_t constant = chunk->code[offset + 1] | (chunk->code[offset + 2] << 8);
             printf("%-16s %4d ", opcode_name(instruction), constant);
             if (constant >= chunk->constant_count) {
@@ -73,14 +78,15 @@ size_t disassemble_instruction_with_vm(bytecode_chunk* chunk, size_t offset, vm_
                     
                     // Disassemble the function if we have VM access
                     if (func_index >= 0 && (size_t)func_index < da_length(vm->functions)) {
-                        function_t* func = da_get(vm->functions, func_index);
+                        function_t* func = vm_get_function(vm, (size_t)func_index);
                         if (func) {
                             printf("\n");
                             bytecode_chunk func_chunk = {
                                 .code = func->bytecode,
                                 .count = func->bytecode_length,
                                 .constants = func->constants,
-                                .constant_count = func->constant_count
+                                .constant_count = func->constant_count,
+                                .local_types = func->local_types
                             };
                             chunk_disassemble_with_vm(&func_chunk, func->name ? func->name : "<anonymous>", vm);
                             printf("\n");
@@ -93,21 +99,75 @@ size_t disassemble_instruction_with_vm(bytecode_chunk* chunk, size_t offset, vm_
             return offset + 3;
         }
         
+        case OP_GET_LOCAL:
+        case OP_SET_LOCAL:
+        case OP_GET_UPVALUE:
+        case OP_SET_UPVALUE:
+        case OP_POP_N:
+        case OP_APPEND_LOCAL: {
+            uint8_t operand = chunk->code[offset + 1];
+            printf("%-16s %4d\n", opcode_name(instruction), operand);
+            return offset + 2;
+        }
+        
+        case OP_DEFINE_GLOBAL: {
+            uint16_t constant = chunk->code[offset + 1] | (chunk->code[offset + 2] << 8);
+            uint8_t is_immutable = chunk->code[offset + 3];
+            printf("%-16s %4d%s\n", opcode_name(instruction), constant, is_immutable ? " (immutable)" : "");
+            return offset + 4;
+        }
+        
         case OP_BUILD_ARRAY:
+        case OP_CONCAT_N:
         case OP_BUILD_OBJECT:
+        case OP_BUILD_RANGE:
         case OP_CALL:
+        case OP_CALL_METHOD:
+        case OP_RELEASE_LOCAL_CLOSURES:
+        case OP_CREATE_ADT_CONSTRUCTOR:
+        case OP_POP_N_PRESERVE_TOP:
         case OP_GET_GLOBAL:
         case OP_SET_GLOBAL:
-        case OP_DEFINE_GLOBAL:
+        case OP_APPEND_GLOBAL: {
+            uint16_t operand = chunk->code[offset + 1] | (chunk->code[offset + 2] << 8);
+            printf("%-16s %4d\n", opcode_name(instruction), operand);
+            return offset + 3;
+        }
+        
         case OP_JUMP:
         case OP_JUMP_IF_FALSE:
         case OP_JUMP_IF_TRUE:
         case OP_LOOP: {
             uint16_t operand = chunk->code[offset + 1] | (chunk->code[offset + 2] << 8);
-            printf("%-16s %4d\n", opcode_name(instruction), operand);
+            // OP_JUMP is signed (loops close with a backward jump), OP_LOOP always goes back
+            long target = (long)offset + 3;
+            if (instruction == OP_JUMP) {
+                target += (int16_t)operand;
+            } else if (instruction == OP_LOOP) {
+                target -= operand;
+            } else {
+                target += operand;
+            }
+            printf("%-16s %4d (-> %ld)\n", opcode_name(instruction), operand, target);
             return offset + 3;
         }
         
+        case OP_MATCH_SWITCH: {
+            uint8_t kind = chunk->code[offset + 1];
+            uint16_t miss = chunk->code[offset + 2] | (chunk->code[offset + 3] << 8);
+            uint16_t count = chunk->code[offset + 8] | (chunk->code[offset + 9] << 8);
+            size_t entry_size = kind == MATCH_SWITCH_INT32 ? 2 : 8;
+            size_t end = offset + 10 + count * entry_size;
+            if (kind == MATCH_SWITCH_INT32) {
+                int32_t min = (int32_t)(chunk->code[offset + 4] | (chunk->code[offset + 5] << 8) |
+                                        (chunk->code[offset + 6] << 16) | ((uint32_t)chunk->code[offset + 7] << 24));
+                printf("%-16s int32 %d..%d (miss -> %zu)\n", opcode_name(instruction), min, min + count - 1, end + miss);
+            } else {
+                printf("%-16s string %d slots (miss -> %zu)\n", opcode_name(instruction), count, end + miss);
+            }
+            return end;
+        }
+        
         case OP_SET_DEBUG_LOCATION: {
             uint16_t constant = chunk->code[offset + 1] | (chunk->code[offset + 2] << 8);
             uint8_t line = chunk->code[offset + 3];
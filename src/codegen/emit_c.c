@@ -0,0 +1,306 @@
+#include "codegen.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// C translation of compiled functions for ahead-of-time builds (slate --emit-c, see aot.h).
+// Every instruction becomes a call to its op_* handler; jumps become gotos between labels.
+
+static void emit_c_string(FILE* out, const char* text, size_t length) {
+    fputc('"', out);
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\' || c == '?') {
+            fprintf(out, "\\%c", c);
+        } else if (c >= 0x20 && c < 0x7F) {
+            fputc(c, out);
+        } else {
+            fprintf(out, "\\%03o", c); // Fixed-width octal can't swallow the next character
+        }
+    }
+    fputc('"', out);
+}
+
+static void emit_handler_name(FILE* out, opcode op) {
+    fputs("op_", out);
+    for (const char* c = opcode_name(op); *c; c++) {
+        fputc(tolower((unsigned char)*c), out);
+    }
+}
+
+static uint16_t read_u16(const uint8_t* code, size_t offset) {
+    return code[offset] | (code[offset + 1] << 8);
+}
+
+// Target of a jump instruction (may be out of range for malformed bytecode)
+static long jump_target(const uint8_t* code, size_t offset) {
+    uint16_t operand = read_u16(code, offset + 1);
+    switch ((opcode)code[offset]) {
+    case OP_JUMP:
+        return (long)offset + 3 + (int16_t)operand;
+    case OP_LOOP:
+        return (long)offset + 3 - operand;
+    default:
+        return (long)offset + 3 + operand;
+    }
+}
+
+static void emit_constant(FILE* out, value_t value) {
+    double number;
+    uint64_t bits;
+    switch (value.type) {
+    case VAL_INT32:
+        fprintf(out, "{AOT_CONST_INT32, %d, 0, NULL, 0}", (int)value.as.int32);
+        break;
+    case VAL_FLOAT32:
+    case VAL_FLOAT64:
+        number = value.type == VAL_FLOAT32 ? (double)value.as.float32 : value.as.float64;
+        memcpy(&bits, &number, sizeof(bits));
+        fprintf(out, "{%s, 0, 0x%016llxULL, NULL, 0}",
+                value.type == VAL_FLOAT32 ? "AOT_CONST_FLOAT32" : "AOT_CONST_FLOAT64", (unsigned long long)bits);
+        break;
+    case VAL_BIGINT: {
+        char* digits = di_to_string(value.as.bigint, 10);
+        fputs("{AOT_CONST_BIGINT, 0, 0, ", out);
+        emit_c_string(out, digits, strlen(digits));
+        fprintf(out, ", %zu}", strlen(digits));
+        free(digits);
+        break;
+    }
+    case VAL_STRING:
+        fputs("{AOT_CONST_STRING, 0, 0, ", out);
+        emit_c_string(out, value.as.string, ds_length(value.as.string));
+        fprintf(out, ", %zu}", ds_length(value.as.string));
+        break;
+    default:
+        fputs("{AOT_CONST_NULL, 0, 0, NULL, 0}", out);
+        break;
+    }
+}
+
+// Static tables for one function: bytecode, constants, parameter names, upvalue descriptors
+static void emit_function_data(FILE* out, function_t* function, const char* id) {
+    fprintf(out, "static const uint8_t %s_code[] = {", id);
+    for (size_t i = 0; i < function->bytecode_length; i++) {
+        fprintf(out, "%s0x%02x,", i % 16 == 0 ? "\n    " : " ", function->bytecode[i]);
+    }
+    fputs("\n};\n", out);
+
+    if (function->constant_count > 0) {
+        fprintf(out, "static const aot_constant %s_constants[] = {\n", id);
+        for (size_t i = 0; i < function->constant_count; i++) {
+            fputs("    ", out);
+            emit_constant(out, function->constants[i]);
+            fputs(",\n", out);
+        }
+        fputs("};\n", out);
+    }
+
+    if (function->parameter_count > 0) {
+        fprintf(out, "static const char* const %s_parameters[] = {", id);
+        for (size_t i = 0; i < function->parameter_count; i++) {
+            emit_c_string(out, function->parameter_names[i], strlen(function->parameter_names[i]));
+            fputs(i + 1 < function->parameter_count ? ", " : "", out);
+        }
+        fputs("};\n", out);
+    }
+
+    if (function->upvalue_count > 0) {
+        fprintf(out, "static const upvalue_desc_t %s_upvalues[] = {", id);
+        for (size_t i = 0; i < function->upvalue_count; i++) {
+            fprintf(out, "{%d, %d}%s", function->upvalue_descriptors[i].index,
+                    function->upvalue_descriptors[i].is_local, i + 1 < function->upvalue_count ? ", " : "");
+        }
+        fputs("};\n", out);
+    }
+}
+
+// The native body. Returns false if the bytecode can't be decoded.
+static bool emit_function_body(FILE* out, function_t* function, const char* id) {
+    const uint8_t* code = function->bytecode;
+    size_t length = function->bytecode_length;
+    bool* starts = calloc(length + 1, sizeof(bool));
+    bool* labels = calloc(length + 1, sizeof(bool));
+    bool has_switch = false;
+    bool ok = true;
+
+    // First pass: instruction boundaries and jump targets
+    for (size_t offset = 0; offset < length && ok;) {
+        size_t size = instruction_length(code, offset, length);
+        if (size == 0) {
+            ok = false;
+            break;
+        }
+        starts[offset] = true;
+        switch ((opcode)code[offset]) {
+        case OP_JUMP:
+        case OP_LOOP:
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE: {
+            long target = jump_target(code, offset);
+            if (target < 0 || (size_t)target > length) {
+                ok = false;
+            } else {
+                labels[target] = true;
+            }
+            break;
+        }
+        case OP_MATCH_SWITCH:
+            has_switch = true;
+            break;
+        default:
+            break;
+        }
+        offset += size;
+    }
+    starts[length] = true;
+    for (size_t offset = 0; offset <= length && ok; offset++) {
+        if (labels[offset] && !starts[offset]) ok = false;
+        // MATCH_SWITCH leaves its target in vm->ip, so any instruction may be resumed
+        if (has_switch && starts[offset]) labels[offset] = true;
+    }
+    if (!ok) {
+        free(starts);
+        free(labels);
+        return false;
+    }
+
+    fprintf(out, "static vm_result %s_native(vm_t* vm, size_t depth) {\n", id);
+    fputs("    uint8_t* code = vm->frames[depth - 1].closure->function->bytecode;\n", out);
+    fputs("    vm->bytecode = code;\n\n", out);
+
+    for (size_t offset = 0; offset < length;) {
+        opcode op = (opcode)code[offset];
+        size_t size = instruction_length(code, offset, length);
+        if (labels[offset]) fprintf(out, "L_%zu:\n", offset);
+        fputs("    ", out);
+
+        switch (op) {
+        case OP_JUMP:
+        case OP_LOOP:
+            fprintf(out, "goto L_%ld;\n", jump_target(code, offset));
+            break;
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+            fprintf(out, "AOT_BRANCH(%zu, ", offset);
+            emit_handler_name(out, op);
+            fprintf(out, ", %ld);\n", jump_target(code, offset));
+            break;
+        case OP_CALL:
+        case OP_CALL_METHOD:
+        case OP_GET_INDEX:
+            fprintf(out, "AOT_CALL(%zu, ", offset);
+            emit_handler_name(out, op);
+            fputs(");\n", out);
+            break;
+        default:
+            fprintf(out, "AOT_STEP(%zu, ", offset);
+            emit_handler_name(out, op);
+            fputs(");\n", out);
+            if (op == OP_RETURN || op == OP_HALT) {
+                fputs("    return VM_OK;\n", out);
+            } else if (op == OP_MATCH_SWITCH) {
+                fputs("    goto dispatch;\n", out);
+            }
+            break;
+        }
+        offset += size;
+    }
+
+    if (labels[length]) fprintf(out, "L_%zu:\n", length);
+    fputs("    return VM_RUNTIME_ERROR; // Ran off the end of the bytecode\n", out);
+
+    if (has_switch) {
+        fputs("\ndispatch:\n    switch (vm->ip - code) {\n", out);
+        for (size_t offset = 0; offset <= length; offset++) {
+            if (starts[offset]) fprintf(out, "    case %zu: goto L_%zu;\n", offset, offset);
+        }
+        fputs("    }\n    return VM_RUNTIME_ERROR;\n", out);
+    }
+    fputs("}\n", out);
+
+    free(starts);
+    free(labels);
+    return true;
+}
+
+static void emit_function_entry(FILE* out, function_t* function, const char* id) {
+    fputs("    {", out);
+    if (function->name) {
+        emit_c_string(out, function->name, strlen(function->name));
+    } else {
+        fputs("NULL", out);
+    }
+    fprintf(out, ", %s_code, sizeof(%s_code), ", id, id);
+    if (function->constant_count > 0) {
+        fprintf(out, "%s_constants, %zu, ", id, function->constant_count);
+    } else {
+        fputs("NULL, 0, ", out);
+    }
+    if (function->parameter_count > 0) {
+        fprintf(out, "%s_parameters, %zu, ", id, function->parameter_count);
+    } else {
+        fputs("NULL, 0, ", out);
+    }
+    fprintf(out, "%zu, ", function->local_count);
+    if (function->upvalue_count > 0) {
+        fprintf(out, "%s_upvalues, %zu, ", id, function->upvalue_count);
+    } else {
+        fputs("NULL, 0, ", out);
+    }
+    if (function->is_generator) {
+        fputs("1, NULL}", out);
+    } else {
+        fprintf(out, "0, %s_native}", id);
+    }
+}
+
+static bool emit_function(FILE* out, function_t* function, const char* id) {
+    fprintf(out, "\n// %s\n", function->name ? function->name : id);
+    emit_function_data(out, function, id);
+    fputc('\n', out);
+    // A native body can't suspend; generators are resumed by the interpreter from their bytecode
+    if (function->is_generator) return true;
+    return emit_function_body(out, function, id);
+}
+
+int codegen_emit_c(vm_t* vm, function_t* main_function, size_t first_function, const char* source_name, FILE* out) {
+    if (!vm || !main_function || !out) return 1;
+
+    size_t function_count = vm->functions->length - first_function;
+    char id[32];
+
+    fprintf(out, "// Generated by slate --emit-c from %s - do not edit\n", source_name ? source_name : "<script>");
+    fputs("#include \"aot.h\"\n", out);
+
+    for (size_t i = 0; i < function_count; i++) {
+        snprintf(id, sizeof(id), "fn%zu", first_function + i);
+        if (!emit_function(out, vm_get_function(vm, first_function + i), id)) {
+            fprintf(stderr, "Cannot translate bytecode of function %zu\n", first_function + i);
+            return 1;
+        }
+    }
+    if (!emit_function(out, main_function, "script")) {
+        fprintf(stderr, "Cannot translate bytecode of the main script\n");
+        return 1;
+    }
+
+    if (function_count > 0) {
+        fputs("\nstatic const aot_function functions[] = {\n", out);
+        for (size_t i = 0; i < function_count; i++) {
+            snprintf(id, sizeof(id), "fn%zu", first_function + i);
+            emit_function_entry(out, vm_get_function(vm, first_function + i), id);
+            fputs(",\n", out);
+        }
+        fputs("};\n", out);
+    }
+    fputs("\nstatic const aot_function script =\n", out);
+    emit_function_entry(out, main_function, "script");
+    fputs(";\n", out);
+
+    fprintf(out, "\nstatic const aot_program program = {%s, %zu, %zu, &script};\n",
+            function_count > 0 ? "functions" : "NULL", function_count, first_function);
+    fputs("\nint main(int argc, char** argv) {\n    return aot_main(&program, argc, argv);\n}\n", out);
+    return 0;
+}
@@ -7,6 +7,27 @@
 // Forward declarations
 void codegen_emit_template_literal(codegen_t* codegen, ast_template_literal* node);
 
+// Builtin higher-order methods that only call their function argument and never keep it.
+// Lambdas passed directly to them get a pooled closure (OP_CLOSURE_LOCAL) instead of a heap one.
+static const char* const lambda_consumer_methods[] = { "map", "filter", "flatMap" };
+
+static int codegen_is_lambda_consumer(ast_node* callee) {
+    if (callee->type != AST_MEMBER) return 0;
+    ast_member* member = (ast_member*)callee;
+    if (member->is_optional) return 0;
+    for (size_t i = 0; i < sizeof(lambda_consumer_methods) / sizeof(lambda_consumer_methods[0]); i++) {
+        if (strcmp(member->property, lambda_consumer_methods[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+// A pooled closure must be released before the enclosing frame can suspend, and a generator
+// outlives the call that created it, so neither a generator body nor a generator lambda uses one
+static int codegen_can_pool_closure(codegen_t* codegen, ast_node* node) {
+    return node->type == AST_FUNCTION && !codegen->is_generator &&
+           !((ast_function*)node)->is_generator;
+}
+
 // Expression code generation
 void codegen_emit_expression(codegen_t* codegen, ast_node* expr) {
     if (!expr) return;
@@ -136,17 +157,41 @@ void codegen_emit_expression(codegen_t* codegen, ast_node* expr) {
         
         case AST_CALL: {
             ast_call* call_node = (ast_call*)expr;
-            // Generate function/callable expression first
-            codegen_emit_expression(codegen, call_node->function);
+            uint16_t local_closures = 0;
+            // Generate function/callable expression first; an immediately-invoked lambda can't escape
+            if (codegen_can_pool_closure(codegen, call_node->function)) {
+                codegen_emit_local_function(codegen, (ast_function*)call_node->function);
+                local_closures++;
+            } else {
+                codegen_emit_expression(codegen, call_node->function);
+            }
             // Generate arguments (pushed left to right)
+            int consumes_lambdas = codegen_is_lambda_consumer(call_node->function);
             for (size_t i = 0; i < call_node->arg_count; i++) {
-                codegen_emit_expression(codegen, call_node->arguments[i]);
+                if (consumes_lambdas && codegen_can_pool_closure(codegen, call_node->arguments[i])) {
+                    codegen_emit_local_function(codegen, (ast_function*)call_node->arguments[i]);
+                    local_closures++;
+                } else {
+                    codegen_emit_expression(codegen, call_node->arguments[i]);
+                }
+            }
+            // One-argument calls are indistinguishable from indexing (arr(i), str(i)), so emit the
+            // dedicated index opcode; it falls back to a regular call for non-indexable callees
+            if (call_node->arg_count == 1 && call_node->function->type != AST_FUNCTION) {
+                codegen_emit_op(codegen, OP_GET_INDEX);
+            } else {
+                codegen_emit_op_operand(codegen, OP_CALL, (uint16_t)call_node->arg_count);
+            }
+            if (local_closures > 0) {
+                codegen_emit_op_operand(codegen, OP_RELEASE_LOCAL_CLOSURES, local_closures);
             }
-            // Emit call operation with argument count
-            codegen_emit_op_operand(codegen, OP_CALL, (uint16_t)call_node->arg_count);
             break;
         }
         
+        case AST_YIELD:
+            codegen_emit_yield(codegen, (ast_yield*)expr);
+            break;
+            
         case AST_FUNCTION:
             codegen_emit_function(codegen, (ast_function*)expr);
             break;
@@ -173,6 +218,7 @@ void codegen_emit_expression(codegen_t* codegen, ast_node* expr) {
                     // Local variable assignment with single byte operand
                     codegen_emit_op(codegen, OP_SET_LOCAL);
                     chunk_write_byte(codegen->chunk, (uint8_t)slot);
+                    codegen_emit_op(codegen, OP_POP);  // Remove the duplicate left by DUP since SET_LOCAL uses peek
                 } else if (upvalue_index != -1) {
                     // Upvalue assignment with single byte operand
                     codegen_emit_op(codegen, OP_SET_UPVALUE);
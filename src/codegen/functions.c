@@ -17,6 +17,7 @@ function_t* codegen_compile_function(codegen_t* parent_codegen, ast_function* fu
     
     // Set up parent-child relationship for upvalue resolution
     func_codegen->parent = parent_codegen;
+    func_codegen->is_generator = func_node->is_generator;
     
     // Create function object
     function_t* function = function_create(NULL);
@@ -27,6 +28,7 @@ function_t* codegen_compile_function(codegen_t* parent_codegen, ast_function* fu
     
     // Set up function metadata
     function->parameter_count = func_node->param_count;
+    function->is_generator = func_node->is_generator;
     function->local_count = func_node->param_count; // Will be updated as locals are added
     
     // Copy parameter names (function_destroy expects to own them)
@@ -70,6 +72,15 @@ function_t* codegen_compile_function(codegen_t* parent_codegen, ast_function* fu
         func_codegen->scope.locals[slot].is_initialized = 1;
     }
     
+    // Infer local types before emitting so arithmetic on typed locals can be specialized
+    if (func_node->is_expression) {
+        codegen_infer_types(func_codegen, &func_node->body, 1, func_node->parameters, func_node->param_count);
+    } else {
+        ast_block* block = (ast_block*)func_node->body;
+        codegen_infer_types(func_codegen, block->statements, block->statement_count,
+                            func_node->parameters, func_node->param_count);
+    }
+    
     // Compile function body based on type
     if (func_node->is_expression) {
         // Expression function: compile body as expression and return result
@@ -133,6 +144,8 @@ function_t* codegen_compile_function(codegen_t* parent_codegen, ast_function* fu
     
     // Update local count
     function->local_count = func_codegen->scope.local_count;
+    function->local_types = func_codegen->chunk->local_types;
+    func_codegen->chunk->local_types = NULL;
     
     // Transfer upvalue information
     function->upvalue_count = func_codegen->scope.upvalue_count;
@@ -170,4 +183,18 @@ void codegen_emit_function(codegen_t* codegen, ast_function* node) {
     size_t func_index = vm_add_function(codegen->vm, function);
     size_t constant = chunk_add_constant(codegen->chunk, make_int32((int32_t)func_index));
     codegen_emit_op_operand(codegen, OP_CLOSURE, (uint16_t)constant);
-}
\ No newline at end of file
+}
+
+// Non-escaping function expression: the closure comes from the VM pool and the caller must emit
+// OP_RELEASE_LOCAL_CLOSURES once the call consuming it has returned
+void codegen_emit_local_function(codegen_t* codegen, ast_function* node) {
+    function_t* function = codegen_compile_function(codegen, node);
+    if (!function) {
+        codegen_error(codegen, "Failed to compile function");
+        return;
+    }
+    
+    size_t func_index = vm_add_function(codegen->vm, function);
+    size_t constant = chunk_add_constant(codegen->chunk, make_int32((int32_t)func_index));
+    codegen_emit_op_operand(codegen, OP_CLOSURE_LOCAL, (uint16_t)constant);
+}
@@ -20,6 +20,10 @@ codegen_t* codegen_create(vm_t* vm) {
     
     // Initialize scope manager
     codegen_init_scope_manager(codegen);
+    codegen->types.bindings = NULL;
+    codegen->types.count = 0;
+    codegen->types.capacity = 0;
+    codegen->is_generator = 0;
     
     return codegen;
 }
@@ -44,6 +48,10 @@ codegen_t* codegen_create_with_debug(vm_t* vm, const char* source_code) {
     
     // Initialize scope manager
     codegen_init_scope_manager(codegen);
+    codegen->types.bindings = NULL;
+    codegen->types.count = 0;
+    codegen->types.capacity = 0;
+    codegen->is_generator = 0;
     
     return codegen;
 }
@@ -61,6 +69,7 @@ void codegen_destroy(codegen_t* codegen) {
     
     // Clean up scope manager
     codegen_cleanup_scope_manager(codegen);
+    codegen_free_types(codegen);
     
     free(codegen);
 }
\ No newline at end of file
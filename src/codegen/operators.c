@@ -45,6 +45,12 @@ void codegen_emit_binary_op(codegen_t* codegen, ast_binary_op* node) {
     codegen_emit_expression(codegen, node->left);
     codegen_emit_expression(codegen, node->right);
     
+    opcode specialized;
+    if (codegen_specialize_binary_op(codegen, node->op, node->left, node->right, &specialized)) {
+        codegen_emit_op(codegen, specialized);
+        return;
+    }
+    
     // Generate operator without debug info (operands already have their debug info)
     switch (node->op) {
         case BIN_ADD:           codegen_emit_op(codegen, OP_ADD); break;
@@ -369,11 +375,11 @@ void codegen_emit_unary_op(codegen_t* codegen, ast_unary_op* node) {
             
             switch (node->op) {
                 case UN_PRE_INCREMENT:
-                    // Pre-increment: get value using OP_CALL, increment, duplicate for return, set using OP_SET_INDEX
-                    // First, get the current value by calling the array
+                    // Pre-increment: get value using OP_GET_INDEX, increment, duplicate for return, set using OP_SET_INDEX
+                    // First, get the current value by indexing the array
                     codegen_emit_expression(codegen, call->function);     // [array]
                     codegen_emit_expression(codegen, call->arguments[0]); // [array, index]
-                    codegen_emit_op_operand(codegen, OP_CALL, 1);         // [value]
+                    codegen_emit_op(codegen, OP_GET_INDEX);               // [value]
                     codegen_emit_op(codegen, OP_INCREMENT);               // [new_value]
                     codegen_emit_op(codegen, OP_DUP);                     // [new_value, new_value]
                     
@@ -385,10 +391,10 @@ void codegen_emit_unary_op(codegen_t* codegen, ast_unary_op* node) {
                     break;
                     
                 case UN_PRE_DECREMENT:
-                    // Pre-decrement: get value using OP_CALL, decrement, duplicate for return, set using OP_SET_INDEX
+                    // Pre-decrement: get value using OP_GET_INDEX, decrement, duplicate for return, set using OP_SET_INDEX
                     codegen_emit_expression(codegen, call->function);     // [array]
                     codegen_emit_expression(codegen, call->arguments[0]); // [array, index]
-                    codegen_emit_op_operand(codegen, OP_CALL, 1);         // [value]
+                    codegen_emit_op(codegen, OP_GET_INDEX);               // [value]
                     codegen_emit_op(codegen, OP_DECREMENT);               // [new_value]
                     codegen_emit_op(codegen, OP_DUP);                     // [new_value, new_value]
                     
@@ -400,10 +406,10 @@ void codegen_emit_unary_op(codegen_t* codegen, ast_unary_op* node) {
                     break;
                     
                 case UN_POST_INCREMENT:
-                    // Post-increment: get value using OP_CALL, duplicate for return, increment, set using OP_SET_INDEX
+                    // Post-increment: get value using OP_GET_INDEX, duplicate for return, increment, set using OP_SET_INDEX
                     codegen_emit_expression(codegen, call->function);     // [array]
                     codegen_emit_expression(codegen, call->arguments[0]); // [array, index]
-                    codegen_emit_op_operand(codegen, OP_CALL, 1);         // [old_value]
+                    codegen_emit_op(codegen, OP_GET_INDEX);               // [old_value]
                     codegen_emit_op(codegen, OP_DUP);                     // [old_value, old_value]
                     codegen_emit_op(codegen, OP_INCREMENT);               // [old_value, new_value]
                     
@@ -416,10 +422,10 @@ void codegen_emit_unary_op(codegen_t* codegen, ast_unary_op* node) {
                     break;
                     
                 case UN_POST_DECREMENT:
-                    // Post-decrement: get value using OP_CALL, duplicate for return, decrement, set using OP_SET_INDEX
+                    // Post-decrement: get value using OP_GET_INDEX, duplicate for return, decrement, set using OP_SET_INDEX
                     codegen_emit_expression(codegen, call->function);     // [array]
                     codegen_emit_expression(codegen, call->arguments[0]); // [array, index]
-                    codegen_emit_op_operand(codegen, OP_CALL, 1);         // [old_value]
+                    codegen_emit_op(codegen, OP_GET_INDEX);               // [old_value]
                     codegen_emit_op(codegen, OP_DUP);                     // [old_value, old_value]
                     codegen_emit_op(codegen, OP_DECREMENT);               // [old_value, new_value]
                     
@@ -128,6 +128,7 @@ int codegen_declare_variable(codegen_t* codegen, const char* name, int is_immuta
     local->slot = codegen->scope.local_count; // Stack slot index relative to frame->slots
     local->is_initialized = 0; // Will be set to 1 after initialization
     local->is_immutable = is_immutable; // Store immutability flag
+    local->type = STATIC_TYPE_UNKNOWN; // Set by codegen_assign_local_type for inferred locals
     
     return codegen->scope.local_count++;
 }
@@ -32,6 +32,7 @@ void codegen_emit_var_declaration(codegen_t* codegen, ast_var_declaration* node)
         if (slot < 0) {
             return; // Error already reported
         }
+        codegen_assign_local_type(codegen, slot, node->name);
         
         if (node->initializer) {
             codegen_emit_expression(codegen, node->initializer);
@@ -183,6 +184,7 @@ void codegen_emit_compound_assignment(codegen_t* codegen, ast_compound_assignmen
         if (is_local) {
             codegen_emit_op(codegen, OP_SET_LOCAL);
             chunk_write_byte(codegen->chunk, (uint8_t)slot);
+            codegen_emit_op(codegen, OP_POP);  // Remove the duplicate left by DUP since SET_LOCAL uses peek
         } else if (upvalue_index != -1) {
             codegen_emit_op(codegen, OP_SET_UPVALUE);
             chunk_write_byte(codegen->chunk, (uint8_t)upvalue_index);
@@ -221,24 +223,29 @@ void codegen_emit_compound_assignment(codegen_t* codegen, ast_compound_assignmen
     codegen_emit_expression(codegen, node->value);
     
     // Emit the appropriate binary operation
-    switch (node->op) {
-        case BIN_ADD:      codegen_emit_op(codegen, OP_ADD); break;
-        case BIN_SUBTRACT: codegen_emit_op(codegen, OP_SUBTRACT); break;
-        case BIN_MULTIPLY: codegen_emit_op(codegen, OP_MULTIPLY); break;
-        case BIN_DIVIDE:   codegen_emit_op(codegen, OP_DIVIDE); break;
-        case BIN_MOD:      codegen_emit_op(codegen, OP_MOD); break;
-        case BIN_POWER:    codegen_emit_op(codegen, OP_POWER); break;
-        case BIN_FLOOR_DIV: codegen_emit_op(codegen, OP_FLOOR_DIV); break;
-        case BIN_BITWISE_AND:  codegen_emit_op(codegen, OP_BITWISE_AND); break;
-        case BIN_BITWISE_OR:   codegen_emit_op(codegen, OP_BITWISE_OR); break;
-        case BIN_BITWISE_XOR:  codegen_emit_op(codegen, OP_BITWISE_XOR); break;
-        case BIN_LEFT_SHIFT:   codegen_emit_op(codegen, OP_LEFT_SHIFT); break;
-        case BIN_RIGHT_SHIFT:  codegen_emit_op(codegen, OP_RIGHT_SHIFT); break;
-        case BIN_LOGICAL_RIGHT_SHIFT: codegen_emit_op(codegen, OP_LOGICAL_RIGHT_SHIFT); break;
-        case BIN_NULL_COALESCE: codegen_emit_op(codegen, OP_NULL_COALESCE); break;
-        default:
-            codegen_error(codegen, "Unsupported compound assignment operation");
-            return;
+    opcode specialized;
+    if (codegen_specialize_binary_op(codegen, node->op, node->target, node->value, &specialized)) {
+        codegen_emit_op(codegen, specialized);
+    } else {
+        switch (node->op) {
+            case BIN_ADD:      codegen_emit_op(codegen, OP_ADD); break;
+            case BIN_SUBTRACT: codegen_emit_op(codegen, OP_SUBTRACT); break;
+            case BIN_MULTIPLY: codegen_emit_op(codegen, OP_MULTIPLY); break;
+            case BIN_DIVIDE:   codegen_emit_op(codegen, OP_DIVIDE); break;
+            case BIN_MOD:      codegen_emit_op(codegen, OP_MOD); break;
+            case BIN_POWER:    codegen_emit_op(codegen, OP_POWER); break;
+            case BIN_FLOOR_DIV: codegen_emit_op(codegen, OP_FLOOR_DIV); break;
+            case BIN_BITWISE_AND:  codegen_emit_op(codegen, OP_BITWISE_AND); break;
+            case BIN_BITWISE_OR:   codegen_emit_op(codegen, OP_BITWISE_OR); break;
+            case BIN_BITWISE_XOR:  codegen_emit_op(codegen, OP_BITWISE_XOR); break;
+            case BIN_LEFT_SHIFT:   codegen_emit_op(codegen, OP_LEFT_SHIFT); break;
+            case BIN_RIGHT_SHIFT:  codegen_emit_op(codegen, OP_RIGHT_SHIFT); break;
+            case BIN_LOGICAL_RIGHT_SHIFT: codegen_emit_op(codegen, OP_LOGICAL_RIGHT_SHIFT); break;
+            case BIN_NULL_COALESCE: codegen_emit_op(codegen, OP_NULL_COALESCE); break;
+            default:
+                codegen_error(codegen, "Unsupported compound assignment operation");
+                return;
+        }
     }
     
     // Duplicate the result for expression contexts
@@ -249,6 +256,7 @@ void codegen_emit_compound_assignment(codegen_t* codegen, ast_compound_assignmen
     if (is_local) {
         codegen_emit_op(codegen, OP_SET_LOCAL);
         chunk_write_byte(codegen->chunk, (uint8_t)slot);
+        codegen_emit_op(codegen, OP_POP);  // Remove the duplicate left by DUP since SET_LOCAL uses peek
     } else if (upvalue_index != -1) {
         codegen_emit_op(codegen, OP_SET_UPVALUE);
         chunk_write_byte(codegen->chunk, (uint8_t)upvalue_index);
@@ -258,7 +266,176 @@ void codegen_emit_compound_assignment(codegen_t* codegen, ast_compound_assignmen
     }
 }
 
+// Where an appending statement's variable lives: a local slot, or a global's name constant
+typedef struct {
+    bool is_local;
+    int slot;
+    size_t name_constant;
+} append_target_t;
+
+// Pushes the `+` chain `x + a + b ...` left to right, appending each operand to x's value
+static void emit_append_chain(codegen_t* codegen, ast_node* node, const append_target_t* target) {
+    if (node->type == AST_IDENTIFIER) {
+        if (target->is_local) {
+            codegen_emit_op(codegen, OP_GET_LOCAL);
+            chunk_write_byte(codegen->chunk, (uint8_t)target->slot);
+        } else {
+            codegen_emit_op_operand(codegen, OP_GET_GLOBAL, (uint16_t)target->name_constant);
+        }
+        return;
+    }
+    ast_binary_op* add = (ast_binary_op*)node;
+    emit_append_chain(codegen, add->left, target);
+    codegen_emit_expression(codegen, add->right);
+    if (target->is_local) {
+        codegen_emit_op(codegen, OP_APPEND_LOCAL);
+        chunk_write_byte(codegen->chunk, (uint8_t)target->slot);
+    } else {
+        codegen_emit_op_operand(codegen, OP_APPEND_GLOBAL, (uint16_t)target->name_constant);
+    }
+}
+
+// Whether evaluating node could read the variable name: it mentions it, or (when calls_can_read)
+// makes a call whose code might. Anything not known to be neither counts as a read.
+static bool may_read_variable(ast_node* node, const char* name, bool calls_can_read) {
+    if (!node) return false;
+
+    switch (node->type) {
+    case AST_INTEGER:
+    case AST_BIGINT:
+    case AST_NUMBER:
+    case AST_STRING:
+    case AST_BOOLEAN:
+    case AST_NULL:
+    case AST_UNDEFINED:
+        return false;
+    case AST_IDENTIFIER:
+        return strcmp(((ast_identifier*)node)->name, name) == 0;
+    case AST_BINARY_OP:
+        return may_read_variable(((ast_binary_op*)node)->left, name, calls_can_read) ||
+               may_read_variable(((ast_binary_op*)node)->right, name, calls_can_read);
+    case AST_UNARY_OP:
+        return may_read_variable(((ast_unary_op*)node)->operand, name, calls_can_read);
+    case AST_TERNARY:
+        return may_read_variable(((ast_ternary*)node)->condition, name, calls_can_read) ||
+               may_read_variable(((ast_ternary*)node)->true_expr, name, calls_can_read) ||
+               may_read_variable(((ast_ternary*)node)->false_expr, name, calls_can_read);
+    case AST_MEMBER:
+        return may_read_variable(((ast_member*)node)->object, name, calls_can_read);
+    case AST_CALL: {
+        if (calls_can_read) return true;
+        ast_call* call = (ast_call*)node;
+        if (may_read_variable(call->function, name, calls_can_read)) return true;
+        for (size_t i = 0; i < call->arg_count; i++) {
+            if (may_read_variable(call->arguments[i], name, calls_can_read)) return true;
+        }
+        return false;
+    }
+    case AST_ARRAY: {
+        ast_array* array = (ast_array*)node;
+        for (size_t i = 0; i < array->count; i++) {
+            if (may_read_variable(array->elements[i], name, calls_can_read)) return true;
+        }
+        return false;
+    }
+    case AST_TEMPLATE_LITERAL: {
+        ast_template_literal* template = (ast_template_literal*)node;
+        for (size_t i = 0; i < template->part_count; i++) {
+            if (template->parts[i].type == TEMPLATE_PART_EXPRESSION &&
+                may_read_variable(template->parts[i].as.expression, name, calls_can_read)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    default:
+        return true;
+    }
+}
+
+// `x = x + a + b ...` or `x += a` building a string in x. A loop body statement's result is
+// overwritten before anything can read it, so rather than leaving x's new value in the result
+// register (which would keep a reference to it), this appends with APPEND_LOCAL/APPEND_GLOBAL and
+// just stores x - letting the string grow in place. Returns false for any other statement, and
+// when an operand after the first could read x.
+static bool codegen_emit_append(codegen_t* codegen, ast_node* expr) {
+    ast_node* target_node;
+    ast_node* chain;
+    if (expr->type == AST_ASSIGNMENT) {
+        ast_assignment* assign = (ast_assignment*)expr;
+        target_node = assign->target;
+        chain = assign->value;
+    } else if (expr->type == AST_COMPOUND_ASSIGNMENT && ((ast_compound_assignment*)expr)->op == BIN_ADD) {
+        target_node = ((ast_compound_assignment*)expr)->target;
+        chain = NULL;
+    } else {
+        return false;
+    }
+    if (target_node->type != AST_IDENTIFIER) return false;
+    const char* name = ((ast_identifier*)target_node)->name;
+
+    // The first operand added to x, which must make the addition a string concatenation
+    ast_node* first = expr->type == AST_COMPOUND_ASSIGNMENT ? ((ast_compound_assignment*)expr)->value : NULL;
+    for (ast_node* node = chain; node && !first;) {
+        if (node->type != AST_BINARY_OP || ((ast_binary_op*)node)->op != BIN_ADD) return false;
+        ast_binary_op* add = (ast_binary_op*)node;
+        if (add->left->type == AST_IDENTIFIER && strcmp(((ast_identifier*)add->left)->name, name) == 0) {
+            first = add->right;
+        }
+        node = add->left;
+    }
+    if (!first || (codegen_expression_type(codegen, target_node) != STATIC_TYPE_STRING &&
+                   codegen_expression_type(codegen, first) != STATIC_TYPE_STRING)) {
+        return false;
+    }
+
+    int is_local;
+    int upvalue_index;
+    int slot = codegen_resolve_variable(codegen, name, &is_local, &upvalue_index);
+    if (!is_local && upvalue_index != -1) return false;
+
+    // Operands after the first are evaluated once x has grown in place, so none of them may read
+    // it. Any call might read a global, but a local only through a nested function capturing it.
+    bool calls_can_read = !is_local || codegen_name_is_captured(codegen, name);
+    for (ast_node* node = chain; node; node = ((ast_binary_op*)node)->left) {
+        ast_binary_op* add = (ast_binary_op*)node;
+        if (add->right == first) break;
+        if (may_read_variable(add->right, name, calls_can_read)) return false;
+    }
+    append_target_t target = {is_local != 0, slot, 0};
+    if (!is_local) {
+        target.name_constant = chunk_add_constant(codegen->chunk, make_string(name));
+    }
+
+    chunk_add_debug_info(codegen->chunk, expr->line, expr->column);
+    if (chain) {
+        emit_append_chain(codegen, chain, &target);
+    } else {
+        emit_append_chain(codegen, target_node, &target);
+        codegen_emit_expression(codegen, first);
+        if (is_local) {
+            codegen_emit_op(codegen, OP_APPEND_LOCAL);
+            chunk_write_byte(codegen->chunk, (uint8_t)slot);
+        } else {
+            codegen_emit_op_operand(codegen, OP_APPEND_GLOBAL, (uint16_t)target.name_constant);
+        }
+    }
+
+    chunk_add_debug_info(codegen->chunk, expr->line, expr->column);
+    if (is_local) {
+        codegen_emit_op(codegen, OP_SET_LOCAL);
+        chunk_write_byte(codegen->chunk, (uint8_t)slot);
+        codegen_emit_op(codegen, OP_POP);
+    } else {
+        codegen_emit_op_operand(codegen, OP_SET_GLOBAL, (uint16_t)target.name_constant);
+    }
+    return true;
+}
+
 void codegen_emit_expression_stmt(codegen_t* codegen, ast_expression_stmt* node) {
+    if (codegen->loop_depth > 0 && codegen_emit_append(codegen, node->expression)) {
+        return;
+    }
     codegen_emit_expression(codegen, node->expression);
     codegen_emit_op(codegen, OP_SET_RESULT); // Pop and store in result register
 }
@@ -389,60 +566,260 @@ void codegen_emit_if(codegen_t* codegen, ast_if* node) {
     codegen_patch_jump(codegen, end_jump);
 }
 
+// Minimum number of literal cases before a match is lowered to OP_MATCH_SWITCH
+#define MATCH_SWITCH_MIN_CASES 4
+// Largest int32 table span allowed, and how sparse it may be relative to the case count
+#define MATCH_SWITCH_MAX_SPAN 1024
+#define MATCH_SWITCH_MAX_DENSITY 4
+
+// Emit a case body leaving its value on the stack
+static void codegen_emit_case_body(codegen_t* codegen, ast_case* case_node) {
+    if (case_node->body->type == AST_BLOCK) {
+        codegen_emit_block_expression(codegen, (ast_block*)case_node->body);
+    } else if (case_node->body->type == AST_EXPRESSION_STMT) {
+        codegen_emit_expression(codegen, ((ast_expression_stmt*)case_node->body)->expression);
+    } else {
+        codegen_emit_expression(codegen, case_node->body);
+    }
+}
+
+// Extract an int32 literal pattern (42 or -42)
+static bool match_int32_pattern(ast_node* pattern, int32_t* out) {
+    if (pattern->type == AST_INTEGER) {
+        *out = ((ast_integer*)pattern)->value;
+        return true;
+    }
+    if (pattern->type == AST_UNARY_OP) {
+        ast_unary_op* unary = (ast_unary_op*)pattern;
+        if (unary->op == UN_NEGATE && unary->operand->type == AST_INTEGER) {
+            *out = -((ast_integer*)unary->operand)->value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void write_u16_at(bytecode_chunk* chunk, size_t offset, uint16_t value) {
+    chunk->code[offset] = (uint8_t)(value & 0xFF);
+    chunk->code[offset + 1] = (uint8_t)((value >> 8) & 0xFF);
+}
+
+static void write_u32(bytecode_chunk* chunk, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        chunk_write_byte(chunk, (uint8_t)((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// Patch a switch table offset so it lands on the current position
+static void patch_switch_offset(codegen_t* codegen, size_t operand, size_t switch_end) {
+    size_t jump = codegen->chunk->count - switch_end;
+    if (jump >= 0xFFFF) {
+        codegen_error(codegen, "Too much code to jump over");
+        return;
+    }
+    write_u16_at(codegen->chunk, operand, (uint16_t)jump);
+}
+
+// Emit OP_MATCH_SWITCH for the first literal_count cases if they are all int32 literals in a
+// dense range or all string literals. Fills operands[i] with the table slot operand for case i
+// (0 for duplicates, which can never be reached) and *miss_operand with the miss offset operand.
+// Returns the offset just past the instruction, or 0 if the cases don't qualify.
+static size_t codegen_emit_match_switch(codegen_t* codegen, ast_match* node, size_t literal_count,
+                                        size_t* operands, size_t* miss_operand) {
+    if (literal_count < MATCH_SWITCH_MIN_CASES || literal_count > UINT16_MAX / 2) {
+        return 0;
+    }
+
+    bytecode_chunk* chunk = codegen->chunk;
+    int32_t value;
+
+    if (match_int32_pattern(node->cases[0].pattern, &value)) {
+        int32_t min = value;
+        int32_t max = value;
+        for (size_t i = 0; i < literal_count; i++) {
+            if (!match_int32_pattern(node->cases[i].pattern, &value)) {
+                return 0;
+            }
+            if (value < min) min = value;
+            if (value > max) max = value;
+        }
+
+        int64_t span = (int64_t)max - (int64_t)min + 1;
+        if (span > MATCH_SWITCH_MAX_SPAN || span > (int64_t)literal_count * MATCH_SWITCH_MAX_DENSITY) {
+            return 0;
+        }
+
+        codegen_emit_op(codegen, OP_MATCH_SWITCH);
+        chunk_write_byte(chunk, MATCH_SWITCH_INT32);
+        *miss_operand = chunk->count;
+        chunk_write_operand(chunk, 0xFFFF);
+        write_u32(chunk, (uint32_t)min);
+        chunk_write_operand(chunk, (uint16_t)span);
+
+        size_t table = chunk->count;
+        for (int64_t i = 0; i < span; i++) {
+            chunk_write_operand(chunk, 0xFFFF);
+        }
+
+        // First case wins for duplicate literals
+        for (size_t i = 0; i < literal_count; i++) {
+            match_int32_pattern(node->cases[i].pattern, &value);
+            size_t slot = table + (size_t)((int64_t)value - min) * 2;
+            operands[i] = 0;
+            bool taken = false;
+            for (size_t j = 0; j < i; j++) {
+                if (operands[j] == slot) {
+                    taken = true;
+                    break;
+                }
+            }
+            if (!taken) {
+                operands[i] = slot;
+            }
+        }
+        return chunk->count;
+    }
+
+    if (node->cases[0].pattern->type == AST_STRING) {
+        for (size_t i = 0; i < literal_count; i++) {
+            if (node->cases[i].pattern->type != AST_STRING) {
+                return 0;
+            }
+        }
+
+        size_t slot_count = 1;
+        while (slot_count < literal_count * 2) {
+            slot_count <<= 1;
+        }
+        uint32_t mask = (uint32_t)slot_count - 1;
+
+        // Look for a seed that places every distinct string in its own slot
+        uint32_t seed = 0;
+        bool* used = malloc(slot_count);
+        for (uint32_t candidate = 0; candidate < 256; candidate++) {
+            memset(used, 0, slot_count);
+            bool perfect = true;
+            for (size_t i = 0; i < literal_count && perfect; i++) {
+                const char* text = ((ast_string*)node->cases[i].pattern)->value;
+                bool duplicate = false;
+                for (size_t j = 0; j < i; j++) {
+                    if (strcmp(text, ((ast_string*)node->cases[j].pattern)->value) == 0) {
+                        duplicate = true;
+                        break;
+                    }
+                }
+                if (duplicate) continue;
+                uint32_t slot = match_string_hash(text, strlen(text), candidate) & mask;
+                if (used[slot]) {
+                    perfect = false;
+                } else {
+                    used[slot] = true;
+                }
+            }
+            if (perfect) {
+                seed = candidate;
+                break;
+            }
+        }
+        free(used);
+
+        codegen_emit_op(codegen, OP_MATCH_SWITCH);
+        chunk_write_byte(chunk, MATCH_SWITCH_STRING);
+        *miss_operand = chunk->count;
+        chunk_write_operand(chunk, 0xFFFF);
+        write_u32(chunk, seed);
+        chunk_write_operand(chunk, (uint16_t)slot_count);
+
+        size_t table = chunk->count;
+        for (size_t i = 0; i < slot_count; i++) {
+            write_u32(chunk, 0);
+            chunk_write_operand(chunk, 0xFFFF);
+            chunk_write_operand(chunk, 0xFFFF);
+        }
+
+        for (size_t i = 0; i < literal_count; i++) {
+            const char* text = ((ast_string*)node->cases[i].pattern)->value;
+            operands[i] = 0;
+            bool duplicate = false;
+            for (size_t j = 0; j < i; j++) {
+                if (strcmp(text, ((ast_string*)node->cases[j].pattern)->value) == 0) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (duplicate) continue;
+
+            uint32_t hash = match_string_hash(text, strlen(text), seed);
+            size_t entry = table + (size_t)(hash & mask) * 8;
+            while (chunk->code[entry + 4] != 0xFF || chunk->code[entry + 5] != 0xFF) {
+                entry = table + (size_t)(((entry - table) / 8 + 1) & mask) * 8;
+            }
+
+            size_t constant = chunk_add_constant(chunk, make_string(text));
+            for (int b = 0; b < 4; b++) {
+                chunk->code[entry + b] = (uint8_t)((hash >> (8 * b)) & 0xFF);
+            }
+            write_u16_at(chunk, entry + 4, (uint16_t)constant);
+            operands[i] = entry + 6;
+        }
+        return chunk->count;
+    }
+
+    return 0;
+}
+
 void codegen_emit_match(codegen_t* codegen, ast_match* node) {
     // Generate the match expression once
     codegen_emit_expression(codegen, node->expression);
     
+    // Literal cases before the first variable case (a variable case always matches)
+    size_t literal_count = 0;
+    while (literal_count < node->case_count && !node->cases[literal_count].is_variable) {
+        literal_count++;
+    }
+    int has_variable_case = literal_count < node->case_count;
+    
     // Store jump locations for case exits
-    size_t* end_jumps = malloc(sizeof(size_t) * node->case_count);
+    size_t* end_jumps = malloc(sizeof(size_t) * (literal_count + 1));
     
-    // Find if we have variable cases (these act as catch-alls)
-    int has_variable_case = 0;
-    for (size_t i = 0; i < node->case_count; i++) {
-        if (node->cases[i].is_variable) {
-            has_variable_case = 1;
-            break;
-        }
-    }
+    // Dense int32 and string literal cases dispatch through a single OP_MATCH_SWITCH;
+    // the sequential .equals() chain below only runs for subjects of other types
+    size_t* switch_operands = malloc(sizeof(size_t) * (literal_count + 1));
+    size_t miss_operand = 0;
+    size_t switch_end = codegen_emit_match_switch(codegen, node, literal_count, switch_operands, &miss_operand);
     
-    // Generate code for literal cases first
-    for (size_t i = 0; i < node->case_count; i++) {
-        ast_case* case_node = &node->cases[i];
+    if (switch_end) {
+        size_t* body_jumps = malloc(sizeof(size_t) * literal_count);
         
-        if (case_node->is_variable) {
-            // Handle variable cases - they always match (catch-all)
-            // Begin a new scope for the variable binding
-            codegen_begin_scope(codegen);
-            
-            // Declare the variable and initialize it with the match value
-            // Stack: [match_value]
-            int var_slot = codegen_declare_variable(codegen, case_node->variable_name, 1); // 1 = immutable (like val)
-            if (var_slot != -1) {
-                // Duplicate the match value: [match_value, match_value]
-                codegen_emit_op(codegen, OP_DUP);
-                // Store in local variable: [match_value]
-                codegen_emit_op(codegen, OP_SET_LOCAL);
-                chunk_write_byte(codegen->chunk, (uint8_t)var_slot);
-                // Now the variable is initialized and match_value is still on stack
-            }
-            
-            // Generate the case body - no conditional jumps needed
-            if (case_node->body->type == AST_BLOCK) {
-                codegen_emit_block_expression(codegen, (ast_block*)case_node->body);
-            } else if (case_node->body->type == AST_EXPRESSION_STMT) {
-                codegen_emit_expression(codegen, ((ast_expression_stmt*)case_node->body)->expression);
-            } else {
-                codegen_emit_expression(codegen, case_node->body);
-            }
+        for (size_t i = 0; i < literal_count; i++) {
+            if (!switch_operands[i]) continue; // Duplicate literal - an earlier case always wins
+            codegen_emit_op(codegen, OP_DUP);
+            codegen_emit_expression(codegen, node->cases[i].pattern);
+            codegen_emit_op(codegen, OP_EQUAL);
+            body_jumps[i] = codegen_emit_jump(codegen, OP_JUMP_IF_TRUE);
+        }
+        size_t chain_miss_jump = codegen_emit_jump(codegen, OP_JUMP);
+        
+        for (size_t i = 0; i < literal_count; i++) {
+            if (!switch_operands[i]) continue;
+            patch_switch_offset(codegen, switch_operands[i], switch_end);
+            codegen_patch_jump(codegen, body_jumps[i]);
             
-            // End scope while keeping the case result on top
-            // Stack: [match_value, case_result] -> [case_result]
-            codegen_end_scope_keep_top(codegen);
+            codegen_emit_case_body(codegen, &node->cases[i]);
             
-            // Variable case always matches, so we're done
-            break;
+            // Clean up: [match_value, case_result] -> [case_result]
+            codegen_emit_op(codegen, OP_SWAP);
+            codegen_emit_op(codegen, OP_POP);
+            end_jumps[i] = codegen_emit_jump(codegen, OP_JUMP);
+        }
+        
+        patch_switch_offset(codegen, miss_operand, switch_end);
+        codegen_patch_jump(codegen, chain_miss_jump);
+        free(body_jumps);
+    } else {
+        for (size_t i = 0; i < literal_count; i++) {
+            ast_case* case_node = &node->cases[i];
             
-        } else {
             // Literal pattern case: case 42 do ...
             // Duplicate the match value for comparison
             codegen_emit_op(codegen, OP_DUP);
@@ -457,13 +834,7 @@ void codegen_emit_match(codegen_t* codegen, ast_match* node) {
             size_t next_case_jump = codegen_emit_jump(codegen, OP_JUMP_IF_FALSE);
             
             // Generate the case body
-            if (case_node->body->type == AST_BLOCK) {
-                codegen_emit_block_expression(codegen, (ast_block*)case_node->body);
-            } else if (case_node->body->type == AST_EXPRESSION_STMT) {
-                codegen_emit_expression(codegen, ((ast_expression_stmt*)case_node->body)->expression);
-            } else {
-                codegen_emit_expression(codegen, case_node->body);
-            }
+            codegen_emit_case_body(codegen, case_node);
             
             // Clean up: [match_value, case_result] -> [case_result]
             codegen_emit_op(codegen, OP_SWAP);  // [case_result, match_value]
@@ -474,23 +845,49 @@ void codegen_emit_match(codegen_t* codegen, ast_match* node) {
             
             // Patch the next case jump for literal patterns
             codegen_patch_jump(codegen, next_case_jump);
+            switch_operands[i] = 1;
         }
     }
     
-    // If we reach here, no literal case matched and there's no variable case
-    if (!has_variable_case) {
+    if (has_variable_case) {
+        // Handle variable cases - they always match (catch-all)
+        ast_case* case_node = &node->cases[literal_count];
+        
+        // Begin a new scope for the variable binding
+        codegen_begin_scope(codegen);
+        
+        // Declare the variable and initialize it with the match value
+        // Stack: [match_value]
+        int var_slot = codegen_declare_variable(codegen, case_node->variable_name, 1); // 1 = immutable (like val)
+        if (var_slot != -1) {
+            // Duplicate the match value: [match_value, match_value]
+            codegen_emit_op(codegen, OP_DUP);
+            // Store in local variable: [match_value]
+            codegen_emit_op(codegen, OP_SET_LOCAL);
+            chunk_write_byte(codegen->chunk, (uint8_t)var_slot);
+            // Now the variable is initialized and match_value is still on stack
+        }
+        
+        // Generate the case body - no conditional jumps needed
+        codegen_emit_case_body(codegen, case_node);
+        
+        // End scope while keeping the case result on top
+        // Stack: [match_value, case_result] -> [case_result]
+        codegen_end_scope_keep_top(codegen);
+    } else {
         // Non-exhaustive match - pop the match value and return null for now
         codegen_emit_op(codegen, OP_POP);
         codegen_emit_op(codegen, OP_PUSH_NULL);
     }
     
     // Patch all end jumps from literal cases
-    for (size_t i = 0; i < node->case_count; i++) {
-        if (!node->cases[i].is_variable) {
+    for (size_t i = 0; i < literal_count; i++) {
+        if (switch_operands[i]) {
             codegen_patch_jump(codegen, end_jumps[i]);
         }
     }
     
+    free(switch_operands);
     free(end_jumps);
 }
 
@@ -661,8 +1058,8 @@ void codegen_emit_data_declaration(codegen_t* codegen, ast_data_declaration* nod
             size_t constructor_name_constant = chunk_add_constant(codegen->chunk, make_string(case_node->name));
             codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)constructor_name_constant);
             
-            // Push case type and parameter count for runtime constructor creation
-            codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(case_node->type)));
+            // Push constructor tag (case index) and parameter count for runtime constructor creation
+            codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32((int32_t)i)));
             codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(case_node->param_count)));
             
             // Push parameter names for runtime
@@ -686,8 +1083,8 @@ void codegen_emit_data_declaration(codegen_t* codegen, ast_data_declaration* nod
         size_t constructor_name_constant = chunk_add_constant(codegen->chunk, make_string(node->name));
         codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)constructor_name_constant);
         
-        // Push constructor type and parameter count
-        codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(DATA_CASE_CONSTRUCTOR)));
+        // Push constructor tag (the only case) and parameter count
+        codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(0)));
         codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(node->param_count)));
         
         // Push parameter names
@@ -710,8 +1107,8 @@ void codegen_emit_data_declaration(codegen_t* codegen, ast_data_declaration* nod
         size_t constructor_name_constant = chunk_add_constant(codegen->chunk, make_string(node->name));
         codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)constructor_name_constant);
         
-        // Create singleton constructor (no parameters)
-        codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(DATA_CASE_SINGLETON)));
+        // Create singleton constructor (tag 0, no parameters)
+        codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(0)));
         codegen_emit_op_operand(codegen, OP_PUSH_CONSTANT, (uint16_t)chunk_add_constant(codegen->chunk, make_int32(0)));
         
         // Call create_adt_constructor
@@ -0,0 +1,550 @@
+#include "codegen.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+// Local type inference
+//
+// Before a function body is compiled, every name it declares is given the join of the types of
+// all values ever assigned to it (declarations, assignments, compound assignments, ++/--).
+// The analysis is flow-insensitive and iterated to a fixpoint, so a type is only kept when it
+// holds for the whole lifetime of every local with that name. Parameters, match bindings,
+// globals, upvalues and names written from nested functions are never typed.
+//
+// Codegen reads the result through the local slots (codegen_assign_local_type) and uses it to
+// pick the specialized arithmetic/comparison opcodes, so a typed slot never needs a type check.
+
+const char* static_type_name(static_type type) {
+    switch (type) {
+    case STATIC_TYPE_INT:
+        return "Int";
+    case STATIC_TYPE_FLOAT64:
+        return "Float64";
+    case STATIC_TYPE_STRING:
+        return "String";
+    case STATIC_TYPE_ARRAY:
+        return "Array";
+    case STATIC_TYPE_BOOLEAN:
+        return "Boolean";
+    default:
+        return "Unknown";
+    }
+}
+
+static static_type type_join(static_type a, static_type b) {
+    if (a == STATIC_TYPE_NONE) return b;
+    if (b == STATIC_TYPE_NONE) return a;
+    return a == b ? a : STATIC_TYPE_UNKNOWN;
+}
+
+// Result type of a binary operator, or UNKNOWN when the runtime type depends on the values
+static static_type binary_result_type(binary_operator op, static_type left, static_type right) {
+    switch (op) {
+    case BIN_EQUAL:
+    case BIN_NOT_EQUAL:
+    case BIN_LESS:
+    case BIN_LESS_EQUAL:
+    case BIN_GREATER:
+    case BIN_GREATER_EQUAL:
+    case BIN_IN:
+    case BIN_INSTANCEOF:
+        return STATIC_TYPE_BOOLEAN;
+    default:
+        break;
+    }
+
+    if (left == STATIC_TYPE_NONE || right == STATIC_TYPE_NONE) {
+        return STATIC_TYPE_NONE;
+    }
+
+    switch (op) {
+    case BIN_ADD:
+        // Anything added to a string is converted with toString
+        if (left == STATIC_TYPE_STRING || right == STATIC_TYPE_STRING) return STATIC_TYPE_STRING;
+        if (left == STATIC_TYPE_ARRAY && right == STATIC_TYPE_ARRAY) return STATIC_TYPE_ARRAY;
+        // fallthrough
+    case BIN_SUBTRACT:
+    case BIN_MULTIPLY:
+        if (left == STATIC_TYPE_INT && right == STATIC_TYPE_INT) return STATIC_TYPE_INT;
+        if (left == STATIC_TYPE_FLOAT64 && right == STATIC_TYPE_FLOAT64) return STATIC_TYPE_FLOAT64;
+        return STATIC_TYPE_UNKNOWN;
+    case BIN_DIVIDE:
+        // int / int produces the default float type, which is a build option
+        if (left == STATIC_TYPE_FLOAT64 && right == STATIC_TYPE_FLOAT64) return STATIC_TYPE_FLOAT64;
+        return STATIC_TYPE_UNKNOWN;
+    case BIN_LOGICAL_AND:
+    case BIN_LOGICAL_OR:
+        return type_join(left, right);
+    default:
+        return STATIC_TYPE_UNKNOWN;
+    }
+}
+
+typedef static_type (*type_lookup_fn)(void* context, const char* name);
+
+static static_type infer_type(ast_node* expr, type_lookup_fn lookup, void* context) {
+    if (!expr) return STATIC_TYPE_UNKNOWN;
+
+    switch (expr->type) {
+    case AST_INTEGER:
+        return STATIC_TYPE_INT;
+    case AST_NUMBER:
+        return ((ast_number*)expr)->is_float32 ? STATIC_TYPE_UNKNOWN : STATIC_TYPE_FLOAT64;
+    case AST_STRING:
+    case AST_TEMPLATE_LITERAL:
+        return STATIC_TYPE_STRING;
+    case AST_BOOLEAN:
+        return STATIC_TYPE_BOOLEAN;
+    case AST_ARRAY:
+        return STATIC_TYPE_ARRAY;
+    case AST_IDENTIFIER:
+        return lookup(context, ((ast_identifier*)expr)->name);
+    case AST_BINARY_OP: {
+        ast_binary_op* binary = (ast_binary_op*)expr;
+        return binary_result_type(binary->op, infer_type(binary->left, lookup, context),
+                                  infer_type(binary->right, lookup, context));
+    }
+    case AST_UNARY_OP: {
+        ast_unary_op* unary = (ast_unary_op*)expr;
+        if (unary->op == UN_NOT) return STATIC_TYPE_BOOLEAN;
+        static_type operand = infer_type(unary->operand, lookup, context);
+        if (operand == STATIC_TYPE_NONE) return STATIC_TYPE_NONE;
+        if (unary->op == UN_BITWISE_NOT) return STATIC_TYPE_UNKNOWN;
+        return operand == STATIC_TYPE_INT || operand == STATIC_TYPE_FLOAT64 ? operand : STATIC_TYPE_UNKNOWN;
+    }
+    case AST_TERNARY: {
+        ast_ternary* ternary = (ast_ternary*)expr;
+        return type_join(infer_type(ternary->true_expr, lookup, context),
+                         infer_type(ternary->false_expr, lookup, context));
+    }
+    case AST_ASSIGNMENT:
+        return infer_type(((ast_assignment*)expr)->value, lookup, context);
+    default:
+        return STATIC_TYPE_UNKNOWN;
+    }
+}
+
+// === Inference pass ===
+
+static type_binding_t* env_find(type_env_t* env, const char* name) {
+    for (int i = 0; i < env->count; i++) {
+        if (strcmp(env->bindings[i].name, name) == 0) {
+            return &env->bindings[i];
+        }
+    }
+    return NULL;
+}
+
+static void env_join(type_env_t* env, const char* name, static_type type, int* changed) {
+    type_binding_t* binding = env_find(env, name);
+    if (!binding) {
+        if (env->count >= env->capacity) {
+            int new_capacity = env->capacity == 0 ? 8 : env->capacity * 2;
+            type_binding_t* new_bindings = realloc(env->bindings, new_capacity * sizeof(type_binding_t));
+            if (!new_bindings) return;
+            env->bindings = new_bindings;
+            env->capacity = new_capacity;
+        }
+        binding = &env->bindings[env->count++];
+        binding->name = strdup(name);
+        binding->type = STATIC_TYPE_NONE;
+        binding->captured = false;
+    }
+
+    static_type joined = type_join(binding->type, type);
+    if (joined != binding->type) {
+        binding->type = joined;
+        *changed = 1;
+    }
+}
+
+// Walk state: names currently in scope, so that a read of a name that resolves to a global or
+// an upvalue is never typed from a same-named local declared elsewhere in the function
+typedef struct {
+    type_env_t* env;
+    const char** visible;
+    int visible_count;
+    int visible_capacity;
+    int is_program; // Top-level declarations are globals, not locals
+    int* changed;
+} infer_walk_t;
+
+static static_type walk_lookup(void* context, const char* name) {
+    infer_walk_t* walk = context;
+    for (int i = walk->visible_count - 1; i >= 0; i--) {
+        if (strcmp(walk->visible[i], name) == 0) {
+            type_binding_t* binding = env_find(walk->env, name);
+            return binding ? binding->type : STATIC_TYPE_UNKNOWN;
+        }
+    }
+    return STATIC_TYPE_UNKNOWN;
+}
+
+static void walk_declare(infer_walk_t* walk, const char* name) {
+    if (walk->visible_count >= walk->visible_capacity) {
+        int new_capacity = walk->visible_capacity == 0 ? 16 : walk->visible_capacity * 2;
+        const char** new_visible = realloc(walk->visible, new_capacity * sizeof(const char*));
+        if (!new_visible) return;
+        walk->visible = new_visible;
+        walk->visible_capacity = new_capacity;
+    }
+    walk->visible[walk->visible_count++] = name;
+}
+
+static bool expression_mentions(ast_node* node, const char* name);
+
+static void walk_node(infer_walk_t* walk, ast_node* node, int depth, int nested);
+
+static void walk_scoped(infer_walk_t* walk, ast_node* node, int depth, int nested) {
+    int saved = walk->visible_count;
+    walk_node(walk, node, depth + 1, nested);
+    walk->visible_count = saved;
+}
+
+static void walk_assign(infer_walk_t* walk, ast_node* target, static_type type, int nested) {
+    if (!target || target->type != AST_IDENTIFIER) return;
+    // A nested function writing a captured name makes the outer local's type unknowable here
+    env_join(walk->env, ((ast_identifier*)target)->name, nested ? STATIC_TYPE_UNKNOWN : type, walk->changed);
+}
+
+static void walk_node(infer_walk_t* walk, ast_node* node, int depth, int nested) {
+    if (!node) return;
+
+    switch (node->type) {
+    case AST_VAR_DECLARATION: {
+        ast_var_declaration* decl = (ast_var_declaration*)node;
+        walk_node(walk, decl->initializer, depth, nested);
+        if (nested) break; // Declared in the nested function's own scope
+        if (walk->is_program && depth == 0) {
+            env_join(walk->env, decl->name, STATIC_TYPE_UNKNOWN, walk->changed);
+            break;
+        }
+        static_type type = STATIC_TYPE_UNKNOWN;
+        // An initializer reading its own name sees whatever was in the slot before
+        if (decl->initializer && !expression_mentions(decl->initializer, decl->name)) {
+            type = infer_type(decl->initializer, walk_lookup, walk);
+        }
+        env_join(walk->env, decl->name, type, walk->changed);
+        walk_declare(walk, decl->name);
+        break;
+    }
+    case AST_ASSIGNMENT: {
+        ast_assignment* assignment = (ast_assignment*)node;
+        walk_node(walk, assignment->target, depth, nested);
+        walk_node(walk, assignment->value, depth, nested);
+        walk_assign(walk, assignment->target, infer_type(assignment->value, walk_lookup, walk), nested);
+        break;
+    }
+    case AST_COMPOUND_ASSIGNMENT: {
+        ast_compound_assignment* compound = (ast_compound_assignment*)node;
+        walk_node(walk, compound->target, depth, nested);
+        walk_node(walk, compound->value, depth, nested);
+        static_type type = STATIC_TYPE_UNKNOWN;
+        if (compound->target->type == AST_IDENTIFIER) {
+            type = binary_result_type(compound->op, infer_type(compound->target, walk_lookup, walk),
+                                      infer_type(compound->value, walk_lookup, walk));
+        }
+        walk_assign(walk, compound->target, type, nested);
+        break;
+    }
+    case AST_UNARY_OP: {
+        ast_unary_op* unary = (ast_unary_op*)node;
+        walk_node(walk, unary->operand, depth, nested);
+        if (unary->op == UN_PRE_INCREMENT || unary->op == UN_PRE_DECREMENT ||
+            unary->op == UN_POST_INCREMENT || unary->op == UN_POST_DECREMENT) {
+            walk_assign(walk, unary->operand, infer_type(node, walk_lookup, walk), nested);
+        }
+        break;
+    }
+    case AST_IDENTIFIER:
+        if (nested) {
+            const char* name = ((ast_identifier*)node)->name;
+            env_join(walk->env, name, STATIC_TYPE_NONE, walk->changed);
+            type_binding_t* binding = env_find(walk->env, name);
+            if (binding) binding->captured = true;
+        }
+        break;
+    case AST_FUNCTION:
+        // Locals of the nested function are inferred when it is compiled; only its writes to
+        // names of this function matter here
+        walk_scoped(walk, ((ast_function*)node)->body, depth, 1);
+        break;
+    case AST_DATA_DECLARATION: {
+        ast_data_declaration* data = (ast_data_declaration*)node;
+        walk_scoped(walk, data->shared_methods, depth, 1);
+        for (size_t i = 0; i < data->case_count; i++) {
+            walk_scoped(walk, data->cases[i].methods, depth, 1);
+        }
+        break;
+    }
+    case AST_TEMPLATE_LITERAL: {
+        ast_template_literal* template = (ast_template_literal*)node;
+        for (size_t i = 0; i < template->part_count; i++) {
+            if (template->parts[i].type == TEMPLATE_PART_EXPRESSION) {
+                walk_node(walk, template->parts[i].as.expression, depth, nested);
+            }
+        }
+        break;
+    }
+    case AST_ARRAY: {
+        ast_array* array = (ast_array*)node;
+        for (size_t i = 0; i < array->count; i++) {
+            walk_node(walk, array->elements[i], depth, nested);
+        }
+        break;
+    }
+    case AST_BINARY_OP:
+        walk_node(walk, ((ast_binary_op*)node)->left, depth, nested);
+        walk_node(walk, ((ast_binary_op*)node)->right, depth, nested);
+        break;
+    case AST_TERNARY:
+        walk_node(walk, ((ast_ternary*)node)->condition, depth, nested);
+        walk_scoped(walk, ((ast_ternary*)node)->true_expr, depth, nested);
+        walk_scoped(walk, ((ast_ternary*)node)->false_expr, depth, nested);
+        break;
+    case AST_RANGE:
+        walk_node(walk, ((ast_range*)node)->start, depth, nested);
+        walk_node(walk, ((ast_range*)node)->end, depth, nested);
+        walk_node(walk, ((ast_range*)node)->step, depth, nested);
+        break;
+    case AST_CALL: {
+        ast_call* call = (ast_call*)node;
+        walk_node(walk, call->function, depth, nested);
+        for (size_t i = 0; i < call->arg_count; i++) {
+            walk_node(walk, call->arguments[i], depth, nested);
+        }
+        break;
+    }
+    case AST_MEMBER:
+        walk_node(walk, ((ast_member*)node)->object, depth, nested);
+        break;
+    case AST_OBJECT_LITERAL: {
+        ast_object_literal* object = (ast_object_literal*)node;
+        for (size_t i = 0; i < object->property_count; i++) {
+            walk_node(walk, object->properties[i].value, depth, nested);
+        }
+        break;
+    }
+    case AST_MATCH: {
+        ast_match* match = (ast_match*)node;
+        walk_node(walk, match->expression, depth, nested);
+        for (size_t i = 0; i < match->case_count; i++) {
+            int saved = walk->visible_count;
+            walk_node(walk, match->cases[i].pattern, depth + 1, nested);
+            if (match->cases[i].variable_name && !nested) {
+                env_join(walk->env, match->cases[i].variable_name, STATIC_TYPE_UNKNOWN, walk->changed);
+                walk_declare(walk, match->cases[i].variable_name);
+            }
+            walk_node(walk, match->cases[i].body, depth + 1, nested);
+            walk->visible_count = saved;
+        }
+        break;
+    }
+    case AST_IF:
+        walk_node(walk, ((ast_if*)node)->condition, depth, nested);
+        walk_scoped(walk, ((ast_if*)node)->then_stmt, depth, nested);
+        walk_scoped(walk, ((ast_if*)node)->else_stmt, depth, nested);
+        break;
+    case AST_WHILE:
+        walk_node(walk, ((ast_while*)node)->condition, depth, nested);
+        walk_scoped(walk, ((ast_while*)node)->body, depth, nested);
+        break;
+    case AST_DO_WHILE:
+        walk_scoped(walk, ((ast_do_while*)node)->body, depth, nested);
+        walk_node(walk, ((ast_do_while*)node)->condition, depth, nested);
+        break;
+    case AST_FOR: {
+        ast_for* loop = (ast_for*)node;
+        int saved = walk->visible_count;
+        walk_node(walk, loop->initializer, depth + 1, nested);
+        walk_node(walk, loop->condition, depth + 1, nested);
+        walk_node(walk, loop->increment, depth + 1, nested);
+        walk_scoped(walk, loop->body, depth + 1, nested);
+        walk->visible_count = saved;
+        break;
+    }
+    case AST_LOOP:
+        walk_scoped(walk, ((ast_loop*)node)->body, depth, nested);
+        break;
+    case AST_RETURN:
+        walk_node(walk, ((ast_return*)node)->value, depth, nested);
+        break;
+    case AST_YIELD:
+        walk_node(walk, ((ast_yield*)node)->value, depth, nested);
+        break;
+    case AST_EXPRESSION_STMT:
+        walk_node(walk, ((ast_expression_stmt*)node)->expression, depth, nested);
+        break;
+    case AST_BLOCK: {
+        ast_block* block = (ast_block*)node;
+        int saved = walk->visible_count;
+        for (size_t i = 0; i < block->statement_count; i++) {
+            walk_node(walk, block->statements[i], depth + 1, nested);
+        }
+        walk->visible_count = saved;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+static bool expression_mentions(ast_node* node, const char* name) {
+    if (!node) return false;
+
+    switch (node->type) {
+    case AST_IDENTIFIER:
+        return strcmp(((ast_identifier*)node)->name, name) == 0;
+    case AST_BINARY_OP:
+        return expression_mentions(((ast_binary_op*)node)->left, name) ||
+               expression_mentions(((ast_binary_op*)node)->right, name);
+    case AST_UNARY_OP:
+        return expression_mentions(((ast_unary_op*)node)->operand, name);
+    case AST_TERNARY:
+        return expression_mentions(((ast_ternary*)node)->condition, name) ||
+               expression_mentions(((ast_ternary*)node)->true_expr, name) ||
+               expression_mentions(((ast_ternary*)node)->false_expr, name);
+    case AST_ASSIGNMENT:
+        return expression_mentions(((ast_assignment*)node)->target, name) ||
+               expression_mentions(((ast_assignment*)node)->value, name);
+    default:
+        return false;
+    }
+}
+
+void codegen_infer_types(codegen_t* codegen, ast_node** statements, size_t statement_count,
+                         char** parameters, size_t param_count) {
+    type_env_t* env = &codegen->types;
+    int is_program = codegen->parent == NULL;
+    int changed = 1;
+
+    // Every pass can only move names up the lattice, so this terminates
+    while (changed) {
+        changed = 0;
+        infer_walk_t walk = {.env = env, .is_program = is_program, .changed = &changed};
+        for (size_t i = 0; i < param_count; i++) {
+            env_join(env, parameters[i], STATIC_TYPE_UNKNOWN, &changed);
+            walk_declare(&walk, parameters[i]);
+        }
+        for (size_t i = 0; i < statement_count; i++) {
+            walk_node(&walk, statements[i], 0, 0);
+        }
+        free(walk.visible);
+    }
+
+    // Names only ever assigned from themselves have no evidence either way
+    for (int i = 0; i < env->count; i++) {
+        if (env->bindings[i].type == STATIC_TYPE_NONE) {
+            env->bindings[i].type = STATIC_TYPE_UNKNOWN;
+        }
+    }
+}
+
+void codegen_free_types(codegen_t* codegen) {
+    for (int i = 0; i < codegen->types.count; i++) {
+        free(codegen->types.bindings[i].name);
+    }
+    free(codegen->types.bindings);
+    codegen->types.bindings = NULL;
+    codegen->types.count = 0;
+    codegen->types.capacity = 0;
+}
+
+// === Codegen queries ===
+
+static static_type local_lookup(void* context, const char* name) {
+    codegen_t* codegen = context;
+    for (int i = codegen->scope.local_count - 1; i >= 0; i--) {
+        if (strcmp(codegen->scope.locals[i].name, name) == 0) {
+            return codegen->scope.locals[i].type;
+        }
+    }
+    return STATIC_TYPE_UNKNOWN; // Upvalue or global
+}
+
+// Type of an expression at the current point of code generation (identifiers via local slots)
+static_type codegen_expression_type(codegen_t* codegen, ast_node* expr) {
+    static_type type = infer_type(expr, local_lookup, codegen);
+    return type == STATIC_TYPE_NONE ? STATIC_TYPE_UNKNOWN : type;
+}
+
+// Whether a nested function of the one being compiled mentions name, and so may see its local
+bool codegen_name_is_captured(codegen_t* codegen, const char* name) {
+    type_binding_t* binding = env_find(&codegen->types, name);
+    return binding && binding->captured;
+}
+
+// Attach the inferred type of name to a freshly declared local and record it for --disassemble
+void codegen_assign_local_type(codegen_t* codegen, int slot, const char* name) {
+    type_binding_t* binding = env_find(&codegen->types, name);
+    static_type type = binding ? binding->type : STATIC_TYPE_UNKNOWN;
+
+    for (int i = codegen->scope.local_count - 1; i >= 0; i--) {
+        if (codegen->scope.locals[i].slot == slot) {
+            codegen->scope.locals[i].type = type;
+            break;
+        }
+    }
+    if (type == STATIC_TYPE_UNKNOWN || type == STATIC_TYPE_NONE) return;
+
+    bytecode_chunk* chunk = codegen->chunk;
+    char entry[256];
+    snprintf(entry, sizeof(entry), "%s: %s", name, static_type_name(type));
+    if (chunk->local_types) {
+        // Redeclarations share one entry
+        const char* existing = strstr(chunk->local_types, entry);
+        size_t entry_length = strlen(entry);
+        while (existing) {
+            bool starts = existing == chunk->local_types || existing[-1] == ' ';
+            bool ends = existing[entry_length] == '\0' || existing[entry_length] == ',';
+            if (starts && ends) return;
+            existing = strstr(existing + 1, entry);
+        }
+    }
+
+    size_t old_length = chunk->local_types ? strlen(chunk->local_types) : 0;
+    char* local_types = realloc(chunk->local_types, old_length + strlen(entry) + 3);
+    if (!local_types) return;
+    if (old_length > 0) {
+        snprintf(local_types + old_length, strlen(entry) + 3, ", %s", entry);
+    } else {
+        strcpy(local_types, entry);
+    }
+    chunk->local_types = local_types;
+}
+
+// Opcode specialized for the statically known operand types of `left op right`, if there is one
+bool codegen_specialize_binary_op(codegen_t* codegen, binary_operator op, ast_node* left_expr, ast_node* right_expr,
+                                  opcode* specialized) {
+    static_type left = codegen_expression_type(codegen, left_expr);
+    static_type right = codegen_expression_type(codegen, right_expr);
+    if (left != right) return false;
+
+    switch (left) {
+    case STATIC_TYPE_INT:
+        switch (op) {
+        case BIN_ADD: *specialized = OP_ADD_INT; return true;
+        case BIN_SUBTRACT: *specialized = OP_SUBTRACT_INT; return true;
+        case BIN_MULTIPLY: *specialized = OP_MULTIPLY_INT; return true;
+        case BIN_LESS: *specialized = OP_LESS_INT; return true;
+        case BIN_LESS_EQUAL: *specialized = OP_LESS_EQUAL_INT; return true;
+        case BIN_GREATER: *specialized = OP_GREATER_INT; return true;
+        case BIN_GREATER_EQUAL: *specialized = OP_GREATER_EQUAL_INT; return true;
+        default: return false;
+        }
+    case STATIC_TYPE_FLOAT64:
+        switch (op) {
+        case BIN_ADD: *specialized = OP_ADD_FLOAT; return true;
+        case BIN_SUBTRACT: *specialized = OP_SUBTRACT_FLOAT; return true;
+        case BIN_MULTIPLY: *specialized = OP_MULTIPLY_FLOAT; return true;
+        case BIN_DIVIDE: *specialized = OP_DIVIDE_FLOAT; return true;
+        default: return false;
+        }
+    case STATIC_TYPE_STRING:
+        *specialized = OP_CONCAT_STRING;
+        return op == BIN_ADD;
+    default:
+        return false;
+    }
+}
@@ -13,13 +13,13 @@
 #include <time.h>
 
 // Global class references
-value_t* global_local_date_class = NULL;
-value_t* global_local_time_class = NULL;
-value_t* global_local_datetime_class = NULL;
-value_t* global_date_class = NULL;
-value_t* global_instant_class = NULL;
-value_t* global_duration_class = NULL;
-value_t* global_period_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_local_date_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_local_time_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_local_datetime_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_date_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_instant_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_duration_class = NULL;
+SLATE_ISOLATE_LOCAL value_t* global_period_class = NULL;
 
 // Date constants
 static const int DAYS_IN_MONTH[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
@@ -577,8 +577,8 @@ char* local_datetime_to_string(vm_t* vm, const local_datetime_t* dt) {
 
 // LocalDateTime utility functions
 local_datetime_t* local_datetime_now(vm_t* vm) {
-    time_t t = time(NULL);
-    struct tm* tm = localtime(&t);
+    struct tm tm_storage;
+    struct tm* tm = timezone_localtime(time(NULL), &tm_storage);
     if (tm == NULL) {
         runtime_error(vm, "System time function failed");
     }
@@ -609,8 +609,8 @@ value_t builtin_local_date_now(vm_t* vm, int arg_count, value_t* args) {
         runtime_error(vm, "LocalDate.now() takes no arguments");
     }
 
-    time_t t = time(NULL);
-    struct tm* tm = localtime(&t);
+    struct tm tm_storage;
+    struct tm* tm = timezone_localtime(time(NULL), &tm_storage);
     if (tm == NULL) {
         runtime_error(vm, "System time function failed");
     }
@@ -41,6 +41,7 @@ static keyword_entry_t keywords[] = {
     {"break", TOKEN_BREAK},
     {"continue", TOKEN_CONTINUE},
     {"return", TOKEN_RETURN},
+    {"yield", TOKEN_YIELD},
     {"then", TOKEN_THEN},
     {"end", TOKEN_END},
     {"and", TOKEN_AND},
@@ -799,6 +800,7 @@ const char* token_type_name(token_type_t type) {
         case TOKEN_DO: return "DO";
         case TOKEN_BREAK: return "BREAK";
         case TOKEN_RETURN: return "RETURN";
+        case TOKEN_YIELD: return "YIELD";
         case TOKEN_THEN: return "THEN";
         case TOKEN_END: return "END";
         case TOKEN_AND: return "AND";
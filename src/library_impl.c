@@ -6,6 +6,12 @@
 #define DI_IMPLEMENTATION
 #define DB_IMPLEMENTATION
 
+// Property keys are interned in one process-wide table shared by isolates on every thread
+#include <pthread.h>
+static pthread_mutex_t intern_lock = PTHREAD_MUTEX_INITIALIZER;
+#define DO_INTERN_LOCK() pthread_mutex_lock(&intern_lock)
+#define DO_INTERN_UNLOCK() pthread_mutex_unlock(&intern_lock)
+
 // Include the libraries once here
 #include "dynamic_array.h"
 #include "dynamic_int.h"
@@ -77,6 +77,19 @@ static struct cag_option options[] = {
         .access_name = "include",
         .value_name = "PATH",
         .description = "Add directory to module search path (can be used multiple times)"
+    },
+    {
+        .identifier = 'c',
+        .access_name = "emit-c",
+        .value_name = "PATH",
+        .description = "Compile a script to C for linking against slate_runtime"
+    },
+    {
+        .identifier = 'o',
+        .access_letters = "o",
+        .access_name = "output",
+        .value_name = "PATH",
+        .description = "Output file for --emit-c (default: standard output)"
     }
 };
 
@@ -97,6 +110,7 @@ static void show_help(const char* program_name) {
     printf("  %s --test                    # Run built-in tests\n", program_name);
     printf("  %s -D \"f(g(3))\"              # Disassemble bytecode\n", program_name);
     printf("  %s -I /path/to/modules script.sl  # Add module search path\n", program_name);
+    printf("  %s --emit-c script.sl -o script.c  # Compile ahead of time to C\n", program_name);
     printf("  SLATEPATH=/path/to/modules %s script.sl  # Use environment variable\n", program_name);
     printf("\nShebang usage:\n");
     printf("  #!/usr/bin/env %s\n", program_name);
@@ -167,7 +181,8 @@ static void disassemble(const char* source) {
         .code = function->bytecode,
         .count = function->bytecode_length,
         .constants = function->constants,
-        .constant_count = function->constant_count
+        .constant_count = function->constant_count,
+        .local_types = function->local_types
     };
     chunk_disassemble_with_vm(&chunk, "main", temp_vm);
     printf("\n");
@@ -183,40 +198,13 @@ static void disassemble(const char* source) {
 // Forward declaration
 static void interpret_with_vm(const char* source, vm_t* vm);
 
-// Add search paths from SLATEPATH environment variable
-static void add_env_search_paths(vm_t* vm) {
-    const char* slate_path = getenv("SLATEPATH");
-    if (!slate_path) return;
-    
-    // Make a copy since we'll modify it with strtok
-    char* path_copy = strdup(slate_path);
-    if (!path_copy) return;
-    
-    // Split by colon (Unix) or semicolon (Windows)
-    const char* delimiter = ":";
-    #ifdef _WIN32
-    delimiter = ";";
-    #endif
-    
-    char* token = strtok(path_copy, delimiter);
-    while (token != NULL) {
-        // Skip empty tokens
-        if (strlen(token) > 0) {
-            module_add_search_path(vm, token);
-        }
-        token = strtok(NULL, delimiter);
-    }
-    
-    free(path_copy);
-}
-
 // Apply both environment variable and command line search paths to a VM
 static void configure_search_paths(vm_t* vm, char** include_paths, int include_count) {
     // First add current working directory (default behavior)
     module_add_search_path(vm, ".");
     
     // Then add environment paths
-    add_env_search_paths(vm);
+    module_add_env_search_paths(vm);
     
     // Finally add command line paths (highest priority)
     for (int i = 0; i < include_count; i++) {
@@ -367,6 +355,54 @@ static char* read_file(const char* path) {
     return buffer;
 }
 
+// Compile a script file to C (see aot.h). The VM is set up like file mode so the
+// function table indices baked into the program match the ones aot_main will see.
+static int emit_c(const char* path, const char* output_path) {
+    char* source = read_file(path);
+    if (!source) return 1;
+
+    lexer_t lexer;
+    lexer_init(&lexer, source);
+    parser_t parser;
+    parser_init(&parser, &lexer);
+    ast_program* program = parse_program(&parser);
+    if (parser.had_error || !program) {
+        fprintf(stderr, "Parse error\n");
+        lexer_cleanup(&lexer);
+        free(source);
+        return 1;
+    }
+
+    vm_t* vm = vm_create();
+    vm->context = CTX_SCRIPT;
+    module_system_init(vm);
+    size_t first_function = vm->functions->length;
+
+    codegen_t* codegen = codegen_create_with_debug(vm, source);
+    function_t* function = codegen_compile(codegen, program);
+    int status = 1;
+    if (codegen->had_error || !function) {
+        fprintf(stderr, "Compilation error\n");
+    } else {
+        FILE* out = output_path ? fopen(output_path, "w") : stdout;
+        if (!out) {
+            fprintf(stderr, "Could not open file \"%s\".\n", output_path);
+        } else {
+            status = codegen_emit_c(vm, function, first_function, path, out);
+            if (output_path) fclose(out);
+            if (status != 0 && output_path) remove(output_path);
+        }
+        function_destroy(function);
+    }
+
+    codegen_destroy(codegen);
+    ast_free((ast_node*)program);
+    lexer_cleanup(&lexer);
+    vm_destroy(vm);
+    free(source);
+    return status;
+}
+
 static void repl_with_args(int argc, char** argv, char** include_paths, int include_count);
 static void repl(void) { repl_with_args(0, NULL, NULL, 0); }
 static int should_continue_for_data_declaration(ast_program* program);
@@ -702,6 +738,8 @@ int main(int argc, char* argv[]) {
     int use_stdin = 0;
     const char* script_content = NULL;
     const char* disassemble_content = NULL;
+    const char* emit_c_file = NULL;
+    const char* output_path = NULL;
     int start_repl = 0;
     
     // Collect include paths
@@ -726,7 +764,7 @@ int main(int argc, char* argv[]) {
             vm->context = CTX_SCRIPT;
             module_system_init(vm);
             module_add_search_path(vm, ".");  // Current directory
-            add_env_search_paths(vm); // Environment paths
+            module_add_env_search_paths(vm); // Environment paths
             interpret_with_vm_mode(source, vm, 0); // Hide undefined results
             vm_destroy(vm);
             free(source);
@@ -767,6 +805,12 @@ int main(int argc, char* argv[]) {
             case 'D':
                 disassemble_content = cag_option_get_value(&context);
                 break;
+            case 'c':
+                emit_c_file = cag_option_get_value(&context);
+                break;
+            case 'o':
+                output_path = cag_option_get_value(&context);
+                break;
             case 'I':
                 // Add include path
                 include_paths = realloc(include_paths, sizeof(char*) * (include_count + 1));
@@ -795,9 +839,10 @@ int main(int argc, char* argv[]) {
     if (script_file) execution_modes++;
     if (disassemble_content) execution_modes++;
     if (start_repl) execution_modes++;
+    if (emit_c_file) execution_modes++;
     
     if (execution_modes > 1) {
-        fprintf(stderr, "Error: Only one execution mode can be specified (--stdin, --script, --file, --disassemble, or --repl)\n");
+        fprintf(stderr, "Error: Only one execution mode can be specified (--stdin, --script, --file, --disassemble, --emit-c, or --repl)\n");
         show_help(argv[0]);
         return 1;
     }
@@ -805,6 +850,13 @@ int main(int argc, char* argv[]) {
     if (disassemble_content) {
         // Disassemble the provided code
         disassemble(disassemble_content);
+    } else if (emit_c_file) {
+        int status = emit_c(emit_c_file, output_path);
+        for (int i = 0; i < include_count; i++) {
+            free(include_paths[i]);
+        }
+        free(include_paths);
+        return status;
     } else if (use_stdin) {
         // Read and interpret from stdin with result display
         char* source = read_stdin();
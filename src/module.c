@@ -315,6 +315,37 @@ void module_add_search_path(struct slate_vm* vm, const char* search_path) {
     da_push(vm->module_search_paths, &path_copy);
 }
 
+// Add search paths from the SLATEPATH environment variable
+void module_add_env_search_paths(struct slate_vm* vm) {
+    const char* slate_path = getenv("SLATEPATH");
+    if (!vm || !slate_path) return;
+    
+    // Make a copy since we'll split it in place (not with strtok, which isn't thread-safe)
+    char* path_copy = strdup(slate_path);
+    if (!path_copy) return;
+    
+    // Split by colon (Unix) or semicolon (Windows)
+    char delimiter = ':';
+    #ifdef _WIN32
+    delimiter = ';';
+    #endif
+    
+    char* token = path_copy;
+    while (token != NULL) {
+        char* next = strchr(token, delimiter);
+        if (next) {
+            *next++ = '\0';
+        }
+        // Skip empty tokens
+        if (*token != '\0') {
+            module_add_search_path(vm, token);
+        }
+        token = next;
+    }
+    
+    free(path_copy);
+}
+
 // Clear all search paths
 void module_clear_search_paths(struct slate_vm* vm) {
     if (!vm)
@@ -13,6 +13,7 @@ vm_result op_add(vm_t* vm) {
         // Concatenate using DS library
         ds_string result = ds_append(str_a, str_b);
         vm_push(vm, make_string_ds_with_debug(result, a.debug));
+        ds_release(&result); // The stack took its own reference
 
         // Clean up temporary strings
         ds_release(&str_a);
@@ -40,6 +41,7 @@ vm_result op_add(vm_t* vm) {
         }
 
         vm_push(vm, make_array_with_debug(result_array, a.debug));
+        da_release(&result_array); // The stack took its own reference
     }
     // Numeric addition - handle all numeric type combinations
     else if (is_number(a) && is_number(b)) {
@@ -0,0 +1,35 @@
+#include "vm.h"
+#include "module.h"
+#include "opcodes.h"
+
+// As op_append_local, for a global (or module-level) x. The global is looked up only after b has
+// been converted, since a user toString() may define globals and move the namespace's storage.
+vm_result op_append_global(vm_t* vm) {
+    uint16_t name_constant = *vm->ip | (*(vm->ip + 1) << 8);
+    vm->ip += 2;
+    if (vm->stack_top[-2].type != VAL_STRING) {
+        return op_add(vm);
+    }
+
+    value_t b = vm_pop(vm);
+    ds_string text = b.type == VAL_STRING ? ds_retain(b.as.string) : call_toString_for_string_conversion(vm, b);
+
+    // Resolve x the way OP_SET_GLOBAL will; an immutable one is never written through, so the
+    // assignment that follows can still reject it
+    function_t* current_func = vm->frames[vm->frame_count - 1].closure->function;
+    const char* name = property_key(current_func->constants[name_constant].as.string);
+    module_t* current_module = module_get_current_context(vm);
+    value_t* variable = current_module ? (value_t*)do_get_interned(current_module->namespace, name) : NULL;
+    if (!variable) {
+        variable = (value_t*)do_get_interned(vm->globals, name);
+    }
+    bool* immutable_flag = (bool*)do_get_interned(vm->global_immutability, name);
+    if (immutable_flag && *immutable_flag) {
+        variable = NULL;
+    }
+
+    vm_append_string(vm, variable, text);
+    ds_release(&text);
+    vm_release(b);
+    return VM_OK;
+}
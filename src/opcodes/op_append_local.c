@@ -0,0 +1,40 @@
+#include "vm.h"
+#include "opcodes.h"
+
+// Appends text to the string on top of the stack for `x = x + text` / `x += text`, where variable
+// is x's storage (NULL if it mustn't be written through). Strings are immutable, so this only
+// grows the string in place when nothing else can see it: the stack holds the only reference, or
+// x holds the other one and is pointed at the grown string. Otherwise it copies, and the copy is
+// then unshared, so a loop of appends runs in linear rather than quadratic time.
+void vm_append_string(vm_t* vm, value_t* variable, ds_string text) {
+    value_t* top = vm->stack_top - 1;
+    ds_string str = top->as.string;
+    size_t references = ds_refcount(str);
+    int held_by_variable = variable && variable->type == VAL_STRING && variable->as.string == str;
+    if (references == 1 || (references == 2 && held_by_variable)) {
+        str = ds_append_in_place(str, text, ds_length(text));
+        top->as.string = str;
+        if (held_by_variable) {
+            variable->as.string = str;
+        }
+    } else {
+        top->as.string = ds_concat(str, text);
+        ds_release(&str);
+    }
+}
+
+// The top two values are [a, b] as for OP_ADD; anything but a string on the left is a plain add
+vm_result op_append_local(vm_t* vm) {
+    uint8_t slot = *vm->ip++;
+    if (vm->stack_top[-2].type != VAL_STRING) {
+        return op_add(vm);
+    }
+
+    value_t b = vm_pop(vm);
+    ds_string text = b.type == VAL_STRING ? ds_retain(b.as.string) : call_toString_for_string_conversion(vm, b);
+    call_frame* frame = &vm->frames[vm->frame_count - 1];
+    vm_append_string(vm, &frame->slots[slot], text);
+    ds_release(&text);
+    vm_release(b);
+    return VM_OK;
+}
@@ -36,7 +36,7 @@ vm_result op_build_object(vm_t* vm) {
         }
 
         // Set property in object
-        if (do_set(object, key.as.string, &value, sizeof(value_t)) != 0) {
+        if (do_set_interned(object, property_key(key.as.string), &value, sizeof(value_t)) != 0) {
             do_release(&object);
             vm_release(key);
             vm_release(value);
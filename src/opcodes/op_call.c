@@ -1,11 +1,31 @@
 #include "vm.h"
 #include "runtime_error.h"
 #include "module.h"
+#include "../opcodes/opcodes.h"
+#include "../classes/String/class_string.h"
 
 vm_result op_call(vm_t* vm) {
     uint16_t arg_count = *vm->ip | (*(vm->ip + 1) << 8);
     vm->ip += 2;
 
+    return op_call_value(vm, arg_count);
+}
+
+// Pooled closures (OP_CLOSURE_LOCAL) are only safe inside the builtin natives the compiler
+// trusted; user functions and constructors may store their arguments, so hand them heap copies
+static void promote_local_closures(value_t* args, uint16_t arg_count) {
+    for (int i = 0; i < arg_count; i++) {
+        if (args[i].type == VAL_CLOSURE && args[i].as.closure->is_local) {
+            closure_t* copy = closure_promote(args[i].as.closure);
+            if (copy) {
+                args[i].as.closure = copy;
+            }
+        }
+    }
+}
+
+// Call the value sitting below arg_count arguments on the stack
+vm_result op_call_value(vm_t* vm, uint16_t arg_count) {
     // Pop arguments into temporary array (they're on stack in reverse order)
     value_t* args = NULL;
     if (arg_count > 0) {
@@ -92,6 +112,25 @@ vm_result op_call(vm_t* vm) {
             vm_release(callable);
         }
         
+        promote_local_closures(args, arg_count);
+        
+        // Generator functions don't run yet: the call evaluates to an Iterator over their yields
+        if (func->is_generator) {
+            iterator_t* iter = create_generator_iterator(vm, closure, callable.type == VAL_FUNCTION, args, arg_count);
+            for (int i = 0; i < arg_count; i++) {
+                vm_release(args[i]);
+            }
+            if (args)
+                free(args);
+            vm_release(callable);
+            if (!iter) {
+                slate_runtime_error(vm, ERR_ASSERT, __FILE__, __LINE__, -1, "Failed to create generator");
+                return VM_RUNTIME_ERROR;
+            }
+            vm_push(vm, make_iterator(iter));
+            return VM_OK;
+        }
+        
         // Push arguments onto the VM stack (they become the function's local variables)
         for (int i = 0; i < arg_count; i++) {
             vm_push(vm, args[i]);
@@ -195,22 +234,10 @@ vm_result op_call(vm_t* vm) {
             vm_release(callable);
         }
 
-        int32_t index = index_val.as.int32;
-        size_t string_length = ds_length(callable.as.string);
-
-        if (index < 0 || index >= string_length) {
-            // Out of bounds - return null as error indicator
-            vm_push(vm, make_null());
-            vm_release(args[0]);
-            free(args);
-            vm_release(callable);
-            return VM_OK;
-        }
-
-        // Get the character at the index
-        char ch = callable.as.string[index];
-        char ch_str[2] = {ch, '\0'};
-        vm_push(vm, make_string(ch_str));
+        // Out of bounds gives null as error indicator
+        value_t ch = string_char_at(callable.as.string, index_val.as.int32);
+        vm_push(vm, ch);
+        vm_release(ch); // The stack took its own reference
 
         vm_release(args[0]);
         free(args);
@@ -223,6 +250,7 @@ vm_result op_call(vm_t* vm) {
         class_t* cls = callable.as.class;
         if (cls->factory != NULL) {
             // Call the factory function to create an instance
+            promote_local_closures(args, arg_count);
             value_t result = cls->factory(vm, cls, arg_count, args);
             vm_push(vm, result);
 
@@ -242,7 +270,7 @@ vm_result op_call(vm_t* vm) {
     if (callable.type == VAL_UNDEFINED) {
         slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Cannot call undefined (property does not exist)");
     } else {
-        slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Value is not callable (type: %s)", value_type_name(callable.type));
+        slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Value is not callable (type: %s)", value_class_name(callable));
     }
     if (args) {
         for (int i = 0; i < arg_count; i++) {
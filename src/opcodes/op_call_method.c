@@ -58,7 +58,7 @@ vm_result op_call_method(vm_t* vm) {
     if (method.type == VAL_UNDEFINED) {
         slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Property does not exist (undefined is not callable)");
     } else {
-        slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Value is not callable (type: %s)", value_type_name(method.type));
+        slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Value is not callable (type: %s)", value_class_name(method));
     }
     if (args) {
         for (int i = 0; i < arg_count; i++) {
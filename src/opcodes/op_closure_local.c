@@ -0,0 +1,48 @@
+#include "vm.h"
+#include "runtime_error.h"
+
+// Like OP_CLOSURE, but for lambdas the compiler proved never outlive the call they are passed to
+// (arr.map(x -> x * k), immediately-invoked lambdas). The closure comes from the VM's pool and is
+// handed back by the OP_RELEASE_LOCAL_CLOSURES that follows the call, so no per-iteration malloc.
+vm_result op_closure_local(vm_t* vm) {
+    uint16_t constant = *vm->ip | (*(vm->ip + 1) << 8);
+    vm->ip += 2;
+    
+    // Get function index from constants
+    function_t* current_func = vm->frames[vm->frame_count - 1].closure->function;
+    value_t index_val = current_func->constants[constant];
+    if (index_val.type != VAL_INT32) {
+        runtime_error(vm, "Expected function index in OP_CLOSURE_LOCAL");
+        return VM_RUNTIME_ERROR;
+    }
+    
+    // Get function from function table
+    function_t* target_func = vm_get_function(vm, (size_t)index_val.as.int32);
+    if (!target_func) {
+        runtime_error(vm, "Invalid function index in OP_CLOSURE_LOCAL");
+        return VM_RUNTIME_ERROR;
+    }
+    
+    closure_t* closure = local_closure_acquire(vm, target_func);
+    if (!closure) {
+        runtime_error(vm, "Failed to create closure");
+        return VM_RUNTIME_ERROR;
+    }
+    
+    // Capture each upvalue (same descriptors as OP_CLOSURE)
+    call_frame* current_frame = &vm->frames[vm->frame_count - 1];
+    for (size_t i = 0; i < target_func->upvalue_count; i++) {
+        upvalue_desc_t* desc = &target_func->upvalue_descriptors[i];
+        value_t captured_value = desc->is_local ? current_frame->slots[desc->index]
+                                                : current_frame->closure->upvalues[desc->index];
+        closure->upvalues[i] = vm_retain(captured_value);
+    }
+    
+    value_t closure_val;
+    closure_val.type = VAL_CLOSURE;
+    closure_val.as.closure = closure;
+    closure_val.class = NULL;
+    closure_val.debug = NULL;
+    vm_push(vm, closure_val);
+    return VM_OK;
+}
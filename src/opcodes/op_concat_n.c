@@ -0,0 +1,75 @@
+#include "vm.h"
+#include "../classes/String/class_string.h"
+#include "../classes/Number/number_format.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Parts up to this count are tracked on the C stack
+#define CONCAT_INLINE_PARTS 8
+
+// One part's bytes: borrowed from a string, formatted into digits, or owned by a converted value
+typedef struct {
+    const char* data;
+    size_t length;
+    value_t converted; // toString() result for other values, released once copied
+    char digits[NF_MAX_LENGTH];
+} concat_part;
+
+// Template literal: pop n parts, convert each as StringBuilder.append() does and push their
+// concatenation, built in one exactly sized allocation
+vm_result op_concat_n(vm_t* vm) {
+    uint16_t count = *vm->ip | (*(vm->ip + 1) << 8);
+    vm->ip += 2;
+
+    value_t* values = vm->stack_top - count;
+
+    // "{name}" is the string itself
+    if (count == 1 && values[0].type == VAL_STRING) {
+        return VM_OK;
+    }
+
+    concat_part inline_parts[CONCAT_INLINE_PARTS];
+    concat_part* parts = count <= CONCAT_INLINE_PARTS ? inline_parts : malloc(sizeof(concat_part) * count);
+    size_t total = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        concat_part* part = &parts[i];
+        part->converted = make_null();
+        if (values[i].type == VAL_STRING) {
+            part->data = values[i].as.string;
+            part->length = ds_length(values[i].as.string);
+        } else if (values[i].type == VAL_INT32) {
+            part->data = part->digits;
+            part->length = nf_format_int32(part->digits, values[i].as.int32);
+        } else if (values[i].type == VAL_FLOAT64) {
+            part->data = part->digits;
+            part->length = nf_format_float64(part->digits, values[i].as.float64);
+        } else if (values[i].type == VAL_FLOAT32) {
+            part->data = part->digits;
+            part->length = nf_format_float32(part->digits, values[i].as.float32);
+        } else {
+            part->converted = builtin_value_to_string(vm, 1, &values[i]);
+            part->data = part->converted.as.string;
+            part->length = ds_length(part->converted.as.string);
+        }
+        total += part->length;
+    }
+
+    ds_string result = ds_new_uninit(total);
+    char* at = result;
+    for (uint16_t i = 0; i < count; i++) {
+        memcpy(at, parts[i].data, parts[i].length);
+        at += parts[i].length;
+        vm_release(parts[i].converted);
+    }
+    if (parts != inline_parts) {
+        free(parts);
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        vm_release(vm_pop(vm));
+    }
+    value_t string = make_string_ds(result);
+    vm_push(vm, string);
+    vm_release(string); // The stack took its own reference
+    return VM_OK;
+}
@@ -0,0 +1,15 @@
+#include "vm.h"
+
+// a + b where codegen has proven both operands are strings - no toString conversion needed
+vm_result op_concat_string(vm_t* vm) {
+    value_t b = vm_pop(vm);
+    value_t a = vm_pop(vm);
+
+    ds_string result = ds_append(a.as.string, b.as.string);
+    vm_push(vm, make_string_ds_with_debug(result, a.debug));
+    ds_release(&result); // The stack took its own reference
+
+    vm_release(a);
+    vm_release(b);
+    return VM_OK;
+}
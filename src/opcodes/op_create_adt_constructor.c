@@ -10,73 +10,24 @@
 
 // Wrapper factory function that creates ADT instances
 static value_t adt_constructor_wrapper(vm_t* vm, class_t* self, int arg_count, value_t* args) {
-    // Create a basic ADT instance without a release function
-    // We'll handle cleanup manually when the object is destroyed
-    do_object object = do_create(NULL);
-    if (!object) {
-        return make_null();
-    }
-    
-    value_t instance = make_object_with_debug(object, vm->current_debug);
-    
-    // Get constructor information directly from self - no more complex lookups needed!
-    const char* constructor_name = self->name; // "Some", "None", "b", etc.
-    
-    // Get metadata from the constructor class's static properties  
-    ds_string* case_type_metadata = NULL;
-    if (self->static_properties) {
-        case_type_metadata = (ds_string*)do_get(self->static_properties, "__constructor_case_type");
-    }
+    adt_constructor_t* layout = self->adt;
     
-    const char* case_type_str = "constructor"; // default
-    if (case_type_metadata) {
-        case_type_str = *case_type_metadata;
-    }
-    
-    // No need to find ADT base class - each constructor will have its own methods
-    
-    // Set the constructor class as the instance's class (same as any factory)
-    value_t* class_value = malloc(sizeof(value_t));
-    if (class_value) {
-        *class_value = (value_t){.type = VAL_CLASS, .as.class = self};
-        instance.class = class_value;
-        // Note: The class value is stored directly on the instance, not as a property
-        // It will be freed when the instance is destroyed via free_value
+    // Instance header and fields live in a single allocation sized from the declaration
+    adt_instance_t* adt = malloc(sizeof(adt_instance_t) + sizeof(value_t) * layout->field_count);
+    if (!adt) {
+        return make_null();
     }
     
-    // No need to store metadata in instance - it's all in the class now
-    
-    // Store constructor arguments using parameter names from class metadata
-    int32_t* param_count_ptr = (int32_t*)do_get(self->static_properties, "__constructor_param_count");
-    int stored_param_count = param_count_ptr ? *param_count_ptr : 0;
-    
+    adt->ref_count = 1;
+    adt->constructor = layout;
+    class_retain(self); // Keeps the shared layout alive for as long as the instance
     
     // Arguments are passed directly without receiver (different from op_call_method)
-    if (stored_param_count > 0 && arg_count > 0) {
-        // Use actual parameter names from class metadata
-        for (int i = 0; i < arg_count && i < stored_param_count; i++) {
-            char param_key[32];
-            snprintf(param_key, sizeof(param_key), "__param_%d", i);
-            ds_string* param_name_ptr = (ds_string*)do_get(self->static_properties, param_key);
-            if (param_name_ptr) {
-                ds_string param_name = *param_name_ptr; // dereference to get the actual ds_string
-                value_t retained_arg = vm_retain(args[i]); // Direct indexing, no receiver to skip
-                // Store the value_t struct directly
-                do_set(instance.as.object, param_name, &retained_arg, sizeof(value_t));
-            }
-        }
-    } else if (arg_count > 0) {
-        // Fallback to numbered parameters if metadata not available
-        for (int i = 0; i < arg_count; i++) {
-            char param_name[32];
-            snprintf(param_name, sizeof(param_name), "param_%d", i);
-            value_t retained_arg = vm_retain(args[i]); // Direct indexing, no receiver to skip
-            // Store the value_t struct directly
-            do_set(instance.as.object, param_name, &retained_arg, sizeof(value_t));
-        }
+    for (int i = 0; i < layout->field_count; i++) {
+        adt->fields[i] = i < arg_count ? vm_retain(args[i]) : make_null();
     }
     
-    return instance;
+    return make_adt_with_debug(adt, vm->current_debug);
 }
 
 vm_result op_create_adt_constructor(vm_t* vm) {
@@ -84,13 +35,13 @@ vm_result op_create_adt_constructor(vm_t* vm) {
     uint16_t param_count = *vm->ip | (*(vm->ip + 1) << 8);
     vm->ip += 2;
     
-    // Stack contains: [name, case_type, param_count, param_name1, param_name2, ...]
+    // Stack contains: [name, tag, param_count, param_name1, param_name2, ...]
     
-    // Pop parameter names
-    char** param_names = NULL;
+    // Pop parameter names straight into the constructor's field name table
+    char** field_names = NULL;
     if (param_count > 0) {
-        param_names = malloc(sizeof(char*) * param_count);
-        if (!param_names) {
+        field_names = malloc(sizeof(char*) * param_count);
+        if (!field_names) {
             runtime_error(vm, "Memory allocation failed for parameter names");
             return VM_RUNTIME_ERROR;
         }
@@ -101,33 +52,36 @@ vm_result op_create_adt_constructor(vm_t* vm) {
             if (param_name_val.type != VAL_STRING) {
                 // Clean up and error
                 for (int j = i + 1; j < (int)param_count; j++) {
-                    free(param_names[j]);
+                    free(field_names[j]);
                 }
-                free(param_names);
+                free(field_names);
                 vm_release(param_name_val);
                 runtime_error(vm, "Parameter name must be a string");
                 return VM_RUNTIME_ERROR;
             }
-            param_names[i] = strdup(param_name_val.as.string);
+            field_names[i] = strdup(param_name_val.as.string);
             vm_release(param_name_val);
         }
     }
     
     // Pop remaining values
     value_t param_count_val = vm_pop(vm);
-    value_t case_type_val = vm_pop(vm);
+    value_t tag_val = vm_pop(vm);
     value_t name_val = vm_pop(vm);
     
-    if (name_val.type != VAL_STRING || case_type_val.type != VAL_INT32 || param_count_val.type != VAL_INT32) {
+    adt_constructor_t* layout = malloc(sizeof(adt_constructor_t));
+    
+    if (name_val.type != VAL_STRING || tag_val.type != VAL_INT32 || param_count_val.type != VAL_INT32 || !layout) {
         // Clean up
-        if (param_names) {
+        if (field_names) {
             for (size_t i = 0; i < param_count; i++) {
-                free(param_names[i]);
+                free(field_names[i]);
             }
-            free(param_names);
+            free(field_names);
         }
+        free(layout);
         vm_release(param_count_val);
-        vm_release(case_type_val);
+        vm_release(tag_val);
         vm_release(name_val);
         runtime_error(vm, "Invalid ADT constructor parameters");
         return VM_RUNTIME_ERROR;
@@ -136,79 +90,43 @@ vm_result op_create_adt_constructor(vm_t* vm) {
     // Create a constructor class
     value_t constructor_class = make_class_with_debug(name_val.as.string, NULL, NULL, vm->current_debug);
     
-    // Store constructor metadata in the class static properties
-    if (constructor_class.as.class) {
-        if (!constructor_class.as.class->static_properties) {
-            constructor_class.as.class->static_properties = do_create(NULL);
-        }
-        
-        // Store case name
-        ds_string case_name_str = ds_new(name_val.as.string);
-        do_set(constructor_class.as.class->static_properties, "__constructor_case_name", &case_name_str, sizeof(ds_string));
-        
-        // Store case type based on parameter count - if it has params, it's a constructor
-        ds_string case_type_str = ds_new((param_count > 0) ? "constructor" : "singleton");
-        do_set(constructor_class.as.class->static_properties, "__constructor_case_type", &case_type_str, sizeof(ds_string));
-        
-        // Store parameter count
-        int32_t* param_count_ptr = malloc(sizeof(int32_t));
-        if (param_count_ptr) {
-            *param_count_ptr = param_count_val.as.int32;
-            do_set(constructor_class.as.class->static_properties, "__constructor_param_count", param_count_ptr, sizeof(int32_t));
-        }
-        
-        // Store parameter names as individual string properties
-        if (param_count > 0) {
-            for (size_t i = 0; i < param_count; i++) {
-                char param_key[32];
-                snprintf(param_key, sizeof(param_key), "__param_%zu", i);
-                ds_string param_name_str = ds_new(param_names[i]);
-                do_set(constructor_class.as.class->static_properties, param_key, &param_name_str, sizeof(ds_string));
-            }
-        }
-        
-        // Add static methods to constructor class
-        value_t class_toString_method = make_native(adt_class_toString);
-        do_set(constructor_class.as.class->static_properties, "toString", &class_toString_method, sizeof(value_t));
-        
-        value_t class_equals_method = make_native(adt_class_equals);
-        do_set(constructor_class.as.class->static_properties, "equals", &class_equals_method, sizeof(value_t));
-        
-        value_t class_hash_method = make_native(adt_class_hash);
-        do_set(constructor_class.as.class->static_properties, "hash", &class_hash_method, sizeof(value_t));
-        
-        // Add ADT instance methods to constructor class
-        if (!constructor_class.as.class->instance_properties) {
-            constructor_class.as.class->instance_properties = do_create(NULL);
-        }
-        
-        value_t instance_toString_method = make_native(adt_instance_toString);
-        do_set(constructor_class.as.class->instance_properties, "toString", &instance_toString_method, sizeof(value_t));
-        
-        value_t instance_equals_method = make_native(adt_instance_equals);
-        do_set(constructor_class.as.class->instance_properties, "equals", &instance_equals_method, sizeof(value_t));
-        
-        value_t instance_hash_method = make_native(adt_instance_hash);
-        do_set(constructor_class.as.class->instance_properties, "hash", &instance_hash_method, sizeof(value_t));
-    }
+    // Field layout shared by every instance; the class owns it and frees it in class_release
+    layout->class_value = constructor_class;
+    layout->class_value.debug = NULL;
+    layout->tag = (uint16_t)tag_val.as.int32;
+    layout->field_count = param_count;
+    layout->field_names = field_names;
+    constructor_class.as.class->adt = layout;
+    
+    // Add static methods to constructor class
+    value_t class_toString_method = make_native(adt_class_toString);
+    do_set(constructor_class.as.class->static_properties, "toString", &class_toString_method, sizeof(value_t));
+    
+    value_t class_equals_method = make_native(adt_class_equals);
+    do_set(constructor_class.as.class->static_properties, "equals", &class_equals_method, sizeof(value_t));
+    
+    value_t class_hash_method = make_native(adt_class_hash);
+    do_set(constructor_class.as.class->static_properties, "hash", &class_hash_method, sizeof(value_t));
+    
+    // Add ADT instance methods to constructor class
+    value_t instance_toString_method = make_native(adt_instance_toString);
+    do_set(constructor_class.as.class->instance_properties, "toString", &instance_toString_method, sizeof(value_t));
     
-    // Create a specialized factory function for this specific constructor
-    // For now, we'll use a shared factory and store the constructor name in the class
-    // The factory will extract the name when creating instances
+    value_t instance_equals_method = make_native(adt_instance_equals);
+    do_set(constructor_class.as.class->instance_properties, "equals", &instance_equals_method, sizeof(value_t));
+    
+    value_t instance_hash_method = make_native(adt_instance_hash);
+    do_set(constructor_class.as.class->instance_properties, "hash", &instance_hash_method, sizeof(value_t));
+    
+    // All constructors share one factory; the per-constructor layout comes from self->adt
     constructor_class.as.class->factory = adt_constructor_wrapper;
     
     vm_push(vm, constructor_class);
     
     // Clean up
-    if (param_names) {
-        for (size_t i = 0; i < param_count; i++) {
-            free(param_names[i]);
-        }
-        free(param_names);
-    }
     vm_release(param_count_val);
-    vm_release(case_type_val);
+    vm_release(tag_val);
     vm_release(name_val);
     
     return VM_OK;
-}
\ No newline at end of file
+}
@@ -0,0 +1,15 @@
+#include "vm.h"
+#include "opcodes.h"
+
+// a / b where codegen has proven both operands are float64. Division by zero is still an
+// error, so that case is reported by op_divide.
+vm_result op_divide_float(vm_t* vm) {
+    value_t* a = vm->stack_top - 2;
+    value_t* b = vm->stack_top - 1;
+    if (b->as.float64 == 0) {
+        return op_divide(vm);
+    }
+    *a = make_float64_with_debug(a->as.float64 / b->as.float64, a->debug);
+    vm->stack_top--;
+    return VM_OK;
+}
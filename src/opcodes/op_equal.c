@@ -5,6 +5,15 @@ vm_result op_equal(vm_t* vm) {
     value_t b = vm_pop(vm);
     value_t a = vm_pop(vm);
     
+    // Primitive pairs with builtin .equals() skip method lookup entirely
+    int fast = primitive_equals(a, b);
+    if (fast >= 0) {
+        vm_push(vm, make_boolean(fast));
+        vm_release(a);
+        vm_release(b);
+        return VM_OK;
+    }
+    
     // Call .equals() method on the left operand using method dispatch
     value_t* current_class = a.class;
     
@@ -26,7 +35,8 @@ vm_result op_equal(vm_t* vm) {
     }
     
     // If no .equals() method found, runtime error - all classes must have equals
+    const char* type = value_class_name(a);
     vm_release(a);
     vm_release(b);
-    runtime_error(vm, "Type %s has no .equals() method", value_type_name(a.type));
+    runtime_error(vm, "Type %s has no .equals() method", type);
 }
\ No newline at end of file
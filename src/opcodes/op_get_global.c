@@ -42,13 +42,14 @@ vm_result op_get_global(vm_t* vm) {
     
     // Fall through to namespace-aware global variable lookup
     do_object target_namespace = get_current_namespace(vm);
-    value_t* stored_value = (value_t*)do_get(target_namespace, name);
+    const char* key = property_key(name);
+    value_t* stored_value = (value_t*)do_get_interned(target_namespace, key);
     if (stored_value) {
         vm_push(vm, *stored_value);
     } else {
         // If not found in current namespace, try VM globals (for built-ins)
         if (target_namespace != vm->globals) {
-            stored_value = (value_t*)do_get(vm->globals, name);
+            stored_value = (value_t*)do_get_interned(vm->globals, key);
             if (stored_value) {
                 vm_push(vm, *stored_value);
                 return VM_OK;
@@ -0,0 +1,100 @@
+#include "vm.h"
+#include "runtime_error.h"
+#include "../opcodes/opcodes.h"
+#include "../classes/Range/range.h"
+#include "../classes/TypedArray/typed_array.h"
+#include "../classes/String/class_string.h"
+
+vm_result op_get_index(vm_t* vm) {
+    // Stack order: receiver, index (top)
+    value_t index_val = vm_peek(vm, 0);
+    value_t receiver = vm_peek(vm, 1);
+
+    // Anything that isn't an int32-indexed array/string/buffer/range is a regular call (functions,
+    // bound methods, constructors) or an indexing error - let op_call handle it
+    if (index_val.type != VAL_INT32) {
+        return op_call_value(vm, 1);
+    }
+
+    int32_t index = index_val.as.int32;
+
+    switch (receiver.type) {
+    case VAL_ARRAY: {
+        vm->stack_top -= 2;
+        size_t array_length = da_length(receiver.as.array);
+
+        if (index < 0 || index >= array_length) {
+            // Out of bounds - return null as error indicator
+            vm_push(vm, make_null());
+        } else {
+            vm_push(vm, *(value_t*)da_get(receiver.as.array, index));
+        }
+
+        vm_release(receiver);
+        return VM_OK;
+    }
+
+    case VAL_STRING: {
+        vm->stack_top -= 2;
+        value_t ch = string_char_at(receiver.as.string, index);
+        vm_push(vm, ch);
+        vm_release(ch); // The stack took its own reference
+        vm_release(receiver);
+        return VM_OK;
+    }
+
+    case VAL_BUFFER: {
+        vm->stack_top -= 2;
+        size_t buffer_size = db_size(receiver.as.buffer);
+
+        if (index < 0 || index >= buffer_size) {
+            // Out of bounds - return null as error indicator
+            vm_push(vm, make_null());
+        } else {
+            vm_push(vm, make_int32((uint8_t)receiver.as.buffer[index]));
+        }
+
+        vm_release(receiver);
+        return VM_OK;
+    }
+
+    case VAL_TYPED_ARRAY: {
+        vm->stack_top -= 2;
+        typed_array_t* array = receiver.as.typed_array;
+
+        if (index < 0 || (size_t)index >= array->length) {
+            // Out of bounds - return null as error indicator
+            vm_push(vm, make_null());
+        } else {
+            vm_push(vm, typed_array_get(array, (size_t)index));
+        }
+
+        vm_release(receiver);
+        return VM_OK;
+    }
+
+    case VAL_RANGE: {
+        range_t* range = receiver.as.range;
+        if (range->start.type != VAL_INT32 || range->end.type != VAL_INT32 || range->step.type != VAL_INT32) {
+            break;
+        }
+
+        vm->stack_top -= 2;
+        int32_t element;
+        if (range_int32_at(range, index, &element)) {
+            vm_push(vm, make_int32(element));
+        } else {
+            // Out of bounds - return null as error indicator
+            vm_push(vm, make_null());
+        }
+
+        vm_release(receiver);
+        return VM_OK;
+    }
+
+    default:
+        break;
+    }
+
+    return op_call_value(vm, 1);
+}
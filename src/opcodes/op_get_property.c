@@ -1,5 +1,6 @@
 #include "vm.h"
 #include "runtime_error.h"
+#include "../classes/ADT/adt_methods.h"
 
 vm_result op_get_property(vm_t* vm) {
     value_t property = vm_pop(vm);
@@ -10,6 +11,7 @@ vm_result op_get_property(vm_t* vm) {
     }
 
     const char* prop_name = property.as.string;
+    const char* key = property_key(property.as.string);
 
     // For classes, check static properties first (e.g., Buffer.fromHex)
     if (object.type == VAL_CLASS) {
@@ -30,7 +32,7 @@ vm_result op_get_property(vm_t* vm) {
 
     // For objects, check own properties first
     if (object.type == VAL_OBJECT) {
-        value_t* prop_value = (value_t*)do_get(object.as.object, prop_name);
+        value_t* prop_value = (value_t*)do_get_interned(object.as.object, key);
         if (prop_value) {
             vm_push(vm, *prop_value);
             vm_release(object);
@@ -39,6 +41,17 @@ vm_result op_get_property(vm_t* vm) {
         }
     }
 
+    // ADT fields come from the constructor's name table, then methods via the class
+    if (object.type == VAL_ADT) {
+        value_t* field = adt_instance_field(object.as.adt, prop_name);
+        if (field) {
+            vm_push(vm, *field);
+            vm_release(object);
+            vm_release(property);
+            return VM_OK;
+        }
+    }
+
     // Check the prototype chain via class - walk up inheritance hierarchy
     value_t* current_class = object.class;
     bool property_found = false;
@@ -47,7 +60,7 @@ vm_result op_get_property(vm_t* vm) {
     while (current_class && current_class->type == VAL_CLASS && !property_found) {
         // Get the class's instance properties (prototype chain)
         class_t* cls = current_class->as.class;
-        value_t* prop_value = lookup_instance_property(cls, prop_name);
+        value_t* prop_value = cls->instance_properties ? (value_t*)do_get_interned(cls->instance_properties, key) : NULL;
         if (prop_value) {
             // If it's a native function, create a bound method
             if (prop_value->type == VAL_NATIVE) {
@@ -1,4 +1,5 @@
 #include "vm.h"
+#include "../classes/ADT/adt_methods.h"
 
 vm_result op_in(vm_t* vm) {
     value_t object = vm_pop(vm);
@@ -18,8 +19,11 @@ vm_result op_in(vm_t* vm) {
     // Check different object types
     if (object.type == VAL_OBJECT) {
         // Check own properties
-        value_t* prop_value = (value_t*)do_get(object.as.object, prop_name);
+        value_t* prop_value = (value_t*)do_get_interned(object.as.object, property_key(property.as.string));
         found = (prop_value != NULL);
+    } else if (object.type == VAL_ADT) {
+        // Declared constructor parameters
+        found = (adt_instance_field(object.as.adt, prop_name) != NULL);
     } else if (object.type == VAL_ARRAY) {
         // For arrays, check if property name is a valid numeric index
         // or if it's a built-in array method/property
@@ -0,0 +1,14 @@
+#include "vm.h"
+#include "opcodes.h"
+
+// a < b where codegen has inferred both operands as Int (BigInt operands go through op_less)
+vm_result op_less_int(vm_t* vm) {
+    value_t* a = vm->stack_top - 2;
+    value_t* b = vm->stack_top - 1;
+    if (a->type == VAL_INT32 && b->type == VAL_INT32) {
+        *a = make_boolean_with_debug(a->as.int32 < b->as.int32, a->debug);
+        vm->stack_top--;
+        return VM_OK;
+    }
+    return op_less(vm);
+}
@@ -0,0 +1,94 @@
+#include "vm.h"
+#include "runtime_error.h"
+#include <string.h>
+
+static uint16_t read_u16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+
+static uint32_t read_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Constant pool of the code currently executing (same resolution as op_push_constant)
+static value_t* current_constants(vm_t* vm, size_t* count) {
+    if (vm->frame_count == 0) {
+        *count = vm->constant_count;
+        return vm->constants;
+    }
+    function_t* current_func = vm->frames[vm->frame_count - 1].closure->function;
+    *count = current_func->constant_count;
+    return current_func->constants;
+}
+
+vm_result op_match_switch(vm_t* vm) {
+    uint8_t kind = *vm->ip++;
+    uint16_t miss_offset = read_u16(vm->ip);
+    vm->ip += 2;
+
+    // The subject stays on the stack - case bodies expect it there
+    value_t subject = vm_peek(vm, 0);
+
+    switch (kind) {
+    case MATCH_SWITCH_INT32: {
+        int32_t min = (int32_t)read_u32(vm->ip);
+        uint16_t count = read_u16(vm->ip + 4);
+        const uint8_t* table = vm->ip + 6;
+        vm->ip += 6 + (size_t)count * 2;
+
+        // Other numeric types may still .equals() an int literal - use the sequential chain
+        if (subject.type != VAL_INT32) {
+            return VM_OK;
+        }
+
+        int64_t slot = (int64_t)subject.as.int32 - min;
+        if (slot >= 0 && slot < count) {
+            uint16_t offset = read_u16(table + slot * 2);
+            if (offset != 0xFFFF) {
+                vm->ip += offset;
+                return VM_OK;
+            }
+        }
+        vm->ip += miss_offset;
+        return VM_OK;
+    }
+
+    case MATCH_SWITCH_STRING: {
+        uint32_t seed = read_u32(vm->ip);
+        uint16_t slot_count = read_u16(vm->ip + 4);
+        const uint8_t* table = vm->ip + 6;
+        vm->ip += 6 + (size_t)slot_count * 8;
+
+        if (subject.type != VAL_STRING) {
+            return VM_OK;
+        }
+
+        size_t constant_count;
+        value_t* constants = current_constants(vm, &constant_count);
+        size_t length = ds_length(subject.as.string);
+        uint32_t hash = match_hash_seed(ds_hash32(subject.as.string), seed);
+        uint16_t mask = slot_count - 1;
+
+        // Linear probing; tables built without collisions resolve on the first probe
+        for (uint16_t probe = 0; probe < slot_count; probe++) {
+            const uint8_t* entry = table + (size_t)((hash + probe) & mask) * 8;
+            uint16_t constant = read_u16(entry + 4);
+            if (constant == 0xFFFF) {
+                break;
+            }
+            if (read_u32(entry) != hash || constant >= constant_count) {
+                continue;
+            }
+            ds_string pattern = constants[constant].as.string;
+            if (ds_length(pattern) == length && memcmp(pattern, subject.as.string, length) == 0) {
+                vm->ip += read_u16(entry + 6);
+                return VM_OK;
+            }
+        }
+        vm->ip += miss_offset;
+        return VM_OK;
+    }
+
+    default:
+        slate_runtime_error(vm, ERR_ASSERT, __FILE__, __LINE__, -1, "Unknown match switch kind %d", kind);
+        return VM_RUNTIME_ERROR;
+    }
+}
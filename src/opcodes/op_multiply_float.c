@@ -0,0 +1,10 @@
+#include "vm.h"
+
+// a * b where codegen has proven both operands are float64 - no type dispatch needed
+vm_result op_multiply_float(vm_t* vm) {
+    value_t* a = vm->stack_top - 2;
+    value_t* b = vm->stack_top - 1;
+    *a = make_float64_with_debug(a->as.float64 * b->as.float64, a->debug);
+    vm->stack_top--;
+    return VM_OK;
+}
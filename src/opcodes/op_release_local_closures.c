@@ -0,0 +1,10 @@
+#include "vm.h"
+
+vm_result op_release_local_closures(vm_t* vm) {
+    uint16_t count = *vm->ip | (*(vm->ip + 1) << 8);
+    vm->ip += 2;
+
+    // The call consuming the pooled closures has returned - their slots can be reused
+    local_closures_release(vm, count);
+    return VM_OK;
+}
@@ -28,6 +28,12 @@ vm_result op_return(vm_t* vm) {
         vm->result = result;
         return VM_OK;
     }
+    if (vm->frame_count == vm->call_floor) {
+        // Returning to C code (vm_call_function) - it restores ip/bytecode itself
+        vm->stack_top = current_frame->slots;
+        vm->result = result;
+        return VM_OK;
+    }
     
     // Get previous frame (now the active frame)
     call_frame* prev_frame = &vm->frames[vm->frame_count - 1];  // Frame to return to
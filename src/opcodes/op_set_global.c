@@ -39,11 +39,12 @@ vm_result op_set_global(vm_t* vm) {
 
     // Check if variable exists in current namespace
     do_object target_namespace = get_current_namespace(vm);
-    value_t* stored_value = (value_t*)do_get(target_namespace, name_val.as.string);
+    const char* key = property_key(name_val.as.string);
+    value_t* stored_value = (value_t*)do_get_interned(target_namespace, key);
     
     // If not found in current namespace and we're in a module, try VM globals
     if (!stored_value && target_namespace != vm->globals) {
-        stored_value = (value_t*)do_get(vm->globals, name_val.as.string);
+        stored_value = (value_t*)do_get_interned(vm->globals, key);
         if (stored_value) {
             target_namespace = vm->globals; // Update target for immutability check
         }
@@ -51,7 +52,7 @@ vm_result op_set_global(vm_t* vm) {
     
     if (stored_value) {
         // Check if variable is immutable
-        bool* immutable_flag = (bool*)do_get(vm->global_immutability, name_val.as.string);
+        bool* immutable_flag = (bool*)do_get_interned(vm->global_immutability, key);
         if (immutable_flag && *immutable_flag) {
             char error_msg[256];
             snprintf(error_msg, sizeof(error_msg), "Cannot assign to immutable variable '%s'", name_val.as.string);
@@ -1,5 +1,31 @@
 #include "vm.h"
 #include "runtime_error.h"
+#include "../classes/TypedArray/typed_array.h"
+
+// typedArray(i) = value: stored unboxed, so the value has to fit the element type
+static vm_result set_typed_array_index(vm_t* vm, value_t array_val, value_t index_val, value_t value) {
+    typed_array_t* array = array_val.as.typed_array;
+    vm_result result = VM_OK;
+    if (index_val.type != VAL_INT32) {
+        slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Array index must be an integer");
+        result = VM_RUNTIME_ERROR;
+    } else if (index_val.as.int32 < 0 || (size_t)index_val.as.int32 >= array->length) {
+        slate_runtime_error(vm, ERR_RANGE, __FILE__, __LINE__, -1, "Array index out of bounds: %d (array length: %zu)",
+                            index_val.as.int32, array->length);
+        result = VM_RUNTIME_ERROR;
+    } else if (!typed_array_set(array, (size_t)index_val.as.int32, value)) {
+        slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "%s elements must be %s, not %s",
+                            typed_array_class_name(array->kind),
+                            array->kind == TYPED_INT32 ? "Int32 values" : "numbers", value_class_name(value));
+        result = VM_RUNTIME_ERROR;
+    } else {
+        vm_push(vm, vm_retain(value));
+    }
+    vm_release(value);
+    vm_release(index_val);
+    vm_release(array_val);
+    return result;
+}
 
 vm_result op_set_index(vm_t* vm) {
     // Stack order: array, index, value (top)
@@ -12,6 +38,10 @@ vm_result op_set_index(vm_t* vm) {
     // Pop the array
     value_t array_val = vm_pop(vm);
     
+    if (array_val.type == VAL_TYPED_ARRAY) {
+        return set_typed_array_index(vm, array_val, index_val, value);
+    }
+
     // Validate that we have an array
     if (array_val.type != VAL_ARRAY) {
         slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Can only set index on arrays");
@@ -1,5 +1,6 @@
 #include "vm.h"
 #include "runtime_error.h"
+#include "../classes/ADT/adt_methods.h"
 
 vm_result op_set_property(vm_t* vm) {
     // Stack order: object, property_name, value (top)
@@ -12,6 +13,26 @@ vm_result op_set_property(vm_t* vm) {
     // Pop the object
     value_t object = vm_pop(vm);
     
+    // ADT instances have a fixed layout - only declared fields can be assigned
+    if (object.type == VAL_ADT && property_name.type == VAL_STRING) {
+        value_t* field = adt_instance_field(object.as.adt, property_name.as.string);
+        if (!field) {
+            slate_runtime_error(vm, ERR_REFERENCE, __FILE__, __LINE__, -1, "%s has no field '%s'",
+                                object.as.adt->constructor->class_value.as.class->name, property_name.as.string);
+            vm_release(value);
+            vm_release(property_name);
+            vm_release(object);
+            return VM_RUNTIME_ERROR;
+        }
+        vm_release(*field);
+        *field = vm_retain(value);
+        vm_push(vm, vm_retain(value));
+        vm_release(value);
+        vm_release(property_name);
+        vm_release(object);
+        return VM_OK;
+    }
+    
     // Validate that we have an object
     if (object.type != VAL_OBJECT) {
         slate_runtime_error(vm, ERR_TYPE, __FILE__, __LINE__, -1, "Can only set properties on objects");
@@ -32,14 +53,15 @@ vm_result op_set_property(vm_t* vm) {
     
     // Set the property in the object
     // First check if the property already exists and release the old value
-    value_t* existing_value = (value_t*)do_get(object.as.object, property_name.as.string);
+    const char* key = property_key(property_name.as.string);
+    value_t* existing_value = (value_t*)do_get_interned(object.as.object, key);
     if (existing_value) {
         vm_release(*existing_value);
     }
     
     // Set the new property value (retain it since it's now stored in the object)
     value_t new_value = vm_retain(value);
-    do_set(object.as.object, property_name.as.string, &new_value, sizeof(value_t));
+    do_set_interned(object.as.object, key, &new_value, sizeof(value_t));
     
     // Push the assigned value back onto the stack (for assignment expressions)
     vm_push(vm, vm_retain(value));
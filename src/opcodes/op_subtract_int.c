@@ -0,0 +1,17 @@
+#include "vm.h"
+#include "opcodes.h"
+
+// a - b where codegen has inferred both operands as Int. Int values are int32 until they
+// overflow into BigInt, so only that representation is handled inline; BigInt operands and
+// overflow go through op_subtract.
+vm_result op_subtract_int(vm_t* vm) {
+    value_t* a = vm->stack_top - 2;
+    value_t* b = vm->stack_top - 1;
+    int32_t result;
+    if (a->type == VAL_INT32 && b->type == VAL_INT32 && di_subtract_overflow_int32(a->as.int32, b->as.int32, &result)) {
+        *a = make_int32_with_debug(result, a->debug);
+        vm->stack_top--;
+        return VM_OK;
+    }
+    return op_subtract(vm);
+}
@@ -0,0 +1,46 @@
+#include "vm.h"
+#include "module.h"
+#include "runtime_error.h"
+#include <stdlib.h>
+
+vm_result op_yield(vm_t* vm) {
+    generator_t* gen = vm->generator;
+    call_frame* frame = &vm->frames[vm->frame_count - 1];
+
+    // Only the generator's own frame, entered by generator_has_next, can suspend
+    if (!gen || vm->frame_count - 1 != vm->call_floor || frame->closure != gen->closure) {
+        slate_runtime_error(vm, ERR_ASSERT, __FILE__, __LINE__, -1, "yield outside of a running generator");
+        return VM_RUNTIME_ERROR;
+    }
+
+    value_t value = vm_pop(vm);
+
+    // Move the frame's stack window into the generator; the values keep their references
+    size_t count = vm->stack_top - frame->slots;
+    if (count > gen->stack_capacity) {
+        value_t* grown = realloc(gen->stack, sizeof(value_t) * count);
+        if (!grown) {
+            vm_release(value);
+            slate_runtime_error(vm, ERR_ASSERT, __FILE__, __LINE__, -1, "Out of memory suspending generator");
+            return VM_RUNTIME_ERROR;
+        }
+        gen->stack = grown;
+        gen->stack_capacity = count;
+    }
+    for (size_t i = 0; i < count; i++) {
+        gen->stack[i] = frame->slots[i];
+    }
+    gen->stack_count = count;
+    gen->ip = vm->ip;
+    gen->pending = value;
+    gen->has_pending = 1;
+    gen->state = GEN_SUSPENDED;
+
+    // Leave the frame exactly as op_return would, without a result
+    if (frame->closure->module) {
+        module_pop_context(vm);
+    }
+    vm->stack_top = frame->slots;
+    vm->frame_count--;
+    return VM_OK;
+}
@@ -17,6 +17,7 @@ vm_result op_less_equal(vm_t* vm);
 vm_result op_greater(vm_t* vm);
 vm_result op_greater_equal(vm_t* vm);
 vm_result op_return(vm_t* vm);
+vm_result op_yield(vm_t* vm);
 vm_result op_get_local(vm_t* vm);
 vm_result op_set_local(vm_t* vm);
 vm_result op_define_global(vm_t* vm);
@@ -28,12 +29,33 @@ vm_result op_power(vm_t* vm);
 vm_result op_build_array(vm_t* vm);
 vm_result op_bitwise_and(vm_t* vm);
 
+// Type-specialized opcodes emitted for operands with inferred static types
+vm_result op_add_int(vm_t* vm);
+vm_result op_subtract_int(vm_t* vm);
+vm_result op_multiply_int(vm_t* vm);
+vm_result op_less_int(vm_t* vm);
+vm_result op_less_equal_int(vm_t* vm);
+vm_result op_greater_int(vm_t* vm);
+vm_result op_greater_equal_int(vm_t* vm);
+vm_result op_add_float(vm_t* vm);
+vm_result op_subtract_float(vm_t* vm);
+vm_result op_multiply_float(vm_t* vm);
+vm_result op_divide_float(vm_t* vm);
+vm_result op_concat_string(vm_t* vm);
+vm_result op_concat_n(vm_t* vm);
+vm_result op_append_local(vm_t* vm);
+vm_result op_append_global(vm_t* vm);
+void vm_append_string(vm_t* vm, value_t* variable, ds_string text);
+
 // New opcodes extracted from vm.c
 vm_result op_push_constant(vm_t* vm);
 vm_result op_get_global(vm_t* vm);
 vm_result op_get_property(vm_t* vm);
 vm_result op_call(vm_t* vm);
+vm_result op_call_value(vm_t* vm, uint16_t arg_count);
 vm_result op_closure(vm_t* vm);
+vm_result op_closure_local(vm_t* vm);
+vm_result op_release_local_closures(vm_t* vm);
 vm_result op_set_debug_location(vm_t* vm);
 vm_result op_push_null(vm_t* vm);
 vm_result op_push_undefined(vm_t* vm);
@@ -66,6 +88,7 @@ vm_result op_build_range(vm_t* vm);
 vm_result op_jump_if_false(vm_t* vm);
 vm_result op_jump_if_true(vm_t* vm);
 vm_result op_jump(vm_t* vm);
+vm_result op_match_switch(vm_t* vm);
 vm_result op_loop(vm_t* vm);
 vm_result op_pop_n(vm_t* vm);
 vm_result op_not(vm_t* vm);
@@ -80,6 +103,9 @@ vm_result op_get_export(vm_t* vm);
 vm_result op_call_adt_base_class(vm_t* vm);
 vm_result op_create_adt_constructor(vm_t* vm);
 
+// Element access opcodes
+vm_result op_get_index(vm_t* vm);
+
 // Element/property assignment opcodes
 vm_result op_set_index(vm_t* vm);
 vm_result op_set_property(vm_t* vm);
@@ -122,6 +122,7 @@ ast_node* parse_def_declaration(parser_t* parser) {
     
     // Parse function body - support both single-line and indented block forms
     ast_node* body = NULL;
+    int outer_saw_yield = parser_begin_function(parser);
     if (parser_check(parser, TOKEN_NEWLINE) || parser_check(parser, TOKEN_INDENT)) {
         // Indented block form: def name(params) =\n  <block>
         body = parse_indented_block(parser);
@@ -131,8 +132,9 @@ ast_node* parse_def_declaration(parser_t* parser) {
     }
     
     // Create function AST node (both forms are treated as expressions)
-    ast_node* func_node = (ast_node*)ast_create_function(parameters, param_count, body, 1,
-                                                        name_line, name_column);
+    ast_function* func_node = ast_create_function(parameters, param_count, body, 1,
+                                                  name_line, name_column);
+    parser_end_function(parser, func_node, outer_saw_yield);
     
     // Allow semicolon or newline to terminate statement
     if (!parser_match(parser, TOKEN_SEMICOLON)) {
@@ -140,7 +142,7 @@ ast_node* parse_def_declaration(parser_t* parser) {
     }
     
     // Return this as a variable declaration with the function as initializer
-    return (ast_node*)ast_create_var_declaration(func_name, func_node, 1,  // 1 = immutable (like val)
+    return (ast_node*)ast_create_var_declaration(func_name, (ast_node*)func_node, 1,  // 1 = immutable (like val)
                                                 name_line, name_column);
 }
 
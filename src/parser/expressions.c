@@ -1,7 +1,7 @@
 #include "parser_internal.h"
+#include "../classes/Number/number_parse.h"
 #include <stdlib.h>
 #include <string.h>
-#include <errno.h>
 #include <math.h>
 
 // Forward declarations for static functions
@@ -65,9 +65,25 @@ ast_node* parse_lambda_or_assignment(parser_t* parser) {
 
 // Parse expression
 ast_node* parse_expression(parser_t* parser) {
+    if (parser_match(parser, TOKEN_YIELD)) {
+        return parse_yield(parser);
+    }
     return parse_lambda_or_assignment(parser);
 }
 
+// Parse yield expression: yield <expression>
+ast_node* parse_yield(parser_t* parser) {
+    int line = parser->previous.line;
+    int column = parser->previous.column;
+    if (parser->function_depth == 0) {
+        parser_error(parser, "'yield' can only be used inside a function");
+    }
+    parser->saw_yield = 1;
+    
+    ast_node* value = parse_expression(parser);
+    return (ast_node*)ast_create_yield(value, line, column);
+}
+
 // Parse assignment
 ast_node* parse_assignment(parser_t* parser) {
     ast_node* expr = parse_ternary(parser);
@@ -465,24 +481,13 @@ ast_node* parse_primary(parser_t* parser) {
                 return (ast_node*)ast_create_bigint(big_value, parser->previous.line, parser->previous.column);
             }
         } else {
-            // Regular decimal integer - use original logic
-            char* endptr;
-            errno = 0;
-            long long value = strtoll(buffer, &endptr, 10);
-            
-            if (errno == ERANGE || value < INT32_MIN || value > INT32_MAX) {
-                // Too large for int32, create as BigInt
-                di_int big_value = di_from_string(buffer, 10);
-                if (big_value == NULL) {
-                    // Fallback to double for very large numbers
-                    double dval = strtod(buffer, NULL);
-                    return (ast_node*)ast_create_number(dval, parser->previous.line, parser->previous.column);
-                }
-                return (ast_node*)ast_create_bigint(big_value, parser->previous.line, parser->previous.column);
-            } else {
-                // Fits in int32 - create integer AST node
-                return (ast_node*)ast_create_integer((int32_t)value, parser->previous.line, parser->previous.column);
+            // Regular decimal integer: int32 when it fits, BigInt otherwise
+            np_number number;
+            np_parse(parser->previous.start, parser->previous.length, NP_INTEGER_ONLY, &number);
+            if (number.kind == NP_BIGINT) {
+                return (ast_node*)ast_create_bigint(number.as.bigint, parser->previous.line, parser->previous.column);
             }
+            return (ast_node*)ast_create_integer(number.as.int32, parser->previous.line, parser->previous.column);
         }
     }
     
@@ -603,10 +608,13 @@ ast_node* parse_arrow_function(parser_t* parser, char** parameters, size_t param
     parser_consume(parser, TOKEN_ARROW, "Expected '->' in arrow function");
     
     // Parse the function body (expression or indented block)
+    int outer_saw_yield = parser_begin_function(parser);
     ast_node* body = parse_expression(parser);
     
-    return (ast_node*)ast_create_function(parameters, param_count, body, 1, 
-                                         parser->previous.line, parser->previous.column);
+    ast_function* function = ast_create_function(parameters, param_count, body, 1,
+                                                 parser->previous.line, parser->previous.column);
+    parser_end_function(parser, function, outer_saw_yield);
+    return (ast_node*)function;
 }
 
 // Parse either a parenthesized expression or arrow function parameter list
@@ -1,4 +1,5 @@
 #include "parser_internal.h"
+#include "../classes/Number/number_parse.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -25,27 +26,13 @@ char* token_to_string(token_t* token) {
 // Helper function to extract number from token
 double token_to_number(token_t* token) {
     if (!token || !token->start) return 0.0;
-    
-    char* str = token_to_string(token);
-    if (!str) return 0.0;
-    
-    double value = strtod(str, NULL);
-    free(str);
-    
-    return value;
+    return np_parse_float64(token->start, token->length);
 }
 
 // Helper function to extract float32 from token
 float token_to_float32(token_t* token) {
     if (!token || !token->start) return 0.0f;
-    
-    char* str = token_to_string(token);
-    if (!str) return 0.0f;
-    
-    float value = strtof(str, NULL);
-    free(str);
-    
-    return value;
+    return np_parse_float32(token->start, token->length);
 }
 
 // Parser initialization
@@ -55,6 +42,8 @@ void parser_init(parser_t* parser, lexer_t* lexer) {
     parser->panic_mode = 0;
     parser->mode = PARSER_MODE_STRICT;  // Default to strict mode
     parser->pushback_count = 0;  // Initialize pushback
+    parser->function_depth = 0;
+    parser->saw_yield = 0;
     
     // Prime the parser with the first token
     parser_advance(parser);
@@ -219,6 +208,23 @@ void parser_synchronize(parser_t* parser) {
     }
 }
 
+// Enter a function body; returns the enclosing body's yield flag for parser_end_function
+int parser_begin_function(parser_t* parser) {
+    int outer_saw_yield = parser->saw_yield;
+    parser->saw_yield = 0;
+    parser->function_depth++;
+    return outer_saw_yield;
+}
+
+// Leave a function body: a yield anywhere in it (outside nested functions) makes it a generator
+void parser_end_function(parser_t* parser, ast_function* function, int outer_saw_yield) {
+    parser->function_depth--;
+    if (function) {
+        function->is_generator = parser->saw_yield;
+    }
+    parser->saw_yield = outer_saw_yield;
+}
+
 // Binary operator conversion
 binary_operator token_to_binary_op(token_type_t type) {
     switch (type) {
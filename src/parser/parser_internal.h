@@ -22,6 +22,8 @@ int parser_match(parser_t* parser, token_type_t type);
 void parser_consume(parser_t* parser, token_type_t type, const char* message);
 void parser_pushback(parser_t* parser);
 void parser_synchronize(parser_t* parser);
+int parser_begin_function(parser_t* parser);
+void parser_end_function(parser_t* parser, ast_function* function, int outer_saw_yield);
 
 // Declaration parsing (declarations.c)
 ast_node* parse_declaration(parser_t* parser);
@@ -49,6 +51,7 @@ ast_node* parse_expression_statement(parser_t* parser);
 // Expression parsing (expressions.c)
 ast_node* parse_lambda_or_assignment(parser_t* parser);
 ast_node* parse_expression(parser_t* parser);
+ast_node* parse_yield(parser_t* parser);
 ast_node* parse_assignment(parser_t* parser);
 ast_node* parse_or(parser_t* parser);
 ast_node* parse_and(parser_t* parser);
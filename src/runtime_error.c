@@ -5,7 +5,7 @@
 #include <string.h>
 
 // External reference to global VM pointer (defined in vm/lifecycle.c)
-extern vm_t* g_current_vm;
+extern SLATE_ISOLATE_LOCAL vm_t* g_current_vm;
 
 // Helper function to get error kind name
 static const char* error_kind_name(ErrorKind k) {
@@ -143,6 +143,12 @@ void slate_runtime_error(vm_t* vm, ErrorKind kind, const char* file, int line, i
         // Silent - just longjmp back to test
         longjmp(vm->trap, 1);
         break;
+
+    case CTX_ISOLATE:
+        // Report like a script, but unwind to the isolate runner instead of exiting the process
+        print_error_with_caret(stderr, &vm->error, debug_loc);
+        longjmp(vm->trap, 1);
+        break;
     }
 }
 
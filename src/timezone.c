@@ -20,8 +20,42 @@ static const timezone_t utc_timezone = {"UTC", 0, 0, NULL, "UTC", NULL};
 static const timezone_t utc_timezone = {"UTC", 0};
 #endif
 
-// System timezone pointer (set during initialization)
-static const timezone_t* system_timezone = NULL;
+// System timezone pointer. Every build reports UTC for now, so it is fixed here rather than
+// in init_timezone_system, which each VM (on any thread) calls
+static const timezone_t* const system_timezone = &utc_timezone;
+
+#ifdef FULL_TIMEZONE
+#include <pthread.h>
+
+// Lookups temporarily switch the process-wide TZ variable and share the pool in timezone_of,
+// so isolates running on other threads serialize on this lock
+static pthread_mutex_t timezone_lock = PTHREAD_MUTEX_INITIALIZER;
+
+#define TIMEZONE_POOL_SIZE 100
+static timezone_t full_timezones[TIMEZONE_POOL_SIZE];
+static char timezone_ids[TIMEZONE_POOL_SIZE][64];
+static int timezone_count = 0;
+
+// localtime_r() as seen from the named zone; the caller holds timezone_lock
+static struct tm* localtime_in(const char* tz_name, time_t seconds, struct tm* out) {
+    char* old_tz = getenv("TZ");
+    old_tz = old_tz ? strdup(old_tz) : NULL; // setenv may free the string getenv returned
+    setenv("TZ", tz_name, 1);
+    tzset();
+
+    struct tm* result = localtime_r(&seconds, out);
+
+    // Restore original timezone
+    if (old_tz) {
+        setenv("TZ", old_tz, 1);
+        free(old_tz);
+    } else {
+        unsetenv("TZ");
+    }
+    tzset();
+    return result;
+}
+#endif
 
 #ifdef EMBEDDED_TIMEZONE
 // Canadian timezone data (embedded mode)
@@ -58,13 +92,22 @@ void init_timezone_system(void) {
 #ifdef FULL_TIMEZONE
     // For full timezone support, system timezone is determined at runtime
     // This is a placeholder - real implementation would detect system timezone
-    system_timezone = &utc_timezone;
 #elif defined(EMBEDDED_TIMEZONE)
     // For embedded timezone, default to UTC (can be overridden)
-    system_timezone = &utc_timezone;
 #else
     // For minimal timezone, only UTC is available
-    system_timezone = &utc_timezone;
+#endif
+}
+
+// Thread-safe localtime() in the process's own zone
+struct tm* timezone_localtime(time_t seconds, struct tm* out) {
+#ifdef FULL_TIMEZONE
+    pthread_mutex_lock(&timezone_lock); // Don't read TZ while another thread has it switched
+    struct tm* result = localtime_r(&seconds, out);
+    pthread_mutex_unlock(&timezone_lock);
+    return result;
+#else
+    return localtime_r(&seconds, out);
 #endif
 }
 
@@ -75,7 +118,7 @@ const timezone_t* timezone_utc(void) {
 
 // Get system default timezone
 const timezone_t* timezone_system(void) {
-    return system_timezone ? system_timezone : &utc_timezone;
+    return system_timezone;
 }
 
 // Get timezone by ID
@@ -90,48 +133,33 @@ const timezone_t* timezone_of(const char* timezone_id) {
     }
 
 #ifdef FULL_TIMEZONE
-    // For full timezone support, validate timezone with system
-    // Try to set the timezone and see if it works
-    char* old_tz = getenv("TZ");
-    setenv("TZ", timezone_id, 1);
-    tzset();
-    
-    // Test if timezone is valid by getting current time
-    time_t test_time = time(NULL);
-    struct tm test_tm;
-    struct tm* result = localtime_r(&test_time, &test_tm);
-    
-    // Restore original timezone
-    if (old_tz) {
-        setenv("TZ", old_tz, 1);
-    } else {
-        unsetenv("TZ");
-    }
-    tzset();
-    
-    if (result == NULL) {
-        return NULL; // Invalid timezone
+    pthread_mutex_lock(&timezone_lock);
+
+    // Zones looked up before (by any VM) are reused rather than taking another pool slot
+    for (int i = 0; i < timezone_count; i++) {
+        if (strcmp(timezone_ids[i], timezone_id) == 0) {
+            pthread_mutex_unlock(&timezone_lock);
+            return &full_timezones[i];
+        }
     }
-    
-    // Create timezone object using static storage (like UTC)
-    // In a real implementation, you'd want a cache/pool for these
-    static timezone_t full_timezones[100]; // Simple static pool
-    static int timezone_count = 0;
-    
-    if (timezone_count >= 100) {
-        return NULL; // Pool exhausted
+
+    // Test if timezone is valid by getting current time in it
+    struct tm test_tm;
+    if (localtime_in(timezone_id, time(NULL), &test_tm) == NULL || timezone_count >= TIMEZONE_POOL_SIZE) {
+        pthread_mutex_unlock(&timezone_lock);
+        return NULL; // Invalid timezone or pool exhausted
     }
-    
-    timezone_t* tz = &full_timezones[timezone_count++];
-    
+
     // Copy timezone ID to static storage
-    static char timezone_ids[100][64]; // Static storage for IDs
-    strncpy(timezone_ids[timezone_count-1], timezone_id, 63);
-    timezone_ids[timezone_count-1][63] = '\0';
-    
-    tz->id = timezone_ids[timezone_count-1];
-    tz->system_tz_name = timezone_ids[timezone_count-1];
-    
+    timezone_t* tz = &full_timezones[timezone_count];
+    strncpy(timezone_ids[timezone_count], timezone_id, 63);
+    timezone_ids[timezone_count][63] = '\0';
+
+    tz->id = timezone_ids[timezone_count];
+    tz->system_tz_name = timezone_ids[timezone_count];
+    timezone_count++;
+
+    pthread_mutex_unlock(&timezone_lock);
     return tz;
     
 #elif defined(EMBEDDED_TIMEZONE)
@@ -157,27 +185,12 @@ int16_t timezone_get_offset(const timezone_t* tz, int64_t epoch_millis) {
 
 #ifdef FULL_TIMEZONE
     // Use system timezone functions
-    time_t epoch_seconds = epoch_millis / 1000;
-    
-    // Set timezone environment variable
-    char* old_tz = getenv("TZ");
-    setenv("TZ", tz->system_tz_name ? tz->system_tz_name : tz->id, 1);
-    tzset();
-    
-    // Get local time for this timezone
     struct tm local_tm;
-    localtime_r(&epoch_seconds, &local_tm);
-    int16_t offset_minutes = local_tm.tm_gmtoff / 60;
-    
-    // Restore original timezone
-    if (old_tz) {
-        setenv("TZ", old_tz, 1);
-    } else {
-        unsetenv("TZ");
-    }
-    tzset();
-    
-    return offset_minutes;
+    pthread_mutex_lock(&timezone_lock);
+    localtime_in(tz->system_tz_name ? tz->system_tz_name : tz->id, epoch_millis / 1000, &local_tm);
+    pthread_mutex_unlock(&timezone_lock);
+
+    return local_tm.tm_gmtoff / 60;
     
 #elif defined(EMBEDDED_TIMEZONE)
     // Check if DST is active
@@ -201,25 +214,12 @@ bool timezone_is_dst(const timezone_t* tz, int64_t epoch_millis) {
 
 #ifdef FULL_TIMEZONE
     // Use system timezone functions to determine DST
-    time_t epoch_seconds = epoch_millis / 1000;
-    
-    char* old_tz = getenv("TZ");
-    setenv("TZ", tz->system_tz_name ? tz->system_tz_name : tz->id, 1);
-    tzset();
-    
     struct tm local_tm;
-    localtime_r(&epoch_seconds, &local_tm);
-    bool is_dst = local_tm.tm_isdst > 0;
-    
-    // Restore original timezone
-    if (old_tz) {
-        setenv("TZ", old_tz, 1);
-    } else {
-        unsetenv("TZ");
-    }
-    tzset();
-    
-    return is_dst;
+    pthread_mutex_lock(&timezone_lock);
+    localtime_in(tz->system_tz_name ? tz->system_tz_name : tz->id, epoch_millis / 1000, &local_tm);
+    pthread_mutex_unlock(&timezone_lock);
+
+    return local_tm.tm_isdst > 0;
     
 #elif defined(EMBEDDED_TIMEZONE)
     // Use embedded DST calculation
@@ -374,7 +374,8 @@ static int get_day_of_year_for_dst_transition(int year, uint8_t month, uint8_t w
     tm_temp.tm_mday = 1;
     first_of_month = mktime(&tm_temp);
     
-    struct tm* first_tm = gmtime(&first_of_month);
+    struct tm first_storage;
+    struct tm* first_tm = gmtime_r(&first_of_month, &first_storage);
     int first_weekday = first_tm->tm_wday; // 0=Sunday, 1=Monday, etc.
     
     // Calculate the target day
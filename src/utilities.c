@@ -8,9 +8,10 @@
 #include "instant.h"
 #include "timezone.h"
 #include "vm.h"
+#include "classes/Value/value.h"
 
 // External reference to global VM pointer (defined in vm/lifecycle.c)
-extern vm_t* g_current_vm;
+extern SLATE_ISOLATE_LOCAL vm_t* g_current_vm;
 
 // Value utility functions
 int is_falsy(value_t value) {
@@ -238,8 +239,71 @@ ds_string display_value_to_string(vm_t* vm, value_t value) {
     }
 }
 
+// Numeric value of an int32/float operand for cross-type comparison
+static int primitive_number(value_t value, double* out) {
+    switch (value.type) {
+    case VAL_INT32:
+        *out = (double)value.as.int32;
+        return 1;
+    case VAL_FLOAT32:
+        *out = (double)value.as.float32;
+        return 1;
+    case VAL_FLOAT64:
+        *out = value.as.float64;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+// Same result as the builtin .equals() of null/boolean/int32/float/string/instant, without the
+// class chain lookup. Only applies when the receiver still has its builtin class; anything else
+// (bigint operands, objects, user classes) returns -1 so the caller dispatches .equals().
+int primitive_equals(value_t a, value_t b) {
+    switch (a.type) {
+    case VAL_NULL:
+        if (a.class != global_null_class) return -1;
+        return b.type == VAL_NULL;
+    case VAL_BOOLEAN:
+        if (a.class != global_boolean_class) return -1;
+        return b.type == VAL_BOOLEAN && a.as.boolean == b.as.boolean;
+    case VAL_INT32:
+        if (a.class != global_int_class) return -1;
+        if (b.type == VAL_INT32) return a.as.int32 == b.as.int32;
+        break;
+    case VAL_FLOAT32:
+    case VAL_FLOAT64:
+        if (a.class != global_float_class) return -1;
+        break;
+    case VAL_STRING: {
+        if (a.class != global_string_class) return -1;
+        if (b.type != VAL_STRING) return 0;
+        if (a.as.string == b.as.string) return 1;
+        if (a.as.string == NULL || b.as.string == NULL) return 0;
+        return ds_equals(a.as.string, b.as.string);
+    }
+    case VAL_INSTANT:
+        if (a.class != global_instant_class) return -1;
+        return b.type == VAL_INSTANT && a.as.instant_millis == b.as.instant_millis;
+    default:
+        return -1;
+    }
+
+    // Numeric receiver: same semantics as Number.equals (NaN never equal)
+    if (b.type == VAL_BIGINT) return -1;
+    double x, y;
+    if (!primitive_number(b, &y)) return 0;
+    primitive_number(a, &x);
+    return x == y;
+}
+
 // Helper function to call .equals() method on values using method dispatch
 int call_equals_method(vm_t* vm, value_t a, value_t b) {
+    int fast = primitive_equals(a, b);
+    if (fast >= 0) {
+        return fast;
+    }
+    
     // For classes (VAL_CLASS), check static properties first
     if (a.type == VAL_CLASS && a.as.class) {
         value_t* static_equals = lookup_static_property(a.as.class, "equals");
@@ -279,6 +343,43 @@ int call_equals_method(vm_t* vm, value_t a, value_t b) {
     return 0;
 }
 
+uint32_t call_hash_method(vm_t* vm, value_t value) {
+    // The nearest native .hash() up the class chain, like call_equals_method
+    value_t* current_class = value.class;
+    while (current_class && current_class->type == VAL_CLASS) {
+        value_t* hash_method = lookup_instance_property(current_class->as.class, "hash");
+        if (hash_method && hash_method->type == VAL_NATIVE) {
+            value_t args[1] = { value };
+            value_t result = ((native_t)hash_method->as.native)(vm, 1, args);
+            if (result.type == VAL_INT32) {
+                return (uint32_t)result.as.int32;
+            }
+            vm_release(result);
+            break;
+        }
+        current_class = current_class->class;
+    }
+
+    // No usable hash() method - Value.hash() covers every type
+    value_t result = builtin_value_hash(vm, 1, &value);
+    return (uint32_t)result.as.int32;
+}
+
+// Seeded hash shared by the match compiler and OP_MATCH_SWITCH string tables. The seed is mixed
+// into the string's plain FNV-1a hash, so at runtime the subject's cached ds_hash32 is reused.
+uint32_t match_hash_seed(uint32_t hash, uint32_t seed) {
+    hash ^= seed * 0x9e3779b9u;
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    return hash ^ (hash >> 16);
+}
+
+uint32_t match_string_hash(const char* str, size_t length, uint32_t seed) {
+    return match_hash_seed(ds_hash_bytes(str, length), seed);
+}
+
 void print_value(vm_t* vm, value_t value) {
     // Strings get special treatment - we want to show them with quotes in print_value
     // This is different from print_for_builtin which shows strings without quotes
@@ -304,7 +405,7 @@ float value_to_float32(value_t value) {
     case VAL_FLOAT64:
         return (float)value.as.float64;
     default:
-        runtime_error(g_current_vm, "Cannot convert %s to number", value_type_name(value.type));
+        runtime_error(g_current_vm, "Cannot convert %s to number", value_class_name(value));
         return 0.0f; // Never reached, but keeps compiler happy
     }
 }
@@ -320,7 +421,7 @@ double value_to_float64(value_t value) {
     case VAL_FLOAT64:
         return value.as.float64;
     default:
-        runtime_error(g_current_vm, "Cannot convert %s to number", value_type_name(value.type));
+        runtime_error(g_current_vm, "Cannot convert %s to number", value_class_name(value));
         return 0.0; // Never reached, but keeps compiler happy
     }
 }
@@ -366,7 +467,7 @@ int value_to_int(value_t value) {
             return 0; // Never reached
         }
     default:
-        runtime_error(g_current_vm, "Cannot convert %s to integer", value_type_name(value.type));
+        runtime_error(g_current_vm, "Cannot convert %s to integer", value_class_name(value));
         return 0; // Never reached, but keeps compiler happy
     }
 }
@@ -388,3 +489,15 @@ value_t* lookup_instance_property(class_t* cls, const char* prop_name) {
     }
     return (value_t*)do_get(cls->instance_properties, prop_name);
 }
+
+// Interned key for a string used as a property or global name. The string's cached hash saves
+// rehashing the name on every lookup; names with an embedded NUL key on the text before it,
+// like any C string, so they are hashed the long way.
+const char* property_key(ds_string name) {
+    const char* key = memchr(name, '\0', ds_length(name)) ? do_string_intern(name)
+                                                           : do_string_intern_hashed(name, ds_hash32(name));
+    if (!key) {
+        runtime_error(g_current_vm, "Out of memory interning '%s'", name);
+    }
+    return key;
+}
@@ -47,6 +47,14 @@ value_t vm_retain(value_t value) {
         value.as.duration->ref_count++;
     } else if (value.type == VAL_PERIOD) {
         value.as.period->ref_count++;
+    } else if (value.type == VAL_ADT) {
+        value.as.adt->ref_count++;
+    } else if (value.type == VAL_PROMISE && value.as.promise) {
+        value.as.promise->ref_count++;
+    } else if (value.type == VAL_TYPED_ARRAY && value.as.typed_array) {
+        value.as.typed_array->ref_count++;
+    } else if ((value.type == VAL_MAP || value.type == VAL_SET) && value.as.map) {
+        value.as.map->ref_count++;
     }
     return value;
 }
@@ -87,10 +95,7 @@ void vm_release(value_t value) {
             free(value.as.range);
         }
     } else if (value.type == VAL_ITERATOR && value.as.iterator) {
-        value.as.iterator->ref_count--;
-        if (value.as.iterator->ref_count <= 0) {
-            free_value(make_iterator(value.as.iterator));
-        }
+        iterator_release(value.as.iterator);
     } else if (value.type == VAL_BOUND_METHOD && value.as.bound_method) {
         bound_method_release(value.as.bound_method);
     } else if (value.type == VAL_LOCAL_DATE && value.as.local_date) {
@@ -109,6 +114,14 @@ void vm_release(value_t value) {
         duration_release(value.as.duration);
     } else if (value.type == VAL_PERIOD && value.as.period) {
         period_release(value.as.period);
+    } else if (value.type == VAL_ADT && value.as.adt) {
+        adt_instance_release(value.as.adt);
+    } else if (value.type == VAL_PROMISE && value.as.promise) {
+        promise_release(value.as.promise);
+    } else if (value.type == VAL_TYPED_ARRAY && value.as.typed_array) {
+        typed_array_release(value.as.typed_array);
+    } else if ((value.type == VAL_MAP || value.type == VAL_SET) && value.as.map) {
+        hash_map_release(value.as.map);
     }
 }
 
@@ -234,6 +247,7 @@ value_t make_class(const char* name, do_object instance_properties, do_object st
     cls->instance_properties = instance_properties ? do_retain(instance_properties) : do_create(NULL); // Retain or create empty
     cls->static_properties = static_properties ? do_retain(static_properties) : do_create(NULL); // Retain or create empty
     cls->factory = NULL; // Default: class cannot be instantiated by calling it
+    cls->adt = NULL; // Set by OP_CREATE_ADT_CONSTRUCTOR for ADT constructor classes
 
     value_t value;
     value.type = VAL_CLASS;
@@ -416,6 +430,51 @@ value_t make_period(period_t* period) {
     return value;
 }
 
+value_t make_adt(adt_instance_t* adt) {
+    value_t value;
+    value.type = VAL_ADT;
+    value.as.adt = adt;
+    value.class = &adt->constructor->class_value; // Instances dispatch through their constructor class
+    value.debug = NULL;
+    return value;
+}
+
+value_t make_promise(promise_t* promise) {
+    value_t value;
+    value.type = VAL_PROMISE;
+    value.as.promise = promise;
+    value.class = global_promise_class;
+    value.debug = NULL;
+    return value;
+}
+
+value_t make_typed_array(typed_array_t* array) {
+    value_t value;
+    value.type = VAL_TYPED_ARRAY;
+    value.as.typed_array = array;
+    value.class = array->kind == TYPED_INT32 ? global_int32_array_class : global_float64_array_class;
+    value.debug = NULL;
+    return value;
+}
+
+value_t make_map(hash_map_t* map) {
+    value_t value;
+    value.type = VAL_MAP;
+    value.as.map = map;
+    value.class = global_map_class;
+    value.debug = NULL;
+    return value;
+}
+
+value_t make_set(hash_map_t* set) {
+    value_t value;
+    value.type = VAL_SET;
+    value.as.map = set;
+    value.class = global_set_class;
+    value.debug = NULL;
+    return value;
+}
+
 // Value creation functions with debug info (copy debug location)
 static debug_location* copy_debug_location(debug_location* original) {
     if (!original) return NULL;
@@ -608,6 +667,12 @@ value_t make_period_with_debug(period_t* period, debug_location* debug) {
     return value;
 }
 
+value_t make_adt_with_debug(adt_instance_t* adt, debug_location* debug) {
+    value_t value = make_adt(adt);
+    value.debug = copy_debug_location(debug);
+    return value;
+}
+
 // Class utility functions
 class_t* class_retain(class_t* class) {
     if (class) {
@@ -625,7 +690,27 @@ void class_release(class_t* class) {
             do_release(&temp_instance_props);
             do_object temp_static_props = class->static_properties;
             do_release(&temp_static_props);
+            if (class->adt) {
+                for (uint16_t i = 0; i < class->adt->field_count; i++) {
+                    free(class->adt->field_names[i]);
+                }
+                free(class->adt->field_names);
+                free(class->adt);
+            }
             free(class);
         }
     }
-}
\ No newline at end of file
+}
+
+void adt_instance_release(adt_instance_t* adt) {
+    if (adt) {
+        adt->ref_count--;
+        if (adt->ref_count <= 0) {
+            for (uint16_t i = 0; i < adt->constructor->field_count; i++) {
+                vm_release(adt->fields[i]);
+            }
+            class_release(adt->constructor->class_value.as.class);
+            free(adt);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "aot.h"
+#include "module.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static value_t aot_constant_value(const aot_constant* constant) {
+    double number;
+    switch (constant->kind) {
+    case AOT_CONST_INT32:
+        return make_int32(constant->int32);
+    case AOT_CONST_FLOAT32:
+        memcpy(&number, &constant->bits, sizeof(number));
+        return make_float32((float)number);
+    case AOT_CONST_FLOAT64:
+        memcpy(&number, &constant->bits, sizeof(number));
+        return make_float64(number);
+    case AOT_CONST_BIGINT:
+        return make_bigint(di_from_string(constant->text, 10));
+    case AOT_CONST_STRING:
+        return make_string_ds(ds_create_length(constant->text, constant->length));
+    case AOT_CONST_NULL:
+    default:
+        return make_null();
+    }
+}
+
+// Rebuild a function_t from the static tables, as codegen would have left it
+static function_t* aot_load_function(const aot_function* entry) {
+    function_t* function = function_create(entry->name);
+    if (!function) return NULL;
+
+    function->bytecode = malloc(entry->bytecode_length);
+    memcpy(function->bytecode, entry->bytecode, entry->bytecode_length);
+    function->bytecode_length = entry->bytecode_length;
+
+    if (entry->constant_count > 0) {
+        function->constants = malloc(sizeof(value_t) * entry->constant_count);
+        for (size_t i = 0; i < entry->constant_count; i++) {
+            function->constants[i] = aot_constant_value(&entry->constants[i]);
+        }
+        function->constant_count = entry->constant_count;
+    }
+
+    if (entry->parameter_count > 0) {
+        function->parameter_names = malloc(sizeof(char*) * entry->parameter_count);
+        for (size_t i = 0; i < entry->parameter_count; i++) {
+            function->parameter_names[i] = strdup(entry->parameter_names[i]);
+        }
+        function->parameter_count = entry->parameter_count;
+    }
+    function->local_count = entry->local_count;
+
+    if (entry->upvalue_count > 0) {
+        function->upvalue_descriptors = malloc(sizeof(upvalue_desc_t) * entry->upvalue_count);
+        memcpy(function->upvalue_descriptors, entry->upvalue_descriptors,
+               sizeof(upvalue_desc_t) * entry->upvalue_count);
+        function->upvalue_count = entry->upvalue_count;
+    }
+
+    function->is_generator = entry->is_generator;
+    function->native = entry->native;
+    return function;
+}
+
+function_t* aot_load(vm_t* vm, const aot_program* program) {
+    // Closures refer to functions by table index, so the table must line up with compile time
+    if ((size_t)vm->functions->length != program->first_function) {
+        fprintf(stderr, "AOT program expects %zu runtime functions, found %zu - rebuild it with this runtime\n",
+                program->first_function, (size_t)vm->functions->length);
+        return NULL;
+    }
+    for (size_t i = 0; i < program->function_count; i++) {
+        vm_add_function(vm, aot_load_function(&program->functions[i]));
+    }
+    return aot_load_function(program->main);
+}
+
+int aot_main(const aot_program* program, int argc, char** argv) {
+    // Same setup as `slate file.sl args...`
+    vm_t* vm = vm_create_with_args(argc > 1 ? argc - 1 : 0, argc > 1 ? &argv[1] : NULL);
+    vm->context = CTX_SCRIPT;
+    module_system_init(vm);
+    module_add_search_path(vm, ".");
+    module_add_env_search_paths(vm);
+
+    function_t* main_function = aot_load(vm, program);
+    if (!main_function) {
+        vm_destroy(vm);
+        return 1;
+    }
+
+    // vm_execute's frame closure owns the main function and destroys it when done
+    vm_result result = vm_execute(vm, main_function);
+    if (result == VM_OK) {
+        if (vm->result.type != VAL_UNDEFINED) {
+            printf("Result: ");
+            print_value(vm, vm->result);
+            printf("\n");
+        }
+    } else {
+        printf("Execution error: %d\n", result);
+    }
+
+    vm_destroy(vm);
+    return result == VM_OK ? 0 : 1;
+}
+
+vm_result aot_run_callee(vm_t* vm, size_t caller_depth) {
+    function_t* function = vm->frames[vm->frame_count - 1].closure->function;
+    if (function->native) {
+        return function->native(vm, vm->frame_count);
+    }
+
+    // Interpret the callee; returning to call_floor hands us the result instead of pushing it
+    size_t saved_floor = vm->call_floor;
+    uint8_t* saved_bytecode = vm->bytecode;
+    vm->call_floor = caller_depth;
+    vm_result result = vm_run(vm);
+    vm->call_floor = saved_floor;
+    vm->bytecode = saved_bytecode;
+    if (result == VM_OK) {
+        vm_push(vm, vm->result);
+    }
+    return result;
+}
@@ -4,6 +4,7 @@
 #include "lexer.h"
 #include "parser.h"
 #include "codegen.h"
+#include "jit.h"
 #include <stdio.h>
 #include <assert.h>
 
@@ -115,6 +116,84 @@ vm_result vm_run(vm_t* vm) {
             break;
         }
 
+        case OP_ADD_INT: {
+            vm_result result = op_add_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_SUBTRACT_INT: {
+            vm_result result = op_subtract_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_MULTIPLY_INT: {
+            vm_result result = op_multiply_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_LESS_INT: {
+            vm_result result = op_less_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_LESS_EQUAL_INT: {
+            vm_result result = op_less_equal_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_GREATER_INT: {
+            vm_result result = op_greater_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_GREATER_EQUAL_INT: {
+            vm_result result = op_greater_equal_int(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_ADD_FLOAT: {
+            vm_result result = op_add_float(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_SUBTRACT_FLOAT: {
+            vm_result result = op_subtract_float(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_MULTIPLY_FLOAT: {
+            vm_result result = op_multiply_float(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_DIVIDE_FLOAT: {
+            vm_result result = op_divide_float(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_CONCAT_STRING: {
+            vm_result result = op_concat_string(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_CONCAT_N: {
+            vm_result result = op_concat_n(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
         case OP_NEGATE: {
             vm_result result = op_negate(vm);
             if (result != VM_OK) return result;
@@ -191,6 +270,16 @@ vm_result vm_run(vm_t* vm) {
         case OP_RETURN: {
             vm_result result = op_return(vm);
             if (result != VM_OK) return result;
+            // The frame entered by vm_call_function (or main) is done - hand control back
+            if (vm->frame_count == vm->call_floor) return VM_OK;
+            break;
+        }
+
+        case OP_YIELD: {
+            vm_result result = op_yield(vm);
+            if (result != VM_OK) return result;
+            // The generator frame is suspended - hand control back to generator_has_next
+            if (vm->frame_count == vm->call_floor) return VM_OK;
             break;
         }
 
@@ -224,6 +313,18 @@ vm_result vm_run(vm_t* vm) {
             break;
         }
 
+        case OP_APPEND_LOCAL: {
+            vm_result result = op_append_local(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_APPEND_GLOBAL: {
+            vm_result result = op_append_global(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
         case OP_GET_UPVALUE: {
             vm_result result = op_get_upvalue(vm);
             if (result != VM_OK) return result;
@@ -249,8 +350,15 @@ vm_result vm_run(vm_t* vm) {
         }
 
         case OP_CALL: {
+#ifdef SLATE_JIT
+            size_t caller_depth = vm->frame_count;
+#endif
             vm_result result = op_call(vm);
             if (result != VM_OK) return result;
+#ifdef SLATE_JIT
+            result = jit_enter_frame(vm, caller_depth);
+            if (result != VM_OK) return result;
+#endif
             break;
         }
 
@@ -260,12 +368,37 @@ vm_result vm_run(vm_t* vm) {
             break;
         }
 
+        case OP_CLOSURE_LOCAL: {
+            vm_result result = op_closure_local(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
+        case OP_RELEASE_LOCAL_CLOSURES: {
+            vm_result result = op_release_local_closures(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
         case OP_BUILD_ARRAY: {
             vm_result result = op_build_array(vm);
             if (result != VM_OK) return result;
             break;
         }
 
+        case OP_GET_INDEX: {
+#ifdef SLATE_JIT
+            size_t caller_depth = vm->frame_count;
+#endif
+            vm_result result = op_get_index(vm);
+            if (result != VM_OK) return result;
+#ifdef SLATE_JIT
+            result = jit_enter_frame(vm, caller_depth);
+            if (result != VM_OK) return result;
+#endif
+            break;
+        }
+
         case OP_SET_INDEX: {
             vm_result result = op_set_index(vm);
             if (result != VM_OK) return result;
@@ -290,9 +423,23 @@ vm_result vm_run(vm_t* vm) {
             break;
         }
 
+        case OP_MATCH_SWITCH: {
+            vm_result result = op_match_switch(vm);
+            if (result != VM_OK) return result;
+            break;
+        }
+
         case OP_JUMP: {
             vm_result result = op_jump(vm);
             if (result != VM_OK) return result;
+#ifdef SLATE_JIT
+            // while loops close with a backward jump rather than OP_LOOP
+            if (vm->ip < vm->current_instruction) {
+                result = jit_enter_loop(vm);
+                if (result != VM_OK) return result;
+                if (vm->frame_count == vm->call_floor) return VM_OK;
+            }
+#endif
             break;
         }
 
@@ -311,6 +458,12 @@ vm_result vm_run(vm_t* vm) {
         case OP_LOOP: {
             vm_result result = op_loop(vm);
             if (result != VM_OK) return result;
+#ifdef SLATE_JIT
+            // Back-edges count towards hotness; a hot loop carries on in native code
+            result = jit_enter_loop(vm);
+            if (result != VM_OK) return result;
+            if (vm->frame_count == vm->call_floor) return VM_OK;
+#endif
             break;
         }
 
@@ -393,8 +546,15 @@ vm_result vm_run(vm_t* vm) {
         }
 
         case OP_CALL_METHOD: {
+#ifdef SLATE_JIT
+            size_t caller_depth = vm->frame_count;
+#endif
             vm_result result = op_call_method(vm);
             if (result != VM_OK) return result;
+#ifdef SLATE_JIT
+            result = jit_enter_frame(vm, caller_depth);
+            if (result != VM_OK) return result;
+#endif
             break;
         }
 
@@ -449,6 +609,14 @@ vm_result vm_execute(vm_t* vm, function_t* function) {
     // Clear the stack at the start of each execution (important for REPL)
     vm->stack_top = vm->stack;
 
+    // A previous run that aborted mid-call may have left pooled closures checked out
+    // (and a nested call floor or a generator marked as running behind)
+    if (vm->frame_count == 0) {
+        local_closures_release(vm, vm->local_closure_count);
+        vm->call_floor = 0;
+        vm->generator = NULL;
+    }
+
     // Set up initial call frame
     if (vm->frame_count >= vm->frame_capacity) {
         return VM_STACK_OVERFLOW;
@@ -463,8 +631,8 @@ vm_result vm_execute(vm_t* vm, function_t* function) {
     vm->bytecode = function->bytecode;
     vm->ip = function->bytecode;
 
-    // Run the VM using the new core execution function
-    vm_result result = vm_run(vm);
+    // Run the VM using the new core execution function (or the AOT-compiled body)
+    vm_result result = function->native ? function->native(vm, vm->frame_count) : vm_run(vm);
     
     // Always clean up closure and reset VM state for REPL
     if (result == VM_OK) {
@@ -4,6 +4,7 @@
 #include "codegen.h"
 #include "runtime_error.h"
 #include "vm.h"
+#include "../classes/TypedArray/typed_array.h"
 
 // Debug location management
 debug_location* debug_location_create(int line, int column, const char* source_text) {
@@ -88,8 +89,8 @@ void vm_runtime_error_with_values(vm_t* vm, const char* format, const value_t* a
                                   debug_location* location) {
     // Format the error message with value types
     char formatted_message[256];
-    snprintf(formatted_message, sizeof(formatted_message), format, value_type_name(a->type),
-             b ? value_type_name(b->type) : "");
+    snprintf(formatted_message, sizeof(formatted_message), format, value_class_name(*a),
+             b ? value_class_name(*b) : "");
 
     // Use the best debug location available (preference order: location param, a->debug, b->debug, current_debug)
     debug_location* debug_to_use = location;
@@ -169,7 +170,25 @@ const char* value_type_name(value_type type) {
         return "Duration";
     case VAL_PERIOD:
         return "Period";
+    case VAL_ADT:
+        return "object"; // Matches type()
+    case VAL_PROMISE:
+        return "Promise";
+    case VAL_TYPED_ARRAY:
+        return "TypedArray";
+    case VAL_MAP:
+        return "Map";
+    case VAL_SET:
+        return "Set";
     default:
         return "unknown";
     }
 }
+
+// Type name of a value as type() reports it, so typed arrays go by their class
+const char* value_class_name(value_t value) {
+    if (value.type == VAL_TYPED_ARRAY) {
+        return typed_array_class_name(value.as.typed_array->kind);
+    }
+    return value_type_name(value.type);
+}
@@ -0,0 +1,926 @@
+#define _GNU_SOURCE // pipe2
+#include "event_loop.h"
+#include "dynamic_array.h"
+#include "dynamic_object.h"
+#include <stdlib.h>
+#include <string.h>
+
+// A promise owns its waiter list; the tasks and Promise.all states those point at are owned by
+// the loop, so freeing a promise never has to reach back into it
+typedef enum {
+    WAITER_TASK, // Resume a task parked on the promise
+    WAITER_ALL   // Fill one slot of a Promise.all
+} waiter_kind;
+
+typedef struct all_state {
+    size_t refs;       // Waiters still registered on element promises
+    promise_t* promise;
+    value_t* values;   // Fulfilled values by element index
+    size_t count;
+    size_t remaining;  // Elements not fulfilled yet
+} all_state_t;
+
+struct promise_waiter {
+    waiter_kind kind;
+    struct task* task;
+    all_state_t* all;
+    size_t index;
+    struct promise_waiter* next;
+};
+
+static void all_state_unref(all_state_t* all) {
+    if (--all->refs > 0) {
+        return;
+    }
+    for (size_t i = 0; i < all->count; i++) {
+        vm_release(all->values[i]);
+    }
+    free(all->values);
+    promise_release(all->promise);
+    free(all);
+}
+
+promise_t* promise_create(void) {
+    promise_t* promise = malloc(sizeof(promise_t));
+    if (!promise) {
+        return NULL;
+    }
+    promise->ref_count = 1;
+    promise->state = PROMISE_PENDING;
+    promise->value = make_null();
+    promise->waiters = NULL;
+    return promise;
+}
+
+void promise_release(promise_t* promise) {
+    if (!promise || --promise->ref_count > 0) {
+        return;
+    }
+    // Only possible once the loop is gone: while it runs, whatever will settle a promise holds it
+    struct promise_waiter* waiter = promise->waiters;
+    while (waiter) {
+        struct promise_waiter* next = waiter->next;
+        if (waiter->kind == WAITER_ALL) {
+            all_state_unref(waiter->all);
+        }
+        free(waiter);
+        waiter = next;
+    }
+    vm_release(promise->value);
+    free(promise);
+}
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <spawn.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+extern char** environ;
+
+typedef struct task {
+    value_t generator;     // Generator iterator being driven
+    promise_t* promise;    // Settles with the generator's return value
+    promise_t* awaiting;   // Yielded promise: parked on it, or its value is the next thing sent
+    value_t sent;          // Next value sent when not awaiting a promise
+    struct task* next_ready;
+    struct task* prev;     // All live tasks, for destroy
+    struct task* next;
+} task_t;
+
+typedef struct timer {
+    int64_t deadline; // CLOCK_MONOTONIC milliseconds
+    uint64_t sequence; // Equal deadlines fire in the order they were set
+    promise_t* promise;
+} timer_t_;
+
+typedef struct io_job {
+    int is_write;
+    char* path;
+    db_buffer buffer; // Data to write, or the data read
+    bool ok;
+    promise_t* promise;
+    struct io_job* next;
+} io_job_t;
+
+// How often children that closed stdout are checked for exit when no pidfd can watch them
+#define PROCESS_POLL_MS 10
+
+typedef struct process {
+    pid_t pid;
+    int fd;            // Read end of the child's stdout, then its pidfd once that closes (-1 when polled)
+    bool output_done;  // Stdout closed; only waiting for the child to exit
+    ds_builder output;
+    promise_t* promise;
+    struct process* prev;
+    struct process* next;
+} process_t;
+
+struct event_loop {
+    int epoll_fd;
+    int wake_fd; // eventfd the I/O threads signal completions on (epoll data.ptr NULL)
+
+    task_t* ready_head; // Tasks to resume, in order
+    task_t* ready_tail;
+    size_t ready_count;
+    task_t* tasks;
+
+    timer_t_* timers; // Min-heap on (deadline, sequence)
+    size_t timer_count;
+    size_t timer_capacity;
+    uint64_t timer_sequence;
+
+    process_t* processes;
+    size_t polled_processes; // Output done with no pidfd to watch: checked every PROCESS_POLL_MS
+
+    // File I/O threads. Only the job queues are shared, under io_lock.
+    pthread_t io_threads[EVENT_LOOP_IO_THREADS];
+    size_t io_thread_count;
+    pthread_mutex_t io_lock;
+    pthread_cond_t io_wake;
+    io_job_t* io_pending_head;
+    io_job_t* io_pending_tail;
+    io_job_t* io_completed;
+    bool io_shutdown;
+    size_t io_in_flight; // Submitted and not yet settled (VM thread only)
+};
+
+static int64_t monotonic_millis(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+event_loop_t* event_loop_get(vm_t* vm) {
+    if (vm->event_loop) {
+        return vm->event_loop;
+    }
+    event_loop_t* loop = calloc(1, sizeof(event_loop_t));
+    if (!loop) {
+        return NULL;
+    }
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    loop->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = NULL};
+    if (loop->epoll_fd < 0 || loop->wake_fd < 0 || epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &event) != 0) {
+        if (loop->epoll_fd >= 0) {
+            close(loop->epoll_fd);
+        }
+        if (loop->wake_fd >= 0) {
+            close(loop->wake_fd);
+        }
+        free(loop);
+        return NULL;
+    }
+    pthread_mutex_init(&loop->io_lock, NULL);
+    pthread_cond_init(&loop->io_wake, NULL);
+    vm->event_loop = loop;
+    return loop;
+}
+
+// Tasks
+
+static void task_schedule(event_loop_t* loop, task_t* task) {
+    task->next_ready = NULL;
+    if (loop->ready_tail) {
+        loop->ready_tail->next_ready = task;
+    } else {
+        loop->ready_head = task;
+    }
+    loop->ready_tail = task;
+    loop->ready_count++;
+}
+
+static task_t* task_dequeue(event_loop_t* loop) {
+    task_t* task = loop->ready_head;
+    loop->ready_head = task->next_ready;
+    if (!loop->ready_head) {
+        loop->ready_tail = NULL;
+    }
+    loop->ready_count--;
+    return task;
+}
+
+static void task_free(task_t* task) {
+    vm_release(task->generator);
+    vm_release(task->sent);
+    promise_release(task->awaiting);
+    promise_release(task->promise);
+    free(task);
+}
+
+static void task_finish(event_loop_t* loop, task_t* task) {
+    if (task->prev) {
+        task->prev->next = task->next;
+    } else {
+        loop->tasks = task->next;
+    }
+    if (task->next) {
+        task->next->prev = task->prev;
+    }
+    task_free(task);
+}
+
+static bool promise_add_waiter(promise_t* promise, waiter_kind kind, task_t* task, all_state_t* all, size_t index) {
+    struct promise_waiter* waiter = malloc(sizeof(struct promise_waiter));
+    if (!waiter) {
+        return false;
+    }
+    waiter->kind = kind;
+    waiter->task = task;
+    waiter->all = all;
+    waiter->index = index;
+    // Appended, so waiters resume in the order they started waiting
+    waiter->next = NULL;
+    struct promise_waiter** tail = &promise->waiters;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = waiter;
+    return true;
+}
+
+// Park the task on what it yielded (consumed): a promise until it settles, a generator as a child
+// task, anything else is just sent straight back on the next turn
+static void task_await(event_loop_t* loop, task_t* task, value_t yielded) {
+    if (yielded.type == VAL_ITERATOR && yielded.as.iterator->type == ITER_GENERATOR) {
+        promise_t* child = event_loop_spawn(loop, yielded);
+        vm_release(yielded);
+        yielded = child ? make_promise(child) : make_null();
+    }
+    if (yielded.type != VAL_PROMISE) {
+        task->sent = yielded;
+        task_schedule(loop, task);
+        return;
+    }
+    task->awaiting = yielded.as.promise;
+    if (task->awaiting->state != PROMISE_PENDING ||
+        !promise_add_waiter(task->awaiting, WAITER_TASK, task, NULL, 0)) {
+        task_schedule(loop, task);
+    }
+}
+
+static void task_step(event_loop_t* loop, task_t* task) {
+    value_t sent = task->sent;
+    task->sent = make_null();
+    promise_t* awaited = task->awaiting;
+    if (awaited) {
+        task->awaiting = NULL;
+        if (awaited->state == PROMISE_REJECTED) {
+            // A generator has no way to observe the error, so the task fails with it
+            promise_reject(loop, task->promise, vm_retain(awaited->value));
+            promise_release(awaited);
+            task_finish(loop, task);
+            return;
+        }
+        sent = vm_retain(awaited->value);
+        promise_release(awaited);
+    }
+
+    generator_t* gen = task->generator.as.iterator->data.generator;
+    if (generator_send(gen, sent)) {
+        value_t yielded = gen->pending;
+        gen->pending = make_null();
+        gen->has_pending = 0;
+        task_await(loop, task, yielded);
+    } else {
+        promise_fulfill(loop, task->promise, vm_retain(gen->result));
+        task_finish(loop, task);
+    }
+}
+
+promise_t* event_loop_spawn(event_loop_t* loop, value_t generator) {
+    task_t* task = malloc(sizeof(task_t));
+    promise_t* promise = promise_create();
+    if (!task || !promise) {
+        free(task);
+        free(promise);
+        return NULL;
+    }
+    task->generator = vm_retain(generator);
+    task->promise = promise;
+    task->awaiting = NULL;
+    task->sent = make_null();
+    task->prev = NULL;
+    task->next = loop->tasks;
+    if (loop->tasks) {
+        loop->tasks->prev = task;
+    }
+    loop->tasks = task;
+    task_schedule(loop, task);
+    promise->ref_count++; // One for the task, one for the caller
+    return promise;
+}
+
+// Settling
+
+static void all_fill(event_loop_t* loop, all_state_t* all, size_t index, value_t value) {
+    all->values[index] = value;
+    if (--all->remaining > 0) {
+        return;
+    }
+    da_array results = da_new(sizeof(value_t));
+    for (size_t i = 0; i < all->count; i++) {
+        da_push(results, &all->values[i]);
+        all->values[i] = make_null();
+    }
+    promise_fulfill(loop, all->promise, make_array(results));
+}
+
+static void all_settle_element(event_loop_t* loop, all_state_t* all, size_t index, promise_t* element) {
+    if (all->promise->state == PROMISE_PENDING) {
+        if (element->state == PROMISE_REJECTED) {
+            promise_reject(loop, all->promise, vm_retain(element->value));
+        } else {
+            all_fill(loop, all, index, vm_retain(element->value));
+        }
+    }
+}
+
+static void promise_settle(event_loop_t* loop, promise_t* promise, promise_state state, value_t value) {
+    if (!promise || promise->state != PROMISE_PENDING) {
+        vm_release(value);
+        return;
+    }
+    promise->state = state;
+    promise->value = value;
+
+    struct promise_waiter* waiter = promise->waiters;
+    promise->waiters = NULL;
+    while (waiter) {
+        struct promise_waiter* next = waiter->next;
+        if (waiter->kind == WAITER_TASK) {
+            task_schedule(loop, waiter->task);
+        } else {
+            all_settle_element(loop, waiter->all, waiter->index, promise);
+            all_state_unref(waiter->all);
+        }
+        free(waiter);
+        waiter = next;
+    }
+}
+
+void promise_fulfill(event_loop_t* loop, promise_t* promise, value_t value) {
+    promise_settle(loop, promise, PROMISE_FULFILLED, value);
+}
+
+void promise_reject(event_loop_t* loop, promise_t* promise, value_t message) {
+    promise_settle(loop, promise, PROMISE_REJECTED, message);
+}
+
+static value_t error_message(const char* message, const char* detail) {
+    ds_builder text = ds_builder_create();
+    ds_builder_append(text, message);
+    ds_builder_append(text, detail);
+    value_t result = make_string_ds(ds_builder_to_string(text));
+    ds_builder_release(&text);
+    return result;
+}
+
+static promise_t* rejected_promise(const char* message, const char* detail) {
+    promise_t* promise = promise_create();
+    if (promise) {
+        promise->state = PROMISE_REJECTED;
+        promise->value = error_message(message, detail);
+    }
+    return promise;
+}
+
+promise_t* event_loop_all(event_loop_t* loop, value_t* values, size_t count) {
+    all_state_t* all = malloc(sizeof(all_state_t));
+    promise_t* promise = promise_create();
+    value_t* slots = malloc(sizeof(value_t) * (count > 0 ? count : 1));
+    if (!all || !promise || !slots) {
+        free(all);
+        free(promise);
+        free(slots);
+        return NULL;
+    }
+    all->refs = 1; // Ours, until every element has been looked at
+    all->promise = promise;
+    all->values = slots;
+    all->count = count;
+    all->remaining = count;
+    promise->ref_count++;
+
+    for (size_t i = 0; i < count; i++) {
+        all->values[i] = make_null();
+    }
+    if (count == 0) {
+        promise_fulfill(loop, promise, make_array(da_new(sizeof(value_t))));
+    }
+    for (size_t i = 0; i < count && promise->state == PROMISE_PENDING; i++) {
+        value_t element = values[i];
+        if (element.type != VAL_PROMISE) {
+            all_fill(loop, all, i, vm_retain(element));
+        } else if (element.as.promise->state != PROMISE_PENDING) {
+            all_settle_element(loop, all, i, element.as.promise);
+        } else if (promise_add_waiter(element.as.promise, WAITER_ALL, NULL, all, i)) {
+            all->refs++;
+        } else {
+            promise_reject(loop, promise, make_string("Out of memory"));
+        }
+    }
+    all_state_unref(all);
+    return promise;
+}
+
+// Timers
+
+static bool timer_before(const timer_t_* a, const timer_t_* b) {
+    return a->deadline < b->deadline || (a->deadline == b->deadline && a->sequence < b->sequence);
+}
+
+promise_t* event_loop_sleep(event_loop_t* loop, int64_t millis) {
+    if (loop->timer_count == loop->timer_capacity) {
+        size_t capacity = loop->timer_capacity ? loop->timer_capacity * 2 : 16;
+        timer_t_* timers = realloc(loop->timers, sizeof(timer_t_) * capacity);
+        if (!timers) {
+            return NULL;
+        }
+        loop->timers = timers;
+        loop->timer_capacity = capacity;
+    }
+    promise_t* promise = promise_create();
+    if (!promise) {
+        return NULL;
+    }
+    promise->ref_count++;
+
+    timer_t_ timer = {monotonic_millis() + (millis > 0 ? millis : 0), loop->timer_sequence++, promise};
+    size_t i = loop->timer_count++;
+    while (i > 0 && timer_before(&timer, &loop->timers[(i - 1) / 2])) {
+        loop->timers[i] = loop->timers[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    loop->timers[i] = timer;
+    return promise;
+}
+
+static void timers_fire(event_loop_t* loop) {
+    int64_t now = monotonic_millis();
+    while (loop->timer_count > 0 && loop->timers[0].deadline <= now) {
+        promise_t* promise = loop->timers[0].promise;
+        timer_t_ last = loop->timers[--loop->timer_count];
+        size_t i = 0;
+        for (;;) {
+            size_t child = i * 2 + 1;
+            if (child >= loop->timer_count) {
+                break;
+            }
+            if (child + 1 < loop->timer_count && timer_before(&loop->timers[child + 1], &loop->timers[child])) {
+                child++;
+            }
+            if (!timer_before(&loop->timers[child], &last)) {
+                break;
+            }
+            loop->timers[i] = loop->timers[child];
+            i = child;
+        }
+        if (loop->timer_count > 0) {
+            loop->timers[i] = last;
+        }
+        promise_fulfill(loop, promise, make_null());
+        promise_release(promise);
+    }
+}
+
+// File I/O threads
+
+static void* io_worker(void* arg) {
+    event_loop_t* loop = arg;
+    pthread_mutex_lock(&loop->io_lock);
+    for (;;) {
+        while (!loop->io_pending_head && !loop->io_shutdown) {
+            pthread_cond_wait(&loop->io_wake, &loop->io_lock);
+        }
+        if (loop->io_shutdown) {
+            break;
+        }
+        io_job_t* job = loop->io_pending_head;
+        loop->io_pending_head = job->next;
+        if (!loop->io_pending_head) {
+            loop->io_pending_tail = NULL;
+        }
+        pthread_mutex_unlock(&loop->io_lock);
+
+        if (job->is_write) {
+            job->ok = db_write_file(job->buffer, job->path);
+        } else {
+            job->buffer = db_read_file(job->path);
+            job->ok = job->buffer != NULL;
+        }
+
+        pthread_mutex_lock(&loop->io_lock);
+        job->next = loop->io_completed;
+        loop->io_completed = job;
+        uint64_t one = 1;
+        ssize_t written = write(loop->wake_fd, &one, sizeof(one));
+        (void)written; // Only fails when the counter is already nonzero, which wakes the loop anyway
+    }
+    pthread_mutex_unlock(&loop->io_lock);
+    return NULL;
+}
+
+static void io_job_free(io_job_t* job) {
+    if (job->buffer) {
+        db_release(&job->buffer);
+    }
+    promise_release(job->promise);
+    free(job->path);
+    free(job);
+}
+
+static promise_t* io_submit(event_loop_t* loop, int is_write, db_buffer buffer, const char* path) {
+    io_job_t* job = malloc(sizeof(io_job_t));
+    promise_t* promise = promise_create();
+    char* path_copy = strdup(path);
+    if (!job || !promise || !path_copy) {
+        free(job);
+        free(promise);
+        free(path_copy);
+        return NULL;
+    }
+    promise->ref_count++;
+    job->is_write = is_write;
+    job->path = path_copy;
+    job->buffer = buffer ? db_retain(buffer) : NULL;
+    job->ok = false;
+    job->promise = promise;
+    job->next = NULL;
+
+    pthread_mutex_lock(&loop->io_lock);
+    // Threads start with the first operation that needs them
+    while (loop->io_thread_count < EVENT_LOOP_IO_THREADS &&
+           pthread_create(&loop->io_threads[loop->io_thread_count], NULL, io_worker, loop) == 0) {
+        loop->io_thread_count++;
+    }
+    if (loop->io_thread_count == 0) {
+        pthread_mutex_unlock(&loop->io_lock);
+        io_job_free(job);
+        promise_release(promise);
+        return rejected_promise("Failed to start I/O threads for ", path);
+    }
+    if (loop->io_pending_tail) {
+        loop->io_pending_tail->next = job;
+    } else {
+        loop->io_pending_head = job;
+    }
+    loop->io_pending_tail = job;
+    pthread_cond_signal(&loop->io_wake);
+    pthread_mutex_unlock(&loop->io_lock);
+    loop->io_in_flight++;
+    return promise;
+}
+
+promise_t* event_loop_read_file(event_loop_t* loop, const char* path) {
+    return io_submit(loop, 0, NULL, path);
+}
+
+promise_t* event_loop_write_file(event_loop_t* loop, db_buffer buffer, const char* path) {
+    return io_submit(loop, 1, buffer, path);
+}
+
+static void io_drain(event_loop_t* loop) {
+    uint64_t count;
+    ssize_t got = read(loop->wake_fd, &count, sizeof(count));
+    (void)got;
+
+    pthread_mutex_lock(&loop->io_lock);
+    io_job_t* completed = loop->io_completed;
+    loop->io_completed = NULL;
+    pthread_mutex_unlock(&loop->io_lock);
+
+    // Completions were pushed newest first
+    io_job_t* ordered = NULL;
+    while (completed) {
+        io_job_t* next = completed->next;
+        completed->next = ordered;
+        ordered = completed;
+        completed = next;
+    }
+    while (ordered) {
+        io_job_t* job = ordered;
+        ordered = job->next;
+        loop->io_in_flight--;
+        if (job->is_write) {
+            promise_fulfill(loop, job->promise, make_boolean(job->ok));
+        } else if (job->ok) {
+            promise_fulfill(loop, job->promise, make_buffer(job->buffer));
+            job->buffer = NULL;
+        } else {
+            promise_reject(loop, job->promise, error_message("Failed to read file: ", job->path));
+        }
+        io_job_free(job);
+    }
+}
+
+// Child processes
+
+promise_t* event_loop_exec(event_loop_t* loop, const char* command) {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        return rejected_promise("Failed to start process: ", command);
+    }
+
+    // stdout into the pipe, stdin from /dev/null so children never compete for the terminal
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    char* argv[] = {"sh", "-c", (char*)command, NULL};
+    pid_t pid;
+    int spawned = posix_spawn(&pid, "/bin/sh", &actions, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+
+    process_t* process = spawned == 0 ? malloc(sizeof(process_t)) : NULL;
+    promise_t* promise = process ? promise_create() : NULL;
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = process};
+    if (!promise || fcntl(fds[0], F_SETFL, O_NONBLOCK) != 0 ||
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fds[0], &event) != 0) {
+        close(fds[0]);
+        if (spawned == 0) {
+            waitpid(pid, NULL, 0);
+        }
+        free(process);
+        free(promise);
+        return rejected_promise("Failed to start process: ", command);
+    }
+
+    promise->ref_count++;
+    process->pid = pid;
+    process->fd = fds[0];
+    process->output_done = false;
+    process->output = ds_builder_create();
+    process->promise = promise;
+    process->prev = NULL;
+    process->next = loop->processes;
+    if (loop->processes) {
+        loop->processes->prev = process;
+    }
+    loop->processes = process;
+    return promise;
+}
+
+static void process_close(event_loop_t* loop, process_t* process) {
+    if (process->fd >= 0) {
+        epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, process->fd, NULL);
+        close(process->fd);
+    } else {
+        loop->polled_processes--;
+    }
+    if (process->prev) {
+        process->prev->next = process->next;
+    } else {
+        loop->processes = process->next;
+    }
+    if (process->next) {
+        process->next->prev = process->prev;
+    }
+    ds_builder_release(&process->output);
+    promise_release(process->promise);
+    free(process);
+}
+
+// Settles the child's promise and closes it once it has exited; false while it is still running
+static bool process_finish(event_loop_t* loop, process_t* process) {
+    int status = 0;
+    pid_t reaped;
+    while ((reaped = waitpid(process->pid, &status, WNOHANG)) < 0 && errno == EINTR) {
+    }
+    if (reaped == 0) {
+        return false;
+    }
+    int code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + (WIFSIGNALED(status) ? WTERMSIG(status) : 0);
+
+    do_object result = do_create(NULL);
+    value_t status_value = make_int32(code);
+    do_set(result, "status", &status_value, sizeof(value_t));
+    value_t output_value = make_string_ds(ds_builder_to_string(process->output));
+    do_set(result, "output", &output_value, sizeof(value_t));
+    promise_fulfill(loop, process->promise, make_object(result));
+    process_close(loop, process);
+    return true;
+}
+
+static void process_readable(event_loop_t* loop, process_t* process) {
+    char chunk[4096];
+    for (;;) {
+        ssize_t n = read(process->fd, chunk, sizeof(chunk));
+        if (n > 0) {
+            ds_builder_append_length(process->output, chunk, (size_t)n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        break; // End of output (or a broken pipe): the child has finished or closed stdout
+    }
+
+    if (process_finish(loop, process)) {
+        return;
+    }
+
+    // The child closed stdout but is still running: wait for its exit on a pidfd, or poll for it
+    // where the kernel has none, rather than blocking the loop in waitpid
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, process->fd, NULL);
+    close(process->fd);
+    process->output_done = true;
+    process->fd = -1;
+#ifdef SYS_pidfd_open
+    process->fd = (int)syscall(SYS_pidfd_open, process->pid, 0);
+#endif
+    struct epoll_event event = {.events = EPOLLIN, .data.ptr = process};
+    if (process->fd >= 0 && epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, process->fd, &event) != 0) {
+        close(process->fd);
+        process->fd = -1;
+    }
+    if (process->fd < 0) {
+        loop->polled_processes++;
+    }
+}
+
+static void processes_poll(event_loop_t* loop) {
+    process_t* process = loop->processes;
+    while (process) {
+        process_t* next = process->next;
+        if (process->output_done && process->fd < 0) {
+            process_finish(loop, process);
+        }
+        process = next;
+    }
+}
+
+// Running
+
+static void event_loop_poll(event_loop_t* loop, int timeout) {
+    struct epoll_event events[32];
+    int count = epoll_wait(loop->epoll_fd, events, 32, timeout);
+    for (int i = 0; i < count; i++) {
+        process_t* process = events[i].data.ptr;
+        if (process && process->output_done) {
+            process_finish(loop, process); // The pidfd is readable once the child has exited
+        } else if (process) {
+            process_readable(loop, process);
+        } else {
+            io_drain(loop);
+        }
+    }
+}
+
+bool event_loop_run_until(event_loop_t* loop, promise_t* promise) {
+    while (promise->state == PROMISE_PENDING) {
+        // Resume the tasks ready now; tasks they wake wait for the next round, after I/O is polled
+        for (size_t batch = loop->ready_count; batch > 0 && promise->state == PROMISE_PENDING; batch--) {
+            task_step(loop, task_dequeue(loop));
+        }
+        if (promise->state != PROMISE_PENDING) {
+            break;
+        }
+
+        int timeout;
+        if (loop->ready_head) {
+            timeout = 0;
+        } else if (loop->timer_count > 0) {
+            int64_t wait = loop->timers[0].deadline - monotonic_millis();
+            timeout = wait < 0 ? 0 : (wait > 60000 ? 60000 : (int)wait);
+        } else if (loop->io_in_flight > 0 || loop->processes) {
+            timeout = -1;
+        } else {
+            return false; // Nothing left that could ever settle it
+        }
+        if (loop->polled_processes > 0 && (timeout < 0 || timeout > PROCESS_POLL_MS)) {
+            timeout = PROCESS_POLL_MS;
+        }
+        event_loop_poll(loop, timeout);
+        if (loop->polled_processes > 0) {
+            processes_poll(loop);
+        }
+        timers_fire(loop);
+    }
+    return true;
+}
+
+void event_loop_destroy(event_loop_t* loop) {
+    if (!loop) {
+        return;
+    }
+
+    pthread_mutex_lock(&loop->io_lock);
+    loop->io_shutdown = true;
+    pthread_cond_broadcast(&loop->io_wake);
+    pthread_mutex_unlock(&loop->io_lock);
+    for (size_t i = 0; i < loop->io_thread_count; i++) {
+        pthread_join(loop->io_threads[i], NULL);
+    }
+    io_job_t* lists[] = {loop->io_pending_head, loop->io_completed};
+    for (size_t i = 0; i < 2; i++) {
+        while (lists[i]) {
+            io_job_t* next = lists[i]->next;
+            io_job_free(lists[i]);
+            lists[i] = next;
+        }
+    }
+    pthread_mutex_destroy(&loop->io_lock);
+    pthread_cond_destroy(&loop->io_wake);
+
+    // Unfinished children are left to exit on their own once their stdout is closed
+    while (loop->processes) {
+        pid_t pid = loop->processes->pid;
+        process_close(loop, loop->processes);
+        waitpid(pid, NULL, WNOHANG);
+    }
+    for (size_t i = 0; i < loop->timer_count; i++) {
+        promise_release(loop->timers[i].promise);
+    }
+    free(loop->timers);
+    while (loop->tasks) {
+        task_t* next = loop->tasks->next;
+        task_free(loop->tasks);
+        loop->tasks = next;
+    }
+
+    close(loop->wake_fd);
+    close(loop->epoll_fd);
+    free(loop);
+}
+
+#else // No event loop on this platform: the async builtins report that instead
+
+event_loop_t* event_loop_get(vm_t* vm) {
+    (void)vm;
+    return NULL;
+}
+
+void event_loop_destroy(event_loop_t* loop) {
+    (void)loop;
+}
+
+void promise_fulfill(event_loop_t* loop, promise_t* promise, value_t value) {
+    (void)loop;
+    (void)promise;
+    vm_release(value);
+}
+
+void promise_reject(event_loop_t* loop, promise_t* promise, value_t message) {
+    (void)loop;
+    (void)promise;
+    vm_release(message);
+}
+
+promise_t* event_loop_spawn(event_loop_t* loop, value_t generator) {
+    (void)loop;
+    (void)generator;
+    return NULL;
+}
+
+promise_t* event_loop_all(event_loop_t* loop, value_t* values, size_t count) {
+    (void)loop;
+    (void)values;
+    (void)count;
+    return NULL;
+}
+
+promise_t* event_loop_sleep(event_loop_t* loop, int64_t millis) {
+    (void)loop;
+    (void)millis;
+    return NULL;
+}
+
+promise_t* event_loop_read_file(event_loop_t* loop, const char* path) {
+    (void)loop;
+    (void)path;
+    return NULL;
+}
+
+promise_t* event_loop_write_file(event_loop_t* loop, db_buffer buffer, const char* path) {
+    (void)loop;
+    (void)buffer;
+    (void)path;
+    return NULL;
+}
+
+promise_t* event_loop_exec(event_loop_t* loop, const char* command) {
+    (void)loop;
+    (void)command;
+    return NULL;
+}
+
+bool event_loop_run_until(event_loop_t* loop, promise_t* promise) {
+    (void)loop;
+    (void)promise;
+    return false;
+}
+
+#endif // __linux__
@@ -4,6 +4,18 @@
 // Core VM execution function - executes a function with the given closure
 // Assumes the VM is already set up with proper stack state and call frame
 
+// Calling a generator function from C code: no frame runs, the result is its Iterator
+value_t vm_call_generator(vm_t* vm, value_t callable, int arg_count, value_t* args) {
+    int owns_closure = callable.type == VAL_FUNCTION;
+    closure_t* closure = owns_closure ? closure_create(callable.as.function) : callable.as.closure;
+    iterator_t* iter = closure ? create_generator_iterator(vm, closure, owns_closure, args, arg_count) : NULL;
+    if (!iter) {
+        if (owns_closure) free(closure);
+        return make_undefined();
+    }
+    return make_iterator(iter);
+}
+
 // Helper function to call functions from C code (for array methods, etc.)
 value_t vm_call_function(vm_t* vm, value_t callable, int arg_count, value_t* args) {
     if (callable.type == VAL_NATIVE) {
@@ -33,6 +45,10 @@ value_t vm_call_function(vm_t* vm, value_t callable, int arg_count, value_t* arg
         return make_undefined();
     }
     
+    if (func->is_generator) {
+        return vm_call_generator(vm, callable, actual_arg_count, args);
+    }
+    
     // Use the real VM execution infrastructure for proper closure execution
     closure_t* closure = NULL;
     int created_closure = 0;
@@ -55,6 +71,7 @@ value_t vm_call_function(vm_t* vm, value_t callable, int arg_count, value_t* arg
     uint8_t* saved_ip = vm->ip;
     uint8_t* saved_bytecode = vm->bytecode;
     size_t saved_frame_count = vm->frame_count;
+    size_t saved_call_floor = vm->call_floor;
     
     // Push arguments onto VM stack
     for (int i = 0; i < actual_arg_count; i++) {
@@ -71,8 +88,10 @@ value_t vm_call_function(vm_t* vm, value_t callable, int arg_count, value_t* arg
     vm->ip = func->bytecode;
     vm->bytecode = func->bytecode;
     
-    // Execute the function using our core execution loop
+    // Execute the function using our core execution loop; vm_run returns once this frame returns
+    vm->call_floor = saved_frame_count;
     vm_result result = vm_run(vm);
+    vm->call_floor = saved_call_floor;
     
     value_t return_value = make_undefined();
     if (result == VM_OK) {
@@ -82,14 +101,8 @@ value_t vm_call_function(vm_t* vm, value_t callable, int arg_count, value_t* arg
     
     // Restore VM state
     vm->stack_top = vm->stack + saved_stack_size;
-    // Only restore IP if we're not being called from bytecode execution
-    // When called from bytecode (op_call), we should NOT restore IP
-    // as the calling bytecode needs to continue from where it left off
-    if (saved_frame_count == 0) {
-        // Called from C code - restore IP
-        vm->ip = saved_ip;
-    }
-    // Otherwise leave IP as set by OP_RETURN for proper bytecode continuation
+    // Resume the caller's bytecode where the native was invoked
+    vm->ip = saved_ip;
     vm->bytecode = saved_bytecode;
     vm->frame_count = saved_frame_count;
     
@@ -170,6 +183,11 @@ value_t vm_call_slate_function_safe(vm_t* vm, value_t callable, int arg_count, v
     // Use only the required number of arguments
     int actual_arg_count = (arg_count > func->parameter_count) ? func->parameter_count : arg_count;
     
+    if (func->is_generator) {
+        if (created_closure) free(closure); // The generator makes its own wrapper
+        return vm_call_generator(vm, callable, actual_arg_count, args);
+    }
+    
     // Check frame capacity
     if (vm->frame_count >= vm->frame_capacity) {
         if (created_closure) closure_destroy(closure);
@@ -203,8 +221,11 @@ value_t vm_call_slate_function_safe(vm_t* vm, value_t callable, int arg_count, v
         vm->current_module = closure->module;
     }
     
-    // Execute the function
+    // Execute the function; vm_run returns once this frame returns
+    size_t saved_call_floor = vm->call_floor;
+    vm->call_floor = saved_state.frame_count;
     vm_result result = vm_run(vm);
+    vm->call_floor = saved_call_floor;
     
     // Capture return value before restoring state
     value_t return_value = make_undefined();
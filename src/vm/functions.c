@@ -3,6 +3,7 @@
 #include <string.h>
 #include "codegen.h"
 #include "module.h"
+#include "jit.h"
 
 // Function operations
 function_t* function_create(const char* name) {
@@ -19,8 +20,14 @@ function_t* function_create(const char* name) {
     function->local_count = 0;
     function->name = name ? strdup(name) : NULL;
     function->debug = NULL; // Initialize debug info
+    function->local_types = NULL;
     function->upvalue_descriptors = NULL;
     function->upvalue_count = 0;
+    function->hotness = 0;
+    function->jit = NULL;
+    function->jit_disabled = 0;
+    function->native = NULL;
+    function->is_generator = 0;
 
     return function;
 }
@@ -42,9 +49,13 @@ void function_destroy(function_t* function) {
     free(function->parameter_names);
 
     debug_info_destroy(function->debug);
+    free(function->local_types);
 
     free(function->upvalue_descriptors);
     free(function->name);
+#ifdef SLATE_JIT
+    jit_code_free(function->jit);
+#endif
     free(function);
 }
 
@@ -57,6 +68,7 @@ closure_t* closure_create(function_t* function) {
     closure->upvalues = NULL;
     closure->upvalue_count = 0;
     closure->module = NULL; // No module context for legacy calls
+    closure->is_local = 0;
 
     return closure;
 }
@@ -71,6 +83,7 @@ closure_t* closure_create_with_module(function_t* function, vm_t* vm) {
     closure->upvalue_count = 0;
     // Capture current module context for namespace resolution
     closure->module = module_get_current_context(vm);
+    closure->is_local = 0;
 
     return closure;
 }
@@ -82,4 +95,84 @@ void closure_destroy(closure_t* closure) {
     function_destroy(closure->function);
     free(closure->upvalues);
     free(closure);
-}
\ No newline at end of file
+}
+
+closure_t* local_closure_acquire(vm_t* vm, function_t* function) {
+    if (vm->local_closure_count == vm->local_closure_capacity) {
+        size_t new_capacity = vm->local_closure_capacity ? vm->local_closure_capacity * 2 : 8;
+        local_closure_t** slots = realloc(vm->local_closures, sizeof(local_closure_t*) * new_capacity);
+        if (!slots)
+            return NULL;
+        for (size_t i = vm->local_closure_capacity; i < new_capacity; i++) {
+            slots[i] = NULL;
+        }
+        vm->local_closures = slots;
+        vm->local_closure_capacity = new_capacity;
+    }
+
+    local_closure_t* slot = vm->local_closures[vm->local_closure_count];
+    if (!slot) {
+        slot = calloc(1, sizeof(local_closure_t));
+        if (!slot)
+            return NULL;
+        vm->local_closures[vm->local_closure_count] = slot;
+    }
+
+    if (slot->upvalue_capacity < function->upvalue_count) {
+        value_t* upvalues = realloc(slot->closure.upvalues, sizeof(value_t) * function->upvalue_count);
+        if (!upvalues)
+            return NULL;
+        slot->closure.upvalues = upvalues;
+        slot->upvalue_capacity = function->upvalue_count;
+    }
+
+    vm->local_closure_count++;
+    slot->closure.function = function;
+    slot->closure.upvalue_count = function->upvalue_count;
+    slot->closure.module = module_get_current_context(vm);
+    slot->closure.is_local = 1;
+    return &slot->closure;
+}
+
+void local_closures_release(vm_t* vm, size_t count) {
+    while (count-- > 0 && vm->local_closure_count > 0) {
+        closure_t* closure = &vm->local_closures[--vm->local_closure_count]->closure;
+        for (size_t i = 0; i < closure->upvalue_count; i++) {
+            vm_release(closure->upvalues[i]);
+        }
+        closure->upvalue_count = 0;
+    }
+}
+
+closure_t* closure_promote(closure_t* closure) {
+    closure_t* copy = malloc(sizeof(closure_t));
+    if (!copy)
+        return NULL;
+
+    *copy = *closure;
+    copy->is_local = 0;
+    copy->upvalues = NULL;
+    if (closure->upvalue_count > 0) {
+        copy->upvalues = malloc(sizeof(value_t) * closure->upvalue_count);
+        if (!copy->upvalues) {
+            free(copy);
+            return NULL;
+        }
+        for (size_t i = 0; i < closure->upvalue_count; i++) {
+            copy->upvalues[i] = vm_retain(closure->upvalues[i]);
+        }
+    }
+    return copy;
+}
+
+void closure_free_promoted(closure_t* closure) {
+    if (!closure) {
+        return;
+    }
+    // Only the closure itself: its function belongs to the VM's function table
+    for (size_t i = 0; i < closure->upvalue_count; i++) {
+        vm_release(closure->upvalues[i]);
+    }
+    free(closure->upvalues);
+    free(closure);
+}
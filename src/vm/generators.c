@@ -0,0 +1,185 @@
+#include "vm.h"
+#include "module.h"
+#include "runtime_error.h"
+#include <stdlib.h>
+
+// Generator functions (any function whose body contains yield).
+//
+// Calling one doesn't run it: the arguments are moved into a heap generator and the call
+// evaluates to an Iterator. iterator_has_next resumes the body on the VM stack as a normal call
+// frame, with vm->call_floor set so that vm_run returns as soon as the frame yields (OP_YIELD
+// moves the window back into the generator) or returns (the generator is done). Nothing the
+// frame owns stays on the VM stack between resumes, so generators can be resumed from anywhere,
+// in any order, and simply freed when abandoned.
+
+iterator_t* create_generator_iterator(vm_t* vm, closure_t* closure, int owns_closure, value_t* args, size_t arg_count) {
+    generator_t* gen = malloc(sizeof(generator_t));
+    iterator_t* iter = malloc(sizeof(iterator_t));
+    value_t* stack = arg_count > 0 ? malloc(sizeof(value_t) * arg_count) : NULL;
+    // The generator outlives the pool slot of a lambda that was only meant for one call
+    closure_t* promoted = closure->is_local ? closure_promote(closure) : NULL;
+    if (!gen || !iter || (arg_count > 0 && !stack) || (closure->is_local && !promoted)) {
+        free(gen);
+        free(iter);
+        free(stack);
+        closure_free_promoted(promoted);
+        return NULL;
+    }
+    if (promoted) {
+        closure = promoted;
+        owns_closure = 1;
+    }
+
+    // The arguments become the first slots of the frame, exactly as a call would push them
+    for (size_t i = 0; i < arg_count; i++) {
+        stack[i] = vm_retain(args[i]);
+    }
+
+    gen->vm = vm;
+    gen->closure = closure;
+    gen->owns_closure = owns_closure;
+    gen->stack = stack;
+    gen->stack_count = arg_count;
+    gen->stack_capacity = arg_count;
+    gen->ip = closure->function->bytecode;
+    gen->started = 0;
+    gen->state = GEN_SUSPENDED;
+    gen->pending = make_null();
+    gen->has_pending = 0;
+    gen->result = make_null();
+    gen->resumer = NULL;
+
+    iter->ref_count = 1;
+    iter->type = ITER_GENERATOR;
+    iter->data.generator = gen;
+    return iter;
+}
+
+// Run the body until its next yield or its end; `sent` becomes the value of the yield it resumes
+static void generator_resume(generator_t* gen, value_t sent) {
+    vm_t* vm = gen->vm;
+
+    for (generator_t* active = vm->generator; active; active = active->resumer) {
+        if (active == gen) {
+            vm_release(sent);
+            runtime_error(vm, "Generator is already running");
+            return;
+        }
+    }
+    if (vm->frame_count >= vm->frame_capacity) {
+        vm_release(sent);
+        runtime_error(vm, "Stack overflow");
+        return;
+    }
+
+    uint8_t* saved_bytecode = vm->bytecode;
+    uint8_t* saved_ip = vm->ip;
+    uint8_t* saved_instruction = vm->current_instruction;
+    value_t* saved_stack_top = vm->stack_top;
+    size_t saved_frame_count = vm->frame_count;
+    size_t saved_call_floor = vm->call_floor;
+    value_t saved_result = vm->result;
+
+    // Restore the frame: saved window, then the value of the yield expression being resumed
+    value_t* slots = vm->stack_top;
+    for (size_t i = 0; i < gen->stack_count; i++) {
+        vm_push(vm, gen->stack[i]);
+    }
+    gen->stack_count = 0;
+    if (gen->started) {
+        vm_push(vm, sent);
+    } else {
+        vm_release(sent); // There's no yield expression to receive it yet
+    }
+    gen->started = 1;
+
+    call_frame* frame = &vm->frames[vm->frame_count++];
+    frame->closure = gen->closure;
+    frame->ip = saved_ip;
+    frame->slots = slots;
+    if (gen->closure->module) {
+        module_push_context(vm, gen->closure->module);
+    }
+
+    vm->bytecode = gen->closure->function->bytecode;
+    vm->ip = gen->ip;
+    vm->call_floor = saved_frame_count;
+    gen->state = GEN_RUNNING;
+    gen->resumer = vm->generator;
+    vm->generator = gen;
+
+    vm_result result = vm_run(vm);
+
+    vm->generator = gen->resumer;
+    gen->resumer = NULL;
+    if (gen->state == GEN_RUNNING) {
+        // The body returned (or failed): its return value isn't part of the sequence
+        gen->state = GEN_DONE;
+        if (result == VM_OK) {
+            gen->result = vm->result;
+        }
+    }
+
+    vm->bytecode = saved_bytecode;
+    vm->ip = saved_ip;
+    vm->current_instruction = saved_instruction;
+    vm->stack_top = saved_stack_top;
+    vm->frame_count = saved_frame_count;
+    vm->call_floor = saved_call_floor;
+    vm->result = saved_result;
+}
+
+int generator_send(generator_t* gen, value_t sent) {
+    if (gen->has_pending) {
+        vm_release(sent);
+        return 1;
+    }
+    // A body that raised out of its resume never got back to mark itself done
+    if (gen->state == GEN_RUNNING) {
+        int active = 0;
+        for (generator_t* g = gen->vm->generator; g; g = g->resumer) {
+            active |= g == gen;
+        }
+        if (!active) {
+            gen->state = GEN_DONE;
+        }
+    }
+    if (gen->state == GEN_DONE) {
+        vm_release(sent);
+        return 0;
+    }
+    generator_resume(gen, sent);
+    return gen->has_pending;
+}
+
+int generator_has_next(generator_t* gen) {
+    return generator_send(gen, make_null());
+}
+
+value_t generator_next(generator_t* gen) {
+    if (!generator_has_next(gen)) {
+        return make_null();
+    }
+    value_t value = gen->pending;
+    gen->pending = make_null();
+    gen->has_pending = 0;
+    return value;
+}
+
+void generator_destroy(generator_t* gen) {
+    if (!gen) {
+        return;
+    }
+    for (size_t i = 0; i < gen->stack_count; i++) {
+        vm_release(gen->stack[i]);
+    }
+    free(gen->stack);
+    if (gen->has_pending) {
+        vm_release(gen->pending);
+    }
+    vm_release(gen->result);
+    if (gen->owns_closure) {
+        closure_free_promoted(gen->closure);
+    }
+    free(gen);
+}
@@ -0,0 +1,270 @@
+#include "vm.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Open-addressing hash table shared by Map and Set. The slot array holds entry indexes and is
+// probed linearly; entries are appended to a separate array in insertion order. A removal marks
+// both the slot and the entry dead until the next rehash compacts them away. Slots are never
+// more than half used (the slot array is twice the entry capacity), so probes stay short and
+// always reach an empty slot.
+
+// ===========================
+// KEY HASHING AND EQUALITY
+// ===========================
+
+// 64-bit finalizer (from MurmurHash3): spreads sequential integers across the low bits
+static inline uint32_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= UINT64_C(0xff51afd7ed558ccd);
+    x ^= x >> 33;
+    x *= UINT64_C(0xc4ceb9fe1a85ec53);
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+// Integral values hash like the integer itself, so 1, 1.0 and BigInt 1 collide as they must
+static uint32_t number_hash(double x) {
+    if (x >= -9223372036854775808.0 && x < 9223372036854775808.0 && x == floor(x)) {
+        return mix64((uint64_t)(int64_t)x);
+    }
+    if (isnan(x)) {
+        return 0x7fc00000;
+    }
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return mix64(bits);
+}
+
+// FNV-1a, cached in the string's header so a key is only ever hashed once
+static uint32_t string_hash(ds_string str) {
+    uint32_t hash = ds_hash32(str);
+    return hash ^ (hash >> 15);
+}
+
+uint32_t hash_map_key_hash(vm_t* vm, value_t key) {
+    switch (key.type) {
+    case VAL_INT32:
+        return mix64((uint64_t)(int64_t)key.as.int32);
+    case VAL_FLOAT32:
+        return number_hash(key.as.float32);
+    case VAL_FLOAT64:
+        return number_hash(key.as.float64);
+    case VAL_BIGINT: {
+        int64_t small;
+        if (di_to_int64(key.as.bigint, &small)) {
+            return mix64((uint64_t)small);
+        }
+        return number_hash(di_to_double(key.as.bigint));
+    }
+    case VAL_STRING:
+        return key.as.string ? string_hash(key.as.string) : 0;
+    case VAL_NULL:
+        return 0x9e3779b9;
+    case VAL_BOOLEAN:
+        return key.as.boolean ? 0x85ebca6b : 0xc2b2ae35;
+    default:
+        return mix64(call_hash_method(vm, key));
+    }
+}
+
+static bool keys_equal(vm_t* vm, value_t a, value_t b) {
+    if (a.type == VAL_INT32 && b.type == VAL_INT32) {
+        return a.as.int32 == b.as.int32;
+    }
+    if (a.type == VAL_STRING && b.type == VAL_STRING) {
+        if (a.as.string == b.as.string) return true;
+        if (!a.as.string || !b.as.string) return false;
+        return ds_equals(a.as.string, b.as.string);
+    }
+    return call_equals_method(vm, a, b);
+}
+
+// ===========================
+// PROBING AND RESIZING
+// ===========================
+
+// The slot holding key, or NULL with *insert_at (if given) set to the slot a new entry should use
+static uint32_t* find_slot(vm_t* vm, hash_map_t* map, value_t key, uint32_t hash, uint32_t** insert_at) {
+    uint32_t* first_removed = NULL;
+    for (size_t i = hash & map->slot_mask;; i = (i + 1) & map->slot_mask) {
+        uint32_t* slot = &map->slots[i];
+        if (*slot == 0) {
+            if (insert_at) {
+                *insert_at = first_removed ? first_removed : slot;
+            }
+            return NULL;
+        }
+        if (*slot == HASH_MAP_SLOT_REMOVED) {
+            if (!first_removed) first_removed = slot;
+            continue;
+        }
+        hash_map_entry* entry = &map->entries[*slot - 1];
+        if (entry->hash == hash && keys_equal(vm, entry->key, key)) {
+            return slot;
+        }
+    }
+}
+
+// Rebuilds the table with room for entry_capacity entries, dropping removed ones. Stored hashes
+// are reused, so no hash() or equals() runs.
+static int resize(hash_map_t* map, size_t entry_capacity) {
+    if (entry_capacity >= UINT32_MAX / 2) {
+        return 0;
+    }
+    hash_map_entry* entries = malloc(entry_capacity * sizeof(hash_map_entry));
+    uint32_t* slots = calloc(entry_capacity * 2, sizeof(uint32_t));
+    if (!entries || !slots) {
+        free(entries);
+        free(slots);
+        return 0;
+    }
+
+    size_t slot_mask = entry_capacity * 2 - 1;
+    size_t count = 0;
+    for (size_t i = 0; i < map->entry_count; i++) {
+        if (!map->entries[i].live) continue;
+        entries[count] = map->entries[i];
+        size_t s = entries[count].hash & slot_mask;
+        while (slots[s] != 0) s = (s + 1) & slot_mask;
+        slots[s] = (uint32_t)(count + 1);
+        count++;
+    }
+
+    free(map->entries);
+    free(map->slots);
+    map->entries = entries;
+    map->slots = slots;
+    map->entry_capacity = entry_capacity;
+    map->entry_count = count;
+    map->slot_mask = slot_mask;
+    return 1;
+}
+
+// ===========================
+// TABLE OPERATIONS
+// ===========================
+
+hash_map_entry* hash_map_find(vm_t* vm, hash_map_t* map, value_t key) {
+    if (map->count == 0) {
+        return NULL;
+    }
+    uint32_t* slot = find_slot(vm, map, key, hash_map_key_hash(vm, key), NULL);
+    return slot ? &map->entries[*slot - 1] : NULL;
+}
+
+int hash_map_put(vm_t* vm, hash_map_t* map, value_t key, value_t value) {
+    uint32_t hash = hash_map_key_hash(vm, key);
+    uint32_t* insert_at;
+    uint32_t* slot = find_slot(vm, map, key, hash, &insert_at);
+    if (slot) {
+        hash_map_entry* entry = &map->entries[*slot - 1];
+        value_t old = entry->value;
+        entry->value = vm_retain(value);
+        vm_release(old);
+        return 1;
+    }
+
+    if (map->entry_count == map->entry_capacity) {
+        // Mostly removed entries: compacting in place is enough; otherwise double
+        size_t capacity = map->count >= map->entry_capacity / 2 ? map->entry_capacity * 2 : map->entry_capacity;
+        if (!resize(map, capacity)) {
+            return 0;
+        }
+        find_slot(vm, map, key, hash, &insert_at);
+    }
+
+    size_t index = map->entry_count++;
+    map->entries[index].key = vm_retain(key);
+    map->entries[index].value = vm_retain(value);
+    map->entries[index].hash = hash;
+    map->entries[index].live = true;
+    *insert_at = (uint32_t)(index + 1);
+    map->count++;
+    return 1;
+}
+
+int hash_map_remove(vm_t* vm, hash_map_t* map, value_t key) {
+    if (map->count == 0) {
+        return 0;
+    }
+    uint32_t* slot = find_slot(vm, map, key, hash_map_key_hash(vm, key), NULL);
+    if (!slot) {
+        return 0;
+    }
+    hash_map_entry* entry = &map->entries[*slot - 1];
+    *slot = HASH_MAP_SLOT_REMOVED;
+    entry->live = false;
+    map->count--;
+    vm_release(entry->key);
+    vm_release(entry->value);
+    return 1;
+}
+
+int hash_map_reserve(hash_map_t* map, size_t count) {
+    // Enough unused entries already (removed ones only come back through a rehash)
+    if (count <= map->count + (map->entry_capacity - map->entry_count)) {
+        return 1;
+    }
+    size_t capacity = map->entry_capacity;
+    while (capacity < count) {
+        if (capacity >= UINT32_MAX / 4) return 0;
+        capacity *= 2;
+    }
+    return resize(map, capacity);
+}
+
+void hash_map_clear(hash_map_t* map) {
+    for (size_t i = 0; i < map->entry_count; i++) {
+        if (map->entries[i].live) {
+            vm_release(map->entries[i].key);
+            vm_release(map->entries[i].value);
+        }
+    }
+    memset(map->slots, 0, (map->slot_mask + 1) * sizeof(uint32_t));
+    map->entry_count = 0;
+    map->count = 0;
+}
+
+hash_map_t* hash_map_copy(hash_map_t* map) {
+    hash_map_t* copy = hash_map_create(map->count);
+    if (!copy) {
+        return NULL;
+    }
+    for (size_t i = 0; i < map->entry_count; i++) {
+        hash_map_entry* entry = &map->entries[i];
+        if (!entry->live) continue;
+        size_t index = copy->entry_count++;
+        copy->entries[index].key = vm_retain(entry->key);
+        copy->entries[index].value = vm_retain(entry->value);
+        copy->entries[index].hash = entry->hash;
+        copy->entries[index].live = true;
+        size_t s = entry->hash & copy->slot_mask;
+        while (copy->slots[s] != 0) s = (s + 1) & copy->slot_mask;
+        copy->slots[s] = (uint32_t)(index + 1);
+    }
+    copy->count = copy->entry_count;
+    return copy;
+}
+
+da_array hash_map_to_array(hash_map_t* map, hash_map_view view) {
+    da_array array = da_new(sizeof(value_t));
+    da_reserve(array, map->count);
+    for (size_t i = 0; i < map->entry_count; i++) {
+        hash_map_entry* entry = &map->entries[i];
+        if (!entry->live) continue;
+        value_t element;
+        if (view == HASH_MAP_ENTRIES) {
+            da_array pair = da_new(sizeof(value_t));
+            value_t key = vm_retain(entry->key);
+            value_t value = vm_retain(entry->value);
+            da_push(pair, &key);
+            da_push(pair, &value);
+            element = make_array(pair);
+        } else {
+            element = vm_retain(view == HASH_MAP_KEYS ? entry->key : entry->value);
+        }
+        da_push(array, &element);
+    }
+    return array;
+}
@@ -0,0 +1,369 @@
+#include "isolate.h"
+#include "aot.h"
+#include "codegen.h"
+#include "lexer.h"
+#include "module.h"
+#include "parser.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct isolate {
+    char* source; // Owned copy, or NULL for a program or call
+    const struct aot_program* program;
+    vm_result (*entry)(vm_t* vm, void* context);
+    void* context;
+    int argc;
+    char** argv;
+
+    vm_result result;
+    char* result_text;
+
+    pthread_mutex_t lock; // Guards done
+    pthread_cond_t finished;
+    bool done;
+};
+
+// Isolates waiting to start. The owning worker takes the newest from the back (its caches
+// are warmest for what it just spawned), thieves take the oldest from the front.
+typedef struct {
+    pthread_mutex_t lock;
+    isolate** tasks; // Ring buffer
+    size_t front;
+    size_t count;
+    size_t capacity;
+} isolate_queue;
+
+typedef struct {
+    isolate_pool* pool;
+    size_t index;
+    pthread_t thread;
+    isolate_queue queue;
+} isolate_worker;
+
+struct isolate_pool {
+    isolate_worker* workers;
+    size_t worker_count;
+    atomic_size_t next_queue; // Round-robin target for spawns from outside the pool
+
+    pthread_mutex_t lock; // Guards waiting and stopping
+    pthread_cond_t work_ready;
+    size_t waiting; // Queued isolates no worker has claimed yet
+    bool stopping;
+};
+
+// The worker running on this thread, if any
+static _Thread_local isolate_worker* current_worker = NULL;
+
+// === Queues ===
+
+static void queue_push(isolate_queue* queue, isolate* iso) {
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        size_t capacity = queue->capacity ? queue->capacity * 2 : 16;
+        isolate** tasks = malloc(sizeof(isolate*) * capacity);
+        for (size_t i = 0; i < queue->count; i++) {
+            tasks[i] = queue->tasks[(queue->front + i) % queue->capacity];
+        }
+        free(queue->tasks);
+        queue->tasks = tasks;
+        queue->front = 0;
+        queue->capacity = capacity;
+    }
+    queue->tasks[(queue->front + queue->count) % queue->capacity] = iso;
+    queue->count++;
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static isolate* queue_pop_back(isolate_queue* queue) {
+    isolate* iso = NULL;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count > 0) {
+        queue->count--;
+        iso = queue->tasks[(queue->front + queue->count) % queue->capacity];
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return iso;
+}
+
+static isolate* queue_steal_front(isolate_queue* queue) {
+    isolate* iso = NULL;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count > 0) {
+        iso = queue->tasks[queue->front];
+        queue->front = (queue->front + 1) % queue->capacity;
+        queue->count--;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return iso;
+}
+
+// === Running an isolate ===
+
+static vm_result run_source(vm_t* vm, const char* source) {
+    lexer_t lexer;
+    lexer_init(&lexer, source);
+    parser_t parser;
+    parser_init(&parser, &lexer);
+
+    ast_program* program = parse_program(&parser);
+    if (parser.had_error || !program) {
+        fprintf(stderr, "Parse error\n");
+        lexer_cleanup(&lexer);
+        return VM_COMPILE_ERROR;
+    }
+
+    codegen_t* codegen = codegen_create_with_debug(vm, source);
+    function_t* function = codegen_compile(codegen, program);
+    vm_result result = VM_COMPILE_ERROR;
+    if (codegen->had_error || !function) {
+        fprintf(stderr, "Compilation error\n");
+    } else {
+        result = vm_execute(vm, function);
+    }
+
+    codegen_destroy(codegen);
+    ast_free((ast_node*)program);
+    lexer_cleanup(&lexer);
+    return result;
+}
+
+// Runs on a worker thread, start to finish: vm_create points this thread's class registers at
+// the new VM's builtins
+static void isolate_run(isolate* iso) {
+    vm_t* vm = vm_create_with_args(iso->argc, iso->argv);
+    if (!vm) {
+        iso->result = VM_RUNTIME_ERROR;
+        return;
+    }
+    vm->context = CTX_ISOLATE;
+    module_add_search_path(vm, ".");
+    module_add_env_search_paths(vm);
+
+    // Runtime errors print and unwind to here; whatever the aborted run held goes with the VM
+    if (setjmp(vm->trap) == 0) {
+        if (iso->entry) {
+            iso->result = iso->entry(vm, iso->context);
+        } else if (iso->source) {
+            iso->result = run_source(vm, iso->source);
+        } else {
+            function_t* main_function = aot_load(vm, iso->program);
+            iso->result = main_function ? vm_execute(vm, main_function) : VM_COMPILE_ERROR;
+        }
+        if (iso->result == VM_OK && vm->result.type != VAL_UNDEFINED) {
+            ds_string text = display_value_to_string(vm, vm->result);
+            iso->result_text = strdup(text);
+            ds_release(&text);
+        }
+    } else {
+        iso->result = VM_RUNTIME_ERROR;
+    }
+
+    vm_destroy(vm);
+}
+
+// === Workers ===
+
+static isolate* take_isolate(isolate_worker* worker) {
+    isolate* iso = queue_pop_back(&worker->queue);
+    for (size_t i = 1; !iso && i < worker->pool->worker_count; i++) {
+        iso = queue_steal_front(&worker->pool->workers[(worker->index + i) % worker->pool->worker_count].queue);
+    }
+    return iso;
+}
+
+static void* worker_main(void* arg) {
+    isolate_worker* worker = arg;
+    isolate_pool* pool = worker->pool;
+    current_worker = worker;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->waiting == 0 && !pool->stopping) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->waiting == 0) {
+            pthread_mutex_unlock(&pool->lock); // Stopping, and nothing left to run
+            break;
+        }
+        // Claim one: there are at least as many queued isolates as claims, so the search ends
+        pool->waiting--;
+        pthread_mutex_unlock(&pool->lock);
+
+        isolate* iso;
+        while (!(iso = take_isolate(worker))) {
+            sched_yield(); // Another claimer is mid-way through taking the one we'd find first
+        }
+        isolate_run(iso);
+
+        pthread_mutex_lock(&iso->lock);
+        iso->done = true;
+        pthread_cond_broadcast(&iso->finished);
+        pthread_mutex_unlock(&iso->lock);
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+// === Pool ===
+
+isolate_pool* isolate_pool_create(size_t threads) {
+    if (threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    isolate_pool* pool = calloc(1, sizeof(isolate_pool));
+    if (!pool) return NULL;
+    pool->workers = calloc(threads, sizeof(isolate_worker));
+    if (!pool->workers) {
+        free(pool);
+        return NULL;
+    }
+    pool->worker_count = threads;
+    atomic_init(&pool->next_queue, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+
+    for (size_t i = 0; i < threads; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i;
+        pthread_mutex_init(&pool->workers[i].queue.lock, NULL);
+    }
+
+    size_t started = 0;
+    while (started < threads &&
+           pthread_create(&pool->workers[started].thread, NULL, worker_main, &pool->workers[started]) == 0) {
+        started++;
+    }
+    if (started < threads) {
+        // All or nothing: the workers already running scan every queue
+        pthread_mutex_lock(&pool->lock);
+        pool->stopping = true;
+        pthread_cond_broadcast(&pool->work_ready);
+        pthread_mutex_unlock(&pool->lock);
+        for (size_t i = 0; i < started; i++) {
+            pthread_join(pool->workers[i].thread, NULL);
+        }
+        for (size_t i = 0; i < threads; i++) {
+            pthread_mutex_destroy(&pool->workers[i].queue.lock);
+        }
+        pthread_cond_destroy(&pool->work_ready);
+        pthread_mutex_destroy(&pool->lock);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void isolate_pool_destroy(isolate_pool* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->worker_count; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    for (size_t i = 0; i < pool->worker_count; i++) {
+        free(pool->workers[i].queue.tasks);
+        pthread_mutex_destroy(&pool->workers[i].queue.lock);
+    }
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+size_t isolate_pool_size(const isolate_pool* pool) {
+    return pool ? pool->worker_count : 0;
+}
+
+// === Isolates ===
+
+static isolate* isolate_enqueue(isolate_pool* pool, isolate* iso) {
+    pthread_mutex_init(&iso->lock, NULL);
+    pthread_cond_init(&iso->finished, NULL);
+
+    // Isolates spawned by a worker stay on its queue until someone steals them
+    isolate_worker* worker = current_worker;
+    if (!worker || worker->pool != pool) {
+        worker = &pool->workers[atomic_fetch_add(&pool->next_queue, 1) % pool->worker_count];
+    }
+    queue_push(&worker->queue, iso);
+
+    pthread_mutex_lock(&pool->lock);
+    pool->waiting++;
+    pthread_cond_signal(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    return iso;
+}
+
+isolate* isolate_spawn(isolate_pool* pool, const char* source, int argc, char** argv) {
+    if (!pool || !source) return NULL;
+
+    isolate* iso = calloc(1, sizeof(isolate));
+    if (!iso) return NULL;
+    iso->source = strdup(source);
+    if (!iso->source) {
+        free(iso);
+        return NULL;
+    }
+    iso->argc = argc;
+    iso->argv = argv;
+    return isolate_enqueue(pool, iso);
+}
+
+isolate* isolate_spawn_program(isolate_pool* pool, const struct aot_program* program, int argc, char** argv) {
+    if (!pool || !program) return NULL;
+
+    isolate* iso = calloc(1, sizeof(isolate));
+    if (!iso) return NULL;
+    iso->program = program;
+    iso->argc = argc;
+    iso->argv = argv;
+    return isolate_enqueue(pool, iso);
+}
+
+isolate* isolate_spawn_call(isolate_pool* pool, vm_result (*entry)(vm_t* vm, void* context), void* context) {
+    if (!pool || !entry) return NULL;
+
+    isolate* iso = calloc(1, sizeof(isolate));
+    if (!iso) return NULL;
+    iso->entry = entry;
+    iso->context = context;
+    return isolate_enqueue(pool, iso);
+}
+
+vm_result isolate_join(isolate* iso, char** result_text) {
+    if (result_text) *result_text = NULL;
+    if (!iso) return VM_RUNTIME_ERROR;
+
+    pthread_mutex_lock(&iso->lock);
+    while (!iso->done) {
+        pthread_cond_wait(&iso->finished, &iso->lock);
+    }
+    pthread_mutex_unlock(&iso->lock);
+
+    vm_result result = iso->result;
+    if (result_text) {
+        *result_text = iso->result_text;
+    } else {
+        free(iso->result_text);
+    }
+
+    pthread_cond_destroy(&iso->finished);
+    pthread_mutex_destroy(&iso->lock);
+    free(iso->source);
+    free(iso);
+    return result;
+}
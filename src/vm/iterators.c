@@ -49,6 +49,27 @@ iterator_t* create_range_iterator(value_t start, value_t end, int exclusive, val
     return iter;
 }
 
+iterator_t* iterator_for_value(value_t value) {
+    switch (value.type) {
+    case VAL_ARRAY:
+        return value.as.array ? create_array_iterator(value.as.array) : NULL;
+    case VAL_RANGE:
+        return value.as.range ? create_range_iterator(value.as.range->start, value.as.range->end,
+                                                      value.as.range->exclusive, value.as.range->step) : NULL;
+    case VAL_ITERATOR:
+        return iterator_retain(value.as.iterator);
+    case VAL_SET:
+    case VAL_MAP: {
+        da_array snapshot = hash_map_to_array(value.as.map, value.type == VAL_SET ? HASH_MAP_KEYS : HASH_MAP_ENTRIES);
+        iterator_t* iter = create_array_iterator(snapshot); // Retains the snapshot
+        da_release(&snapshot);
+        return iter;
+    }
+    default:
+        return NULL;
+    }
+}
+
 int iterator_has_next(iterator_t* iter) {
     if (!iter)
         return 0;
@@ -84,6 +105,10 @@ int iterator_has_next(iterator_t* iter) {
             }
         }
     }
+    case ITER_GENERATOR:
+        return generator_has_next(iter->data.generator);
+    case ITER_PIPELINE:
+        return pipeline_has_next(iter->data.pipeline);
     default:
         return 0;
     }
@@ -113,6 +138,10 @@ value_t iterator_next(iterator_t* iter) {
 
         return current;
     }
+    case ITER_GENERATOR:
+        return generator_next(iter->data.generator);
+    case ITER_PIPELINE:
+        return pipeline_next(iter->data.pipeline);
     default:
         return make_null();
     }
@@ -139,6 +168,10 @@ void iterator_release(iterator_t* iter) {
             vm_release(iter->data.range_iter.current);
             vm_release(iter->data.range_iter.end);
             vm_release(iter->data.range_iter.step);
+        } else if (iter->type == ITER_GENERATOR) {
+            generator_destroy(iter->data.generator);
+        } else if (iter->type == ITER_PIPELINE) {
+            pipeline_destroy(iter->data.pipeline);
         }
 
         // Free the iterator itself
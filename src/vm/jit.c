@@ -0,0 +1,623 @@
+#include "jit.h"
+
+#ifdef SLATE_JIT
+
+#include "../opcodes/opcodes.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+// Native code layout (System V x86-64):
+//   rbx = vm, r12 = frame depth of the compiled function, r13 = its local slots,
+//   r14 = one past the last usable stack slot.
+// The entry point jumps to `resume`: the first instruction for a call, or a loop header when
+// the interpreter switches over mid-loop.
+// Each bytecode instruction becomes either an inline fast path with a handler fallback, or a
+// plain call into the interpreter's op_* handler with vm->ip pointing at its operands. Handlers
+// that leave a new call frame behind (calls) have the callee run to completion before the
+// next instruction, so the compiled code always resumes at the instruction that follows.
+
+typedef vm_result (*jit_handler_t)(vm_t* vm);
+typedef vm_result (*jit_entry_t)(vm_t* vm, value_t* slots, size_t depth, value_t* stack_limit, void* resume);
+
+#define JIT_NO_LABEL UINT32_MAX
+#define JIT_EXIT SIZE_MAX
+
+struct jit_code {
+    jit_entry_t entry; // Start of the executable mapping
+    size_t size; // Mapping size
+    const uint8_t* bytecode; // Bytecode the labels refer to
+    uint32_t* labels; // Native offset of each instruction start, JIT_NO_LABEL elsewhere
+};
+
+typedef struct {
+    size_t at; // Position of the rel32 to patch
+    size_t target; // Bytecode offset of the jump target, or JIT_EXIT
+} jit_fixup;
+
+typedef struct {
+    uint8_t* code;
+    size_t length;
+    size_t capacity;
+    const uint8_t* bytecode;
+    size_t bytecode_length;
+    uint32_t* labels;
+    da_array fixups;
+    jit_code_t* result;
+} jit_compiler;
+
+_Static_assert(sizeof(value_type) == 4, "JIT type checks compare 32-bit type tags");
+
+#define VALUE_SIZE ((int32_t)sizeof(value_t))
+#define TYPE_AT(slot) ((int32_t)((slot) * VALUE_SIZE + offsetof(value_t, type)))
+#define AS_AT(slot) ((int32_t)((slot) * VALUE_SIZE + offsetof(value_t, as)))
+#define CLASS_AT(slot) ((int32_t)((slot) * VALUE_SIZE + offsetof(value_t, class)))
+#define VM_FIELD(field) ((int32_t)offsetof(vm_t, field))
+
+// x86 condition codes used with Jcc (0F 80+cc) and SETcc (0F 90+cc)
+enum { CC_O = 0x0, CC_AE = 0x3, CC_E = 0x4, CC_NE = 0x5, CC_L = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G = 0xF };
+
+// Hotness threshold, read once from SLATE_JIT_THRESHOLD (isolates may ask from several threads)
+static long threshold = JIT_DEFAULT_THRESHOLD;
+static pthread_once_t threshold_once = PTHREAD_ONCE_INIT;
+
+static void read_threshold(void) {
+    const char* env = getenv("SLATE_JIT_THRESHOLD");
+    threshold = env ? strtol(env, NULL, 10) : JIT_DEFAULT_THRESHOLD;
+    if (threshold < 0) {
+        threshold = JIT_DEFAULT_THRESHOLD;
+    }
+}
+
+static long jit_threshold(void) {
+    pthread_once(&threshold_once, read_threshold);
+    return threshold;
+}
+
+// === Code buffer ===
+
+static void emit_bytes(jit_compiler* c, const void* bytes, size_t count) {
+    if (c->length + count > c->capacity) {
+        size_t capacity = c->capacity ? c->capacity * 2 : 4096;
+        while (capacity < c->length + count) {
+            capacity *= 2;
+        }
+        c->code = realloc(c->code, capacity);
+        c->capacity = capacity;
+    }
+    memcpy(c->code + c->length, bytes, count);
+    c->length += count;
+}
+
+static void emit_u8(jit_compiler* c, uint8_t byte) { emit_bytes(c, &byte, 1); }
+
+static void emit_u32(jit_compiler* c, uint32_t value) { emit_bytes(c, &value, 4); }
+
+static void emit_u64(jit_compiler* c, uint64_t value) { emit_bytes(c, &value, 8); }
+
+static void emit_op(jit_compiler* c, const char* bytes, size_t count) { emit_bytes(c, bytes, count); }
+
+static void emit_op_disp(jit_compiler* c, const char* bytes, size_t count, int32_t disp) {
+    emit_bytes(c, bytes, count);
+    emit_u32(c, (uint32_t)disp);
+}
+
+// Jump to a bytecode offset (or the exit), patched once every label is known
+static void emit_jump_to(jit_compiler* c, int cc, size_t target) {
+    if (cc < 0) {
+        emit_u8(c, 0xE9);
+    } else {
+        emit_u8(c, 0x0F);
+        emit_u8(c, (uint8_t)(0x80 | cc));
+    }
+    jit_fixup fixup = {c->length, target};
+    da_push(c->fixups, &fixup);
+    emit_u32(c, 0);
+}
+
+static void emit_jump_to_exit(jit_compiler* c, int cc) { emit_jump_to(c, cc, JIT_EXIT); }
+
+// Forward jump within the current instruction; returns the rel32 position for patch_here
+static size_t emit_jump_forward(jit_compiler* c, int cc) {
+    if (cc < 0) {
+        emit_u8(c, 0xE9);
+    } else {
+        emit_u8(c, 0x0F);
+        emit_u8(c, (uint8_t)(0x80 | cc));
+    }
+    size_t at = c->length;
+    emit_u32(c, 0);
+    return at;
+}
+
+static void patch_here(jit_compiler* c, size_t at) {
+    int32_t rel = (int32_t)(c->length - (at + 4));
+    memcpy(c->code + at, &rel, 4);
+}
+
+static void emit_call(jit_compiler* c, const void* function) {
+    emit_op(c, "\x48\xB8", 2); // movabs rax, function
+    emit_u64(c, (uint64_t)(uintptr_t)function);
+    emit_op(c, "\xFF\xD0", 2); // call rax
+}
+
+// === Instruction templates ===
+
+// Call the interpreter's handler with vm->ip just past the opcode, as vm_run does
+static void emit_handler_call(jit_compiler* c, size_t offset, jit_handler_t handler) {
+    emit_op(c, "\x48\xB8", 2); // movabs rax, &bytecode[offset]
+    emit_u64(c, (uint64_t)(uintptr_t)(c->bytecode + offset));
+    emit_op_disp(c, "\x48\x89\x83", 3, VM_FIELD(current_instruction)); // mov [rbx+current_instruction], rax
+    emit_op(c, "\x48\xFF\xC0", 3); // inc rax
+    emit_op_disp(c, "\x48\x89\x83", 3, VM_FIELD(ip)); // mov [rbx+ip], rax
+    emit_op(c, "\x48\x89\xDF", 3); // mov rdi, rbx
+    emit_call(c, (const void*)handler);
+    emit_op(c, "\x85\xC0", 2); // test eax, eax
+    emit_jump_to_exit(c, CC_NE);
+}
+
+static vm_result jit_run_callee(vm_t* vm, size_t caller_depth);
+
+// A handler that pushed a call frame (calls, callable indexing) leaves the callee to run
+static void emit_callee_check(jit_compiler* c) {
+    emit_op_disp(c, "\x4C\x39\xA3", 3, VM_FIELD(frame_count)); // cmp [rbx+frame_count], r12
+    size_t same_frame = emit_jump_forward(c, CC_E);
+    emit_op(c, "\x48\x89\xDF", 3); // mov rdi, rbx
+    emit_op(c, "\x4C\x89\xE6", 3); // mov rsi, r12
+    emit_call(c, (const void*)jit_run_callee);
+    emit_op(c, "\x85\xC0", 2); // test eax, eax
+    emit_jump_to_exit(c, CC_NE);
+    patch_here(c, same_frame);
+}
+
+static void emit_generic(jit_compiler* c, size_t offset, jit_handler_t handler) {
+    emit_handler_call(c, offset, handler);
+    emit_callee_check(c);
+}
+
+// rax = vm->stack_top; bail to `slow` unless the top `count` values are int32
+static void emit_int32_operand_checks(jit_compiler* c, int count, size_t* slow, int* slow_count) {
+    emit_op_disp(c, "\x48\x8B\x83", 3, VM_FIELD(stack_top)); // mov rax, [rbx+stack_top]
+    for (int i = 1; i <= count; i++) {
+        emit_op_disp(c, "\x81\xB8", 2, TYPE_AT(-i)); // cmp dword [rax+type], VAL_INT32
+        emit_u32(c, VAL_INT32);
+        slow[(*slow_count)++] = emit_jump_forward(c, CC_NE);
+    }
+}
+
+// Drop the top value: stack_top = rax - 1 slot
+static void emit_pop_one(jit_compiler* c) {
+    emit_op_disp(c, "\x48\x8D\x80", 3, -VALUE_SIZE); // lea rax, [rax-sizeof(value_t)]
+    emit_op_disp(c, "\x48\x89\x83", 3, VM_FIELD(stack_top)); // mov [rbx+stack_top], rax
+}
+
+// GET_LOCAL: copy an int32 local without touching reference counts
+static void emit_get_local(jit_compiler* c, size_t offset) {
+    uint8_t slot = c->bytecode[offset + 1];
+    size_t slow[2];
+    emit_op_disp(c, "\x49\x8D\x85", 3, slot * VALUE_SIZE); // lea rax, [r13+slot]
+    emit_op_disp(c, "\x81\xB8", 2, TYPE_AT(0)); // cmp dword [rax+type], VAL_INT32
+    emit_u32(c, VAL_INT32);
+    slow[0] = emit_jump_forward(c, CC_NE);
+    emit_op_disp(c, "\x48\x8B\x8B", 3, VM_FIELD(stack_top)); // mov rcx, [rbx+stack_top]
+    emit_op(c, "\x4C\x39\xF1", 3); // cmp rcx, r14
+    slow[1] = emit_jump_forward(c, CC_AE);
+    for (int32_t word = 0; word < VALUE_SIZE; word += 8) {
+        emit_op_disp(c, "\x48\x8B\x90", 3, word); // mov rdx, [rax+word]
+        emit_op_disp(c, "\x48\x89\x91", 3, word); // mov [rcx+word], rdx
+    }
+    emit_op(c, "\x48\x81\xC1", 3); // add rcx, sizeof(value_t)
+    emit_u32(c, (uint32_t)VALUE_SIZE);
+    emit_op_disp(c, "\x48\x89\x8B", 3, VM_FIELD(stack_top)); // mov [rbx+stack_top], rcx
+    size_t done = emit_jump_forward(c, -1);
+    patch_here(c, slow[0]);
+    patch_here(c, slow[1]);
+    emit_generic(c, offset, op_get_local);
+    patch_here(c, done);
+}
+
+// ADD/SUBTRACT: int32 arithmetic in place; overflow falls back to the handler's BigInt promotion
+static void emit_int32_arithmetic(jit_compiler* c, size_t offset, uint8_t alu_opcode, jit_handler_t handler) {
+    size_t slow[3];
+    int slow_count = 0;
+    emit_int32_operand_checks(c, 2, slow, &slow_count);
+    emit_op_disp(c, "\x8B\x88", 2, AS_AT(-2)); // mov ecx, [a]
+    emit_u8(c, alu_opcode); // add/sub ecx, [b]
+    emit_u8(c, 0x88);
+    emit_u32(c, (uint32_t)AS_AT(-1));
+    slow[slow_count++] = emit_jump_forward(c, CC_O);
+    emit_op_disp(c, "\x89\x88", 2, AS_AT(-2)); // mov [a], ecx
+    emit_pop_one(c);
+    size_t done = emit_jump_forward(c, -1);
+    for (int i = 0; i < slow_count; i++) {
+        patch_here(c, slow[i]);
+    }
+    emit_generic(c, offset, handler);
+    patch_here(c, done);
+}
+
+// LESS/GREATER/...: int32 comparison producing a Boolean in a's slot
+static void emit_int32_compare(jit_compiler* c, size_t offset, int cc, jit_handler_t handler) {
+    size_t slow[2];
+    int slow_count = 0;
+    emit_int32_operand_checks(c, 2, slow, &slow_count);
+    emit_op_disp(c, "\x8B\x88", 2, AS_AT(-2)); // mov ecx, [a]
+    emit_op_disp(c, "\x3B\x88", 2, AS_AT(-1)); // cmp ecx, [b]
+    emit_u8(c, 0x0F); // setcc dl
+    emit_u8(c, (uint8_t)(0x90 | cc));
+    emit_u8(c, 0xC2);
+    emit_op(c, "\x0F\xB6\xD2", 3); // movzx edx, dl
+    emit_op_disp(c, "\x89\x90", 2, AS_AT(-2)); // mov [a.as], edx
+    emit_op_disp(c, "\xC7\x80", 2, TYPE_AT(-2)); // mov dword [a.type], VAL_BOOLEAN
+    emit_u32(c, VAL_BOOLEAN);
+    emit_op(c, "\x48\xB9", 2); // movabs rcx, &global_boolean_class
+    emit_u64(c, (uint64_t)(uintptr_t)&global_boolean_class);
+    emit_op(c, "\x48\x8B\x09", 3); // mov rcx, [rcx]
+    emit_op_disp(c, "\x48\x89\x88", 3, CLASS_AT(-2)); // mov [a.class], rcx
+    emit_pop_one(c);
+    size_t done = emit_jump_forward(c, -1);
+    for (int i = 0; i < slow_count; i++) {
+        patch_here(c, slow[i]);
+    }
+    emit_generic(c, offset, handler);
+    patch_here(c, done);
+}
+
+// JUMP_IF_FALSE/TRUE: Boolean conditions branch natively, anything else asks the handler and
+// follows wherever it left vm->ip
+static void emit_conditional_jump(jit_compiler* c, size_t offset, size_t target, int jump_if_true, jit_handler_t handler) {
+    emit_op_disp(c, "\x48\x8B\x83", 3, VM_FIELD(stack_top)); // mov rax, [rbx+stack_top]
+    emit_op_disp(c, "\x81\xB8", 2, TYPE_AT(-1)); // cmp dword [rax+type], VAL_BOOLEAN
+    emit_u32(c, VAL_BOOLEAN);
+    size_t slow = emit_jump_forward(c, CC_NE);
+    emit_pop_one(c);
+    emit_op_disp(c, "\x81\xB8", 2, AS_AT(0)); // cmp dword [rax+as], 0
+    emit_u32(c, 0);
+    emit_jump_to(c, jump_if_true ? CC_NE : CC_E, target);
+    size_t done = emit_jump_forward(c, -1);
+    patch_here(c, slow);
+    emit_handler_call(c, offset, handler);
+    emit_op_disp(c, "\x48\x8B\x83", 3, VM_FIELD(ip)); // mov rax, [rbx+ip]
+    emit_op(c, "\x48\xB9", 2); // movabs rcx, fallthrough
+    emit_u64(c, (uint64_t)(uintptr_t)(c->bytecode + offset + 3));
+    emit_op(c, "\x48\x39\xC8", 3); // cmp rax, rcx
+    emit_jump_to(c, CC_NE, target);
+    patch_here(c, done);
+}
+
+// MATCH_SWITCH has a computed target: let the handler pick it, then look up its native label
+static void* jit_resolve_ip(vm_t* vm, jit_code_t* code) {
+    return (uint8_t*)code->entry + code->labels[vm->ip - code->bytecode];
+}
+
+static void emit_computed_jump(jit_compiler* c, size_t offset) {
+    emit_handler_call(c, offset, op_match_switch);
+    emit_op(c, "\x48\x89\xDF", 3); // mov rdi, rbx
+    emit_op(c, "\x48\xBE", 2); // movabs rsi, code
+    emit_u64(c, (uint64_t)(uintptr_t)c->result);
+    emit_call(c, (const void*)jit_resolve_ip);
+    emit_op(c, "\xFF\xE0", 2); // jmp rax
+}
+
+// === Translation ===
+
+// Size of the instruction at offset, or 0 if the JIT can't handle it
+static size_t jit_instruction_length(const uint8_t* bytecode, size_t offset, size_t length) {
+    // Variable-length, frame-suspending or VM-terminating instructions stay in the interpreter
+    if (bytecode[offset] == OP_IMPORT_MODULE || bytecode[offset] == OP_YIELD || bytecode[offset] == OP_HALT) return 0;
+    return instruction_length(bytecode, offset, length);
+}
+
+static jit_handler_t jit_handler(opcode op) {
+    switch (op) {
+    case OP_PUSH_CONSTANT: return op_push_constant;
+    case OP_PUSH_NULL: return op_push_null;
+    case OP_PUSH_UNDEFINED: return op_push_undefined;
+    case OP_PUSH_TRUE: return op_push_true;
+    case OP_PUSH_FALSE: return op_push_false;
+    case OP_POP: return op_pop;
+    case OP_DUP: return op_dup;
+    case OP_SWAP: return op_swap;
+    case OP_NIP: return op_nip;
+    case OP_ROT: return op_rot;
+    case OP_OVER: return op_over;
+    case OP_SET_RESULT: return op_set_result;
+    case OP_ADD: return op_add;
+    case OP_SUBTRACT: return op_subtract;
+    case OP_MULTIPLY: return op_multiply;
+    case OP_DIVIDE: return op_divide;
+    case OP_ADD_INT: return op_add_int;
+    case OP_SUBTRACT_INT: return op_subtract_int;
+    case OP_MULTIPLY_INT: return op_multiply_int;
+    case OP_LESS_INT: return op_less_int;
+    case OP_LESS_EQUAL_INT: return op_less_equal_int;
+    case OP_GREATER_INT: return op_greater_int;
+    case OP_GREATER_EQUAL_INT: return op_greater_equal_int;
+    case OP_ADD_FLOAT: return op_add_float;
+    case OP_SUBTRACT_FLOAT: return op_subtract_float;
+    case OP_MULTIPLY_FLOAT: return op_multiply_float;
+    case OP_DIVIDE_FLOAT: return op_divide_float;
+    case OP_CONCAT_STRING: return op_concat_string;
+    case OP_CONCAT_N: return op_concat_n;
+    case OP_NEGATE: return op_negate;
+    case OP_MOD: return op_mod;
+    case OP_POWER: return op_power;
+    case OP_EQUAL: return op_equal;
+    case OP_NOT_EQUAL: return op_not_equal;
+    case OP_NULL_COALESCE: return op_null_coalesce;
+    case OP_INSTANCEOF: return op_instanceof;
+    case OP_NOT: return op_not;
+    case OP_LESS: return op_less;
+    case OP_GREATER: return op_greater;
+    case OP_LESS_EQUAL: return op_less_equal;
+    case OP_GREATER_EQUAL: return op_greater_equal;
+    case OP_RETURN: return op_return;
+    case OP_GET_LOCAL: return op_get_local;
+    case OP_SET_LOCAL: return op_set_local;
+    case OP_GET_GLOBAL: return op_get_global;
+    case OP_DEFINE_GLOBAL: return op_define_global;
+    case OP_SET_GLOBAL: return op_set_global;
+    case OP_APPEND_LOCAL: return op_append_local;
+    case OP_APPEND_GLOBAL: return op_append_global;
+    case OP_GET_UPVALUE: return op_get_upvalue;
+    case OP_SET_UPVALUE: return op_set_upvalue;
+    case OP_GET_PROPERTY: return op_get_property;
+    case OP_SET_PROPERTY: return op_set_property;
+    case OP_CALL: return op_call;
+    case OP_CLOSURE: return op_closure;
+    case OP_CLOSURE_LOCAL: return op_closure_local;
+    case OP_RELEASE_LOCAL_CLOSURES: return op_release_local_closures;
+    case OP_BUILD_ARRAY: return op_build_array;
+    case OP_GET_INDEX: return op_get_index;
+    case OP_SET_INDEX: return op_set_index;
+    case OP_BUILD_OBJECT: return op_build_object;
+    case OP_SET_DEBUG_LOCATION: return op_set_debug_location;
+    case OP_CLEAR_DEBUG_LOCATION: return op_clear_debug_location;
+    case OP_MATCH_SWITCH: return op_match_switch;
+    case OP_JUMP: return op_jump;
+    case OP_JUMP_IF_FALSE: return op_jump_if_false;
+    case OP_JUMP_IF_TRUE: return op_jump_if_true;
+    case OP_LOOP: return op_loop;
+    case OP_POP_N: return op_pop_n;
+    case OP_BITWISE_AND: return op_bitwise_and;
+    case OP_BITWISE_OR: return op_bitwise_or;
+    case OP_BITWISE_XOR: return op_bitwise_xor;
+    case OP_BITWISE_NOT: return op_bitwise_not;
+    case OP_LEFT_SHIFT: return op_left_shift;
+    case OP_RIGHT_SHIFT: return op_right_shift;
+    case OP_LOGICAL_RIGHT_SHIFT: return op_logical_right_shift;
+    case OP_FLOOR_DIV: return op_floor_div;
+    case OP_INCREMENT: return op_increment;
+    case OP_DECREMENT: return op_decrement;
+    case OP_IN: return op_in;
+    case OP_CALL_METHOD: return op_call_method;
+    case OP_POP_N_PRESERVE_TOP: return op_pop_n_preserve_top;
+    case OP_BUILD_RANGE: return op_build_range;
+    case OP_GET_EXPORT: return op_get_export;
+    case OP_CALL_ADT_BASE_CLASS: return op_call_adt_base_class;
+    case OP_CREATE_ADT_CONSTRUCTOR: return op_create_adt_constructor;
+    default: return NULL;
+    }
+}
+
+static uint16_t read_operand(const uint8_t* bytecode, size_t offset) {
+    return (uint16_t)(bytecode[offset + 1] | (bytecode[offset + 2] << 8));
+}
+
+static int jit_translate(jit_compiler* c) {
+    const uint8_t* bytecode = c->bytecode;
+
+    // Prologue: save callee-saved registers, keep the frame context in them
+    emit_op(c, "\x55\x48\x89\xE5", 4); // push rbp; mov rbp, rsp
+    emit_op(c, "\x53\x41\x54\x41\x55\x41\x56", 7); // push rbx, r12, r13, r14
+    emit_op(c, "\x48\x89\xFB", 3); // mov rbx, rdi (vm)
+    emit_op(c, "\x49\x89\xF5", 3); // mov r13, rsi (slots)
+    emit_op(c, "\x49\x89\xD4", 3); // mov r12, rdx (depth)
+    emit_op(c, "\x49\x89\xCE", 3); // mov r14, rcx (stack limit)
+    emit_op(c, "\x41\xFF\xE0", 3); // jmp r8 (resume point)
+
+    for (size_t offset = 0; offset < c->bytecode_length;) {
+        opcode op = (opcode)bytecode[offset];
+        size_t length = jit_instruction_length(bytecode, offset, c->bytecode_length);
+        jit_handler_t handler = jit_handler(op);
+        if (length == 0 || !handler || offset + length > c->bytecode_length) {
+            return 0;
+        }
+        c->labels[offset] = (uint32_t)c->length;
+
+        switch (op) {
+        case OP_GET_LOCAL:
+            emit_get_local(c, offset);
+            break;
+        case OP_ADD:
+        case OP_ADD_INT:
+            emit_int32_arithmetic(c, offset, 0x03, handler);
+            break;
+        case OP_SUBTRACT:
+        case OP_SUBTRACT_INT:
+            emit_int32_arithmetic(c, offset, 0x2B, handler);
+            break;
+        case OP_LESS:
+        case OP_LESS_INT:
+            emit_int32_compare(c, offset, CC_L, handler);
+            break;
+        case OP_LESS_EQUAL:
+        case OP_LESS_EQUAL_INT:
+            emit_int32_compare(c, offset, CC_LE, handler);
+            break;
+        case OP_GREATER:
+        case OP_GREATER_INT:
+            emit_int32_compare(c, offset, CC_G, handler);
+            break;
+        case OP_GREATER_EQUAL:
+        case OP_GREATER_EQUAL_INT:
+            emit_int32_compare(c, offset, CC_GE, handler);
+            break;
+        case OP_JUMP:
+            emit_jump_to(c, -1, offset + 3 + (int16_t)read_operand(bytecode, offset));
+            break;
+        case OP_LOOP:
+            emit_jump_to(c, -1, offset + 3 - read_operand(bytecode, offset));
+            break;
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+            emit_conditional_jump(c, offset, offset + 3 + read_operand(bytecode, offset),
+                                  op == OP_JUMP_IF_TRUE, handler);
+            break;
+        case OP_MATCH_SWITCH:
+            emit_computed_jump(c, offset);
+            break;
+        case OP_RETURN:
+            emit_handler_call(c, offset, op_return);
+            emit_op(c, "\x31\xC0", 2); // xor eax, eax (VM_OK)
+            emit_jump_to_exit(c, -1);
+            break;
+        default:
+            emit_generic(c, offset, handler);
+            break;
+        }
+        offset += length;
+    }
+
+    // Running off the end of the bytecode is a compiler bug - report it like vm_run would
+    emit_u8(c, 0xB8); // mov eax, VM_RUNTIME_ERROR
+    emit_u32(c, VM_RUNTIME_ERROR);
+
+    // Exit: eax holds the vm_result
+    uint32_t exit_label = (uint32_t)c->length;
+    emit_op(c, "\x41\x5E\x41\x5D\x41\x5C\x5B\x5D\xC3", 9); // pop r14, r13, r12, rbx, rbp; ret
+
+    for (size_t i = 0; i < da_length(c->fixups); i++) {
+        jit_fixup* fixup = (jit_fixup*)da_get(c->fixups, i);
+        uint32_t label = exit_label;
+        if (fixup->target != JIT_EXIT) {
+            if (fixup->target >= c->bytecode_length || c->labels[fixup->target] == JIT_NO_LABEL) {
+                return 0; // Jump outside the function or into the middle of an instruction
+            }
+            label = c->labels[fixup->target];
+        }
+        int32_t rel = (int32_t)(label - (fixup->at + 4));
+        memcpy(c->code + fixup->at, &rel, 4);
+    }
+    return 1;
+}
+
+static jit_code_t* jit_compile(function_t* function) {
+    if (!function->bytecode || function->bytecode_length == 0) {
+        return NULL;
+    }
+
+    jit_code_t* code = calloc(1, sizeof(jit_code_t));
+    uint32_t* labels = malloc(sizeof(uint32_t) * function->bytecode_length);
+    if (!code || !labels) {
+        free(code);
+        free(labels);
+        return NULL;
+    }
+    for (size_t i = 0; i < function->bytecode_length; i++) {
+        labels[i] = JIT_NO_LABEL;
+    }
+
+    jit_compiler c = {0};
+    c.bytecode = function->bytecode;
+    c.bytecode_length = function->bytecode_length;
+    c.labels = labels;
+    c.fixups = da_new(sizeof(jit_fixup));
+    c.result = code;
+
+    int ok = jit_translate(&c);
+    da_release(&c.fixups);
+
+    void* memory = MAP_FAILED;
+    if (ok) {
+        memory = mmap(NULL, c.length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (memory == MAP_FAILED) {
+        free(c.code);
+        free(labels);
+        free(code);
+        return NULL;
+    }
+    memcpy(memory, c.code, c.length);
+    free(c.code);
+    if (mprotect(memory, c.length, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, c.length);
+        free(labels);
+        free(code);
+        return NULL;
+    }
+
+    code->entry = (jit_entry_t)memory;
+    code->size = c.length;
+    code->bytecode = function->bytecode;
+    code->labels = labels;
+    return code;
+}
+
+void jit_code_free(jit_code_t* code) {
+    if (!code) return;
+    munmap((void*)code->entry, code->size);
+    free(code->labels);
+    free(code);
+}
+
+// === Entry ===
+
+// Count a call and compile the function once it's hot; NULL while it should stay interpreted
+static jit_code_t* jit_code_for(function_t* function) {
+    if (function->jit) return function->jit;
+    if (function->jit_disabled || ++function->hotness <= (size_t)jit_threshold()) return NULL;
+
+    function->jit = jit_compile(function);
+    if (!function->jit) {
+        function->jit_disabled = 1;
+    }
+    return function->jit;
+}
+
+// Run the top frame natively from the instruction at `offset` until the function returns
+static vm_result jit_invoke(vm_t* vm, jit_code_t* code, size_t offset) {
+    call_frame* frame = &vm->frames[vm->frame_count - 1];
+    void* resume = (uint8_t*)code->entry + code->labels[offset];
+    return code->entry(vm, frame->slots, vm->frame_count, vm->stack + vm->stack_capacity, resume);
+}
+
+vm_result jit_enter_frame(vm_t* vm, size_t caller_depth) {
+    if (vm->frame_count <= caller_depth) return VM_OK;
+
+    jit_code_t* code = jit_code_for(vm->frames[vm->frame_count - 1].closure->function);
+    return code ? jit_invoke(vm, code, 0) : VM_OK;
+}
+
+vm_result jit_enter_loop(vm_t* vm) {
+    function_t* function = vm->frames[vm->frame_count - 1].closure->function;
+    jit_code_t* code = jit_code_for(function);
+    if (!code) return VM_OK;
+
+    size_t offset = vm->ip - function->bytecode;
+    if (offset >= function->bytecode_length || code->labels[offset] == JIT_NO_LABEL) return VM_OK;
+    return jit_invoke(vm, code, offset);
+}
+
+// Compiled code called something that pushed a frame - run it until it returns to us
+static vm_result jit_run_callee(vm_t* vm, size_t caller_depth) {
+    jit_code_t* code = jit_code_for(vm->frames[vm->frame_count - 1].closure->function);
+    if (code) {
+        return jit_invoke(vm, code, 0);
+    }
+
+    // Interpret the callee; returning to call_floor hands us the result instead of pushing it
+    size_t saved_floor = vm->call_floor;
+    uint8_t* saved_bytecode = vm->bytecode;
+    vm->call_floor = caller_depth;
+    vm_result result = vm_run(vm);
+    vm->call_floor = saved_floor;
+    vm->bytecode = saved_bytecode;
+    if (result == VM_OK) {
+        vm_push(vm, vm->result);
+    }
+    return result;
+}
+
+#endif // SLATE_JIT
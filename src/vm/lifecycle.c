@@ -1,6 +1,7 @@
 #include "vm.h"
 #include "memory.h"
 #include "module.h"
+#include "event_loop.h"
 #include "../opcodes/opcodes.h"
 #include <assert.h>
 #include <math.h>
@@ -31,7 +32,7 @@ static void string_array_release(void* str_ptr) {
 #define CONSTANTS_MAX 256
 
 // Global VM pointer for library assert access
-vm_t* g_current_vm = NULL;
+SLATE_ISOLATE_LOCAL vm_t* g_current_vm = NULL;
 
 // VM lifecycle functions
 vm_t* vm_create(void) {
@@ -39,6 +40,14 @@ vm_t* vm_create(void) {
     if (!vm)
         return NULL;
 
+    // Local closure pool starts empty and grows on first OP_CLOSURE_LOCAL
+    vm->local_closures = NULL;
+    vm->local_closure_count = 0;
+    vm->local_closure_capacity = 0;
+    vm->generator = NULL;
+    vm->event_loop = NULL;
+    vm->call_floor = 0;
+
     vm->stack = malloc(sizeof(value_t) * STACK_MAX);
     vm->frames = malloc(sizeof(call_frame) * FRAMES_MAX);
     vm->constants = malloc(sizeof(value_t) * CONSTANTS_MAX);
@@ -72,7 +81,6 @@ vm_t* vm_create(void) {
         vm_destroy(vm);
         return NULL;
     }
-
     // Initialize module search paths
     vm->module_search_paths = da_create(sizeof(ds_string), 4, 
                                        (void (*)(void*))string_array_retain, 
@@ -139,6 +147,9 @@ void vm_destroy(vm_t* vm) {
         g_current_vm = NULL;
     }
 
+    // Pending tasks and operations hold values, so the loop goes first
+    event_loop_destroy(vm->event_loop);
+
     // Free constants
     for (size_t i = 0; i < vm->constant_count; i++) {
         free_value(vm->constants[i]);
@@ -152,6 +163,16 @@ void vm_destroy(vm_t* vm) {
     
     // Release function table (functions handle their own ref counting)
     da_release(&vm->functions);
+
+    // Release local closure pool slots
+    local_closures_release(vm, vm->local_closure_count);
+    for (size_t i = 0; i < vm->local_closure_capacity; i++) {
+        if (vm->local_closures[i]) {
+            free(vm->local_closures[i]->closure.upvalues);
+            free(vm->local_closures[i]);
+        }
+    }
+    free(vm->local_closures);
     
     // Release module search paths
     da_release(&vm->module_search_paths);
@@ -177,6 +198,7 @@ void vm_reset(vm_t* vm) {
 
     vm->stack_top = vm->stack;
     vm->frame_count = 0;
+    vm->generator = NULL;
     vm->constant_count = 0;
     vm->bytes_allocated = 0;
     vm->bytecode = NULL;
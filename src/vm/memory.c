@@ -1,5 +1,6 @@
 #include "vm.h"
 #include <stdlib.h>
+#include <string.h>
 
 // Bound method reference counting functions
 bound_method_t* bound_method_retain(bound_method_t* method) {
@@ -46,4 +47,87 @@ void range_release(range_t* range) {
         // Free the range itself
         free(range);
     }
-}
\ No newline at end of file
+}
+// Typed array allocation and reference counting functions
+typed_array_t* typed_array_create(typed_array_kind kind, size_t length) {
+    size_t element_size = kind == TYPED_INT32 ? sizeof(int32_t) : sizeof(double);
+    if (length > (SIZE_MAX - 31) / element_size) {
+        return NULL;
+    }
+    typed_array_t* array = malloc(sizeof(typed_array_t));
+    if (!array) {
+        return NULL;
+    }
+
+    // aligned_alloc wants a multiple of the alignment, which also lets kernels read whole vectors
+    size_t bytes = (length * element_size + 31) & ~(size_t)31;
+    array->data.bytes = aligned_alloc(32, bytes ? bytes : 32);
+    if (!array->data.bytes) {
+        free(array);
+        return NULL;
+    }
+    memset(array->data.bytes, 0, bytes);
+    array->ref_count = 1;
+    array->kind = kind;
+    array->length = length;
+    return array;
+}
+
+void typed_array_release(typed_array_t* array) {
+    if (!array)
+        return;
+
+    array->ref_count--;
+    if (array->ref_count == 0) {
+        free(array->data.bytes);
+        free(array);
+    }
+}
+
+// Hash map allocation and reference counting functions
+hash_map_t* hash_map_create(size_t capacity) {
+    // Entry capacity is a power of two with twice as many slots, so slots stay at most half full
+    size_t entry_capacity = 8;
+    while (entry_capacity < capacity) {
+        if (entry_capacity > SIZE_MAX / 4 / sizeof(hash_map_entry)) {
+            return NULL;
+        }
+        entry_capacity *= 2;
+    }
+    hash_map_t* map = malloc(sizeof(hash_map_t));
+    if (!map) {
+        return NULL;
+    }
+    map->entries = malloc(entry_capacity * sizeof(hash_map_entry));
+    map->slots = calloc(entry_capacity * 2, sizeof(uint32_t));
+    if (!map->entries || !map->slots) {
+        free(map->entries);
+        free(map->slots);
+        free(map);
+        return NULL;
+    }
+    map->ref_count = 1;
+    map->entry_count = 0;
+    map->entry_capacity = entry_capacity;
+    map->count = 0;
+    map->slot_mask = entry_capacity * 2 - 1;
+    return map;
+}
+
+void hash_map_release(hash_map_t* map) {
+    if (!map)
+        return;
+
+    map->ref_count--;
+    if (map->ref_count == 0) {
+        for (size_t i = 0; i < map->entry_count; i++) {
+            if (map->entries[i].live) {
+                vm_release(map->entries[i].key);
+                vm_release(map->entries[i].value);
+            }
+        }
+        free(map->entries);
+        free(map->slots);
+        free(map);
+    }
+}
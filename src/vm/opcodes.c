@@ -81,6 +81,32 @@ const char* opcode_name(opcode op) {
         return "INCREMENT";
     case OP_DECREMENT:
         return "DECREMENT";
+    case OP_ADD_INT:
+        return "ADD_INT";
+    case OP_SUBTRACT_INT:
+        return "SUBTRACT_INT";
+    case OP_MULTIPLY_INT:
+        return "MULTIPLY_INT";
+    case OP_LESS_INT:
+        return "LESS_INT";
+    case OP_LESS_EQUAL_INT:
+        return "LESS_EQUAL_INT";
+    case OP_GREATER_INT:
+        return "GREATER_INT";
+    case OP_GREATER_EQUAL_INT:
+        return "GREATER_EQUAL_INT";
+    case OP_ADD_FLOAT:
+        return "ADD_FLOAT";
+    case OP_SUBTRACT_FLOAT:
+        return "SUBTRACT_FLOAT";
+    case OP_MULTIPLY_FLOAT:
+        return "MULTIPLY_FLOAT";
+    case OP_DIVIDE_FLOAT:
+        return "DIVIDE_FLOAT";
+    case OP_CONCAT_STRING:
+        return "CONCAT_STRING";
+    case OP_CONCAT_N:
+        return "CONCAT_N";
     case OP_GET_LOCAL:
         return "GET_LOCAL";
     case OP_SET_LOCAL:
@@ -91,12 +117,18 @@ const char* opcode_name(opcode op) {
         return "SET_GLOBAL";
     case OP_DEFINE_GLOBAL:
         return "DEFINE_GLOBAL";
+    case OP_APPEND_LOCAL:
+        return "APPEND_LOCAL";
+    case OP_APPEND_GLOBAL:
+        return "APPEND_GLOBAL";
     case OP_GET_PROPERTY:
         return "GET_PROPERTY";
     case OP_SET_PROPERTY:
         return "SET_PROPERTY";
     case OP_BUILD_ARRAY:
         return "BUILD_ARRAY";
+    case OP_GET_INDEX:
+        return "GET_INDEX";
     case OP_SET_INDEX:
         return "SET_INDEX";
     case OP_BUILD_OBJECT:
@@ -105,10 +137,24 @@ const char* opcode_name(opcode op) {
         return "BUILD_RANGE";
     case OP_CLOSURE:
         return "CLOSURE";
+    case OP_CLOSURE_LOCAL:
+        return "CLOSURE_LOCAL";
+    case OP_RELEASE_LOCAL_CLOSURES:
+        return "RELEASE_LOCAL_CLOSURES";
     case OP_CALL:
         return "CALL";
+    case OP_CALL_METHOD:
+        return "CALL_METHOD";
     case OP_RETURN:
         return "RETURN";
+    case OP_YIELD:
+        return "YIELD";
+    case OP_GET_UPVALUE:
+        return "GET_UPVALUE";
+    case OP_SET_UPVALUE:
+        return "SET_UPVALUE";
+    case OP_MATCH_SWITCH:
+        return "MATCH_SWITCH";
     case OP_JUMP:
         return "JUMP";
     case OP_JUMP_IF_FALSE:
@@ -125,6 +171,10 @@ const char* opcode_name(opcode op) {
         return "SET_DEBUG_LOCATION";
     case OP_CLEAR_DEBUG_LOCATION:
         return "CLEAR_DEBUG_LOCATION";
+    case OP_IMPORT_MODULE:
+        return "IMPORT_MODULE";
+    case OP_GET_EXPORT:
+        return "GET_EXPORT";
     case OP_CALL_ADT_BASE_CLASS:
         return "CALL_ADT_BASE_CLASS";
     case OP_CREATE_ADT_CONSTRUCTOR:
@@ -134,4 +184,62 @@ const char* opcode_name(opcode op) {
     default:
         return "UNKNOWN";
     }
-}
\ No newline at end of file
+}
+// Size in bytes of the instruction at `offset`, or 0 if it runs past the end of the bytecode
+size_t instruction_length(const uint8_t* bytecode, size_t offset, size_t length) {
+    size_t size;
+    switch ((opcode)bytecode[offset]) {
+    case OP_GET_LOCAL:
+    case OP_SET_LOCAL:
+    case OP_GET_UPVALUE:
+    case OP_SET_UPVALUE:
+    case OP_POP_N:
+    case OP_APPEND_LOCAL:
+        size = 2;
+        break;
+    case OP_PUSH_CONSTANT:
+    case OP_GET_GLOBAL:
+    case OP_SET_GLOBAL:
+    case OP_APPEND_GLOBAL:
+    case OP_BUILD_ARRAY:
+    case OP_CONCAT_N:
+    case OP_BUILD_OBJECT:
+    case OP_BUILD_RANGE:
+    case OP_CALL:
+    case OP_CALL_METHOD:
+    case OP_CLOSURE:
+    case OP_CLOSURE_LOCAL:
+    case OP_RELEASE_LOCAL_CLOSURES:
+    case OP_CREATE_ADT_CONSTRUCTOR:
+    case OP_POP_N_PRESERVE_TOP:
+    case OP_JUMP:
+    case OP_JUMP_IF_FALSE:
+    case OP_JUMP_IF_TRUE:
+    case OP_LOOP:
+        size = 3;
+        break;
+    case OP_DEFINE_GLOBAL:
+        size = 4;
+        break;
+    case OP_SET_DEBUG_LOCATION:
+        size = 5;
+        break;
+    case OP_MATCH_SWITCH: {
+        if (offset + 10 > length) return 0;
+        uint16_t count = bytecode[offset + 8] | (bytecode[offset + 9] << 8);
+        size = 10 + (size_t)count * (bytecode[offset + 1] == MATCH_SWITCH_INT32 ? 2 : 8);
+        break;
+    }
+    case OP_IMPORT_MODULE: {
+        // u16 path, then 0xFF (wildcard) or 0xFE (namespace) plus one byte, or a specifier count
+        if (offset + 4 > length) return 0;
+        uint8_t flags = bytecode[offset + 3];
+        size = (flags == 0xFF || flags == 0xFE) ? 5 : 4 + (size_t)flags * 2;
+        break;
+    }
+    default:
+        size = 1;
+        break;
+    }
+    return offset + size <= length ? size : 0;
+}
@@ -0,0 +1,440 @@
+#include "parallel.h"
+#include "builtins.h"
+#include "isolate.h"
+#include "module.h"
+#include "../opcodes/opcodes.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Builtins a kernel may call: no side effects, and plain values in give plain values out
+static const native_t pure_builtins[] = {
+    builtin_abs, builtin_sqrt, builtin_floor, builtin_ceil, builtin_round, builtin_min, builtin_max,
+    builtin_sin, builtin_cos, builtin_tan, builtin_asin, builtin_acos, builtin_atan, builtin_atan2,
+    builtin_degrees, builtin_radians, builtin_exp, builtin_ln, builtin_sign,
+};
+
+typedef struct {
+    const char* name;
+    value_t value; // Plain value, string or pure builtin, as the calling VM resolved it
+} kernel_global;
+
+struct parallel_kernel {
+    function_t* function; // The caller's: read-only while workers copy it
+    const value_t* upvalues;
+    size_t upvalue_count;
+    kernel_global* globals;
+    size_t global_count;
+};
+
+typedef enum { CHUNK_MAP, CHUNK_TEST, CHUNK_FOLD } chunk_kind;
+
+typedef struct {
+    const parallel_kernel* kernel;
+    chunk_kind kind;
+    const value_t* in;
+    size_t begin;
+    size_t end;
+    value_t* out; // CHUNK_MAP: indexed like in
+    bool* keep; // CHUNK_TEST: indexed like in
+    value_t folded; // CHUNK_FOLD
+    closure_t* closure; // The worker's copy of the callback
+} parallel_chunk;
+
+// === Values that can cross threads ===
+
+static bool is_plain(value_t value) {
+    switch (value.type) {
+    case VAL_NULL:
+    case VAL_UNDEFINED:
+    case VAL_BOOLEAN:
+    case VAL_INT32:
+    case VAL_FLOAT32:
+    case VAL_FLOAT64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool is_pure_builtin(value_t value) {
+    if (value.type != VAL_NATIVE) return false;
+    for (size_t i = 0; i < sizeof(pure_builtins) / sizeof(pure_builtins[0]); i++) {
+        if ((native_t)value.as.native == pure_builtins[i]) return true;
+    }
+    return false;
+}
+
+static bool is_copyable(value_t value) {
+    return is_plain(value) || value.type == VAL_STRING || is_pure_builtin(value);
+}
+
+// Rebuild a value on the current thread, so it refers to this thread's classes and owns any storage
+static value_t copy_value(value_t value) {
+    switch (value.type) {
+    case VAL_BOOLEAN:
+        return make_boolean(value.as.boolean);
+    case VAL_INT32:
+        return make_int32(value.as.int32);
+    case VAL_FLOAT32:
+        return make_float32(value.as.float32);
+    case VAL_FLOAT64:
+        return make_float64(value.as.float64);
+    case VAL_STRING:
+        return make_string_ds(ds_create_length(value.as.string, ds_length(value.as.string)));
+    case VAL_NATIVE:
+        return make_native((native_t)value.as.native);
+    case VAL_UNDEFINED:
+        return make_undefined();
+    case VAL_NULL:
+    default:
+        return make_null();
+    }
+}
+
+// === Verification ===
+
+static bool is_parameter(function_t* function, const char* name) {
+    for (size_t i = 0; i < function->parameter_count; i++) {
+        if (strcmp(function->parameter_names[i], name) == 0) return true;
+    }
+    return false;
+}
+
+// Resolve a global the way OP_GET_GLOBAL would in the caller and remember its current value
+static bool capture_global(parallel_kernel* kernel, vm_t* vm, closure_t* closure, const char* name) {
+    if (is_parameter(kernel->function, name)) return true; // OP_GET_GLOBAL reads parameters first
+    for (size_t i = 0; i < kernel->global_count; i++) {
+        if (strcmp(kernel->globals[i].name, name) == 0) return true;
+    }
+
+    value_t* value = NULL;
+    if (closure && closure->module) {
+        value = (value_t*)do_get(closure->module->namespace, name);
+    }
+    if (!value) {
+        value = (value_t*)do_get(vm->globals, name);
+    }
+    if (!value || !is_copyable(*value)) return false;
+
+    kernel_global* globals = realloc(kernel->globals, sizeof(kernel_global) * (kernel->global_count + 1));
+    if (!globals) return false;
+    kernel->globals = globals;
+    kernel->globals[kernel->global_count].name = name;
+    kernel->globals[kernel->global_count].value = *value;
+    kernel->global_count++;
+    return true;
+}
+
+static bool verify_bytecode(parallel_kernel* kernel, vm_t* vm, closure_t* closure) {
+    function_t* function = kernel->function;
+    const uint8_t* code = function->bytecode;
+
+    for (size_t offset = 0; offset < function->bytecode_length;) {
+        size_t size = instruction_length(code, offset, function->bytecode_length);
+        if (size == 0) return false;
+
+        switch ((opcode)code[offset]) {
+        case OP_GET_GLOBAL: {
+            uint16_t index = code[offset + 1] | (code[offset + 2] << 8);
+            if (index >= function->constant_count || function->constants[index].type != VAL_STRING ||
+                !capture_global(kernel, vm, closure, function->constants[index].as.string)) {
+                return false;
+            }
+            break;
+        }
+        case OP_GET_UPVALUE:
+            if (code[offset + 1] >= kernel->upvalue_count) return false;
+            break;
+
+        // Stack, local and control flow
+        case OP_PUSH_CONSTANT:
+        case OP_PUSH_NULL:
+        case OP_PUSH_UNDEFINED:
+        case OP_PUSH_TRUE:
+        case OP_PUSH_FALSE:
+        case OP_POP:
+        case OP_DUP:
+        case OP_SWAP:
+        case OP_NIP:
+        case OP_ROT:
+        case OP_OVER:
+        case OP_POP_N:
+        case OP_POP_N_PRESERVE_TOP:
+        case OP_GET_LOCAL:
+        case OP_SET_LOCAL:
+        case OP_JUMP:
+        case OP_JUMP_IF_FALSE:
+        case OP_JUMP_IF_TRUE:
+        case OP_LOOP:
+        case OP_MATCH_SWITCH:
+        case OP_RETURN:
+        case OP_SET_DEBUG_LOCATION:
+        case OP_CLEAR_DEBUG_LOCATION:
+        // Operators (only ever see plain values and strings here)
+        case OP_ADD:
+        case OP_SUBTRACT:
+        case OP_MULTIPLY:
+        case OP_DIVIDE:
+        case OP_MOD:
+        case OP_POWER:
+        case OP_NEGATE:
+        case OP_FLOOR_DIV:
+        case OP_INCREMENT:
+        case OP_DECREMENT:
+        case OP_EQUAL:
+        case OP_NOT_EQUAL:
+        case OP_LESS:
+        case OP_LESS_EQUAL:
+        case OP_GREATER:
+        case OP_GREATER_EQUAL:
+        case OP_NOT:
+        case OP_NULL_COALESCE:
+        case OP_BITWISE_AND:
+        case OP_BITWISE_OR:
+        case OP_BITWISE_XOR:
+        case OP_BITWISE_NOT:
+        case OP_LEFT_SHIFT:
+        case OP_RIGHT_SHIFT:
+        case OP_LOGICAL_RIGHT_SHIFT:
+        case OP_ADD_INT:
+        case OP_SUBTRACT_INT:
+        case OP_MULTIPLY_INT:
+        case OP_LESS_INT:
+        case OP_LESS_EQUAL_INT:
+        case OP_GREATER_INT:
+        case OP_GREATER_EQUAL_INT:
+        case OP_ADD_FLOAT:
+        case OP_SUBTRACT_FLOAT:
+        case OP_MULTIPLY_FLOAT:
+        case OP_DIVIDE_FLOAT:
+        case OP_CONCAT_STRING:
+        case OP_CONCAT_N:
+        // Callees can only come from globals, which were checked to be pure builtins. One-argument
+        // calls compile to OP_GET_INDEX, which on a string indexes it instead.
+        case OP_CALL:
+        case OP_GET_INDEX:
+            break;
+
+        default:
+            return false;
+        }
+        offset += size;
+    }
+    return true;
+}
+
+parallel_kernel* parallel_kernel_create(vm_t* vm, value_t callable, size_t max_params) {
+    closure_t* closure = NULL;
+    function_t* function;
+    if (callable.type == VAL_CLOSURE) {
+        closure = callable.as.closure;
+        function = closure->function;
+    } else if (callable.type == VAL_FUNCTION) {
+        function = callable.as.function;
+    } else {
+        return NULL;
+    }
+    if (function->parameter_count > max_params) return NULL;
+
+    for (size_t i = 0; i < function->constant_count; i++) {
+        if (!is_plain(function->constants[i]) && function->constants[i].type != VAL_STRING) return NULL;
+    }
+    if (closure) {
+        for (size_t i = 0; i < closure->upvalue_count; i++) {
+            if (!is_plain(closure->upvalues[i]) && closure->upvalues[i].type != VAL_STRING) return NULL;
+        }
+    }
+
+    parallel_kernel* kernel = calloc(1, sizeof(parallel_kernel));
+    if (!kernel) return NULL;
+    kernel->function = function;
+    kernel->upvalues = closure ? closure->upvalues : NULL;
+    kernel->upvalue_count = closure ? closure->upvalue_count : 0;
+    if (!verify_bytecode(kernel, vm, closure)) {
+        parallel_kernel_destroy(kernel);
+        return NULL;
+    }
+    return kernel;
+}
+
+void parallel_kernel_destroy(parallel_kernel* kernel) {
+    if (!kernel) return;
+    free(kernel->globals);
+    free(kernel);
+}
+
+// === Workers ===
+
+static size_t thread_count = 1;
+static isolate_pool* pool = NULL;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+static void start_pool(void) {
+    const char* env = getenv("SLATE_THREADS");
+    long threads = env ? strtol(env, NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    thread_count = threads > 0 ? (size_t)threads : 1;
+    if (thread_count > 1) {
+        pool = isolate_pool_create(thread_count); // Lives until exit
+        if (!pool) thread_count = 1;
+    }
+}
+
+size_t parallel_thread_count(void) {
+    pthread_once(&pool_once, start_pool);
+    return thread_count;
+}
+
+// The worker's own copy of the callback: bytecode and constants copied, globals installed
+static closure_t* instantiate(vm_t* vm, const parallel_kernel* kernel) {
+    const function_t* source = kernel->function;
+    function_t* function = function_create(source->name);
+    if (!function) return NULL;
+
+    function->bytecode = malloc(source->bytecode_length);
+    memcpy(function->bytecode, source->bytecode, source->bytecode_length);
+    function->bytecode_length = source->bytecode_length;
+    if (source->constant_count > 0) {
+        function->constants = malloc(sizeof(value_t) * source->constant_count);
+        for (size_t i = 0; i < source->constant_count; i++) {
+            function->constants[i] = copy_value(source->constants[i]);
+        }
+        function->constant_count = source->constant_count;
+    }
+    if (source->parameter_count > 0) {
+        function->parameter_names = malloc(sizeof(char*) * source->parameter_count);
+        for (size_t i = 0; i < source->parameter_count; i++) {
+            function->parameter_names[i] = strdup(source->parameter_names[i]);
+        }
+        function->parameter_count = source->parameter_count;
+    }
+    function->local_count = source->local_count; // Any compiled body stays with the caller: run the bytecode
+
+    closure_t* closure = closure_create(function);
+    if (kernel->upvalue_count > 0) {
+        closure->upvalues = malloc(sizeof(value_t) * kernel->upvalue_count);
+        for (size_t i = 0; i < kernel->upvalue_count; i++) {
+            closure->upvalues[i] = copy_value(kernel->upvalues[i]);
+        }
+        closure->upvalue_count = kernel->upvalue_count;
+    }
+
+    for (size_t i = 0; i < kernel->global_count; i++) {
+        value_t value = copy_value(kernel->globals[i].value);
+        do_set(vm->globals, kernel->globals[i].name, &value, sizeof(value_t));
+    }
+    return closure;
+}
+
+static vm_result run_chunk(vm_t* vm, void* context) {
+    parallel_chunk* chunk = context;
+    vm->context = CTX_TEST; // Stay silent on errors: the caller reruns sequentially and reports them
+
+    // An error unwinds out of the callback with the VM still on the closure's constants, which
+    // the caller frees: give the VM its own back before vm_destroy frees them too
+    value_t* constants = vm->constants;
+    size_t constant_count = vm->constant_count;
+    if (setjmp(vm->trap) != 0) {
+        vm->constants = constants;
+        vm->constant_count = constant_count;
+        return VM_RUNTIME_ERROR;
+    }
+
+    chunk->closure = instantiate(vm, chunk->kernel);
+    if (!chunk->closure) return VM_RUNTIME_ERROR;
+    value_t callable = make_closure(chunk->closure);
+
+    if (chunk->kind == CHUNK_FOLD) {
+        value_t acc = copy_value(chunk->in[chunk->begin]);
+        for (size_t i = chunk->begin + 1; i < chunk->end; i++) {
+            value_t args[2] = {acc, copy_value(chunk->in[i])};
+            acc = vm_call_slate_function_safe(vm, callable, 2, args);
+            if (!is_plain(acc)) return VM_RUNTIME_ERROR;
+        }
+        chunk->folded = acc;
+        return VM_OK;
+    }
+
+    for (size_t i = chunk->begin; i < chunk->end; i++) {
+        value_t args[2] = {copy_value(chunk->in[i]), make_int32((int32_t)i)};
+        value_t result = vm_call_slate_function_safe(vm, callable, 2, args);
+        if (chunk->kind == CHUNK_TEST) {
+            chunk->keep[i] = is_truthy(result);
+            vm_release(result);
+        } else if (is_plain(result)) {
+            chunk->out[i] = result;
+        } else {
+            vm_release(result);
+            return VM_RUNTIME_ERROR;
+        }
+    }
+    return VM_OK;
+}
+
+// closure_destroy frees the function copy but not the captured values, which the copy owns
+static void discard_closure(closure_t* closure) {
+    if (!closure) return;
+    for (size_t i = 0; i < closure->upvalue_count; i++) {
+        free_value(closure->upvalues[i]);
+    }
+    closure_destroy(closure);
+}
+
+// Split [0, count) across the pool and wait for every chunk. Returns the chunk count, 0 on failure.
+static size_t run_chunks(parallel_kernel* kernel, chunk_kind kind, const value_t* in, size_t count,
+                         value_t* out, bool* keep, value_t* partials) {
+    size_t threads = parallel_thread_count();
+    if (!kernel || threads < 2 || count < PARALLEL_MIN_ELEMENTS || count > INT32_MAX) return 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!is_plain(in[i])) return 0;
+    }
+
+    parallel_chunk* chunks = calloc(threads, sizeof(parallel_chunk));
+    isolate** isolates = calloc(threads, sizeof(isolate*));
+    if (!chunks || !isolates) {
+        free(chunks);
+        free(isolates);
+        return 0;
+    }
+    for (size_t c = 0; c < threads; c++) {
+        chunks[c] = (parallel_chunk){kernel, kind, in, count * c / threads, count * (c + 1) / threads, out, keep};
+        isolates[c] = isolate_spawn_call(pool, run_chunk, &chunks[c]);
+    }
+
+    bool ok = true;
+    for (size_t c = 0; c < threads; c++) {
+        if (!isolates[c] || isolate_join(isolates[c], NULL) != VM_OK) ok = false;
+        discard_closure(chunks[c].closure);
+        if (kind == CHUNK_FOLD) partials[c] = chunks[c].folded;
+    }
+    free(chunks);
+    free(isolates);
+    return ok ? threads : 0;
+}
+
+// Results were made on worker threads: give them this thread's classes
+static void adopt_results(value_t* values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        values[i] = copy_value(values[i]);
+    }
+}
+
+bool parallel_map(vm_t* vm, parallel_kernel* kernel, const value_t* in, size_t count, value_t* out) {
+    (void)vm;
+    if (run_chunks(kernel, CHUNK_MAP, in, count, out, NULL, NULL) == 0) return false;
+    adopt_results(out, count);
+    return true;
+}
+
+bool parallel_test(vm_t* vm, parallel_kernel* kernel, const value_t* in, size_t count, bool* keep) {
+    (void)vm;
+    return run_chunks(kernel, CHUNK_TEST, in, count, NULL, keep, NULL) > 0;
+}
+
+size_t parallel_fold(vm_t* vm, parallel_kernel* kernel, const value_t* in, size_t count, value_t* partials) {
+    (void)vm;
+    size_t chunk_count = run_chunks(kernel, CHUNK_FOLD, in, count, NULL, NULL, partials);
+    adopt_results(partials, chunk_count);
+    return chunk_count;
+}
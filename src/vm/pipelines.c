@@ -0,0 +1,309 @@
+#include "vm.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// Lazy iterator adapters.
+//
+// it.map(f).filter(g).take(3) builds one pipeline: the source iterator plus the stages
+// [map f, filter g, take 3]. Pulling an element asks the last stage, which pulls from the stage
+// before it and so on down to the source, so each element makes a single pass through every
+// stage and is only retained by whoever holds it right now. Stages that end early (take, zip)
+// stop pulling, so infinite sources such as generators are fine.
+//
+// Adding a stage to a pipeline nothing has been pulled from yet copies its stages into the new
+// one rather than wrapping it, which keeps chains flat. Like any adapter, chaining consumes the
+// receiver: keep using the iterator it returns.
+
+// Pooled closures (OP_CLOSURE_LOCAL) only live as long as the call they were passed to
+static int stage_keep_fn(pipeline_stage* stage, value_t fn) {
+    stage->owns_fn = 0;
+    if (fn.type == VAL_CLOSURE && fn.as.closure->is_local) {
+        closure_t* promoted = closure_promote(fn.as.closure);
+        if (!promoted) {
+            return 0;
+        }
+        fn.as.closure = promoted;
+        stage->owns_fn = 1;
+    }
+    stage->fn = vm_retain(fn);
+    return 1;
+}
+
+static void stage_release(pipeline_stage* stage) {
+    if (stage->owns_fn) {
+        closure_free_promoted(stage->fn.as.closure);
+    } else {
+        vm_release(stage->fn);
+    }
+    iterator_release(stage->other);
+}
+
+static void free_stages(pipeline_stage* stages, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        stage_release(&stages[i]);
+    }
+    free(stages);
+}
+
+iterator_t* iterator_pipeline_create(vm_t* vm, iterator_t* upstream, pipeline_stage stage) {
+    iterator_pipeline* base = upstream->type == ITER_PIPELINE && !upstream->data.pipeline->pulled
+        ? upstream->data.pipeline : NULL;
+    size_t count = (base ? base->stage_count : 0) + 1;
+
+    iterator_t* iter = malloc(sizeof(iterator_t));
+    iterator_pipeline* pipeline = malloc(sizeof(iterator_pipeline));
+    pipeline_stage* stages = malloc(sizeof(pipeline_stage) * count);
+    value_t fn = stage.fn;
+    if (!iter || !pipeline || !stages || !stage_keep_fn(&stage, fn)) {
+        free(iter);
+        free(pipeline);
+        free(stages);
+        iterator_release(stage.other);
+        return NULL;
+    }
+
+    size_t copied = 0;
+    if (base) {
+        for (; copied < base->stage_count; copied++) {
+            stages[copied] = base->stages[copied];
+            if (!stage_keep_fn(&stages[copied], base->stages[copied].fn)) {
+                break;
+            }
+            iterator_retain(stages[copied].other);
+        }
+        if (copied < base->stage_count) {
+            free_stages(stages, copied);
+            stage_release(&stage);
+            free(iter);
+            free(pipeline);
+            return NULL;
+        }
+    }
+    stages[copied] = stage;
+
+    pipeline->vm = vm;
+    pipeline->source = iterator_retain(base ? base->source : upstream);
+    pipeline->stages = stages;
+    pipeline->stage_count = count;
+    pipeline->pending = make_null();
+    pipeline->has_pending = 0;
+    pipeline->pulled = 0;
+    pipeline->done = 0;
+
+    iter->ref_count = 1;
+    iter->type = ITER_PIPELINE;
+    iter->data.pipeline = pipeline;
+    return iter;
+}
+
+static value_t stage_call(iterator_pipeline* pipeline, pipeline_stage* stage, value_t element) {
+    value_t result = vm_call_slate_function_safe(pipeline->vm, stage->fn, 1, &element);
+    vm_release(element);
+    return result;
+}
+
+static value_t make_pair(value_t first, value_t second) {
+    da_array pair = da_new(sizeof(value_t));
+    da_push(pair, &first);
+    da_push(pair, &second);
+    return make_array(pair);
+}
+
+// Next element out of stage n (0 is the source itself). 0 when there are no more.
+static int pipeline_pull(iterator_pipeline* pipeline, size_t n, value_t* out) {
+    if (n == 0) {
+        if (!iterator_has_next(pipeline->source)) {
+            return 0;
+        }
+        *out = iterator_next(pipeline->source);
+        return 1;
+    }
+
+    pipeline_stage* stage = &pipeline->stages[n - 1];
+    value_t element;
+    switch (stage->kind) {
+    case STAGE_MAP:
+        if (!pipeline_pull(pipeline, n - 1, &element)) {
+            return 0;
+        }
+        *out = stage_call(pipeline, stage, element);
+        return 1;
+    case STAGE_FILTER:
+        while (pipeline_pull(pipeline, n - 1, &element)) {
+            value_t keep = vm_call_slate_function_safe(pipeline->vm, stage->fn, 1, &element);
+            int truthy = is_truthy(keep);
+            vm_release(keep);
+            if (truthy) {
+                *out = element;
+                return 1;
+            }
+            vm_release(element);
+        }
+        return 0;
+    case STAGE_FLAT_MAP:
+        for (;;) {
+            if (stage->other) {
+                if (iterator_has_next(stage->other)) {
+                    *out = iterator_next(stage->other);
+                    return 1;
+                }
+                iterator_release(stage->other);
+                stage->other = NULL;
+            }
+            if (!pipeline_pull(pipeline, n - 1, &element)) {
+                return 0;
+            }
+            value_t mapped = stage_call(pipeline, stage, element);
+            stage->other = iterator_for_value(mapped);
+            if (!stage->other) {
+                *out = mapped; // Not a collection: it's the element
+                return 1;
+            }
+            vm_release(mapped);
+        }
+    case STAGE_TAKE:
+        if (stage->count == 0) {
+            return 0;
+        }
+        if (!pipeline_pull(pipeline, n - 1, out)) {
+            stage->count = 0;
+            return 0;
+        }
+        stage->count--;
+        return 1;
+    case STAGE_SKIP:
+        for (; stage->count > 0; stage->count--) {
+            if (!pipeline_pull(pipeline, n - 1, &element)) {
+                return 0;
+            }
+            vm_release(element);
+        }
+        return pipeline_pull(pipeline, n - 1, out);
+    case STAGE_ENUMERATE:
+        if (!pipeline_pull(pipeline, n - 1, &element)) {
+            return 0;
+        }
+        *out = make_pair(make_int32((int32_t)stage->count++), element);
+        return 1;
+    case STAGE_ZIP:
+        // Check the other side first so no element is pulled from this one only to be dropped
+        if (!iterator_has_next(stage->other) || !pipeline_pull(pipeline, n - 1, &element)) {
+            return 0;
+        }
+        *out = make_pair(element, iterator_next(stage->other));
+        return 1;
+    }
+    return 0;
+}
+
+int pipeline_has_next(iterator_pipeline* pipeline) {
+    if (!pipeline->has_pending && !pipeline->done) {
+        pipeline->pulled = 1;
+        pipeline->has_pending = pipeline_pull(pipeline, pipeline->stage_count, &pipeline->pending);
+        pipeline->done = !pipeline->has_pending;
+    }
+    return pipeline->has_pending;
+}
+
+value_t pipeline_next(iterator_pipeline* pipeline) {
+    if (!pipeline_has_next(pipeline)) {
+        return make_null();
+    }
+    value_t element = pipeline->pending;
+    pipeline->pending = make_null();
+    pipeline->has_pending = 0;
+    return element;
+}
+
+void pipeline_destroy(iterator_pipeline* pipeline) {
+    if (!pipeline) {
+        return;
+    }
+    if (pipeline->has_pending) {
+        vm_release(pipeline->pending);
+    }
+    free_stages(pipeline->stages, pipeline->stage_count);
+    iterator_release(pipeline->source);
+    free(pipeline);
+}
+
+static size_t min_size(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+
+static int pipeline_size_hint(iterator_pipeline* pipeline, size_t* count) {
+    if (pipeline->done) {
+        *count = 0;
+        return 1;
+    }
+    size_t n;
+    int exact = iterator_size_hint(pipeline->source, &n);
+    for (size_t i = 0; i < pipeline->stage_count; i++) {
+        pipeline_stage* stage = &pipeline->stages[i];
+        switch (stage->kind) {
+        case STAGE_MAP:
+        case STAGE_ENUMERATE:
+            break;
+        case STAGE_FILTER:
+            exact = 0;
+            break;
+        case STAGE_FLAT_MAP:
+            exact = 0;
+            n = SIZE_MAX;
+            break;
+        case STAGE_TAKE:
+            n = min_size(n, stage->count);
+            break;
+        case STAGE_SKIP:
+            if (n != SIZE_MAX) {
+                n = n > stage->count ? n - stage->count : 0;
+            }
+            break;
+        case STAGE_ZIP: {
+            size_t other;
+            exact = iterator_size_hint(stage->other, &other) && exact;
+            n = min_size(n, other);
+            break;
+        }
+        }
+    }
+    if (pipeline->has_pending && n != SIZE_MAX) {
+        n++;
+    }
+    *count = n;
+    return exact;
+}
+
+int iterator_size_hint(iterator_t* iter, size_t* count) {
+    switch (iter->type) {
+    case ITER_ARRAY: {
+        size_t length = da_length(iter->data.array_iter.array);
+        *count = iter->data.array_iter.index < length ? length - iter->data.array_iter.index : 0;
+        return 1;
+    }
+    case ITER_RANGE: {
+        if (!iterator_has_next(iter) || iter->data.range_iter.step.type != VAL_INT32) {
+            *count = 0;
+            return 1;
+        }
+        int64_t current = iter->data.range_iter.current.as.int32;
+        int64_t end = iter->data.range_iter.end.as.int32;
+        int64_t step = iter->data.range_iter.step.as.int32;
+        int64_t span = iter->data.range_iter.reverse ? current - end : end - current;
+        step = step < 0 ? -step : step;
+        if (step == 0) {
+            *count = SIZE_MAX;
+            return 0;
+        }
+        int64_t steps = span / step;
+        *count = (size_t)(iter->data.range_iter.exclusive && span % step == 0 ? steps : steps + 1);
+        return 1;
+    }
+    case ITER_PIPELINE:
+        return pipeline_size_hint(iter->data.pipeline, count);
+    case ITER_GENERATOR:
+    default:
+        *count = SIZE_MAX;
+        return 0;
+    }
+}
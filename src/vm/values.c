@@ -5,6 +5,10 @@
 #include "datetime.h"
 #include "date.h"
 #include "instant.h"
+#include "../classes/ADT/adt_methods.h"
+#include "../classes/TypedArray/typed_array.h"
+#include "../classes/Map/map.h"
+#include "../classes/Number/number_format.h"
 
 // Value creation functions with debug info
 
@@ -85,9 +89,8 @@ static ds_string value_to_builtin_string(vm_t* vm, value_t value) {
     case VAL_STRING:
         return ds_retain(value.as.string);
     case VAL_INT32: {
-        char buffer[32];
-        snprintf(buffer, sizeof(buffer), "%d", value.as.int32);
-        return ds_new(buffer);
+        char buffer[NF_MAX_LENGTH];
+        return ds_create_length(buffer, nf_format_int32(buffer, value.as.int32));
     }
     case VAL_BIGINT: {
         char* str = di_to_string(value.as.bigint, 10);
@@ -100,28 +103,12 @@ static ds_string value_to_builtin_string(vm_t* vm, value_t value) {
         }
     }
     case VAL_FLOAT32: {
-        float val = value.as.float32;
-        if (isnan(val)) {
-            return ds_new("NaN");
-        } else if (isinf(val)) {
-            return ds_new(val > 0 ? "Infinity" : "-Infinity");
-        } else {
-            char buffer[32];
-            snprintf(buffer, sizeof(buffer), "%.7g", val);
-            return ds_new(buffer);
-        }
+        char buffer[NF_MAX_LENGTH];
+        return ds_create_length(buffer, nf_format_float32(buffer, value.as.float32));
     }
     case VAL_FLOAT64: {
-        double val = value.as.float64;
-        if (isnan(val)) {
-            return ds_new("NaN");
-        } else if (isinf(val)) {
-            return ds_new(val > 0 ? "Infinity" : "-Infinity");
-        } else {
-            char buffer[32];
-            snprintf(buffer, sizeof(buffer), "%.6g", val);
-            return ds_new(buffer);
-        }
+        char buffer[NF_MAX_LENGTH];
+        return ds_create_length(buffer, nf_format_float64(buffer, value.as.float64));
     }
     case VAL_BOOLEAN:
         return ds_new(value.as.boolean ? "true" : "false");
@@ -222,6 +209,10 @@ static ds_string value_to_builtin_string(vm_t* vm, value_t value) {
             return ds_new("{Array Iterator}");
         } else if (value.as.iterator->type == ITER_RANGE) {
             return ds_new("{Range Iterator}");
+        } else if (value.as.iterator->type == ITER_GENERATOR) {
+            return ds_new("{Generator Iterator}");
+        } else if (value.as.iterator->type == ITER_PIPELINE) {
+            return ds_new("{Pipeline Iterator}");
         } else {
             return ds_new("{Unknown Iterator}");
         }
@@ -299,6 +290,35 @@ static ds_string value_to_builtin_string(vm_t* vm, value_t value) {
         return ds_new("<Duration>");  // TODO: implement string conversion
     case VAL_PERIOD:
         return ds_new("<Period>");  // TODO: implement string conversion
+    case VAL_PROMISE: {
+        if (!value.as.promise) {
+            return ds_new("{null promise}");
+        }
+        if (value.as.promise->state == PROMISE_PENDING) {
+            return ds_new("{Promise pending}");
+        }
+        ds_string inner = display_value_to_string(vm, value.as.promise->value);
+        ds_string prefix = ds_new(value.as.promise->state == PROMISE_FULFILLED ? "{Promise fulfilled: " : "{Promise rejected: ");
+        ds_string suffix = ds_new("}");
+        ds_string temp = ds_concat(prefix, inner);
+        ds_string result = ds_concat(temp, suffix);
+        ds_release(&prefix);
+        ds_release(&inner);
+        ds_release(&suffix);
+        ds_release(&temp);
+        return result;
+    }
+    case VAL_TYPED_ARRAY:
+        return typed_array_to_display_string(vm, value.as.typed_array);
+    case VAL_MAP:
+    case VAL_SET:
+        return map_to_display_string(vm, value);
+    case VAL_ADT: {
+        value_t str_result = adt_instance_toString(vm, 1, &value);
+        ds_string result = ds_retain(str_result.as.string);
+        vm_release(str_result);
+        return result;
+    }
     default:
         return ds_new("{Unknown}");
     }
@@ -0,0 +1,21 @@
+# Runs a script with the interpreter and its ahead-of-time compiled executable and fails
+# unless both print the same output.
+#   cmake -DSLATE=<slate> -DPROGRAM=<compiled program> -DSCRIPT=<script.sl> -P aot_compare.cmake
+
+execute_process(COMMAND ${SLATE} ${SCRIPT}
+        OUTPUT_VARIABLE expected
+        ERROR_VARIABLE expected_errors
+        RESULT_VARIABLE expected_status)
+execute_process(COMMAND ${PROGRAM}
+        OUTPUT_VARIABLE actual
+        ERROR_VARIABLE actual_errors
+        RESULT_VARIABLE actual_status)
+
+if (NOT expected STREQUAL actual OR NOT expected_errors STREQUAL actual_errors)
+    message(FATAL_ERROR "Output of ${PROGRAM} differs from the interpreter\n"
+            "--- interpreted ---\n${expected}${expected_errors}\n"
+            "--- compiled ---\n${actual}${actual_errors}")
+endif ()
+if (NOT expected_status STREQUAL actual_status)
+    message(FATAL_ERROR "Exit status ${actual_status} differs from the interpreter's ${expected_status}")
+endif ()
@@ -816,6 +816,95 @@ void test_bigint_multiplication_preserves_type(void) {
     }
 }
 
+// Locals with inferred types compile to specialized opcodes that keep the generic semantics
+void test_inferred_local_types() {
+    const char* source =
+        "def f(n) =\n"
+        "    var total = 0\n"
+        "    var i = 0\n"
+        "    var scale = 1.5\n"
+        "    var label = \"n\"\n"
+        "    var mixed = 1\n"
+        "    while i < n\n"
+        "        total += i\n"
+        "        i = i + 1\n"
+        "        scale = scale * 2.0\n"
+        "        label = label + \"!\"\n"
+        "    label = label + \"?\"\n"
+        "    mixed = \"text\"\n"
+        "    total\n"
+        "f(3)";
+
+    lexer_t lexer;
+    lexer_init(&lexer, source);
+    parser_t parser;
+    parser_init(&parser, &lexer);
+    ast_program* program = parse_program(&parser);
+    TEST_ASSERT_FALSE(parser.had_error);
+
+    vm_t* vm = vm_create();
+    codegen_t* codegen = codegen_create(vm);
+    function_t* main_function = codegen_compile(codegen, program);
+    TEST_ASSERT_FALSE(codegen->had_error);
+
+    function_t* f = vm_get_function(vm, 0);
+    TEST_ASSERT_EQUAL_STRING("total: Int, i: Int, scale: Float64, label: String", f->local_types);
+
+    int saw_add_int = 0, saw_less_int = 0, saw_multiply_float = 0, saw_concat = 0, saw_append = 0;
+    for (size_t offset = 0; offset < f->bytecode_length; offset++) {
+        saw_add_int |= f->bytecode[offset] == OP_ADD_INT;
+        saw_less_int |= f->bytecode[offset] == OP_LESS_INT;
+        saw_multiply_float |= f->bytecode[offset] == OP_MULTIPLY_FLOAT;
+        saw_concat |= f->bytecode[offset] == OP_CONCAT_STRING;
+        saw_append |= f->bytecode[offset] == OP_APPEND_LOCAL;
+    }
+    TEST_ASSERT_TRUE(saw_add_int);
+    TEST_ASSERT_FALSE(saw_less_int); // n is a parameter, so i < n stays generic
+    TEST_ASSERT_TRUE(saw_multiply_float);
+    TEST_ASSERT_TRUE(saw_concat);
+    TEST_ASSERT_TRUE(saw_append); // label = label + "!" in the loop grows label in place
+
+    function_destroy(main_function);
+    vm_destroy(vm);
+    codegen_destroy(codegen);
+    ast_free((ast_node*)program);
+    lexer_cleanup(&lexer);
+
+    // Int locals still promote to BigInt through the specialized opcodes
+    value_t result = execute_expression(
+        "def grow() =\n"
+        "    var x = 1\n"
+        "    var steps = 0\n"
+        "    while steps < 40\n"
+        "        x = x * 2\n"
+        "        steps += 1\n"
+        "    x\n"
+        "grow()");
+    TEST_ASSERT_EQUAL(VAL_BIGINT, result.type);
+    char* str = di_to_string(result.as.bigint, 10);
+    TEST_ASSERT_EQUAL_STRING("1099511627776", str);
+    free(str);
+    vm_release(result);
+
+    result = execute_expression(
+        "def halve() =\n"
+        "    var x = 10.0\n"
+        "    var y = 4.0\n"
+        "    x / y - 0.5\n"
+        "halve()");
+    TEST_ASSERT_EQUAL(VAL_FLOAT64, result.type);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, result.as.float64);
+
+    // Float64 division by zero is still an error
+    result = execute_expression_allow_errors(
+        "def broken() =\n"
+        "    var x = 1.0\n"
+        "    var zero = 0.0\n"
+        "    x / zero\n"
+        "broken()");
+    TEST_ASSERT_EQUAL_INT(VAL_NULL, result.type);
+}
+
 // Test suite function for integration with main test runner
 void test_arithmetic_suite(void) {
     RUN_TEST(test_basic_int32_arithmetic);
@@ -839,4 +928,5 @@ void test_arithmetic_suite(void) {
     RUN_TEST(test_division_by_zero_errors);
     RUN_TEST(test_modulo_by_zero_errors);
     RUN_TEST(test_bigint_multiplication_preserves_type);
+    RUN_TEST(test_inferred_local_types);
 }
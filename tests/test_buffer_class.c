@@ -66,6 +66,18 @@ void test_buffer_class_length_method(void) {
     vm_release(result);
 }
 
+// Test Buffer indexing: buf(i) returns the byte value
+void test_buffer_class_indexing(void) {
+    value_t result = test_execute_expression("Buffer(\"Hi\")(1)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL(105, result.as.int32);
+    vm_release(result);
+
+    result = test_execute_expression("Buffer(\"Hi\")(2)");
+    TEST_ASSERT_EQUAL(VAL_NULL, result.type);
+    vm_release(result);
+}
+
 // Test Buffer instance method: slice()
 void test_buffer_class_slice_method(void) {
     value_t result = test_execute_expression("Buffer(\"Hello World\").slice(6, 5).toString()");
@@ -283,6 +295,7 @@ void test_buffer_class_suite(void) {
     RUN_TEST(test_buffer_class_constructor_error_handling);
     RUN_TEST(test_buffer_class_from_hex);
     RUN_TEST(test_buffer_class_length_method);
+    RUN_TEST(test_buffer_class_indexing);
     RUN_TEST(test_buffer_class_slice_method);
     RUN_TEST(test_buffer_class_concat_method);
     RUN_TEST(test_buffer_class_to_hex_method);
@@ -320,6 +320,44 @@ void test_array_reverse(void) {
     vm_release(result);
 }
 
+// Test sort() and sorted() without a comparator
+void test_array_sort_default_order(void) {
+    test_expect_true("var a = [5, -3, 9, 0]\nvar same = a.sort()\nsame == a && a == [-3, 0, 5, 9]");
+    test_expect_true("[2.5, -1, 3, 0.5].sorted() == [-1, 0.5, 2.5, 3] && [10000000000, 3, 2.5].sorted() == [2.5, 3, 10000000000]");
+    test_expect_true("[\"pear\", \"apple\", \"fig\", \"app\"].sorted() == [\"app\", \"apple\", \"fig\", \"pear\"]");
+    test_expect_true("var a = [3, 1, 2]\nvar b = a.sorted()\na == [3, 1, 2] && b == [1, 2, 3] && [].sorted() == []");
+}
+
+// Test the radix path for large Int32 arrays against the comparator path
+void test_array_sort_large(void) {
+    test_expect_true(
+        "var a = []\n"
+        "var i = 0\n"
+        "while i < 5000\n"
+        "    a.push((i * 7919) % 3001 - 1500)\n"
+        "    i = i + 1\n"
+        "var expected = a.sorted((x, y) -> x - y)\n"
+        "var sorted = a.sort()\n"
+        "sorted == expected && a(0) == -1500 && a(4999) == 1500");
+}
+
+// Test sort() with a comparator and stable sortBy()
+void test_array_sort_comparator_and_key(void) {
+    test_expect_true("[3, 1, 2].sort((a, b) -> b - a) == [3, 2, 1]");
+    test_expect_true(
+        "var people = [{name: \"bo\", age: 30}, {name: \"al\", age: 25}, {name: \"cy\", age: 30}, {name: \"di\", age: 25}]\n"
+        "people.sortBy(p -> p.age).map(p -> p.name) == [\"al\", \"di\", \"bo\", \"cy\"]");
+    test_expect_true("[\"ccc\", \"a\", \"bb\"].sortBy(s -> s.length()) == [\"a\", \"bb\", \"ccc\"]");
+    // Equal keys keep their original order with a comparator too
+    test_expect_true("[[1, \"a\"], [0, \"b\"], [1, \"c\"], [0, \"d\"]].sort((x, y) -> x(0) - y(0)).map(p -> p(1)) == [\"b\", \"d\", \"a\", \"c\"]");
+}
+
+void test_array_sort_errors(void) {
+    TEST_ASSERT_TRUE(test_expect_error("[1, \"a\"].sort()", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("[1, 2].sort((a, b) -> \"x\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("[1, 2].sortBy(x -> null)", ERR_TYPE));
+}
+
 // Test Suite Runner
 // Test Array.hash() method
 void test_array_hash_basic(void) {
@@ -437,6 +475,39 @@ void test_array_equals_nested(void) {
     vm_release(result);
 }
 
+// indexOf/contains: typed scans for int/string needles plus mixed-type fallbacks
+void test_array_index_of_and_contains(void) {
+    value_t result = test_execute_expression("[5, 7, 9].indexOf(9)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(2, result.as.int32);
+    vm_release(result);
+
+    result = test_execute_expression("[1.5, \"a\", 2.0, 2].indexOf(2)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(2, result.as.int32);
+    vm_release(result);
+
+    result = test_execute_expression("[\"ab\", \"abc\", \"abd\"].indexOf(\"abd\")");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(2, result.as.int32);
+    vm_release(result);
+
+    result = test_execute_expression("[[1], null, true].indexOf(null)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(1, result.as.int32);
+    vm_release(result);
+
+    result = test_execute_expression("[1, 2, 3].contains(\"2\")");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_FALSE(result.as.boolean);
+    vm_release(result);
+
+    result = test_execute_expression("[[1, 2], [3]].contains([3])");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+    vm_release(result);
+}
+
 void test_array_method_equals_equality(void) {
     // Test the exact pattern requested: [1, 2, 3].equals([1, 2, 3]) == true
     value_t result = test_execute_expression("[1, 2, 3].equals([1, 2, 3]) == true");
@@ -474,6 +545,10 @@ void test_class_array_suite(void) {
     RUN_TEST(test_array_slice_negative_indices);
     RUN_TEST(test_array_slice_edge_cases);
     RUN_TEST(test_array_reverse);
+    RUN_TEST(test_array_sort_default_order);
+    RUN_TEST(test_array_sort_large);
+    RUN_TEST(test_array_sort_comparator_and_key);
+    RUN_TEST(test_array_sort_errors);
     
     // Array hash tests
     RUN_TEST(test_array_hash_basic);
@@ -489,5 +564,6 @@ void test_class_array_suite(void) {
     RUN_TEST(test_array_equals_empty);
     RUN_TEST(test_array_equals_cross_type);
     RUN_TEST(test_array_equals_nested);
+    RUN_TEST(test_array_index_of_and_contains);
     RUN_TEST(test_array_method_equals_equality);
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include "unity.h"
 #include "test_helpers.h"
+#include "number_format.h"
+#include "number_parse.h"
 #include <limits.h>
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 // Forward declarations
 void test_hexadecimal_literals(void);
@@ -262,6 +267,159 @@ void test_int_hash_equality_function(void) {
     vm_release(result);
 }
 
+static const char* formatted(size_t (*format)(char*, double), double value) {
+    static char buffer[NF_MAX_LENGTH + 1];
+    buffer[format(buffer, value)] = '\0';
+    return buffer;
+}
+
+static size_t format_int64_of(char* out, double value) { return nf_format_int64(out, (int64_t)value); }
+static size_t format_float32_of(char* out, double value) { return nf_format_float32(out, (float)value); }
+
+void test_number_format_integers(void) {
+    char buffer[NF_MAX_LENGTH + 1];
+    int32_t values[] = {0, 7, -7, 10, 99, 100, -1000, 123456789, INT32_MAX, INT32_MIN};
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        char expected[16];
+        snprintf(expected, sizeof(expected), "%d", values[i]);
+        buffer[nf_format_int32(buffer, values[i])] = '\0';
+        TEST_ASSERT_EQUAL_STRING(expected, buffer);
+    }
+    buffer[nf_format_int64(buffer, INT64_MIN)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-9223372036854775808", buffer);
+    buffer[nf_format_uint64(buffer, UINT64_MAX)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", buffer);
+    TEST_ASSERT_EQUAL_STRING("-4503599627370496", formatted(format_int64_of, -4503599627370496.0));
+}
+
+void test_number_format_shortest_floats(void) {
+    TEST_ASSERT_EQUAL_STRING("0.1", formatted(nf_format_float64, 0.1));
+    TEST_ASSERT_EQUAL_STRING("0.30000000000000004", formatted(nf_format_float64, 0.1 + 0.2));
+    TEST_ASSERT_EQUAL_STRING("100000000000000", formatted(nf_format_float64, 1e14));
+    TEST_ASSERT_EQUAL_STRING("1e+15", formatted(nf_format_float64, 1e15));
+    TEST_ASSERT_EQUAL_STRING("1.2345678901234568e+17", formatted(nf_format_float64, 123456789012345678.0));
+    TEST_ASSERT_EQUAL_STRING("0.0001", formatted(nf_format_float64, 1e-4));
+    TEST_ASSERT_EQUAL_STRING("1e-05", formatted(nf_format_float64, 1e-5));
+    TEST_ASSERT_EQUAL_STRING("5e-324", formatted(nf_format_float64, 5e-324));
+    TEST_ASSERT_EQUAL_STRING("1.7976931348623157e+308", formatted(nf_format_float64, 1.7976931348623157e308));
+    TEST_ASSERT_EQUAL_STRING("-0", formatted(nf_format_float64, -0.0));
+    TEST_ASSERT_EQUAL_STRING("-Infinity", formatted(nf_format_float64, -INFINITY));
+    TEST_ASSERT_EQUAL_STRING("NaN", formatted(nf_format_float64, NAN));
+
+    TEST_ASSERT_EQUAL_STRING("0.1", formatted(format_float32_of, 0.1));
+    TEST_ASSERT_EQUAL_STRING("1000000", formatted(format_float32_of, 1e6));
+    TEST_ASSERT_EQUAL_STRING("1e+07", formatted(format_float32_of, 1e7));
+    TEST_ASSERT_EQUAL_STRING("1.6777216e+07", formatted(format_float32_of, 16777216.0));
+    TEST_ASSERT_EQUAL_STRING("3.4028235e+38", formatted(format_float32_of, 3.4028235e38));
+    TEST_ASSERT_EQUAL_STRING("1e-45", formatted(format_float32_of, 1e-45));
+
+    // Random bit patterns read back as the same value
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    char buffer[NF_MAX_LENGTH + 1];
+    for (int i = 0; i < 100000; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double d;
+        float f;
+        uint32_t low = (uint32_t)state;
+        memcpy(&d, &state, sizeof(d));
+        memcpy(&f, &low, sizeof(f));
+        if (isfinite(d)) {
+            buffer[nf_format_float64(buffer, d)] = '\0';
+            TEST_ASSERT_TRUE_MESSAGE(strtod(buffer, NULL) == d, buffer);
+        }
+        if (isfinite(f)) {
+            buffer[nf_format_float32(buffer, f)] = '\0';
+            TEST_ASSERT_TRUE_MESSAGE(strtof(buffer, NULL) == f, buffer);
+        }
+    }
+}
+
+void test_number_to_string_uses_shortest_digits(void) {
+    // toString(), string concatenation, templates and StringBuilder.append() all agree
+    value_t result = test_execute_expression(
+        "var x = 0.1 + 0.2\n"
+        "var sb = StringBuilder()\n"
+        "sb.append(x).append(\",\").append(0.1f).append(\",\").append(-2147483647 - 1)\n"
+        "[x.toString(), \"\" + x, `$x`, sb.toString(), (1.0 / 3.0).toString(), 2.5e-7.toString()]");
+    TEST_ASSERT_EQUAL(VAL_ARRAY, result.type);
+    const char* expected[] = {"0.30000000000000004", "0.30000000000000004", "0.30000000000000004",
+                              "0.30000000000000004,0.1,-2147483648", "0.3333333333333333", "2.5e-07"};
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        value_t* element = (value_t*)da_get(result.as.array, i);
+        TEST_ASSERT_EQUAL(VAL_STRING, element->type);
+        TEST_ASSERT_EQUAL_STRING(expected[i], element->as.string);
+    }
+    vm_release(result);
+}
+
+void test_number_parse_matches_strtod(void) {
+    np_number number;
+    TEST_ASSERT_EQUAL(NP_INT32, np_parse("-2147483648", 11, 0, &number));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, number.as.int32);
+    TEST_ASSERT_EQUAL(NP_BIGINT, np_parse("2147483648", 10, 0, &number));
+    di_release(&number.as.bigint);
+    TEST_ASSERT_EQUAL(NP_FLOAT32, np_parse("0.1f", 4, 0, &number));
+    TEST_ASSERT_EQUAL_FLOAT(0.1f, number.as.float32);
+    TEST_ASSERT_EQUAL(NP_FLOAT32, np_parse("2.5", 3, NP_SINGLE, &number));
+    TEST_ASSERT_EQUAL(NP_FLOAT64, np_parse("2.5d", 4, NP_SINGLE, &number));
+    TEST_ASSERT_EQUAL(NP_INVALID, np_parse("1.5", 3, NP_INTEGER_ONLY, &number));
+    TEST_ASSERT_EQUAL(1, np_scan("1.5", 3, NP_INTEGER_ONLY, &number));
+    TEST_ASSERT_EQUAL(NP_INVALID, np_parse("1.", 2, 0, &number));
+    TEST_ASSERT_EQUAL(NP_FLOAT64, np_parse("1.", 2, NP_BARE_POINT, &number));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, number.as.float64);
+    TEST_ASSERT_EQUAL(NP_FLOAT64, np_parse("-.5", 3, NP_BARE_POINT, &number));
+    TEST_ASSERT_EQUAL_DOUBLE(-0.5, number.as.float64);
+    TEST_ASSERT_EQUAL(NP_FLOAT64, np_parse("1.e2", 4, NP_BARE_POINT, &number));
+    TEST_ASSERT_EQUAL_DOUBLE(100.0, number.as.float64);
+    TEST_ASSERT_EQUAL(NP_INVALID, np_parse(".", 1, NP_BARE_POINT, &number));
+    TEST_ASSERT_EQUAL(NP_INVALID, np_parse("1.", 2, NP_BARE_POINT | NP_INTEGER_ONLY, &number));
+    TEST_ASSERT_EQUAL(NP_INVALID, np_parse("", 0, 0, &number));
+
+    // Halfway cases, long mantissas and the subnormal and overflow edges round as strtod does
+    const char* edges[] = {"9007199254740993", "2.2250738585072011e-308", "4.9406564584124654e-324",
+                           "2.4703282292062327e-324", "1.7976931348623158e308", "1e400",
+                           "0.1000000000000000055511151231257827021181583404541015625000001"};
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+        TEST_ASSERT_TRUE_MESSAGE(np_parse_float64(edges[i], strlen(edges[i])) == strtod(edges[i], NULL), edges[i]);
+    }
+    TEST_ASSERT_TRUE(np_parse_float32("16777217.0", 10) == 16777216.0f);
+
+    // Random decimal strings agree with the C library bit for bit
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    char buffer[64];
+    for (int i = 0; i < 100000; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int length = snprintf(buffer, sizeof(buffer), "%llu.%llue%d", (unsigned long long)(state % 100000000000ull),
+                              (unsigned long long)(state >> 40), (int)(state >> 56) % 40 - 20);
+        double d = np_parse_float64(buffer, (size_t)length);
+        float f = np_parse_float32(buffer, (size_t)length);
+        TEST_ASSERT_TRUE_MESSAGE(d == strtod(buffer, NULL), buffer);
+        TEST_ASSERT_TRUE_MESSAGE(f == strtof(buffer, NULL), buffer);
+    }
+}
+
+void test_parse_int_and_parse_number(void) {
+    value_t result = test_execute_expression(
+        "var a = parse_int(\" 42 \") == 42 && parse_int(\"-7\") == -7 && parse_int(\"+3\") == 3\n"
+        "var b = parse_int(\"123456789012345678901234567890\").toString() == \"123456789012345678901234567890\"\n"
+        "var c = parse_number(\"1e5\") == 100000.0 && parse_number(\"2.5\") == 2.5 && parse_number(\"7\") == 7\n"
+        "var d = parse_number(\"0.1f\") == 0.1f && parse_number(\"0.5d\") == 0.5\n"
+        "var e = parse_number(\".5\") == 0.5 && parse_number(\"1.\") == 1.0 && parse_number(\"-.25e1\") == -2.5\n"
+        "a && b && c && d && e");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    TEST_ASSERT_TRUE(test_expect_error("parse_int(\"1.5\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("parse_int(\"12abc\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("parse_number(\"\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("parse_number(\".\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("parse_int(\".5\")", ERR_TYPE));
+}
+
 void test_class_int_suite(void) {
     RUN_TEST(test_integer_literals_vs_float_literals);
     RUN_TEST(test_int32_overflow_detection);
@@ -280,6 +438,11 @@ void test_class_int_suite(void) {
     RUN_TEST(test_int32_hash_consistency);
     RUN_TEST(test_int32_hash_max_min);
     RUN_TEST(test_int_hash_equality_function);
+    RUN_TEST(test_number_format_integers);
+    RUN_TEST(test_number_format_shortest_floats);
+    RUN_TEST(test_number_to_string_uses_shortest_digits);
+    RUN_TEST(test_number_parse_matches_strtod);
+    RUN_TEST(test_parse_int_and_parse_number);
 }
 
 // Test hexadecimal literal parsing and type handling
@@ -202,6 +202,78 @@ void test_iterator_method_chaining(void) {
 }
 
 // Test Suite Runner
+// ===========================
+// LAZY ADAPTER TESTS
+// ===========================
+
+// Test map/filter/take/skip/enumerate/zip/flatMap chains
+void test_iterator_adapters(void) {
+    test_expect_true(
+        "[1, 2, 3, 4, 5, 6].iterator().map(x -> x * 10).filter(x -> x > 20).take(3).toArray() == [30, 40, 50]");
+    test_expect_true(
+        "(1..5).iterator().skip(2).enumerate().toArray() == [[0, 3], [1, 4], [2, 5]]");
+    test_expect_true(
+        "[1, 2, 3].iterator().zip([\"a\", \"b\"]).toArray() == [[1, \"a\"], [2, \"b\"]]");
+    test_expect_true(
+        "[1, 2, 3].iterator().flatMap(x -> 1..x).toArray() == [1, 1, 2, 1, 2, 3]");
+    test_expect_true(
+        "[1, 2].iterator().flatMap(x -> x * 2).toArray() == [2, 4]");
+    test_expect_true(
+        "var it = (1..3).iterator().map(x -> x + 1)\n"
+        "var first = it.next()\n"
+        "first == 2 && it.toArray() == [3, 4] && !it.hasNext()");
+}
+
+// Test that each element makes one pass through every stage, pulled on demand
+void test_iterator_adapters_are_lazy(void) {
+    test_expect_true(
+        "var log = []\n"
+        "var it = [1, 2, 3].iterator().map(x -> log.push(\"m\" + x.toString())).filter(x -> log.push(\"f\"))\n"
+        "var before = log.length()\n"
+        "it.next()\n"
+        "before == 0 && log == [\"m1\", \"f\"]");
+    test_expect_true(
+        "def naturals() =\n"
+        "    var i = 0\n"
+        "    while true\n"
+        "        yield i\n"
+        "        i += 1\n"
+        "naturals().map(x -> x * x).filter(x -> x % 2 == 1).take(3).toArray() == [1, 9, 25]");
+    // Captured locals outlive the call that built the pipeline
+    test_expect_true(
+        "def scaled(n) =\n"
+        "    var factor = n\n"
+        "    (1..3).iterator().map(x -> x * factor)\n"
+        "scaled(5).toArray() == [5, 10, 15]");
+}
+
+// Test reduce/sum/count
+void test_iterator_terminal_operations(void) {
+    test_expect_true(
+        "(1..10).iterator().reduce((a, b) -> a * b) == 3628800 && "
+        "(1..10).iterator().reduce((a, b) -> a + b, 100) == 155 && "
+        "[].iterator().reduce((a, b) -> a + b, 0) == 0");
+    test_expect_true(
+        "(1..100).iterator().sum() == 5050 && [1.5, 2].iterator().sum() == 3.5 && [].iterator().sum() == 0");
+    test_expect_true(
+        "[2147483647, 1].iterator().sum() == 2147483648");
+    test_expect_true(
+        "(1..10).iterator().filter(x -> x % 2 == 0).count() == 5 && (1..10).iterator().count() == 10 && "
+        "[1, 2, 3].iterator().skip(1).count() == 2");
+    test_expect_true(
+        "var it = [1, 2, 3].iterator()\n"
+        "it.count() == 3 && !it.hasNext()");
+}
+
+// Test adapter argument errors
+void test_iterator_adapter_errors(void) {
+    TEST_ASSERT_TRUE(test_expect_error("[1].iterator().map(5)", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("[1].iterator().take(-1)", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("[1].iterator().zip(5)", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("[].iterator().reduce((a, b) -> a + b)", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("[\"a\"].iterator().sum()", ERR_TYPE));
+}
+
 void test_class_iterator_suite(void) {
     RUN_TEST(test_iterator_creation_from_array);
     RUN_TEST(test_iterator_creation_from_range);
@@ -213,4 +285,8 @@ void test_class_iterator_suite(void) {
     RUN_TEST(test_iterator_state_progression);
     RUN_TEST(test_iterator_edge_cases);
     RUN_TEST(test_iterator_method_chaining);
+    RUN_TEST(test_iterator_adapters);
+    RUN_TEST(test_iterator_adapters_are_lazy);
+    RUN_TEST(test_iterator_terminal_operations);
+    RUN_TEST(test_iterator_adapter_errors);
 }
\ No newline at end of file
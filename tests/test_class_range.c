@@ -437,6 +437,35 @@ void test_range_edge_cases(void) {
     vm_release(result);
 }
 
+// Test range indexing (ranges are callable with one integer argument)
+void test_range_indexing(void) {
+    value_t result = test_execute_expression("(1..10)(3)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL(4, result.as.int32);
+    vm_release(result);
+    
+    // Reverse ranges count down
+    result = test_execute_expression("(10..1)(2)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL(8, result.as.int32);
+    vm_release(result);
+    
+    // Stepped ranges
+    result = test_execute_expression("(1..<10 step 3)(2)");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL(7, result.as.int32);
+    vm_release(result);
+    
+    // Out of bounds returns null, like arrays
+    result = test_execute_expression("(1..<10 step 3)(3)");
+    TEST_ASSERT_EQUAL(VAL_NULL, result.type);
+    vm_release(result);
+    
+    result = test_execute_expression("(1..5)(-1)");
+    TEST_ASSERT_EQUAL(VAL_NULL, result.type);
+    vm_release(result);
+}
+
 // Test Suite Runner
 void test_class_range_suite(void) {
     RUN_TEST(test_range_construction);
@@ -452,6 +481,7 @@ void test_class_range_suite(void) {
     RUN_TEST(test_range_iterator);
     RUN_TEST(test_range_method_chaining);
     RUN_TEST(test_range_edge_cases);
+    RUN_TEST(test_range_indexing);
     
     // Range iterator comprehensive tests
     RUN_TEST(test_range_iterator_forward_inclusive);
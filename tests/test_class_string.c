@@ -1,5 +1,10 @@
 #include "../unity/unity.h"
 #include "test_helpers.h"
+#include "codegen.h"
+#include "lexer.h"
+#include "parser.h"
+#include "string_kernels.h"
+#include "../src/opcodes/opcodes.h"
 #include <string.h>
 
 
@@ -292,6 +297,70 @@ void test_string_concat_with_empty_object(void) {
     vm_release(result);
 }
 
+// Appending in a loop grows the variable's string in place; values taken earlier must not change
+void test_string_concat_in_loop(void) {
+    value_t result = test_execute_expression(
+        "def build(n) =\n"
+        "    var s = \"\"\n"
+        "    var kept = []\n"
+        "    for var i = 0; i < n; i += 1 do\n"
+        "        s = s + i + \",\"\n"
+        "        kept.push(s)\n"
+        "        s += \"|\"\n"
+        "    kept.push(s)\n"
+        "    kept\n"
+        "build(3) == [\"0,\", \"0,|1,\", \"0,|1,|2,\", \"0,|1,|2,|\"]");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    // Globals, doubling (s + s) and a non-string left operand that becomes one
+    result = test_execute_expression(
+        "var g = \"ab\"\n"
+        "var n = 1\n"
+        "var copy = g\n"
+        "for var i = 0; i < 3; i += 1 do\n"
+        "    g = g + g\n"
+        "    n = n + \"x\"\n"
+        "g.length() == 16 && copy == \"ab\" && n == \"1xxx\"");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    result = test_execute_expression(
+        "var s = \"\"\n"
+        "var i = 0\n"
+        "while i < 100000\n"
+        "    s += \"line \" + i.toString() + \"\\n\"\n"
+        "    i += 1\n"
+        "s.length()");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT(1088890, result.as.int32);
+
+    TEST_ASSERT_TRUE(test_expect_error("val v = \"a\"\nfor var i = 0; i < 2; i += 1 do v += \"b\"", ERR_TYPE));
+
+    // Operands after the first read x as it was before the statement, locals and globals alike
+    result = test_execute_expression(
+        "def twice() =\n"
+        "    var x = \"b\"\n"
+        "    for var i = 0; i < 2; i += 1 do\n"
+        "        x = x + \"a\" + x\n"
+        "    x\n"
+        "def captured() =\n"
+        "    var x = \"b\"\n"
+        "    def peek() = x\n"
+        "    for var i = 0; i < 2; i += 1 do\n"
+        "        x = x + \"a\" + peek()\n"
+        "    x\n"
+        "var g = \"b\"\n"
+        "var h = \"b\"\n"
+        "def current() = h\n"
+        "for var i = 0; i < 2; i += 1 do\n"
+        "    g = g + \"a\" + g\n"
+        "    h = h + \"a\" + current()\n"
+        "twice() == \"bababab\" && captured() == \"babab\" && g == \"bababab\" && h == \"bababab\"");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
 // =============================================================================
 // STRING BUILDER TESTS
 // =============================================================================
@@ -464,6 +533,380 @@ void test_string_method_hash_equality(void) {
     vm_release(result);
 }
 
+void test_string_hash_cached(void) {
+    // The hash is cached on first use and must be dropped when a loop appends in place
+    value_t result = test_execute_expression(
+        "var s = \"key\"\n"
+        "var before = s.hash()\n"
+        "for var i = 0; i < 3; i += 1 do s += \"!\"\n"
+        "s.hash() == \"key!!!\".hash() && s.hash() != before && Set([s]).has(\"key!!!\") && !Set([s]).has(\"key\")");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    // Equal text built different ways hashes and compares equal; same-length strings whose cached
+    // hashes differ compare unequal
+    result = test_execute_expression(
+        "var a = \"ab\" + \"cd\"\n"
+        "var b = \"abce\"\n"
+        "a.hash() == \"abcd\".hash() && b.hash() != a.hash() && a == \"abcd\" && a != b && !a.equals(b)");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    // Object hashing reads the hash stored with each interned key
+    result = test_execute_expression("{name: \"x\", id: 1}.hash() == {id: 1, name: \"x\"}.hash() && {a: 1}.hash() != {b: 1}.hash()");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
+void test_string_search_methods(void) {
+    value_t result = test_execute_expression(
+        "var s = \"a-b--c-\"\n"
+        "var found = s.lastIndexOf(\"-\") == 6 && s.lastIndexOf(\"--\") == 3 && s.lastIndexOf(\"x\") == -1 && s.lastIndexOf(\"\") == 7\n"
+        "var counted = s.count(\"-\") == 4 && s.count(\"--\") == 1 && \"aaaa\".count(\"aa\") == 2 && s.count(\"\") == 0\n"
+        "var replaced = s.replaceAll(\"-\", \"+\") == \"a+b++c+\" && s.replaceAll(\"--\", \"\") == \"a-bc-\" && s.replaceAll(\"\", \"x\") == s\n"
+        "found && counted && replaced && s.replace(\"-\", \"\") == \"ab--c-\" && \"\".replaceAll(\"a\", \"b\") == \"\"");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    // Positions count characters, and needles longer than the two-way cutoff work the same
+    result = test_execute_expression(
+        "var long = \"0123456789abcdefghijklmnopqrstuvwxyz\"\n"
+        "var text = \"é\" + long + \"|\" + long\n"
+        "text.indexOf(long) == 1 && text.lastIndexOf(long) == 38 && text.count(long) == 2 && text.indexOf(long + \"!\") == -1");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
+void test_string_unicode_case_and_trim(void) {
+    value_t result = test_execute_expression("\"héllo wörld ÿ ß\".toUpper()");
+    TEST_ASSERT_EQUAL(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("HÉLLO WÖRLD Ÿ ß", result.as.string);
+    vm_release(result);
+
+    result = test_execute_expression("\"ΑΘΗΝΑ Привет ÀÉÎ ŁÓDŹ\".toLower()");
+    TEST_ASSERT_EQUAL(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("αθηνα привет àéî łódź", result.as.string);
+    vm_release(result);
+
+    // Unicode spaces (no-break, em, ideographic) trim too; other non-ASCII text is kept
+    result = test_execute_expression("\"\xc2\xa0\xe2\x80\x83 \\t é \xe3\x80\x80\\n\".trim()");
+    TEST_ASSERT_EQUAL(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("é", result.as.string);
+    vm_release(result);
+
+    result = test_execute_expression("\" \xc2\xa0 \".trim()");
+    TEST_ASSERT_EQUAL(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("", result.as.string);
+    vm_release(result);
+}
+
+void test_string_split_methods(void) {
+    value_t result = test_execute_expression(
+        "var a = \"a,,b,\".split(\",\") == [\"a\", \"\", \"b\", \"\"] && \"\".split(\",\") == [\"\"] && \"a--b\".split(\"--\") == [\"a\", \"b\"]\n"
+        "var b = \"héllo\".split(\"\") == [\"h\", \"é\", \"l\", \"l\", \"o\"] && \"abc\".split(\"x\") == [\"abc\"]\n"
+        "var c = \"one\r\\ntwo\\n\\nthree\\n\".lines() == [\"one\", \"two\", \"\", \"three\"] && \"\".lines() == [] && \"x\".lines() == [\"x\"]\n"
+        "var d = \" the\\tquick \xe3\x80\x80" "brown\\n\".splitWhitespace() == [\"the\", \"quick\", \"brown\"] && \"  \".splitWhitespace() == []\n"
+        "a && b && c && d");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    // Pieces are ordinary strings: they hash, compare and grow like any other
+    result = test_execute_expression(
+        "var words = \"alpha beta alpha\".splitWhitespace()\n"
+        "var w = words(1)\n"
+        "w += \"!\"\n"
+        "Set(words).size() == 2 && w == \"beta!\" && words(1) == \"beta\" && words(0).hash() == \"alpha\".hash()");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
+void test_string_parse_ints(void) {
+    value_t result = test_execute_expression(
+        "var a = \" 1 -20\\n300\\t+4 \".parseInts() == Int32Array([1, -20, 300, 4]) && \"\".parseInts().length() == 0\n"
+        "var b = \"5, 6 ,7,\".parseInts(\",\") == Int32Array([5, 6, 7]) && \"-2147483648\".parseInts()(0) == -2147483648\n"
+        "a && b");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    TEST_ASSERT_TRUE(test_expect_error("\"1,,2\".parseInts(\",\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("\"1 2.5\".parseInts()", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("\"2147483648\".parseInts()", ERR_TYPE));
+}
+
+void test_string_slices_share_chunks(void) {
+    // Many small pieces share chunks, big ones get their own allocation; either way each string
+    // is released on its own, in any order
+    enum { PIECES = 5000 };
+    static char text[PIECES * 3 + DS_POOL_CHUNK];
+    static ds_span spans[PIECES + 1];
+    static ds_string out[PIECES + 1];
+    for (int i = 0; i < PIECES; i++) {
+        text[i * 3] = (char)('a' + i % 26);
+        text[i * 3 + 1] = (char)('a' + i / 26 % 26);
+        text[i * 3 + 2] = ',';
+        spans[i] = (ds_span){(size_t)i * 3, 2};
+    }
+    memset(text + PIECES * 3, 'z', DS_POOL_CHUNK);
+    spans[PIECES] = (ds_span){PIECES * 3, DS_POOL_CHUNK};
+    ds_slices(text, spans, PIECES + 1, out);
+
+    for (int i = 0; i < PIECES; i++) {
+        TEST_ASSERT_EQUAL_UINT64(2, ds_length(out[i]));
+        TEST_ASSERT_EQUAL_MEMORY(text + i * 3, out[i], 2);
+        TEST_ASSERT_EQUAL_CHAR('\0', out[i][2]);
+    }
+    TEST_ASSERT_EQUAL_UINT64(DS_POOL_CHUNK, ds_length(out[PIECES]));
+
+    // Growing a pooled string moves it out of its chunk
+    out[7] = ds_append_in_place(out[7], "!!", 2);
+    TEST_ASSERT_EQUAL_STRING("ha!!", out[7]);
+    TEST_ASSERT_EQUAL_STRING("ga", out[6]);
+    for (int i = 0; i <= PIECES; i += 2) ds_release(&out[i]);
+    for (int i = PIECES - 1; i > 0; i -= 2) ds_release(&out[i]);
+}
+
+void test_string_append_to_split_piece(void) {
+    // x += "!" on a split() piece held by x and the stack: the grown string moves out of the
+    // chunk, and both holders keep their reference to it
+    ds_span spans[2] = {{0, 2}, {3, 2}}; // "ab,cd".split(",")
+    ds_string pieces[2];
+    ds_slices("ab,cd", spans, 2, pieces);
+    value_t variable = make_string_ds(pieces[0]);
+    ds_release(&pieces[1]);
+    TEST_ASSERT_EQUAL_UINT64(1, ds_refcount(variable.as.string));
+
+    vm_t* vm = vm_create();
+    vm_push(vm, variable);
+    ds_string text = ds_new("!");
+    vm_append_string(vm, &variable, text);
+    ds_release(&text);
+    value_t grown = vm_pop(vm);
+    TEST_ASSERT_EQUAL_PTR(variable.as.string, grown.as.string);
+    TEST_ASSERT_EQUAL_UINT64(2, ds_refcount(grown.as.string));
+    vm_release(grown);
+
+    TEST_ASSERT_EQUAL_STRING("ab!", variable.as.string);
+    TEST_ASSERT_EQUAL_UINT64(1, ds_refcount(variable.as.string));
+    vm_release(variable);
+    vm_destroy(vm);
+}
+
+void test_string_codepoint_indexing(void) {
+    value_t result = test_execute_expression(
+        "var s = \"h\xc3\xa9llo, w\xc3\xb6rld \xe2\x82\xac\xf0\x9f\x98\x80!\"\n"
+        "var lengths = s.length() == 16 && \"\".length() == 0 && \"abc\".length() == 3\n"
+        "var chars = s(1) == \"\xc3\xa9\" && s(14) == \"\xf0\x9f\x98\x80\" && s(15) == \"!\" && s(16) == null && s(-1) == null\n"
+        "var subs = s.substring(7, 5) == \"w\xc3\xb6rld\" && s.substring(13, 10) == \"\xe2\x82\xac\xf0\x9f\x98\x80!\" && s.substring(20, 1) == \"\"\n"
+        "var found = s.indexOf(\"rld\") == 9 && s.lastIndexOf(\"l\") == 10 && s.substring(s.indexOf(\"\xe2\x82\xac\"), 1) == \"\xe2\x82\xac\"\n"
+        "lengths && chars && subs && found");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+    // Walking a long non-ASCII string by index visits every character once, in order
+    result = test_execute_expression(
+        "var s = \"\"\n"
+        "for var i = 0; i < 500; i += 1 do\n"
+        "    s += if i % 3 == 0 then \"\xce\xb1\" else \"b\"\n"
+        "var rebuilt = \"\"\n"
+        "for var i = 0; i < s.length(); i += 1 do\n"
+        "    rebuilt += s(i)\n"
+        "s.length() == 500 && rebuilt == s && s(497) == \"b\" && s(498) == \"\xce\xb1\" && s(499) == \"b\"");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
+void test_template_literal_parts(void) {
+    // Every kind of part converts as StringBuilder.append() would
+    value_t result = test_execute_expression(
+        "var name = \"Ann\"\n"
+        "var low = -2147483647 - 1\n"
+        "`$name: $low ${0} ${-7} ${2.5} ${true} ${null} ${[1, \"x\"]} ${1..<3}`");
+    TEST_ASSERT_EQUAL(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("Ann: -2147483648 0 -7 2.5 true null [1, x] 1..<3", result.as.string);
+    vm_release(result);
+
+    // More parts than fit inline, a lone string part, and no parts at all
+    result = test_execute_expression(
+        "var s = \"word\"\n"
+        "var many = `${1}-${2}-${3}-${4}-${5}-${6}-${7}-${8}-${9}-${10}` == \"1-2-3-4-5-6-7-8-9-10\"\n"
+        "many && `$s` == \"word\" && `` == \"\" && `plain` == \"plain\"");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
+void test_template_literal_compiles_to_concat_n(void) {
+    const char* source =
+        "var x = 42\n"
+        "`x is $x, twice ${x * 2}`";
+
+    lexer_t lexer;
+    lexer_init(&lexer, source);
+    parser_t parser;
+    parser_init(&parser, &lexer);
+    ast_program* program = parse_program(&parser);
+    TEST_ASSERT_FALSE(parser.had_error);
+
+    vm_t* vm = vm_create();
+    codegen_t* codegen = codegen_create(vm);
+    function_t* main_function = codegen_compile(codegen, program);
+    TEST_ASSERT_FALSE(codegen->had_error);
+
+    // Four parts joined by one instruction, with no StringBuilder or method calls
+    int concat_count = 0, concat_operand = -1, calls = 0;
+    for (size_t offset = 0; offset < main_function->bytecode_length;) {
+        opcode op = (opcode)main_function->bytecode[offset];
+        if (op == OP_CONCAT_N) {
+            concat_count++;
+            concat_operand = main_function->bytecode[offset + 1] | (main_function->bytecode[offset + 2] << 8);
+        }
+        calls += op == OP_CALL || op == OP_GET_PROPERTY;
+        size_t size = instruction_length(main_function->bytecode, offset, main_function->bytecode_length);
+        TEST_ASSERT_NOT_EQUAL(0, size);
+        offset += size;
+    }
+    TEST_ASSERT_EQUAL_INT(1, concat_count);
+    TEST_ASSERT_EQUAL_INT(4, concat_operand);
+    TEST_ASSERT_EQUAL_INT(0, calls);
+
+    function_destroy(main_function);
+    vm_destroy(vm);
+    codegen_destroy(codegen);
+    ast_free((ast_node*)program);
+    lexer_cleanup(&lexer);
+}
+
+void test_string_codepoint_index_agrees_with_walk(void) {
+    // One- to four-byte characters, a stray continuation byte and a truncated sequence at the end,
+    // long enough for many index entries
+    ds_builder sb = ds_builder_create();
+    const char* pieces[] = {"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\x80", "z"};
+    for (int i = 0; i < 400; i++) {
+        ds_builder_append(sb, pieces[(i * 7 + i / 5) % 6]);
+    }
+    ds_builder_append(sb, "\xe2\x82");
+    ds_string str = ds_builder_to_string(sb);
+    ds_builder_release(&sb);
+
+    size_t length = ds_length(str);
+    size_t offsets[2048];
+    size_t count = 0;
+    for (size_t pos = 0; pos < length; count++) {
+        offsets[count] = pos;
+        unsigned char lead = (unsigned char)str[pos];
+        size_t width = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+        pos += width < length - pos ? width : length - pos;
+    }
+    offsets[count] = length;
+
+    TEST_ASSERT_FALSE(ds_is_ascii(str));
+    TEST_ASSERT_EQUAL_UINT64(count, ds_codepoint_length(str));
+    for (size_t i = 0; i <= count + 3; i++) {
+        size_t expected = i <= count ? offsets[i] : length;
+        TEST_ASSERT_EQUAL_UINT64(expected, ds_codepoint_offset(str, i));
+    }
+    for (size_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_UINT64(i, ds_codepoint_index(str, offsets[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT64(count, ds_codepoint_index(str, length));
+    TEST_ASSERT_EQUAL_UINT32(0x20AC, ds_codepoint_at(str, 2));
+
+    // Appending drops the index: the truncated sequence now claims the first appended byte, leaving
+    // the second as a stray
+    str = ds_append_in_place(str, "\xce\xb1", 2);
+    TEST_ASSERT_EQUAL_UINT64(count + 1, ds_codepoint_length(str));
+    TEST_ASSERT_EQUAL_UINT64(length + 1, ds_codepoint_offset(str, count));
+    ds_release(&str);
+
+    ds_string ascii = ds_new("plain ascii text that is long enough for the word-at-a-time scan");
+    TEST_ASSERT_TRUE(ds_is_ascii(ascii));
+    TEST_ASSERT_EQUAL_UINT64(ds_length(ascii), ds_codepoint_length(ascii));
+    ascii = ds_append_in_place(ascii, "!", 1);
+    TEST_ASSERT_TRUE(ds_is_ascii(ascii));
+    ascii = ds_append_in_place(ascii, "\xc3\xa9", 2);
+    TEST_ASSERT_FALSE(ds_is_ascii(ascii));
+    TEST_ASSERT_EQUAL_UINT64(ds_length(ascii) - 1, ds_codepoint_length(ascii));
+    ds_release(&ascii);
+}
+
+static ssize_t naive_find(const char* text, size_t length, const char* needle, size_t needle_length, size_t from) {
+    for (size_t i = from; i + needle_length <= length; i++) {
+        if (memcmp(text + i, needle, needle_length) == 0) return (ssize_t)i;
+    }
+    return -1;
+}
+
+static ssize_t naive_find_last(const char* text, size_t length, const char* needle, size_t needle_length) {
+    for (size_t i = length - needle_length + 1; i-- > 0;) {
+        if (memcmp(text + i, needle, needle_length) == 0) return (ssize_t)i;
+    }
+    return -1;
+}
+
+void test_string_kernels_agree_across_levels(void) {
+    // A small alphabet makes partial matches common; the repeated block exercises two-way's
+    // periodic case
+    enum { N = 3001 };
+    static char text[N + 1];
+    for (int i = 0; i < N; i++) {
+        text[i] = "abcab "[(i * 7919 + i / 97) % 6];
+    }
+    memset(text + 2000, 'a', 200);
+    text[2150] = 'b';
+    text[N] = '\0';
+
+    const char* needles[] = {"a", " ", "z", "ab", "ba", "abc", "b ab", "c aba", "aaaaaaaaaaaaaaaab", "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab",
+                             "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaac"};
+    tk_level original = tk_get_level();
+    for (int level = TK_SCALAR; level <= TK_AVX2; level++) {
+        tk_set_level((tk_level)level);
+        for (size_t k = 0; k < sizeof(needles) / sizeof(needles[0]); k++) {
+            size_t m = strlen(needles[k]);
+            for (size_t from = 0; from <= N; from += 37) {
+                TEST_ASSERT_EQUAL_INT64(naive_find(text, N, needles[k], m, from), sk_find(text, N, needles[k], m, from));
+            }
+            TEST_ASSERT_EQUAL_INT64(naive_find_last(text, N, needles[k], m), sk_find_last(text, N, needles[k], m));
+            size_t expected = 0;
+            for (ssize_t at = 0; (at = naive_find(text, N, needles[k], m, (size_t)at)) >= 0; at += (ssize_t)m) expected++;
+            TEST_ASSERT_EQUAL_UINT64(expected, sk_count(text, N, needles[k], m));
+        }
+        // Needles drawn from the text itself, at every length around the vector widths
+        for (size_t m = 1; m <= 70; m++) {
+            const char* needle = text + 1500 - m / 2;
+            TEST_ASSERT_EQUAL_INT64(naive_find(text, N, needle, m, 0), sk_find(text, N, needle, m, 0));
+            TEST_ASSERT_EQUAL_INT64(naive_find_last(text, N, needle, m), sk_find_last(text, N, needle, m));
+        }
+
+        // Whitespace runs of every length up to past two AVX2 blocks on both sides
+        char padded[160];
+        for (int pad = 0; pad < 70; pad++) {
+            memset(padded, ' ', sizeof(padded));
+            for (int i = 0; i < pad; i++) padded[i] = "\t\n\v\f\r "[i % 6];
+            memcpy(padded + pad, "x\x80y", 3);
+            size_t length = (size_t)pad + 3 + (size_t)pad;
+            TEST_ASSERT_EQUAL_UINT64((size_t)pad, sk_skip_space(padded, length));
+            TEST_ASSERT_EQUAL_UINT64((size_t)pad + 3, sk_skip_space_back(padded, length));
+        }
+
+        // ASCII runs of every length around the block size, then a two-byte letter
+        char mixed[80], upper[80], lower[80];
+        for (size_t run = 0; run < 70; run++) {
+            for (size_t i = 0; i < run; i++) mixed[i] = "aZ{@`"[i % 5];
+            memcpy(mixed + run, "\xc3\xa9q\xff", 4); // é, q, then a byte that isn't UTF-8
+            size_t length = run + 4;
+            TEST_ASSERT_TRUE(sk_to_upper(upper, mixed, length));
+            TEST_ASSERT_EQUAL_INT(run >= 2, sk_to_lower(lower, mixed, length)); // Only the Z changes
+            for (size_t i = 0; i < run; i++) {
+                TEST_ASSERT_EQUAL_CHAR(mixed[i] == 'a' ? 'A' : mixed[i], upper[i]);
+                TEST_ASSERT_EQUAL_CHAR(mixed[i] == 'Z' ? 'z' : mixed[i], lower[i]);
+            }
+            TEST_ASSERT_EQUAL_MEMORY("\xc3\x89Q\xff", upper + run, 4);
+            TEST_ASSERT_EQUAL_MEMORY("\xc3\xa9q\xff", lower + run, 4);
+        }
+        TEST_ASSERT_FALSE(sk_to_upper(upper, "ABC {}", 6));
+    }
+    tk_set_level(original);
+}
+
 // Test String.equals() method
 void test_string_equals_basic(void) {
     value_t result = test_execute_expression("\"hello\".equals(\"hello\")");
@@ -534,6 +977,17 @@ void test_class_string_suite(void) {
     RUN_TEST(test_string_index_of);
     RUN_TEST(test_string_method_chaining);
     RUN_TEST(test_string_is_empty_non_empty);
+    RUN_TEST(test_string_search_methods);
+    RUN_TEST(test_string_unicode_case_and_trim);
+    RUN_TEST(test_string_split_methods);
+    RUN_TEST(test_string_parse_ints);
+    RUN_TEST(test_string_slices_share_chunks);
+    RUN_TEST(test_string_append_to_split_piece);
+    RUN_TEST(test_string_codepoint_indexing);
+    RUN_TEST(test_string_codepoint_index_agrees_with_walk);
+    RUN_TEST(test_template_literal_parts);
+    RUN_TEST(test_template_literal_compiles_to_concat_n);
+    RUN_TEST(test_string_kernels_agree_across_levels);
     
     // String concatenation tests (moved from test_builtins.c)
     RUN_TEST(test_string_concat_with_array);
@@ -541,6 +995,7 @@ void test_class_string_suite(void) {
     RUN_TEST(test_string_concat_with_nested_array);
     RUN_TEST(test_string_concat_with_object);
     RUN_TEST(test_string_concat_with_empty_object);
+    RUN_TEST(test_string_concat_in_loop);
     
     // StringBuilder tests (new functionality)
     RUN_TEST(test_string_builder_creation_empty);
@@ -563,6 +1018,7 @@ void test_class_string_suite(void) {
     RUN_TEST(test_string_hash_consistency);
     RUN_TEST(test_string_hash_differences);
     RUN_TEST(test_string_method_hash_equality);
+    RUN_TEST(test_string_hash_cached);
     
     // String equals tests
     RUN_TEST(test_string_equals_basic);
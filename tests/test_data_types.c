@@ -108,8 +108,8 @@ void test_adt_constructor_calls_return_instances(void) {
     const char* code = "data TestType\n"
                        "TestType()";
     value_t result = test_execute_expression(code);
-    // Constructor calls should return object instances
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
+    // Constructor calls should return ADT instances
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
     vm_release(result);
 }
 
@@ -118,8 +118,8 @@ void test_adt_parameterized_constructor_calls(void) {
     const char* code = "data Person(name, age)\n"
                        "Person('Alice', 25)";
     value_t result = test_execute_expression(code);
-    // Constructor calls with parameters should return object instances
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
+    // Constructor calls with parameters should return ADT instances
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
     vm_release(result);
 }
 
@@ -130,8 +130,8 @@ void test_adt_multi_case_constructor_calls(void) {
                        "  case Error(message)\n"
                        "Success('hello')";
     value_t result = test_execute_expression(code);
-    // Multi-case constructor calls should return object instances
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
+    // Multi-case constructor calls should return ADT instances
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
     vm_release(result);
 }
 
@@ -154,7 +154,7 @@ void test_adt_instances_assignable(void) {
                        "p";
     value_t result = test_execute_expression(code);
     // Should be able to assign ADT instances to variables
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
     vm_release(result);
 }
 
@@ -289,7 +289,7 @@ void test_adt_basic_constructor_calls(void) {
                        "instance";
     value_t result = test_execute_expression(code);
     // Should return an ADT instance, not crash
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
     vm_release(result);
 }
 
@@ -346,6 +346,46 @@ void test_adt_equality(void) {
     vm_release(result);
 }
 
+// Test fixed-layout ADT instances: constructor tag, indexed fields, field assignment and hashing
+void test_adt_fixed_layout(void) {
+    const char* code = "data Tree\n"
+                       "  case Leaf\n"
+                       "  case Node(value, left, right)\n"
+                       "Node(1, Leaf(), Leaf())";
+    value_t result = test_execute_expression(code);
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
+    TEST_ASSERT_EQUAL_UINT16(1, result.as.adt->constructor->tag);
+    TEST_ASSERT_EQUAL_UINT16(3, result.as.adt->constructor->field_count);
+    TEST_ASSERT_EQUAL_INT32(1, result.as.adt->fields[0].as.int32);
+    TEST_ASSERT_EQUAL(VAL_ADT, result.as.adt->fields[1].type);
+    TEST_ASSERT_EQUAL_UINT16(0, result.as.adt->fields[1].as.adt->constructor->tag);
+    vm_release(result);
+
+    result = test_execute_expression("data Point(x, y)\n"
+                                     "var p = Point(10, 20)\n"
+                                     "p.y = 30\n"
+                                     "p.x + p.y");
+    TEST_ASSERT_EQUAL(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(40, result.as.int32);
+    vm_release(result);
+
+    result = test_execute_expression("data Point(x, y)\n"
+                                     "Point(1, 2).hash() == Point(1, 2).hash() && Point(1, 2).hash() != Point(2, 1).hash()");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+    vm_release(result);
+
+    result = test_execute_expression("data Point(x, y)\n"
+                                     "\"x\" in Point(1, 2)");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+    vm_release(result);
+
+    // The layout is internal: scripts still see instances as objects
+    test_expect_true("data Point(x, y)\n"
+                     "type(Point(1, 2)) == \"object\"");
+}
+
 // Test singleton constructor display issue - printing should show "None", not "unknown"
 void test_adt_singleton_constructor_display(void) {
     // Test that singleton constructors remain as classes but print correctly
@@ -407,5 +447,6 @@ void test_data_types_suite(void) {
 
     RUN_TEST(test_adt_basic_constructor_calls);
     RUN_TEST(test_adt_equality);
+    RUN_TEST(test_adt_fixed_layout);
     RUN_TEST(test_adt_singleton_constructor_display);
 }
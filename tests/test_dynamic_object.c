@@ -0,0 +1,149 @@
+#include "unity.h"
+#include "test_helpers.h"
+#include "dynamic_object.h"
+#include <stdio.h>
+
+static int released_count;
+
+static void count_release(void* data) {
+    (void)data;
+    released_count++;
+}
+
+static void key_name(char* buffer, size_t size, int i) {
+    snprintf(buffer, size, "prop_%d", i);
+}
+
+// Objects with n int properties prop_0..prop_{n-1} = 0..n-1
+static do_object make_numbered(int n) {
+    do_object obj = do_create(count_release);
+    char key[32];
+    for (int i = 0; i < n; i++) {
+        key_name(key, sizeof(key), i);
+        TEST_ASSERT_EQUAL_INT(DO_SUCCESS, do_set(obj, key, &i, sizeof(i)));
+    }
+    return obj;
+}
+
+// ===========================
+// INDEXED STORAGE
+// ===========================
+
+void test_dynamic_object_lookup_across_sizes(void) {
+    int sizes[] = {1, 8, 9, 64, 10000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        do_object obj = make_numbered(n);
+        TEST_ASSERT_EQUAL_INT(n, do_property_count(obj));
+        char key[32];
+        for (int i = 0; i < n; i++) {
+            key_name(key, sizeof(key), i);
+            int* value = (int*)do_get(obj, key);
+            TEST_ASSERT_NOT_NULL(value);
+            TEST_ASSERT_EQUAL_INT(i, *value);
+        }
+        TEST_ASSERT_NULL(do_get(obj, "missing"));
+        do_release(&obj);
+    }
+}
+
+void test_dynamic_object_delete_and_reinsert(void) {
+    int n = 1000;
+    do_object obj = make_numbered(n);
+    char key[32];
+    // Delete the even properties, then put half of them back with new values
+    for (int i = 0; i < n; i += 2) {
+        key_name(key, sizeof(key), i);
+        TEST_ASSERT_EQUAL_INT(1, do_delete(obj, key));
+        TEST_ASSERT_EQUAL_INT(0, do_delete(obj, key));
+    }
+    for (int i = 0; i < n; i += 4) {
+        key_name(key, sizeof(key), i);
+        int value = -i;
+        do_set(obj, key, &value, sizeof(value));
+    }
+    TEST_ASSERT_EQUAL_INT(n / 2 + n / 4, do_property_count(obj));
+    for (int i = 0; i < n; i++) {
+        key_name(key, sizeof(key), i);
+        int* value = (int*)do_get(obj, key);
+        if (i % 2) {
+            TEST_ASSERT_EQUAL_INT(i, *value);
+        } else if (i % 4 == 0) {
+            TEST_ASSERT_EQUAL_INT(-i, *value);
+        } else {
+            TEST_ASSERT_NULL(value);
+        }
+    }
+    do_release(&obj);
+}
+
+void test_dynamic_object_keeps_insertion_order(void) {
+    do_object obj = make_numbered(20);
+    do_delete(obj, "prop_3");
+    int value = 99;
+    do_set(obj, "prop_3", &value, sizeof(value));
+    do_set(obj, "prop_0", &value, sizeof(value)); // Updating doesn't move a property
+
+    const char** keys = do_get_own_keys(obj);
+    TEST_ASSERT_EQUAL_INT(20, arrlen(keys));
+    TEST_ASSERT_EQUAL_STRING("prop_0", keys[0]);
+    TEST_ASSERT_EQUAL_STRING("prop_4", keys[3]);
+    TEST_ASSERT_EQUAL_STRING("prop_3", keys[19]);
+    arrfree(keys);
+    do_release(&obj);
+
+    // Slate objects keep their properties in the order they were stored (literals store theirs
+    // last to first), so printing is stable across the switch to indexed storage
+    value_t result = test_execute_expression(
+        "var o = {a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, h: 8, i: 9, j: 10}\n"
+        "o.k = 11\n"
+        "o.a = 0\n"
+        "o.toString()");
+    TEST_ASSERT_EQUAL(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("{j: 10, i: 9, h: 8, g: 7, f: 6, e: 5, d: 4, c: 3, b: 2, a: 0, k: 11}", result.as.string);
+    vm_release(result);
+}
+
+void test_dynamic_object_prototype_chain(void) {
+    do_object base = make_numbered(50);
+    do_object derived = do_create_with_prototype(base, count_release);
+    int value = 7;
+    do_set(derived, "prop_10", &value, sizeof(value)); // Shadows the prototype's
+    TEST_ASSERT_EQUAL_INT(7, *(int*)do_get(derived, "prop_10"));
+    TEST_ASSERT_EQUAL_INT(49, *(int*)do_get(derived, "prop_49"));
+    TEST_ASSERT_TRUE(do_has(derived, "prop_0"));
+    TEST_ASSERT_FALSE(do_has_own(derived, "prop_0"));
+    do_release(&derived);
+    do_release(&base);
+}
+
+void test_dynamic_object_releases_each_value_once(void) {
+    released_count = 0;
+    do_object obj = make_numbered(100);
+    int value = 1;
+    do_set(obj, "prop_5", &value, sizeof(value)); // Replacing releases the old value
+    do_delete(obj, "prop_6");
+    TEST_ASSERT_EQUAL_INT(2, released_count);
+    do_release(&obj);
+    TEST_ASSERT_EQUAL_INT(101, released_count);
+}
+
+void test_dynamic_object_interned_hash(void) {
+    // Callers holding a ds_string intern it with its cached hash; both routes must agree
+    ds_string name = ds_new("prop_hashed");
+    const char* interned = do_string_intern_hashed(name, ds_hash32(name));
+    TEST_ASSERT_EQUAL_PTR(interned, do_string_intern("prop_hashed"));
+    TEST_ASSERT_EQUAL_UINT32(ds_hash32(name), (uint32_t)do_string_hash("prop_hashed"));
+    TEST_ASSERT_EQUAL_UINT32(ds_hash32(name), (uint32_t)do_interned_hash(interned));
+    TEST_ASSERT_EQUAL_UINT32(ds_hash_bytes(name, ds_length(name)), ds_hash32(name));
+    ds_release(&name);
+}
+
+void test_dynamic_object_suite(void) {
+    RUN_TEST(test_dynamic_object_lookup_across_sizes);
+    RUN_TEST(test_dynamic_object_delete_and_reinsert);
+    RUN_TEST(test_dynamic_object_keeps_insertion_order);
+    RUN_TEST(test_dynamic_object_prototype_chain);
+    RUN_TEST(test_dynamic_object_releases_each_value_once);
+    RUN_TEST(test_dynamic_object_interned_hash);
+}
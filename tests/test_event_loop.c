@@ -0,0 +1,132 @@
+#include "unity.h"
+#include "test_helpers.h"
+#include <stdio.h>
+#include <unistd.h>
+
+void test_event_loop_tasks_interleave_on_timers(void) {
+    // Each task runs until it yields a pending promise, and resumes in deadline order
+    test_expect_true(
+        "var log = []\n"
+        "def worker(name, ms) =\n"
+        "    log.push(name + \" start\")\n"
+        "    yield sleep(ms)\n"
+        "    log.push(name + \" end\")\n"
+        "    name\n"
+        "var results = await([spawn(worker(\"slow\", 30)), spawn(worker(\"fast\", 5))])\n"
+        "results == [\"slow\", \"fast\"] && log == [\"slow start\", \"fast start\", \"fast end\", \"slow end\"]");
+}
+
+void test_event_loop_yield_values_and_children(void) {
+    // Plain values come straight back, generators run as child tasks and give their return value
+    test_expect_true(
+        "def child(x) =\n"
+        "    yield sleep(1)\n"
+        "    x * 2\n"
+        "def parent() =\n"
+        "    var a = yield 20\n"
+        "    var b = yield child(a)\n"
+        "    var c = yield await(sleep(1))\n"
+        "    [a, b, c]\n"
+        "var p = spawn(parent())\n"
+        "var pending = p.isPending()\n"
+        "await(p) == [20, 40, null] && pending && p.isFulfilled() && p.value() == [20, 40, null] && p.error() == null");
+}
+
+void test_event_loop_file_round_trip(void) {
+    char source[2048];
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "/tmp/slate_event_loop_%d_", (int)getpid());
+    snprintf(source, sizeof(source),
+        "var prefix = \"%s\"\n"
+        "var writes = [0, 1, 2, 3, 4, 5, 6, 7].map(i -> write_file_async(Buffer(\"file \" + i.toString()), prefix + i.toString()))\n"
+        "var written = await(Promise.all(writes))\n"
+        "var reads = await([0, 1, 2, 3, 4, 5, 6, 7].map(i -> read_file_async(prefix + i.toString())))\n"
+        "written == [true, true, true, true, true, true, true, true] && reads.map(b -> b.length()) == [6, 6, 6, 6, 6, 6, 6, 6] && reads(7).toString() == \"file 7\"",
+        prefix);
+    test_expect_true(source);
+    for (int i = 0; i < 8; i++) {
+        char path[96];
+        snprintf(path, sizeof(path), "%s%d", prefix, i);
+        unlink(path);
+    }
+}
+
+// Shell loop that waits (up to five seconds) for path to exist: lets a test hold a child open
+// until it has seen what it needs, without timing anything
+#define WAIT_FOR_FILE "i=0; while [ ! -e %s ] && [ $i -lt 500 ]; do sleep 0.01; i=$((i+1)); done"
+
+void test_event_loop_exec_overlaps_processes(void) {
+    // The slow child runs until the fast one's result has arrived, so they settle in that order
+    char source[2048];
+    char gate[64];
+    snprintf(gate, sizeof(gate), "/tmp/slate_event_loop_%d_gate", (int)getpid());
+    snprintf(source, sizeof(source),
+        "var log = []\n"
+        "def run(command) =\n"
+        "    var r = yield exec(command)\n"
+        "    log.push(r.output)\n"
+        "    r.output\n"
+        "def fast() =\n"
+        "    var output = yield run(\"echo fast\")\n"
+        "    yield write_file_async(Buffer(\"open\"), \"%s\")\n"
+        "    output\n"
+        "var r = await(exec(\"echo hello; exit 3\"))\n"
+        "var all = await([spawn(run(\"" WAIT_FOR_FILE "; echo slow\")), spawn(fast())])\n"
+        "r.status == 3 && r.output == \"hello\\n\" && all == [\"slow\\n\", \"fast\\n\"] && log == [\"fast\\n\", \"slow\\n\"]",
+        gate, gate);
+    test_expect_true(source);
+    unlink(gate);
+}
+
+void test_event_loop_exec_child_outlives_stdout(void) {
+    // A child that closes stdout and keeps running must not hold up the timers meanwhile: it is
+    // still pending after the sleep, and only exits once the script opens its gate
+    char source[2048];
+    char gate[64];
+    snprintf(gate, sizeof(gate), "/tmp/slate_event_loop_%d_gate", (int)getpid());
+    snprintf(source, sizeof(source),
+        "var p = exec(\"echo early; exec >&-; " WAIT_FOR_FILE "; exit 4\")\n"
+        "await(sleep(200))\n"
+        "var pending = p.isPending()\n"
+        "await(write_file_async(Buffer(\"open\"), \"%s\"))\n"
+        "var r = await(p)\n"
+        "pending && r.status == 4 && r.output == \"early\\n\"",
+        gate, gate);
+    test_expect_true(source);
+    unlink(gate);
+}
+
+void test_event_loop_errors(void) {
+    // A failed operation raises from await and fails the tasks waiting on it
+    TEST_ASSERT_TRUE(test_expect_error("await(read_file_async(\"/nonexistent/slate\"))", ERR_TYPE));
+    test_expect_true(
+        "def reader() =\n"
+        "    yield read_file_async(\"/nonexistent/slate\")\n"
+        "    \"unreachable\"\n"
+        "var p = spawn(reader())\n"
+        "await(sleep(5))\n"
+        "var everything = Promise.all([p, sleep(1)])\n"
+        "await(sleep(5))\n"
+        "p.isRejected() && p.error() == \"Failed to read file: /nonexistent/slate\" && everything.isRejected()");
+
+    // A task waiting on itself can never finish
+    TEST_ASSERT_TRUE(test_expect_error(
+        "var p = null\n"
+        "def waits() =\n"
+        "    yield p\n"
+        "p = spawn(waits())\n"
+        "await(p)", ERR_TYPE));
+
+    TEST_ASSERT_TRUE(test_expect_error("spawn([1, 2])", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("sleep(\"soon\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("Promise.all(5)", ERR_TYPE));
+}
+
+void test_event_loop_suite(void) {
+    RUN_TEST(test_event_loop_tasks_interleave_on_timers);
+    RUN_TEST(test_event_loop_yield_values_and_children);
+    RUN_TEST(test_event_loop_file_round_trip);
+    RUN_TEST(test_event_loop_exec_overlaps_processes);
+    RUN_TEST(test_event_loop_exec_child_outlives_stdout);
+    RUN_TEST(test_event_loop_errors);
+}
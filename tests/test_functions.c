@@ -300,6 +300,29 @@ void test_closure_performance(void) {
     TEST_ASSERT_EQUAL_INT32(25, result.as.int32); // 1+2+3+4+5+10 = 25
 }
 
+// Lambdas passed straight to map/filter/flatMap use pooled closures; escaping ones get promoted
+void test_local_closure_arguments(void) {
+    value_t result = run_code("var k = 3; [1, 2, 3].map(x -> x * k)(2)");
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(9, result.as.int32);
+
+    result = run_code("var k = 1; [[1, 2], [3]].map(r -> r.map(x -> x + k))(1)(0)");
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(4, result.as.int32);
+
+    result = run_code("var k = 2; [1, 2, 3, 4].filter(x -> x > k).flatMap(x -> [x, x * k])(3)");
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(8, result.as.int32);
+
+    result = run_code("var k = 5; (x -> x * k)(4)");
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(20, result.as.int32);
+
+    result = run_code("var k = 3; var box = []; var sink = {map: f -> box.push(f)}; sink.map(x -> x + k); [1].map(x -> x); box(0)(1)");
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(4, result.as.int32);
+}
+
 
 // Main test suite function
 void test_functions_suite(void) {
@@ -354,4 +377,5 @@ void test_functions_suite(void) {
     RUN_TEST(test_mixed_type_capture);
     RUN_TEST(test_closure_error_cases);
     RUN_TEST(test_closure_performance);
+    RUN_TEST(test_local_closure_arguments);
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "unity.h"
+#include "test_helpers.h"
+#include "ast.h"
+#include "lexer.h"
+#include "parser.h"
+
+static bool parses(const char* source) {
+    lexer_t lexer;
+    lexer_init(&lexer, source);
+    parser_t parser;
+    parser_init(&parser, &lexer);
+    ast_program* program = parse_program(&parser);
+    bool ok = !parser.had_error;
+    ast_free((ast_node*)program);
+    lexer_cleanup(&lexer);
+    return ok;
+}
+
+void test_generator_yields_in_order(void) {
+    test_expect_true(
+        "def count(n) =\n"
+        "    var i = 0\n"
+        "    while i < n\n"
+        "        yield i * i\n"
+        "        i += 1\n"
+        "count(5).toArray() == [0, 1, 4, 9, 16] && count(0).toArray() == []");
+}
+
+void test_generator_runs_lazily(void) {
+    // Nothing runs until the first hasNext, and each next() runs only up to the following yield
+    test_expect_true(
+        "var log = []\n"
+        "def steps() =\n"
+        "    log.push(\"start\")\n"
+        "    yield 1\n"
+        "    log.push(\"middle\")\n"
+        "    yield 2\n"
+        "    log.push(\"end\")\n"
+        "var g = steps()\n"
+        "var before = log.length()\n"
+        "var first = g.next()\n"
+        "var after_first = log == [\"start\"]\n"
+        "var second = g.next()\n"
+        "var done = !g.hasNext()\n"
+        "before == 0 && first == 1 && after_first && second == 2 && done && log == [\"start\", \"middle\", \"end\"]");
+}
+
+void test_generator_infinite_sequence(void) {
+    test_expect_true(
+        "def fib() =\n"
+        "    var a = 0\n"
+        "    var b = 1\n"
+        "    loop\n"
+        "        yield a\n"
+        "        var t = a + b\n"
+        "        a = b\n"
+        "        b = t\n"
+        "var f = fib()\n"
+        "var out = []\n"
+        "while out.length() < 10\n"
+        "    out.push(f.next())\n"
+        "out == [0, 1, 1, 2, 3, 5, 8, 13, 21, 34]");
+}
+
+void test_generator_instances_are_independent(void) {
+    // Parameters, captures and temporaries live in each generator's own saved frame
+    test_expect_true(
+        "var offset = 100\n"
+        "def from(start) =\n"
+        "    loop\n"
+        "        yield [start + offset, start]\n"
+        "        start += 1\n"
+        "var a = from(1)\n"
+        "var b = from(10)\n"
+        "a.next()\n"
+        "b.next()\n"
+        "a.next() == [102, 2] && b.next() == [111, 11]");
+}
+
+void test_generator_lambdas_and_nesting(void) {
+    test_expect_true(
+        "def take(source, n) =\n"
+        "    while n > 0 && source.hasNext()\n"
+        "        yield source.next()\n"
+        "        n -= 1\n"
+        "def naturals() =\n"
+        "    var i = 0\n"
+        "    loop\n"
+        "        yield i\n"
+        "        i += 1\n"
+        "var pairs = [1, 2].map(x -> yield x * 10).map(it -> it.toArray())\n"
+        "var sum = ((a, b) -> yield a + b)(1, 2)\n"
+        "take(naturals(), 3).toArray() == [0, 1, 2] && pairs == [[10], [20]] && sum.toArray() == [3]");
+}
+
+void test_generator_return_ends_sequence(void) {
+    // The return value isn't yielded, and a resumed yield expression evaluates to null
+    test_expect_true(
+        "def early() =\n"
+        "    var got = yield 1\n"
+        "    yield got\n"
+        "    return 99\n"
+        "    yield 2\n"
+        "early().toArray() == [1, null]");
+}
+
+void test_generator_errors(void) {
+    TEST_ASSERT_FALSE(parses("yield 1"));
+    TEST_ASSERT_TRUE(parses("def f() = yield 1"));
+    TEST_ASSERT_TRUE(parses("var f = x -> yield x"));
+
+    // Resuming a generator from inside its own body
+    TEST_ASSERT_TRUE(test_expect_error(
+        "var g = null\n"
+        "def f() =\n"
+        "    yield g.next()\n"
+        "g = f()\n"
+        "g.next()", ERR_TYPE));
+
+    // A runtime error inside the body surfaces from next()
+    TEST_ASSERT_TRUE(test_expect_error(
+        "def f() =\n"
+        "    yield 1\n"
+        "    yield 1 / undefined\n"
+        "var g = f()\n"
+        "g.next()\n"
+        "g.next()", ERR_TYPE));
+}
+
+void test_generators_suite(void) {
+    RUN_TEST(test_generator_yields_in_order);
+    RUN_TEST(test_generator_runs_lazily);
+    RUN_TEST(test_generator_infinite_sequence);
+    RUN_TEST(test_generator_instances_are_independent);
+    RUN_TEST(test_generator_lambdas_and_nesting);
+    RUN_TEST(test_generator_return_ends_sequence);
+    RUN_TEST(test_generator_errors);
+}
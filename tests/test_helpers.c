@@ -109,6 +109,13 @@ bool test_expect_error(const char* source, ErrorKind expected_error) {
     return error_occurred && actual_error == expected_error;
 }
 
+// Execute source and assert that it evaluates to true
+void test_expect_true(const char* source) {
+    value_t result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
 // === Module Testing Helper Implementations ===
 
 #include <stdlib.h>
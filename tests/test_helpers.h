@@ -14,6 +14,9 @@ value_t test_execute_expression(const char* source);
 // Returns true if the expected error occurred, false otherwise
 bool test_expect_error(const char* source, ErrorKind expected_error);
 
+// Execute source and assert that it evaluates to true
+void test_expect_true(const char* source);
+
 // === Module Testing Helpers ===
 
 // Create a temporary module from source code for testing
@@ -0,0 +1,93 @@
+#include "unity.h"
+#include "isolate.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Loops, string methods, arrays, closures and an object big enough to switch to a hash table,
+// so concurrent isolates exercise their own class tables and the shared key intern table
+static char* isolate_script(int limit, int factor) {
+    char* source = malloc(512);
+    snprintf(source, 512,
+             "var total = 0\n"
+             "var i = 0\n"
+             "while i < %d\n"
+             "    total += i\n"
+             "    i += 1\n"
+             "var o = {alpha: 1, beta: 2, gamma: 3, delta: 4, epsilon: 5, zeta: 6, eta: 7, theta: 8, iota: %d}\n"
+             "var words = [1, 2].map(x -> \"w\" + x * o.iota)\n"
+             "words.toString() + \":\" + total + \":\" + \"abc\".toUpper()",
+             limit, factor);
+    return source;
+}
+
+void test_isolate_runs_scripts_concurrently(void) {
+    enum { COUNT = 24 };
+    isolate_pool* pool = isolate_pool_create(4);
+    TEST_ASSERT_NOT_NULL(pool);
+    TEST_ASSERT_EQUAL_size_t(4, isolate_pool_size(pool));
+
+    isolate* isolates[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+        char* source = isolate_script(1000 + i * 100, i + 1);
+        isolates[i] = isolate_spawn(pool, source, 0, NULL);
+        free(source); // The isolate keeps its own copy
+        TEST_ASSERT_NOT_NULL(isolates[i]);
+    }
+
+    for (int i = 0; i < COUNT; i++) {
+        long limit = 1000 + i * 100;
+        char expected[128];
+        snprintf(expected, sizeof(expected), "\"[\"w%d\", \"w%d\"]:%ld:ABC\"", i + 1, 2 * (i + 1),
+                 limit * (limit - 1) / 2);
+
+        char* text = NULL;
+        TEST_ASSERT_EQUAL_INT(VM_OK, isolate_join(isolates[i], &text));
+        TEST_ASSERT_NOT_NULL(text);
+        TEST_ASSERT_EQUAL_STRING(expected, text);
+        free(text);
+    }
+
+    isolate_pool_destroy(pool);
+}
+
+void test_isolate_errors_stay_in_their_isolate(void) {
+    isolate_pool* pool = isolate_pool_create(2);
+    TEST_ASSERT_NOT_NULL(pool);
+
+    isolate* failing = isolate_spawn(pool, "var x = 1\nvar x = 2", 0, NULL);
+    isolate* broken = isolate_spawn(pool, "var = ", 0, NULL);
+    isolate* healthy = isolate_spawn(pool, "var x = 20\nx * 2 + 2", 0, NULL);
+
+    char* text = NULL;
+    TEST_ASSERT_EQUAL_INT(VM_RUNTIME_ERROR, isolate_join(failing, &text));
+    TEST_ASSERT_NULL(text);
+    TEST_ASSERT_EQUAL_INT(VM_COMPILE_ERROR, isolate_join(broken, NULL));
+    TEST_ASSERT_EQUAL_INT(VM_OK, isolate_join(healthy, &text));
+    TEST_ASSERT_EQUAL_STRING("42", text);
+    free(text);
+
+    isolate_pool_destroy(pool);
+}
+
+void test_isolate_pool_drains_before_destroy(void) {
+    // One worker, so the later isolates are still queued when destroy is called
+    isolate_pool* pool = isolate_pool_create(1);
+    isolate* isolates[8];
+    for (int i = 0; i < 8; i++) {
+        isolates[i] = isolate_spawn(pool, "var s = 0\nvar i = 0\nwhile i < 20000\n    s += i\n    i += 1\ns", 0, NULL);
+    }
+    isolate_pool_destroy(pool);
+
+    for (int i = 0; i < 8; i++) {
+        char* text = NULL;
+        TEST_ASSERT_EQUAL_INT(VM_OK, isolate_join(isolates[i], &text));
+        TEST_ASSERT_EQUAL_STRING("199990000", text);
+        free(text);
+    }
+}
+
+void test_isolate_suite(void) {
+    RUN_TEST(test_isolate_runs_scripts_concurrently);
+    RUN_TEST(test_isolate_errors_stay_in_their_isolate);
+    RUN_TEST(test_isolate_pool_drains_before_destroy);
+}
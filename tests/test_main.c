@@ -11,6 +11,9 @@ void test_infinite_loops_suite(void);
 void test_builtins_suite(void);
 void test_buffer_class_suite(void);
 void test_buffer_builder_class_suite(void);
+void test_typed_array_class_suite(void);
+void test_map_class_suite(void);
+void test_dynamic_object_suite(void);
 void test_class_array_suite(void);
 void test_class_range_suite(void);
 void test_stepped_ranges_suite(void);
@@ -37,6 +40,10 @@ void test_optional_chaining_suite(void);
 void test_match_suite(void);
 void test_data_types_suite(void);
 void test_module_system_suite(void);
+void test_isolate_suite(void);
+void test_parallel_suite(void);
+void test_generators_suite(void);
+void test_event_loop_suite(void);
 
 void setUp(void) {
     // Setup code that runs before each test
@@ -60,6 +67,9 @@ int main(void) {
     test_builtins_suite();
     test_buffer_class_suite();
     test_buffer_builder_class_suite();
+    test_typed_array_class_suite();
+    test_map_class_suite();
+    test_dynamic_object_suite();
     test_class_array_suite();
     test_class_range_suite();
     test_stepped_ranges_suite();
@@ -86,6 +96,10 @@ int main(void) {
     test_match_suite();
     test_data_types_suite();
     test_module_system_suite();
+    test_isolate_suite();
+    test_parallel_suite();
+    test_generators_suite();
+    test_event_loop_suite();
 
     return UNITY_END();
 }
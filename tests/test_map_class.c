@@ -0,0 +1,116 @@
+#include "unity.h"
+#include "test_helpers.h"
+
+// ===========================
+// MAP
+// ===========================
+
+void test_map_basic_operations(void) {
+    test_expect_true(
+        "var m = Map()\n"
+        "m.set(\"a\", 1).set(2, \"two\").set(null, true)\n"
+        "m.get(\"a\") == 1 && m.get(2) == \"two\" && m.get(null) && m.get(\"zz\") == null && m.get(\"zz\", 0) == 0");
+    test_expect_true(
+        "var m = Map([[\"a\", 1], [\"b\", 2]])\n"
+        "m.set(\"a\", 10)\n"
+        "m.size() == 2 && m.has(\"b\") && m.delete(\"b\") && !m.delete(\"b\") && !m.has(\"b\") && m.size() == 1 && m.get(\"a\") == 10");
+    test_expect_true("Map().isEmpty() && !Map([[1, 1]]).isEmpty() && Map([[1, 1]]).clear().isEmpty()");
+    test_expect_true("type(Map()) == \"Map\" && Map([[\"a\", 1], [2, [3]]]).toString() == \"Map{\\\"a\\\": 1, 2: [3]}\"");
+    TEST_ASSERT_TRUE(test_expect_error("Map([1, 2])", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("Map().set(1)", ERR_TYPE));
+}
+
+void test_map_key_equality(void) {
+    // Equal numbers are one key whatever their type
+    test_expect_true(
+        "var m = Map()\n"
+        "m.set(1, \"int\")\n"
+        "m.set(1.0, \"float\")\n"
+        "m.size() == 1 && m.get(1) == \"float\" && m.get(1.5) == null");
+    // Aggregates and dates are keyed by content
+    test_expect_true(
+        "var m = Map()\n"
+        "m.set([1, 2], \"pair\")\n"
+        "m.set(LocalDate(2024, 12, 25), \"xmas\")\n"
+        "m.set({x: 1}, \"object\")\n"
+        "m.get([1, 2]) == \"pair\" && m.get(LocalDate(2024, 12, 25)) == \"xmas\" && m.get({x: 1}) == \"object\" && m.get([2, 1]) == null");
+    test_expect_true("Set([Set([1, 2]), Set([2, 1]), Map([[1, 2]])]).size() == 2");
+}
+
+void test_map_insertion_order(void) {
+    test_expect_true(
+        "var m = Map()\n"
+        "m.set(\"c\", 3).set(\"a\", 1).set(\"b\", 2)\n"
+        "m.delete(\"a\")\n"
+        "m.set(\"a\", 4)\n"
+        "m.keys() == [\"c\", \"b\", \"a\"] && m.values() == [3, 2, 4] && m.entries() == [[\"c\", 3], [\"b\", 2], [\"a\", 4]]");
+    test_expect_true(
+        "var m = Map([[1, \"x\"], [2, \"y\"]])\n"
+        "var out = []\n"
+        "var it = m.iterator()\n"
+        "while it.hasNext() do out.push(it.next()(0))\n"
+        "out == [1, 2] && m.iterator().map(p -> p(1)).toArray() == [\"x\", \"y\"]");
+    test_expect_true("Map([[1, 2], [3, 4]]) == Map([[3, 4], [1, 2]]) && Map([[1, 2]]) != Map([[1, 3]])");
+    test_expect_true("Map([[1, 2], [3, 4]]).hash() == Map([[3, 4], [1, 2]]).hash()");
+}
+
+void test_map_bulk_constructors(void) {
+    test_expect_true(
+        "var m = Map.fromArray([\"apple\", \"avocado\", \"banana\"], s -> s.length())\n"
+        "m.keys() == [5, 7, 6] && m.get(7) == \"avocado\"");
+    test_expect_true(
+        "var g = Map.groupBy(1..10, x -> x % 3)\n"
+        "g.keys() == [1, 2, 0] && g.get(0) == [3, 6, 9] && g.get(1) == [1, 4, 7, 10]");
+    test_expect_true("Map.groupBy([\"a\", \"bb\", \"c\"], s -> s.length()).get(1) == [\"a\", \"c\"]");
+    test_expect_true("Map(Map([[1, 2]])).get(1) == 2 && Map([[1, 2]]).copy().set(1, 3).get(1) == 3");
+}
+
+void test_map_large(void) {
+    // Growth, rehashing and tombstone reuse
+    test_expect_true(
+        "var m = Map().reserve(10)\n"
+        "for var i = 0; i < 100000; i += 1 do m.set(i, i * 2)\n"
+        "for var i = 0; i < 100000; i += 2 do m.delete(i)\n"
+        "for var i = 0; i < 1000; i += 1 do m.set(\"k\" + i, i)\n"
+        "m.size() == 51000 && m.get(99999) == 199998 && m.get(500) == null && m.get(\"k999\") == 999 && m.keys()(0) == 1");
+}
+
+// ===========================
+// SET
+// ===========================
+
+void test_set_operations(void) {
+    test_expect_true(
+        "var s = Set([3, 1, 3, 2, 1])\n"
+        "s.toArray() == [3, 1, 2] && s.size() == 3 && s.has(2) && !s.has(4)");
+    test_expect_true("Set().add(1).add(1.0).add(\"1\").size() == 2 && Set(1..5).delete(3) && !Set().delete(1)");
+    test_expect_true("Set([1, 2]).toString() == \"Set{1, 2}\" && type(Set()) == \"Set\" && Set.fromArray([1, 1]).size() == 1");
+    test_expect_true(
+        "var a = Set([1, 2, 3])\n"
+        "var b = Set([2, 3, 4])\n"
+        "a.union(b).toArray() == [1, 2, 3, 4] && a.intersection(b).toArray() == [2, 3] && a.difference(b).toArray() == [1]");
+    test_expect_true("Set([1, 2]) == Set([2, 1]) && Set([1, 2]) != Set([1]) && Set([1, 2]).hash() == Set([2, 1]).hash()");
+    test_expect_true("Set([1, 2]).iterator().map(x -> x * 10).toArray() == [10, 20] && Set(Set([5])).has(5)");
+    TEST_ASSERT_TRUE(test_expect_error("Set([1]).union([2])", ERR_TYPE));
+
+    // Error messages use the names type() reports
+    TEST_ASSERT_EQUAL_STRING("Map", value_type_name(VAL_MAP));
+    TEST_ASSERT_EQUAL_STRING("Set", value_type_name(VAL_SET));
+}
+
+void test_set_large(void) {
+    test_expect_true(
+        "var s = Set()\n"
+        "for var i = 0; i < 100000; i += 1 do s.add(i % 50000)\n"
+        "s.size() == 50000 && s.has(49999) && !s.has(50000)");
+}
+
+void test_map_class_suite(void) {
+    RUN_TEST(test_map_basic_operations);
+    RUN_TEST(test_map_key_equality);
+    RUN_TEST(test_map_insertion_order);
+    RUN_TEST(test_map_bulk_constructors);
+    RUN_TEST(test_map_large);
+    RUN_TEST(test_set_operations);
+    RUN_TEST(test_set_large);
+}
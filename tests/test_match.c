@@ -1,5 +1,6 @@
 #include "unity.h"
 #include "test_helpers.h"
+#include <stdio.h>
 
 // Basic literal pattern matching tests
 void test_match_literal_integer(void) {
@@ -284,6 +285,69 @@ void test_match_string_equality(void) {
     TEST_ASSERT_EQUAL_STRING("strings equal", result.as.string);
 }
 
+// Jump-table dispatch (four or more int32/string literal cases)
+void test_match_int_jump_table(void) {
+    const char* cases =
+        "    case 1 do \"one\"\n"
+        "    case 2 do \"two\"\n"
+        "    case -1 do \"minus one\"\n"
+        "    case 2 do \"duplicate\"\n"
+        "    case 5 do \"five\"\n"
+        "    case x do \"other\"";
+    char source[512];
+
+    snprintf(source, sizeof(source), "match 2\n%s", cases);
+    value_t result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("two", result.as.string);
+    vm_release(result);
+
+    snprintf(source, sizeof(source), "match -1\n%s", cases);
+    result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("minus one", result.as.string);
+    vm_release(result);
+
+    // Hole in the table falls through to the variable case
+    snprintf(source, sizeof(source), "match 3\n%s", cases);
+    result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("other", result.as.string);
+    vm_release(result);
+
+    // Non-int32 subjects still compare with .equals()
+    snprintf(source, sizeof(source), "match 5.0\n%s", cases);
+    result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_STRING, result.type);
+    TEST_ASSERT_EQUAL_STRING("five", result.as.string);
+    vm_release(result);
+}
+
+void test_match_string_jump_table(void) {
+    const char* cases =
+        "    case \"apple\" do 1\n"
+        "    case \"banana\" do 2\n"
+        "    case \"cherry\" do 3\n"
+        "    case \"date\" do 4\n"
+        "    case \"apple\" do 99";
+    char source[512];
+
+    snprintf(source, sizeof(source), "match \"cherry\"\n%s", cases);
+    value_t result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT(3, result.as.int32);
+
+    snprintf(source, sizeof(source), "match \"apple\"\n%s", cases);
+    result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT(1, result.as.int32);
+
+    // Non-exhaustive miss returns null
+    snprintf(source, sizeof(source), "match \"fig\"\n%s", cases);
+    result = test_execute_expression(source);
+    TEST_ASSERT_EQUAL_INT(VAL_NULL, result.type);
+}
+
 // Test suite runner
 void test_match_suite(void) {
     // Basic literal matching
@@ -340,4 +404,8 @@ void test_match_suite(void) {
     // Equals method dispatch
     RUN_TEST(test_match_uses_equals_method);
     RUN_TEST(test_match_string_equality);
+    
+    // Jump-table lowering
+    RUN_TEST(test_match_int_jump_table);
+    RUN_TEST(test_match_string_jump_table);
 }
\ No newline at end of file
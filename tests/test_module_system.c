@@ -58,8 +58,8 @@ void test_import_data_declarations(void) {
                        "Point(3, 4)";
 
     value_t result = test_execute_with_imports(code);
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
-    TEST_ASSERT_NOT_NULL(result.as.object);
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
+    TEST_ASSERT_NOT_NULL(result.as.adt);
     vm_release(result);
 }
 
@@ -176,8 +176,8 @@ void test_mixed_declaration_import(void) {
                        "Success(Point(CONSTANT_VALUE, square(6)))";
 
     value_t result = test_execute_with_imports(code);
-    TEST_ASSERT_EQUAL(VAL_OBJECT, result.type);
-    TEST_ASSERT_NOT_NULL(result.as.object);
+    TEST_ASSERT_EQUAL(VAL_ADT, result.type);
+    TEST_ASSERT_NOT_NULL(result.as.adt);
     vm_release(result);
 }
 
@@ -0,0 +1,170 @@
+#include "unity.h"
+#include "test_helpers.h"
+#include "codegen.h"
+#include "lexer.h"
+#include "parallel.h"
+#include "parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// A VM that stays alive after running its script, so the callback it returns can be verified
+typedef struct {
+    lexer_t lexer;
+    ast_program* program;
+    vm_t* vm;
+    codegen_t* codegen;
+    value_t result;
+} kept_vm;
+
+static void keep_vm_run(kept_vm* kept, const char* source) {
+    lexer_init(&kept->lexer, source);
+    parser_t parser;
+    parser_init(&parser, &kept->lexer);
+    kept->program = parse_program(&parser);
+    TEST_ASSERT_FALSE(parser.had_error);
+
+    kept->vm = vm_create();
+    kept->vm->context = CTX_TEST;
+    kept->codegen = codegen_create(kept->vm);
+    function_t* function = codegen_compile(kept->codegen, kept->program);
+    TEST_ASSERT_NOT_NULL(function);
+    TEST_ASSERT_EQUAL_INT(VM_OK, vm_execute(kept->vm, function));
+    kept->result = kept->vm->result;
+}
+
+static void keep_vm_destroy(kept_vm* kept) {
+    vm_destroy(kept->vm);
+    codegen_destroy(kept->codegen);
+    ast_free((ast_node*)kept->program);
+    lexer_cleanup(&kept->lexer);
+}
+
+static bool is_pure(const char* source) {
+    kept_vm kept;
+    keep_vm_run(&kept, source);
+    parallel_kernel* kernel = parallel_kernel_create(kept.vm, kept.result, 2);
+    parallel_kernel_destroy(kernel);
+    keep_vm_destroy(&kept);
+    return kernel != NULL;
+}
+
+void test_parallel_kernel_verification(void) {
+    TEST_ASSERT_TRUE(is_pure("x -> x * 2 + 1"));
+    TEST_ASSERT_TRUE(is_pure("var k = 3; (x, i) -> x * k + i"));
+    TEST_ASSERT_TRUE(is_pure("x -> sqrt(abs(x)) + max(x, 10)"));
+    TEST_ASSERT_TRUE(is_pure("x -> if x > 0 then \"positive\" else \"other\""));
+
+    TEST_ASSERT_FALSE(is_pure("var box = []; x -> box.push(x)"));
+    TEST_ASSERT_FALSE(is_pure("x -> print(x)"));
+    TEST_ASSERT_FALSE(is_pure("x -> [x, x]"));
+    TEST_ASSERT_FALSE(is_pure("x -> x.toString()"));
+    TEST_ASSERT_FALSE(is_pure("def helper(n) = n + 1; x -> helper(x)"));
+    TEST_ASSERT_FALSE(is_pure("var o = {a: 1}; x -> x + o.a"));
+    TEST_ASSERT_FALSE(is_pure("(x, i, array) -> x")); // The array can't be handed to a worker
+}
+
+void test_parallel_map_runs_on_workers(void) {
+    enum { COUNT = PARALLEL_MIN_ELEMENTS * 3 + 7 };
+    kept_vm kept;
+    keep_vm_run(&kept, "var offset = 0.5; (x, i) -> x * 2 + i + offset");
+    parallel_kernel* kernel = parallel_kernel_create(kept.vm, kept.result, 2);
+    TEST_ASSERT_NOT_NULL(kernel);
+
+    value_t* in = malloc(sizeof(value_t) * COUNT);
+    value_t* out = malloc(sizeof(value_t) * COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        in[i] = make_int32(i);
+    }
+    TEST_ASSERT_TRUE(parallel_map(kept.vm, kernel, in, COUNT, out));
+    for (int i = 0; i < COUNT; i++) {
+        TEST_ASSERT_EQUAL(VAL_FLOAT64, out[i].type);
+        TEST_ASSERT_EQUAL_DOUBLE(3.0 * i + 0.5, out[i].as.float64);
+    }
+
+    // Too short to be worth it, and elements that aren't plain values: the caller runs sequentially
+    TEST_ASSERT_FALSE(parallel_map(kept.vm, kernel, in, PARALLEL_MIN_ELEMENTS - 1, out));
+    in[COUNT / 2] = make_string("shared");
+    TEST_ASSERT_FALSE(parallel_map(kept.vm, kernel, in, COUNT, out));
+    vm_release(in[COUNT / 2]);
+
+    free(in);
+    free(out);
+    parallel_kernel_destroy(kernel);
+    keep_vm_destroy(&kept);
+}
+
+void test_parallel_array_methods_match_sequential(void) {
+    value_t result = test_execute_expression(
+        "var xs = []\n"
+        "var i = 0\n"
+        "while i < 20000\n"
+        "    xs.push(i)\n"
+        "    i += 1\n"
+        "var k = 7\n"
+        "var same = xs.parMap(x -> x * k % 1000) == xs.map(x -> x * k % 1000)\n"
+        "var kept = xs.parFilter((x, i) -> (x + i) % 6 == 0) == xs.filter((x, i) -> (x + i) % 6 == 0)\n"
+        "same && kept && xs.parReduce((a, b) -> a + b, 5) == 199990005");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+}
+
+void test_parallel_array_methods_fall_back(void) {
+    // Side effects, results that aren't plain values and short arrays all take the sequential path
+    value_t result = test_execute_expression(
+        "var xs = []\n"
+        "var i = 0\n"
+        "while i < 5000\n"
+        "    xs.push(i)\n"
+        "    i += 1\n"
+        "var seen = []\n"
+        "xs.parMap(x -> seen.push(x))\n"
+        "var words = xs.parMap(x -> \"w\" + x)\n"
+        "var small = [1, 2, 3].parFilter(x -> x != 2)\n"
+        "seen.length() == 5000 && words(4999) == \"w4999\" && small == [1, 3] && [].parReduce((a, b) -> a + b, 0) == 0");
+    TEST_ASSERT_EQUAL(VAL_BOOLEAN, result.type);
+    TEST_ASSERT_TRUE(result.as.boolean);
+
+}
+
+void test_parallel_errors_surface_from_sequential_rerun(void) {
+    enum { COUNT = PARALLEL_MIN_ELEMENTS * 2 };
+    const char* callback = "x -> 1000 / (x - 7)";
+
+    // The callback is pure, so the elements go to the workers, and the one that divides by zero
+    // fails the parallel run
+    kept_vm kept;
+    keep_vm_run(&kept, callback);
+    parallel_kernel* kernel = parallel_kernel_create(kept.vm, kept.result, 2);
+    TEST_ASSERT_NOT_NULL(kernel);
+    value_t* in = malloc(sizeof(value_t) * COUNT);
+    value_t* out = malloc(sizeof(value_t) * COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        in[i] = make_int32(i);
+    }
+    TEST_ASSERT_FALSE(parallel_map(kept.vm, kernel, in, COUNT, out));
+    free(in);
+    free(out);
+    parallel_kernel_destroy(kernel);
+    keep_vm_destroy(&kept);
+
+    // parMap then reruns sequentially and reports the error as map() would
+    char source[256];
+    snprintf(source, sizeof(source),
+             "var xs = []\n"
+             "var i = 0\n"
+             "while i < %d\n"
+             "    xs.push(i)\n"
+             "    i += 1\n"
+             "xs.parMap(%s)",
+             COUNT, callback);
+    TEST_ASSERT_TRUE(test_expect_error(source, ERR_ARITHMETIC));
+}
+
+void test_parallel_suite(void) {
+    setenv("SLATE_THREADS", "4", 1); // Exercise the workers even on a single-CPU machine
+    RUN_TEST(test_parallel_kernel_verification);
+    RUN_TEST(test_parallel_map_runs_on_workers);
+    RUN_TEST(test_parallel_array_methods_match_sequential);
+    RUN_TEST(test_parallel_array_methods_fall_back);
+    RUN_TEST(test_parallel_errors_surface_from_sequential_rerun);
+}
@@ -0,0 +1,161 @@
+#include "unity.h"
+#include "test_helpers.h"
+#include "kernels.h"
+#include <math.h>
+#include <stdlib.h>
+
+// ===========================
+// CONSTRUCTION AND ACCESS
+// ===========================
+
+void test_typed_array_construction(void) {
+    test_expect_true("Int32Array(3).toArray() == [0, 0, 0] && Float64Array(0).length() == 0");
+    test_expect_true("Int32Array([1, 2, 3]).toArray() == [1, 2, 3] && Float64Array([1, 2.5]).toArray() == [1.0, 2.5]");
+    test_expect_true("Int32Array(1..5).toArray() == [1, 2, 3, 4, 5] && Float64Array((1..3).iterator().map(x -> x * 2)).sum() == 12.0");
+    // Converting between the two truncates toward zero
+    test_expect_true("Int32Array(Float64Array([1.9, -1.9])).toArray() == [1, -1] && Float64Array(Int32Array([7])).toArray() == [7.0]");
+    test_expect_true("type(Int32Array(1)) == \"Int32Array\" && type(Float64Array(1)) == \"Float64Array\"");
+    test_expect_true("Int32Array([1, 2]).toString() == \"Int32Array[1, 2]\" && Float64Array([0.5]).toString() == \"Float64Array[0.5]\"");
+
+    // Error messages name the class type() reports
+    value_t array = test_execute_expression("Float64Array(1)");
+    TEST_ASSERT_EQUAL_STRING("Float64Array", value_class_name(array));
+    vm_release(array);
+}
+
+void test_typed_array_indexing(void) {
+    test_expect_true(
+        "var a = Int32Array(3)\n"
+        "a(1) = 42\n"
+        "var f = Float64Array(2)\n"
+        "f(0) = 3\n"
+        "a(1) == 42 && a(0) == 0 && a(5) == null && f(0) == 3.0");
+    TEST_ASSERT_TRUE(test_expect_error("var a = Int32Array(2)\na(0) = 1.5", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("var a = Int32Array(2)\na(2) = 1", ERR_RANGE));
+}
+
+// ===========================
+// BULK OPERATIONS
+// ===========================
+
+void test_typed_array_reductions(void) {
+    test_expect_true("Int32Array(1..100).sum() == 5050 && Float64Array([0.5, 0.25]).sum() == 0.75");
+    // Int32 sums don't wrap
+    test_expect_true("Int32Array([2147483647, 2147483647]).sum() == 4294967294");
+    test_expect_true("Int32Array([3, -7, 9, 0]).min() == -7 && Int32Array([3, -7, 9, 0]).max() == 9 && Int32Array(0).min() == null");
+    test_expect_true("Float64Array([2.5, -1.5, 8.0]).min() == -1.5 && Float64Array([2.5, -1.5, 8.0]).max() == 8.0");
+    test_expect_true("Int32Array([1, 2, 3]).dot(Int32Array([4, 5, 6])) == 32 && Float64Array([0.5, 2]).dot(Int32Array([4, 3])) == 8.0");
+    TEST_ASSERT_TRUE(test_expect_error("Int32Array(2).dot(Int32Array(3))", ERR_TYPE));
+}
+
+void test_typed_array_elementwise(void) {
+    test_expect_true("Int32Array([1, 2, 3]).add(Int32Array([10, 20, 30])) == Int32Array([11, 22, 33])");
+    test_expect_true("Int32Array([5, 6]).sub(1) == Int32Array([4, 5]) && Int32Array([5, 6]).mul(2) == Int32Array([10, 12])");
+    // Division and Float operands give Float64Array; Int32 arithmetic wraps
+    test_expect_true("Int32Array([1, 3]).div(2) == Float64Array([0.5, 1.5]) && Int32Array([1]).add(0.5) == Float64Array([1.5])");
+    test_expect_true("Int32Array([2147483647]).add(2) == Int32Array([-2147483647])");
+    test_expect_true("Float64Array([1, 2]).mul(Float64Array([3, 4])) == Float64Array([3, 8])");
+    test_expect_true(
+        "var a = Float64Array(5)\n"
+        "var same = a.fill(2.5)\n"
+        "same == a && a.sum() == 12.5 && Int32Array(3).fill(-1).toArray() == [-1, -1, -1]");
+    TEST_ASSERT_TRUE(test_expect_error("Int32Array(2).add(\"x\")", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("Int32Array(2).fill(0.5)", ERR_TYPE));
+}
+
+void test_typed_array_map(void) {
+    test_expect_true("Float64Array([4, 9]).map(sqrt) == Float64Array([2, 3]) && Int32Array([4, 9]).map(sqrt) == Float64Array([2, 3])");
+    test_expect_true("Int32Array([-3, 4]).map(abs) == Int32Array([3, 4]) && Float64Array([-1.5, 2.5]).map(floor) == Float64Array([-2, 2])");
+    test_expect_true("Float64Array([1.2, -1.2]).map(ceil) == Float64Array([2, -1]) && Float64Array([0]).map(exp) == Float64Array([1])");
+    test_expect_true("Int32Array([1, 2]).map(x -> x * 10) == Int32Array([10, 20]) && Float64Array([1, 2]).map(x -> x / 4) == Float64Array([0.25, 0.5])");
+    TEST_ASSERT_TRUE(test_expect_error("Float64Array([-1]).map(sqrt)", ERR_TYPE));
+    TEST_ASSERT_TRUE(test_expect_error("Int32Array([1]).map(x -> x / 2)", ERR_TYPE));
+}
+
+void test_typed_array_buffers(void) {
+    test_expect_true(
+        "var a = Int32Array([1, -2, 300000])\n"
+        "var bytes = a.toBuffer()\n"
+        "bytes.length() == 12 && Int32Array.fromBuffer(bytes) == a && Buffer([1, 0, 0, 0]).length() == 4 && "
+        "Int32Array.fromBuffer(Buffer([1, 0, 0, 0])).toArray() == [1]");
+    test_expect_true("Float64Array.fromBuffer(Float64Array([0.1, 2.5]).toBuffer()) == Float64Array([0.1, 2.5])");
+    TEST_ASSERT_TRUE(test_expect_error("Float64Array.fromBuffer(Buffer([1, 2, 3]))", ERR_TYPE));
+}
+
+// ===========================
+// KERNELS AT EVERY SIMD LEVEL
+// ===========================
+
+// Odd lengths exercise the vector loops and the scalar tails together
+void test_typed_array_kernels_agree_across_levels(void) {
+    enum { N = 1003 };
+    static int32_t ints[N], other_ints[N], out_ints[N];
+    static double floats[N], other_floats[N], out_floats[N];
+    for (int i = 0; i < N; i++) {
+        ints[i] = (i * 7919) % 2001 - 1000;
+        other_ints[i] = (i * 104729) % 33 - 16;
+        floats[i] = ints[i] * 0.25;
+        other_floats[i] = other_ints[i] * 0.5;
+    }
+    int64_t expected_sum = 0, expected_dot = 0;
+    int32_t expected_min = ints[0], expected_max = ints[0];
+    for (int i = 0; i < N; i++) {
+        expected_sum += ints[i];
+        expected_dot += (int64_t)ints[i] * other_ints[i];
+        if (ints[i] < expected_min) expected_min = ints[i];
+        if (ints[i] > expected_max) expected_max = ints[i];
+    }
+
+    tk_level original = tk_get_level();
+    for (int level = TK_SCALAR; level <= TK_AVX2; level++) {
+        tk_set_level((tk_level)level);
+        TEST_ASSERT_EQUAL_INT64(expected_sum, tk_sum_i32(ints, N));
+        // Quarter-integer values sum exactly in any order
+        TEST_ASSERT_EQUAL_DOUBLE(expected_sum * 0.25, tk_sum_f64(floats, N));
+
+        int32_t min, max;
+        tk_min_max_i32(ints, N, &min, &max);
+        TEST_ASSERT_EQUAL_INT32(expected_min, min);
+        TEST_ASSERT_EQUAL_INT32(expected_max, max);
+        double fmin, fmax;
+        tk_min_max_f64(floats, N, &fmin, &fmax);
+        TEST_ASSERT_EQUAL_DOUBLE(expected_min * 0.25, fmin);
+        TEST_ASSERT_EQUAL_DOUBLE(expected_max * 0.25, fmax);
+
+        TEST_ASSERT_EQUAL_DOUBLE(expected_dot * 0.125, tk_dot_f64(floats, other_floats, N));
+
+        tk_binary_i32(TK_MUL, out_ints, ints, other_ints, N);
+        tk_binary_scalar_f64(TK_SUB, out_floats, floats, 1.5, N);
+        for (int i = 0; i < N; i++) {
+            TEST_ASSERT_EQUAL_INT32(ints[i] * other_ints[i], out_ints[i]);
+            TEST_ASSERT_EQUAL_DOUBLE(floats[i] - 1.5, out_floats[i]);
+        }
+
+        tk_abs_i32(out_ints, ints, N);
+        tk_unary_f64(TK_FLOOR, out_floats, floats, N);
+        for (int i = 0; i < N; i++) {
+            TEST_ASSERT_EQUAL_INT32(abs(ints[i]), out_ints[i]);
+            TEST_ASSERT_EQUAL_DOUBLE(floor(floats[i]), out_floats[i]);
+        }
+    }
+
+    // NaN anywhere makes min/max NaN
+    floats[N - 1] = NAN;
+    for (int level = TK_SCALAR; level <= TK_AVX2; level++) {
+        tk_set_level((tk_level)level);
+        double fmin, fmax;
+        tk_min_max_f64(floats, N, &fmin, &fmax);
+        TEST_ASSERT_TRUE(isnan(fmin) && isnan(fmax));
+    }
+    tk_set_level(original);
+}
+
+void test_typed_array_class_suite(void) {
+    RUN_TEST(test_typed_array_construction);
+    RUN_TEST(test_typed_array_indexing);
+    RUN_TEST(test_typed_array_reductions);
+    RUN_TEST(test_typed_array_elementwise);
+    RUN_TEST(test_typed_array_map);
+    RUN_TEST(test_typed_array_buffers);
+    RUN_TEST(test_typed_array_kernels_agree_across_levels);
+}
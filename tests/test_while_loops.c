@@ -309,6 +309,21 @@ void test_do_while_edge_cases(void) {
     vm_release(result);
 }
 
+// Assignments to locals inside a function loop must not leave values behind on the stack
+void test_while_loop_local_assignments_in_function(void) {
+    value_t result = test_execute_expression("def sum(n) =\n"
+                            "    var total = 0\n"
+                            "    var i = 0\n"
+                            "    while i < n do\n"
+                            "        total = total + i\n"
+                            "        i += 1\n"
+                            "    total\n"
+                            "sum(1000)");
+    TEST_ASSERT_EQUAL_INT(VAL_INT32, result.type);
+    TEST_ASSERT_EQUAL_INT32(499500, result.as.int32);
+    vm_release(result);
+}
+
 // Test suite runner
 void test_while_loops_suite(void) {
     RUN_TEST(test_basic_while_loops);
@@ -320,4 +335,5 @@ void test_while_loops_suite(void) {
     RUN_TEST(test_basic_do_while_loops);
     RUN_TEST(test_do_while_break_continue);
     RUN_TEST(test_do_while_edge_cases);
+    RUN_TEST(test_while_loop_local_assignments_in_function);
 }